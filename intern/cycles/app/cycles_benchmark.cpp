@@ -0,0 +1,824 @@
+/*
+ * Copyright 2011-2019 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Headless benchmark
+ *
+ * Renders a fixed set of procedurally generated XML scenes on the CPU device
+ * with a fixed number of samples, and writes the time spent in each phase as
+ * JSON. The scenes are generated from a fixed seed, so results are comparable
+ * between builds on the same machine.
+ *
+ * Reported times, in seconds:
+ *
+ * - sync: reading the XML scene and creating the Cycles scene.
+ * - tessellation, displacement, bvh_build: scene device update phases.
+ * - render: path tracing, excluding scene update and kernel loading.
+ * - denoise: time spent denoising, summed over all render threads.
+ *
+ * Rays per second only counts camera rays, one per pixel sample, since the
+ * kernels do not count secondary rays. The shading scenes only trace camera
+ * rays, so for them it measures shading throughput of a single node type. */
+
+#include <stdio.h>
+
+#include <algorithm>
+
+#include "device/device.h"
+#include "render/buffers.h"
+#include "render/camera.h"
+#include "render/film.h"
+#include "render/scene.h"
+#include "render/session.h"
+#include "render/stats.h"
+
+#include "util/util_args.h"
+#include "util/util_debug.h"
+#include "util/util_foreach.h"
+#include "util/util_hash.h"
+#include "util/util_logging.h"
+#include "util/util_path.h"
+#include "util/util_profiling.h"
+#include "util/util_string.h"
+#include "util/util_task.h"
+#include "util/util_time.h"
+#include "util/util_version.h"
+
+#include "app/cycles_xml.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Scene Generation
+ *
+ * All scenes share the same camera setup, looking down the positive Z axis
+ * from the origin, with Y pointing up. */
+
+static void benchmark_rng_seed(uint *rng, uint seed)
+{
+  *rng = hash_uint(seed);
+}
+
+static float benchmark_rng_float(uint *rng)
+{
+  *rng = hash_uint(*rng);
+  return hash_uint_to_float(*rng);
+}
+
+static string benchmark_float3_array(const vector<float3> &values)
+{
+  string result;
+  foreach (const float3 &value, values) {
+    result += string_printf("%.5f %.5f %.5f ", (double)value.x, (double)value.y, (double)value.z);
+  }
+  return result;
+}
+
+static string benchmark_int_array(const vector<int> &values)
+{
+  string result;
+  foreach (int value, values) {
+    result += string_printf("%d ", value);
+  }
+  return result;
+}
+
+static string benchmark_mesh(const vector<float3> &P,
+                             const vector<int> &nverts,
+                             const vector<int> &verts,
+                             const string &attributes)
+{
+  return string_printf("<mesh %s P=\"%s\" nverts=\"%s\" verts=\"%s\" />\n",
+                       attributes.c_str(),
+                       benchmark_float3_array(P).c_str(),
+                       benchmark_int_array(nverts).c_str(),
+                       benchmark_int_array(verts).c_str());
+}
+
+/* Grid of quads in the XZ plane, centered at the origin. */
+static string benchmark_plane(float size, int resolution, const string &attributes)
+{
+  vector<float3> P;
+  vector<int> nverts, verts;
+
+  for (int j = 0; j <= resolution; j++) {
+    for (int i = 0; i <= resolution; i++) {
+      P.push_back(make_float3((i / (float)resolution - 0.5f) * size,
+                              0.0f,
+                              (j / (float)resolution - 0.5f) * size));
+    }
+  }
+
+  for (int j = 0; j < resolution; j++) {
+    for (int i = 0; i < resolution; i++) {
+      int v = j * (resolution + 1) + i;
+      nverts.push_back(4);
+      verts.push_back(v);
+      verts.push_back(v + resolution + 1);
+      verts.push_back(v + resolution + 2);
+      verts.push_back(v + 1);
+    }
+  }
+
+  return benchmark_mesh(P, nverts, verts, attributes);
+}
+
+/* UV sphere with unit radius, centered at the origin. */
+static string benchmark_sphere(int segments, int rings, const string &attributes)
+{
+  vector<float3> P;
+  vector<int> nverts, verts;
+
+  for (int j = 0; j <= rings; j++) {
+    float theta = M_PI_F * j / rings;
+    for (int i = 0; i < segments; i++) {
+      float phi = M_2PI_F * i / segments;
+      P.push_back(make_float3(sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi)));
+    }
+  }
+
+  for (int j = 0; j < rings; j++) {
+    for (int i = 0; i < segments; i++) {
+      int i1 = (i + 1) % segments;
+      nverts.push_back(4);
+      verts.push_back(j * segments + i);
+      verts.push_back(j * segments + i1);
+      verts.push_back((j + 1) * segments + i1);
+      verts.push_back((j + 1) * segments + i);
+    }
+  }
+
+  return benchmark_mesh(P, nverts, verts, attributes);
+}
+
+/* Axis aligned box from -1 to 1. */
+static string benchmark_box(const string &attributes)
+{
+  vector<float3> P;
+  vector<int> nverts(6, 4);
+  const int faces[] = {0, 1, 3, 2, 4, 6, 7, 5, 0, 4, 5, 1, 2, 3, 7, 6, 0, 2, 6, 4, 1, 5, 7, 3};
+
+  for (int i = 0; i < 8; i++) {
+    P.push_back(make_float3((i & 4) ? 1.0f : -1.0f,
+                            (i & 2) ? 1.0f : -1.0f,
+                            (i & 1) ? 1.0f : -1.0f));
+  }
+
+  return benchmark_mesh(P, nverts, vector<int>(faces, faces + 24), attributes);
+}
+
+static string benchmark_header(int width, int height, float distance, float height_offset)
+{
+  string xml = "<cycles>\n";
+  xml += string_printf("<camera width=\"%d\" height=\"%d\" />\n", width, height);
+  xml += string_printf("<transform translate=\"0 %f %f\" rotate=\"15 1 0 0\">\n",
+                       (double)height_offset,
+                       (double)-distance);
+  xml += "<camera type=\"perspective\" />\n";
+  xml += "</transform>\n";
+  xml += "<integrator max_bounce=\"4\" sample_all_lights_direct=\"false\" ";
+  xml += "sample_all_lights_indirect=\"false\" />\n";
+  xml += "<background>\n";
+  xml += "<background name=\"bg\" strength=\"0.5\" color=\"0.6 0.7 0.9\" />\n";
+  xml += "<connect from=\"bg background\" to=\"output surface\" />\n";
+  xml += "</background>\n";
+  xml += "<shader name=\"diffuse\">\n";
+  xml += "<diffuse_bsdf name=\"bsdf\" color=\"0.7 0.7 0.7\" />\n";
+  xml += "<connect from=\"bsdf bsdf\" to=\"output surface\" />\n";
+  xml += "</shader>\n";
+  xml += "<shader name=\"sun\">\n";
+  xml += "<emission name=\"emission\" color=\"1 0.95 0.9\" strength=\"3\" />\n";
+  xml += "<connect from=\"emission emission\" to=\"output surface\" />\n";
+  xml += "</shader>\n";
+  return xml;
+}
+
+static string benchmark_footer()
+{
+  return "</cycles>\n";
+}
+
+static string benchmark_sun()
+{
+  return "<state shader=\"sun\">\n"
+         "<light type=\"distant\" dir=\"0.3 -1 0.5\" size=\"0.05\" use_mis=\"true\" />\n"
+         "</state>\n";
+}
+
+static string benchmark_ground(float size)
+{
+  return "<state shader=\"diffuse\">\n" + benchmark_plane(size, 1, "") + "</state>\n";
+}
+
+/* Many instances of a single mesh, with their own BVH. */
+static string benchmark_scene_instances(int width, int height)
+{
+  const int grid = 64;
+  uint rng;
+  benchmark_rng_seed(&rng, 1);
+
+  string xml = benchmark_header(width, height, 40.0f, 12.0f);
+  xml += benchmark_sun();
+  xml += "<transform translate=\"0 -1 0\">\n" + benchmark_ground(200.0f) + "</transform>\n";
+
+  xml += "<state shader=\"diffuse\" interpolation=\"smooth\">\n";
+  xml += "<transform translate=\"0 -100 0\">\n";
+  xml += benchmark_sphere(32, 16, "name=\"rock\"");
+  xml += "</transform>\n";
+
+  for (int j = 0; j < grid; j++) {
+    for (int i = 0; i < grid; i++) {
+      float x = (i - grid * 0.5f) * 1.2f + benchmark_rng_float(&rng) * 0.4f;
+      float z = j * 1.2f + benchmark_rng_float(&rng) * 0.4f;
+      float scale = 0.2f + benchmark_rng_float(&rng) * 0.4f;
+      float angle = benchmark_rng_float(&rng) * 360.0f;
+      xml += string_printf(
+          "<transform translate=\"%f %f %f\" rotate=\"%f 0 1 0\" scale=\"%f %f %f\">"
+          "<instance mesh=\"rock\" /></transform>\n",
+          (double)x,
+          (double)(scale - 1.0f),
+          (double)z,
+          (double)angle,
+          (double)scale,
+          (double)(scale * 0.7f),
+          (double)scale);
+    }
+  }
+
+  xml += "</state>\n";
+  xml += benchmark_footer();
+  return xml;
+}
+
+/* Plane with true displacement, diced close to one pixel per micropolygon. */
+static string benchmark_scene_displacement(int width, int height)
+{
+  string xml = benchmark_header(width, height, 6.0f, 2.0f);
+  xml += benchmark_sun();
+  xml += "<shader name=\"displaced\" displacement_method=\"true\">\n";
+  xml += "<diffuse_bsdf name=\"bsdf\" color=\"0.6 0.5 0.4\" />\n";
+  xml += "<noise_texture name=\"noise\" scale=\"3\" detail=\"8\" />\n";
+  xml += "<displacement name=\"displacement\" scale=\"0.6\" />\n";
+  xml += "<connect from=\"noise fac\" to=\"displacement height\" />\n";
+  xml += "<connect from=\"bsdf bsdf\" to=\"output surface\" />\n";
+  xml += "<connect from=\"displacement displacement\" to=\"output displacement\" />\n";
+  xml += "</shader>\n";
+
+  xml += "<state shader=\"displaced\" interpolation=\"smooth\" dicing_rate=\"1\">\n";
+  xml += "<transform translate=\"0 -1 4\">\n";
+  xml += benchmark_plane(12.0f, 8, "subdivision=\"catmull-clark\"");
+  xml += "</transform>\n";
+  xml += "</state>\n";
+  xml += benchmark_footer();
+  return xml;
+}
+
+/* Heterogeneous volume box above a ground plane. */
+static string benchmark_scene_volume(int width, int height)
+{
+  string xml = benchmark_header(width, height, 8.0f, 2.0f);
+  xml += benchmark_sun();
+  xml += "<transform translate=\"0 -1 0\">\n" + benchmark_ground(40.0f) + "</transform>\n";
+  xml += "<shader name=\"smoke\">\n";
+  xml += "<noise_texture name=\"noise\" scale=\"1.5\" detail=\"4\" />\n";
+  xml += "<math name=\"density\" type=\"multiply\" value2=\"4\" />\n";
+  xml += "<principled_volume name=\"volume\" color=\"0.8 0.8 0.8\" anisotropy=\"0.3\" />\n";
+  xml += "<connect from=\"noise fac\" to=\"density value1\" />\n";
+  xml += "<connect from=\"density value\" to=\"volume density\" />\n";
+  xml += "<connect from=\"volume volume\" to=\"output volume\" />\n";
+  xml += "</shader>\n";
+
+  xml += "<state shader=\"smoke\">\n";
+  xml += "<transform translate=\"0 1 4\" scale=\"2.5 2 2.5\">\n";
+  xml += benchmark_box("");
+  xml += "</transform>\n";
+  xml += "</state>\n";
+  xml += benchmark_footer();
+  return xml;
+}
+
+/* Hundreds of small colored point lights over a ground plane with spheres. */
+static string benchmark_scene_lights(int width, int height)
+{
+  const int grid = 16;
+  uint rng;
+  benchmark_rng_seed(&rng, 2);
+
+  string xml = benchmark_header(width, height, 12.0f, 4.0f);
+  xml += "<transform translate=\"0 -1 0\">\n" + benchmark_ground(60.0f) + "</transform>\n";
+
+  xml += "<state shader=\"diffuse\" interpolation=\"smooth\">\n";
+  for (int i = 0; i < 8; i++) {
+    xml += string_printf("<transform translate=\"%f 0 %f\">\n",
+                         (double)((i - 3.5f) * 2.0f),
+                         (double)(4.0f + (i % 2) * 3.0f));
+    xml += benchmark_sphere(32, 16, "");
+    xml += "</transform>\n";
+  }
+  xml += "</state>\n";
+
+  for (int j = 0; j < grid; j++) {
+    for (int i = 0; i < grid; i++) {
+      float r = benchmark_rng_float(&rng);
+      float g = benchmark_rng_float(&rng);
+      float b = benchmark_rng_float(&rng);
+      xml += string_printf("<shader name=\"light%d\">\n", j * grid + i);
+      xml += string_printf("<emission name=\"emission\" color=\"%f %f %f\" strength=\"20\" />\n",
+                           (double)r,
+                           (double)g,
+                           (double)b);
+      xml += "<connect from=\"emission emission\" to=\"output surface\" />\n";
+      xml += "</shader>\n";
+      xml += string_printf("<state shader=\"light%d\">\n", j * grid + i);
+      xml += string_printf(
+          "<light type=\"point\" co=\"%f %f %f\" size=\"0.05\" use_mis=\"true\" />\n",
+          (double)((i - grid * 0.5f) * 1.5f),
+          (double)(-0.5f + benchmark_rng_float(&rng) * 2.0f),
+          (double)(j * 1.5f));
+      xml += "</state>\n";
+    }
+  }
+
+  xml += benchmark_footer();
+  return xml;
+}
+
+/* Patch of curly hair strands on a ground plane. */
+static string benchmark_scene_hair(int width, int height)
+{
+  const int num_strands = 20000;
+  const int num_keys = 6;
+  uint rng;
+  benchmark_rng_seed(&rng, 3);
+
+  string xml = benchmark_header(width, height, 5.0f, 1.5f);
+  xml += benchmark_sun();
+  xml += "<transform translate=\"0 -1 0\">\n" + benchmark_ground(40.0f) + "</transform>\n";
+  xml += "<shader name=\"hair\">\n";
+  xml += "<principled_hair_bsdf name=\"bsdf\" color=\"0.6 0.4 0.2\" />\n";
+  xml += "<connect from=\"bsdf bsdf\" to=\"output surface\" />\n";
+  xml += "</shader>\n";
+
+  vector<float3> P;
+  vector<int> nkeys;
+
+  for (int i = 0; i < num_strands; i++) {
+    float3 root = make_float3((benchmark_rng_float(&rng) - 0.5f) * 4.0f,
+                              -1.0f,
+                              2.0f + benchmark_rng_float(&rng) * 4.0f);
+    float phase = benchmark_rng_float(&rng) * M_2PI_F;
+    float length = 0.3f + benchmark_rng_float(&rng) * 0.5f;
+
+    for (int k = 0; k < num_keys; k++) {
+      float t = k / (float)(num_keys - 1);
+      float curl = 0.05f * t;
+      P.push_back(root + make_float3(cosf(phase + t * 6.0f) * curl,
+                                     t * length,
+                                     sinf(phase + t * 6.0f) * curl));
+    }
+    nkeys.push_back(num_keys);
+  }
+
+  xml += "<state shader=\"hair\">\n";
+  xml += string_printf("<curves radius=\"0.004\" P=\"%s\" nkeys=\"%s\" />\n",
+                       benchmark_float3_array(P).c_str(),
+                       benchmark_int_array(nkeys).c_str());
+  xml += "</state>\n";
+  xml += benchmark_footer();
+  return xml;
+}
+
+/* Plane filling the view with an emission shader driven by a single node, and
+ * no lights or bounces, to measure shading throughput of that node type. */
+static string benchmark_scene_shading(int width, int height, const char *node, const char *output)
+{
+  string xml = benchmark_header(width, height, 0.0f, 0.0f);
+  xml += "<shader name=\"shading\">\n";
+  xml += "<emission name=\"emission\" color=\"0.8 0.8 0.8\" strength=\"1\" />\n";
+  xml += "<connect from=\"emission emission\" to=\"output surface\" />\n";
+  if (node[0] != '\0') {
+    xml += string(node) + "\n";
+    xml += string_printf("<connect from=\"tex %s\" to=\"emission color\" />\n", output);
+  }
+  xml += "</shader>\n";
+
+  xml += "<state shader=\"shading\">\n";
+  xml += "<transform translate=\"0 0 5\" rotate=\"-90 1 0 0\">\n";
+  xml += benchmark_plane(40.0f, 1, "");
+  xml += "</transform>\n";
+  xml += "</state>\n";
+  xml += benchmark_footer();
+  return xml;
+}
+
+typedef string (*BenchmarkSceneFunc)(int width, int height);
+
+struct BenchmarkScene {
+  const char *name;
+  BenchmarkSceneFunc func;
+  /* Node and output socket for shading scenes, which have no scene function. */
+  const char *shading_node;
+  const char *shading_output;
+};
+
+static const BenchmarkScene benchmark_scenes[] = {
+    {"instances", benchmark_scene_instances},
+    {"displacement", benchmark_scene_displacement},
+    {"volume", benchmark_scene_volume},
+    {"lights", benchmark_scene_lights},
+    {"hair", benchmark_scene_hair},
+    {"shading_emission", NULL, "", ""},
+    {"shading_noise", NULL, "<noise_texture name=\"tex\" scale=\"5\" detail=\"4\" />", "color"},
+    {"shading_voronoi", NULL, "<voronoi_texture name=\"tex\" scale=\"5\" />", "color"},
+    {"shading_musgrave", NULL, "<musgrave_texture name=\"tex\" scale=\"5\" />", "fac"},
+    {"shading_wave", NULL, "<wave_texture name=\"tex\" scale=\"5\" />", "color"},
+    {"shading_magic", NULL, "<magic_texture name=\"tex\" scale=\"5\" />", "color"},
+    {"shading_checker", NULL, "<checker_texture name=\"tex\" scale=\"5\" />", "color"},
+    {"shading_brick", NULL, "<brick_texture name=\"tex\" scale=\"5\" />", "color"},
+    {"shading_gradient", NULL, "<gradient_texture name=\"tex\" />", "color"},
+    {"shading_white_noise", NULL, "<white_noise_texture name=\"tex\" />", "value"},
+};
+
+static const int benchmark_num_scenes = sizeof(benchmark_scenes) / sizeof(*benchmark_scenes);
+
+/* Benchmark Run */
+
+struct BenchmarkOptions {
+  vector<string> scenes;
+  string scene_dir;
+  string output_path;
+  int width, height;
+  bool quiet;
+  SceneParams scene_params;
+  SessionParams session_params;
+} options;
+
+struct BenchmarkResult {
+  string name;
+  double sync_time;
+  double tessellation_time;
+  double displacement_time;
+  double bvh_build_time;
+  double render_time;
+  double denoise_time;
+  double total_time;
+  uint64_t camera_rays;
+};
+
+static double benchmark_update_time(const RenderStats &stats, const string &name)
+{
+  double time = 0.0;
+  foreach (const NamedTimeEntry &entry, stats.update.entries) {
+    if (entry.name == name) {
+      time += entry.time;
+    }
+  }
+  return time;
+}
+
+static double benchmark_denoise_time(Profiler &profiler)
+{
+  /* The profiler samples the state of every render thread once per millisecond. */
+  uint64_t samples = 0;
+  for (int event = PROFILING_DENOISING; event <= PROFILING_DENOISING_DETECT_OUTLIERS; event++) {
+    samples += profiler.get_event((ProfilingEvent)event);
+  }
+  return samples * 1e-3;
+}
+
+static bool benchmark_run(const BenchmarkScene &bench, BenchmarkResult &result)
+{
+  string filepath = path_join(options.scene_dir, string(bench.name) + ".xml");
+  string xml = (bench.func) ? bench.func(options.width, options.height) :
+                              benchmark_scene_shading(options.width,
+                                                      options.height,
+                                                      bench.shading_node,
+                                                      bench.shading_output);
+  if (!path_write_text(filepath, xml)) {
+    fprintf(stderr, "Failed to write scene %s\n", filepath.c_str());
+    return false;
+  }
+
+  if (!options.quiet) {
+    fprintf(stderr, "Rendering %s\n", bench.name);
+  }
+
+  scoped_timer total_timer;
+  Session *session = new Session(options.session_params);
+
+  /* Sync */
+  scoped_timer sync_timer;
+  Scene *scene = new Scene(options.scene_params, session->device);
+  xml_read_file(scene, filepath.c_str());
+
+  scene->camera->width = options.width;
+  scene->camera->height = options.height;
+  scene->camera->compute_auto_viewplane();
+  scene->camera->need_update = true;
+
+  /* Dice subdivision surfaces from the render camera. */
+  *scene->dicing_camera = *scene->camera;
+
+  BufferParams buffer_params;
+  buffer_params.width = options.width;
+  buffer_params.height = options.height;
+  buffer_params.full_width = options.width;
+  buffer_params.full_height = options.height;
+  Pass::add(PASS_COMBINED, buffer_params.passes);
+
+  if (options.session_params.run_denoising) {
+    buffer_params.denoising_data_pass = true;
+    scene->film->denoising_data_pass = true;
+    session->tile_manager.schedule_denoising = true;
+  }
+
+  scene->film->tag_passes_update(scene, buffer_params.passes);
+  scene->film->tag_update(scene);
+  result.sync_time = sync_timer.get_time();
+
+  /* Render */
+  session->scene = scene;
+  session->reset(buffer_params, options.session_params.samples);
+  session->start();
+  session->wait();
+
+  if (session->progress.get_error()) {
+    fprintf(stderr,
+            "Failed to render %s: %s\n",
+            bench.name,
+            session->progress.get_error_message().c_str());
+    delete session;
+    return false;
+  }
+
+  double total_time, render_time;
+  session->progress.get_time(total_time, render_time);
+
+  RenderStats stats;
+  session->collect_statistics(&stats);
+
+  result.name = bench.name;
+  result.tessellation_time = benchmark_update_time(stats, "Tessellation");
+  result.displacement_time = benchmark_update_time(stats, "Displacement");
+  result.bvh_build_time = benchmark_update_time(stats, "BVH");
+  result.render_time = render_time;
+  result.denoise_time = benchmark_denoise_time(session->profiler);
+  result.camera_rays = (uint64_t)options.width * options.height *
+                       options.session_params.samples;
+
+  delete session;
+  result.total_time = total_timer.get_time();
+
+  return true;
+}
+
+static string benchmark_json(const vector<BenchmarkResult> &results)
+{
+  const SessionParams &params = options.session_params;
+  string json = "{\n";
+  json += string_printf("  \"version\": \"%s\",\n", CYCLES_VERSION_STRING);
+  json += string_printf("  \"device\": \"%s\",\n", params.device.description.c_str());
+  json += string_printf("  \"threads\": %d,\n", TaskScheduler::num_threads());
+  json += string_printf("  \"samples\": %d,\n", params.samples);
+  json += string_printf("  \"width\": %d,\n", options.width);
+  json += string_printf("  \"height\": %d,\n", options.height);
+  json += string_printf("  \"denoise\": %s,\n", (params.run_denoising) ? "true" : "false");
+  json += string_printf("  \"split_kernel\": %s,\n",
+                        (DebugFlags().cpu.split_kernel) ? "true" : "false");
+  json += "  \"scenes\": [\n";
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchmarkResult &result = results[i];
+    double rays_per_second = (result.render_time > 0.0) ?
+                                 result.camera_rays / result.render_time :
+                                 0.0;
+
+    json += "    {\n";
+    json += string_printf("      \"name\": \"%s\",\n", result.name.c_str());
+    json += string_printf("      \"sync\": %.4f,\n", result.sync_time);
+    json += string_printf("      \"tessellation\": %.4f,\n", result.tessellation_time);
+    json += string_printf("      \"displacement\": %.4f,\n", result.displacement_time);
+    json += string_printf("      \"bvh_build\": %.4f,\n", result.bvh_build_time);
+    json += string_printf("      \"render\": %.4f,\n", result.render_time);
+    json += string_printf("      \"denoise\": %.4f,\n", result.denoise_time);
+    json += string_printf("      \"total\": %.4f,\n", result.total_time);
+    json += string_printf("      \"camera_rays\": %llu,\n",
+                          (unsigned long long)result.camera_rays);
+    json += string_printf("      \"rays_per_second\": %.1f\n", rays_per_second);
+    json += (i + 1 < results.size()) ? "    },\n" : "    }\n";
+  }
+
+  json += "  ]\n";
+  json += "}\n";
+  return json;
+}
+
+/* Options */
+
+static int scenes_parse(int argc, const char *argv[])
+{
+  for (int i = 0; i < argc; i++) {
+    options.scenes.push_back(argv[i]);
+  }
+
+  return 0;
+}
+
+static void options_parse(int argc, const char **argv)
+{
+  options.width = 640;
+  options.height = 360;
+  options.quiet = false;
+  options.scene_dir = path_cache_get("benchmark");
+  options.session_params.samples = 16;
+
+  bool list = false;
+  bool denoise = false;
+  bool split_kernel = false;
+
+  string scene_names;
+  for (int i = 0; i < benchmark_num_scenes; i++) {
+    scene_names += string((i == 0) ? "" : ", ") + benchmark_scenes[i].name;
+  }
+
+  ArgParse ap;
+  bool help = false, debug = false, version = false;
+  int verbosity = 1;
+
+  ap.options("Usage: cycles_benchmark [options] [scene ...]",
+             "%*",
+             scenes_parse,
+             ("Scenes to render, all by default: " + scene_names).c_str(),
+             "--samples %d",
+             &options.session_params.samples,
+             "Number of samples to render",
+             "--threads %d",
+             &options.session_params.threads,
+             "CPU Rendering Threads",
+             "--width %d",
+             &options.width,
+             "Image width in pixels",
+             "--height %d",
+             &options.height,
+             "Image height in pixels",
+             "--tile-width %d",
+             &options.session_params.tile_size.x,
+             "Tile width in pixels",
+             "--tile-height %d",
+             &options.session_params.tile_size.y,
+             "Tile height in pixels",
+             "--scene-cache %s",
+             &options.scene_params.cache_path,
+             "Directory to cache compiled shaders and scene preprocessing in between runs",
+             "--denoise",
+             &denoise,
+             "Denoise the render result",
+             "--split-kernel",
+             &split_kernel,
+             "Use the split kernel, tracing paths in batches sorted by shader",
+             "--output %s",
+             &options.output_path,
+             "File path to write JSON results to, standard output by default",
+             "--scene-dir %s",
+             &options.scene_dir,
+             "Directory to write the generated XML scenes to",
+             "--list",
+             &list,
+             "List available scenes",
+             "--quiet",
+             &options.quiet,
+             "Don't print progress messages",
+#ifdef WITH_CYCLES_LOGGING
+             "--debug",
+             &debug,
+             "Enable debug logging",
+             "--verbose %d",
+             &verbosity,
+             "Set verbosity of the logger",
+#endif
+             "--help",
+             &help,
+             "Print help message",
+             "--version",
+             &version,
+             "Print version number",
+             NULL);
+
+  if (ap.parse(argc, argv) < 0) {
+    fprintf(stderr, "%s\n", ap.geterror().c_str());
+    ap.usage();
+    exit(EXIT_FAILURE);
+  }
+
+  if (debug) {
+    util_logging_start();
+    util_logging_verbosity_set(verbosity);
+  }
+
+  if (list) {
+    for (int i = 0; i < benchmark_num_scenes; i++) {
+      printf("%s\n", benchmark_scenes[i].name);
+    }
+    exit(EXIT_SUCCESS);
+  }
+  else if (version) {
+    printf("%s\n", CYCLES_VERSION_STRING);
+    exit(EXIT_SUCCESS);
+  }
+  else if (help) {
+    ap.usage();
+    exit(EXIT_SUCCESS);
+  }
+
+  if (options.session_params.samples <= 0) {
+    fprintf(stderr, "Invalid number of samples: %d\n", options.session_params.samples);
+    exit(EXIT_FAILURE);
+  }
+  else if (options.width <= 0 || options.height <= 0) {
+    fprintf(stderr, "Invalid resolution: %dx%d\n", options.width, options.height);
+    exit(EXIT_FAILURE);
+  }
+
+  foreach (const string &name, options.scenes) {
+    bool found = false;
+    for (int i = 0; i < benchmark_num_scenes; i++) {
+      found |= (name == benchmark_scenes[i].name);
+    }
+    if (!found) {
+      fprintf(stderr, "Unknown scene: %s\n", name.c_str());
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  /* Always render on the CPU, the benchmark is meant to run without a GPU. */
+  vector<DeviceInfo> devices = Device::available_devices(DEVICE_MASK_CPU);
+  if (devices.empty()) {
+    fprintf(stderr, "No CPU device available\n");
+    exit(EXIT_FAILURE);
+  }
+
+  SessionParams &params = options.session_params;
+  params.device = devices.front();
+  params.background = true;
+  params.progressive = false;
+  params.use_profiling = true;
+  params.run_denoising = denoise;
+  params.full_denoising = denoise;
+
+  if (split_kernel) {
+    DebugFlags().cpu.split_kernel = true;
+  }
+}
+
+CCL_NAMESPACE_END
+
+using namespace ccl;
+
+int main(int argc, const char **argv)
+{
+  util_logging_init(argv[0]);
+  path_init();
+  options_parse(argc, argv);
+
+  vector<BenchmarkResult> results;
+  bool success = true;
+
+  for (int i = 0; i < benchmark_num_scenes; i++) {
+    const BenchmarkScene &bench = benchmark_scenes[i];
+    if (!options.scenes.empty() &&
+        std::find(options.scenes.begin(), options.scenes.end(), bench.name) ==
+            options.scenes.end()) {
+      continue;
+    }
+
+    BenchmarkResult result;
+    if (benchmark_run(bench, result)) {
+      results.push_back(result);
+    }
+    else {
+      success = false;
+    }
+  }
+
+  string json = benchmark_json(results);
+  if (options.output_path.empty()) {
+    printf("%s", json.c_str());
+  }
+  else if (!path_write_text(options.output_path, json)) {
+    fprintf(stderr, "Failed to write %s\n", options.output_path.c_str());
+    return EXIT_FAILURE;
+  }
+
+  return (success) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
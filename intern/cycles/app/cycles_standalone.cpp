@@ -431,6 +431,9 @@ static void options_parse(int argc, const char **argv)
              "--tile-height %d",
              &options.session_params.tile_size.y,
              "Tile height in pixels",
+             "--scene-cache %s",
+             &options.scene_params.cache_path,
+             "Directory to cache compiled shaders and scene preprocessing in between runs",
              "--list-devices",
              &list,
              "List information about all available devices",
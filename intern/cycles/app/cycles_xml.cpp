@@ -393,6 +393,12 @@ static void xml_read_mesh(const XMLReadState &state, xml_node node)
   Mesh *mesh = xml_add_mesh(state.scene, state.tfm);
   mesh->used_shaders.push_back(state.shader);
 
+  /* named meshes can be instanced */
+  string name;
+  if (xml_read_string(&name, node, "name")) {
+    mesh->name = ustring(name);
+  }
+
   /* read state */
   int shader = 0;
   bool smooth = state.smooth;
@@ -529,6 +535,79 @@ static void xml_read_mesh(const XMLReadState &state, xml_node node)
   }
 }
 
+/* Curves */
+
+static void xml_read_curves(const XMLReadState &state, xml_node node)
+{
+  /* read keys and curves */
+  vector<float3> P;
+  vector<float> radius;
+  vector<int> nkeys;
+
+  xml_read_float3_array(P, node, "P");
+  xml_read_float_array(radius, node, "radius");
+  xml_read_int_array(nkeys, node, "nkeys");
+
+  size_t num_keys = 0;
+  for (size_t i = 0; i < nkeys.size(); i++) {
+    if (nkeys[i] < 0) {
+      fprintf(stderr, "Curves with negative \"nkeys\".\n");
+      return;
+    }
+    num_keys += nkeys[i];
+  }
+
+  if (num_keys > P.size()) {
+    fprintf(stderr, "Curves \"nkeys\" add up to more keys than in \"P\".\n");
+    return;
+  }
+
+  /* add mesh */
+  Mesh *mesh = xml_add_mesh(state.scene, state.tfm);
+  mesh->used_shaders.push_back(state.shader);
+
+  mesh->reserve_curves(nkeys.size(), P.size());
+
+  /* either one radius per key, or a single radius for all keys */
+  bool key_radius = (radius.size() == P.size());
+  float default_radius = (radius.empty()) ? 0.01f : radius[0];
+  int key_offset = 0;
+
+  for (size_t i = 0; i < nkeys.size(); i++) {
+    mesh->add_curve(key_offset, 0);
+
+    for (int j = 0; j < nkeys[i]; j++) {
+      float r = (key_radius) ? radius[key_offset] : default_radius;
+      mesh->add_curve_key(P[key_offset], r);
+      key_offset++;
+    }
+  }
+}
+
+/* Instance */
+
+static void xml_read_instance(const XMLReadState &state, xml_node node)
+{
+  string name;
+
+  if (!xml_read_string(&name, node, "mesh")) {
+    fprintf(stderr, "Instance missing \"mesh\" attribute.\n");
+    return;
+  }
+
+  foreach (Mesh *mesh, state.scene->meshes) {
+    if (mesh->name == name) {
+      Object *object = new Object();
+      object->mesh = mesh;
+      object->tfm = state.tfm;
+      state.scene->objects.push_back(object);
+      return;
+    }
+  }
+
+  fprintf(stderr, "Unknown mesh \"%s\".\n", name.c_str());
+}
+
 /* Light */
 
 static void xml_read_light(XMLReadState &state, xml_node node)
@@ -628,6 +707,12 @@ static void xml_read_scene(XMLReadState &state, xml_node scene_node)
     else if (string_iequals(node.name(), "mesh")) {
       xml_read_mesh(state, node);
     }
+    else if (string_iequals(node.name(), "curves")) {
+      xml_read_curves(state, node);
+    }
+    else if (string_iequals(node.name(), "instance")) {
+      xml_read_instance(state, node);
+    }
     else if (string_iequals(node.name(), "light")) {
       xml_read_light(state, node);
     }
@@ -31,6 +31,8 @@
 #include "util/util_foreach.h"
 #include "util/util_logging.h"
 #include "util/util_math.h"
+#include "util/util_md5.h"
+#include "util/util_task.h"
 
 #include "mikktspace.h"
 
@@ -912,12 +914,160 @@ static void sync_mesh_fluid_motion(BL::Object &b_ob, Scene *scene, Mesh *mesh)
   }
 }
 
+/* Mesh data of the previous sync, to decide between BVH rebuild and refit
+ * once the new data is converted. */
+
+struct MeshSyncState {
+  MeshSyncState(BL::Object &b_ob, void *key, Mesh *mesh) : b_ob(b_ob), key(key), mesh(mesh)
+  {
+  }
+
+  BL::Object b_ob;
+  void *key;
+  Mesh *mesh;
+
+  array<int> triangles;
+  array<Mesh::SubdFace> subd_faces;
+  array<int> subd_face_corners;
+
+  /* compares curve_keys rather than strands in order to handle quick hair
+   * adjustments in dynamic BVH - other methods could probably do this better*/
+  array<float3> curve_keys;
+  array<float> curve_radius;
+
+  /* ensure bvh rebuild (instead of refit) if has_voxel_attributes() changed */
+  bool has_voxel_attributes;
+};
+
+/* Persistent Data */
+
+static void mesh_hash_append(MD5Hash &md5, const void *data, size_t size)
+{
+  /* MD5Hash takes an int size, append large buffers in chunks. */
+  const uint8_t *bytes = (const uint8_t *)data;
+  const size_t chunk_size = 1 << 30;
+
+  while (size > 0) {
+    const size_t num_bytes = min(size, chunk_size);
+    md5.append(bytes, (int)num_bytes);
+    bytes += num_bytes;
+    size -= num_bytes;
+  }
+}
+
+template<typename T> static void mesh_hash_append(MD5Hash &md5, const array<T> &data)
+{
+  const size_t size = data.size();
+  mesh_hash_append(md5, &size, sizeof(size));
+  if (size) {
+    mesh_hash_append(md5, data.data(), size * sizeof(T));
+  }
+}
+
+static void mesh_hash_append(MD5Hash &md5, const AttributeSet &attributes)
+{
+  foreach (const Attribute &attr, attributes.attributes) {
+    md5.append(attr.name.string());
+    mesh_hash_append(md5, &attr.element, sizeof(attr.element));
+
+    const size_t size = attr.buffer.size();
+    mesh_hash_append(md5, &size, sizeof(size));
+    if (size) {
+      mesh_hash_append(md5, &attr.buffer[0], size);
+    }
+  }
+}
+
+static string mesh_geometry_hash(const Mesh *mesh)
+{
+  MD5Hash md5;
+
+  mesh_hash_append(md5, mesh->verts);
+  mesh_hash_append(md5, mesh->triangles);
+  mesh_hash_append(md5, mesh->shader);
+  mesh_hash_append(md5, mesh->smooth);
+
+  mesh_hash_append(md5, mesh->subd_faces);
+  mesh_hash_append(md5, mesh->subd_face_corners);
+
+  mesh_hash_append(md5, mesh->curve_keys);
+  mesh_hash_append(md5, mesh->curve_radius);
+  mesh_hash_append(md5, mesh->curve_first_key);
+  mesh_hash_append(md5, mesh->curve_shader);
+
+  mesh_hash_append(md5, mesh->attributes);
+  mesh_hash_append(md5, mesh->curve_attributes);
+  mesh_hash_append(md5, mesh->subd_attributes);
+
+  return md5.get_hex();
+}
+
+static void persistent_mesh_erase(map<string, Mesh *> &meshes, const string &key, Mesh *mesh)
+{
+  map<string, Mesh *>::iterator it = meshes.find(key);
+  if (it != meshes.end() && it->second == mesh) {
+    meshes.erase(it);
+  }
+}
+
+Mesh *BlenderSync::sync_mesh_persistent(void *key, Mesh *mesh, bool *rebuild)
+{
+  /* Reuse the mesh of the previous frame when the geometry is exactly the same,
+   * including its BVH. Not done for cases where the mesh is modified in place
+   * after sync, or depends on more than the hashed data. */
+  map<string, Mesh *>::iterator it = persistent_meshes.find(mesh->geometry_hash);
+
+  if (it != persistent_meshes.end()) {
+    Mesh *prev = it->second;
+
+    if (prev->used_shaders == mesh->used_shaders && !prev->transform_applied &&
+        !mesh->has_voxel_attributes() && !mesh->has_true_displacement() &&
+        !mesh->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION) &&
+        mesh->subdivision_type == Mesh::SUBDIVISION_NONE &&
+        scene->need_motion() != Scene::MOTION_BLUR) {
+      persistent_mesh_erase(persistent_meshes, prev->geometry_hash, prev);
+      persistent_mesh_erase(persistent_mesh_names, prev->name.string(), prev);
+
+      /* The mesh synced for the key is removed in post_sync(). */
+      mesh_map.remap(key, prev);
+      mesh_synced.erase(mesh);
+      mesh_synced.insert(prev);
+
+      return prev;
+    }
+  }
+
+  /* Otherwise take over the BVH of the mesh with the same name, so it can be
+   * refit rather than rebuilt when only the vertex positions changed. */
+  if (mesh->subdivision_type == Mesh::SUBDIVISION_NONE && mesh->num_curves() == 0) {
+    it = persistent_mesh_names.find(mesh->name.string());
+
+    if (it != persistent_mesh_names.end()) {
+      Mesh *prev = it->second;
+
+      if (prev->bvh && prev->num_curves() == 0 && prev->triangles == mesh->triangles &&
+          prev->has_voxel_attributes() == mesh->has_voxel_attributes()) {
+        persistent_mesh_erase(persistent_meshes, prev->geometry_hash, prev);
+        persistent_mesh_erase(persistent_mesh_names, prev->name.string(), prev);
+
+        mesh->bvh = prev->bvh;
+        prev->bvh = NULL;
+        *rebuild = false;
+        return mesh;
+      }
+    }
+  }
+
+  return mesh;
+}
+
 Mesh *BlenderSync::sync_mesh(BL::Depsgraph &b_depsgraph,
                              BL::Object &b_ob,
                              BL::Object &b_ob_instance,
                              bool object_updated,
                              bool show_self,
-                             bool show_particles)
+                             bool show_particles,
+                             TaskPool *geom_task_pool)
 {
   /* test if we can instance or if the object is modified */
   BL::ID b_ob_data = b_ob.data();
@@ -983,31 +1133,21 @@ Mesh *BlenderSync::sync_mesh(BL::Depsgraph &b_depsgraph,
   if (mesh_synced.find(mesh) != mesh_synced.end())
     return mesh;
 
-  progress.set_sync_status("Synchronizing object", b_ob.name());
-
   mesh_synced.insert(mesh);
 
   /* create derived mesh */
-  array<int> oldtriangles;
-  array<Mesh::SubdFace> oldsubd_faces;
-  array<int> oldsubd_face_corners;
-  oldtriangles.steal_data(mesh->triangles);
-  oldsubd_faces.steal_data(mesh->subd_faces);
-  oldsubd_face_corners.steal_data(mesh->subd_face_corners);
-
-  /* compares curve_keys rather than strands in order to handle quick hair
-   * adjustments in dynamic BVH - other methods could probably do this better*/
-  array<float3> oldcurve_keys;
-  array<float> oldcurve_radius;
-  oldcurve_keys.steal_data(mesh->curve_keys);
-  oldcurve_radius.steal_data(mesh->curve_radius);
-
-  /* ensure bvh rebuild (instead of refit) if has_voxel_attributes() changed */
-  bool oldhas_voxel_attributes = mesh->has_voxel_attributes();
+  MeshSyncState *state = new MeshSyncState(b_ob, key.ptr.owner_id, mesh);
+  state->triangles.steal_data(mesh->triangles);
+  state->subd_faces.steal_data(mesh->subd_faces);
+  state->subd_face_corners.steal_data(mesh->subd_face_corners);
+  state->curve_keys.steal_data(mesh->curve_keys);
+  state->curve_radius.steal_data(mesh->curve_radius);
+  state->has_voxel_attributes = mesh->has_voxel_attributes();
 
   mesh->clear();
   mesh->used_shaders = used_shaders;
   mesh->name = ustring(b_ob_data.name().c_str());
+  mesh->geometry_flags = requested_geometry_flags;
 
   if (requested_geometry_flags != Mesh::GEOMETRY_NONE) {
     /* Adaptive subdivision setup. Not for baking since that requires
@@ -1018,7 +1158,45 @@ Mesh *BlenderSync::sync_mesh(BL::Depsgraph &b_depsgraph,
     else {
       mesh->subdivision_type = object_subdivision_type(b_ob, preview, experimental);
     }
+  }
+
+  if (geom_task_pool) {
+    /* Convert in a task, object sync only needs to know the mesh is updated.
+     * Finished in sync_objects() once all conversion tasks are done. */
+    mesh->need_update = true;
+    mesh_sync_queue.push_back(state);
+
+    geom_task_pool->push(function_bind(&BlenderSync::sync_mesh_data,
+                                       this,
+                                       b_depsgraph,
+                                       b_ob,
+                                       mesh,
+                                       requested_geometry_flags,
+                                       show_self,
+                                       show_particles));
+    return mesh;
+  }
+
+  sync_mesh_data(
+      b_depsgraph, b_ob, mesh, requested_geometry_flags, show_self, show_particles);
+
+  return sync_mesh_finish(state);
+}
+
+void BlenderSync::sync_mesh_data(BL::Depsgraph &b_depsgraph,
+                                 BL::Object &b_ob,
+                                 Mesh *mesh,
+                                 int requested_geometry_flags,
+                                 bool show_self,
+                                 bool show_particles)
+{
+  /* May run in parallel with other meshes, only mesh itself is written to. */
+  if (progress.get_cancel())
+    return;
 
+  progress.set_sync_status("Synchronizing object", b_ob.name());
+
+  if (requested_geometry_flags != Mesh::GEOMETRY_NONE) {
     /* For some reason, meshes do not need this... */
     bool need_undeformed = mesh->need_attribute(scene, ATTR_STD_GENERATED);
 
@@ -1029,9 +1207,10 @@ Mesh *BlenderSync::sync_mesh(BL::Depsgraph &b_depsgraph,
       /* Sync mesh itself. */
       if (view_layer.use_surfaces && show_self) {
         if (mesh->subdivision_type != Mesh::SUBDIVISION_NONE)
-          create_subd_mesh(scene, mesh, b_ob, b_mesh, used_shaders, dicing_rate, max_subdivisions);
+          create_subd_mesh(
+              scene, mesh, b_ob, b_mesh, mesh->used_shaders, dicing_rate, max_subdivisions);
         else
-          create_mesh(scene, mesh, b_mesh, used_shaders, false);
+          create_mesh(scene, mesh, b_mesh, mesh->used_shaders, false);
 
         create_mesh_volume_attributes(scene, b_ob, mesh, b_scene.frame_current());
       }
@@ -1045,22 +1224,75 @@ Mesh *BlenderSync::sync_mesh(BL::Depsgraph &b_depsgraph,
       free_object_to_mesh(b_data, b_ob, b_mesh);
     }
   }
-  mesh->geometry_flags = requested_geometry_flags;
 
-  /* fluid motion */
-  sync_mesh_fluid_motion(b_ob, scene, mesh);
+  /* hash for reuse with persistent data */
+  if (scene->params.persistent_data) {
+    mesh->geometry_hash = mesh_geometry_hash(mesh);
+  }
+}
+
+Mesh *BlenderSync::sync_mesh_finish(MeshSyncState *state)
+{
+  Mesh *mesh = state->mesh;
+
+  /* fluid motion, not in parallel since the motion steps are set by object sync */
+  sync_mesh_fluid_motion(state->b_ob, scene, mesh);
 
   /* tag update */
-  bool rebuild = (oldtriangles != mesh->triangles) || (oldsubd_faces != mesh->subd_faces) ||
-                 (oldsubd_face_corners != mesh->subd_face_corners) ||
-                 (oldcurve_keys != mesh->curve_keys) || (oldcurve_radius != mesh->curve_radius) ||
-                 (oldhas_voxel_attributes != mesh->has_voxel_attributes());
+  bool rebuild = (state->triangles != mesh->triangles) ||
+                 (state->subd_faces != mesh->subd_faces) ||
+                 (state->subd_face_corners != mesh->subd_face_corners) ||
+                 (state->curve_keys != mesh->curve_keys) ||
+                 (state->curve_radius != mesh->curve_radius) ||
+                 (state->has_voxel_attributes != mesh->has_voxel_attributes());
+
+  /* keys change for every frame with persistent data, find matching data
+   * of the previous frame */
+  if (scene->params.persistent_data && mesh->bvh == NULL) {
+    Mesh *persistent_mesh = sync_mesh_persistent(state->key, mesh, &rebuild);
+    if (persistent_mesh != mesh) {
+      delete state;
+      return persistent_mesh;
+    }
+  }
 
   mesh->tag_update(scene, rebuild);
 
+  delete state;
   return mesh;
 }
 
+/* Finish meshes converted in parallel, which may replace them by meshes of
+ * the previous frame with persistent data. */
+
+void BlenderSync::sync_mesh_queue()
+{
+  map<Mesh *, Mesh *> replaced_meshes;
+
+  foreach (MeshSyncState *state, mesh_sync_queue) {
+    Mesh *mesh = state->mesh;
+    Mesh *synced_mesh = sync_mesh_finish(state);
+
+    if (synced_mesh != mesh) {
+      /* motion settings were set by object sync in the meantime */
+      synced_mesh->use_motion_blur = mesh->use_motion_blur;
+      synced_mesh->motion_steps = mesh->motion_steps;
+      replaced_meshes[mesh] = synced_mesh;
+    }
+  }
+
+  mesh_sync_queue.clear();
+
+  if (!replaced_meshes.empty()) {
+    foreach (Object *object, scene->objects) {
+      map<Mesh *, Mesh *>::iterator it = replaced_meshes.find(object->mesh);
+      if (it != replaced_meshes.end()) {
+        object->mesh = it->second;
+      }
+    }
+  }
+}
+
 void BlenderSync::sync_mesh_motion(BL::Depsgraph &b_depsgraph,
                                    BL::Object &b_ob,
                                    Object *object,
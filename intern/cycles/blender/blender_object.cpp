@@ -32,6 +32,7 @@
 #include "util/util_foreach.h"
 #include "util/util_hash.h"
 #include "util/util_logging.h"
+#include "util/util_task.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -299,7 +300,8 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
                                  bool show_particles,
                                  bool show_lights,
                                  BlenderObjectCulling &culling,
-                                 bool *use_portal)
+                                 bool *use_portal,
+                                 TaskPool *geom_task_pool)
 {
   const bool is_instance = b_instance.is_instance();
   BL::Object b_ob = b_instance.object();
@@ -407,8 +409,13 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
     object_updated = true;
 
   /* mesh sync */
-  object->mesh = sync_mesh(
-      b_depsgraph, b_ob, b_ob_instance, object_updated, show_self, show_particles);
+  object->mesh = sync_mesh(b_depsgraph,
+                           b_ob,
+                           b_ob_instance,
+                           object_updated,
+                           show_self,
+                           show_particles,
+                           geom_task_pool);
 
   /* special case not tracked by object update flags */
 
@@ -538,6 +545,11 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
   /* initialize culling */
   BlenderObjectCulling culling(scene, b_scene);
 
+  /* mesh conversion runs in parallel with the object loop, motion sync only
+   * updates meshes that were already converted so it remains serial */
+  TaskPool geom_task_pool;
+  scoped_timer objects_timer;
+
   /* object loop */
   bool cancel = false;
   bool use_portal = false;
@@ -570,12 +582,24 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
                   show_particles,
                   show_lights,
                   culling,
-                  &use_portal);
+                  &use_portal,
+                  (motion) ? NULL : &geom_task_pool);
     }
 
     cancel = progress.get_cancel();
   }
 
+  if (!motion) {
+    progress.add_sync_time("Objects", objects_timer.get_time());
+
+    /* Time not overlapping with the object loop. */
+    scoped_timer geometry_timer;
+    progress.set_sync_status("Synchronizing geometry");
+    geom_task_pool.wait_work();
+    sync_mesh_queue();
+    progress.add_sync_time("Geometry", geometry_timer.get_time());
+  }
+
   progress.set_sync_status("");
 
   if (!cancel && !motion) {
@@ -238,8 +238,9 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
   /* There is no single depsgraph to use for the entire render.
    * See note on create_session().
    */
-  /* sync object should be re-created */
-  sync = new BlenderSync(b_engine, b_data, b_scene, scene, !background, session->progress);
+  /* sync object is kept with persistent data, so the meshes and BVHs of the
+   * previous frame can be reused, only its keys need to be reset */
+  sync->reset(b_data, b_scene);
 
   BL::SpaceView3D b_null_space_view3d(PointerRNA_NULL);
   BL::RegionView3D b_null_region_view3d(PointerRNA_NULL);
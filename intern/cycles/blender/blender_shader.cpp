@@ -1236,6 +1236,17 @@ void BlenderSync::sync_materials(BL::Depsgraph &b_depsgraph, bool update_all)
     BL::Material b_mat(*b_id);
     Shader *shader;
 
+    /* take over shader of the previous frame with persistent data, the
+     * graph is still synced as the material may be animated */
+    if (scene->params.persistent_data && !shader_map.find(b_mat)) {
+      map<string, Shader *>::iterator it = persistent_shaders.find(b_mat.name());
+      if (it != persistent_shaders.end()) {
+        shader_map.remap(b_mat.ptr.owner_id, it->second);
+        shader_map.set_recalc(b_mat);
+        persistent_shaders.erase(it);
+      }
+    }
+
     /* test if we need to sync */
     if (shader_map.sync(&shader, b_mat) || shader->need_sync_object || update_all) {
       ShaderGraph *graph = new ShaderGraph();
@@ -1293,6 +1304,10 @@ void BlenderSync::sync_materials(BL::Depsgraph &b_depsgraph, bool update_all)
         shader->tag_update(scene);
       }
     }
+
+    if (scene->params.persistent_data) {
+      persistent_shaders[b_mat.name()] = shader;
+    }
   }
 
   pool.wait_work();
@@ -38,6 +38,7 @@
 #include "util/util_foreach.h"
 #include "util/util_opengl.h"
 #include "util/util_hash.h"
+#include "util/util_time.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -78,6 +79,46 @@ BlenderSync::~BlenderSync()
 {
 }
 
+void BlenderSync::reset(BL::BlendData &b_data, BL::Scene &b_scene)
+{
+  /* Update data and scene pointers, which change with the depsgraph of
+   * every frame rendered with persistent data. */
+  this->b_data = b_data;
+  this->b_scene = b_scene;
+
+  /* The depsgraph of the previous frame is freed by now, so the pointers used
+   * as keys are no longer valid. Remember the data synced for them, so the
+   * new keys can take it over when it did not change. */
+  persistent_meshes.clear();
+  persistent_mesh_names.clear();
+
+  foreach (Mesh *mesh, scene->meshes) {
+    if (!mesh->geometry_hash.empty()) {
+      persistent_meshes.insert(make_pair(mesh->geometry_hash, mesh));
+      persistent_mesh_names.insert(make_pair(mesh->name.string(), mesh));
+    }
+  }
+
+  const set<Shader *> shaders(scene->shaders.begin(), scene->shaders.end());
+  for (map<string, Shader *>::iterator it = persistent_shaders.begin();
+       it != persistent_shaders.end();) {
+    if (shaders.find(it->second) == shaders.end()) {
+      persistent_shaders.erase(it++);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  shader_map.clear_keys();
+  object_map.clear_keys();
+  mesh_map.clear_keys();
+  light_map.clear_keys();
+  particle_system_map.clear_keys();
+  world_map = NULL;
+  world_recalc = true;
+}
+
 /* Sync */
 
 void BlenderSync::sync_recalc(BL::Depsgraph &b_depsgraph, BL::SpaceView3D &b_v3d)
@@ -207,17 +248,30 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
   sync_view_layer(b_v3d, b_view_layer);
   sync_integrator();
   sync_film(b_v3d);
-  sync_shaders(b_depsgraph, b_v3d);
-  sync_images();
+  {
+    scoped_timer timer;
+    sync_shaders(b_depsgraph, b_v3d);
+    progress.add_sync_time("Shaders", timer.get_time());
+  }
+  {
+    scoped_timer timer;
+    sync_images();
+    progress.add_sync_time("Images", timer.get_time());
+  }
   sync_curve_settings();
 
   mesh_synced.clear(); /* use for objects and motion sync */
 
+  /* objects and geometry times are added by sync_objects() */
   if (scene->need_motion() == Scene::MOTION_PASS || scene->need_motion() == Scene::MOTION_NONE ||
       scene->camera->motion_position == Camera::MOTION_POSITION_CENTER) {
     sync_objects(b_depsgraph, b_v3d);
   }
-  sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
+  {
+    scoped_timer timer;
+    sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
+    progress.add_sync_time("Motion", timer.get_time());
+  }
 
   mesh_synced.clear();
 
@@ -672,7 +726,14 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene, bool background)
   else if (shadingsystem == 1)
     params.shadingsystem = SHADINGSYSTEM_OSL;
 
-  if (background || DebugFlags().viewport_static_bvh)
+  if (background && params.shadingsystem != SHADINGSYSTEM_OSL)
+    params.persistent_data = r.use_persistent_data();
+  else
+    params.persistent_data = false;
+
+  /* Persistent data keeps a BVH per mesh, so unchanged meshes do not need
+   * to be rebuilt for every frame, only the top level BVH. */
+  if ((background && !params.persistent_data) || DebugFlags().viewport_static_bvh)
     params.bvh_type = SceneParams::BVH_STATIC;
   else
     params.bvh_type = SceneParams::BVH_DYNAMIC;
@@ -681,10 +742,14 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene, bool background)
   params.use_bvh_unaligned_nodes = RNA_boolean_get(&cscene, "debug_use_hair_bvh");
   params.num_bvh_time_steps = RNA_int_get(&cscene, "debug_bvh_time_steps");
 
-  if (background && params.shadingsystem != SHADINGSYSTEM_OSL)
-    params.persistent_data = r.use_persistent_data();
-  else
-    params.persistent_data = false;
+  /* Render farms can share compiled shaders and scene preprocessing between
+   * jobs rendering the same scene, through a cache directory. */
+  if (background) {
+    const char *cache_path = getenv("CYCLES_SCENE_CACHE");
+    if (cache_path != NULL) {
+      params.cache_path = cache_path;
+    }
+  }
 
   int texture_limit;
   if (background) {
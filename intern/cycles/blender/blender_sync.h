@@ -42,6 +42,7 @@ class Camera;
 class Film;
 class Light;
 class Mesh;
+struct MeshSyncState;
 class Object;
 class ParticleSystem;
 class Scene;
@@ -49,6 +50,7 @@ class ViewLayer;
 class Shader;
 class ShaderGraph;
 class ShaderNode;
+class TaskPool;
 
 class BlenderSync {
  public:
@@ -60,6 +62,8 @@ class BlenderSync {
               Progress &progress);
   ~BlenderSync();
 
+  void reset(BL::BlendData &b_data, BL::Scene &b_scene);
+
   /* sync */
   void sync_recalc(BL::Depsgraph &b_depsgraph, BL::SpaceView3D &b_v3d);
   void sync_data(BL::RenderSettings &b_render,
@@ -128,7 +132,17 @@ class BlenderSync {
                   BL::Object &b_ob_instance,
                   bool object_updated,
                   bool show_self,
-                  bool show_particles);
+                  bool show_particles,
+                  TaskPool *geom_task_pool);
+  void sync_mesh_data(BL::Depsgraph &b_depsgraph,
+                      BL::Object &b_ob,
+                      Mesh *mesh,
+                      int requested_geometry_flags,
+                      bool show_self,
+                      bool show_particles);
+  Mesh *sync_mesh_finish(MeshSyncState *state);
+  void sync_mesh_queue();
+  Mesh *sync_mesh_persistent(void *key, Mesh *mesh, bool *rebuild);
   void sync_curves(
       Mesh *mesh, BL::Mesh &b_mesh, BL::Object &b_ob, bool motion, int motion_step = 0);
   Object *sync_object(BL::Depsgraph &b_depsgraph,
@@ -139,7 +153,8 @@ class BlenderSync {
                       bool show_particles,
                       bool show_lights,
                       BlenderObjectCulling &culling,
-                      bool *use_portal);
+                      bool *use_portal,
+                      TaskPool *geom_task_pool);
   void sync_light(BL::Object &b_parent,
                   int persistent_id[OBJECT_PERSISTENT_ID_SIZE],
                   BL::Object &b_ob,
@@ -184,6 +199,13 @@ class BlenderSync {
   id_map<ParticleSystemKey, ParticleSystem> particle_system_map;
   set<Mesh *> mesh_synced;
   set<Mesh *> mesh_motion_synced;
+  /* Meshes converted in parallel, finished once all conversion tasks are done. */
+  vector<MeshSyncState *> mesh_sync_queue;
+  /* Meshes and material shaders of the previous frame with persistent data,
+   * which can be taken over by the keys of the new frame. */
+  map<string, Mesh *> persistent_meshes;
+  map<string, Mesh *> persistent_mesh_names;
+  map<string, Shader *> persistent_shaders;
   set<float> motion_times;
   void *world_map;
   bool world_recalc;
@@ -673,6 +673,30 @@ template<typename K, typename T> class id_map {
     b_map[NULL] = data;
   }
 
+  /* Map key to data that already exists in the scene, replacing any data
+   * that was synced for the key before. The replaced data is removed on
+   * post_sync() unless it is used by another key. */
+  void remap(const K &key, T *data)
+  {
+    T *prev_data = find(key);
+    if (prev_data) {
+      used_set.erase(prev_data);
+    }
+
+    b_map[key] = data;
+    used(data);
+  }
+
+  /* Forget all keys but keep the scene data, for when the pointers used as
+   * keys are no longer valid. Data that is not mapped to a new key before the
+   * next post_sync() is removed. */
+  void clear_keys()
+  {
+    b_map.clear();
+    b_recalc.clear();
+    used_set.clear();
+  }
+
   bool post_sync(bool do_delete = true)
   {
     /* remove unused data */
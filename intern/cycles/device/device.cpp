@@ -593,6 +593,9 @@ DeviceInfo Device::get_multi_device(const vector<DeviceInfo> &subdevices,
 
   info.has_half_images = true;
   info.has_volume_decoupled = true;
+  /* Sparse grids reference the tile offsets through a device pointer,
+   * which is not shared between devices. */
+  info.has_sparse_grids = false;
   info.has_osl = true;
   info.has_profiling = true;
 
@@ -78,6 +78,7 @@ class DeviceInfo {
   bool display_device;       /* GPU is used as a display device. */
   bool has_half_images;      /* Support half-float textures. */
   bool has_volume_decoupled; /* Decoupled volume shading. */
+  bool has_sparse_grids;     /* Support sparse grid volume textures. */
   bool has_osl;              /* Support Open Shading Language. */
   bool use_split_kernel;     /* Use split or mega kernel. */
   bool has_profiling;        /* Supports runtime collection of profiling info. */
@@ -93,6 +94,7 @@ class DeviceInfo {
     display_device = false;
     has_half_images = false;
     has_volume_decoupled = false;
+    has_sparse_grids = false;
     has_osl = false;
     use_split_kernel = false;
     has_profiling = false;
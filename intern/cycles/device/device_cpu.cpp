@@ -43,6 +43,7 @@
 #include "render/buffers.h"
 #include "render/coverage.h"
 
+#include "util/util_atomic.h"
 #include "util/util_debug.h"
 #include "util/util_foreach.h"
 #include "util/util_function.h"
@@ -472,12 +473,14 @@ class CPUDevice : public Device {
 
       TextureInfo &info = texture_info[flat_slot];
       info.data = (uint64_t)mem.host_pointer;
+      info.grid_info = (uint64_t)mem.grid_info;
       info.cl_buffer = 0;
       info.interpolation = mem.interpolation;
       info.extension = mem.extension;
       info.width = mem.data_width;
       info.height = mem.data_height;
       info.depth = mem.data_depth;
+      info.grid_type = mem.grid_type;
 
       need_texture_info = true;
     }
@@ -833,11 +836,20 @@ class CPUDevice : public Device {
     float *render_buffer = (float *)tile.buffer;
     int start_sample = tile.start_sample;
     int end_sample = tile.start_sample + tile.num_samples;
+    int num_rendered_samples = 0;
 
     /* Needed for Embree. */
     SIMD_SET_FLUSH_TO_ZERO;
 
-    for (int sample = start_sample; sample < end_sample; sample++) {
+    for (int sample = start_sample;; sample++) {
+      /* Samples may be stolen by other threads, claim them one at a time. */
+      if (tile.sample_counter) {
+        sample = atomic_fetch_and_add_int32(tile.sample_counter, 1);
+      }
+      if (sample >= end_sample) {
+        break;
+      }
+
       if (task.get_cancel() || task_pool.canceled()) {
         if (task.need_finish_queue == false)
           break;
@@ -852,7 +864,9 @@ class CPUDevice : public Device {
         }
       }
 
-      tile.sample = sample + 1;
+      /* Number of samples in the buffer, same as sample + 1 unless samples were stolen. */
+      num_rendered_samples++;
+      tile.sample = start_sample + num_rendered_samples;
 
       task.update_progress(&tile, tile.w * tile.h);
     }
@@ -926,6 +940,9 @@ class CPUDevice : public Device {
     while (task.acquire_tile(this, tile)) {
       if (tile.task == RenderTile::PATH_TRACE) {
         if (use_split_kernel) {
+          /* Split kernel renders all samples at once, the session does not let other
+           * threads steal samples from its tiles. */
+          assert(tile.sample_counter == NULL);
           device_only_memory<uchar> void_buffer(this, "void_buffer");
           split_kernel->path_trace(&task, tile, kgbuffer, void_buffer);
         }
@@ -1009,10 +1026,18 @@ class CPUDevice : public Device {
     delete kg;
   }
 
+  /* Shader evaluation tasks each allocate their own kernel globals, so large
+   * inputs like displacement of a finely diced mesh are split into a few big
+   * batches per thread rather than many small ones. */
+  int shader_task_max_size(DeviceTask &task)
+  {
+    return max(256, task.shader_w / (info.cpu_threads * 4));
+  }
+
   int get_split_task_count(DeviceTask &task)
   {
     if (task.type == DeviceTask::SHADER)
-      return task.get_subtask_count(info.cpu_threads, 256);
+      return task.get_subtask_count(info.cpu_threads, shader_task_max_size(task));
     else
       return task.get_subtask_count(info.cpu_threads);
   }
@@ -1026,7 +1051,7 @@ class CPUDevice : public Device {
     list<DeviceTask> tasks;
 
     if (task.type == DeviceTask::SHADER)
-      task.split(tasks, info.cpu_threads, 256);
+      task.split(tasks, info.cpu_threads, shader_task_max_size(task));
     else
       task.split(tasks, info.cpu_threads);
 
@@ -1194,11 +1219,26 @@ int2 CPUSplitKernel::split_kernel_local_size()
   return make_int2(1, 1);
 }
 
-int2 CPUSplitKernel::split_kernel_global_size(device_memory & /*kg*/,
-                                              device_memory & /*data*/,
+int2 CPUSplitKernel::split_kernel_global_size(device_memory &kg,
+                                              device_memory &data,
                                               DeviceTask * /*task*/)
 {
-  return make_int2(1, 1);
+  /* Every render thread has its own split state, trace paths in batches that are large
+   * enough to sort shading by shader, but keep the state of a thread within a budget. */
+  const int width = 64;
+  const uint64_t max_state_size = 64 * 1024 * 1024;
+
+  uint64_t size_per_element = state_buffer_size(kg, data, 1024) / 1024;
+  int max_elements = DebugFlags().cpu.split_kernel_batch_size;
+  if (size_per_element > 0) {
+    max_elements = min(max_elements, (int)(max_state_size / size_per_element));
+  }
+  int height = max(max_elements / width, 1);
+
+  VLOG(1) << "Split kernel batch size: " << width * height << " paths ("
+          << string_human_readable_size(size_per_element * width * height) << ").";
+
+  return make_int2(width, height);
 }
 
 uint64_t CPUSplitKernel::state_buffer_size(device_memory &kernel_globals,
@@ -1224,6 +1264,7 @@ void device_cpu_info(vector<DeviceInfo> &devices)
   info.id = "CPU";
   info.num = 0;
   info.has_volume_decoupled = true;
+  info.has_sparse_grids = true;
   info.has_osl = true;
   info.has_half_images = true;
   info.has_profiling = true;
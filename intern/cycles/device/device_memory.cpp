@@ -33,6 +33,8 @@ device_memory::device_memory(Device *device, const char *name, MemoryType type)
       name(name),
       interpolation(INTERPOLATION_NONE),
       extension(EXTENSION_REPEAT),
+      grid_type(IMAGE_GRID_TYPE_DENSE),
+      grid_info(0),
       device(device),
       device_pointer(0),
       host_pointer(0),
@@ -59,6 +61,8 @@ device_memory::device_memory(device_memory &&other)
       name(other.name),
       interpolation(other.interpolation),
       extension(other.extension),
+      grid_type(other.grid_type),
+      grid_info(other.grid_info),
       device(other.device),
       device_pointer(other.device_pointer),
       host_pointer(other.host_pointer),
@@ -210,6 +210,9 @@ class device_memory {
   const char *name;
   InterpolationType interpolation;
   ExtensionType extension;
+  ImageGridType grid_type;
+  /* Tile offsets of sparse grid textures, only supported on the CPU. */
+  device_ptr grid_info;
 
   /* Pointers. */
   Device *device;
@@ -1296,6 +1296,8 @@ void OpenCLDevice::flush_texture_buffers()
 
     MemoryManager::BufferDescriptor desc = memory_manager.get_descriptor(slot.name);
     info.data = desc.offset;
+    info.grid_info = 0;
+    info.grid_type = IMAGE_GRID_TYPE_DENSE;
     info.cl_buffer = desc.device_buffer;
 
     if (string_startswith(slot.name, "__tex_image")) {
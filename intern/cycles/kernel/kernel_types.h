@@ -135,6 +135,7 @@ CCL_NAMESPACE_BEGIN
 #  endif
 #  define __VOLUME_DECOUPLED__
 #  define __VOLUME_RECORD_ALL__
+#  define __SVM_SPECIALIZE__
 #endif /* __KERNEL_CPU__ */
 
 #ifdef __KERNEL_CUDA__
@@ -1543,7 +1544,9 @@ typedef struct KernelShader {
   float cryptomatte_id;
   int flags;
   int pass_id;
-  int pad2, pad3;
+  /* Highest node group and node features used, to pick an SVM interpreter. */
+  int nodes_group;
+  int nodes_features;
 } KernelShader;
 static_assert_align(KernelShader, 16);
 
@@ -253,6 +253,31 @@ template<typename T> struct TextureInterpolator {
 
   /* ********  3D interpolation ******** */
 
+  /* Voxel lookup, with sparse grids mapping the voxel to its tile first.
+   * Empty tiles are not stored and read as zero. */
+  template<ImageGridType GridType>
+  static ccl_always_inline float4 read_voxel(const TextureInfo &info, int x, int y, int z)
+  {
+    const T *data = (const T *)info.data;
+    if (GridType == IMAGE_GRID_TYPE_SPARSE) {
+      const int *offsets = (const int *)info.grid_info;
+      const int tiles_x = (info.width + TEX_SPARSE_TILE_MASK) >> TEX_SPARSE_TILE_SHIFT;
+      const int tiles_y = (info.height + TEX_SPARSE_TILE_MASK) >> TEX_SPARSE_TILE_SHIFT;
+      const int tile = (x >> TEX_SPARSE_TILE_SHIFT) +
+                       tiles_x * ((y >> TEX_SPARSE_TILE_SHIFT) +
+                                  tiles_y * (z >> TEX_SPARSE_TILE_SHIFT));
+      const int offset = offsets[tile];
+      if (offset < 0) {
+        return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+      }
+      return read(data[offset + (x & TEX_SPARSE_TILE_MASK) +
+                       ((y & TEX_SPARSE_TILE_MASK) << TEX_SPARSE_TILE_SHIFT) +
+                       ((z & TEX_SPARSE_TILE_MASK) << (2 * TEX_SPARSE_TILE_SHIFT))]);
+    }
+    return read(data[x + y * info.width + z * info.width * info.height]);
+  }
+
+  template<ImageGridType GridType>
   static ccl_always_inline float4 interp_3d_closest(const TextureInfo &info,
                                                     float x,
                                                     float y,
@@ -288,10 +313,10 @@ template<typename T> struct TextureInterpolator {
         return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
     }
 
-    const T *data = (const T *)info.data;
-    return read(data[ix + iy * width + iz * width * height]);
+    return read_voxel<GridType>(info, ix, iy, iz);
   }
 
+  template<ImageGridType GridType>
   static ccl_always_inline float4 interp_3d_linear(const TextureInfo &info,
                                                    float x,
                                                    float y,
@@ -336,19 +361,17 @@ template<typename T> struct TextureInterpolator {
         return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
     }
 
-    const T *data = (const T *)info.data;
     float4 r;
 
-    r = (1.0f - tz) * (1.0f - ty) * (1.0f - tx) *
-        read(data[ix + iy * width + iz * width * height]);
-    r += (1.0f - tz) * (1.0f - ty) * tx * read(data[nix + iy * width + iz * width * height]);
-    r += (1.0f - tz) * ty * (1.0f - tx) * read(data[ix + niy * width + iz * width * height]);
-    r += (1.0f - tz) * ty * tx * read(data[nix + niy * width + iz * width * height]);
+    r = (1.0f - tz) * (1.0f - ty) * (1.0f - tx) * read_voxel<GridType>(info, ix, iy, iz);
+    r += (1.0f - tz) * (1.0f - ty) * tx * read_voxel<GridType>(info, nix, iy, iz);
+    r += (1.0f - tz) * ty * (1.0f - tx) * read_voxel<GridType>(info, ix, niy, iz);
+    r += (1.0f - tz) * ty * tx * read_voxel<GridType>(info, nix, niy, iz);
 
-    r += tz * (1.0f - ty) * (1.0f - tx) * read(data[ix + iy * width + niz * width * height]);
-    r += tz * (1.0f - ty) * tx * read(data[nix + iy * width + niz * width * height]);
-    r += tz * ty * (1.0f - tx) * read(data[ix + niy * width + niz * width * height]);
-    r += tz * ty * tx * read(data[nix + niy * width + niz * width * height]);
+    r += tz * (1.0f - ty) * (1.0f - tx) * read_voxel<GridType>(info, ix, iy, niz);
+    r += tz * (1.0f - ty) * tx * read_voxel<GridType>(info, nix, iy, niz);
+    r += tz * ty * (1.0f - tx) * read_voxel<GridType>(info, ix, niy, niz);
+    r += tz * ty * tx * read_voxel<GridType>(info, nix, niy, niz);
 
     return r;
   }
@@ -359,6 +382,7 @@ template<typename T> struct TextureInterpolator {
    * Only happens for AVX2 kernel and global __KERNEL_SSE__ vectorization
    * enabled.
    */
+  template<ImageGridType GridType>
 #if defined(__GNUC__) || defined(__clang__)
   static ccl_always_inline
 #else
@@ -424,15 +448,14 @@ template<typename T> struct TextureInterpolator {
     }
 
     const int xc[4] = {pix, ix, nix, nnix};
-    const int yc[4] = {width * piy, width * iy, width * niy, width * nniy};
-    const int zc[4] = {
-        width * height * piz, width * height * iz, width * height * niz, width * height * nniz};
+    const int yc[4] = {piy, iy, niy, nniy};
+    const int zc[4] = {piz, iz, niz, nniz};
     float u[4], v[4], w[4];
 
     /* Some helper macro to keep code reasonable size,
      * let compiler to inline all the matrix multiplications.
      */
-#define DATA(x, y, z) (read(data[xc[x] + yc[y] + zc[z]]))
+#define DATA(x, y, z) (read_voxel<GridType>(info, xc[x], yc[y], zc[z]))
 #define COL_TERM(col, row) \
   (v[col] * (u[0] * DATA(0, col, row) + u[1] * DATA(1, col, row) + u[2] * DATA(2, col, row) + \
              u[3] * DATA(3, col, row)))
@@ -444,7 +467,6 @@ template<typename T> struct TextureInterpolator {
     SET_CUBIC_SPLINE_WEIGHTS(w, tz);
 
     /* Actual interpolation. */
-    const T *data = (const T *)info.data;
     return ROW_TERM(0) + ROW_TERM(1) + ROW_TERM(2) + ROW_TERM(3);
 
 #undef COL_TERM
@@ -452,20 +474,30 @@ template<typename T> struct TextureInterpolator {
 #undef DATA
   }
 
+  template<ImageGridType GridType>
   static ccl_always_inline float4
-  interp_3d(const TextureInfo &info, float x, float y, float z, InterpolationType interp)
+  interp_3d_grid(const TextureInfo &info, float x, float y, float z, InterpolationType interp)
   {
-    if (UNLIKELY(!info.data))
-      return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
-
     switch ((interp == INTERPOLATION_NONE) ? info.interpolation : interp) {
       case INTERPOLATION_CLOSEST:
-        return interp_3d_closest(info, x, y, z);
+        return interp_3d_closest<GridType>(info, x, y, z);
       case INTERPOLATION_LINEAR:
-        return interp_3d_linear(info, x, y, z);
+        return interp_3d_linear<GridType>(info, x, y, z);
       default:
-        return interp_3d_tricubic(info, x, y, z);
+        return interp_3d_tricubic<GridType>(info, x, y, z);
+    }
+  }
+
+  static ccl_always_inline float4
+  interp_3d(const TextureInfo &info, float x, float y, float z, InterpolationType interp)
+  {
+    if (UNLIKELY(!info.data))
+      return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+
+    if (info.grid_type == IMAGE_GRID_TYPE_SPARSE) {
+      return interp_3d_grid<IMAGE_GRID_TYPE_SPARSE>(info, x, y, z, interp);
     }
+    return interp_3d_grid<IMAGE_GRID_TYPE_DENSE>(info, x, y, z, interp);
   }
 #undef SET_CUBIC_SPLINE_WEIGHTS
 };
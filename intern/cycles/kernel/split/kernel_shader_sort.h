@@ -54,9 +54,6 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
   }
   ccl_barrier(CCL_LOCAL_MEM_FENCE);
 
-  /* skip sorting for cpu split kernel */
-#  ifdef __KERNEL_OPENCL__
-
   /* bitonic sort */
   for (uint length = 1; length < SHADER_SORT_BLOCK_SIZE; length <<= 1) {
     for (uint inc = length; inc > 0; inc >>= 1) {
@@ -64,6 +61,13 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
         uint i = lid + ii;
         bool direction = ((i & (length << 1)) != 0);
         uint j = i ^ inc;
+#  ifdef __KERNEL_CPU__
+        /* The whole block is sorted by a single thread on the CPU, so every pair only
+         * has to be compared once. */
+        if (j < i) {
+          continue;
+        }
+#  endif
         ushort ioff = local_index[i];
         ushort joff = local_index[j];
         uint iKey = local_value[ioff];
@@ -77,7 +81,6 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
       }
     }
   }
-#  endif /* __KERNEL_OPENCL__ */
 
   /* copy to destination */
   for (uint i = 0; i < SHADER_SORT_BLOCK_SIZE; i += SHADER_SORT_LOCAL_SIZE) {
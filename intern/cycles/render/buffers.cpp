@@ -120,6 +120,9 @@ RenderTile::RenderTile()
   buffer = 0;
 
   buffers = NULL;
+
+  sample_counter = NULL;
+  stolen = false;
 }
 
 /* Render Buffers */
@@ -160,6 +163,30 @@ bool RenderBuffers::copy_from_device()
   return true;
 }
 
+/* Add buffers rendered for a different sample range of the same pixels,
+ * all passes are accumulated over samples so they can simply be summed. */
+bool RenderBuffers::accumulate(RenderBuffers *other)
+{
+  if (!copy_from_device() || !other->copy_from_device()) {
+    return false;
+  }
+
+  const size_t size = buffer.size();
+  if (size != other->buffer.size()) {
+    return false;
+  }
+
+  float *data = buffer.data();
+  const float *other_data = other->buffer.data();
+  for (size_t i = 0; i < size; i++) {
+    data[i] += other_data[i];
+  }
+
+  buffer.copy_to_device();
+
+  return true;
+}
+
 bool RenderBuffers::get_denoising_pass_rect(
     int type, float exposure, int sample, int components, float *pixels)
 {
@@ -88,6 +88,7 @@ class RenderBuffers {
   void zero();
 
   bool copy_from_device();
+  bool accumulate(RenderBuffers *other);
   bool get_pass_rect(PassType type,
                      float exposure,
                      int sample,
@@ -151,6 +152,14 @@ class RenderTile {
 
   RenderBuffers *buffers;
 
+  /* When set, samples are claimed one at a time from this counter instead of
+   * rendering start_sample to start_sample + num_samples in order, so idle
+   * threads can steal part of the remaining samples of the tile. */
+  int *sample_counter;
+  /* Stolen sample range of a tile rendered by another thread, into separate
+   * buffers that are accumulated into the tile buffers when both are done. */
+  bool stolen;
+
   RenderTile();
 };
 
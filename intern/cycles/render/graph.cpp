@@ -763,6 +763,27 @@ void ShaderGraph::compute_displacement_hash()
   displacement_hash = md5.get_hex();
 }
 
+void ShaderGraph::hash(MD5Hash &md5)
+{
+  /* Hash of all nodes, their settings and links. Images and other resources
+   * used by nodes are not part of the hash, callers have to handle them. */
+  foreach (ShaderNode *node, nodes) {
+    node->hash(md5);
+    md5.append((uint8_t *)&node->id, sizeof(node->id));
+    foreach (ShaderInput *input, node->inputs) {
+      if (input->link) {
+        md5.append((uint8_t *)&input->link->parent->id, sizeof(input->link->parent->id));
+        md5.append(input->link->name().string());
+      }
+      else {
+        md5.append("-");
+      }
+    }
+  }
+
+  md5.append((uint8_t *)&finalized, sizeof(finalized));
+}
+
 void ShaderGraph::clean(Scene *scene)
 {
   /* Graph simplification */
@@ -211,6 +211,12 @@ class ShaderNode : public Node {
   {
     return false;
   }
+  /* Node uses images or other data owned by the scene when compiled, so the
+   * compiled nodes can not be reused by another session. */
+  virtual bool has_resource_dependency()
+  {
+    return false;
+  }
   virtual bool has_volume_support()
   {
     return false;
@@ -334,6 +340,7 @@ class ShaderGraph {
 
   void remove_proxy_nodes();
   void compute_displacement_hash();
+  void hash(MD5Hash &md5);
   void simplify(Scene *scene);
   void finalize(Scene *scene,
                 bool do_bump = false,
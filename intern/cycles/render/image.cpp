@@ -25,6 +25,7 @@
 #include "util/util_logging.h"
 #include "util/util_path.h"
 #include "util/util_progress.h"
+#include "util/util_sparse_grid.h"
 #include "util/util_texture.h"
 #include "util/util_unique_ptr.h"
 
@@ -103,6 +104,7 @@ ImageManager::ImageManager(const DeviceInfo &info)
   /* Set image limits */
   max_num_images = TEX_NUM_MAX;
   has_half_images = info.has_half_images;
+  has_sparse_grids = info.has_sparse_grids;
 
   for (size_t type = 0; type < IMAGE_DATA_NUM_TYPES; type++) {
     tex_num_images[type] = 0;
@@ -403,6 +405,7 @@ int ImageManager::add_image(const string &filename,
   img->alpha_type = alpha_type;
   img->colorspace = colorspace;
   img->mem = NULL;
+  img->grid_mem = NULL;
 
   images[type][slot] = img;
 
@@ -769,9 +772,57 @@ bool ImageManager::file_load_image(Image *img,
     memcpy(texture_pixels, &scaled_pixels[0], scaled_pixels.size() * sizeof(StorageType));
   }
 
+  /* Store mostly empty volumes as sparse grid. */
+  if (has_sparse_grids && tex_img.data_depth > 1) {
+    file_load_sparse_grid<StorageType>(img, is_rgba ? 4 : 1, tex_img);
+  }
+
   return true;
 }
 
+template<typename StorageType, typename DeviceType>
+void ImageManager::file_load_sparse_grid(Image *img,
+                                         int components,
+                                         device_vector<DeviceType> &tex_img)
+{
+  const size_t width = tex_img.data_width;
+  const size_t height = tex_img.data_height;
+  const size_t depth = tex_img.data_depth;
+
+  vector<StorageType> sparse_pixels;
+  vector<int> offsets;
+  if (!create_sparse_grid((const StorageType *)tex_img.data(),
+                          width,
+                          height,
+                          depth,
+                          components,
+                          &sparse_pixels,
+                          &offsets)) {
+    return;
+  }
+
+  VLOG(1) << "Storing " << img->filename << " as sparse grid, "
+          << string_human_readable_size(sparse_pixels.size() * sizeof(StorageType)) << " instead of "
+          << string_human_readable_size(tex_img.memory_size()) << ".";
+
+  thread_scoped_lock device_lock(device_mutex);
+
+  img->grid_mem = new device_vector<int>(
+      tex_img.device, (img->mem_name + "_grid").c_str(), MEM_READ_ONLY);
+  int *grid_offsets = img->grid_mem->alloc(offsets.size());
+  memcpy(grid_offsets, &offsets[0], offsets.size() * sizeof(int));
+  img->grid_mem->copy_to_device();
+
+  /* Replaces the dense voxels, keeping the dense resolution for lookups. */
+  StorageType *texture_pixels = (StorageType *)tex_img.alloc(sparse_pixels.size() / components);
+  memcpy(texture_pixels, &sparse_pixels[0], sparse_pixels.size() * sizeof(StorageType));
+  tex_img.data_width = width;
+  tex_img.data_height = height;
+  tex_img.data_depth = depth;
+  tex_img.grid_type = IMAGE_GRID_TYPE_SPARSE;
+  tex_img.grid_info = img->grid_mem->device_pointer;
+}
+
 void ImageManager::device_load_image(
     Device *device, Scene *scene, ImageDataType type, int slot, Progress *progress)
 {
@@ -798,6 +849,11 @@ void ImageManager::device_load_image(
     delete img->mem;
     img->mem = NULL;
   }
+  if (img->grid_mem) {
+    thread_scoped_lock device_lock(device_mutex);
+    delete img->grid_mem;
+    img->grid_mem = NULL;
+  }
 
   /* Create new texture. */
   if (type == IMAGE_DATA_TYPE_FLOAT4) {
@@ -983,6 +1039,10 @@ void ImageManager::device_free_image(Device *, ImageDataType type, int slot)
       thread_scoped_lock device_lock(device_mutex);
       delete img->mem;
     }
+    if (img->grid_mem) {
+      thread_scoped_lock device_lock(device_mutex);
+      delete img->grid_mem;
+    }
 
     delete img;
     images[type][slot] = NULL;
@@ -1098,8 +1158,11 @@ void ImageManager::collect_statistics(RenderStats *stats)
 {
   for (int type = 0; type < IMAGE_DATA_NUM_TYPES; type++) {
     foreach (const Image *image, images[type]) {
-      stats->image.textures.add_entry(
-          NamedSizeEntry(path_filename(image->filename), image->mem->memory_size()));
+      size_t mem_size = image->mem->memory_size();
+      if (image->grid_mem) {
+        mem_size += image->grid_mem->memory_size();
+      }
+      stats->image.textures.add_entry(NamedSizeEntry(path_filename(image->filename), mem_size));
     }
   }
 }
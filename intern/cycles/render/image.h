@@ -158,6 +158,8 @@ class ImageManager {
 
     string mem_name;
     device_memory *mem;
+    /* Tile offsets when the voxels are stored as a sparse grid. */
+    device_vector<int> *grid_mem;
 
     int users;
   };
@@ -166,6 +168,7 @@ class ImageManager {
   int tex_num_images[IMAGE_DATA_NUM_TYPES];
   int max_num_images;
   bool has_half_images;
+  bool has_sparse_grids;
 
   thread_mutex device_mutex;
   int animation_frame;
@@ -181,6 +184,9 @@ class ImageManager {
                        int texture_limit,
                        device_vector<DeviceType> &tex_img);
 
+  template<typename StorageType, typename DeviceType>
+  void file_load_sparse_grid(Image *img, int components, device_vector<DeviceType> &tex_img);
+
   void metadata_detect_colorspace(ImageMetaData &metadata, const char *file_format);
 
   void device_load_image(
@@ -24,10 +24,12 @@
 #include "render/nodes.h"
 #include "render/object.h"
 #include "render/scene.h"
+#include "render/scene_cache.h"
 #include "render/shader.h"
 
 #include "util/util_foreach.h"
 #include "util/util_hash.h"
+#include "util/util_md5.h"
 #include "util/util_path.h"
 #include "util/util_progress.h"
 #include "util/util_logging.h"
@@ -538,6 +540,74 @@ static void background_cdf(
   }
 }
 
+/* Hash of everything the background importance map is computed from. Images
+ * are identified by file name, size and modification time, empty if the
+ * shader uses images not loaded from a file or other resources. */
+static string background_cache_hash(Shader *shader, int2 res)
+{
+  MD5Hash md5;
+
+  foreach (ShaderNode *node, shader->graph->nodes) {
+    ustring filename;
+    void *builtin_data = NULL;
+
+    if (node->type == EnvironmentTextureNode::node_type) {
+      filename = ((EnvironmentTextureNode *)node)->filename;
+      builtin_data = ((EnvironmentTextureNode *)node)->builtin_data;
+    }
+    else if (node->type == ImageTextureNode::node_type) {
+      filename = ((ImageTextureNode *)node)->filename;
+      builtin_data = ((ImageTextureNode *)node)->builtin_data;
+    }
+    else if (node->has_resource_dependency()) {
+      return "";
+    }
+    else {
+      continue;
+    }
+
+    if (builtin_data || !path_exists(filename.string())) {
+      return "";
+    }
+    md5.append(string_printf("%s %llu %llu",
+                             filename.c_str(),
+                             (unsigned long long)path_file_size(filename.string()),
+                             (unsigned long long)path_modified_time(filename.string())));
+  }
+
+  shader->graph->hash(md5);
+  md5.append((uint8_t *)&res, sizeof(res));
+
+  return md5.get_hex();
+}
+
+static bool background_cache_read(Scene *scene,
+                                  DeviceScene *dscene,
+                                  const string &hash,
+                                  int2 res)
+{
+  vector<uint8_t> data;
+  if (!scene->cache->read(SCENE_CACHE_BACKGROUND, hash, data)) {
+    return false;
+  }
+
+  SceneCacheReader reader(data);
+  int2 cached_res;
+  if (reader.read(cached_res) && cached_res.x == res.x && cached_res.y == res.y) {
+    float2 *marg_cdf = dscene->light_background_marginal_cdf.alloc(res.y + 1);
+    float2 *cond_cdf = dscene->light_background_conditional_cdf.alloc((res.x + 1) * res.y);
+    reader.read_data(marg_cdf, sizeof(float2) * (res.y + 1));
+    reader.read_data(cond_cdf, sizeof(float2) * (res.x + 1) * res.y);
+  }
+
+  if (!reader.finished()) {
+    scene->cache->reject(SCENE_CACHE_BACKGROUND);
+    return false;
+  }
+
+  return true;
+}
+
 void LightManager::device_update_background(Device *device,
                                             DeviceScene *dscene,
                                             Scene *scene,
@@ -565,12 +635,13 @@ void LightManager::device_update_background(Device *device,
 
   assert(kintegrator->use_direct_light);
 
+  Shader *shader = (scene->background->shader) ? scene->background->shader :
+                                                 scene->default_background;
+
   /* get the resolution from the light's size (we stuff it in there) */
   int2 res = make_int2(background_light->map_resolution, background_light->map_resolution / 2);
   /* If the resolution isn't set manually, try to find an environment texture. */
   if (res.x == 0) {
-    Shader *shader = (scene->background->shader) ? scene->background->shader :
-                                                   scene->default_background;
     foreach (ShaderNode *node, shader->graph->nodes) {
       if (node->type == EnvironmentTextureNode::node_type) {
         EnvironmentTextureNode *env = (EnvironmentTextureNode *)node;
@@ -593,6 +664,15 @@ void LightManager::device_update_background(Device *device,
   kintegrator->pdf_background_res_x = res.x;
   kintegrator->pdf_background_res_y = res.y;
 
+  /* Reuse the importance map of an earlier session when the scene cache is enabled. */
+  const string cache_hash = (scene->cache->enabled()) ? background_cache_hash(shader, res) : "";
+  if (!cache_hash.empty() && background_cache_read(scene, dscene, cache_hash, res)) {
+    VLOG(2) << "Background importance map loaded from scene cache.";
+    dscene->light_background_marginal_cdf.copy_to_device();
+    dscene->light_background_conditional_cdf.copy_to_device();
+    return;
+  }
+
   vector<float3> pixels;
   shade_background_pixels(device, dscene, res.x, res.y, pixels, progress);
 
@@ -649,6 +729,14 @@ void LightManager::device_update_background(Device *device,
 
   VLOG(2) << "Background MIS build time " << time_dt() - time_start << "\n";
 
+  if (!cache_hash.empty()) {
+    SceneCacheWriter writer;
+    writer.write(res);
+    writer.write_data(marg_cdf, sizeof(float2) * (res.y + 1));
+    writer.write_data(cond_cdf, sizeof(float2) * cdf_width * res.y);
+    scene->cache->write(SCENE_CACHE_BACKGROUND, cache_hash, writer.data);
+  }
+
   /* update device */
   dscene->light_background_marginal_cdf.copy_to_device();
   dscene->light_background_conditional_cdf.copy_to_device();
@@ -437,6 +437,9 @@ Mesh::Mesh() : Node(node_type)
 
   num_subd_verts = 0;
 
+  tessellation_time = 0.0;
+  displacement_time = 0.0;
+
   attributes.triangle_mesh = this;
   curve_attributes.curve_mesh = this;
   subd_attributes.subd_mesh = this;
@@ -2151,6 +2154,9 @@ void MeshManager::device_update(Device *device,
         mesh->need_update = true;
     }
 
+    mesh->tessellation_time = 0.0;
+    mesh->displacement_time = 0.0;
+
     if (mesh->need_update) {
       /* Update normals. */
       mesh->add_face_normals();
@@ -2178,6 +2184,7 @@ void MeshManager::device_update(Device *device,
 
   /* Tessellate meshes that are using subdivision */
   if (total_tess_needed) {
+    scoped_timer timer;
     Camera *dicing_camera = scene->dicing_camera;
     dicing_camera->update(scene);
 
@@ -2194,9 +2201,11 @@ void MeshManager::device_update(Device *device,
 
         progress.set_status("Updating Mesh", msg);
 
+        scoped_timer mesh_timer;
         mesh->subd_params->camera = dicing_camera;
         DiagSplit dsplit(*mesh->subd_params);
         mesh->tessellate(&dsplit);
+        mesh->tessellation_time = mesh_timer.get_time();
 
         i++;
 
@@ -2204,6 +2213,8 @@ void MeshManager::device_update(Device *device,
           return;
       }
     }
+
+    progress.add_update_time("Tessellation", timer.get_time());
   }
 
   /* Update images needed for true displacement. */
@@ -2230,6 +2241,7 @@ void MeshManager::device_update(Device *device,
     return;
 
   /* Update displacement. */
+  scoped_timer displace_timer;
   bool displacement_done = false;
   size_t num_bvh = 0;
   BVHLayout bvh_layout = BVHParams::best_bvh_layout(scene->params.bvh_layout,
@@ -2237,7 +2249,9 @@ void MeshManager::device_update(Device *device,
 
   foreach (Mesh *mesh, scene->meshes) {
     if (mesh->need_update) {
+      scoped_timer mesh_timer;
       if (displace(device, dscene, scene, mesh, progress)) {
+        mesh->displacement_time = mesh_timer.get_time();
         displacement_done = true;
       }
 
@@ -2257,8 +2271,11 @@ void MeshManager::device_update(Device *device,
     device_update_attributes(device, dscene, scene, progress);
     if (progress.get_cancel())
       return;
+
+    progress.add_update_time("Displacement", displace_timer.get_time());
   }
 
+  scoped_timer bvh_timer;
   TaskPool pool;
 
   size_t i = 0;
@@ -2275,6 +2292,7 @@ void MeshManager::device_update(Device *device,
   TaskPool::Summary summary;
   pool.wait_work(&summary);
   VLOG(2) << "Objects BVH build pool statistics:\n" << summary.full_report();
+  progress.add_update_time("BVH", bvh_timer.get_time());
 
   foreach (Shader *shader, scene->shaders) {
     shader->need_update_mesh = false;
@@ -2292,7 +2310,11 @@ void MeshManager::device_update(Device *device,
   if (progress.get_cancel())
     return;
 
-  device_update_bvh(device, dscene, scene, progress);
+  {
+    scoped_timer timer;
+    device_update_bvh(device, dscene, scene, progress);
+    progress.add_update_time("BVH", timer.get_time());
+  }
   if (progress.get_cancel())
     return;
 
@@ -2366,6 +2388,14 @@ void MeshManager::collect_statistics(const Scene *scene, RenderStats *stats)
   foreach (Mesh *mesh, scene->meshes) {
     stats->mesh.geometry.add_entry(
         NamedSizeEntry(string(mesh->name.c_str()), mesh->get_total_size_in_bytes()));
+    if (mesh->tessellation_time > 0.0) {
+      stats->mesh.tessellation.add_entry(
+          NamedTimeEntry(string(mesh->name.c_str()), mesh->tessellation_time));
+    }
+    if (mesh->displacement_time > 0.0) {
+      stats->mesh.displacement.add_entry(
+          NamedTimeEntry(string(mesh->name.c_str()), mesh->displacement_time));
+    }
   }
 }
 
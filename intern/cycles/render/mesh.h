@@ -283,6 +283,13 @@ class Mesh : public Node {
 
   size_t num_subd_verts;
 
+  /* Time spent tessellating and displacing in the last device update, for statistics. */
+  double tessellation_time;
+  double displacement_time;
+
+  /* Hash of the synchronized geometry, used to reuse the mesh with persistent data. */
+  string geometry_hash;
+
  private:
   unordered_map<int, int> vert_to_stitching_key_map; /* real vert index -> stitching index */
   unordered_multimap<int, int>
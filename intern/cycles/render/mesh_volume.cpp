@@ -21,6 +21,7 @@
 #include "util/util_foreach.h"
 #include "util/util_logging.h"
 #include "util/util_progress.h"
+#include "util/util_sparse_grid.h"
 #include "util/util_types.h"
 
 CCL_NAMESPACE_BEGIN
@@ -360,6 +361,8 @@ void VolumeMeshBuilder::convert_quads_to_tris(const vector<QuadData> &quads,
 struct VoxelAttributeGrid {
   float *data;
   int channels;
+  /* Tile offsets for sparse grids, NULL for dense grids. */
+  const int *offsets;
 };
 
 void MeshManager::create_volume_mesh(Scene *scene, Mesh *mesh, Progress &progress)
@@ -368,6 +371,7 @@ void MeshManager::create_volume_mesh(Scene *scene, Mesh *mesh, Progress &progres
   progress.set_status("Updating Mesh", msg);
 
   vector<VoxelAttributeGrid> voxel_grids;
+  size_t grid_memory = 0;
 
   /* Compute volume parameters. */
   VolumeParams volume_params;
@@ -394,7 +398,13 @@ void MeshManager::create_volume_mesh(Scene *scene, Mesh *mesh, Progress &progres
     VoxelAttributeGrid voxel_grid;
     voxel_grid.data = static_cast<float *>(image_memory->host_pointer);
     voxel_grid.channels = image_memory->data_elements;
+    /* Sparse grids are only used on the CPU, where device and host pointers match. */
+    voxel_grid.offsets = (image_memory->grid_type == IMAGE_GRID_TYPE_SPARSE) ?
+                             (const int *)image_memory->grid_info :
+                             NULL;
     voxel_grids.push_back(voxel_grid);
+
+    grid_memory += image_memory->memory_size();
   }
 
   if (voxel_grids.empty()) {
@@ -447,19 +457,60 @@ void MeshManager::create_volume_mesh(Scene *scene, Mesh *mesh, Progress &progres
   VolumeMeshBuilder builder(&volume_params);
   const float isovalue = mesh->volume_isovalue;
 
-  for (int z = 0; z < resolution.z; ++z) {
-    for (int y = 0; y < resolution.y; ++y) {
-      for (int x = 0; x < resolution.x; ++x) {
-        size_t voxel_index = compute_voxel_index(resolution, x, y, z);
+  /* Iterate over the grid in tiles, so empty tiles of sparse grids can be
+   * skipped without looking at their voxels. */
+  const int tiles_x = sparse_grid_num_tiles(resolution.x);
+  const int tiles_y = sparse_grid_num_tiles(resolution.y);
+  const int tiles_z = sparse_grid_num_tiles(resolution.z);
+
+  for (int tz = 0; tz < tiles_z; ++tz) {
+    for (int ty = 0; ty < tiles_y; ++ty) {
+      for (int tx = 0; tx < tiles_x; ++tx) {
+        const int tile = tx + tiles_x * (ty + tiles_y * tz);
 
         for (size_t i = 0; i < voxel_grids.size(); ++i) {
           const VoxelAttributeGrid &voxel_grid = voxel_grids[i];
           const int channels = voxel_grid.channels;
+          const int offset = (voxel_grid.offsets) ? voxel_grid.offsets[tile] : 0;
+          const bool empty_tile = (offset < 0);
 
-          for (int c = 0; c < channels; c++) {
-            if (voxel_grid.data[voxel_index * channels + c] >= isovalue) {
-              builder.add_node_with_padding(x, y, z);
-              break;
+          /* Empty tiles only contain zero voxels. */
+          if (empty_tile && isovalue > 0.0f) {
+            continue;
+          }
+
+          const int x0 = tx * TEX_SPARSE_TILE_SIZE;
+          const int y0 = ty * TEX_SPARSE_TILE_SIZE;
+          const int z0 = tz * TEX_SPARSE_TILE_SIZE;
+          const int x1 = min(x0 + TEX_SPARSE_TILE_SIZE, resolution.x);
+          const int y1 = min(y0 + TEX_SPARSE_TILE_SIZE, resolution.y);
+          const int z1 = min(z0 + TEX_SPARSE_TILE_SIZE, resolution.z);
+
+          for (int z = z0; z < z1; ++z) {
+            for (int y = y0; y < y1; ++y) {
+              for (int x = x0; x < x1; ++x) {
+                if (empty_tile) {
+                  builder.add_node_with_padding(x, y, z);
+                  continue;
+                }
+
+                size_t voxel_index;
+                if (voxel_grid.offsets) {
+                  voxel_index = offset + (x & TEX_SPARSE_TILE_MASK) +
+                                ((y & TEX_SPARSE_TILE_MASK) << TEX_SPARSE_TILE_SHIFT) +
+                                ((z & TEX_SPARSE_TILE_MASK) << (2 * TEX_SPARSE_TILE_SHIFT));
+                }
+                else {
+                  voxel_index = compute_voxel_index(resolution, x, y, z);
+                }
+
+                for (int c = 0; c < channels; c++) {
+                  if (voxel_grid.data[voxel_index * channels + c] >= isovalue) {
+                    builder.add_node_with_padding(x, y, z);
+                    break;
+                  }
+                }
+              }
             }
           }
         }
@@ -499,9 +550,7 @@ void MeshManager::create_volume_mesh(Scene *scene, Mesh *mesh, Progress &progres
                  (1024.0 * 1024.0)
           << "Mb.";
 
-  VLOG(1) << "Memory usage volume grid: "
-          << (resolution.x * resolution.y * resolution.z * sizeof(float)) / (1024.0 * 1024.0)
-          << "Mb.";
+  VLOG(1) << "Memory usage volume grid: " << grid_memory / (1024.0 * 1024.0) << "Mb.";
 }
 
 CCL_NAMESPACE_END
@@ -78,6 +78,10 @@ class ImageSlotTextureNode : public TextureNode {
   {
     special_type = SHADER_SPECIAL_TYPE_IMAGE_SLOT;
   }
+  bool has_resource_dependency()
+  {
+    return true;
+  }
   int slot;
 };
 
@@ -326,6 +330,10 @@ class PointDensityTextureNode : public ShaderNode {
   {
     return true;
   }
+  bool has_resource_dependency()
+  {
+    return true;
+  }
 
   void add_image();
 
@@ -358,6 +366,10 @@ class IESLightNode : public TextureNode {
   {
     return NODE_GROUP_LEVEL_2;
   }
+  bool has_resource_dependency()
+  {
+    return true;
+  }
 
   ustring filename;
   ustring ies;
@@ -1458,6 +1470,10 @@ class OSLNode : public ShaderNode {
   {
     return true;
   }
+  bool has_resource_dependency()
+  {
+    return true;
+  }
 
   virtual bool equals(const ShaderNode & /*other*/)
   {
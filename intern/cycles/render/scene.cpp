@@ -29,6 +29,7 @@
 #include "render/osl.h"
 #include "render/particles.h"
 #include "render/scene.h"
+#include "render/scene_cache.h"
 #include "render/shader.h"
 #include "render/svm.h"
 #include "render/tables.h"
@@ -101,6 +102,8 @@ Scene::Scene(const SceneParams &params_, Device *device)
   particle_system_manager = new ParticleSystemManager();
   curve_system_manager = new CurveSystemManager();
   bake_manager = new BakeManager();
+  cache = new SceneCache();
+  cache->set_directory(params.cache_path);
 
   /* OSL only works on the CPU */
   if (device->info.has_osl)
@@ -133,6 +136,11 @@ void Scene::free_memory(bool final)
   lights.clear();
   particle_systems.clear();
 
+  default_surface = NULL;
+  default_light = NULL;
+  default_background = NULL;
+  default_empty = NULL;
+
   if (device) {
     camera->device_free(device, &dscene, this);
     film->device_free(device, &dscene, this);
@@ -172,6 +180,7 @@ void Scene::free_memory(bool final)
     delete curve_system_manager;
     delete image_manager;
     delete bake_manager;
+    delete cache;
   }
 }
 
@@ -370,7 +379,12 @@ bool Scene::need_reset()
 void Scene::reset()
 {
   shader_manager->reset(this);
-  shader_manager->add_default(this);
+
+  /* Keep the default shaders of the previous render, so meshes using them
+   * can be reused with persistent data. */
+  if (default_surface == NULL) {
+    shader_manager->add_default(this);
+  }
 
   /* ensure all objects are updated */
   camera->tag_update();
@@ -394,6 +408,7 @@ void Scene::collect_statistics(RenderStats *stats)
 {
   mesh_manager->collect_statistics(this, stats);
   image_manager->collect_statistics(stats);
+  cache->collect_statistics(stats);
 }
 
 CCL_NAMESPACE_END
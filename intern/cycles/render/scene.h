@@ -49,6 +49,7 @@ class MeshManager;
 class Object;
 class ObjectManager;
 class ParticleSystemManager;
+class SceneCache;
 class ParticleSystem;
 class CurveSystemManager;
 class Shader;
@@ -169,6 +170,9 @@ class SceneParams {
   int num_bvh_time_steps;
   bool persistent_data;
   int texture_limit;
+  /* Directory to cache compiled shaders and other preprocessing results in,
+   * for reuse by later sessions. Empty to disable. */
+  string cache_path;
 
   SceneParams()
   {
@@ -189,7 +193,8 @@ class SceneParams {
              use_bvh_spatial_split == params.use_bvh_spatial_split &&
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
-             persistent_data == params.persistent_data && texture_limit == params.texture_limit);
+             persistent_data == params.persistent_data && texture_limit == params.texture_limit &&
+             cache_path == params.cache_path);
   }
 };
 
@@ -225,6 +230,9 @@ class Scene {
   CurveSystemManager *curve_system_manager;
   BakeManager *bake_manager;
 
+  /* on-disk cache of preprocessing results */
+  SceneCache *cache;
+
   /* default shaders */
   Shader *default_surface;
   Shader *default_light;
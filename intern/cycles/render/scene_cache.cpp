@@ -0,0 +1,197 @@
+/*
+ * Copyright 2011-2019 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "render/scene_cache.h"
+#include "render/stats.h"
+
+#include "util/util_atomic.h"
+#include "util/util_logging.h"
+#include "util/util_md5.h"
+#include "util/util_path.h"
+#include "util/util_system.h"
+#include "util/util_version.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Increase when the layout of any cache entry changes. */
+#define SCENE_CACHE_VERSION 1
+
+static const char *scene_cache_magic = "CCSC";
+
+static const char *scene_cache_type_name(SceneCacheType type)
+{
+  switch (type) {
+    case SCENE_CACHE_SHADER:
+      return "shader";
+    case SCENE_CACHE_BACKGROUND:
+      return "background";
+    case SCENE_CACHE_NUM_TYPES:
+      break;
+  }
+  assert(!"Unknown scene cache type");
+  return "";
+}
+
+/* Scene Cache */
+
+SceneCache::SceneCache()
+{
+  memset(hits, 0, sizeof(hits));
+  memset(misses, 0, sizeof(misses));
+}
+
+void SceneCache::set_directory(const string &directory_)
+{
+  directory = directory_;
+  if (!directory.empty()) {
+    path_create_directories(path_join(directory, ""));
+  }
+}
+
+string SceneCache::entry_path(SceneCacheType type, const string &hash)
+{
+  /* Entries of different Cycles versions are kept apart, since compiled data
+   * is only valid for the kernel it was compiled for. */
+  MD5Hash md5;
+  md5.append(hash);
+  md5.append(CYCLES_VERSION_STRING);
+  return path_join(directory, string(scene_cache_type_name(type)) + "_" + md5.get_hex());
+}
+
+bool SceneCache::read(SceneCacheType type, const string &hash, vector<uint8_t> &data)
+{
+  if (!enabled()) {
+    return false;
+  }
+
+  vector<uint8_t> binary;
+  const size_t header_size = 4 + sizeof(uint) + sizeof(uint64_t);
+
+  if (path_read_binary(entry_path(type, hash), binary) && binary.size() >= header_size) {
+    uint version;
+    uint64_t size;
+    memcpy(&version, &binary[4], sizeof(version));
+    memcpy(&size, &binary[4 + sizeof(version)], sizeof(size));
+
+    if (memcmp(&binary[0], scene_cache_magic, 4) == 0 && version == SCENE_CACHE_VERSION &&
+        size == binary.size() - header_size) {
+      data.assign(binary.begin() + header_size, binary.end());
+      atomic_fetch_and_inc_uint32(&hits[type]);
+      return true;
+    }
+
+    VLOG(1) << "Ignoring invalid " << scene_cache_type_name(type) << " cache entry " << hash;
+  }
+
+  atomic_fetch_and_inc_uint32(&misses[type]);
+  return false;
+}
+
+void SceneCache::write(SceneCacheType type, const string &hash, const vector<uint8_t> &data)
+{
+  if (!enabled()) {
+    return;
+  }
+
+  const uint version = SCENE_CACHE_VERSION;
+  const uint64_t size = data.size();
+
+  SceneCacheWriter writer;
+  writer.write_data(scene_cache_magic, 4);
+  writer.write(version);
+  writer.write(size);
+  writer.write_data(data.data(), data.size());
+
+  /* Write to a temporary file and rename it, so other processes sharing the
+   * cache never read a partially written entry. The name is unique for every
+   * write of every process, so concurrent writers never share a file. */
+  static uint temp_counter = 0;
+  const string path = entry_path(type, hash);
+  const string temp_path = string_printf("%s.%llu.%u.tmp",
+                                         path.c_str(),
+                                         (unsigned long long)system_self_process_id(),
+                                         atomic_fetch_and_add_uint32(&temp_counter, 1));
+
+  if (!path_write_binary(temp_path, writer.data) || !path_rename(temp_path, path)) {
+    VLOG(1) << "Failed to write " << scene_cache_type_name(type) << " cache entry " << path;
+    path_remove(temp_path);
+  }
+}
+
+void SceneCache::reject(SceneCacheType type)
+{
+  atomic_fetch_and_dec_uint32(&hits[type]);
+  atomic_fetch_and_inc_uint32(&misses[type]);
+}
+
+void SceneCache::collect_statistics(RenderStats *stats)
+{
+  stats->cache.shader_hits = hits[SCENE_CACHE_SHADER];
+  stats->cache.shader_misses = misses[SCENE_CACHE_SHADER];
+  stats->cache.background_hits = hits[SCENE_CACHE_BACKGROUND];
+  stats->cache.background_misses = misses[SCENE_CACHE_BACKGROUND];
+}
+
+/* Cache Entry Writer */
+
+void SceneCacheWriter::write_string(const string &value)
+{
+  const uint size = value.size();
+  write(size);
+  write_data(value.data(), size);
+}
+
+void SceneCacheWriter::write_data(const void *value, size_t size)
+{
+  const uint8_t *bytes = (const uint8_t *)value;
+  data.insert(data.end(), bytes, bytes + size);
+}
+
+/* Cache Entry Reader */
+
+SceneCacheReader::SceneCacheReader(const vector<uint8_t> &data_)
+    : data(data_), offset(0), valid(true)
+{
+}
+
+bool SceneCacheReader::read_string(string &value)
+{
+  uint size;
+  if (!read(size) || size > data.size() - offset) {
+    valid = false;
+    return false;
+  }
+  value.assign((const char *)&data[offset], size);
+  offset += size;
+  return true;
+}
+
+bool SceneCacheReader::read_data(void *value, size_t size)
+{
+  if (!valid || size > data.size() - offset) {
+    valid = false;
+    return false;
+  }
+  if (size > 0) {
+    memcpy(value, &data[offset], size);
+  }
+  offset += size;
+  return true;
+}
+
+CCL_NAMESPACE_END
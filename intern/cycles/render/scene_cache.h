@@ -0,0 +1,114 @@
+/*
+ * Copyright 2011-2019 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __SCENE_CACHE_H__
+#define __SCENE_CACHE_H__
+
+#include "util/util_string.h"
+#include "util/util_types.h"
+#include "util/util_vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+class RenderStats;
+
+/* Scene Cache
+ *
+ * Stores compiled shaders and other scene preprocessing results on disk, so
+ * sessions rendering the same scene again can skip that work. Every entry is
+ * named by a hash of all data it was computed from, entries are never
+ * invalidated, only looked up under a different name when anything changes.
+ *
+ * Multiple processes may share a cache directory. Entries are written to a
+ * temporary file first and then renamed, and read entries are validated, so
+ * a missing or damaged entry is simply a cache miss. */
+
+enum SceneCacheType {
+  SCENE_CACHE_SHADER = 0,
+  SCENE_CACHE_BACKGROUND,
+
+  SCENE_CACHE_NUM_TYPES,
+};
+
+class SceneCache {
+ public:
+  SceneCache();
+
+  /* Empty directory disables the cache. */
+  void set_directory(const string &directory);
+  bool enabled() const
+  {
+    return !directory.empty();
+  }
+
+  /* Read the entry with the given hash, counting a hit or a miss. */
+  bool read(SceneCacheType type, const string &hash, vector<uint8_t> &data);
+  void write(SceneCacheType type, const string &hash, const vector<uint8_t> &data);
+
+  /* Count a miss for an entry that was found in the cache but could not be
+   * used, for example because it depends on state of the current session. */
+  void reject(SceneCacheType type);
+
+  void collect_statistics(RenderStats *stats);
+
+ protected:
+  string entry_path(SceneCacheType type, const string &hash);
+
+  string directory;
+  uint hits[SCENE_CACHE_NUM_TYPES];
+  uint misses[SCENE_CACHE_NUM_TYPES];
+};
+
+/* Utilities to pack and unpack the content of cache entries. */
+
+class SceneCacheWriter {
+ public:
+  template<typename T> void write(const T &value)
+  {
+    write_data(&value, sizeof(T));
+  }
+  void write_string(const string &value);
+  void write_data(const void *value, size_t size);
+
+  vector<uint8_t> data;
+};
+
+class SceneCacheReader {
+ public:
+  explicit SceneCacheReader(const vector<uint8_t> &data);
+
+  template<typename T> bool read(T &value)
+  {
+    return read_data(&value, sizeof(T));
+  }
+  bool read_string(string &value);
+  bool read_data(void *value, size_t size);
+
+  /* True when all data was read without running out of bounds. */
+  bool finished() const
+  {
+    return valid && offset == data.size();
+  }
+
+ protected:
+  const vector<uint8_t> &data;
+  size_t offset;
+  bool valid;
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __SCENE_CACHE_H__ */
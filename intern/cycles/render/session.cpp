@@ -29,6 +29,7 @@
 #include "render/session.h"
 #include "render/bake.h"
 
+#include "util/util_debug.h"
 #include "util/util_foreach.h"
 #include "util/util_function.h"
 #include "util/util_logging.h"
@@ -72,12 +73,27 @@ Session::Session(const SessionParams &params_)
     display = new DisplayBuffer(device, params.display_buffer_linear);
   }
 
+  /* Balance the load at the end of final renders. Stealing samples requires separate
+   * buffers per tile and a device that claims samples one at a time, which the CPU
+   * split kernel does not as it renders all samples of a tile at once. */
+  tile_manager.num_workers = (params.device.type == DEVICE_CPU) ?
+                                 TaskScheduler::num_threads() :
+                                 max(params.device.multi_devices.size(), 1);
+  tile_manager.use_tile_splitting = params.background && !params.progressive_refine;
+  tile_manager.use_sample_stealing = tile_manager.use_tile_splitting &&
+                                     (params.device.type == DEVICE_CPU) && (buffers == NULL) &&
+                                     !DebugFlags().cpu.split_kernel;
+
   session_thread = NULL;
   scene = NULL;
 
   reset_time = 0.0;
   last_update_time = 0.0;
 
+  tail_idle_time = 0.0;
+  idle_start_time_sum = 0.0;
+  num_idle_workers = 0;
+
   delayed_reset.do_reset = false;
   delayed_reset.samples = 0;
 
@@ -300,6 +316,7 @@ void Session::run_gpu()
       render();
 
       device->task_wait();
+      update_tail_idle_time();
 
       if (!device->error_message().empty())
         progress.set_cancel(device->error_message());
@@ -388,23 +405,57 @@ bool Session::acquire_tile(Device *tile_device, RenderTile &rtile)
   /* get next tile from manager */
   Tile *tile;
   int device_num = device->device_number(tile_device);
+  int start_sample = tile_manager.state.sample;
+  int num_samples = tile_manager.state.num_samples;
+  bool stolen = false;
+
+  if (!tile_manager.next_tile(tile, device_num)) {
+    /* steal samples from a tile other workers are still rendering */
+    if (!tile_manager.steal_tile_samples(tile, start_sample, num_samples)) {
+      if (!progress.get_cancel()) {
+        idle_start_time_sum += time_dt();
+        num_idle_workers++;
+      }
+      return false;
+    }
 
-  if (!tile_manager.next_tile(tile, device_num))
-    return false;
+    stolen = true;
+  }
 
   /* fill render tile */
   rtile.x = tile_manager.state.buffer.full_x + tile->x;
   rtile.y = tile_manager.state.buffer.full_y + tile->y;
   rtile.w = tile->w;
   rtile.h = tile->h;
-  rtile.start_sample = tile_manager.state.sample;
-  rtile.num_samples = tile_manager.state.num_samples;
+  rtile.start_sample = start_sample;
+  rtile.num_samples = num_samples;
   rtile.resolution = tile_manager.state.resolution_divider;
   rtile.tile_index = tile->index;
   rtile.task = (tile->state == Tile::DENOISE) ? RenderTile::DENOISE : RenderTile::PATH_TRACE;
+  rtile.sample_counter = (tile_manager.use_sample_stealing && !stolen) ? &tile->next_sample :
+                                                                          NULL;
+  rtile.stolen = stolen;
 
   tile_lock.unlock();
 
+  if (stolen) {
+    /* stolen samples are rendered into separate buffers, accumulated into the
+     * tile buffers once all parts of the tile are done */
+    BufferParams buffer_params = tile_manager.params;
+    buffer_params.full_x = rtile.x;
+    buffer_params.full_y = rtile.y;
+    buffer_params.width = rtile.w;
+    buffer_params.height = rtile.h;
+
+    rtile.buffers = new RenderBuffers(tile_device);
+    rtile.buffers->reset(buffer_params);
+    rtile.buffers->params.get_offset_stride(rtile.offset, rtile.stride);
+    rtile.buffer = rtile.buffers->buffer.device_pointer;
+    rtile.sample = rtile.start_sample;
+
+    return true;
+  }
+
   /* in case of a permanent buffer, return it, otherwise we will allocate
    * a new temporary buffer */
   if (buffers) {
@@ -435,7 +486,7 @@ bool Session::acquire_tile(Device *tile_device, RenderTile &rtile)
 
   rtile.buffer = tile->buffers->buffer.device_pointer;
   rtile.buffers = tile->buffers;
-  rtile.sample = tile_manager.state.sample;
+  rtile.sample = rtile.start_sample;
 
   /* this will tag tile as IN PROGRESS in blender-side render pipeline,
    * which is needed to highlight currently rendering tile before first
@@ -450,7 +501,7 @@ void Session::update_tile_sample(RenderTile &rtile)
 {
   thread_scoped_lock tile_lock(tile_mutex);
 
-  if (update_render_tile_cb) {
+  if (update_render_tile_cb && !rtile.stolen) {
     if (params.progressive_refine == false) {
       /* todo: optimize this by making it thread safe and removing lock */
 
@@ -461,10 +512,40 @@ void Session::update_tile_sample(RenderTile &rtile)
   update_status_time();
 }
 
+/* Returns whether all parts of the tile are rendered, in which case rtile is updated
+ * to refer to the full tile with the buffers of all parts accumulated. */
+bool Session::release_tile_part(RenderTile &rtile)
+{
+  int num_rendered_samples = rtile.sample - rtile.start_sample;
+  if (!tile_manager.finish_tile_part(
+          rtile.tile_index, (rtile.stolen) ? rtile.buffers : NULL, num_rendered_samples)) {
+    return false;
+  }
+
+  Tile &tile = tile_manager.state.tiles[rtile.tile_index];
+  if (rtile.stolen || num_rendered_samples != tile.num_rendered_samples) {
+    rtile.buffers = tile.buffers;
+    rtile.buffer = tile.buffers->buffer.device_pointer;
+    tile.buffers->params.get_offset_stride(rtile.offset, rtile.stride);
+    rtile.start_sample = tile_manager.state.sample;
+    rtile.num_samples = tile_manager.state.num_samples;
+    rtile.sample = rtile.start_sample + tile.num_rendered_samples;
+    rtile.sample_counter = NULL;
+    rtile.stolen = false;
+  }
+
+  return true;
+}
+
 void Session::release_tile(RenderTile &rtile)
 {
   thread_scoped_lock tile_lock(tile_mutex);
 
+  if (rtile.task == RenderTile::PATH_TRACE && !release_tile_part(rtile)) {
+    update_status_time();
+    return;
+  }
+
   progress.add_finished_tile(rtile.task == RenderTile::DENOISE);
 
   bool delete_tile;
@@ -657,6 +738,7 @@ void Session::run_cpu()
     }
 
     device->task_wait();
+    update_tail_idle_time();
 
     {
       thread_scoped_lock reset_lock(delayed_reset.mutex);
@@ -1124,8 +1206,37 @@ void Session::device_free()
    */
 }
 
+/* Accumulate the time workers were idle at the end of the last render pass. */
+void Session::update_tail_idle_time()
+{
+  thread_scoped_lock tile_lock(tile_mutex);
+
+  if (num_idle_workers > 0) {
+    tail_idle_time += num_idle_workers * time_dt() - idle_start_time_sum;
+  }
+
+  idle_start_time_sum = 0.0;
+  num_idle_workers = 0;
+}
+
 void Session::collect_statistics(RenderStats *render_stats)
 {
+  render_stats->tiles.num_split_tiles = tile_manager.num_split_tiles;
+  render_stats->tiles.num_stolen_ranges = tile_manager.num_stolen_ranges;
+  render_stats->tiles.tail_idle_time = tail_idle_time;
+
+  vector<pair<string, double>> sync_times;
+  progress.get_sync_times(sync_times);
+  for (size_t i = 0; i < sync_times.size(); i++) {
+    render_stats->sync.add_entry(NamedTimeEntry(sync_times[i].first, sync_times[i].second));
+  }
+
+  vector<pair<string, double>> update_times;
+  progress.get_update_times(update_times);
+  for (size_t i = 0; i < update_times.size(); i++) {
+    render_stats->update.add_entry(NamedTimeEntry(update_times[i].first, update_times[i].second));
+  }
+
   scene->collect_statistics(render_stats);
   if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
     render_stats->collect_profiling(scene, profiler);
@@ -191,6 +191,7 @@ class Session {
   bool acquire_tile(Device *tile_device, RenderTile &tile);
   void update_tile_sample(RenderTile &tile);
   void release_tile(RenderTile &tile);
+  bool release_tile_part(RenderTile &tile);
 
   void map_neighbor_tiles(RenderTile *tiles, Device *tile_device);
   void unmap_neighbor_tiles(RenderTile *tiles, Device *tile_device);
@@ -217,6 +218,13 @@ class Session {
 
   double reset_time;
 
+  /* Time workers are idle at the end of rendering, after running out of tiles
+   * while others are still rendering. */
+  double tail_idle_time;
+  double idle_start_time_sum;
+  int num_idle_workers;
+  void update_tail_idle_time();
+
   /* progressive refine */
   double last_update_time;
   bool update_progressive_refine(bool cancel);
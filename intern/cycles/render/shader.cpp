@@ -448,6 +448,36 @@ uint ShaderManager::get_attribute_id(AttributeStandard std)
   return (uint)std;
 }
 
+bool ShaderManager::get_attribute_ids_if_match(const vector<ustring> &names,
+                                               const vector<uint> &ids)
+{
+  assert(names.size() == ids.size());
+
+  thread_scoped_spin_lock lock(attribute_lock_);
+
+  /* ids that would be assigned to names used for the first time */
+  AttributeIDMap new_attribute_id;
+
+  for (size_t i = 0; i < names.size(); i++) {
+    AttributeIDMap::iterator it = unique_attribute_id.find(names[i]);
+    if (it == unique_attribute_id.end()) {
+      it = new_attribute_id.find(names[i]);
+      if (it == new_attribute_id.end()) {
+        uint id = (uint)ATTR_STD_NUM + unique_attribute_id.size() + new_attribute_id.size();
+        new_attribute_id[names[i]] = id;
+        it = new_attribute_id.find(names[i]);
+      }
+    }
+
+    if (it->second != ids[i]) {
+      return false;
+    }
+  }
+
+  unique_attribute_id.insert(new_attribute_id.begin(), new_attribute_id.end());
+  return true;
+}
+
 int ShaderManager::get_shader_id(Shader *shader, bool smooth)
 {
   /* get a shader id to pass to the kernel */
@@ -549,6 +579,10 @@ void ShaderManager::device_update_common(Device *device,
 
     uint32_t cryptomatte_id = util_murmur_hash3(shader->name.c_str(), shader->name.length(), 0);
 
+    /* Nodes used by the shader, so the kernel can use an interpreter specialized for them. */
+    DeviceRequestedFeatures shader_features;
+    get_requested_shader_features(shader, &shader_features);
+
     /* regular shader */
     kshader->flags = flag;
     kshader->pass_id = shader->pass_id;
@@ -556,6 +590,8 @@ void ShaderManager::device_update_common(Device *device,
     kshader->constant_emission[1] = constant_emission.y;
     kshader->constant_emission[2] = constant_emission.z;
     kshader->cryptomatte_id = util_hash_to_float(cryptomatte_id);
+    kshader->nodes_group = shader_features.max_nodes_group;
+    kshader->nodes_features = shader_features.nodes_features;
     kshader++;
 
     has_transparent_shadow |= (flag & SD_HAS_TRANSPARENT_SHADOW) != 0;
@@ -696,22 +732,28 @@ void ShaderManager::get_requested_features(Scene *scene,
   requested_features->nodes_features = 0;
   for (int i = 0; i < scene->shaders.size(); i++) {
     Shader *shader = scene->shaders[i];
-    /* Gather requested features from all the nodes from the graph nodes. */
-    get_requested_graph_features(shader->graph, requested_features);
-    ShaderNode *output_node = shader->graph->output();
-    if (output_node->input("Displacement")->link != NULL) {
-      requested_features->nodes_features |= NODE_FEATURE_BUMP;
-      if (shader->displacement_method == DISPLACE_BOTH) {
-        requested_features->nodes_features |= NODE_FEATURE_BUMP_STATE;
-        requested_features->max_nodes_group = max(requested_features->max_nodes_group,
-                                                  NODE_GROUP_LEVEL_1);
-      }
+    get_requested_shader_features(shader, requested_features);
+  }
+}
+
+void ShaderManager::get_requested_shader_features(Shader *shader,
+                                                  DeviceRequestedFeatures *requested_features)
+{
+  /* Gather requested features from all the nodes from the graph nodes. */
+  get_requested_graph_features(shader->graph, requested_features);
+  ShaderNode *output_node = shader->graph->output();
+  if (output_node->input("Displacement")->link != NULL) {
+    requested_features->nodes_features |= NODE_FEATURE_BUMP;
+    if (shader->displacement_method == DISPLACE_BOTH) {
+      requested_features->nodes_features |= NODE_FEATURE_BUMP_STATE;
+      requested_features->max_nodes_group = max(requested_features->max_nodes_group,
+                                                NODE_GROUP_LEVEL_1);
     }
-    /* On top of volume nodes, also check if we need volume sampling because
-     * e.g. an Emission node would slip through the NODE_FEATURE_VOLUME check */
-    if (shader->has_volume)
-      requested_features->use_volume |= true;
   }
+  /* On top of volume nodes, also check if we need volume sampling because
+   * e.g. an Emission node would slip through the NODE_FEATURE_VOLUME check */
+  if (shader->has_volume)
+    requested_features->use_volume |= true;
 }
 
 void ShaderManager::free_memory()
@@ -187,6 +187,9 @@ class ShaderManager {
   /* get globally unique id for a type of attribute */
   uint get_attribute_id(ustring name);
   uint get_attribute_id(AttributeStandard std);
+  /* get ids for all names, only if get_attribute_id() would give the expected
+   * ids for them, otherwise no new ids are assigned */
+  bool get_attribute_ids_if_match(const vector<ustring> &names, const vector<uint> &ids);
 
   /* get shader id for mesh faces */
   int get_shader_id(Shader *shader, bool smooth = false);
@@ -218,6 +221,8 @@ class ShaderManager {
 
   void get_requested_graph_features(ShaderGraph *graph,
                                     DeviceRequestedFeatures *requested_features);
+  void get_requested_shader_features(Shader *shader,
+                                     DeviceRequestedFeatures *requested_features);
 
   thread_spin_lock attribute_lock_;
 
@@ -87,6 +87,42 @@ string NamedSizeStats::full_report(int indent_level)
   return result;
 }
 
+/* Named time entry. */
+
+NamedTimeEntry::NamedTimeEntry() : name(""), time(0.0)
+{
+}
+
+NamedTimeEntry::NamedTimeEntry(const string &name, double time) : name(name), time(time)
+{
+}
+
+/* Named time statistics. */
+
+NamedTimeStats::NamedTimeStats() : total_time(0.0)
+{
+}
+
+void NamedTimeStats::add_entry(const NamedTimeEntry &entry)
+{
+  total_time += entry.time;
+  entries.push_back(entry);
+}
+
+string NamedTimeStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  const string double_indent = indent + indent;
+  string result = "";
+  result += string_printf("%sTotal time: %.2fs\n", indent.c_str(), total_time);
+  /* Entries are kept in the order they were added, which is the order of the phases. */
+  foreach (const NamedTimeEntry &entry, entries) {
+    result += string_printf(
+        "%s%-32s %.2fs\n", double_indent.c_str(), entry.name.c_str(), entry.time);
+  }
+  return result;
+}
+
 /* Named time sample statistics. */
 
 NamedNestedSampleStats::NamedNestedSampleStats() : name(""), self_samples(0), sum_samples(0)
@@ -207,6 +243,12 @@ string MeshStats::full_report(int indent_level)
   const string indent(indent_level * kIndentNumSpaces, ' ');
   string result = "";
   result += indent + "Geometry:\n" + geometry.full_report(indent_level + 1);
+  if (!tessellation.entries.empty()) {
+    result += indent + "Tessellation:\n" + tessellation.full_report(indent_level + 1);
+  }
+  if (!displacement.entries.empty()) {
+    result += indent + "Displacement:\n" + displacement.full_report(indent_level + 1);
+  }
   return result;
 }
 
@@ -224,6 +266,42 @@ string ImageStats::full_report(int indent_level)
   return result;
 }
 
+/* Tile statistics. */
+
+TileStats::TileStats() : num_split_tiles(0), num_stolen_ranges(0), tail_idle_time(0.0)
+{
+}
+
+string TileStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  string result = "";
+  result += string_printf("%sSplit tiles: %d\n", indent.c_str(), num_split_tiles);
+  result += string_printf("%sStolen sample ranges: %d\n", indent.c_str(), num_stolen_ranges);
+  result += string_printf("%sTail idle time: %.2fs\n", indent.c_str(), tail_idle_time);
+  return result;
+}
+
+/* Scene cache statistics. */
+
+CacheStats::CacheStats()
+    : shader_hits(0), shader_misses(0), background_hits(0), background_misses(0)
+{
+}
+
+string CacheStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  string result = "";
+  result += string_printf(
+      "%sShaders: %d hits, %d misses\n", indent.c_str(), shader_hits, shader_misses);
+  result += string_printf("%sBackground importance map: %d hits, %d misses\n",
+                          indent.c_str(),
+                          background_hits,
+                          background_misses);
+  return result;
+}
+
 /* Overall statistics. */
 
 RenderStats::RenderStats()
@@ -304,6 +382,14 @@ void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
 string RenderStats::full_report()
 {
   string result = "";
+  if (!sync.entries.empty()) {
+    result += "Synchronization statistics:\n" + sync.full_report(1);
+  }
+  if (!update.entries.empty()) {
+    result += "Scene update statistics:\n" + update.full_report(1);
+  }
+  result += "Tile statistics:\n" + tiles.full_report(1);
+  result += "Scene cache statistics:\n" + cache.full_report(1);
   result += "Mesh statistics:\n" + mesh.full_report(1);
   result += "Image statistics:\n" + image.full_report(1);
   if (has_profiling) {
@@ -64,6 +64,34 @@ class NamedSizeStats {
   vector<NamedSizeEntry> entries;
 };
 
+class NamedTimeEntry {
+ public:
+  NamedTimeEntry();
+  NamedTimeEntry(const string &name, double time);
+
+  string name;
+  double time;
+};
+
+class NamedTimeStats {
+ public:
+  NamedTimeStats();
+
+  /* Add entry to the statistics. */
+  void add_entry(const NamedTimeEntry &entry);
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+
+  /* Total time of all entries, in seconds. */
+  double total_time;
+
+  /* NOTE: Is fine to read directly, but for adding use add_entry(), which
+   * makes sure all accumulating values are properly updated.
+   */
+  vector<NamedTimeEntry> entries;
+};
+
 class NamedNestedSampleStats {
  public:
   NamedNestedSampleStats();
@@ -122,6 +150,10 @@ class MeshStats {
    * memory like BVH.
    */
   NamedSizeStats geometry;
+
+  /* Time spent tessellating and displacing each mesh in the last update. */
+  NamedTimeStats tessellation;
+  NamedTimeStats displacement;
 };
 
 /* Statistics about images held in memory. */
@@ -136,6 +168,34 @@ class ImageStats {
 };
 
 /* Render process statistics. */
+class TileStats {
+ public:
+  TileStats();
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+
+  /* Tiles split and sample ranges stolen to balance the load at the end of rendering. */
+  int num_split_tiles;
+  int num_stolen_ranges;
+
+  /* Time summed over all workers that were idle at the end of rendering, while
+   * the last tiles were still rendering. */
+  double tail_idle_time;
+};
+
+/* Scene cache statistics. */
+class CacheStats {
+ public:
+  CacheStats();
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+
+  int shader_hits, shader_misses;
+  int background_hits, background_misses;
+};
+
 class RenderStats {
  public:
   RenderStats();
@@ -148,6 +208,12 @@ class RenderStats {
 
   bool has_profiling;
 
+  /* Time spent in each phase of scene synchronization. */
+  NamedTimeStats sync;
+  /* Time spent in tessellation, displacement and BVH build during scene update. */
+  NamedTimeStats update;
+  TileStats tiles;
+  CacheStats cache;
   MeshStats mesh;
   ImageStats image;
   NamedNestedSampleStats kernel;
@@ -16,15 +16,18 @@
 
 #include "device/device.h"
 #include "render/graph.h"
+#include "render/integrator.h"
 #include "render/light.h"
 #include "render/mesh.h"
 #include "render/nodes.h"
 #include "render/scene.h"
+#include "render/scene_cache.h"
 #include "render/shader.h"
 #include "render/svm.h"
 
 #include "util/util_logging.h"
 #include "util/util_foreach.h"
+#include "util/util_md5.h"
 #include "util/util_progress.h"
 #include "util/util_task.h"
 
@@ -44,6 +47,22 @@ void SVMShaderManager::reset(Scene * /*scene*/)
 {
 }
 
+/* Finalize the shader graph for compilation, returns whether bump is generated
+ * from displacement. */
+static bool svm_graph_finalize(Scene *scene, Shader *shader)
+{
+  ShaderNode *output = shader->graph->output();
+  bool has_bump = (shader->displacement_method != DISPLACE_TRUE) &&
+                  output->input("Surface")->link && output->input("Displacement")->link;
+
+  shader->graph->finalize(scene,
+                          has_bump,
+                          shader->has_integrator_dependency,
+                          shader->displacement_method == DISPLACE_BOTH);
+
+  return has_bump;
+}
+
 void SVMShaderManager::device_update_shader(Scene *scene,
                                             Shader *shader,
                                             Progress *progress,
@@ -54,6 +73,19 @@ void SVMShaderManager::device_update_shader(Scene *scene,
   }
   assert(shader->graph);
 
+  /* Reuse nodes compiled by an earlier session when the scene cache is enabled.
+   * The graph is finalized first, so it is hashed and used by the rest of the
+   * session in the same state whether the cache hits or not. */
+  string hash;
+  if (scene->cache->enabled()) {
+    svm_graph_finalize(scene, shader);
+    hash = cache_hash(scene, shader);
+    if (!hash.empty() && cache_read(scene, shader, hash, svm_nodes)) {
+      VLOG(2) << "Shader " << shader->name << " loaded from scene cache.";
+      return;
+    }
+  }
+
   svm_nodes->push_back_slow(make_int4(NODE_SHADER_JUMP, 0, 0, 0));
 
   SVMCompiler::Summary summary;
@@ -64,6 +96,135 @@ void SVMShaderManager::device_update_shader(Scene *scene,
   VLOG(2) << "Compilation summary:\n"
           << "Shader name: " << shader->name << "\n"
           << summary.full_report();
+
+  if (!hash.empty()) {
+    cache_write(scene, shader, hash, *svm_nodes, compiler.attribute_names);
+  }
+}
+
+/* Shader flags which are set by compilation, and so have to be stored in the cache. */
+static bool Shader::*const cache_shader_flags[] = {
+    &Shader::has_surface,
+    &Shader::has_surface_emission,
+    &Shader::has_surface_transparent,
+    &Shader::has_surface_bssrdf,
+    &Shader::has_bump,
+    &Shader::has_bssrdf_bump,
+    &Shader::has_volume,
+    &Shader::has_displacement,
+    &Shader::has_surface_spatial_varying,
+    &Shader::has_volume_spatial_varying,
+    &Shader::has_object_dependency,
+    &Shader::has_attribute_dependency,
+    &Shader::has_integrator_dependency,
+};
+
+static const int cache_num_shader_flags = sizeof(cache_shader_flags) /
+                                          sizeof(*cache_shader_flags);
+
+string SVMShaderManager::cache_hash(Scene *scene, Shader *shader)
+{
+  foreach (ShaderNode *node, shader->graph->nodes) {
+    if (node->has_resource_dependency()) {
+      return "";
+    }
+  }
+
+  MD5Hash md5;
+  shader->graph->hash(md5);
+
+  /* Shader settings and scene state used by graph finalization and compilation. */
+  md5.append(string_printf("%d %d %d %d",
+                           (int)shader->displacement_method,
+                           (int)shader->has_integrator_dependency,
+                           (int)shader->used,
+                           (int)(shader == scene->default_background)));
+
+  const float rgb_to_gray[3] = {linear_rgb_to_gray(make_float3(1.0f, 0.0f, 0.0f)),
+                                linear_rgb_to_gray(make_float3(0.0f, 1.0f, 0.0f)),
+                                linear_rgb_to_gray(make_float3(0.0f, 0.0f, 1.0f))};
+  md5.append((const uint8_t *)rgb_to_gray, sizeof(rgb_to_gray));
+  md5.append((uint8_t *)&scene->integrator->filter_glossy, sizeof(float));
+
+  return md5.get_hex();
+}
+
+bool SVMShaderManager::cache_read(Scene *scene,
+                                  Shader *shader,
+                                  const string &hash,
+                                  array<int4> *svm_nodes)
+{
+  vector<uint8_t> data;
+  if (!scene->cache->read(SCENE_CACHE_SHADER, hash, data)) {
+    return false;
+  }
+
+  SceneCacheReader reader(data);
+
+  uint flags = 0, num_attributes = 0, num_nodes = 0;
+  reader.read(flags);
+  reader.read(num_attributes);
+
+  vector<ustring> attribute_names;
+  vector<uint> attribute_ids;
+  for (uint i = 0; i < num_attributes; i++) {
+    uint id;
+    string name;
+    if (!reader.read(id) || !reader.read_string(name)) {
+      break;
+    }
+    attribute_names.push_back(ustring(name));
+    attribute_ids.push_back(id);
+  }
+
+  array<int4> nodes;
+  if (reader.read(num_nodes) && num_nodes <= data.size() / sizeof(int4)) {
+    nodes.resize(num_nodes);
+    reader.read_data(nodes.data(), sizeof(int4) * num_nodes);
+  }
+
+  /* Attribute IDs are assigned in the order they are first used, so the
+   * compiled nodes are only valid if this session assigns the same IDs.
+   * Only check that once the entry is known to be complete, so rejected
+   * entries don't register attributes. */
+  if (!reader.finished() || nodes.size() == 0 ||
+      !get_attribute_ids_if_match(attribute_names, attribute_ids)) {
+    scene->cache->reject(SCENE_CACHE_SHADER);
+    return false;
+  }
+
+  for (int i = 0; i < cache_num_shader_flags; i++) {
+    shader->*cache_shader_flags[i] = (flags & (1 << i)) != 0;
+  }
+  svm_nodes->steal_data(nodes);
+
+  return true;
+}
+
+void SVMShaderManager::cache_write(Scene *scene,
+                                   Shader *shader,
+                                   const string &hash,
+                                   const array<int4> &svm_nodes,
+                                   const vector<ustring> &attribute_names)
+{
+  uint flags = 0;
+  for (int i = 0; i < cache_num_shader_flags; i++) {
+    if (shader->*cache_shader_flags[i]) {
+      flags |= (1 << i);
+    }
+  }
+
+  SceneCacheWriter writer;
+  writer.write(flags);
+  writer.write((uint)attribute_names.size());
+  foreach (ustring name, attribute_names) {
+    writer.write(get_attribute_id(name));
+    writer.write_string(name.string());
+  }
+  writer.write((uint)svm_nodes.size());
+  writer.write_data(svm_nodes.data(), sizeof(int4) * svm_nodes.size());
+
+  scene->cache->write(SCENE_CACHE_SHADER, hash, writer.data);
 }
 
 void SVMShaderManager::device_update(Device *device,
@@ -408,6 +569,7 @@ void SVMCompiler::add_node(const float4 &f)
 
 uint SVMCompiler::attribute(ustring name)
 {
+  attribute_names.push_back(name);
   return shader_manager->get_attribute_id(name);
 }
 
@@ -799,22 +961,15 @@ void SVMCompiler::compile_type(Shader *shader, ShaderGraph *graph, ShaderType ty
 void SVMCompiler::compile(
     Scene *scene, Shader *shader, array<int4> &svm_nodes, int index, Summary *summary)
 {
-  /* copy graph for shader with bump mapping */
-  ShaderNode *output = shader->graph->output();
   int start_num_svm_nodes = svm_nodes.size();
 
   const double time_start = time_dt();
 
-  bool has_bump = (shader->displacement_method != DISPLACE_TRUE) &&
-                  output->input("Surface")->link && output->input("Displacement")->link;
-
   /* finalize */
+  bool has_bump;
   {
     scoped_timer timer((summary != NULL) ? &summary->time_finalize : NULL);
-    shader->graph->finalize(scene,
-                            has_bump,
-                            shader->has_integrator_dependency,
-                            shader->displacement_method == DISPLACE_BOTH);
+    has_bump = svm_graph_finalize(scene, shader);
   }
 
   current_shader = shader;
@@ -54,6 +54,16 @@ class SVMShaderManager : public ShaderManager {
                             Shader *shader,
                             Progress *progress,
                             array<int4> *svm_nodes);
+
+  /* Scene cache of compiled shaders. The hash is empty for shaders which can
+   * not be cached, because they use images or other data owned by the scene. */
+  string cache_hash(Scene *scene, Shader *shader);
+  bool cache_read(Scene *scene, Shader *shader, const string &hash, array<int4> *svm_nodes);
+  void cache_write(Scene *scene,
+                   Shader *shader,
+                   const string &hash,
+                   const array<int4> &svm_nodes,
+                   const vector<ustring> &attribute_names);
 };
 
 /* Graph Compiler */
@@ -131,6 +141,9 @@ class SVMCompiler {
   LightManager *light_manager;
   bool background;
 
+  /* Names of non-standard attributes the compiled nodes look up. */
+  vector<ustring> attribute_names;
+
  protected:
   /* stack */
   struct Stack {
@@ -17,6 +17,7 @@
 #include "render/tile.h"
 
 #include "util/util_algorithm.h"
+#include "util/util_atomic.h"
 #include "util/util_foreach.h"
 #include "util/util_types.h"
 
@@ -24,6 +25,12 @@ CCL_NAMESPACE_BEGIN
 
 namespace {
 
+/* Tiles are not split into tiles smaller than this, in pixels. */
+const int kTileSplitMinSize = 16;
+
+/* Samples of a rendering tile are only stolen when at least twice this many are left. */
+const int kTileStealMinSamples = 2;
+
 class TileComparator {
  public:
   TileComparator(TileOrder order_, int2 center_, Tile *tiles_)
@@ -107,6 +114,10 @@ TileManager::TileManager(bool progressive_,
   background = background_;
   schedule_denoising = false;
 
+  num_workers = 1;
+  use_tile_splitting = false;
+  use_sample_stealing = false;
+
   range_start_sample = 0;
   range_num_samples = -1;
 
@@ -158,6 +169,9 @@ void TileManager::reset(BufferParams &params_, int num_samples_)
   state.render_tiles.clear();
   state.denoising_tiles.clear();
   device_free();
+
+  num_split_tiles = 0;
+  num_stolen_ranges = 0;
 }
 
 void TileManager::set_samples(int num_samples_)
@@ -375,6 +389,10 @@ void TileManager::set_tiles()
 
   state.num_tiles = gen_tiles(!background);
 
+  /* Reserve space for tiles split at the end of the render, tiles are referenced by
+   * pointer while rendering so they must not be reallocated. */
+  state.tiles.reserve(state.tiles.size() * 2 + num_workers * 4);
+
   state.buffer.width = image_w;
   state.buffer.height = image_h;
 
@@ -494,9 +512,148 @@ bool TileManager::next_tile(Tile *&tile, int device)
   if (state.render_tiles[logical_device].empty())
     return false;
 
+  if (can_split_tiles() && state.render_tiles[logical_device].size() < num_workers) {
+    split_tiles(state.render_tiles[logical_device]);
+  }
+
   int idx = state.render_tiles[logical_device].front();
   state.render_tiles[logical_device].pop_front();
   tile = &state.tiles[idx];
+
+  tile->next_sample = state.sample;
+  tile->end_sample = state.sample + state.num_samples;
+  tile->num_parts = 1;
+  tile->num_rendered_samples = 0;
+  return true;
+}
+
+/* Tiles can only be split in final renders, where they are independent of each other
+ * and their buffers are written out separately. */
+bool TileManager::can_split_tiles()
+{
+  return use_tile_splitting && background && !progressive && !schedule_denoising &&
+         !preserve_tile_device;
+}
+
+/* Split tiles that are not rendered yet in halves until there is one for every worker,
+ * so the last tiles of the render do not keep a few workers busy while others are idle.
+ * Tiles are split in turn so they remain about the same size. */
+void TileManager::split_tiles(list<int> &tile_list)
+{
+  int num_unsplittable = 0;
+
+  while (tile_list.size() < num_workers && num_unsplittable < tile_list.size() &&
+         state.tiles.size() < state.tiles.capacity()) {
+    int idx = tile_list.front();
+    tile_list.pop_front();
+
+    Tile *tile = &state.tiles[idx];
+    int new_idx = state.tiles.size();
+
+    if (tile->w >= tile->h && tile->w >= 2 * kTileSplitMinSize) {
+      int w = tile->w / 2;
+      state.tiles.push_back(
+          Tile(new_idx, tile->x + w, tile->y, tile->w - w, tile->h, tile->device, Tile::RENDER));
+      tile->w = w;
+    }
+    else if (tile->h >= 2 * kTileSplitMinSize) {
+      int h = tile->h / 2;
+      state.tiles.push_back(
+          Tile(new_idx, tile->x, tile->y + h, tile->w, tile->h - h, tile->device, Tile::RENDER));
+      tile->h = h;
+    }
+    else {
+      tile_list.push_back(idx);
+      num_unsplittable++;
+      continue;
+    }
+
+    tile_list.push_back(idx);
+    tile_list.push_back(new_idx);
+    state.num_tiles++;
+    num_split_tiles++;
+  }
+}
+
+/* Steal half of the samples left of the tile with the most work left, returns false
+ * if there is no tile worth stealing from. */
+bool TileManager::steal_tile_samples(Tile *&tile, int &start_sample, int &num_samples)
+{
+  if (!use_sample_stealing || !can_split_tiles()) {
+    return false;
+  }
+
+  /* Cryptomatte passes are not a plain sum over samples and can't be accumulated. */
+  foreach (const Pass &pass, params.passes) {
+    if (pass.type == PASS_CRYPTOMATTE) {
+      return false;
+    }
+  }
+
+  Tile *steal_tile = NULL;
+  int64_t steal_work = 0;
+
+  foreach (Tile &render_tile, state.tiles) {
+    if (render_tile.state != Tile::RENDER || render_tile.num_parts == 0) {
+      continue;
+    }
+
+    int next_sample = atomic_fetch_and_add_int32(&render_tile.next_sample, 0);
+    int num_left = render_tile.end_sample - next_sample;
+    int64_t work = (int64_t)num_left * render_tile.w * render_tile.h;
+
+    if (num_left >= 2 * kTileStealMinSamples && work > steal_work) {
+      steal_tile = &render_tile;
+      steal_work = work;
+    }
+  }
+
+  if (steal_tile == NULL) {
+    return false;
+  }
+
+  /* The thread rendering the tile keeps claiming samples after the stolen ones. */
+  int next_sample = atomic_fetch_and_add_int32(&steal_tile->next_sample, 0);
+  int num_steal = (steal_tile->end_sample - next_sample) / 2;
+  int steal_start = atomic_fetch_and_add_int32(&steal_tile->next_sample, num_steal);
+
+  num_steal = min(num_steal, steal_tile->end_sample - steal_start);
+  if (num_steal <= 0) {
+    return false;
+  }
+
+  steal_tile->num_parts++;
+  num_stolen_ranges++;
+
+  tile = steal_tile;
+  start_sample = steal_start;
+  num_samples = num_steal;
+  return true;
+}
+
+/* Returns whether all parts of the tile are rendered, accumulating the buffers of
+ * stolen parts into the tile buffers at that point. */
+bool TileManager::finish_tile_part(int index,
+                                   RenderBuffers *part_buffers,
+                                   int num_rendered_samples)
+{
+  Tile &tile = state.tiles[index];
+
+  tile.num_rendered_samples += num_rendered_samples;
+  if (part_buffers) {
+    tile.part_buffers.push_back(part_buffers);
+  }
+
+  if (--tile.num_parts > 0) {
+    return false;
+  }
+
+  foreach (RenderBuffers *buffers, tile.part_buffers) {
+    tile.buffers->accumulate(buffers);
+    delete buffers;
+  }
+  tile.part_buffers.clear();
+
   return true;
 }
 
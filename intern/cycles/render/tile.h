@@ -21,6 +21,7 @@
 
 #include "render/buffers.h"
 #include "util/util_list.h"
+#include "util/util_vector.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -40,12 +41,31 @@ class Tile {
   State state;
   RenderBuffers *buffers;
 
+  /* Samples are claimed from next_sample while the tile renders, so idle threads can
+   * steal part of the samples up to end_sample. Every thread rendering the tile is a part,
+   * the buffers of stolen parts are accumulated once all parts are done. */
+  int next_sample, end_sample;
+  int num_parts;
+  int num_rendered_samples;
+  vector<RenderBuffers *> part_buffers;
+
   Tile()
   {
   }
 
   Tile(int index_, int x_, int y_, int w_, int h_, int device_, State state_ = RENDER)
-      : index(index_), x(x_), y(y_), w(w_), h(h_), device(device_), state(state_), buffers(NULL)
+      : index(index_),
+        x(x_),
+        y(y_),
+        w(w_),
+        h(h_),
+        device(device_),
+        state(state_),
+        buffers(NULL),
+        next_sample(0),
+        end_sample(0),
+        num_parts(0),
+        num_rendered_samples(0)
   {
   }
 };
@@ -106,6 +126,8 @@ class TileManager {
   void set_samples(int num_samples);
   bool next();
   bool next_tile(Tile *&tile, int device = 0);
+  bool steal_tile_samples(Tile *&tile, int &start_sample, int &num_samples);
+  bool finish_tile_part(int index, RenderBuffers *part_buffers, int num_rendered_samples);
   bool finish_tile(int index, bool &delete_tile);
   bool done();
 
@@ -128,6 +150,21 @@ class TileManager {
   /* Schedule tiles for denoising after they've been rendered. */
   bool schedule_denoising;
 
+  /* ** Load balancing at the end of the render. ** */
+
+  /* Number of threads or devices asking for tiles. */
+  int num_workers;
+
+  /* Split tiles that are not rendered yet when fewer are left than workers. */
+  bool use_tile_splitting;
+
+  /* Let workers without tiles left steal samples of tiles that are still rendering,
+   * requires the device to claim samples through RenderTile::sample_counter. */
+  bool use_sample_stealing;
+
+  int num_split_tiles;
+  int num_stolen_ranges;
+
  protected:
   void set_tiles();
 
@@ -161,6 +198,9 @@ class TileManager {
   int gen_tiles(bool sliced);
   void gen_render_tiles();
 
+  bool can_split_tiles();
+  void split_tiles(list<int> &tile_list);
+
   int get_neighbor_index(int index, int neighbor);
   bool check_neighbor_state(int index, Tile::State state);
 };
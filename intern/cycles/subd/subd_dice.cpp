@@ -20,6 +20,8 @@
 #include "subd/subd_dice.h"
 #include "subd/subd_patch.h"
 
+#include "util/util_task.h"
+
 CCL_NAMESPACE_BEGIN
 
 /* EdgeDice Base */
@@ -45,8 +47,8 @@ void EdgeDice::reserve(int num_verts, int num_triangles)
   vert_offset = mesh->verts.size();
   tri_offset = mesh->num_triangles();
 
-  mesh->resize_mesh(mesh->verts.size() + num_verts, mesh->num_triangles());
-  mesh->reserve_mesh(mesh->verts.size() + num_verts, mesh->num_triangles() + num_triangles);
+  /* Allocate all triangles upfront, so they can be written from multiple threads. */
+  mesh->resize_mesh(mesh->verts.size() + num_verts, mesh->num_triangles() + num_triangles);
 
   Attribute *attr_vN = mesh->attributes.add(ATTR_STD_VERTEX_NORMAL);
 
@@ -69,17 +71,22 @@ void EdgeDice::set_vert(Patch *patch, int index, float2 uv)
   params.mesh->vert_patch_uv[index + vert_offset] = make_float2(uv.x, uv.y);
 }
 
-void EdgeDice::add_triangle(Patch *patch, int v0, int v1, int v2)
+void EdgeDice::add_triangle(Patch *patch, int index, int v0, int v1, int v2)
 {
   Mesh *mesh = params.mesh;
+  const size_t tri = tri_offset + index;
 
-  mesh->add_triangle(v0 + vert_offset, v1 + vert_offset, v2 + vert_offset, patch->shader, true);
-  params.mesh->triangle_patch[params.mesh->num_triangles() - 1] = patch->patch_index;
+  assert(tri < mesh->num_triangles());
 
-  tri_offset++;
+  mesh->triangles[tri * 3 + 0] = v0 + vert_offset;
+  mesh->triangles[tri * 3 + 1] = v1 + vert_offset;
+  mesh->triangles[tri * 3 + 2] = v2 + vert_offset;
+  mesh->shader[tri] = patch->shader;
+  mesh->smooth[tri] = true;
+  mesh->triangle_patch[tri] = patch->patch_index;
 }
 
-void EdgeDice::stitch_triangles(Subpatch &sub, int edge)
+void EdgeDice::stitch_triangles(Subpatch &sub, int edge, int &triangle)
 {
   int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
   int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
@@ -122,7 +129,7 @@ void EdgeDice::stitch_triangles(Subpatch &sub, int edge)
         v2 = sub.get_vert_along_grid_edge(edge, ++i);
     }
 
-    add_triangle(sub.patch, v1, v0, v2);
+    add_triangle(sub.patch, triangle++, v1, v0, v2);
   }
 }
 
@@ -157,12 +164,17 @@ void QuadDice::set_vert(Subpatch &sub, int index, float u, float v)
   EdgeDice::set_vert(sub.patch, index, map_uv(sub, u, v));
 }
 
-void QuadDice::set_side(Subpatch &sub, int edge)
+void QuadDice::set_side(Subpatch &sub, int edge, const int *vert_owner, int owner)
 {
   int t = sub.edges[edge].T;
 
-  /* set verts on the edge of the patch */
+  /* set verts on the edge of the patch, skipping those evaluated by another subpatch */
   for (int i = 0; i < t; i++) {
+    const int index = sub.get_vert_along_edge(edge, i);
+    if (vert_owner[index] != owner) {
+      continue;
+    }
+
     float f = i / (float)t;
 
     float u, v;
@@ -186,7 +198,7 @@ void QuadDice::set_side(Subpatch &sub, int edge)
         break;
     }
 
-    set_vert(sub, sub.get_vert_along_edge(edge, i), u, v);
+    set_vert(sub, index, u, v);
   }
 }
 
@@ -224,7 +236,23 @@ float QuadDice::scale_factor(Subpatch &sub, int Mu, int Mv)
   return S;
 }
 
-void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
+void QuadDice::grid_size(Subpatch &sub, int &Mu, int &Mv)
+{
+  /* compute inner grid size with scale factor */
+  Mu = max(sub.edge_u0.T, sub.edge_u1.T);
+  Mv = max(sub.edge_v0.T, sub.edge_v1.T);
+
+#if 0 /* Doesn't work very well, especially at grazing angles. */
+  float S = scale_factor(sub, ef, Mu, Mv);
+#else
+  float S = 1.0f;
+#endif
+
+  Mu = max((int)ceilf(S * Mu), 2);  // XXX handle 0 & 1?
+  Mv = max((int)ceilf(S * Mv), 2);  // XXX handle 0 & 1?
+}
+
+void QuadDice::add_grid_verts(Subpatch &sub, int Mu, int Mv, int offset)
 {
   /* create inner grid */
   float du = 1.0f / (float)Mu;
@@ -236,48 +264,104 @@ void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
       float v = j * dv;
 
       set_vert(sub, offset + (i - 1) + (j - 1) * (Mu - 1), u, v);
+    }
+  }
+}
 
-      if (i < Mu - 1 && j < Mv - 1) {
-        int i1 = offset + (i - 1) + (j - 1) * (Mu - 1);
-        int i2 = offset + i + (j - 1) * (Mu - 1);
-        int i3 = offset + i + j * (Mu - 1);
-        int i4 = offset + (i - 1) + j * (Mu - 1);
-
-        add_triangle(sub.patch, i1, i2, i3);
-        add_triangle(sub.patch, i1, i3, i4);
-      }
+void QuadDice::add_grid_triangles(Subpatch &sub, int Mu, int Mv, int offset, int &triangle)
+{
+  for (int j = 1; j < Mv - 1; j++) {
+    for (int i = 1; i < Mu - 1; i++) {
+      int i1 = offset + (i - 1) + (j - 1) * (Mu - 1);
+      int i2 = offset + i + (j - 1) * (Mu - 1);
+      int i3 = offset + i + j * (Mu - 1);
+      int i4 = offset + (i - 1) + j * (Mu - 1);
+
+      add_triangle(sub.patch, triangle++, i1, i2, i3);
+      add_triangle(sub.patch, triangle++, i1, i3, i4);
     }
   }
 }
 
-void QuadDice::dice(Subpatch &sub)
+void QuadDice::dice_verts(vector<Subpatch> *subpatches,
+                          const int *vert_owner,
+                          int start,
+                          int end)
 {
-  /* compute inner grid size with scale factor */
-  int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
-  int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
+  for (int i = start; i < end; i++) {
+    Subpatch &sub = (*subpatches)[i];
+    int Mu, Mv;
+    grid_size(sub, Mu, Mv);
+
+    /* inner grid */
+    add_grid_verts(sub, Mu, Mv, sub.inner_grid_vert_offset);
+
+    /* sides */
+    set_side(sub, 0, vert_owner, i);
+    set_side(sub, 1, vert_owner, i);
+    set_side(sub, 2, vert_owner, i);
+    set_side(sub, 3, vert_owner, i);
+  }
+}
 
-#if 0 /* Doesn't work very well, especially at grazing angles. */
-  float S = scale_factor(sub, ef, Mu, Mv);
-#else
-  float S = 1.0f;
-#endif
+void QuadDice::dice_triangles(vector<Subpatch> *subpatches, int start, int end)
+{
+  for (int i = start; i < end; i++) {
+    Subpatch &sub = (*subpatches)[i];
+    int Mu, Mv;
+    grid_size(sub, Mu, Mv);
 
-  Mu = max((int)ceilf(S * Mu), 2);  // XXX handle 0 & 1?
-  Mv = max((int)ceilf(S * Mv), 2);  // XXX handle 0 & 1?
+    int triangle = sub.triangle_offset;
+
+    /* inner grid */
+    add_grid_triangles(sub, Mu, Mv, sub.inner_grid_vert_offset, triangle);
+
+    /* sides, these need the positions of vertices diced by neighboring subpatches */
+    stitch_triangles(sub, 0, triangle);
+    stitch_triangles(sub, 1, triangle);
+    stitch_triangles(sub, 2, triangle);
+    stitch_triangles(sub, 3, triangle);
+
+    assert(triangle == sub.triangle_offset + sub.calc_num_triangles());
+  }
+}
+
+void QuadDice::dice(vector<Subpatch> &subpatches)
+{
+  const int num_subpatches = subpatches.size();
+  const int subpatches_per_task = 64;
+
+  /* Vertices along edges are shared with neighboring subpatches. Evaluate each of them only for
+   * the last subpatch using it, which is the value dicing in order would end up with. */
+  vector<int> vert_owner(params.mesh->verts.size() - vert_offset, -1);
 
-  /* inner grid */
-  add_grid(sub, Mu, Mv, sub.inner_grid_vert_offset);
+  for (int i = 0; i < num_subpatches; i++) {
+    Subpatch &sub = subpatches[i];
 
-  /* sides */
-  set_side(sub, 0);
-  set_side(sub, 1);
-  set_side(sub, 2);
-  set_side(sub, 3);
+    for (int edge = 0; edge < 4; edge++) {
+      for (int j = 0; j < sub.edges[edge].T; j++) {
+        vert_owner[sub.get_vert_along_edge(edge, j)] = i;
+      }
+    }
+  }
+
+  /* Stitching triangles depends on vertex positions, so all vertices are diced first. */
+  TaskPool pool;
+
+  for (int start = 0; start < num_subpatches; start += subpatches_per_task) {
+    const int end = min(start + subpatches_per_task, num_subpatches);
+    pool.push(function_bind(
+        &QuadDice::dice_verts, this, &subpatches, vert_owner.data(), start, end));
+  }
+
+  pool.wait_work();
+
+  for (int start = 0; start < num_subpatches; start += subpatches_per_task) {
+    const int end = min(start + subpatches_per_task, num_subpatches);
+    pool.push(function_bind(&QuadDice::dice_triangles, this, &subpatches, start, end));
+  }
 
-  stitch_triangles(sub, 0);
-  stitch_triangles(sub, 1);
-  stitch_triangles(sub, 2);
-  stitch_triangles(sub, 3);
+  pool.wait_work();
 }
 
 CCL_NAMESPACE_END
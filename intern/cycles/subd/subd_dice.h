@@ -72,12 +72,16 @@ class EdgeDice {
   void reserve(int num_verts, int num_triangles);
 
   void set_vert(Patch *patch, int index, float2 uv);
-  void add_triangle(Patch *patch, int v0, int v1, int v2);
+  void add_triangle(Patch *patch, int index, int v0, int v1, int v2);
 
-  void stitch_triangles(Subpatch &sub, int edge);
+  void stitch_triangles(Subpatch &sub, int edge, int &triangle);
 };
 
-/* Quad EdgeDice */
+/* Quad EdgeDice
+ *
+ * Subpatches are diced in parallel. Every subpatch writes its triangles to the range starting at
+ * its triangle_offset, and vertices shared with other subpatches are only evaluated by one of
+ * them, so the mesh is the same as when dicing the subpatches one after the other. */
 
 class QuadDice : public EdgeDice {
  public:
@@ -88,14 +92,20 @@ class QuadDice : public EdgeDice {
   float2 map_uv(Subpatch &sub, float u, float v);
   void set_vert(Subpatch &sub, int index, float u, float v);
 
-  void add_grid(Subpatch &sub, int Mu, int Mv, int offset);
+  void grid_size(Subpatch &sub, int &Mu, int &Mv);
+  void add_grid_verts(Subpatch &sub, int Mu, int Mv, int offset);
+  void add_grid_triangles(Subpatch &sub, int Mu, int Mv, int offset, int &triangle);
 
-  void set_side(Subpatch &sub, int edge);
+  void set_side(Subpatch &sub, int edge, const int *vert_owner, int owner);
 
   float quad_area(const float3 &a, const float3 &b, const float3 &c, const float3 &d);
   float scale_factor(Subpatch &sub, int Mu, int Mv);
 
-  void dice(Subpatch &sub);
+  void dice(vector<Subpatch> &subpatches);
+
+ protected:
+  void dice_verts(vector<Subpatch> *subpatches, const int *vert_owner, int start, int end);
+  void dice_triangles(vector<Subpatch> *subpatches, int start, int end);
 };
 
 CCL_NAMESPACE_END
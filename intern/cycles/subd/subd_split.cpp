@@ -25,6 +25,7 @@
 #include "util/util_foreach.h"
 #include "util/util_hash.h"
 #include "util/util_math.h"
+#include "util/util_task.h"
 #include "util/util_types.h"
 
 CCL_NAMESPACE_BEGIN
@@ -337,26 +338,74 @@ Edge *DiagSplit::alloc_edge()
   return &edges.back();
 }
 
-void DiagSplit::split_patches(Patch *patches, size_t patches_byte_stride)
+void DiagSplit::split_faces(Patch *patches,
+                            size_t patches_byte_stride,
+                            const vector<int> *face_patch_index,
+                            int start,
+                            int end)
 {
-  int patch_index = 0;
-
-  for (int f = 0; f < params.mesh->subd_faces.size(); f++) {
+  for (int f = start; f < end; f++) {
     Mesh::SubdFace &face = params.mesh->subd_faces[f];
 
-    Patch *patch = (Patch *)(((char *)patches) + patch_index * patches_byte_stride);
+    Patch *patch = (Patch *)(((char *)patches) + (*face_patch_index)[f] * patches_byte_stride);
 
     if (face.is_quad()) {
-      patch_index++;
-
       split_quad(face, patch);
     }
     else {
-      patch_index += face.num_corners;
-
       split_ngon(face, patch, patches_byte_stride);
     }
   }
+}
+
+void DiagSplit::split_patches(Patch *patches, size_t patches_byte_stride)
+{
+  const int num_faces = params.mesh->subd_faces.size();
+  const int faces_per_task = 256;
+
+  vector<int> face_patch_index(num_faces);
+  int patch_index = 0;
+
+  for (int f = 0; f < num_faces; f++) {
+    face_patch_index[f] = patch_index;
+    patch_index += params.mesh->subd_faces[f].num_ptex_faces();
+  }
+
+  /* Split ranges of faces in parallel. Faces only share edges with other faces through stitching
+   * keys, so each range can be split with its own edges, subpatches and vertices. These are
+   * merged in face order, which gives the same result as splitting all faces in order. */
+  vector<DiagSplit> tasks(divide_up(num_faces, faces_per_task), DiagSplit(params));
+  TaskPool pool;
+
+  for (size_t i = 0; i < tasks.size(); i++) {
+    const int start = i * faces_per_task;
+    const int end = min(start + faces_per_task, num_faces);
+    pool.push(function_bind(&DiagSplit::split_faces,
+                            &tasks[i],
+                            patches,
+                            patches_byte_stride,
+                            &face_patch_index,
+                            start,
+                            end));
+  }
+
+  pool.wait_work();
+
+  foreach (DiagSplit &task, tasks) {
+    const int vert_offset = alloc_verts(task.num_alloced_verts);
+
+    foreach (Edge &edge, task.edges) {
+      if (edge.start_vert_index >= 0) {
+        edge.start_vert_index += vert_offset;
+      }
+      if (edge.end_vert_index >= 0) {
+        edge.end_vert_index += vert_offset;
+      }
+    }
+
+    edges.splice(edges.end(), task.edges);
+    subpatches.insert(subpatches.end(), task.subpatches.begin(), task.subpatches.end());
+  }
 
   params.mesh->vert_to_stitching_key_map.clear();
   params.mesh->vert_stitching_map.clear();
@@ -721,14 +770,6 @@ void DiagSplit::post_split()
   int num_verts = num_alloced_verts;
   int num_triangles = 0;
 
-  for (size_t i = 0; i < subpatches.size(); i++) {
-    subpatches[i].inner_grid_vert_offset = num_verts;
-    num_verts += subpatches[i].calc_num_inner_verts();
-    num_triangles += subpatches[i].calc_num_triangles();
-  }
-
-  dice.reserve(num_verts, num_triangles);
-
   for (size_t i = 0; i < subpatches.size(); i++) {
     Subpatch &sub = subpatches[i];
 
@@ -737,9 +778,15 @@ void DiagSplit::post_split()
     sub.edge_v0.T = max(sub.edge_v0.T, 1);
     sub.edge_v1.T = max(sub.edge_v1.T, 1);
 
-    dice.dice(sub);
+    sub.inner_grid_vert_offset = num_verts;
+    sub.triangle_offset = num_triangles;
+    num_verts += sub.calc_num_inner_verts();
+    num_triangles += sub.calc_num_triangles();
   }
 
+  dice.reserve(num_verts, num_triangles);
+  dice.dice(subpatches);
+
   /* Cleanup */
   subpatches.clear();
   edges.clear();
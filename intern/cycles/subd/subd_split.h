@@ -25,12 +25,10 @@
 #include "subd/subd_dice.h"
 #include "subd/subd_subpatch.h"
 
-#include "util/util_deque.h"
+#include "util/util_list.h"
 #include "util/util_types.h"
 #include "util/util_vector.h"
 
-#include <deque>
-
 CCL_NAMESPACE_BEGIN
 
 class Mesh;
@@ -40,8 +38,9 @@ class DiagSplit {
   SubdParams params;
 
   vector<Subpatch> subpatches;
-  /* deque is used so that element pointers remain vaild when size is changed. */
-  deque<Edge> edges;
+  /* list is used so that element pointers remain valid when size is changed, and when the edges
+   * of faces split in parallel are merged. */
+  list<Edge> edges;
 
   float3 to_world(Patch *patch, float2 uv);
   int T(Patch *patch, float2 Pstart, float2 Pend, bool recursive_resolve = false);
@@ -57,6 +56,12 @@ class DiagSplit {
   int num_alloced_verts = 0;
   int alloc_verts(int n); /* Returns start index of new verts. */
 
+  void split_faces(Patch *patches,
+                   size_t patches_byte_stride,
+                   const vector<int> *face_patch_index,
+                   int start,
+                   int end);
+
  public:
   Edge *alloc_edge();
 
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2011-2019 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "testing/testing.h"
+
+#include <OpenImageIO/filesystem.h>
+
+#include "render/scene_cache.h"
+#include "render/stats.h"
+#include "render/svm.h"
+
+#include "util/util_path.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Cache in a directory of its own, removed after the test. */
+class RenderSceneCache : public testing::Test {
+ protected:
+  string directory;
+
+  virtual void SetUp()
+  {
+    directory = path_join(OIIO::Filesystem::temp_directory_path(),
+                          OIIO::Filesystem::unique_path("cycles_scene_cache_%%%%-%%%%-%%%%"));
+  }
+
+  virtual void TearDown()
+  {
+    std::string error;
+    OIIO::Filesystem::remove_all(directory, error);
+  }
+};
+
+TEST(render_scene_cache, writer_reader)
+{
+  SceneCacheWriter writer;
+  writer.write(42);
+  writer.write_string("attribute");
+  writer.write(make_float2(1.0f, 2.0f));
+
+  SceneCacheReader reader(writer.data);
+  int value = 0;
+  string name;
+  float2 f = make_float2(0.0f, 0.0f);
+  EXPECT_TRUE(reader.read(value));
+  EXPECT_TRUE(reader.read_string(name));
+  EXPECT_TRUE(reader.read(f));
+  EXPECT_TRUE(reader.finished());
+  EXPECT_EQ(value, 42);
+  EXPECT_EQ(name, "attribute");
+  EXPECT_EQ(f.x, 1.0f);
+  EXPECT_EQ(f.y, 2.0f);
+
+  /* Reading past the end invalidates the reader. */
+  EXPECT_FALSE(reader.read(value));
+  EXPECT_FALSE(reader.finished());
+}
+
+TEST_F(RenderSceneCache, hit_and_miss)
+{
+  SceneCache cache;
+  vector<uint8_t> data;
+  const string hash = "hit_and_miss";
+
+  /* Disabled cache never hits. */
+  EXPECT_FALSE(cache.enabled());
+  EXPECT_FALSE(cache.read(SCENE_CACHE_SHADER, hash, data));
+
+  cache.set_directory(directory);
+  EXPECT_TRUE(cache.enabled());
+  EXPECT_FALSE(cache.read(SCENE_CACHE_SHADER, hash, data));
+
+  vector<uint8_t> entry(100);
+  for (size_t i = 0; i < entry.size(); i++) {
+    entry[i] = (uint8_t)i;
+  }
+  cache.write(SCENE_CACHE_SHADER, hash, entry);
+
+  EXPECT_TRUE(cache.read(SCENE_CACHE_SHADER, hash, data));
+  EXPECT_EQ(data, entry);
+
+  /* Entries of different types don't collide. */
+  EXPECT_FALSE(cache.read(SCENE_CACHE_BACKGROUND, hash, data));
+
+  /* Rejected hits count as misses. */
+  EXPECT_TRUE(cache.read(SCENE_CACHE_SHADER, hash, data));
+  cache.reject(SCENE_CACHE_SHADER);
+
+  RenderStats stats;
+  cache.collect_statistics(&stats);
+  EXPECT_EQ(stats.cache.shader_hits, 1);
+  EXPECT_EQ(stats.cache.shader_misses, 2);
+  EXPECT_EQ(stats.cache.background_hits, 0);
+  EXPECT_EQ(stats.cache.background_misses, 1);
+}
+
+TEST(render_scene_cache, attribute_ids_if_match)
+{
+  SVMShaderManager manager;
+  const uint id_a = manager.get_attribute_id(ustring("a"));
+
+  vector<ustring> names;
+  vector<uint> ids;
+  names.push_back(ustring("a"));
+  ids.push_back(id_a);
+  names.push_back(ustring("b"));
+  ids.push_back(id_a + 2);
+
+  /* Mismatching IDs don't register new attributes. */
+  EXPECT_FALSE(manager.get_attribute_ids_if_match(names, ids));
+  ids[1] = id_a + 1;
+  EXPECT_TRUE(manager.get_attribute_ids_if_match(names, ids));
+  EXPECT_EQ(manager.get_attribute_id(ustring("b")), id_a + 1);
+  EXPECT_EQ(manager.get_attribute_id(ustring("c")), id_a + 2);
+}
+
+CCL_NAMESPACE_END
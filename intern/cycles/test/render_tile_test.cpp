@@ -0,0 +1,96 @@
+/*
+ * Copyright 2011-2019 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "testing/testing.h"
+
+#include "render/tile.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+class RenderTileTest : public testing::Test {
+ protected:
+  RenderTileTest()
+      : tile_manager(false, 16, make_int2(64, 64), INT_MAX, false, true, TILE_BOTTOM_TO_TOP)
+  {
+    tile_manager.num_workers = 8;
+    tile_manager.use_tile_splitting = true;
+    tile_manager.use_sample_stealing = true;
+
+    BufferParams buffer_params;
+    buffer_params.width = buffer_params.full_width = 128;
+    buffer_params.height = buffer_params.full_height = 64;
+    tile_manager.reset(buffer_params, 16);
+    tile_manager.next();
+  }
+
+  TileManager tile_manager;
+};
+
+}  // namespace
+
+TEST_F(RenderTileTest, split_tiles_cover_image)
+{
+  vector<int> coverage(128 * 64, 0);
+  int num_tiles = 0;
+
+  Tile *tile;
+  while (tile_manager.next_tile(tile)) {
+    for (int y = tile->y; y < tile->y + tile->h; y++) {
+      for (int x = tile->x; x < tile->x + tile->w; x++) {
+        coverage[y * 128 + x]++;
+      }
+    }
+    EXPECT_GE(tile->w, 16);
+    EXPECT_GE(tile->h, 16);
+    num_tiles++;
+  }
+
+  /* Two tiles, split as long as fewer are left than workers. */
+  EXPECT_GE(num_tiles, 8);
+  EXPECT_EQ(tile_manager.state.num_tiles, num_tiles);
+  EXPECT_EQ(tile_manager.num_split_tiles, num_tiles - 2);
+
+  for (int i = 0; i < coverage.size(); i++) {
+    EXPECT_EQ(coverage[i], 1);
+  }
+}
+
+TEST_F(RenderTileTest, steal_tile_samples)
+{
+  Tile *tile;
+  ASSERT_TRUE(tile_manager.next_tile(tile));
+  const int index = tile->index;
+
+  /* Render a few samples of the tile. */
+  tile->next_sample = 4;
+
+  Tile *steal_tile;
+  int start_sample, num_samples;
+  ASSERT_TRUE(tile_manager.steal_tile_samples(steal_tile, start_sample, num_samples));
+  EXPECT_EQ(steal_tile->index, index);
+  EXPECT_EQ(start_sample, 4);
+  EXPECT_EQ(num_samples, 6);
+  EXPECT_EQ(tile->next_sample, 10);
+
+  /* The tile is done once both parts are. */
+  EXPECT_FALSE(tile_manager.finish_tile_part(index, NULL, 6));
+  EXPECT_TRUE(tile_manager.finish_tile_part(index, NULL, 10));
+  EXPECT_EQ(tile->num_rendered_samples, 16);
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2011-2019 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "testing/testing.h"
+
+#include "util/util_sparse_grid.h"
+
+CCL_NAMESPACE_BEGIN
+
+static float sparse_grid_lookup(const vector<float> &sparse,
+                                const vector<int> &offsets,
+                                int width,
+                                int height,
+                                int x,
+                                int y,
+                                int z)
+{
+  const int tile = (x >> TEX_SPARSE_TILE_SHIFT) +
+                   sparse_grid_num_tiles(width) *
+                       ((y >> TEX_SPARSE_TILE_SHIFT) +
+                        sparse_grid_num_tiles(height) * (z >> TEX_SPARSE_TILE_SHIFT));
+  if (offsets[tile] < 0) {
+    return 0.0f;
+  }
+  return sparse[offsets[tile] + (x & TEX_SPARSE_TILE_MASK) +
+                ((y & TEX_SPARSE_TILE_MASK) << TEX_SPARSE_TILE_SHIFT) +
+                ((z & TEX_SPARSE_TILE_MASK) << (2 * TEX_SPARSE_TILE_SHIFT))];
+}
+
+TEST(util_sparse_grid, mostly_empty)
+{
+  const int width = 21, height = 19, depth = 33;
+  vector<float> dense(width * height * depth, 0.0f);
+
+  /* Small blob crossing a tile boundary, and a voxel in the partial last tile. */
+  for (int z = 6; z < 10; z++) {
+    for (int y = 6; y < 10; y++) {
+      for (int x = 6; x < 10; x++) {
+        dense[x + y * width + z * width * height] = (float)(x + y + z);
+      }
+    }
+  }
+  dense[(width - 1) + (height - 1) * width + (depth - 1) * width * height] = 1.0f;
+
+  vector<float> sparse;
+  vector<int> offsets;
+  ASSERT_TRUE(create_sparse_grid(&dense[0], width, height, depth, 1, &sparse, &offsets));
+
+  EXPECT_EQ(offsets.size(), 3 * 3 * 5);
+  EXPECT_EQ(sparse.size(), 9 * TEX_SPARSE_TILE_SIZE * TEX_SPARSE_TILE_SIZE * TEX_SPARSE_TILE_SIZE);
+
+  for (int z = 0; z < depth; z++) {
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        EXPECT_EQ(sparse_grid_lookup(sparse, offsets, width, height, x, y, z),
+                  dense[x + y * width + z * width * height]);
+      }
+    }
+  }
+}
+
+TEST(util_sparse_grid, dense)
+{
+  const int width = 16, height = 16, depth = 16;
+  vector<float> dense(width * height * depth, 1.0f);
+
+  vector<float> sparse;
+  vector<int> offsets;
+  EXPECT_FALSE(create_sparse_grid(&dense[0], width, height, depth, 1, &sparse, &offsets));
+  EXPECT_TRUE(offsets.empty());
+}
+
+CCL_NAMESPACE_END
@@ -82,6 +82,11 @@ class DebugFlags {
 
     /* Whether split kernel is used */
     bool split_kernel;
+
+    /* Number of paths traced together by each thread when using the split
+     * kernel. Larger batches give more coherent shading after sorting by
+     * shader, at the cost of more memory for the path state. */
+    int split_kernel_batch_size;
   };
 
   /* Descriptor of CUDA feature-set to be used. */
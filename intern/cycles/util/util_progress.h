@@ -23,10 +23,13 @@
  * update notifications from a job running in another thread. All methods
  * except for the constructor/destructor are thread safe. */
 
+#include "util/util_foreach.h"
 #include "util/util_function.h"
+#include "util/util_map.h"
 #include "util/util_string.h"
 #include "util/util_time.h"
 #include "util/util_thread.h"
+#include "util/util_vector.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -87,6 +90,8 @@ class Progress {
     substatus = "";
     sync_status = "";
     sync_substatus = "";
+    sync_times.clear();
+    update_times.clear();
     kernel_status = "";
     cancel = false;
     cancel_message = "";
@@ -300,6 +305,30 @@ class Progress {
     set_update();
   }
 
+  /* Accumulate time spent in a phase of scene synchronization. */
+  void add_sync_time(const string &phase, double time)
+  {
+    add_phase_time(sync_times, phase, time);
+  }
+
+  void get_sync_times(vector<pair<string, double>> &sync_times_)
+  {
+    thread_scoped_lock lock(progress_mutex);
+    sync_times_ = sync_times;
+  }
+
+  /* Accumulate time spent in a phase of the scene device update. */
+  void add_update_time(const string &phase, double time)
+  {
+    add_phase_time(update_times, phase, time);
+  }
+
+  void get_update_times(vector<pair<string, double>> &update_times_)
+  {
+    thread_scoped_lock lock(progress_mutex);
+    update_times_ = update_times;
+  }
+
   void get_status(string &status_, string &substatus_)
   {
     thread_scoped_lock lock(progress_mutex);
@@ -376,6 +405,26 @@ class Progress {
   string sync_status;
   string sync_substatus;
 
+  /* Time per synchronization phase, in the order the phases first ran. */
+  typedef pair<string, double> SyncTime;
+  vector<SyncTime> sync_times;
+  /* Time per scene device update phase, same layout as the synchronization times. */
+  vector<SyncTime> update_times;
+
+  void add_phase_time(vector<SyncTime> &phase_times, const string &phase, double time)
+  {
+    thread_scoped_lock lock(progress_mutex);
+
+    foreach (SyncTime &phase_time, phase_times) {
+      if (phase_time.first == phase) {
+        phase_time.second += time;
+        return;
+      }
+    }
+
+    phase_times.push_back(SyncTime(phase, time));
+  }
+
   string kernel_status;
 
   volatile bool cancel;
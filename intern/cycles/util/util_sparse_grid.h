@@ -0,0 +1,136 @@
+/*
+ * Copyright 2011-2019 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UTIL_SPARSE_GRID_H__
+#define __UTIL_SPARSE_GRID_H__
+
+#include <climits>
+
+#include "util/util_image.h"
+#include "util/util_texture.h"
+#include "util/util_vector.h"
+
+/* Sparse Grid
+ *
+ * Volume textures are split into tiles of TEX_SPARSE_TILE_SIZE^3 voxels. Only
+ * tiles that contain at least one non-zero voxel are stored, packed one after
+ * another. A separate index with one entry per tile holds the offset of the
+ * first voxel of the tile in the packed array, or -1 for empty tiles.
+ *
+ * Voxels inside a tile are stored in x, y, z order, so the voxel (x, y, z) of
+ * an active tile is found at:
+ *
+ *   offset + (x & mask) + ((y & mask) << shift) + ((z & mask) << (2 * shift))
+ *
+ * Empty tiles read as zero, which matches the dense grid exactly, so all
+ * interpolation modes give the same result on both representations. The
+ * same tile index is used to skip empty space when building volume bounds. */
+
+CCL_NAMESPACE_BEGIN
+
+/* Only use a sparse grid when at most this fraction of tiles is active,
+ * otherwise the extra indirection on lookup is not worth the memory saved. */
+#define SPARSE_GRID_MAX_ACTIVE_FRACTION 0.5f
+
+ccl_device_inline int sparse_grid_num_tiles(int size)
+{
+  return (size + TEX_SPARSE_TILE_SIZE - 1) >> TEX_SPARSE_TILE_SHIFT;
+}
+
+template<typename T>
+bool create_sparse_grid(const T *dense,
+                        const size_t width,
+                        const size_t height,
+                        const size_t depth,
+                        const size_t components,
+                        vector<T> *sparse,
+                        vector<int> *offsets)
+{
+  const size_t tiles_x = sparse_grid_num_tiles(width);
+  const size_t tiles_y = sparse_grid_num_tiles(height);
+  const size_t tiles_z = sparse_grid_num_tiles(depth);
+  const size_t num_tiles = tiles_x * tiles_y * tiles_z;
+  const size_t tile_voxels = TEX_SPARSE_TILE_SIZE * TEX_SPARSE_TILE_SIZE * TEX_SPARSE_TILE_SIZE;
+
+  /* First pass: find active tiles and assign them offsets. */
+  offsets->resize(num_tiles);
+  size_t num_active = 0;
+
+  for (size_t tz = 0; tz < tiles_z; tz++) {
+    for (size_t ty = 0; ty < tiles_y; ty++) {
+      for (size_t tx = 0; tx < tiles_x; tx++) {
+        const size_t x0 = tx * TEX_SPARSE_TILE_SIZE, x1 = min(x0 + TEX_SPARSE_TILE_SIZE, width);
+        const size_t y0 = ty * TEX_SPARSE_TILE_SIZE, y1 = min(y0 + TEX_SPARSE_TILE_SIZE, height);
+        const size_t z0 = tz * TEX_SPARSE_TILE_SIZE, z1 = min(z0 + TEX_SPARSE_TILE_SIZE, depth);
+        bool active = false;
+
+        for (size_t z = z0; z < z1 && !active; z++) {
+          for (size_t y = y0; y < y1 && !active; y++) {
+            const T *row = dense + ((z * height + y) * width) * components;
+            for (size_t i = x0 * components; i < x1 * components; i++) {
+              if (util_image_cast_to_float(row[i]) != 0.0f) {
+                active = true;
+                break;
+              }
+            }
+          }
+        }
+
+        const size_t tile = tx + tiles_x * (ty + tiles_y * tz);
+        (*offsets)[tile] = (active) ? (int)(num_active++ * tile_voxels) : -1;
+      }
+    }
+  }
+
+  if (num_active > num_tiles * SPARSE_GRID_MAX_ACTIVE_FRACTION ||
+      num_active * tile_voxels > INT_MAX) {
+    offsets->clear();
+    return false;
+  }
+
+  /* Second pass: copy voxels of active tiles, padding partial tiles with zero. */
+  sparse->clear();
+  sparse->resize(num_active * tile_voxels * components, util_image_cast_from_float<T>(0.0f));
+
+  for (size_t z = 0; z < depth; z++) {
+    for (size_t y = 0; y < height; y++) {
+      for (size_t x = 0; x < width; x++) {
+        const size_t tile = (x >> TEX_SPARSE_TILE_SHIFT) +
+                            tiles_x * ((y >> TEX_SPARSE_TILE_SHIFT) +
+                                       tiles_y * (z >> TEX_SPARSE_TILE_SHIFT));
+        const int offset = (*offsets)[tile];
+        if (offset < 0) {
+          continue;
+        }
+
+        const size_t local = (x & TEX_SPARSE_TILE_MASK) +
+                             ((y & TEX_SPARSE_TILE_MASK) << TEX_SPARSE_TILE_SHIFT) +
+                             ((z & TEX_SPARSE_TILE_MASK) << (2 * TEX_SPARSE_TILE_SHIFT));
+        const T *src = dense + ((z * height + y) * width + x) * components;
+        T *dst = &(*sparse)[(offset + local) * components];
+        for (size_t c = 0; c < components; c++) {
+          dst[c] = src[c];
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+CCL_NAMESPACE_END
+
+#endif /* __UTIL_SPARSE_GRID_H__ */
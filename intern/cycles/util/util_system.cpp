@@ -31,6 +31,7 @@ OIIO_NAMESPACE_USING
 #  endif
 #  include "util_windows.h"
 #elif defined(__APPLE__)
+#  include <unistd.h>
 #  include <sys/ioctl.h>
 #  include <sys/sysctl.h>
 #  include <sys/types.h>
@@ -351,6 +352,15 @@ bool system_call_self(const vector<string> &args)
   return (system(cmd.c_str()) == 0);
 }
 
+uint64_t system_self_process_id()
+{
+#ifdef _WIN32
+  return GetCurrentProcessId();
+#else
+  return getpid();
+#endif
+}
+
 size_t system_physical_ram()
 {
 #ifdef _WIN32
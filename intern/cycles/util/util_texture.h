@@ -28,6 +28,11 @@ CCL_NAMESPACE_BEGIN
 #define TEX_IMAGE_MISSING_B 1
 #define TEX_IMAGE_MISSING_A 1
 
+/* Tile size of sparse grid textures, see util_sparse_grid.h. */
+#define TEX_SPARSE_TILE_SHIFT 3
+#define TEX_SPARSE_TILE_SIZE (1 << TEX_SPARSE_TILE_SHIFT)
+#define TEX_SPARSE_TILE_MASK (TEX_SPARSE_TILE_SIZE - 1)
+
 /* Texture type. */
 #define kernel_tex_type(tex) (tex & IMAGE_DATA_TYPE_MASK)
 
@@ -88,15 +93,31 @@ typedef enum ExtensionType {
   EXTENSION_NUM_TYPES,
 } ExtensionType;
 
+/* Grid types for 3D textures.
+ *
+ * Defines how voxels are laid out in memory. */
+typedef enum ImageGridType {
+  /* All voxels stored in x, y, z order. */
+  IMAGE_GRID_TYPE_DENSE = 0,
+  /* Only non-empty tiles are stored, with an index of tile offsets. */
+  IMAGE_GRID_TYPE_SPARSE = 1,
+
+  IMAGE_GRID_NUM_TYPES,
+} ImageGridType;
+
 typedef struct TextureInfo {
   /* Pointer, offset or texture depending on device. */
   uint64_t data;
+  /* Pointer to tile offsets for sparse grids. */
+  uint64_t grid_info;
   /* Buffer number for OpenCL. */
   uint cl_buffer;
   /* Interpolation and extension type. */
   uint interpolation, extension;
   /* Dimensions. */
   uint width, height, depth;
+  /* Voxel layout of 3D textures. */
+  uint grid_type;
 } TextureInfo;
 
 CCL_NAMESPACE_END
@@ -292,6 +292,10 @@ void BKE_animsys_eval_driver(struct Depsgraph *depsgraph,
 
 void BKE_animsys_update_driver_array(struct ID *id);
 
+/* Resolved F-Curve paths of evaluated IDs, to avoid resolving them on every evaluation. */
+void BKE_animsys_update_path_cache(struct ID *id);
+void BKE_animsys_path_cache_tag_invalid(void);
+
 /* ************************************* */
 
 #endif /* __BKE_ANIMSYS_H__*/
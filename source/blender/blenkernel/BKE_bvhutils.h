@@ -244,4 +244,7 @@ bool bvhcache_has_tree(const BVHCache *cache, const BVHTree *tree);
 void bvhcache_insert(BVHCache **cache_p, BVHTree *tree, int type);
 void bvhcache_free(BVHCache **cache_p);
 
+BVHCache *bvhcache_take_for_refit(struct Mesh *mesh);
+void bvhcache_give_for_refit(struct Mesh *mesh, BVHCache **cache_p);
+
 #endif
@@ -107,6 +107,9 @@ bool driver_get_variable_property(struct ChannelDriver *driver,
                                   int *r_index);
 
 bool BKE_driver_has_simple_expression(struct ChannelDriver *driver);
+bool BKE_driver_simple_expression_uses_frame(struct ChannelDriver *driver);
+void BKE_driver_stats_reset(void);
+void BKE_driver_stats_get(unsigned int *r_num_evaluated, unsigned int *r_num_python);
 void BKE_driver_invalidate_expression(struct ChannelDriver *driver,
                                       bool expr_changed,
                                       bool varname_changed);
@@ -339,6 +342,9 @@ void correct_bezpart(float v1[2], float v2[2], float v3[2], float v4[2]);
 /* evaluate fcurve */
 float evaluate_fcurve(struct FCurve *fcu, float evaltime);
 float evaluate_fcurve_only_curve(struct FCurve *fcu, float evaltime);
+/* sample fcurve at a range of frames */
+void evaluate_fcurve_range(
+    struct FCurve *fcu, float start, float step, int num_samples, float *r_values);
 float evaluate_fcurve_driver(struct PathResolvedRNA *anim_rna,
                              struct FCurve *fcu,
                              struct ChannelDriver *driver_orig,
@@ -346,6 +352,10 @@ float evaluate_fcurve_driver(struct PathResolvedRNA *anim_rna,
 bool BKE_fcurve_is_empty(struct FCurve *fcu);
 /* evaluate fcurve and store value */
 float calculate_fcurve(struct PathResolvedRNA *anim_rna, struct FCurve *fcu, float evaltime);
+float calculate_fcurve_ex(struct PathResolvedRNA *anim_rna,
+                          struct FCurve *fcu,
+                          float evaltime,
+                          int *segment_hint);
 
 /* ************* F-Curve Samples API ******************** */
 
@@ -1802,6 +1802,13 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
    * they aren't cleaned up properly on mode switch, causing crashes, e.g T58150. */
   BLI_assert(ob->id.tag & LIB_TAG_COPIED_ON_WRITE);
 
+  /* Keep the BVH trees of the previous result, so they can be refit when only the vertex
+   * positions change, instead of being built again. */
+  BVHCache *bvh_cache_prev = NULL;
+  if (ob->runtime.mesh_eval != NULL && ob->runtime.is_mesh_eval_owned) {
+    bvh_cache_prev = bvhcache_take_for_refit(ob->runtime.mesh_eval);
+  }
+
   BKE_object_free_derived_caches(ob);
   if (DEG_is_active(depsgraph)) {
     BKE_sculpt_update_object_before_eval(ob);
@@ -1832,6 +1839,13 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
 
   assign_object_mesh_eval(ob);
 
+  if (ob->runtime.is_mesh_eval_owned) {
+    bvhcache_give_for_refit(ob->runtime.mesh_eval, &bvh_cache_prev);
+  }
+  else {
+    bvhcache_free(&bvh_cache_prev);
+  }
+
   ob->runtime.last_data_mask = *dataMask;
   ob->runtime.last_need_mapping = need_mapping;
 
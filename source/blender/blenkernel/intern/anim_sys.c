@@ -67,6 +67,7 @@
 #include "DEG_depsgraph_query.h"
 
 #include "RNA_access.h"
+#include "RNA_define.h"
 
 #include "nla_private.h"
 
@@ -76,6 +77,8 @@
 
 static CLG_LogRef LOG = {"bke.anim_sys"};
 
+static void animsys_path_cache_free(AnimData *adt);
+
 /* ***************************************** */
 /* AnimData API */
 
@@ -271,6 +274,9 @@ void BKE_animdata_free(ID *id, const bool do_id_user)
       /* free driver array cache */
       MEM_SAFE_FREE(adt->driver_array);
 
+      /* free resolved paths cache */
+      animsys_path_cache_free(adt);
+
       /* free overrides */
       /* TODO... */
 
@@ -320,6 +326,7 @@ AnimData *BKE_animdata_copy(Main *bmain, AnimData *adt, const int flag)
   /* duplicate drivers (F-Curves) */
   copy_fcurves(&dadt->drivers, &adt->drivers);
   dadt->driver_array = NULL;
+  dadt->path_cache = NULL;
 
   /* don't copy overrides */
   BLI_listbase_clear(&dadt->overrides);
@@ -1128,6 +1135,9 @@ bool BKE_animdata_fix_paths_remove(ID *id, const char *prefix)
       any_removed |= nlastrips_path_remove_fix(prefix, &nlt->strips);
     }
   }
+  if (any_removed) {
+    BKE_animsys_path_cache_tag_invalid();
+  }
   return any_removed;
 }
 
@@ -1878,18 +1888,193 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
 }
 
+/* ***************************************** */
+/* Resolved Paths Cache */
+
+/* Resolving the RNA path of an F-Curve parses the path string and looks up every property along
+ * it, which dominates evaluation of rigs with many animated channels. Evaluated (copy-on-write)
+ * AnimData therefore keeps the resolved paths of its active action and drivers between frames.
+ *
+ * A copy-on-write update of any ID may move data a path was resolved through (paths can go
+ * through pointers into other IDs), as do relations updates and freeing of runtime defined RNA
+ * properties. All these bump a generation number, and bindings resolved in an older generation
+ * are resolved again on their next evaluation. Paths resolving into another ID are not kept at
+ * all, see animsys_path_binding_ensure(). */
+
+typedef struct AnimPathBinding {
+  /* F-Curve and path the binding was resolved for, to detect edits of the F-Curve. */
+  const FCurve *fcu;
+  const char *rna_path;
+  int array_index;
+
+  /* Generation the binding was resolved in, 0 when it never was or must not be kept. */
+  uint generation;
+
+  /* Keyframe found by the previous evaluation, see calculate_fcurve_ex(). */
+  int segment_hint;
+
+  bool is_valid;
+  /* The path of the original data is only resolved when flushing to it. */
+  bool is_orig_resolved;
+  bool is_orig_valid;
+
+  PathResolvedRNA anim_rna;
+  PathResolvedRNA orig_anim_rna;
+} AnimPathBinding;
+
+typedef struct AnimPathCache {
+  /* Bindings of the active action F-Curves, in list order. */
+  const bAction *action;
+  uint action_generation;
+  AnimPathBinding *action_bindings;
+  int num_action_bindings;
+
+  /* Bindings of the drivers, indexed like AnimData.driver_array. Drivers of an ID are evaluated
+   * in parallel, but each only ever touches its own binding. */
+  AnimPathBinding *driver_bindings;
+  int num_driver_bindings;
+} AnimPathCache;
+
+static uint animsys_path_cache_generation = 1;
+
+void BKE_animsys_path_cache_tag_invalid(void)
+{
+  atomic_add_and_fetch_uint32(&animsys_path_cache_generation, 1);
+}
+
+static uint animsys_path_cache_generation_get(void)
+{
+  /* Both counters only ever increase, so their sum changes whenever either does. */
+  return animsys_path_cache_generation + RNA_def_free_generation();
+}
+
+static void animsys_path_cache_free(AnimData *adt)
+{
+  AnimPathCache *cache = adt->path_cache;
+
+  if (cache == NULL) {
+    return;
+  }
+
+  MEM_SAFE_FREE(cache->action_bindings);
+  MEM_SAFE_FREE(cache->driver_bindings);
+  MEM_freeN(cache);
+  adt->path_cache = NULL;
+}
+
+/* Get bindings for the F-Curves of the given action, NULL when paths are not cached. */
+static AnimPathBinding *animsys_path_cache_action_bindings(AnimData *adt,
+                                                           const bAction *act,
+                                                           int *r_num_bindings)
+{
+  AnimPathCache *cache = adt->path_cache;
+  const uint generation = animsys_path_cache_generation_get();
+
+  *r_num_bindings = 0;
+
+  if (cache == NULL || act == NULL) {
+    return NULL;
+  }
+
+  if (cache->action != act || cache->action_generation != generation) {
+    MEM_SAFE_FREE(cache->action_bindings);
+    cache->action = act;
+    cache->action_generation = generation;
+    cache->num_action_bindings = BLI_listbase_count(&act->curves);
+    if (cache->num_action_bindings) {
+      cache->action_bindings = MEM_callocN(
+          sizeof(AnimPathBinding) * cache->num_action_bindings, "AnimPathCache action bindings");
+    }
+  }
+
+  *r_num_bindings = cache->num_action_bindings;
+  return cache->action_bindings;
+}
+
+/* Resolve the path of the F-Curve unless the binding has it resolved already. */
+static bool animsys_path_binding_ensure(AnimPathBinding *binding, PointerRNA *ptr, FCurve *fcu)
+{
+  const uint generation = animsys_path_cache_generation_get();
+
+  if (binding->generation != generation || binding->fcu != fcu ||
+      binding->rna_path != fcu->rna_path || binding->array_index != fcu->array_index) {
+    binding->fcu = fcu;
+    binding->rna_path = fcu->rna_path;
+    binding->array_index = fcu->array_index;
+    binding->generation = generation;
+    binding->is_valid = animsys_store_rna_setting(
+        ptr, fcu->rna_path, fcu->array_index, &binding->anim_rna);
+    binding->is_orig_resolved = false;
+    binding->is_orig_valid = false;
+
+    /* Evaluated data of other IDs can be replaced or freed without a copy-on-write update, the
+     * evaluated mesh an object points to is freed by its next geometry evaluation. Only paths
+     * within the animated ID are kept, others are resolved again on every evaluation. */
+    if (binding->is_valid && binding->anim_rna.ptr.owner_id != ptr->owner_id) {
+      binding->generation = 0;
+    }
+  }
+
+  return binding->is_valid;
+}
+
+static void animsys_write_orig_anim_rna_binding(PointerRNA *ptr,
+                                                AnimPathBinding *binding,
+                                                float value)
+{
+  if (!binding->is_orig_resolved) {
+    PointerRNA ptr_orig;
+    binding->is_orig_resolved = true;
+    binding->is_orig_valid = animsys_construct_orig_pointer_rna(ptr, &ptr_orig) &&
+                             animsys_store_rna_setting(&ptr_orig,
+                                                       binding->rna_path,
+                                                       binding->array_index,
+                                                       &binding->orig_anim_rna);
+  }
+  if (binding->is_orig_valid) {
+    animsys_write_rna_setting(&binding->orig_anim_rna, value);
+  }
+}
+
+void BKE_animsys_update_path_cache(ID *id)
+{
+  AnimData *adt = BKE_animdata_from_id(id);
+
+  /* The ID was copied, which moves all data paths of any ID might be resolved through. */
+  BKE_animsys_path_cache_tag_invalid();
+
+  if (adt == NULL) {
+    return;
+  }
+
+  BLI_assert(!adt->path_cache);
+
+  AnimPathCache *cache = MEM_callocN(sizeof(AnimPathCache), "AnimPathCache");
+  cache->num_driver_bindings = BLI_listbase_count(&adt->drivers);
+  if (cache->num_driver_bindings) {
+    cache->driver_bindings = MEM_callocN(sizeof(AnimPathBinding) * cache->num_driver_bindings,
+                                         "AnimPathCache driver bindings");
+  }
+  adt->path_cache = cache;
+}
+
 /**
  * Evaluate all the F-Curves in the given list
  * This performs a set of standard checks. If extra checks are required,
  * separate code should be used.
+ *
+ * \param bindings: Optional cached paths of the F-Curves, in list order.
  */
 static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      ListBase *list,
+                                     AnimPathBinding *bindings,
+                                     int num_bindings,
                                      float ctime,
                                      bool flush_to_original)
 {
   /* Calculate then execute each curve. */
-  for (FCurve *fcu = list->first; fcu; fcu = fcu->next) {
+  int index = 0;
+  for (FCurve *fcu = list->first; fcu; fcu = fcu->next, index++) {
     /* Check if this F-Curve doesn't belong to a muted group. */
     if ((fcu->grp != NULL) && (fcu->grp->flag & AGRP_MUTED)) {
       continue;
@@ -1902,6 +2087,18 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
     if (BKE_fcurve_is_empty(fcu)) {
       continue;
     }
+    if (index < num_bindings) {
+      AnimPathBinding *binding = &bindings[index];
+      if (animsys_path_binding_ensure(binding, ptr, fcu)) {
+        const float curval = calculate_fcurve_ex(
+            &binding->anim_rna, fcu, ctime, &binding->segment_hint);
+        animsys_write_rna_setting(&binding->anim_rna, curval);
+        if (flush_to_original) {
+          animsys_write_orig_anim_rna_binding(ptr, binding, curval);
+        }
+      }
+      continue;
+    }
     PathResolvedRNA anim_rna;
     if (animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, ctime);
@@ -2024,12 +2221,19 @@ void animsys_evaluate_action_group(PointerRNA *ptr, bAction *act, bActionGroup *
   }
 }
 
-/* Evaluate Action (F-Curve Bag) */
+/* Evaluate Action (F-Curve Bag)
+ *
+ * \param adt: Optional animation data the action is assigned to, used to cache resolved paths.
+ */
 static void animsys_evaluate_action_ex(PointerRNA *ptr,
+                                       AnimData *adt,
                                        bAction *act,
                                        float ctime,
                                        const bool flush_to_original)
 {
+  AnimPathBinding *bindings = NULL;
+  int num_bindings = 0;
+
   /* check if mapper is appropriate for use here (we set to NULL if it's inappropriate) */
   if (act == NULL) {
     return;
@@ -2037,8 +2241,12 @@ static void animsys_evaluate_action_ex(PointerRNA *ptr,
 
   action_idcode_patch_check(ptr->owner_id, act);
 
+  if (adt != NULL) {
+    bindings = animsys_path_cache_action_bindings(adt, act, &num_bindings);
+  }
+
   /* calculate then execute each curve */
-  animsys_evaluate_fcurves(ptr, &act->curves, ctime, flush_to_original);
+  animsys_evaluate_fcurves(ptr, &act->curves, bindings, num_bindings, ctime, flush_to_original);
 }
 
 void animsys_evaluate_action(PointerRNA *ptr,
@@ -2046,7 +2254,7 @@ void animsys_evaluate_action(PointerRNA *ptr,
                              float ctime,
                              const bool flush_to_original)
 {
-  animsys_evaluate_action_ex(ptr, act, ctime, flush_to_original);
+  animsys_evaluate_action_ex(ptr, NULL, act, ctime, flush_to_original);
 }
 
 /* ***************************************** */
@@ -2085,7 +2293,7 @@ static void nlastrip_evaluate_controls(NlaStrip *strip, float ctime, const bool
     RNA_pointer_create(NULL, &RNA_NlaStrip, strip, &strip_ptr);
 
     /* execute these settings as per normal */
-    animsys_evaluate_fcurves(&strip_ptr, &strip->fcurves, ctime, flush_to_original);
+    animsys_evaluate_fcurves(&strip_ptr, &strip->fcurves, NULL, 0, ctime, flush_to_original);
   }
 
   /* analytically generate values for influence and time (if applicable)
@@ -3874,7 +4082,7 @@ void BKE_animsys_evaluate_animdata(
     }
     /* evaluate Active Action only */
     else if (adt->action) {
-      animsys_evaluate_action_ex(&id_ptr, adt->action, ctime, flush_to_original);
+      animsys_evaluate_action_ex(&id_ptr, adt, adt->action, ctime, flush_to_original);
     }
   }
 
@@ -4117,16 +4325,35 @@ void BKE_animsys_eval_driver(Depsgraph *depsgraph, ID *id, int driver_index, FCu
        * adding new to only be done when drivers only changed */
       // printf("\told val = %f\n", fcu->curval);
 
-      PathResolvedRNA anim_rna;
-      if (animsys_store_rna_setting(&id_ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      /* Use the cached path when available, each driver only touches its own binding. */
+      AnimPathBinding *binding = NULL;
+      PathResolvedRNA local_anim_rna, *anim_rna = &local_anim_rna;
+      bool is_resolved;
+      if (adt->path_cache && driver_index < adt->path_cache->num_driver_bindings) {
+        binding = &adt->path_cache->driver_bindings[driver_index];
+        is_resolved = animsys_path_binding_ensure(binding, &id_ptr, fcu);
+        anim_rna = &binding->anim_rna;
+      }
+      else {
+        is_resolved = animsys_store_rna_setting(
+            &id_ptr, fcu->rna_path, fcu->array_index, anim_rna);
+      }
+
+      if (is_resolved) {
         /* Evaluate driver, and write results to COW-domain destination */
         const float ctime = DEG_get_ctime(depsgraph);
-        const float curval = calculate_fcurve(&anim_rna, fcu, ctime);
-        ok = animsys_write_rna_setting(&anim_rna, curval);
+        const float curval = calculate_fcurve_ex(
+            anim_rna, fcu, ctime, binding ? &binding->segment_hint : NULL);
+        ok = animsys_write_rna_setting(anim_rna, curval);
 
         /* Flush results & status codes to original data for UI (T59984) */
         if (ok && DEG_is_active(depsgraph)) {
-          animsys_write_orig_anim_rna(&id_ptr, fcu->rna_path, fcu->array_index, curval);
+          if (binding) {
+            animsys_write_orig_anim_rna_binding(&id_ptr, binding, curval);
+          }
+          else {
+            animsys_write_orig_anim_rna(&id_ptr, fcu->rna_path, fcu->array_index, curval);
+          }
 
           /* curval is displayed in the UI, and flag contains error-status codes */
           fcu_orig->curval = fcu->curval;
@@ -30,6 +30,7 @@
 #include "DNA_meshdata_types.h"
 
 #include "BLI_utildefines.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
 #include "BLI_threads.h"
@@ -43,6 +44,8 @@
 
 static ThreadRWMutex cache_rwlock = BLI_RWLOCK_INITIALIZER;
 
+static bool bvhcache_refit_from_mesh(struct Mesh *mesh, int type, BVHTree **r_tree);
+
 /* -------------------------------------------------------------------- */
 /** \name Local Callbacks
  * \{ */
@@ -1321,6 +1324,11 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
   bool is_cached = bvhcache_find(*bvh_cache, bvh_cache_type, &tree);
   BLI_rw_mutex_unlock(&cache_rwlock);
 
+  if (is_cached == false) {
+    /* Reuse the tree of the previous evaluation when only the vertex positions changed. */
+    is_cached = bvhcache_refit_from_mesh(mesh, bvh_cache_type, &tree);
+  }
+
   if (is_cached && tree == NULL) {
     memset(data, 0, sizeof(*data));
     return tree;
@@ -1624,8 +1632,19 @@ typedef struct BVHCacheItem {
   int type;
   BVHTree *tree;
 
+  /** Topology of the mesh the tree was built for, only set for trees kept for refitting. */
+  uint topology_hash;
+  int totvert, totedge, totloop, totpoly;
+  /** #BLI_bvhtree_get_area_ratio of the tree after it was built, zero when unknown. */
+  float area_ratio_build;
 } BVHCacheItem;
 
+/**
+ * Rebuild refit trees when their area ratio grows past this factor of the ratio after building,
+ * refitting keeps the tree structure, which fits worse the more the mesh deforms.
+ */
+#define BVHCACHE_REFIT_AREA_RATIO_MAX 1.5f
+
 /**
  * Queries a bvhcache for the cache bvhtree of the request type
  */
@@ -1672,6 +1691,8 @@ void bvhcache_insert(BVHCache **cache_p, BVHTree *tree, int type)
 
   item->type = type;
   item->tree = tree;
+  item->topology_hash = 0;
+  item->area_ratio_build = 0.0f;
 
   BLI_linklist_prepend(cache_p, item);
 }
@@ -1694,3 +1715,212 @@ void bvhcache_free(BVHCache **cache_p)
 }
 
 /** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name BVHCache Refitting
+ *
+ * Evaluated meshes are freed and created again on every evaluation of their object.
+ * When only the vertex positions change (animated deformation for example),
+ * the trees of the previous evaluated mesh are refit to the new positions,
+ * which is much faster than building them again.
+ * \{ */
+
+/* Everything the trees depend on, except for the vertex positions. */
+static uint mesh_topology_hash(const Mesh *mesh)
+{
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+  BLI_hash_mm2a_add_int(&mm2, mesh->totvert);
+  BLI_hash_mm2a_add_int(&mm2, mesh->totedge);
+  BLI_hash_mm2a_add_int(&mm2, mesh->totloop);
+  BLI_hash_mm2a_add_int(&mm2, mesh->totpoly);
+  if (mesh->totedge) {
+    BLI_hash_mm2a_add(&mm2, (const uchar *)mesh->medge, sizeof(*mesh->medge) * mesh->totedge);
+  }
+  if (mesh->totloop) {
+    BLI_hash_mm2a_add(&mm2, (const uchar *)mesh->mloop, sizeof(*mesh->mloop) * mesh->totloop);
+  }
+  if (mesh->totpoly) {
+    BLI_hash_mm2a_add(&mm2, (const uchar *)mesh->mpoly, sizeof(*mesh->mpoly) * mesh->totpoly);
+  }
+  return BLI_hash_mm2a_end(&mm2);
+}
+
+/**
+ * Move the trees out of the cache of an evaluated mesh which is about to be freed,
+ * to pass them to the next evaluated mesh of the same object with #bvhcache_give_for_refit.
+ */
+BVHCache *bvhcache_take_for_refit(struct Mesh *mesh)
+{
+  BVHCache *cache = NULL;
+  uint topology_hash = 0;
+
+  /* Trees which weren't requested since the previous evaluation aren't kept. */
+  BLI_linklist_free(mesh->runtime.bvh_cache_refit, (LinkNodeFreeFP)bvhcacheitem_free);
+  mesh->runtime.bvh_cache_refit = NULL;
+
+  for (LinkNode *link = mesh->runtime.bvh_cache; link; link = link->next) {
+    BVHCacheItem *item = link->link;
+    /* Legacy tessellated faces aren't kept. */
+    if (item->tree == NULL || item->type == BVHTREE_FROM_FACES) {
+      bvhcacheitem_free(item);
+      continue;
+    }
+    if (cache == NULL) {
+      topology_hash = mesh_topology_hash(mesh);
+    }
+    item->topology_hash = topology_hash;
+    item->totvert = mesh->totvert;
+    item->totedge = mesh->totedge;
+    item->totloop = mesh->totloop;
+    item->totpoly = mesh->totpoly;
+    if (item->area_ratio_build == 0.0f) {
+      item->area_ratio_build = BLI_bvhtree_get_area_ratio(item->tree);
+    }
+    BLI_linklist_prepend(&cache, item);
+  }
+  BLI_linklist_free(mesh->runtime.bvh_cache, NULL);
+  mesh->runtime.bvh_cache = NULL;
+
+  return cache;
+}
+
+/**
+ * Keep trees from #bvhcache_take_for_refit which match the topology of \a mesh,
+ * they are refit the first time they are requested with #BKE_bvhtree_from_mesh_get.
+ * Frees the other trees.
+ */
+void bvhcache_give_for_refit(struct Mesh *mesh, BVHCache **cache_p)
+{
+  BLI_assert(mesh->runtime.bvh_cache_refit == NULL);
+
+  if (*cache_p == NULL) {
+    return;
+  }
+
+  const uint topology_hash = mesh_topology_hash(mesh);
+  for (LinkNode *link = *cache_p; link; link = link->next) {
+    BVHCacheItem *item = link->link;
+    /* The hash alone could collide, the element counts must match for the refit to be safe. */
+    if (item->topology_hash == topology_hash && item->totvert == mesh->totvert &&
+        item->totedge == mesh->totedge && item->totloop == mesh->totloop &&
+        item->totpoly == mesh->totpoly) {
+      BLI_linklist_prepend(&mesh->runtime.bvh_cache_refit, item);
+    }
+    else {
+      bvhcacheitem_free(item);
+    }
+  }
+  BLI_linklist_free(*cache_p, NULL);
+  *cache_p = NULL;
+}
+
+typedef struct BVHRefitData {
+  const MVert *vert;
+  const MEdge *edge;
+  const MLoop *loop;
+  const MLoopTri *looptri;
+} BVHRefitData;
+
+static int mesh_verts_refit_cb(void *userdata, int index, float r_co[4][3])
+{
+  const BVHRefitData *data = userdata;
+  copy_v3_v3(r_co[0], data->vert[index].co);
+  return 1;
+}
+
+static int mesh_edges_refit_cb(void *userdata, int index, float r_co[4][3])
+{
+  const BVHRefitData *data = userdata;
+  const MEdge *edge = &data->edge[index];
+  copy_v3_v3(r_co[0], data->vert[edge->v1].co);
+  copy_v3_v3(r_co[1], data->vert[edge->v2].co);
+  return 2;
+}
+
+static int mesh_looptri_refit_cb(void *userdata, int index, float r_co[4][3])
+{
+  const BVHRefitData *data = userdata;
+  const MLoopTri *lt = &data->looptri[index];
+  copy_v3_v3(r_co[0], data->vert[data->loop[lt->tri[0]].v].co);
+  copy_v3_v3(r_co[1], data->vert[data->loop[lt->tri[1]].v].co);
+  copy_v3_v3(r_co[2], data->vert[data->loop[lt->tri[2]].v].co);
+  return 3;
+}
+
+/**
+ * Refit a tree kept from the previous evaluation and move it to the cache of the mesh.
+ * \return false when there is no such tree, or when it got too slow to query.
+ */
+static bool bvhcache_refit_from_mesh(struct Mesh *mesh, int type, BVHTree **r_tree)
+{
+  BVHCache **bvh_cache = &mesh->runtime.bvh_cache;
+  BVHCache **bvh_cache_refit = &mesh->runtime.bvh_cache_refit;
+  LinkNode *link_prev = NULL;
+  LinkNode *link;
+
+  BLI_rw_mutex_lock(&cache_rwlock, THREAD_LOCK_WRITE);
+  /* Another thread may have refit the tree in the meantime. */
+  if (bvhcache_find(*bvh_cache, type, r_tree)) {
+    BLI_rw_mutex_unlock(&cache_rwlock);
+    return true;
+  }
+
+  for (link = *bvh_cache_refit; link; link_prev = link, link = link->next) {
+    if (((BVHCacheItem *)link->link)->type == type) {
+      break;
+    }
+  }
+  if (link == NULL) {
+    BLI_rw_mutex_unlock(&cache_rwlock);
+    return false;
+  }
+
+  if (link_prev) {
+    link_prev->next = link->next;
+  }
+  else {
+    *bvh_cache_refit = link->next;
+  }
+  BVHCacheItem *item = link->link;
+  MEM_freeN(link);
+
+  BVHRefitData data = {
+      .vert = mesh->mvert,
+      .edge = mesh->medge,
+      .loop = mesh->mloop,
+  };
+  switch (type) {
+    case BVHTREE_FROM_VERTS:
+    case BVHTREE_FROM_LOOSEVERTS:
+      BLI_bvhtree_update_leafs(item->tree, mesh_verts_refit_cb, &data);
+      break;
+    case BVHTREE_FROM_EDGES:
+    case BVHTREE_FROM_LOOSEEDGES:
+      BLI_bvhtree_update_leafs(item->tree, mesh_edges_refit_cb, &data);
+      break;
+    case BVHTREE_FROM_LOOPTRI:
+    case BVHTREE_FROM_LOOPTRI_NO_HIDDEN:
+      data.looptri = BKE_mesh_runtime_looptri_ensure(mesh);
+      BLI_bvhtree_update_leafs(item->tree, mesh_looptri_refit_cb, &data);
+      break;
+    default:
+      BLI_assert(false);
+      break;
+  }
+
+  if (BLI_bvhtree_get_area_ratio(item->tree) >
+      item->area_ratio_build * BVHCACHE_REFIT_AREA_RATIO_MAX) {
+    bvhcacheitem_free(item);
+    BLI_rw_mutex_unlock(&cache_rwlock);
+    return false;
+  }
+
+  BLI_linklist_prepend(bvh_cache, item);
+  BLI_rw_mutex_unlock(&cache_rwlock);
+
+  *r_tree = item->tree;
+  return true;
+}
+
+/** \} */
@@ -32,6 +32,7 @@
 #include "BLI_utildefines.h"
 #include "BLI_ghash.h"
 #include "BLI_linklist.h"
+#include "BLI_task.h"
 
 #include "DNA_anim_types.h"
 #include "DNA_curve_types.h"
@@ -2637,451 +2638,682 @@ void BKE_curve_bevelList_free(ListBase *bev)
     if (bl->bevpoints != NULL) {
       MEM_freeN(bl->bevpoints);
     }
+    if (bl->source != NULL) {
+      MEM_freeN(bl->source);
+    }
     MEM_freeN(bl);
   }
 
   BLI_listbase_clear(bev);
 }
 
-void BKE_curve_bevelList_make(Object *ob, ListBase *nurbs, bool for_render)
-{
-  /*
-   * - convert all curves to polys, with indication of resol and flags for double-vertices
-   * - possibly; do a smart vertice removal (in case Nurb)
-   * - separate in individual blocks with BoundBox
-   * - AutoHole detection
-   */
+/**
+ * A copy of everything the bevel list of a spline is calculated from, the bevel list can be
+ * reused as long as the copy made for the next evaluation is the same, byte for byte.
+ */
+static void *bevel_list_nurb_source(const Curve *cu,
+                                    const Nurb *nu,
+                                    const int resolu,
+                                    const int smooth_iter,
+                                    const bool need_seglen,
+                                    size_t *r_source_len)
+{
+  const int settings[] = {
+      cu->flag & CU_3D,
+      cu->twist_mode,
+      smooth_iter,
+      need_seglen,
+      nu->type,
+      nu->flagu,
+      nu->pntsu,
+      nu->pntsv,
+      nu->orderu,
+      nu->charidx,
+      nu->tilt_interp,
+      nu->radius_interp,
+      resolu,
+      CU_DO_TILT(cu, nu),
+      CU_DO_RADIUS(cu, nu),
+  };
+  const size_t bezt_len = nu->bezt ? sizeof(*nu->bezt) * (size_t)nu->pntsu : 0;
+  const size_t bp_len = nu->bp ? sizeof(*nu->bp) * (size_t)(nu->pntsu * nu->pntsv) : 0;
+  const size_t knots_len = nu->knotsu ? sizeof(float) * (size_t)KNOTSU(nu) : 0;
+  const size_t source_len = sizeof(settings) + bezt_len + bp_len + knots_len;
+  char *source = MEM_mallocN(source_len, __func__);
+  char *source_iter = source;
+
+  memcpy(source_iter, settings, sizeof(settings));
+  source_iter += sizeof(settings);
+  if (bezt_len) {
+    memcpy(source_iter, nu->bezt, bezt_len);
+    source_iter += bezt_len;
+  }
+  if (bp_len) {
+    memcpy(source_iter, nu->bp, bp_len);
+    source_iter += bp_len;
+  }
+  if (knots_len) {
+    memcpy(source_iter, nu->knotsu, knots_len);
+  }
+
+  *r_source_len = source_len;
+  return source;
+}
 
-  /* this function needs an object, because of tflag and upflag */
-  Curve *cu = ob->data;
-  Nurb *nu;
+/**
+ * Convert a single spline to a poly and remove its double points (STEP 1 and 2),
+ * returns NULL for splines which don't have a bevel list.
+ */
+static BevList *bevel_list_make_nurb(const Curve *cu,
+                                     Nurb *nu,
+                                     const int resolu,
+                                     const bool need_seglen)
+{
   BezTriple *bezt, *prevbezt;
   BPoint *bp;
-  BevList *bl, *blnew, *blnext;
-  BevPoint *bevp2, *bevp1 = NULL, *bevp0;
+  BevList *bl, *blnew;
+  BevPoint *bevp, *bevp1, *bevp0;
   const float treshold = 0.00001f;
-  float min, inp;
   float *seglen = NULL;
-  struct BevelSort *sortdata, *sd, *sd1;
-  int a, b, nr, poly, resolu = 0, len = 0, segcount;
+  int a, nr, len, segcount;
   int *segbevcount;
-  bool do_tilt, do_radius, do_weight;
-  bool is_editmode = false;
-  ListBase *bev;
 
-  /* segbevcount alsp requires seglen. */
-  const bool need_seglen = ELEM(
-                               cu->bevfac1_mapping, CU_BEVFAC_MAP_SEGMENT, CU_BEVFAC_MAP_SPLINE) ||
-                           ELEM(cu->bevfac2_mapping, CU_BEVFAC_MAP_SEGMENT, CU_BEVFAC_MAP_SPLINE);
+  /* check if we will calculate tilt data */
+  const bool do_tilt = CU_DO_TILT(cu, nu);
 
-  bev = &ob->runtime.curve_cache->bev;
+  /* Normal display uses the radius, better just to calculate them. */
+  const bool do_radius = CU_DO_RADIUS(cu, nu);
 
-#if 0
-  /* do we need to calculate the radius for each point? */
-  do_radius = (cu->bevobj || cu->taperobj || (cu->flag & CU_FRONT) || (cu->flag & CU_BACK)) ? 0 :
-                                                                                              1;
-#endif
+  const bool do_weight = true;
 
   /* STEP 1: MAKE POLYS  */
 
-  BKE_curve_bevelList_free(&ob->runtime.curve_cache->bev);
-  nu = nurbs->first;
-  if (cu->editnurb && ob->type != OB_FONT) {
-    is_editmode = 1;
+  /* check we are a single point? also check we are not a surface and that the orderu is sane,
+   * enforced in the UI but can go wrong possibly */
+  if (!BKE_nurb_check_valid_u(nu)) {
+    bl = MEM_callocN(sizeof(BevList), "makeBevelList1");
+    bl->bevpoints = MEM_calloc_arrayN(1, sizeof(BevPoint), "makeBevelPoints1");
+    bl->nr = 0;
+    bl->charidx = nu->charidx;
+    return bl;
   }
 
-  for (; nu; nu = nu->next) {
-    if (nu->hide && is_editmode) {
-      continue;
+  segcount = SEGMENTSU(nu);
+
+  if (nu->type == CU_POLY) {
+    len = nu->pntsu;
+    bl = MEM_callocN(sizeof(BevList), "makeBevelList2");
+    bl->bevpoints = MEM_calloc_arrayN(len, sizeof(BevPoint), "makeBevelPoints2");
+    if (need_seglen && (nu->flagu & CU_NURB_CYCLIC) == 0) {
+      bl->seglen = MEM_malloc_arrayN(segcount, sizeof(float), "makeBevelList2_seglen");
+      bl->segbevcount = MEM_malloc_arrayN(segcount, sizeof(int), "makeBevelList2_segbevcount");
+    }
+
+    bl->poly = (nu->flagu & CU_NURB_CYCLIC) ? 0 : -1;
+    bl->nr = len;
+    bl->dupe_nr = 0;
+    bl->charidx = nu->charidx;
+    bevp = bl->bevpoints;
+    bevp->offset = 0;
+    bp = nu->bp;
+    seglen = bl->seglen;
+    segbevcount = bl->segbevcount;
+
+    while (len--) {
+      copy_v3_v3(bevp->vec, bp->vec);
+      bevp->tilt = bp->tilt;
+      bevp->radius = bp->radius;
+      bevp->weight = bp->weight;
+      bevp->split_tag = true;
+      bp++;
+      if (seglen != NULL && len != 0) {
+        *seglen = len_v3v3(bevp->vec, bp->vec);
+        bevp++;
+        bevp->offset = *seglen;
+        if (*seglen > treshold) {
+          *segbevcount = 1;
+        }
+        else {
+          *segbevcount = 0;
+        }
+        seglen++;
+        segbevcount++;
+      }
+      else {
+        bevp++;
+      }
     }
 
-    /* check if we will calculate tilt data */
-    do_tilt = CU_DO_TILT(cu, nu);
+    if ((nu->flagu & CU_NURB_CYCLIC) == 0) {
+      bevlist_firstlast_direction_calc_from_bpoint(nu, bl);
+    }
+  }
+  else if (nu->type == CU_BEZIER) {
+    /* in case last point is not cyclic */
+    len = segcount * resolu + 1;
 
-    /* Normal display uses the radius, better just to calculate them. */
-    do_radius = CU_DO_RADIUS(cu, nu);
+    bl = MEM_callocN(sizeof(BevList), "makeBevelBPoints");
+    bl->bevpoints = MEM_calloc_arrayN(len, sizeof(BevPoint), "makeBevelBPointsPoints");
+    if (need_seglen && (nu->flagu & CU_NURB_CYCLIC) == 0) {
+      bl->seglen = MEM_malloc_arrayN(segcount, sizeof(float), "makeBevelBPoints_seglen");
+      bl->segbevcount = MEM_malloc_arrayN(segcount, sizeof(int), "makeBevelBPoints_segbevcount");
+    }
 
-    do_weight = true;
+    bl->poly = (nu->flagu & CU_NURB_CYCLIC) ? 0 : -1;
+    bl->charidx = nu->charidx;
 
-    /* check we are a single point? also check we are not a surface and that the orderu is sane,
-     * enforced in the UI but can go wrong possibly */
-    if (!BKE_nurb_check_valid_u(nu)) {
-      bl = MEM_callocN(sizeof(BevList), "makeBevelList1");
-      bl->bevpoints = MEM_calloc_arrayN(1, sizeof(BevPoint), "makeBevelPoints1");
-      BLI_addtail(bev, bl);
-      bl->nr = 0;
-      bl->charidx = nu->charidx;
+    bevp = bl->bevpoints;
+    seglen = bl->seglen;
+    segbevcount = bl->segbevcount;
+
+    bevp->offset = 0;
+    if (seglen != NULL) {
+      *seglen = 0;
+      *segbevcount = 0;
+    }
+
+    a = nu->pntsu - 1;
+    bezt = nu->bezt;
+    if (nu->flagu & CU_NURB_CYCLIC) {
+      a++;
+      prevbezt = nu->bezt + (nu->pntsu - 1);
     }
     else {
-      BevPoint *bevp;
+      prevbezt = bezt;
+      bezt++;
+    }
 
-      if (for_render && cu->resolu_ren != 0) {
-        resolu = cu->resolu_ren;
-      }
-      else {
-        resolu = nu->resolu;
-      }
+    sub_v3_v3v3(bevp->dir, prevbezt->vec[2], prevbezt->vec[1]);
+    normalize_v3(bevp->dir);
 
-      segcount = SEGMENTSU(nu);
+    BLI_assert(segcount >= a);
 
-      if (nu->type == CU_POLY) {
-        len = nu->pntsu;
-        bl = MEM_callocN(sizeof(BevList), "makeBevelList2");
-        bl->bevpoints = MEM_calloc_arrayN(len, sizeof(BevPoint), "makeBevelPoints2");
-        if (need_seglen && (nu->flagu & CU_NURB_CYCLIC) == 0) {
-          bl->seglen = MEM_malloc_arrayN(segcount, sizeof(float), "makeBevelList2_seglen");
-          bl->segbevcount = MEM_malloc_arrayN(segcount, sizeof(int), "makeBevelList2_segbevcount");
-        }
-        BLI_addtail(bev, bl);
+    while (a--) {
+      if (prevbezt->h2 == HD_VECT && bezt->h1 == HD_VECT) {
 
-        bl->poly = (nu->flagu & CU_NURB_CYCLIC) ? 0 : -1;
-        bl->nr = len;
-        bl->dupe_nr = 0;
-        bl->charidx = nu->charidx;
-        bevp = bl->bevpoints;
-        bevp->offset = 0;
-        bp = nu->bp;
-        seglen = bl->seglen;
-        segbevcount = bl->segbevcount;
-
-        while (len--) {
-          copy_v3_v3(bevp->vec, bp->vec);
-          bevp->tilt = bp->tilt;
-          bevp->radius = bp->radius;
-          bevp->weight = bp->weight;
-          bevp->split_tag = true;
-          bp++;
-          if (seglen != NULL && len != 0) {
-            *seglen = len_v3v3(bevp->vec, bp->vec);
-            bevp++;
-            bevp->offset = *seglen;
-            if (*seglen > treshold) {
-              *segbevcount = 1;
-            }
-            else {
-              *segbevcount = 0;
-            }
-            seglen++;
-            segbevcount++;
-          }
-          else {
-            bevp++;
+        copy_v3_v3(bevp->vec, prevbezt->vec[1]);
+        bevp->tilt = prevbezt->tilt;
+        bevp->radius = prevbezt->radius;
+        bevp->weight = prevbezt->weight;
+        bevp->split_tag = true;
+        bevp->dupe_tag = false;
+        bevp++;
+        bl->nr++;
+        bl->dupe_nr = 1;
+        if (seglen != NULL) {
+          *seglen = len_v3v3(prevbezt->vec[1], bezt->vec[1]);
+          bevp->offset = *seglen;
+          seglen++;
+          /* match segbevcount to the cleaned up bevel lists (see STEP 2) */
+          if (bevp->offset > treshold) {
+            *segbevcount = 1;
           }
-        }
-
-        if ((nu->flagu & CU_NURB_CYCLIC) == 0) {
-          bevlist_firstlast_direction_calc_from_bpoint(nu, bl);
+          segbevcount++;
         }
       }
-      else if (nu->type == CU_BEZIER) {
-        /* in case last point is not cyclic */
-        len = segcount * resolu + 1;
+      else {
+        /* always do all three, to prevent data hanging around */
+        int j;
 
-        bl = MEM_callocN(sizeof(BevList), "makeBevelBPoints");
-        bl->bevpoints = MEM_calloc_arrayN(len, sizeof(BevPoint), "makeBevelBPointsPoints");
-        if (need_seglen && (nu->flagu & CU_NURB_CYCLIC) == 0) {
-          bl->seglen = MEM_malloc_arrayN(segcount, sizeof(float), "makeBevelBPoints_seglen");
-          bl->segbevcount = MEM_malloc_arrayN(
-              segcount, sizeof(int), "makeBevelBPoints_segbevcount");
+        /* BevPoint must stay aligned to 4 so sizeof(BevPoint)/sizeof(float) works */
+        for (j = 0; j < 3; j++) {
+          BKE_curve_forward_diff_bezier(prevbezt->vec[1][j],
+                                        prevbezt->vec[2][j],
+                                        bezt->vec[0][j],
+                                        bezt->vec[1][j],
+                                        &(bevp->vec[j]),
+                                        resolu,
+                                        sizeof(BevPoint));
         }
-        BLI_addtail(bev, bl);
 
-        bl->poly = (nu->flagu & CU_NURB_CYCLIC) ? 0 : -1;
-        bl->charidx = nu->charidx;
+        /* if both arrays are NULL do nothiong */
+        tilt_bezpart(prevbezt,
+                     bezt,
+                     nu,
+                     do_tilt ? &bevp->tilt : NULL,
+                     do_radius ? &bevp->radius : NULL,
+                     do_weight ? &bevp->weight : NULL,
+                     resolu,
+                     sizeof(BevPoint));
+
+        if (cu->twist_mode == CU_TWIST_TANGENT) {
+          forward_diff_bezier_cotangent(prevbezt->vec[1],
+                                        prevbezt->vec[2],
+                                        bezt->vec[0],
+                                        bezt->vec[1],
+                                        bevp->tan,
+                                        resolu,
+                                        sizeof(BevPoint));
+        }
 
-        bevp = bl->bevpoints;
-        seglen = bl->seglen;
-        segbevcount = bl->segbevcount;
+        /* indicate with handlecodes double points */
+        if (prevbezt->h1 == prevbezt->h2) {
+          if (prevbezt->h1 == 0 || prevbezt->h1 == HD_VECT) {
+            bevp->split_tag = true;
+          }
+        }
+        else {
+          if (prevbezt->h1 == 0 || prevbezt->h1 == HD_VECT) {
+            bevp->split_tag = true;
+          }
+          else if (prevbezt->h2 == 0 || prevbezt->h2 == HD_VECT) {
+            bevp->split_tag = true;
+          }
+        }
 
-        bevp->offset = 0;
+        /* seglen */
         if (seglen != NULL) {
           *seglen = 0;
           *segbevcount = 0;
-        }
-
-        a = nu->pntsu - 1;
-        bezt = nu->bezt;
-        if (nu->flagu & CU_NURB_CYCLIC) {
-          a++;
-          prevbezt = nu->bezt + (nu->pntsu - 1);
+          for (j = 0; j < resolu; j++) {
+            bevp0 = bevp;
+            bevp++;
+            bevp->offset = len_v3v3(bevp0->vec, bevp->vec);
+            /* match seglen and segbevcount to the cleaned up bevel lists (see STEP 2) */
+            if (bevp->offset > treshold) {
+              *seglen += bevp->offset;
+              *segbevcount += 1;
+            }
+          }
+          seglen++;
+          segbevcount++;
         }
         else {
-          prevbezt = bezt;
-          bezt++;
+          bevp += resolu;
         }
+        bl->nr += resolu;
+      }
+      prevbezt = bezt;
+      bezt++;
+    }
 
-        sub_v3_v3v3(bevp->dir, prevbezt->vec[2], prevbezt->vec[1]);
-        normalize_v3(bevp->dir);
-
-        BLI_assert(segcount >= a);
+    if ((nu->flagu & CU_NURB_CYCLIC) == 0) { /* not cyclic: endpoint */
+      copy_v3_v3(bevp->vec, prevbezt->vec[1]);
+      bevp->tilt = prevbezt->tilt;
+      bevp->radius = prevbezt->radius;
+      bevp->weight = prevbezt->weight;
 
-        while (a--) {
-          if (prevbezt->h2 == HD_VECT && bezt->h1 == HD_VECT) {
+      sub_v3_v3v3(bevp->dir, prevbezt->vec[1], prevbezt->vec[0]);
+      normalize_v3(bevp->dir);
 
-            copy_v3_v3(bevp->vec, prevbezt->vec[1]);
-            bevp->tilt = prevbezt->tilt;
-            bevp->radius = prevbezt->radius;
-            bevp->weight = prevbezt->weight;
-            bevp->split_tag = true;
-            bevp->dupe_tag = false;
-            bevp++;
-            bl->nr++;
-            bl->dupe_nr = 1;
-            if (seglen != NULL) {
-              *seglen = len_v3v3(prevbezt->vec[1], bezt->vec[1]);
-              bevp->offset = *seglen;
-              seglen++;
-              /* match segbevcount to the cleaned up bevel lists (see STEP 2) */
-              if (bevp->offset > treshold) {
-                *segbevcount = 1;
-              }
-              segbevcount++;
-            }
-          }
-          else {
-            /* always do all three, to prevent data hanging around */
-            int j;
-
-            /* BevPoint must stay aligned to 4 so sizeof(BevPoint)/sizeof(float) works */
-            for (j = 0; j < 3; j++) {
-              BKE_curve_forward_diff_bezier(prevbezt->vec[1][j],
-                                            prevbezt->vec[2][j],
-                                            bezt->vec[0][j],
-                                            bezt->vec[1][j],
-                                            &(bevp->vec[j]),
-                                            resolu,
-                                            sizeof(BevPoint));
-            }
-
-            /* if both arrays are NULL do nothiong */
-            tilt_bezpart(prevbezt,
-                         bezt,
-                         nu,
-                         do_tilt ? &bevp->tilt : NULL,
-                         do_radius ? &bevp->radius : NULL,
-                         do_weight ? &bevp->weight : NULL,
-                         resolu,
-                         sizeof(BevPoint));
-
-            if (cu->twist_mode == CU_TWIST_TANGENT) {
-              forward_diff_bezier_cotangent(prevbezt->vec[1],
-                                            prevbezt->vec[2],
-                                            bezt->vec[0],
-                                            bezt->vec[1],
-                                            bevp->tan,
-                                            resolu,
-                                            sizeof(BevPoint));
-            }
+      bl->nr++;
+    }
+  }
+  else if (nu->type == CU_NURBS && nu->pntsv == 1) {
+    len = (resolu * segcount);
 
-            /* indicate with handlecodes double points */
-            if (prevbezt->h1 == prevbezt->h2) {
-              if (prevbezt->h1 == 0 || prevbezt->h1 == HD_VECT) {
-                bevp->split_tag = true;
-              }
-            }
-            else {
-              if (prevbezt->h1 == 0 || prevbezt->h1 == HD_VECT) {
-                bevp->split_tag = true;
-              }
-              else if (prevbezt->h2 == 0 || prevbezt->h2 == HD_VECT) {
-                bevp->split_tag = true;
-              }
-            }
+    bl = MEM_callocN(sizeof(BevList), "makeBevelList3");
+    bl->bevpoints = MEM_calloc_arrayN(len, sizeof(BevPoint), "makeBevelPoints3");
+    if (need_seglen && (nu->flagu & CU_NURB_CYCLIC) == 0) {
+      bl->seglen = MEM_malloc_arrayN(segcount, sizeof(float), "makeBevelList3_seglen");
+      bl->segbevcount = MEM_malloc_arrayN(segcount, sizeof(int), "makeBevelList3_segbevcount");
+    }
+    bl->nr = len;
+    bl->dupe_nr = 0;
+    bl->poly = (nu->flagu & CU_NURB_CYCLIC) ? 0 : -1;
+    bl->charidx = nu->charidx;
 
-            /* seglen */
-            if (seglen != NULL) {
-              *seglen = 0;
-              *segbevcount = 0;
-              for (j = 0; j < resolu; j++) {
-                bevp0 = bevp;
-                bevp++;
-                bevp->offset = len_v3v3(bevp0->vec, bevp->vec);
-                /* match seglen and segbevcount to the cleaned up bevel lists (see STEP 2) */
-                if (bevp->offset > treshold) {
-                  *seglen += bevp->offset;
-                  *segbevcount += 1;
-                }
-              }
-              seglen++;
-              segbevcount++;
-            }
-            else {
-              bevp += resolu;
-            }
-            bl->nr += resolu;
+    bevp = bl->bevpoints;
+    seglen = bl->seglen;
+    segbevcount = bl->segbevcount;
+
+    BKE_nurb_makeCurve(nu,
+                       &bevp->vec[0],
+                       do_tilt ? &bevp->tilt : NULL,
+                       do_radius ? &bevp->radius : NULL,
+                       do_weight ? &bevp->weight : NULL,
+                       resolu,
+                       sizeof(BevPoint));
+
+    /* match seglen and segbevcount to the cleaned up bevel lists (see STEP 2) */
+    if (seglen != NULL) {
+      nr = segcount;
+      bevp0 = bevp;
+      bevp++;
+      while (nr) {
+        int j;
+        *seglen = 0;
+        *segbevcount = 0;
+        /* We keep last bevel segment zero-length. */
+        for (j = 0; j < ((nr == 1) ? (resolu - 1) : resolu); j++) {
+          bevp->offset = len_v3v3(bevp0->vec, bevp->vec);
+          if (bevp->offset > treshold) {
+            *seglen += bevp->offset;
+            *segbevcount += 1;
           }
-          prevbezt = bezt;
-          bezt++;
+          bevp0 = bevp;
+          bevp++;
         }
+        seglen++;
+        segbevcount++;
+        nr--;
+      }
+    }
 
-        if ((nu->flagu & CU_NURB_CYCLIC) == 0) { /* not cyclic: endpoint */
-          copy_v3_v3(bevp->vec, prevbezt->vec[1]);
-          bevp->tilt = prevbezt->tilt;
-          bevp->radius = prevbezt->radius;
-          bevp->weight = prevbezt->weight;
-
-          sub_v3_v3v3(bevp->dir, prevbezt->vec[1], prevbezt->vec[0]);
-          normalize_v3(bevp->dir);
+    if ((nu->flagu & CU_NURB_CYCLIC) == 0) {
+      bevlist_firstlast_direction_calc_from_bpoint(nu, bl);
+    }
+  }
+  else {
+    return NULL;
+  }
 
-          bl->nr++;
+  /* STEP 2: DOUBLE POINTS AND AUTOMATIC RESOLUTION, REDUCE DATABLOCKS */
+  if (bl->nr) { /* null bevel items come from single points */
+    bool is_cyclic = bl->poly != -1;
+    nr = bl->nr;
+    if (is_cyclic) {
+      bevp1 = bl->bevpoints;
+      bevp0 = bevp1 + (nr - 1);
+    }
+    else {
+      bevp0 = bl->bevpoints;
+      bevp0->offset = 0;
+      bevp1 = bevp0 + 1;
+    }
+    nr--;
+    while (nr--) {
+      if (bl->seglen != NULL) {
+        if (fabsf(bevp1->offset) < treshold) {
+          bevp0->dupe_tag = true;
+          bl->dupe_nr++;
         }
       }
-      else if (nu->type == CU_NURBS) {
-        if (nu->pntsv == 1) {
-          len = (resolu * segcount);
-
-          bl = MEM_callocN(sizeof(BevList), "makeBevelList3");
-          bl->bevpoints = MEM_calloc_arrayN(len, sizeof(BevPoint), "makeBevelPoints3");
-          if (need_seglen && (nu->flagu & CU_NURB_CYCLIC) == 0) {
-            bl->seglen = MEM_malloc_arrayN(segcount, sizeof(float), "makeBevelList3_seglen");
-            bl->segbevcount = MEM_malloc_arrayN(
-                segcount, sizeof(int), "makeBevelList3_segbevcount");
-          }
-          BLI_addtail(bev, bl);
-          bl->nr = len;
-          bl->dupe_nr = 0;
-          bl->poly = (nu->flagu & CU_NURB_CYCLIC) ? 0 : -1;
-          bl->charidx = nu->charidx;
-
-          bevp = bl->bevpoints;
-          seglen = bl->seglen;
-          segbevcount = bl->segbevcount;
-
-          BKE_nurb_makeCurve(nu,
-                             &bevp->vec[0],
-                             do_tilt ? &bevp->tilt : NULL,
-                             do_radius ? &bevp->radius : NULL,
-                             do_weight ? &bevp->weight : NULL,
-                             resolu,
-                             sizeof(BevPoint));
-
-          /* match seglen and segbevcount to the cleaned up bevel lists (see STEP 2) */
-          if (seglen != NULL) {
-            nr = segcount;
-            bevp0 = bevp;
-            bevp++;
-            while (nr) {
-              int j;
-              *seglen = 0;
-              *segbevcount = 0;
-              /* We keep last bevel segment zero-length. */
-              for (j = 0; j < ((nr == 1) ? (resolu - 1) : resolu); j++) {
-                bevp->offset = len_v3v3(bevp0->vec, bevp->vec);
-                if (bevp->offset > treshold) {
-                  *seglen += bevp->offset;
-                  *segbevcount += 1;
-                }
-                bevp0 = bevp;
-                bevp++;
-              }
-              seglen++;
-              segbevcount++;
-              nr--;
+      else {
+        if (fabsf(bevp0->vec[0] - bevp1->vec[0]) < 0.00001f) {
+          if (fabsf(bevp0->vec[1] - bevp1->vec[1]) < 0.00001f) {
+            if (fabsf(bevp0->vec[2] - bevp1->vec[2]) < 0.00001f) {
+              bevp0->dupe_tag = true;
+              bl->dupe_nr++;
             }
           }
-
-          if ((nu->flagu & CU_NURB_CYCLIC) == 0) {
-            bevlist_firstlast_direction_calc_from_bpoint(nu, bl);
-          }
         }
       }
+      bevp0 = bevp1;
+      bevp1++;
     }
   }
 
-  /* STEP 2: DOUBLE POINTS AND AUTOMATIC RESOLUTION, REDUCE DATABLOCKS */
-  bl = bev->first;
-  while (bl) {
-    if (bl->nr) { /* null bevel items come from single points */
-      bool is_cyclic = bl->poly != -1;
-      nr = bl->nr;
-      if (is_cyclic) {
-        bevp1 = bl->bevpoints;
-        bevp0 = bevp1 + (nr - 1);
+  if (bl->nr && bl->dupe_nr) {
+    nr = bl->nr - bl->dupe_nr + 1; /* +1 because vectorbezier sets flag too */
+    blnew = MEM_callocN(sizeof(BevList), "makeBevelList4");
+    memcpy(blnew, bl, sizeof(BevList));
+    blnew->bevpoints = MEM_calloc_arrayN(nr, sizeof(BevPoint), "makeBevelPoints4");
+    if (!blnew->bevpoints) {
+      MEM_freeN(blnew);
+      return bl;
+    }
+    blnew->nr = 0;
+    bevp0 = bl->bevpoints;
+    bevp1 = blnew->bevpoints;
+    nr = bl->nr;
+    while (nr--) {
+      if (bevp0->dupe_tag == 0) {
+        memcpy(bevp1, bevp0, sizeof(BevPoint));
+        bevp1++;
+        blnew->nr++;
+      }
+      bevp0++;
+    }
+    MEM_freeN(bl->bevpoints);
+    MEM_freeN(bl);
+    blnew->dupe_nr = 0;
+    bl = blnew;
+  }
+
+  return bl;
+}
+
+typedef struct BevelListMakeData {
+  const Curve *cu;
+  Nurb **nurbs;
+  const int *resolu;
+  BevList **bevlists;
+  const bool *is_reused;
+  bool need_seglen;
+  int smooth_iter;
+} BevelListMakeData;
+
+static void bevel_list_make_cb(void *__restrict userdata,
+                               const int i,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BevelListMakeData *data = userdata;
+
+  if (!data->is_reused[i]) {
+    data->bevlists[i] = bevel_list_make_nurb(
+        data->cu, data->nurbs[i], data->resolu[i], data->need_seglen);
+  }
+}
+
+static void bevel_list_orient_cb(void *__restrict userdata,
+                                 const int i,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BevelListMakeData *data = userdata;
+  BevList *bl = data->bevlists[i];
+
+  if (data->is_reused[i]) {
+    return;
+  }
+
+  /* STEP 4: 2D-COSINES or 3D ORIENTATION */
+  if (bl->nr < 2) {
+    BevPoint *bevp = bl->bevpoints;
+    unit_qt(bevp->quat);
+  }
+  else if ((data->cu->flag & CU_3D) == 0) {
+    /* 2D Curves */
+    if (bl->nr == 2) { /* 2 pnt, treat separate */
+      make_bevel_list_segment_2D(bl);
+    }
+    else {
+      make_bevel_list_2D(bl);
+    }
+  }
+  else {
+    /* 3D Curves */
+    if (bl->nr == 2) { /* 2 pnt, treat separate */
+      make_bevel_list_segment_3D(bl);
+    }
+    else {
+      make_bevel_list_3D(bl, data->smooth_iter, data->cu->twist_mode);
+    }
+  }
+}
+
+void BKE_curve_bevelList_make(Object *ob, ListBase *nurbs, bool for_render)
+{
+  /*
+   * - convert all curves to polys, with indication of resol and flags for double-vertices
+   * - possibly; do a smart vertice removal (in case Nurb)
+   * - separate in individual blocks with BoundBox
+   * - AutoHole detection
+   *
+   * Splines are converted in parallel, the bevel lists of splines which didn't change
+   * since the previous evaluation are reused (when only the transform of the object changed).
+   */
+
+  /* this function needs an object, because of tflag and upflag */
+  Curve *cu = ob->data;
+  Nurb *nu;
+  BevList *bl;
+  BevPoint *bevp2, *bevp1 = NULL, *bevp0;
+  float min, inp;
+  struct BevelSort *sortdata, *sd, *sd1;
+  int a, b, nr, poly, poly_len, resolu = 0, nurbs_len, points_len = 0;
+  bool is_editmode = false;
+  ListBase *bev, bev_prev;
+
+  /* segbevcount alsp requires seglen. */
+  const bool need_seglen = ELEM(
+                               cu->bevfac1_mapping, CU_BEVFAC_MAP_SEGMENT, CU_BEVFAC_MAP_SPLINE) ||
+                           ELEM(cu->bevfac2_mapping, CU_BEVFAC_MAP_SEGMENT, CU_BEVFAC_MAP_SPLINE);
+
+  bev = &ob->runtime.curve_cache->bev;
+
+  /* Bevel lists of the previous evaluation, to reuse for splines which didn't change. */
+  bev_prev = *bev;
+  BLI_listbase_clear(bev);
+
+  nurbs_len = BLI_listbase_count(nurbs);
+  if (nurbs_len == 0) {
+    BKE_curve_bevelList_free(&bev_prev);
+    return;
+  }
+
+  if (cu->editnurb && ob->type != OB_FONT) {
+    is_editmode = 1;
+  }
+
+  Nurb **nurbs_array = MEM_malloc_arrayN(nurbs_len, sizeof(*nurbs_array), __func__);
+  int *resolu_array = MEM_malloc_arrayN(nurbs_len, sizeof(*resolu_array), __func__);
+  void **sources = MEM_malloc_arrayN(nurbs_len, sizeof(*sources), __func__);
+  size_t *sources_len = MEM_malloc_arrayN(nurbs_len, sizeof(*sources_len), __func__);
+  BevList **bevlists = MEM_calloc_arrayN(nurbs_len, sizeof(*bevlists), __func__);
+  bool *is_reused = MEM_calloc_arrayN(nurbs_len, sizeof(*is_reused), __func__);
+
+  /* Only keep the splines which get a bevel list. */
+  nurbs_len = 0;
+  for (nu = nurbs->first; nu; nu = nu->next) {
+    int nu_resolu = 0;
+
+    if (nu->hide && is_editmode) {
+      continue;
+    }
+
+    if (BKE_nurb_check_valid_u(nu)) {
+      if (for_render && cu->resolu_ren != 0) {
+        nu_resolu = cu->resolu_ren;
       }
       else {
-        bevp0 = bl->bevpoints;
-        bevp0->offset = 0;
-        bevp1 = bevp0 + 1;
+        nu_resolu = nu->resolu;
       }
-      nr--;
-      while (nr--) {
-        if (seglen != NULL) {
-          if (fabsf(bevp1->offset) < treshold) {
-            bevp0->dupe_tag = true;
-            bl->dupe_nr++;
-          }
-        }
-        else {
-          if (fabsf(bevp0->vec[0] - bevp1->vec[0]) < 0.00001f) {
-            if (fabsf(bevp0->vec[1] - bevp1->vec[1]) < 0.00001f) {
-              if (fabsf(bevp0->vec[2] - bevp1->vec[2]) < 0.00001f) {
-                bevp0->dupe_tag = true;
-                bl->dupe_nr++;
-              }
-            }
-          }
-        }
-        bevp0 = bevp1;
-        bevp1++;
+      /* Used for the orientation of all 3D curves, see STEP 4. */
+      resolu = nu_resolu;
+
+      if (!(ELEM(nu->type, CU_POLY, CU_BEZIER) || (nu->type == CU_NURBS && nu->pntsv == 1))) {
+        continue;
       }
+      points_len += (nu->type == CU_POLY) ? nu->pntsu : nu->pntsu * nu_resolu;
     }
-    bl = bl->next;
+
+    nurbs_array[nurbs_len] = nu;
+    resolu_array[nurbs_len] = nu_resolu;
+    nurbs_len++;
   }
-  bl = bev->first;
-  while (bl) {
-    blnext = bl->next;
-    if (bl->nr && bl->dupe_nr) {
-      nr = bl->nr - bl->dupe_nr + 1; /* +1 because vectorbezier sets flag too */
-      blnew = MEM_callocN(sizeof(BevList), "makeBevelList4");
-      memcpy(blnew, bl, sizeof(BevList));
-      blnew->bevpoints = MEM_calloc_arrayN(nr, sizeof(BevPoint), "makeBevelPoints4");
-      if (!blnew->bevpoints) {
-        MEM_freeN(blnew);
-        break;
+
+  BevelListMakeData data = {
+      .cu = cu,
+      .nurbs = nurbs_array,
+      .resolu = resolu_array,
+      .bevlists = bevlists,
+      .is_reused = is_reused,
+      .need_seglen = need_seglen,
+      .smooth_iter = (int)(resolu * cu->twist_smooth),
+  };
+
+  for (a = 0; a < nurbs_len; a++) {
+    sources[a] = bevel_list_nurb_source(
+        cu, nurbs_array[a], resolu_array[a], data.smooth_iter, need_seglen, &sources_len[a]);
+  }
+
+  /* Splines are matched by their position, which doesn't change when only transforming. */
+  bl = bev_prev.first;
+  for (a = 0; a < nurbs_len && bl; a++, bl = bl->next) {
+    if (bl->source_len == sources_len[a] && memcmp(bl->source, sources[a], sources_len[a]) == 0) {
+      bevlists[a] = bl;
+      is_reused[a] = true;
+    }
+  }
+
+  /* In 2D the direction of cyclic splines depends on the other cyclic splines
+   * of the same character (holes, see STEP 3), so they can only be reused together,
+   * when none of them changed, and none were added or removed. */
+  if ((cu->flag & CU_3D) == 0) {
+    GSet *chars_changed = BLI_gset_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+
+    bl = bev_prev.first;
+    for (a = 0; a < nurbs_len || bl; a++, bl = bl ? bl->next : NULL) {
+      if (a < nurbs_len && is_reused[a]) {
+        continue;
       }
-      blnew->segbevcount = bl->segbevcount;
-      blnew->seglen = bl->seglen;
-      blnew->nr = 0;
-      BLI_remlink(bev, bl);
-      BLI_insertlinkbefore(bev, blnext, blnew); /* to make sure bevlijst is tuned with nurblist */
-      bevp0 = bl->bevpoints;
-      bevp1 = blnew->bevpoints;
-      nr = bl->nr;
-      while (nr--) {
-        if (bevp0->dupe_tag == 0) {
-          memcpy(bevp1, bevp0, sizeof(BevPoint));
-          bevp1++;
-          blnew->nr++;
-        }
-        bevp0++;
+      if (a < nurbs_len && (nurbs_array[a]->flagu & CU_NURB_CYCLIC)) {
+        BLI_gset_add(chars_changed, POINTER_FROM_INT(nurbs_array[a]->charidx));
+      }
+      if (bl && bl->poly >= 0) {
+        BLI_gset_add(chars_changed, POINTER_FROM_INT(bl->charidx));
       }
-      if (bl->bevpoints != NULL) {
-        MEM_freeN(bl->bevpoints);
+    }
+    for (a = 0; a < nurbs_len; a++) {
+      nu = nurbs_array[a];
+      if (is_reused[a] && (nu->flagu & CU_NURB_CYCLIC) &&
+          BLI_gset_haskey(chars_changed, POINTER_FROM_INT(nu->charidx))) {
+        bevlists[a] = NULL;
+        is_reused[a] = false;
       }
-      MEM_freeN(bl);
-      blnew->dupe_nr = 0;
     }
-    bl = blnext;
+    BLI_gset_free(chars_changed, NULL);
   }
 
+  for (a = 0; a < nurbs_len; a++) {
+    if (is_reused[a]) {
+      BLI_remlink(&bev_prev, bevlists[a]);
+    }
+  }
+  BKE_curve_bevelList_free(&bev_prev);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (nurbs_len > 1 && points_len > 1024);
+  settings.min_iter_per_thread = 1;
+  settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+
+  /* STEP 1 and 2. */
+  BLI_task_parallel_range(0, nurbs_len, &data, bevel_list_make_cb, &settings);
+
+  nr = 0;
+  for (a = 0; a < nurbs_len; a++) {
+    /* Reused lists keep their source, which is the same. */
+    if (bevlists[a] && !is_reused[a]) {
+      bevlists[a]->source = sources[a];
+      bevlists[a]->source_len = sources_len[a];
+    }
+    else {
+      MEM_freeN(sources[a]);
+    }
+    if (bevlists[a]) {
+      BLI_addtail(bev, bevlists[a]);
+      /* Keep the arrays in sync with the bevel lists. */
+      bevlists[nr] = bevlists[a];
+      is_reused[nr] = is_reused[a];
+      nr++;
+    }
+  }
+  nurbs_len = nr;
+
   /* STEP 3: POLYS COUNT AND AUTOHOLE */
-  bl = bev->first;
   poly = 0;
-  while (bl) {
+  poly_len = 0;
+  for (a = 0; a < nurbs_len; a++) {
+    bl = bevlists[a];
     if (bl->nr && bl->poly >= 0) {
       poly++;
       bl->poly = poly;
-      bl->hole = 0;
+      /* Reused splines keep their direction. */
+      if (!is_reused[a]) {
+        bl->hole = 0;
+        poly_len++;
+      }
     }
-    bl = bl->next;
   }
 
   /* find extreme left points, also test (turning) direction */
-  if (poly > 0) {
-    sd = sortdata = MEM_malloc_arrayN(poly, sizeof(struct BevelSort), "makeBevelList5");
-    bl = bev->first;
-    while (bl) {
-      if (bl->poly > 0) {
+  if (poly_len > 0) {
+    sd = sortdata = MEM_malloc_arrayN(poly_len, sizeof(struct BevelSort), "makeBevelList5");
+    for (a = 0; a < nurbs_len; a++) {
+      bl = bevlists[a];
+      if (bl->poly > 0 && !is_reused[a]) {
         BevPoint *bevp;
 
         min = 300000.0;
@@ -3124,13 +3356,11 @@ void BKE_curve_bevelList_make(Object *ob, ListBase *nurbs, bool for_render)
 
         sd++;
       }
-
-      bl = bl->next;
     }
-    qsort(sortdata, poly, sizeof(struct BevelSort), vergxcobev);
+    qsort(sortdata, poly_len, sizeof(struct BevelSort), vergxcobev);
 
     sd = sortdata + 1;
-    for (a = 1; a < poly; a++, sd++) {
+    for (a = 1; a < poly_len; a++, sd++) {
       bl = sd->bl; /* is bl a hole? */
       sd1 = sortdata + (a - 1);
       for (b = a - 1; b >= 0; b--, sd1--) {    /* all polys to the left */
@@ -3146,7 +3376,7 @@ void BKE_curve_bevelList_make(Object *ob, ListBase *nurbs, bool for_render)
     /* turning direction */
     if ((cu->flag & CU_3D) == 0) {
       sd = sortdata;
-      for (a = 0; a < poly; a++, sd++) {
+      for (a = 0; a < poly_len; a++, sd++) {
         if (sd->bl->hole == sd->dir) {
           bl = sd->bl;
           bevp1 = bl->bevpoints;
@@ -3163,37 +3393,15 @@ void BKE_curve_bevelList_make(Object *ob, ListBase *nurbs, bool for_render)
     MEM_freeN(sortdata);
   }
 
-  /* STEP 4: 2D-COSINES or 3D ORIENTATION */
-  if ((cu->flag & CU_3D) == 0) {
-    /* 2D Curves */
-    for (bl = bev->first; bl; bl = bl->next) {
-      if (bl->nr < 2) {
-        BevPoint *bevp = bl->bevpoints;
-        unit_qt(bevp->quat);
-      }
-      else if (bl->nr == 2) { /* 2 pnt, treat separate */
-        make_bevel_list_segment_2D(bl);
-      }
-      else {
-        make_bevel_list_2D(bl);
-      }
-    }
-  }
-  else {
-    /* 3D Curves */
-    for (bl = bev->first; bl; bl = bl->next) {
-      if (bl->nr < 2) {
-        BevPoint *bevp = bl->bevpoints;
-        unit_qt(bevp->quat);
-      }
-      else if (bl->nr == 2) { /* 2 pnt, treat separate */
-        make_bevel_list_segment_3D(bl);
-      }
-      else {
-        make_bevel_list_3D(bl, (int)(resolu * cu->twist_smooth), cu->twist_mode);
-      }
-    }
-  }
+  /* STEP 4. */
+  BLI_task_parallel_range(0, nurbs_len, &data, bevel_list_orient_cb, &settings);
+
+  MEM_freeN(nurbs_array);
+  MEM_freeN(resolu_array);
+  MEM_freeN(sources);
+  MEM_freeN(sources_len);
+  MEM_freeN(bevlists);
+  MEM_freeN(is_reused);
 }
 
 /* ****************** HANDLES ************** */
@@ -39,6 +39,7 @@
 #include "BLI_scanfill.h"
 #include "BLI_utildefines.h"
 #include "BLI_linklist.h"
+#include "BLI_task.h"
 
 #include "BKE_displist.h"
 #include "BKE_cdderivedmesh.h"
@@ -312,168 +313,216 @@ bool BKE_displist_surfindex_get(DispList *dl, int a, int *b, int *p1, int *p2, i
 /* ICC with the optimization -02 causes crashes. */
 #  pragma intel optimization_level 1
 #endif
-static void curve_to_displist(Curve *cu,
-                              ListBase *nubase,
-                              ListBase *dispbase,
-                              const bool for_render)
+static void curve_nurb_to_displist(Nurb *nu, const int resolu, ListBase *dispbase)
 {
-  Nurb *nu;
   DispList *dl;
   BezTriple *bezt, *prevbezt;
   BPoint *bp;
   float *data;
-  int a, len, resolu;
-  const bool editmode = (!for_render && (cu->editnurb || cu->editfont));
+  int a, len;
+
+  if (nu->type == CU_BEZIER) {
+    /* count */
+    len = 0;
+    a = nu->pntsu - 1;
+    if (nu->flagu & CU_NURB_CYCLIC) {
+      a++;
+    }
 
-  nu = nubase->first;
-  while (nu) {
-    if (nu->hide == 0 || editmode == false) {
-      if (for_render && cu->resolu_ren != 0) {
-        resolu = cu->resolu_ren;
+    prevbezt = nu->bezt;
+    bezt = prevbezt + 1;
+    while (a--) {
+      if (a == 0 && (nu->flagu & CU_NURB_CYCLIC)) {
+        bezt = nu->bezt;
+      }
+
+      if (prevbezt->h2 == HD_VECT && bezt->h1 == HD_VECT) {
+        len++;
       }
       else {
-        resolu = nu->resolu;
+        len += resolu;
       }
 
-      if (!BKE_nurb_check_valid_u(nu)) {
-        /* pass */
+      if (a == 0 && (nu->flagu & CU_NURB_CYCLIC) == 0) {
+        len++;
       }
-      else if (nu->type == CU_BEZIER) {
-        /* count */
-        len = 0;
-        a = nu->pntsu - 1;
-        if (nu->flagu & CU_NURB_CYCLIC) {
-          a++;
-        }
 
-        prevbezt = nu->bezt;
-        bezt = prevbezt + 1;
-        while (a--) {
-          if (a == 0 && (nu->flagu & CU_NURB_CYCLIC)) {
-            bezt = nu->bezt;
-          }
+      prevbezt = bezt;
+      bezt++;
+    }
 
-          if (prevbezt->h2 == HD_VECT && bezt->h1 == HD_VECT) {
-            len++;
-          }
-          else {
-            len += resolu;
-          }
+    dl = MEM_callocN(sizeof(DispList), "makeDispListbez");
+    /* len+1 because of 'forward_diff_bezier' function */
+    dl->verts = MEM_mallocN((len + 1) * sizeof(float[3]), "dlverts");
+    BLI_addtail(dispbase, dl);
+    dl->parts = 1;
+    dl->nr = len;
+    dl->col = nu->mat_nr;
+    dl->charidx = nu->charidx;
+
+    data = dl->verts;
+
+    /* check that (len != 2) so we don't immediately loop back on ourselves */
+    if (nu->flagu & CU_NURB_CYCLIC && (dl->nr != 2)) {
+      dl->type = DL_POLY;
+      a = nu->pntsu;
+    }
+    else {
+      dl->type = DL_SEGM;
+      a = nu->pntsu - 1;
+    }
 
-          if (a == 0 && (nu->flagu & CU_NURB_CYCLIC) == 0) {
-            len++;
-          }
+    prevbezt = nu->bezt;
+    bezt = prevbezt + 1;
+
+    while (a--) {
+      if (a == 0 && dl->type == DL_POLY) {
+        bezt = nu->bezt;
+      }
 
-          prevbezt = bezt;
-          bezt++;
+      if (prevbezt->h2 == HD_VECT && bezt->h1 == HD_VECT) {
+        copy_v3_v3(data, prevbezt->vec[1]);
+        data += 3;
+      }
+      else {
+        int j;
+        for (j = 0; j < 3; j++) {
+          BKE_curve_forward_diff_bezier(prevbezt->vec[1][j],
+                                        prevbezt->vec[2][j],
+                                        bezt->vec[0][j],
+                                        bezt->vec[1][j],
+                                        data + j,
+                                        resolu,
+                                        3 * sizeof(float));
         }
 
-        dl = MEM_callocN(sizeof(DispList), "makeDispListbez");
-        /* len+1 because of 'forward_diff_bezier' function */
-        dl->verts = MEM_mallocN((len + 1) * sizeof(float[3]), "dlverts");
-        BLI_addtail(dispbase, dl);
-        dl->parts = 1;
-        dl->nr = len;
-        dl->col = nu->mat_nr;
-        dl->charidx = nu->charidx;
+        data += 3 * resolu;
+      }
 
-        data = dl->verts;
+      if (a == 0 && dl->type == DL_SEGM) {
+        copy_v3_v3(data, bezt->vec[1]);
+      }
 
-        /* check that (len != 2) so we don't immediately loop back on ourselves */
-        if (nu->flagu & CU_NURB_CYCLIC && (dl->nr != 2)) {
-          dl->type = DL_POLY;
-          a = nu->pntsu;
-        }
-        else {
-          dl->type = DL_SEGM;
-          a = nu->pntsu - 1;
-        }
+      prevbezt = bezt;
+      bezt++;
+    }
+  }
+  else if (nu->type == CU_NURBS) {
+    len = (resolu * SEGMENTSU(nu));
 
-        prevbezt = nu->bezt;
-        bezt = prevbezt + 1;
+    dl = MEM_callocN(sizeof(DispList), "makeDispListsurf");
+    dl->verts = MEM_mallocN(len * sizeof(float[3]), "dlverts");
+    BLI_addtail(dispbase, dl);
+    dl->parts = 1;
 
-        while (a--) {
-          if (a == 0 && dl->type == DL_POLY) {
-            bezt = nu->bezt;
-          }
+    dl->nr = len;
+    dl->col = nu->mat_nr;
+    dl->charidx = nu->charidx;
 
-          if (prevbezt->h2 == HD_VECT && bezt->h1 == HD_VECT) {
-            copy_v3_v3(data, prevbezt->vec[1]);
-            data += 3;
-          }
-          else {
-            int j;
-            for (j = 0; j < 3; j++) {
-              BKE_curve_forward_diff_bezier(prevbezt->vec[1][j],
-                                            prevbezt->vec[2][j],
-                                            bezt->vec[0][j],
-                                            bezt->vec[1][j],
-                                            data + j,
-                                            resolu,
-                                            3 * sizeof(float));
-            }
+    data = dl->verts;
+    if (nu->flagu & CU_NURB_CYCLIC) {
+      dl->type = DL_POLY;
+    }
+    else {
+      dl->type = DL_SEGM;
+    }
+    BKE_nurb_makeCurve(nu, data, NULL, NULL, NULL, resolu, 3 * sizeof(float));
+  }
+  else if (nu->type == CU_POLY) {
+    len = nu->pntsu;
+    dl = MEM_callocN(sizeof(DispList), "makeDispListpoly");
+    dl->verts = MEM_mallocN(len * sizeof(float[3]), "dlverts");
+    BLI_addtail(dispbase, dl);
+    dl->parts = 1;
+    dl->nr = len;
+    dl->col = nu->mat_nr;
+    dl->charidx = nu->charidx;
+
+    data = dl->verts;
+    if ((nu->flagu & CU_NURB_CYCLIC) && (dl->nr != 2)) {
+      dl->type = DL_POLY;
+    }
+    else {
+      dl->type = DL_SEGM;
+    }
 
-            data += 3 * resolu;
-          }
+    a = len;
+    bp = nu->bp;
+    while (a--) {
+      copy_v3_v3(data, bp->vec);
+      bp++;
+      data += 3;
+    }
+  }
+}
 
-          if (a == 0 && dl->type == DL_SEGM) {
-            copy_v3_v3(data, bezt->vec[1]);
-          }
+typedef struct CurveToDispListData {
+  Nurb **nurbs;
+  const int *resolu;
+  ListBase *dispbases;
+} CurveToDispListData;
 
-          prevbezt = bezt;
-          bezt++;
-        }
-      }
-      else if (nu->type == CU_NURBS) {
-        len = (resolu * SEGMENTSU(nu));
+static void curve_to_displist_cb(void *__restrict userdata,
+                                 const int i,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CurveToDispListData *data = userdata;
 
-        dl = MEM_callocN(sizeof(DispList), "makeDispListsurf");
-        dl->verts = MEM_mallocN(len * sizeof(float[3]), "dlverts");
-        BLI_addtail(dispbase, dl);
-        dl->parts = 1;
+  curve_nurb_to_displist(data->nurbs[i], data->resolu[i], &data->dispbases[i]);
+}
 
-        dl->nr = len;
-        dl->col = nu->mat_nr;
-        dl->charidx = nu->charidx;
+static void curve_to_displist(Curve *cu,
+                              ListBase *nubase,
+                              ListBase *dispbase,
+                              const bool for_render)
+{
+  Nurb *nu;
+  int a, nurbs_len = 0, points_len = 0;
+  const bool editmode = (!for_render && (cu->editnurb || cu->editfont));
+  const int nubase_len = BLI_listbase_count(nubase);
 
-        data = dl->verts;
-        if (nu->flagu & CU_NURB_CYCLIC) {
-          dl->type = DL_POLY;
-        }
-        else {
-          dl->type = DL_SEGM;
-        }
-        BKE_nurb_makeCurve(nu, data, NULL, NULL, NULL, resolu, 3 * sizeof(float));
-      }
-      else if (nu->type == CU_POLY) {
-        len = nu->pntsu;
-        dl = MEM_callocN(sizeof(DispList), "makeDispListpoly");
-        dl->verts = MEM_mallocN(len * sizeof(float[3]), "dlverts");
-        BLI_addtail(dispbase, dl);
-        dl->parts = 1;
-        dl->nr = len;
-        dl->col = nu->mat_nr;
-        dl->charidx = nu->charidx;
+  if (nubase_len == 0) {
+    return;
+  }
 
-        data = dl->verts;
-        if ((nu->flagu & CU_NURB_CYCLIC) && (dl->nr != 2)) {
-          dl->type = DL_POLY;
-        }
-        else {
-          dl->type = DL_SEGM;
-        }
+  Nurb **nurbs = MEM_malloc_arrayN(nubase_len, sizeof(*nurbs), __func__);
+  int *resolu = MEM_malloc_arrayN(nubase_len, sizeof(*resolu), __func__);
 
-        a = len;
-        bp = nu->bp;
-        while (a--) {
-          copy_v3_v3(data, bp->vec);
-          bp++;
-          data += 3;
-        }
+  for (nu = nubase->first; nu; nu = nu->next) {
+    if ((nu->hide == 0 || editmode == false) && BKE_nurb_check_valid_u(nu)) {
+      nurbs[nurbs_len] = nu;
+      if (for_render && cu->resolu_ren != 0) {
+        resolu[nurbs_len] = cu->resolu_ren;
+      }
+      else {
+        resolu[nurbs_len] = nu->resolu;
       }
+      points_len += nu->pntsu * resolu[nurbs_len];
+      nurbs_len++;
     }
-    nu = nu->next;
   }
+
+  /* Each spline is converted into its own list, these are joined in order afterwards. */
+  CurveToDispListData data = {
+      .nurbs = nurbs,
+      .resolu = resolu,
+      .dispbases = MEM_calloc_arrayN(nurbs_len, sizeof(ListBase), __func__),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (nurbs_len > 1 && points_len > 1024);
+  settings.min_iter_per_thread = 1;
+  settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+  BLI_task_parallel_range(0, nurbs_len, &data, curve_to_displist_cb, &settings);
+
+  for (a = 0; a < nurbs_len; a++) {
+    BLI_movelisttolist(dispbase, &data.dispbases[a]);
+  }
+
+  MEM_freeN(data.dispbases);
+  MEM_freeN(nurbs);
+  MEM_freeN(resolu);
 }
 
 /**
@@ -1187,6 +1236,102 @@ static void displist_surf_indices(DispList *dl)
   }
 }
 
+static void surf_nurb_to_displist(Nurb *nu,
+                                  const int resolu,
+                                  const int resolv,
+                                  ListBase *dispbase)
+{
+  DispList *dl;
+  float *data;
+  int len;
+
+  if (nu->pntsv == 1) {
+    len = SEGMENTSU(nu) * resolu;
+
+    dl = MEM_callocN(sizeof(DispList), "makeDispListsurf");
+    dl->verts = MEM_mallocN(len * sizeof(float[3]), "dlverts");
+
+    BLI_addtail(dispbase, dl);
+    dl->parts = 1;
+    dl->nr = len;
+    dl->col = nu->mat_nr;
+    dl->charidx = nu->charidx;
+
+    /* dl->rt will be used as flag for render face and */
+    /* CU_2D conflicts with R_NOPUNOFLIP */
+    dl->rt = nu->flag & ~CU_2D;
+
+    data = dl->verts;
+    if (nu->flagu & CU_NURB_CYCLIC) {
+      dl->type = DL_POLY;
+    }
+    else {
+      dl->type = DL_SEGM;
+    }
+
+    BKE_nurb_makeCurve(nu, data, NULL, NULL, NULL, resolu, 3 * sizeof(float));
+  }
+  else {
+    len = (nu->pntsu * resolu) * (nu->pntsv * resolv);
+
+    dl = MEM_callocN(sizeof(DispList), "makeDispListsurf");
+    dl->verts = MEM_mallocN(len * sizeof(float[3]), "dlverts");
+    BLI_addtail(dispbase, dl);
+
+    dl->col = nu->mat_nr;
+    dl->charidx = nu->charidx;
+
+    /* dl->rt will be used as flag for render face and */
+    /* CU_2D conflicts with R_NOPUNOFLIP */
+    dl->rt = nu->flag & ~CU_2D;
+
+    data = dl->verts;
+    dl->type = DL_SURF;
+
+    dl->parts = (nu->pntsu * resolu); /* in reverse, because makeNurbfaces works that way */
+    dl->nr = (nu->pntsv * resolv);
+    if (nu->flagv & CU_NURB_CYCLIC) {
+      dl->flag |= DL_CYCL_U; /* reverse too! */
+    }
+    if (nu->flagu & CU_NURB_CYCLIC) {
+      dl->flag |= DL_CYCL_V;
+    }
+
+    BKE_nurb_makeFaces(nu, data, 0, resolu, resolv);
+
+    /* gl array drawing: using indices */
+    displist_surf_indices(dl);
+  }
+}
+
+typedef struct SurfToDispListData {
+  Curve *cu;
+  Nurb **nurbs;
+  ListBase *dispbases;
+  bool for_render;
+} SurfToDispListData;
+
+static void surf_to_displist_cb(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SurfToDispListData *data = userdata;
+  const Curve *cu = data->cu;
+  Nurb *nu = data->nurbs[i];
+  int resolu = nu->resolu, resolv = nu->resolv;
+
+  if (data->for_render) {
+    if (cu->resolu_ren) {
+      resolu = cu->resolu_ren;
+    }
+    if (cu->resolv_ren) {
+      resolv = cu->resolv_ren;
+    }
+  }
+
+  surf_nurb_to_displist(nu, resolu, resolv, &data->dispbases[i]);
+}
+
 void BKE_displist_make_surf(Depsgraph *depsgraph,
                             Scene *scene,
                             Object *ob,
@@ -1198,9 +1343,7 @@ void BKE_displist_make_surf(Depsgraph *depsgraph,
   ListBase nubase = {NULL, NULL};
   Nurb *nu;
   Curve *cu = ob->data;
-  DispList *dl;
-  float *data;
-  int len;
+  int a, nurbs_len = 0, points_len = 0;
 
   if (!for_render && cu->editnurb) {
     BKE_nurbList_duplicate(&nubase, BKE_curve_editNurbs_get(cu));
@@ -1213,79 +1356,37 @@ void BKE_displist_make_surf(Depsgraph *depsgraph,
     curve_calc_modifiers_pre(depsgraph, scene, ob, &nubase, for_render);
   }
 
+  Nurb **nurbs = MEM_malloc_arrayN(BLI_listbase_count(&nubase), sizeof(*nurbs), __func__);
+
   for (nu = nubase.first; nu; nu = nu->next) {
     if ((for_render || nu->hide == 0) && BKE_nurb_check_valid_uv(nu)) {
-      int resolu = nu->resolu, resolv = nu->resolv;
-
-      if (for_render) {
-        if (cu->resolu_ren) {
-          resolu = cu->resolu_ren;
-        }
-        if (cu->resolv_ren) {
-          resolv = cu->resolv_ren;
-        }
-      }
-
-      if (nu->pntsv == 1) {
-        len = SEGMENTSU(nu) * resolu;
-
-        dl = MEM_callocN(sizeof(DispList), "makeDispListsurf");
-        dl->verts = MEM_mallocN(len * sizeof(float[3]), "dlverts");
-
-        BLI_addtail(dispbase, dl);
-        dl->parts = 1;
-        dl->nr = len;
-        dl->col = nu->mat_nr;
-        dl->charidx = nu->charidx;
-
-        /* dl->rt will be used as flag for render face and */
-        /* CU_2D conflicts with R_NOPUNOFLIP */
-        dl->rt = nu->flag & ~CU_2D;
-
-        data = dl->verts;
-        if (nu->flagu & CU_NURB_CYCLIC) {
-          dl->type = DL_POLY;
-        }
-        else {
-          dl->type = DL_SEGM;
-        }
-
-        BKE_nurb_makeCurve(nu, data, NULL, NULL, NULL, resolu, 3 * sizeof(float));
-      }
-      else {
-        len = (nu->pntsu * resolu) * (nu->pntsv * resolv);
-
-        dl = MEM_callocN(sizeof(DispList), "makeDispListsurf");
-        dl->verts = MEM_mallocN(len * sizeof(float[3]), "dlverts");
-        BLI_addtail(dispbase, dl);
-
-        dl->col = nu->mat_nr;
-        dl->charidx = nu->charidx;
-
-        /* dl->rt will be used as flag for render face and */
-        /* CU_2D conflicts with R_NOPUNOFLIP */
-        dl->rt = nu->flag & ~CU_2D;
-
-        data = dl->verts;
-        dl->type = DL_SURF;
+      nurbs[nurbs_len++] = nu;
+      points_len += nu->pntsu * nu->resolu * nu->pntsv * nu->resolv;
+    }
+  }
 
-        dl->parts = (nu->pntsu * resolu); /* in reverse, because makeNurbfaces works that way */
-        dl->nr = (nu->pntsv * resolv);
-        if (nu->flagv & CU_NURB_CYCLIC) {
-          dl->flag |= DL_CYCL_U; /* reverse too! */
-        }
-        if (nu->flagu & CU_NURB_CYCLIC) {
-          dl->flag |= DL_CYCL_V;
-        }
+  /* Each surface is converted into its own list, these are joined in order afterwards. */
+  SurfToDispListData data = {
+      .cu = cu,
+      .nurbs = nurbs,
+      .dispbases = MEM_calloc_arrayN(nurbs_len, sizeof(ListBase), __func__),
+      .for_render = for_render,
+  };
 
-        BKE_nurb_makeFaces(nu, data, 0, resolu, resolv);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (nurbs_len > 1 && points_len > 1024);
+  settings.min_iter_per_thread = 1;
+  settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+  BLI_task_parallel_range(0, nurbs_len, &data, surf_to_displist_cb, &settings);
 
-        /* gl array drawing: using indices */
-        displist_surf_indices(dl);
-      }
-    }
+  for (a = 0; a < nurbs_len; a++) {
+    BLI_movelisttolist(dispbase, &data.dispbases[a]);
   }
 
+  MEM_freeN(data.dispbases);
+  MEM_freeN(nurbs);
+
   if (!for_orco) {
     BKE_nurbList_duplicate(&ob->runtime.curve_cache->deformed_nurbs, &nubase);
     curve_calc_modifiers_post(depsgraph, scene, ob, &nubase, dispbase, r_final, for_render);
@@ -1515,6 +1616,219 @@ static void calc_bevfac_mapping(Curve *cu,
   }
 }
 
+static void curve_bevel_nurb_to_displist(Depsgraph *depsgraph,
+                                         Scene *scene,
+                                         Curve *cu,
+                                         BevList *bl,
+                                         Nurb *nu,
+                                         const ListBase *dlbev,
+                                         const float widfac,
+                                         ListBase *dispbase)
+{
+  DispList *dl;
+  float *data;
+  int a;
+
+  if (bl->nr) { /* blank bevel lists can happen */
+
+    /* exception handling; curve without bevel or extrude, with width correction */
+    if (BLI_listbase_is_empty(dlbev)) {
+      BevPoint *bevp;
+      dl = MEM_callocN(sizeof(DispList), "makeDispListbev");
+      dl->verts = MEM_mallocN(sizeof(float[3]) * bl->nr, "dlverts");
+      BLI_addtail(dispbase, dl);
+
+      if (bl->poly != -1) {
+        dl->type = DL_POLY;
+      }
+      else {
+        dl->type = DL_SEGM;
+      }
+
+      if (dl->type == DL_SEGM) {
+        dl->flag = (DL_FRONT_CURVE | DL_BACK_CURVE);
+      }
+
+      dl->parts = 1;
+      dl->nr = bl->nr;
+      dl->col = nu->mat_nr;
+      dl->charidx = nu->charidx;
+
+      /* dl->rt will be used as flag for render face and */
+      /* CU_2D conflicts with R_NOPUNOFLIP */
+      dl->rt = nu->flag & ~CU_2D;
+
+      a = dl->nr;
+      bevp = bl->bevpoints;
+      data = dl->verts;
+      while (a--) {
+        data[0] = bevp->vec[0] + widfac * bevp->sina;
+        data[1] = bevp->vec[1] + widfac * bevp->cosa;
+        data[2] = bevp->vec[2];
+        bevp++;
+        data += 3;
+      }
+    }
+    else {
+      DispList *dlb;
+      ListBase bottom_capbase = {NULL, NULL};
+      ListBase top_capbase = {NULL, NULL};
+      float bottom_no[3] = {0.0f};
+      float top_no[3] = {0.0f};
+      float firstblend = 0.0f, lastblend = 0.0f;
+      int i, start, steps = 0;
+
+      if (nu->flagu & CU_NURB_CYCLIC) {
+        calc_bevfac_mapping_default(bl, &start, &firstblend, &steps, &lastblend);
+      }
+      else {
+        if (fabsf(cu->bevfac2 - cu->bevfac1) < FLT_EPSILON) {
+          return;
+        }
+
+        calc_bevfac_mapping(cu, bl, nu, &start, &firstblend, &steps, &lastblend);
+      }
+
+      for (dlb = dlbev->first; dlb; dlb = dlb->next) {
+        BevPoint *bevp_first, *bevp_last;
+        BevPoint *bevp;
+
+        /* for each part of the bevel use a separate displblock */
+        dl = MEM_callocN(sizeof(DispList), "makeDispListbev1");
+        dl->verts = data = MEM_mallocN(sizeof(float[3]) * dlb->nr * steps, "dlverts");
+        BLI_addtail(dispbase, dl);
+
+        dl->type = DL_SURF;
+
+        dl->flag = dlb->flag & (DL_FRONT_CURVE | DL_BACK_CURVE);
+        if (dlb->type == DL_POLY) {
+          dl->flag |= DL_CYCL_U;
+        }
+        if ((bl->poly >= 0) && (steps > 2)) {
+          dl->flag |= DL_CYCL_V;
+        }
+
+        dl->parts = steps;
+        dl->nr = dlb->nr;
+        dl->col = nu->mat_nr;
+        dl->charidx = nu->charidx;
+
+        /* dl->rt will be used as flag for render face and */
+        /* CU_2D conflicts with R_NOPUNOFLIP */
+        dl->rt = nu->flag & ~CU_2D;
+
+        dl->bevel_split = BLI_BITMAP_NEW(steps, "bevel_split");
+
+        /* for each point of poly make a bevel piece */
+        bevp_first = bl->bevpoints;
+        bevp_last = &bl->bevpoints[bl->nr - 1];
+        bevp = &bl->bevpoints[start];
+        for (i = start, a = 0; a < steps; i++, bevp++, a++) {
+          float fac = 1.0;
+          float *cur_data = data;
+
+          if (cu->taperobj == NULL) {
+            fac = bevp->radius;
+          }
+          else {
+            float len, taper_fac;
+
+            if (cu->flag & CU_MAP_TAPER) {
+              len = (steps - 3) + firstblend + lastblend;
+
+              if (a == 0) {
+                taper_fac = 0.0f;
+              }
+              else if (a == steps - 1) {
+                taper_fac = 1.0f;
+              }
+              else {
+                taper_fac = ((float)a - (1.0f - firstblend)) / len;
+              }
+            }
+            else {
+              len = bl->nr - 1;
+              taper_fac = (float)i / len;
+
+              if (a == 0) {
+                taper_fac += (1.0f - firstblend) / len;
+              }
+              else if (a == steps - 1) {
+                taper_fac -= (1.0f - lastblend) / len;
+              }
+            }
+
+            fac = displist_calc_taper(depsgraph, scene, cu->taperobj, taper_fac);
+          }
+
+          if (bevp->split_tag) {
+            BLI_BITMAP_ENABLE(dl->bevel_split, a);
+          }
+
+          /* rotate bevel piece and write in data */
+          if ((a == 0) && (bevp != bevp_last)) {
+            rotateBevelPiece(cu, bevp, bevp + 1, dlb, 1.0f - firstblend, widfac, fac, &data);
+          }
+          else if ((a == steps - 1) && (bevp != bevp_first)) {
+            rotateBevelPiece(cu, bevp, bevp - 1, dlb, 1.0f - lastblend, widfac, fac, &data);
+          }
+          else {
+            rotateBevelPiece(cu, bevp, NULL, dlb, 0.0f, widfac, fac, &data);
+          }
+
+          if (cu->bevobj && (cu->flag & CU_FILL_CAPS) && !(nu->flagu & CU_NURB_CYCLIC)) {
+            if (a == 1) {
+              fillBevelCap(nu, dlb, cur_data - 3 * dlb->nr, &bottom_capbase);
+              copy_v3_v3(bottom_no, bevp->dir);
+            }
+            if (a == steps - 1) {
+              fillBevelCap(nu, dlb, cur_data, &top_capbase);
+              negate_v3_v3(top_no, bevp->dir);
+            }
+          }
+        }
+
+        /* gl array drawing: using indices */
+        displist_surf_indices(dl);
+      }
+
+      if (bottom_capbase.first) {
+        BKE_displist_fill(&bottom_capbase, dispbase, bottom_no, false);
+        BKE_displist_fill(&top_capbase, dispbase, top_no, false);
+        BKE_displist_free(&bottom_capbase);
+        BKE_displist_free(&top_capbase);
+      }
+    }
+  }
+}
+
+typedef struct CurveBevelToDispListData {
+  Depsgraph *depsgraph;
+  Scene *scene;
+  Curve *cu;
+  BevList **bevlists;
+  Nurb **nurbs;
+  const ListBase *dlbev;
+  float widfac;
+  ListBase *dispbases;
+} CurveBevelToDispListData;
+
+static void curve_bevel_to_displist_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CurveBevelToDispListData *data = userdata;
+
+  curve_bevel_nurb_to_displist(data->depsgraph,
+                               data->scene,
+                               data->cu,
+                               data->bevlists[i],
+                               data->nurbs[i],
+                               data->dlbev,
+                               data->widfac,
+                               &data->dispbases[i]);
+}
+
 static void do_makeDispListCurveTypes(Depsgraph *depsgraph,
                                       Scene *scene,
                                       Object *ob,
@@ -1537,8 +1851,6 @@ static void do_makeDispListCurveTypes(Depsgraph *depsgraph,
     ListBase dlbev;
     ListBase nubase = {NULL, NULL};
 
-    BKE_curve_bevelList_free(&ob->runtime.curve_cache->bev);
-
     /* We only re-evaluate path if evaluation is not happening for orco.
      * If the calculation happens for orco, we should never free data which
      * was needed before and only not needed for orco calculation.
@@ -1571,187 +1883,61 @@ static void do_makeDispListCurveTypes(Depsgraph *depsgraph,
       curve_to_displist(cu, &nubase, dispbase, for_render);
     }
     else {
-      float widfac = cu->width - 1.0f;
-      BevList *bl = ob->runtime.curve_cache->bev.first;
-      Nurb *nu = nubase.first;
-
-      for (; bl && nu; bl = bl->next, nu = nu->next) {
-        DispList *dl;
-        float *data;
-        int a;
-
-        if (bl->nr) { /* blank bevel lists can happen */
-
-          /* exception handling; curve without bevel or extrude, with width correction */
-          if (BLI_listbase_is_empty(&dlbev)) {
-            BevPoint *bevp;
-            dl = MEM_callocN(sizeof(DispList), "makeDispListbev");
-            dl->verts = MEM_mallocN(sizeof(float[3]) * bl->nr, "dlverts");
-            BLI_addtail(dispbase, dl);
-
-            if (bl->poly != -1) {
-              dl->type = DL_POLY;
-            }
-            else {
-              dl->type = DL_SEGM;
-            }
-
-            if (dl->type == DL_SEGM) {
-              dl->flag = (DL_FRONT_CURVE | DL_BACK_CURVE);
-            }
-
-            dl->parts = 1;
-            dl->nr = bl->nr;
-            dl->col = nu->mat_nr;
-            dl->charidx = nu->charidx;
-
-            /* dl->rt will be used as flag for render face and */
-            /* CU_2D conflicts with R_NOPUNOFLIP */
-            dl->rt = nu->flag & ~CU_2D;
-
-            a = dl->nr;
-            bevp = bl->bevpoints;
-            data = dl->verts;
-            while (a--) {
-              data[0] = bevp->vec[0] + widfac * bevp->sina;
-              data[1] = bevp->vec[1] + widfac * bevp->cosa;
-              data[2] = bevp->vec[2];
-              bevp++;
-              data += 3;
-            }
-          }
-          else {
-            DispList *dlb;
-            ListBase bottom_capbase = {NULL, NULL};
-            ListBase top_capbase = {NULL, NULL};
-            float bottom_no[3] = {0.0f};
-            float top_no[3] = {0.0f};
-            float firstblend = 0.0f, lastblend = 0.0f;
-            int i, start, steps = 0;
-
-            if (nu->flagu & CU_NURB_CYCLIC) {
-              calc_bevfac_mapping_default(bl, &start, &firstblend, &steps, &lastblend);
-            }
-            else {
-              if (fabsf(cu->bevfac2 - cu->bevfac1) < FLT_EPSILON) {
-                continue;
-              }
-
-              calc_bevfac_mapping(cu, bl, nu, &start, &firstblend, &steps, &lastblend);
-            }
-
-            for (dlb = dlbev.first; dlb; dlb = dlb->next) {
-              BevPoint *bevp_first, *bevp_last;
-              BevPoint *bevp;
-
-              /* for each part of the bevel use a separate displblock */
-              dl = MEM_callocN(sizeof(DispList), "makeDispListbev1");
-              dl->verts = data = MEM_mallocN(sizeof(float[3]) * dlb->nr * steps, "dlverts");
-              BLI_addtail(dispbase, dl);
-
-              dl->type = DL_SURF;
-
-              dl->flag = dlb->flag & (DL_FRONT_CURVE | DL_BACK_CURVE);
-              if (dlb->type == DL_POLY) {
-                dl->flag |= DL_CYCL_U;
-              }
-              if ((bl->poly >= 0) && (steps > 2)) {
-                dl->flag |= DL_CYCL_V;
-              }
-
-              dl->parts = steps;
-              dl->nr = dlb->nr;
-              dl->col = nu->mat_nr;
-              dl->charidx = nu->charidx;
-
-              /* dl->rt will be used as flag for render face and */
-              /* CU_2D conflicts with R_NOPUNOFLIP */
-              dl->rt = nu->flag & ~CU_2D;
-
-              dl->bevel_split = BLI_BITMAP_NEW(steps, "bevel_split");
-
-              /* for each point of poly make a bevel piece */
-              bevp_first = bl->bevpoints;
-              bevp_last = &bl->bevpoints[bl->nr - 1];
-              bevp = &bl->bevpoints[start];
-              for (i = start, a = 0; a < steps; i++, bevp++, a++) {
-                float fac = 1.0;
-                float *cur_data = data;
-
-                if (cu->taperobj == NULL) {
-                  fac = bevp->radius;
-                }
-                else {
-                  float len, taper_fac;
-
-                  if (cu->flag & CU_MAP_TAPER) {
-                    len = (steps - 3) + firstblend + lastblend;
-
-                    if (a == 0) {
-                      taper_fac = 0.0f;
-                    }
-                    else if (a == steps - 1) {
-                      taper_fac = 1.0f;
-                    }
-                    else {
-                      taper_fac = ((float)a - (1.0f - firstblend)) / len;
-                    }
-                  }
-                  else {
-                    len = bl->nr - 1;
-                    taper_fac = (float)i / len;
-
-                    if (a == 0) {
-                      taper_fac += (1.0f - firstblend) / len;
-                    }
-                    else if (a == steps - 1) {
-                      taper_fac -= (1.0f - lastblend) / len;
-                    }
-                  }
-
-                  fac = displist_calc_taper(depsgraph, scene, cu->taperobj, taper_fac);
-                }
-
-                if (bevp->split_tag) {
-                  BLI_BITMAP_ENABLE(dl->bevel_split, a);
-                }
-
-                /* rotate bevel piece and write in data */
-                if ((a == 0) && (bevp != bevp_last)) {
-                  rotateBevelPiece(cu, bevp, bevp + 1, dlb, 1.0f - firstblend, widfac, fac, &data);
-                }
-                else if ((a == steps - 1) && (bevp != bevp_first)) {
-                  rotateBevelPiece(cu, bevp, bevp - 1, dlb, 1.0f - lastblend, widfac, fac, &data);
-                }
-                else {
-                  rotateBevelPiece(cu, bevp, NULL, dlb, 0.0f, widfac, fac, &data);
-                }
-
-                if (cu->bevobj && (cu->flag & CU_FILL_CAPS) && !(nu->flagu & CU_NURB_CYCLIC)) {
-                  if (a == 1) {
-                    fillBevelCap(nu, dlb, cur_data - 3 * dlb->nr, &bottom_capbase);
-                    copy_v3_v3(bottom_no, bevp->dir);
-                  }
-                  if (a == steps - 1) {
-                    fillBevelCap(nu, dlb, cur_data, &top_capbase);
-                    negate_v3_v3(top_no, bevp->dir);
-                  }
-                }
-              }
+      const float widfac = cu->width - 1.0f;
+      ListBase *bev = &ob->runtime.curve_cache->bev;
+      BevList *bl;
+      Nurb *nu;
+      DispList *dlb;
+      int a, splines_len = 0, points_len = 0, bevel_len = 0;
+
+      const int splines_max = min_ii(BLI_listbase_count(bev), BLI_listbase_count(&nubase));
+      BevList **bevlists = MEM_malloc_arrayN(splines_max, sizeof(*bevlists), __func__);
+      Nurb **nurbs = MEM_malloc_arrayN(splines_max, sizeof(*nurbs), __func__);
+
+      for (dlb = dlbev.first; dlb; dlb = dlb->next) {
+        bevel_len += dlb->nr;
+      }
+      for (bl = bev->first, nu = nubase.first; bl && nu; bl = bl->next, nu = nu->next) {
+        bevlists[splines_len] = bl;
+        nurbs[splines_len] = nu;
+        points_len += bl->nr * max_ii(bevel_len, 1);
+        splines_len++;
+      }
 
-              /* gl array drawing: using indices */
-              displist_surf_indices(dl);
-            }
+      bool use_threading = (splines_len > 1 && points_len > 1024);
+      if (cu->taperobj && cu->taperobj->type == OB_CURVE) {
+        /* The taper curve is evaluated on first use, make sure that doesn't happen in threads.
+         * Without geometry it would be evaluated again on every use. */
+        displist_calc_taper(depsgraph, scene, cu->taperobj, 0.0f);
+        use_threading &= (cu->taperobj->runtime.curve_cache->disp.first != NULL);
+      }
 
-            if (bottom_capbase.first) {
-              BKE_displist_fill(&bottom_capbase, dispbase, bottom_no, false);
-              BKE_displist_fill(&top_capbase, dispbase, top_no, false);
-              BKE_displist_free(&bottom_capbase);
-              BKE_displist_free(&top_capbase);
-            }
-          }
-        }
+      /* Each spline is converted into its own list, these are joined in order afterwards. */
+      CurveBevelToDispListData data = {
+          .depsgraph = depsgraph,
+          .scene = scene,
+          .cu = cu,
+          .bevlists = bevlists,
+          .nurbs = nurbs,
+          .dlbev = &dlbev,
+          .widfac = widfac,
+          .dispbases = MEM_calloc_arrayN(splines_len, sizeof(ListBase), __func__),
+      };
+
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = use_threading;
+      settings.min_iter_per_thread = 1;
+      settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+      BLI_task_parallel_range(0, splines_len, &data, curve_bevel_to_displist_cb, &settings);
+
+      for (a = 0; a < splines_len; a++) {
+        BLI_movelisttolist(dispbase, &data.dispbases[a]);
       }
+
+      MEM_freeN(data.dispbases);
+      MEM_freeN(bevlists);
+      MEM_freeN(nurbs);
       BKE_displist_free(&dlbev);
     }
 
@@ -1791,11 +1977,19 @@ void BKE_displist_make_curveTypes(
     return;
   }
 
+  /* Keep the bevel lists of the previous evaluation, to reuse for splines which didn't change. */
+  ListBase bev_prev = {NULL, NULL};
+  if (ob->runtime.curve_cache) {
+    bev_prev = ob->runtime.curve_cache->bev;
+    BLI_listbase_clear(&ob->runtime.curve_cache->bev);
+  }
+
   BKE_object_free_derived_caches(ob);
 
   if (!ob->runtime.curve_cache) {
     ob->runtime.curve_cache = MEM_callocN(sizeof(CurveCache), "CurveCache for curve types");
   }
+  ob->runtime.curve_cache->bev = bev_prev;
 
   dispbase = &(ob->runtime.curve_cache->disp);
 
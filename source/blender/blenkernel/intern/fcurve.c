@@ -74,6 +74,10 @@ static ThreadMutex python_driver_lock = BLI_MUTEX_INITIALIZER;
 
 static CLG_LogRef LOG = {"bke.fcurve"};
 
+/* Number of expression drivers evaluated since the last reset, for depsgraph time debugging. */
+static uint driver_stats_num_simple = 0;
+static uint driver_stats_num_python = 0;
+
 /* ************************** Data-Level Functions ************************* */
 
 /* ---------------------- Freeing --------------------------- */
@@ -947,9 +951,21 @@ void fcurve_store_samples(FCurve *fcu, void *data, int start, int end, FcuSample
   fpt = new_fpt = MEM_callocN(sizeof(FPoint) * (end - start + 1), "FPoint Samples");
 
   /* use the sampling callback at 1-frame intervals from start to end frames */
-  for (cfra = start; cfra <= end; cfra++, fpt++) {
-    fpt->vec[0] = (float)cfra;
-    fpt->vec[1] = sample_cb(fcu, data, (float)cfra);
+  if (sample_cb == fcurve_samplingcb_evalcurve && fcu->driver == NULL) {
+    const int num_samples = end - start + 1;
+    float *values = MEM_mallocN(sizeof(float) * num_samples, "F-Curve sample values");
+    evaluate_fcurve_range(fcu, (float)start, 1.0f, num_samples, values);
+    for (cfra = start; cfra <= end; cfra++, fpt++) {
+      fpt->vec[0] = (float)cfra;
+      fpt->vec[1] = values[cfra - start];
+    }
+    MEM_freeN(values);
+  }
+  else {
+    for (cfra = start; cfra <= end; cfra++, fpt++) {
+      fpt->vec[0] = (float)cfra;
+      fpt->vec[1] = sample_cb(fcu, data, (float)cfra);
+    }
   }
 
   /* free any existing sample/keyframe data on curve  */
@@ -2217,6 +2233,29 @@ bool BKE_driver_has_simple_expression(ChannelDriver *driver)
   return driver_compile_simple_expr(driver) && BLI_expr_pylike_is_valid(driver->expr_simple);
 }
 
+/* Check if a simple driver expression uses the frame variable, which is always the first
+ * parameter. Must only be called for drivers for which #BKE_driver_has_simple_expression
+ * returns true. */
+bool BKE_driver_simple_expression_uses_frame(ChannelDriver *driver)
+{
+  return BLI_expr_pylike_is_using_param(driver->expr_simple, 0);
+}
+
+/* Reset the counters of evaluated expression drivers. */
+void BKE_driver_stats_reset(void)
+{
+  driver_stats_num_simple = 0;
+  driver_stats_num_python = 0;
+}
+
+/* Get the number of expression drivers evaluated since the last reset,
+ * and how many of those needed Python. */
+void BKE_driver_stats_get(uint *r_num_evaluated, uint *r_num_python)
+{
+  *r_num_evaluated = driver_stats_num_simple + driver_stats_num_python;
+  *r_num_python = driver_stats_num_python;
+}
+
 /* Reset cached compiled expression data */
 void BKE_driver_invalidate_expression(ChannelDriver *driver,
                                       bool expr_changed,
@@ -2356,7 +2395,12 @@ float evaluate_driver(PathResolvedRNA *anim_rna,
       if ((driver_orig->expression[0] == '\0') || (driver_orig->flag & DRIVER_FLAG_INVALID)) {
         driver->curval = 0.0f;
       }
-      else if (!driver_try_evaluate_simple_expr(driver, driver_orig, &driver->curval, evaltime)) {
+      else if (driver_try_evaluate_simple_expr(driver, driver_orig, &driver->curval, evaltime)) {
+        if (G.debug & G_DEBUG_DEPSGRAPH_TIME) {
+          atomic_add_and_fetch_uint32(&driver_stats_num_simple, 1);
+        }
+      }
+      else {
 #ifdef WITH_PYTHON
         /* this evaluates the expression using Python, and returns its result:
          * - on errors it reports, then returns 0.0f
@@ -2364,6 +2408,7 @@ float evaluate_driver(PathResolvedRNA *anim_rna,
         BLI_mutex_lock(&python_driver_lock);
 
         driver->curval = BPY_driver_exec(anim_rna, driver, driver_orig, evaltime);
+        driver_stats_num_python++;
 
         BLI_mutex_unlock(&python_driver_lock);
 #else  /* WITH_PYTHON*/
@@ -2575,8 +2620,65 @@ static void berekeny(float f1, float f2, float f3, float f4, float *o, int b)
 
 /* -------------------------- */
 
-/* Calculate F-Curve value for 'evaltime' using BezTriple keyframes */
-static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime)
+/* Check whether binarysearch_bezt_index_ex() is guaranteed to return 'index' for the given frame,
+ * when the frame is inside the range of the keyframes. */
+static bool fcurve_bezt_index_check(
+    const BezTriple *bezts, int totvert, float frame, float threshold, int index, bool *r_exact)
+{
+  if (index < 0 || index >= totvert) {
+    return false;
+  }
+
+  const float framenum = bezts[index].vec[1][0];
+
+  if (IS_EQT(frame, framenum, threshold)) {
+    /* On top of the keyframe, neighbors must not be close enough to be found instead. */
+    if ((index > 0 && frame - bezts[index - 1].vec[1][0] <= threshold) ||
+        (index < totvert - 1 && bezts[index + 1].vec[1][0] - frame <= threshold)) {
+      return false;
+    }
+    *r_exact = true;
+    return true;
+  }
+
+  /* Between the previous and this keyframe. */
+  if (index > 0 && frame < framenum && frame - bezts[index - 1].vec[1][0] > threshold) {
+    *r_exact = false;
+    return true;
+  }
+
+  return false;
+}
+
+/* Same as binarysearch_bezt_index_ex(), but first checks the index found in the previous call
+ * and the one following it, which avoids the search when evaluating consecutive frames. */
+static int fcurve_bezt_index_hinted(
+    BezTriple *bezts, int totvert, float frame, float threshold, int *hint, bool *r_exact)
+{
+  int index;
+
+  if (fcurve_bezt_index_check(bezts, totvert, frame, threshold, *hint, r_exact)) {
+    return *hint;
+  }
+  if (fcurve_bezt_index_check(bezts, totvert, frame, threshold, *hint + 1, r_exact)) {
+    index = *hint + 1;
+  }
+  else {
+    index = binarysearch_bezt_index_ex(bezts, frame, totvert, threshold, r_exact);
+  }
+
+  *hint = index;
+  return index;
+}
+
+/* Calculate F-Curve value for 'evaltime' using BezTriple keyframes
+ *
+ * \param segment_hint: Optional index of the keyframe found by the previous evaluation.
+ */
+static float fcurve_eval_keyframes(FCurve *fcu,
+                                   BezTriple *bezts,
+                                   float evaltime,
+                                   int *segment_hint)
 {
   const float eps = 1.e-8f;
   BezTriple *bezt, *prevbezt, *lastbezt;
@@ -2708,7 +2810,12 @@ static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime
      *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
      *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
      */
-    a = binarysearch_bezt_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+    if (segment_hint) {
+      a = fcurve_bezt_index_hinted(bezts, fcu->totvert, evaltime, 0.0001, segment_hint, &exact);
+    }
+    else {
+      a = binarysearch_bezt_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+    }
 
     if (exact) {
       /* index returned must be interpreted differently when it sits on top of an existing keyframe
@@ -3051,7 +3158,7 @@ static float fcurve_eval_samples(FCurve *fcu, FPoint *fpts, float evaltime)
 /* Evaluate and return the value of the given F-Curve at the specified frame ("evaltime")
  * Note: this is also used for drivers
  */
-static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
+static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue, int *segment_hint)
 {
   float devaltime;
 
@@ -3068,7 +3175,7 @@ static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
    *   F-Curve modifier on the stack requested the curve to be evaluated at
    */
   if (fcu->bezt) {
-    cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, devaltime);
+    cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, devaltime, segment_hint);
   }
   else if (fcu->fpt) {
     cvalue = fcurve_eval_samples(fcu, fcu->fpt, devaltime);
@@ -3092,7 +3199,7 @@ float evaluate_fcurve(FCurve *fcu, float evaltime)
 {
   BLI_assert(fcu->driver == NULL);
 
-  return evaluate_fcurve_ex(fcu, evaltime, 0.0);
+  return evaluate_fcurve_ex(fcu, evaltime, 0.0, NULL);
 }
 
 float evaluate_fcurve_only_curve(FCurve *fcu, float evaltime)
@@ -3100,13 +3207,28 @@ float evaluate_fcurve_only_curve(FCurve *fcu, float evaltime)
   /* Can be used to evaluate the (keyframed) fcurve only.
    * Also works for driver-fcurves when the driver itself is not relevant.
    * E.g. when inserting a keyframe in a driver fcurve. */
-  return evaluate_fcurve_ex(fcu, evaltime, 0.0);
+  return evaluate_fcurve_ex(fcu, evaltime, 0.0, NULL);
 }
 
-float evaluate_fcurve_driver(PathResolvedRNA *anim_rna,
-                             FCurve *fcu,
-                             ChannelDriver *driver_orig,
-                             float evaltime)
+/* Sample the F-Curve at 'num_samples' frames: start, start + step, start + 2 * step, ...
+ * Gives the same values as evaluate_fcurve() for each frame, but walks through the keyframes
+ * instead of searching them for every sample, for baking and exporting of whole curves. */
+void evaluate_fcurve_range(
+    FCurve *fcu, float start, float step, int num_samples, float *r_values)
+{
+  BLI_assert(fcu->driver == NULL);
+  int segment_hint = 0;
+
+  for (int i = 0; i < num_samples; i++) {
+    r_values[i] = evaluate_fcurve_ex(fcu, start + (float)i * step, 0.0, &segment_hint);
+  }
+}
+
+static float evaluate_fcurve_driver_ex(PathResolvedRNA *anim_rna,
+                                       FCurve *fcu,
+                                       ChannelDriver *driver_orig,
+                                       float evaltime,
+                                       int *segment_hint)
 {
   BLI_assert(fcu->driver != NULL);
   float cvalue = 0.0f;
@@ -3147,7 +3269,15 @@ float evaluate_fcurve_driver(PathResolvedRNA *anim_rna,
     }
   }
 
-  return evaluate_fcurve_ex(fcu, evaltime, cvalue);
+  return evaluate_fcurve_ex(fcu, evaltime, cvalue, segment_hint);
+}
+
+float evaluate_fcurve_driver(PathResolvedRNA *anim_rna,
+                             FCurve *fcu,
+                             ChannelDriver *driver_orig,
+                             float evaltime)
+{
+  return evaluate_fcurve_driver_ex(anim_rna, fcu, driver_orig, evaltime, NULL);
 }
 
 /* Checks if the curve has valid keys, drivers or modifiers that produce an actual curve. */
@@ -3157,8 +3287,15 @@ bool BKE_fcurve_is_empty(FCurve *fcu)
          !list_has_suitable_fmodifier(&fcu->modifiers, 0, FMI_TYPE_GENERATE_CURVE);
 }
 
-/* Calculate the value of the given F-Curve at the given frame, and set its curval */
-float calculate_fcurve(PathResolvedRNA *anim_rna, FCurve *fcu, float evaltime)
+/* Calculate the value of the given F-Curve at the given frame, and set its curval
+ *
+ * \param segment_hint: Optional keyframe index found by the previous evaluation of the curve,
+ * for evaluating it at consecutive frames without searching the keyframes. Initialize to 0.
+ */
+float calculate_fcurve_ex(PathResolvedRNA *anim_rna,
+                          FCurve *fcu,
+                          float evaltime,
+                          int *segment_hint)
 {
   /* only calculate + set curval (overriding the existing value) if curve has
    * any data which warrants this...
@@ -3167,10 +3304,10 @@ float calculate_fcurve(PathResolvedRNA *anim_rna, FCurve *fcu, float evaltime)
     /* calculate and set curval (evaluates driver too if necessary) */
     float curval;
     if (fcu->driver) {
-      curval = evaluate_fcurve_driver(anim_rna, fcu, fcu->driver, evaltime);
+      curval = evaluate_fcurve_driver_ex(anim_rna, fcu, fcu->driver, evaltime, segment_hint);
     }
     else {
-      curval = evaluate_fcurve(fcu, evaltime);
+      curval = evaluate_fcurve_ex(fcu, evaltime, 0.0, segment_hint);
     }
     fcu->curval = curval; /* debug display only, not thread safe! */
     return curval;
@@ -3179,3 +3316,8 @@ float calculate_fcurve(PathResolvedRNA *anim_rna, FCurve *fcu, float evaltime)
     return 0.0f;
   }
 }
+
+float calculate_fcurve(PathResolvedRNA *anim_rna, FCurve *fcu, float evaltime)
+{
+  return calculate_fcurve_ex(anim_rna, fcu, evaltime, NULL);
+}
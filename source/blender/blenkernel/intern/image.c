@@ -4253,7 +4253,7 @@ static ImBuf *image_get_render_result(Image *ima, ImageUser *iuser, void **r_loc
     if (rl) {
       RenderPass *rpass = image_render_pass_get(rl, pass, actview, NULL);
       if (rpass) {
-        rectf = rpass->rect;
+        rectf = RE_pass_rect_ensure(rl, rpass);
         if (pass != 0) {
           channels = rpass->channels;
           dither = 0.0f; /* don't dither passes */
@@ -4262,7 +4262,7 @@ static ImBuf *image_get_render_result(Image *ima, ImageUser *iuser, void **r_loc
 
       for (rpass = rl->passes.first; rpass; rpass = rpass->next) {
         if (STREQ(rpass->name, RE_PASSNAME_Z) && rpass->view_id == actview) {
-          rectz = rpass->rect;
+          rectz = RE_pass_rect_ensure(rl, rpass);
         }
       }
     }
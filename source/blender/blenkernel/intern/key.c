@@ -30,6 +30,8 @@
 #include "BLI_blenlib.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -71,6 +73,31 @@ typedef struct WeightsArrayCache {
   float **defgroup_weights;
 } WeightsArrayCache;
 
+/**
+ * Elements of a key block that are offset from its relative key, sorted by index.
+ * Lets blending skip the untouched elements of key blocks that only affect a small region.
+ */
+typedef struct KeyBlockSparse {
+  /* Arrays the indices were computed from, used to detect reallocated data. */
+  const void *data, *ref_data;
+  int totelem;
+  /* Number of indices, or -1 when too many elements are offset and dense blending is used. */
+  int len;
+  int *index;
+} KeyBlockSparse;
+
+/* Objects sharing a mesh evaluate the same key concurrently. */
+static ThreadMutex keyblock_sparse_lock = BLI_MUTEX_INITIALIZER;
+
+static void keyblock_sparse_free(KeyBlock *kb)
+{
+  if (kb->sparse) {
+    MEM_SAFE_FREE(kb->sparse->index);
+    MEM_freeN(kb->sparse);
+    kb->sparse = NULL;
+  }
+}
+
 /** Free (or release) any data used by this shapekey (does not free the key itself). */
 void BKE_key_free(Key *key)
 {
@@ -82,6 +109,7 @@ void BKE_key_free(Key *key)
     if (kb->data) {
       MEM_freeN(kb->data);
     }
+    keyblock_sparse_free(kb);
     MEM_freeN(kb);
   }
 }
@@ -94,6 +122,7 @@ void BKE_key_free_nolib(Key *key)
     if (kb->data) {
       MEM_freeN(kb->data);
     }
+    keyblock_sparse_free(kb);
     MEM_freeN(kb);
   }
 }
@@ -173,6 +202,7 @@ void BKE_key_copy_data(Main *UNUSED(bmain),
     if (kb_dst->data) {
       kb_dst->data = MEM_dupallocN(kb_dst->data);
     }
+    kb_dst->sparse = NULL;
     if (kb_src == key_src->refkey) {
       key_dst->refkey = kb_dst;
     }
@@ -205,6 +235,7 @@ Key *BKE_key_copy_nolib(Key *key)
     if (kbn->data) {
       kbn->data = MEM_dupallocN(kbn->data);
     }
+    kbn->sparse = NULL;
     if (kb == key->refkey) {
       keyn->refkey = kbn;
     }
@@ -517,7 +548,8 @@ static void flerp(int tot, float *in, float *f0, float *f1, float *f2, float *f3
   }
 }
 
-static void rel_flerp(int tot, float *in, float *ref, float *out, float fac)
+static void rel_flerp(
+    int tot, float *__restrict in, const float *ref, const float *out, float fac)
 {
   int a;
 
@@ -773,6 +805,245 @@ static void cp_cu_key(Curve *cu,
   }
 }
 
+/* Relative Key Blending of Coordinates --------------- */
+
+/* Number of elements blended by a single task, all key blocks are applied per range so the
+ * output stays in cache while the key data is streamed. */
+#define KEY_RELATIVE_CHUNK_SIZE 1024
+
+typedef struct KeyRelativeBlock {
+  const float (*co)[3];
+  const float (*ref_co)[3];
+  const float *weights;
+  float influence;
+  /* Key block to build the sparse index for, NULL when its data can't be indexed. */
+  KeyBlock *kb;
+  /* NULL for dense blending. */
+  const KeyBlockSparse *sparse;
+} KeyRelativeBlock;
+
+typedef struct KeyRelativeData {
+  float (*out)[3];
+  /* Basis to initialize the output with, NULL when it was initialized already. */
+  const float (*basis)[3];
+  KeyRelativeBlock *blocks;
+  int blocks_len;
+  int tot;
+} KeyRelativeData;
+
+/* Build the sparse index of a key block, or mark it dense when too many elements are offset. */
+static void keyblock_sparse_ensure(KeyBlock *kb, const void *ref_data, const int tot)
+{
+  KeyBlockSparse *sparse = kb->sparse;
+
+  if (sparse && sparse->data == kb->data && sparse->ref_data == ref_data &&
+      sparse->totelem == tot) {
+    return;
+  }
+
+  keyblock_sparse_free(kb);
+
+  const float(*co)[3] = kb->data;
+  const float(*ref_co)[3] = ref_data;
+  const int max_len = tot / 4;
+  int *index = MEM_mallocN(sizeof(*index) * (size_t)max_ii(max_len, 1), __func__);
+  int len = 0;
+
+  for (int i = 0; i < tot; i++) {
+    if (!equals_v3v3(co[i], ref_co[i])) {
+      if (len == max_len) {
+        len = -1;
+        break;
+      }
+      index[len++] = i;
+    }
+  }
+
+  if (len > 0) {
+    index = MEM_reallocN(index, sizeof(*index) * (size_t)len);
+  }
+  else {
+    MEM_SAFE_FREE(index);
+  }
+
+  sparse = MEM_mallocN(sizeof(*sparse), __func__);
+  sparse->data = kb->data;
+  sparse->ref_data = ref_data;
+  sparse->totelem = tot;
+  sparse->len = len;
+  sparse->index = index;
+
+  kb->sparse = sparse;
+}
+
+static void keyblock_sparse_ensure_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  KeyRelativeData *data = userdata;
+  KeyRelativeBlock *block = &data->blocks[i];
+
+  if (block->kb) {
+    keyblock_sparse_ensure(block->kb, block->ref_co, data->tot);
+    block->sparse = (block->kb->sparse->len != -1) ? block->kb->sparse : NULL;
+  }
+}
+
+/* First position in the sorted sparse index that is not below the given element. */
+static int keyblock_sparse_lower_bound(const KeyBlockSparse *sparse, const int elem)
+{
+  int low = 0, high = sparse->len;
+
+  while (low < high) {
+    const int mid = (low + high) / 2;
+    if (sparse->index[mid] < elem) {
+      low = mid + 1;
+    }
+    else {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+static void key_evaluate_relative_coords_cb(void *__restrict userdata,
+                                            const int chunk,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KeyRelativeData *data = userdata;
+  const int start = chunk * KEY_RELATIVE_CHUNK_SIZE;
+  const int end = min_ii(start + KEY_RELATIVE_CHUNK_SIZE, data->tot);
+  float(*out)[3] = data->out;
+
+  if (data->basis) {
+    memcpy(out[start], data->basis[start], sizeof(*out) * (size_t)(end - start));
+  }
+
+  for (int b = 0; b < data->blocks_len; b++) {
+    const KeyRelativeBlock *block = &data->blocks[b];
+    const KeyBlockSparse *sparse = block->sparse;
+
+    if (sparse) {
+      for (int i = keyblock_sparse_lower_bound(sparse, start);
+           i < sparse->len && sparse->index[i] < end;
+           i++) {
+        const int v = sparse->index[i];
+        const float weight = block->weights ? (block->weights[v] * block->influence) :
+                                              block->influence;
+        rel_flerp(KEYELEM_FLOAT_LEN_COORD, out[v], block->ref_co[v], block->co[v], weight);
+      }
+    }
+    else if (block->weights) {
+      for (int v = start; v < end; v++) {
+        const float weight = block->weights[v] * block->influence;
+        if (weight != 0.0f) {
+          rel_flerp(KEYELEM_FLOAT_LEN_COORD, out[v], block->ref_co[v], block->co[v], weight);
+        }
+      }
+    }
+    else {
+      /* Without weights the whole range is one flat array, which vectorizes well. */
+      rel_flerp(KEYELEM_FLOAT_LEN_COORD * (end - start),
+                out[start],
+                block->ref_co[start],
+                block->co[start],
+                block->influence);
+    }
+  }
+}
+
+/**
+ * Blend relative shape keys of meshes and lattices, which only store coordinates.
+ * Gives the same result as the generic path of #key_evaluate_relative, but applies all
+ * key blocks per range of elements in parallel.
+ */
+static void key_evaluate_relative_coords(const int tot,
+                                         float (*out)[3],
+                                         Key *key,
+                                         KeyBlock *actkb,
+                                         float **per_keyblock_weights)
+{
+  KeyRelativeBlock *blocks = MEM_mallocN(sizeof(*blocks) * (size_t)key->totkey, __func__);
+  char **freedata = MEM_callocN(sizeof(*freedata) * (size_t)(key->totkey * 2 + 1), __func__);
+  int blocks_len = 0, freedata_len = 0;
+  bool any_sparse = false;
+  KeyBlock *kb;
+  int keyblock_index;
+
+  /* Only evaluated copies cache sparse indices, their data does not change afterwards. */
+  const bool use_sparse = (key->id.tag & LIB_TAG_COPIED_ON_WRITE) != 0;
+
+  KeyRelativeData data = {
+      .out = out,
+      .basis = NULL,
+      .blocks = blocks,
+      .tot = tot,
+  };
+
+  if (key->refkey->totelem == tot) {
+    data.basis = (const float(*)[3])key_block_get_data(
+        key, actkb, key->refkey, &freedata[freedata_len]);
+    freedata_len++;
+  }
+  else {
+    cp_key(0, tot, tot, (char *)out, key, actkb, key->refkey, NULL, KEY_MODE_DUMMY);
+  }
+
+  for (kb = key->block.first, keyblock_index = 0; kb; kb = kb->next, keyblock_index++) {
+    /* Skip blocks without influence entirely. */
+    if (kb == key->refkey || (kb->flag & KEYBLOCK_MUTE) || kb->curval == 0.0f ||
+        kb->totelem != tot) {
+      continue;
+    }
+
+    KeyBlock *refb = BLI_findlink(&key->block, kb->relative);
+    if (refb == NULL) {
+      continue;
+    }
+
+    KeyRelativeBlock *block = &blocks[blocks_len++];
+    block->co = (const float(*)[3])key_block_get_data(key, actkb, kb, &freedata[freedata_len]);
+    block->ref_co = (const float(*)[3])key_block_get_data(
+        key, actkb, refb, &freedata[freedata_len + 1]);
+    block->weights = per_keyblock_weights ? per_keyblock_weights[keyblock_index] : NULL;
+    block->influence = kb->curval;
+    block->kb = NULL;
+    block->sparse = NULL;
+
+    /* Data from edit-mode is temporary, so it can't be indexed. */
+    if (use_sparse && (void *)block->co == kb->data && (void *)block->ref_co == refb->data) {
+      block->kb = kb;
+      any_sparse = true;
+    }
+
+    freedata_len += 2;
+  }
+
+  data.blocks_len = blocks_len;
+
+  const int chunks_len = (tot + KEY_RELATIVE_CHUNK_SIZE - 1) / KEY_RELATIVE_CHUNK_SIZE;
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (chunks_len > 1);
+
+  if (any_sparse) {
+    BLI_mutex_lock(&keyblock_sparse_lock);
+    BLI_task_parallel_range(0, blocks_len, &data, keyblock_sparse_ensure_cb, &settings);
+    BLI_mutex_unlock(&keyblock_sparse_lock);
+  }
+
+  BLI_task_parallel_range(0, chunks_len, &data, key_evaluate_relative_coords_cb, &settings);
+
+  for (int i = 0; i < freedata_len; i++) {
+    if (freedata[i]) {
+      MEM_freeN(freedata[i]);
+    }
+  }
+  MEM_freeN(freedata);
+  MEM_freeN(blocks);
+}
+
 static void key_evaluate_relative(const int start,
                                   int end,
                                   const int tot,
@@ -798,6 +1069,12 @@ static void key_evaluate_relative(const int start,
     end = tot;
   }
 
+  if (mode == KEY_MODE_DUMMY && start == 0 && end == tot &&
+      ELEM(GS(key->from->name), ID_ME, ID_LT)) {
+    key_evaluate_relative_coords(tot, (float(*)[3])basispoin, key, actkb, per_keyblock_weights);
+    return;
+  }
+
   /* in case of beztriple */
   elemstr[0] = 1; /* nr of ipofloats */
   elemstr[1] = IPO_BEZTRIPLE;
@@ -636,7 +636,7 @@ static bool where_on_path_deform(
 /* returns quaternion for rotation, using cd->no_rot_axis */
 /* axis is using another define!!! */
 static bool calc_curve_deform(
-    Object *par, float co[3], const short axis, CurveDeform *cd, float r_quat[4])
+    Object *par, float co[3], const short axis, const CurveDeform *cd, float r_quat[4])
 {
   Curve *cu = par->data;
   float fac, loc[4], dir[3], new_quat[4], radius;
@@ -743,6 +743,49 @@ static bool calc_curve_deform(
   return false;
 }
 
+typedef struct CurveDeformUserdata {
+  Object *cuOb;
+  const CurveDeform *cd;
+  float (*vert_coords)[3];
+  const MDeformVert *dvert;
+  int defgrp_index;
+  short defaxis;
+  /* Coordinates still need to be transformed into curve space. */
+  bool to_curvespace;
+} CurveDeformUserdata;
+
+static void curve_deform_vert_task(void *__restrict userdata,
+                                   const int index,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CurveDeformUserdata *data = userdata;
+  const CurveDeform *cd = data->cd;
+  float *co = data->vert_coords[index];
+
+  if (data->dvert) {
+    const float weight = defvert_find_weight(&data->dvert[index], data->defgrp_index);
+
+    if (weight > 0.0f) {
+      float vec[3];
+
+      if (data->to_curvespace) {
+        mul_m4_v3(cd->curvespace, co);
+      }
+      copy_v3_v3(vec, co);
+      calc_curve_deform(data->cuOb, vec, data->defaxis, cd, NULL);
+      interp_v3_v3v3(co, co, vec, weight);
+      mul_m4_v3(cd->objectspace, co);
+    }
+  }
+  else {
+    if (data->to_curvespace) {
+      mul_m4_v3(cd->curvespace, co);
+    }
+    calc_curve_deform(data->cuOb, co, data->defaxis, cd, NULL);
+    mul_m4_v3(cd->objectspace, co);
+  }
+}
+
 void curve_deform_verts(Object *cuOb,
                         Object *target,
                         float (*vert_coords)[3],
@@ -775,26 +818,22 @@ void curve_deform_verts(Object *cuOb,
     cd.dmax[0] = cd.dmax[1] = cd.dmax[2] = 0.0f;
   }
 
-  if (dvert) {
-    MDeformVert *dvert_iter;
-    float vec[3];
+  CurveDeformUserdata data = {
+      .cuOb = cuOb,
+      .cd = &cd,
+      .vert_coords = vert_coords,
+      .dvert = dvert,
+      .defgrp_index = defgrp_index,
+      .defaxis = defaxis,
+      .to_curvespace = (cu->flag & CU_DEFORM_BOUNDS_OFF) != 0,
+  };
 
-    if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
-      for (a = 0, dvert_iter = dvert; a < numVerts; a++, dvert_iter++) {
-        const float weight = defvert_find_weight(dvert_iter, defgrp_index);
+  if ((cu->flag & CU_DEFORM_BOUNDS_OFF) == 0) {
+    /* set mesh min/max bounds, this moves the affected vertices into 'cd.curvespace' */
+    INIT_MINMAX(cd.dmin, cd.dmax);
 
-        if (weight > 0.0f) {
-          mul_m4_v3(cd.curvespace, vert_coords[a]);
-          copy_v3_v3(vec, vert_coords[a]);
-          calc_curve_deform(cuOb, vec, defaxis, &cd, NULL);
-          interp_v3_v3v3(vert_coords[a], vert_coords[a], vec, weight);
-          mul_m4_v3(cd.objectspace, vert_coords[a]);
-        }
-      }
-    }
-    else {
-      /* set mesh min/max bounds */
-      INIT_MINMAX(cd.dmin, cd.dmax);
+    if (dvert) {
+      MDeformVert *dvert_iter;
 
       for (a = 0, dvert_iter = dvert; a < numVerts; a++, dvert_iter++) {
         if (defvert_find_weight(dvert_iter, defgrp_index) > 0.0f) {
@@ -802,44 +841,19 @@ void curve_deform_verts(Object *cuOb,
           minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]);
         }
       }
-
-      for (a = 0, dvert_iter = dvert; a < numVerts; a++, dvert_iter++) {
-        const float weight = defvert_find_weight(dvert_iter, defgrp_index);
-
-        if (weight > 0.0f) {
-          /* already in 'cd.curvespace', prev for loop */
-          copy_v3_v3(vec, vert_coords[a]);
-          calc_curve_deform(cuOb, vec, defaxis, &cd, NULL);
-          interp_v3_v3v3(vert_coords[a], vert_coords[a], vec, weight);
-          mul_m4_v3(cd.objectspace, vert_coords[a]);
-        }
-      }
-    }
-  }
-  else {
-    if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
-      for (a = 0; a < numVerts; a++) {
-        mul_m4_v3(cd.curvespace, vert_coords[a]);
-        calc_curve_deform(cuOb, vert_coords[a], defaxis, &cd, NULL);
-        mul_m4_v3(cd.objectspace, vert_coords[a]);
-      }
     }
     else {
-      /* set mesh min max bounds */
-      INIT_MINMAX(cd.dmin, cd.dmax);
-
       for (a = 0; a < numVerts; a++) {
         mul_m4_v3(cd.curvespace, vert_coords[a]);
         minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]);
       }
-
-      for (a = 0; a < numVerts; a++) {
-        /* already in 'cd.curvespace', prev for loop */
-        calc_curve_deform(cuOb, vert_coords[a], defaxis, &cd, NULL);
-        mul_m4_v3(cd.objectspace, vert_coords[a]);
-      }
     }
   }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 32;
+  BLI_task_parallel_range(0, numVerts, &data, curve_deform_vert_task, &settings);
 }
 
 /* input vec and orco = local coord in armature space */
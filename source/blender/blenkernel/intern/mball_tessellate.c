@@ -37,7 +37,9 @@
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
+#include "BLI_ghash.h"
 #include "BLI_memarena.h"
 
 #include "BKE_global.h"
@@ -121,6 +123,8 @@ typedef struct process {     /* parameters, storage */
   CENTERLIST **centers; /* cube center hash table */
   CORNER **corners;     /* corner value hash table */
   EDGELIST **edges;     /* edge and vertex id hash table */
+  int hash_bit;         /* bits per axis of the hash tables, see #lattice_hash() */
+  unsigned int totcenter; /* number of cubes in the centers table */
 
   int (*indices)[4];     /* output indices */
   unsigned int totindex; /* size of memory allocated for indices */
@@ -132,6 +136,11 @@ typedef struct process {     /* parameters, storage */
 
   /* memory allocation from common pool */
   MemArena *pgn_elements;
+
+  /* The lattice is polygonized in blocks, each with its own process, see #polygonize(). */
+  int block[4];          /* lattice location of the block, in blocks (4th is for hashing) */
+  CENTERLIST *cubes_in;  /* cubes added by other blocks, waiting for polygonization */
+  CENTERLIST *cubes_out; /* cubes added outside of this block */
 } PROCESS;
 
 /* Forward declarations */
@@ -294,7 +303,33 @@ static void build_bvh_spatial(PROCESS *process,
 #define HASHBIT (5)
 #define HASHSIZE (size_t)(1 << (3 * HASHBIT)) /*! < hash table size (32768) */
 
-#define HASH(i, j, k) ((((((i)&31) << 5) | ((j)&31)) << 5) | ((k)&31))
+/* Hash table size for given bits per axis. */
+#define HASHSIZE_EX(bit) ((size_t)1 << (3 * (bit)))
+
+/* Number of cubes per axis in a block, cubes of a block don't collide in full size hash tables. */
+#define BLOCK_SIZE (1 << HASHBIT)
+
+/* Bits per axis the hash tables of a block start with, they grow with the cubes of the block. */
+#define BLOCK_HASHBIT_MIN (2)
+
+/**
+ * Hash of a lattice location, using the lowest \a bit bits of each axis.
+ * Coordinates are folded with their block, otherwise all edges on the seam between two blocks
+ * would share the same bits along the seam axis, and collide in the table of the main process.
+ */
+BLI_INLINE int lattice_hash(const int bit, int i, int j, int k)
+{
+  const int mask = (1 << bit) - 1;
+  i ^= i >> HASHBIT;
+  j ^= j >> HASHBIT;
+  k ^= k >> HASHBIT;
+  return ((((i & mask) << bit) | (j & mask)) << bit) | (k & mask);
+}
+
+BLI_INLINE int edge_hash(const int bit, const EDGELIST *e)
+{
+  return lattice_hash(bit, e->i1, e->j1, e->k1) + lattice_hash(bit, e->i2, e->j2, e->k2);
+}
 
 #define MB_BIT(i, bit) (((i) >> (bit)) & 1)
 // #define FLIP(i, bit) ((i) ^ 1 << (bit)) /* flip the given bit of i */
@@ -405,25 +440,26 @@ static float densfunc(const MetaElem *ball, float x, float y, float z)
 
 /**
  * Computes density at given position form all metaballs which contain this point in their box.
- * Traverses BVH using a queue.
+ * Traverses BVH using given queue.
  */
-static float metaball(PROCESS *process, float x, float y, float z)
+static float metaball_ex(
+    const PROCESS *process, MetaballBVHNode **bvh_queue, float x, float y, float z)
 {
   int i;
   float dens = 0.0f;
   unsigned int front = 0, back = 0;
   MetaballBVHNode *node;
 
-  process->bvh_queue[front++] = &process->metaball_bvh;
+  bvh_queue[front++] = (MetaballBVHNode *)&process->metaball_bvh;
 
   while (front != back) {
-    node = process->bvh_queue[back++];
+    node = bvh_queue[back++];
 
     for (i = 0; i < 2; i++) {
       if ((node->bb[i].min[0] <= x) && (node->bb[i].max[0] >= x) && (node->bb[i].min[1] <= y) &&
           (node->bb[i].max[1] >= y) && (node->bb[i].min[2] <= z) && (node->bb[i].max[2] >= z)) {
         if (node->child[i]) {
-          process->bvh_queue[front++] = node->child[i];
+          bvh_queue[front++] = node->child[i];
         }
         else {
           dens += densfunc(node->bb[i].ml, x, y, z);
@@ -435,6 +471,11 @@ static float metaball(PROCESS *process, float x, float y, float z)
   return process->thresh - dens;
 }
 
+static float metaball(PROCESS *process, float x, float y, float z)
+{
+  return metaball_ex(process, process->bvh_queue, x, y, z);
+}
+
 /**
  * Adds face to indices, expands memory if needed.
  */
@@ -447,7 +488,8 @@ static void make_face(PROCESS *process, int i1, int i2, int i3, int i4)
 #endif
 
   if (UNLIKELY(process->totindex == process->curindex)) {
-    process->totindex += 4096;
+    /* Start small and double, each block of the lattice has its own faces. */
+    process->totindex = process->totindex ? process->totindex * 2 : 256;
     process->indices = MEM_reallocN(process->indices, sizeof(int[4]) * process->totindex);
   }
 
@@ -679,7 +721,7 @@ static CORNER *setcorner(PROCESS *process, int i, int j, int k)
   int index;
 
   /* does corner exist? */
-  index = HASH(i, j, k);
+  index = lattice_hash(process->hash_bit, i, j, k);
   c = process->corners[index];
 
   for (; c != NULL; c = c->next) {
@@ -865,7 +907,7 @@ static int setcenter(PROCESS *process, CENTERLIST *table[], const int i, const i
   int index;
   CENTERLIST *newc, *l, *q;
 
-  index = HASH(i, j, k);
+  index = lattice_hash(process->hash_bit, i, j, k);
   q = table[index];
 
   for (l = q; l != NULL; l = l->next) {
@@ -880,6 +922,7 @@ static int setcenter(PROCESS *process, CENTERLIST *table[], const int i, const i
   newc->k = k;
   newc->next = q;
   table[index] = newc;
+  process->totcenter++;
 
   return 0;
 }
@@ -903,7 +946,6 @@ static void setedge(PROCESS *process, int i1, int j1, int k1, int i2, int j2, in
     k1 = k2;
     k2 = t;
   }
-  index = HASH(i1, j1, k1) + HASH(i2, j2, k2);
   newe = BLI_memarena_alloc(process->pgn_elements, sizeof(EDGELIST));
 
   newe->i1 = i1;
@@ -913,6 +955,8 @@ static void setedge(PROCESS *process, int i1, int j1, int k1, int i2, int j2, in
   newe->j2 = j2;
   newe->k2 = k2;
   newe->vid = vid;
+
+  index = edge_hash(process->hash_bit, newe);
   newe->next = process->edges[index];
   process->edges[index] = newe;
 }
@@ -920,8 +964,9 @@ static void setedge(PROCESS *process, int i1, int j1, int k1, int i2, int j2, in
 /**
  * \return vertex id for edge; return -1 if not set
  */
-static int getedge(EDGELIST *table[], int i1, int j1, int k1, int i2, int j2, int k2)
+static int getedge(const PROCESS *process, int i1, int j1, int k1, int i2, int j2, int k2)
 {
+  const int bit = process->hash_bit;
   EDGELIST *q;
 
   if (i1 > i2 || (i1 == i2 && (j1 > j2 || (j1 == j2 && k1 > k2)))) {
@@ -935,7 +980,7 @@ static int getedge(EDGELIST *table[], int i1, int j1, int k1, int i2, int j2, in
     k1 = k2;
     k2 = t;
   }
-  q = table[HASH(i1, j1, k1) + HASH(i2, j2, k2)];
+  q = process->edges[lattice_hash(bit, i1, j1, k1) + lattice_hash(bit, i2, j2, k2)];
   for (; q != NULL; q = q->next) {
     if (q->i1 == i1 && q->j1 == j1 && q->k1 == k1 && q->i2 == i2 && q->j2 == j2 && q->k2 == k2) {
       return q->vid;
@@ -944,13 +989,63 @@ static int getedge(EDGELIST *table[], int i1, int j1, int k1, int i2, int j2, in
   return -1;
 }
 
+/**
+ * Doubles the hash tables of a block process along each axis, moving all entries.
+ */
+static void process_hash_grow(PROCESS *process)
+{
+  const size_t size_old = HASHSIZE_EX(process->hash_bit);
+  CENTERLIST **centers_old = process->centers;
+  CORNER **corners_old = process->corners;
+  EDGELIST **edges_old = process->edges;
+  size_t index, size;
+
+  process->hash_bit++;
+  size = HASHSIZE_EX(process->hash_bit);
+  process->centers = MEM_callocN(size * sizeof(CENTERLIST *), "mbproc->centers");
+  process->corners = MEM_callocN(size * sizeof(CORNER *), "mbproc->corners");
+  process->edges = MEM_callocN(2 * size * sizeof(EDGELIST *), "mbproc->edges");
+
+  for (index = 0; index < size_old; index++) {
+    CENTERLIST *center, *center_next;
+    CORNER *corner, *corner_next;
+
+    for (center = centers_old[index]; center; center = center_next) {
+      const int index_new = lattice_hash(process->hash_bit, center->i, center->j, center->k);
+      center_next = center->next;
+      center->next = process->centers[index_new];
+      process->centers[index_new] = center;
+    }
+    for (corner = corners_old[index]; corner; corner = corner_next) {
+      const int index_new = lattice_hash(process->hash_bit, corner->i, corner->j, corner->k);
+      corner_next = corner->next;
+      corner->next = process->corners[index_new];
+      process->corners[index_new] = corner;
+    }
+  }
+  for (index = 0; index < 2 * size_old; index++) {
+    EDGELIST *e, *e_next;
+
+    for (e = edges_old[index]; e; e = e_next) {
+      const int index_new = edge_hash(process->hash_bit, e);
+      e_next = e->next;
+      e->next = process->edges[index_new];
+      process->edges[index_new] = e;
+    }
+  }
+
+  MEM_freeN(centers_old);
+  MEM_freeN(corners_old);
+  MEM_freeN(edges_old);
+}
+
 /**
  * Adds a vertex, expands memory if needed.
  */
 static void addtovertices(PROCESS *process, const float v[3], const float no[3])
 {
   if (process->curvertex == process->totvertex) {
-    process->totvertex += 4096;
+    process->totvertex = process->totvertex ? process->totvertex * 2 : 256;
     process->co = MEM_reallocN(process->co, process->totvertex * sizeof(float[3]));
     process->no = MEM_reallocN(process->no, process->totvertex * sizeof(float[3]));
   }
@@ -986,7 +1081,7 @@ static void vnormal(PROCESS *process, const float point[3], float r_no[3])
 static int vertid(PROCESS *process, const CORNER *c1, const CORNER *c2)
 {
   float v[3], no[3];
-  int vid = getedge(process->edges, c1->i, c1->j, c1->k, c2->i, c2->j, c2->k);
+  int vid = getedge(process, c1->i, c1->j, c1->k, c2->i, c2->j, c2->k);
 
   if (vid != -1) {
     return vid; /* previously computed */
@@ -1049,16 +1144,40 @@ static void converge(PROCESS *process, const CORNER *c1, const CORNER *c2, float
   interp_v3_v3v3(r_p, c1_co, c2_co, tmp);
 }
 
+/**
+ * \return the lattice location of the block containing given cube location.
+ */
+static int block_of_lattice(const int i)
+{
+  return (i >= 0) ? (i / BLOCK_SIZE) : ((i + 1) / BLOCK_SIZE - 1);
+}
+
 /**
  * Adds cube at given lattice position to cube stack of process.
+ * Cubes outside of the block of the process are passed on to other blocks.
  */
 static void add_cube(PROCESS *process, int i, int j, int k)
 {
   CUBES *ncube;
   int n;
 
+  if ((block_of_lattice(i) != process->block[0]) || (block_of_lattice(j) != process->block[1]) ||
+      (block_of_lattice(k) != process->block[2])) {
+    CENTERLIST *out = BLI_memarena_alloc(process->pgn_elements, sizeof(CENTERLIST));
+    out->i = i;
+    out->j = j;
+    out->k = k;
+    out->next = process->cubes_out;
+    process->cubes_out = out;
+    return;
+  }
+
   /* test if cube has been found before */
   if (setcenter(process, process->centers, i, j, k) == 0) {
+    if (process->hash_bit < HASHBIT && process->totcenter > HASHSIZE_EX(process->hash_bit)) {
+      process_hash_grow(process);
+    }
+
     /* push cube on stack: */
     ncube = BLI_memarena_alloc(process->pgn_elements, sizeof(CUBES));
     ncube->next = process->cubes;
@@ -1096,14 +1215,51 @@ static void closest_latice(int r[3], const float pos[3], const float size)
   r[2] = (int)floorf(pos[2] / size + 1.0f);
 }
 
+/* 26 directions to search from the center of each metaelem. */
+#define FIRST_POINTS_DIRS 26
+
+typedef struct FirstPointsData {
+  const PROCESS *process;
+  /* Cube found in each direction, when the matching flag is set. */
+  int (*cubes)[3];
+  bool *found;
+} FirstPointsData;
+
+/* Each thread traverses the BVH with its own queue. */
+typedef struct FirstPointsTLS {
+  MetaballBVHNode **bvh_queue;
+} FirstPointsTLS;
+
+static float lattice_value(const PROCESS *process, MetaballBVHNode **bvh_queue, const int it[3])
+{
+  return metaball_ex(process,
+                     bvh_queue,
+                     ((float)it[0] - 0.5f) * process->size,
+                     ((float)it[1] - 0.5f) * process->size,
+                     ((float)it[2] - 0.5f) * process->size);
+}
+
 /**
  * Find at most 26 cubes to start polygonization from.
  */
-static void find_first_points(PROCESS *process, const unsigned int em)
+static void find_first_points_cb(void *__restrict userdata,
+                                 const int em,
+                                 const TaskParallelTLS *__restrict tls)
 {
+  const FirstPointsData *data = userdata;
+  const PROCESS *process = data->process;
+  FirstPointsTLS *fp_tls = tls->userdata_chunk;
+  int(*cubes)[3] = &data->cubes[(size_t)em * FIRST_POINTS_DIRS];
+  bool *found = &data->found[(size_t)em * FIRST_POINTS_DIRS];
   const MetaElem *ml;
   int center[3], lbn[3], rtf[3], it[3], dir[3], add[3];
   float tmp[3], a, b;
+  int d = 0;
+
+  if (fp_tls->bvh_queue == NULL) {
+    fp_tls->bvh_queue = MEM_mallocN(sizeof(MetaballBVHNode *) * process->bvh_queue_size,
+                                    "Metaball BVH Queue");
+  }
 
   ml = process->mainb[em];
 
@@ -1120,59 +1276,345 @@ static void find_first_points(PROCESS *process, const unsigned int em)
         }
 
         copy_v3_v3_int(it, center);
+        found[d] = false;
 
-        b = setcorner(process, it[0], it[1], it[2])->value;
+        b = lattice_value(process, fp_tls->bvh_queue, it);
         do {
           it[0] += dir[0];
           it[1] += dir[1];
           it[2] += dir[2];
           a = b;
-          b = setcorner(process, it[0], it[1], it[2])->value;
+          b = lattice_value(process, fp_tls->bvh_queue, it);
 
           if (a * b < 0.0f) {
             add[0] = it[0] - dir[0];
             add[1] = it[1] - dir[1];
             add[2] = it[2] - dir[2];
             DO_MIN(it, add);
-            add_cube(process, add[0], add[1], add[2]);
+            copy_v3_v3_int(cubes[d], add);
+            found[d] = true;
             break;
           }
         } while ((it[0] > lbn[0]) && (it[1] > lbn[1]) && (it[2] > lbn[2]) && (it[0] < rtf[0]) &&
                  (it[1] < rtf[1]) && (it[2] < rtf[2]));
+
+        d++;
       }
     }
   }
 }
 
+static void find_first_points_finalize(void *__restrict UNUSED(userdata),
+                                       void *__restrict userdata_chunk)
+{
+  FirstPointsTLS *fp_tls = userdata_chunk;
+  MEM_SAFE_FREE(fp_tls->bvh_queue);
+}
+
+/**
+ * Searches cubes to start polygonization from, for all metaelems in parallel.
+ * Found cubes are added to the cubes_out list of the process.
+ */
+static void find_first_points(PROCESS *process)
+{
+  const size_t dirs_len = (size_t)process->totelem * FIRST_POINTS_DIRS;
+  FirstPointsData data = {
+      .process = process,
+      .cubes = MEM_malloc_arrayN(dirs_len, sizeof(*data.cubes), __func__),
+      .found = MEM_malloc_arrayN(dirs_len, sizeof(*data.found), __func__),
+  };
+  FirstPointsTLS fp_tls = {NULL};
+  size_t i;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (process->totelem > 4);
+  settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+  settings.min_iter_per_thread = 1;
+  settings.userdata_chunk = &fp_tls;
+  settings.userdata_chunk_size = sizeof(fp_tls);
+  settings.func_finalize = find_first_points_finalize;
+  BLI_task_parallel_range(0, (int)process->totelem, &data, find_first_points_cb, &settings);
+
+  for (i = 0; i < dirs_len; i++) {
+    if (data.found[i]) {
+      CENTERLIST *out = BLI_memarena_alloc(process->pgn_elements, sizeof(CENTERLIST));
+      out->i = data.cubes[i][0];
+      out->j = data.cubes[i][1];
+      out->k = data.cubes[i][2];
+      out->next = process->cubes_out;
+      process->cubes_out = out;
+    }
+  }
+
+  MEM_freeN(data.cubes);
+  MEM_freeN(data.found);
+}
+
+#undef FIRST_POINTS_DIRS
+
+/**** Blocks ****/
+
+/**
+ * Creates the process polygonizing one block of the lattice,
+ * sharing the metaelems and the BVH of the main process.
+ */
+static PROCESS *block_process_new(const PROCESS *process, const int block[3])
+{
+  PROCESS *block_process = MEM_callocN(sizeof(PROCESS), __func__);
+
+  block_process->thresh = process->thresh;
+  block_process->size = process->size;
+  block_process->delta = process->delta;
+  block_process->converge_res = process->converge_res;
+  block_process->mainb = process->mainb;
+  block_process->totelem = process->totelem;
+  block_process->metaball_bvh = process->metaball_bvh;
+  block_process->allbb = process->allbb;
+  block_process->bvh_queue_size = process->bvh_queue_size;
+  copy_v3_v3_int(block_process->block, block);
+
+  /* Most blocks only hold a small part of the surface, start with small tables and buffers. */
+  block_process->hash_bit = BLOCK_HASHBIT_MIN;
+  block_process->centers = MEM_callocN(HASHSIZE_EX(BLOCK_HASHBIT_MIN) * sizeof(CENTERLIST *),
+                                       "mbproc->centers");
+  block_process->corners = MEM_callocN(HASHSIZE_EX(BLOCK_HASHBIT_MIN) * sizeof(CORNER *),
+                                       "mbproc->corners");
+  block_process->edges = MEM_callocN(2 * HASHSIZE_EX(BLOCK_HASHBIT_MIN) * sizeof(EDGELIST *),
+                                     "mbproc->edges");
+  block_process->bvh_queue = MEM_callocN(sizeof(MetaballBVHNode *) * process->bvh_queue_size,
+                                         "Metaball BVH Queue");
+  block_process->pgn_elements = BLI_memarena_new(MEM_SIZE_OPTIMAL(1 << 12), "Metaball memarena");
+
+  return block_process;
+}
+
+static void block_process_free(PROCESS *block_process)
+{
+  /* Owned by the main process. */
+  block_process->mainb = NULL;
+
+  freepolygonize(block_process);
+  MEM_SAFE_FREE(block_process->indices);
+  MEM_SAFE_FREE(block_process->co);
+  MEM_SAFE_FREE(block_process->no);
+  MEM_freeN(block_process);
+}
+
+/**
+ * Polygonizes the cubes passed to the block, and all cubes of the block they lead to.
+ */
+static void block_polygonize_cb(void *__restrict userdata,
+                                const int index,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PROCESS *block_process = ((PROCESS **)userdata)[index];
+  CENTERLIST *in;
+  CUBE c;
+
+  for (in = block_process->cubes_in; in; in = in->next) {
+    add_cube(block_process, in->i, in->j, in->k);
+
+    while (block_process->cubes != NULL) {
+      c = block_process->cubes->cube;
+      block_process->cubes = block_process->cubes->next;
+
+      docube(block_process, &c);
+    }
+  }
+}
+
+typedef struct MetaballBlocks {
+  GHash *hash;     /* block processes by lattice location of the block */
+  PROCESS **array; /* block processes in order of creation */
+  unsigned int len, size;
+} MetaballBlocks;
+
+/**
+ * Passes cubes added outside of given process to the blocks containing them,
+ * creating blocks as needed.
+ */
+static void blocks_pass_cubes_out(const PROCESS *process,
+                                  PROCESS *from_process,
+                                  MetaballBlocks *blocks)
+{
+  CENTERLIST *out;
+
+  for (out = from_process->cubes_out; out; out = out->next) {
+    const int block[4] = {
+        block_of_lattice(out->i), block_of_lattice(out->j), block_of_lattice(out->k), 0};
+    PROCESS *block_process = BLI_ghash_lookup(blocks->hash, block);
+    CENTERLIST *in;
+
+    if (block_process == NULL) {
+      block_process = block_process_new(process, block);
+      BLI_ghash_insert(blocks->hash, block_process->block, block_process);
+
+      if (UNLIKELY(blocks->len == blocks->size)) {
+        blocks->size += 64;
+        blocks->array = MEM_reallocN(blocks->array, sizeof(PROCESS *) * blocks->size);
+      }
+      blocks->array[blocks->len++] = block_process;
+    }
+
+    in = BLI_memarena_alloc(block_process->pgn_elements, sizeof(CENTERLIST));
+    in->i = out->i;
+    in->j = out->j;
+    in->k = out->k;
+    in->next = block_process->cubes_in;
+    block_process->cubes_in = in;
+  }
+  from_process->cubes_out = NULL;
+}
+
+/**
+ * \return true when the edge is shared by cubes of different blocks.
+ */
+static bool is_seam_edge(const EDGELIST *e)
+{
+  return ((e->i1 == e->i2) && (e->i1 & (BLOCK_SIZE - 1)) == 0) ||
+         ((e->j1 == e->j2) && (e->j1 & (BLOCK_SIZE - 1)) == 0) ||
+         ((e->k1 == e->k2) && (e->k1 & (BLOCK_SIZE - 1)) == 0);
+}
+
+/**
+ * Appends the surface of a block to the main process.
+ * Vertices on edges shared with other blocks are computed by each of them, but only added once.
+ */
+static void block_merge(PROCESS *process, const PROCESS *block_process)
+{
+  int *vert_map = MEM_malloc_arrayN(block_process->curvertex, sizeof(int), __func__);
+  const EDGELIST *e;
+  unsigned int a;
+  size_t index;
+
+  const size_t edges_len = 2 * HASHSIZE_EX(block_process->hash_bit);
+
+  copy_vn_i(vert_map, (int)block_process->curvertex, -1);
+
+  /* Vertices already added by other blocks. */
+  for (index = 0; index < edges_len; index++) {
+    for (e = block_process->edges[index]; e; e = e->next) {
+      if (is_seam_edge(e)) {
+        vert_map[e->vid] = getedge(process, e->i1, e->j1, e->k1, e->i2, e->j2, e->k2);
+      }
+    }
+  }
+
+  for (a = 0; a < block_process->curvertex; a++) {
+    if (vert_map[a] == -1) {
+      addtovertices(process, block_process->co[a], block_process->no[a]);
+      vert_map[a] = (int)process->curvertex - 1;
+#ifdef USE_ACCUM_NORMAL
+      /* Accumulated again by the merged faces. */
+      zero_v3(process->no[vert_map[a]]);
+#endif
+    }
+  }
+
+  for (index = 0; index < edges_len; index++) {
+    for (e = block_process->edges[index]; e; e = e->next) {
+      if (is_seam_edge(e) &&
+          getedge(process, e->i1, e->j1, e->k1, e->i2, e->j2, e->k2) == -1) {
+        setedge(process, e->i1, e->j1, e->k1, e->i2, e->j2, e->k2, vert_map[e->vid]);
+      }
+    }
+  }
+
+  for (a = 0; a < block_process->curindex; a++) {
+    const int *cur = block_process->indices[a];
+    make_face(process, vert_map[cur[0]], vert_map[cur[1]], vert_map[cur[2]], vert_map[cur[3]]);
+  }
+
+  MEM_freeN(vert_map);
+}
+
 /**
  * The main polygonization proc.
  * Allocates memory, makes cubetable,
  * finds starting surface points
  * and processes cubes on the stack until none left.
+ *
+ * The lattice is split into blocks of #BLOCK_SIZE cubes per axis, each polygonized by its own
+ * process. Blocks run in parallel rounds, cubes added outside of a block are polygonized by the
+ * block containing them in the next round. Results are merged in order of block creation,
+ * so they don't depend on the number of threads.
  */
 static void polygonize(PROCESS *process)
 {
-  CUBE c;
-  unsigned int i;
+  MetaballBlocks blocks = {NULL};
+  PROCESS **blocks_todo;
+  unsigned int i, blocks_todo_len;
+  unsigned int totvertex = 0, totindex = 0;
 
-  process->centers = MEM_callocN(HASHSIZE * sizeof(CENTERLIST *), "mbproc->centers");
-  process->corners = MEM_callocN(HASHSIZE * sizeof(CORNER *), "mbproc->corners");
+  /* Only holds the edges on seams between blocks. */
+  process->hash_bit = HASHBIT;
   process->edges = MEM_callocN(2 * HASHSIZE * sizeof(EDGELIST *), "mbproc->edges");
-  process->bvh_queue = MEM_callocN(sizeof(MetaballBVHNode *) * process->bvh_queue_size,
-                                   "Metaball BVH Queue");
 
   makecubetable();
 
-  for (i = 0; i < process->totelem; i++) {
-    find_first_points(process, i);
+  blocks.hash = BLI_ghash_new(BLI_ghashutil_inthash_v4_p, BLI_ghashutil_inthash_v4_cmp, __func__);
+
+  find_first_points(process);
+  blocks_pass_cubes_out(process, process, &blocks);
+
+  while (true) {
+    blocks_todo = MEM_malloc_arrayN(blocks.len, sizeof(*blocks_todo), __func__);
+    blocks_todo_len = 0;
+    for (i = 0; i < blocks.len; i++) {
+      if (blocks.array[i]->cubes_in) {
+        blocks_todo[blocks_todo_len++] = blocks.array[i];
+      }
+    }
+
+    if (blocks_todo_len == 0) {
+      MEM_freeN(blocks_todo);
+      break;
+    }
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (blocks_todo_len > 1);
+    settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, (int)blocks_todo_len, blocks_todo, block_polygonize_cb, &settings);
+
+    for (i = 0; i < blocks_todo_len; i++) {
+      blocks_todo[i]->cubes_in = NULL;
+    }
+    for (i = 0; i < blocks_todo_len; i++) {
+      blocks_pass_cubes_out(process, blocks_todo[i], &blocks);
+    }
+    MEM_freeN(blocks_todo);
   }
 
-  while (process->cubes != NULL) {
-    c = process->cubes->cube;
-    process->cubes = process->cubes->next;
+  /* Free what isn't needed for merging before the result is allocated,
+   * and allocate it at once. Vertices on seams are counted for each block sharing them. */
+  for (i = 0; i < blocks.len; i++) {
+    PROCESS *block_process = blocks.array[i];
+    MEM_SAFE_FREE(block_process->centers);
+    MEM_SAFE_FREE(block_process->corners);
+    MEM_SAFE_FREE(block_process->bvh_queue);
+    totvertex += block_process->curvertex;
+    totindex += block_process->curindex;
+  }
+  if (totvertex != 0) {
+    process->totvertex = totvertex;
+    process->co = MEM_mallocN(sizeof(float[3]) * totvertex, "mbproc->co");
+    process->no = MEM_mallocN(sizeof(float[3]) * totvertex, "mbproc->no");
+  }
+  if (totindex != 0) {
+    process->totindex = totindex;
+    process->indices = MEM_mallocN(sizeof(int[4]) * totindex, "mbproc->indices");
+  }
 
-    docube(process, &c);
+  for (i = 0; i < blocks.len; i++) {
+    block_merge(process, blocks.array[i]);
+    block_process_free(blocks.array[i]);
   }
+
+  BLI_ghash_free(blocks.hash, NULL, NULL);
+  MEM_SAFE_FREE(blocks.array);
 }
 
 /**
@@ -37,6 +37,9 @@
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_rand.h"
+#include "BLI_sort_utils.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "BKE_bvhutils.h"
 #include "BKE_customdata.h"
@@ -59,15 +62,23 @@ static bool mesh_remap_bvhtree_query_nearest(BVHTreeFromMesh *treedata,
                                              const float max_dist_sq,
                                              float *r_hit_dist)
 {
-  /* Use local proximity heuristics (to reduce the nearest search). */
+  float dist_sq = max_dist_sq;
+
+  /* Use local proximity heuristics (to reduce the nearest search).
+   * The previous hit only gives a (slightly enlarged) bound to the search, so the result is the
+   * same as without it, and doesn't depend on which elements a thread processed before. */
   if (nearest->index != -1) {
-    nearest->dist_sq = min_ff(len_squared_v3v3(co, nearest->co), max_dist_sq);
-  }
-  else {
-    nearest->dist_sq = max_dist_sq;
+    dist_sq = min_ff((len_squared_v3v3(co, nearest->co) + FLT_EPSILON) * 1.001f, max_dist_sq);
   }
+  nearest->index = -1;
+  nearest->dist_sq = dist_sq;
   /* Compute and store result. If invalid (-1 index), keep FLT_MAX dist. */
   BLI_bvhtree_find_nearest(treedata->tree, co, nearest, treedata->nearest_callback, treedata);
+  if ((nearest->index == -1) && (dist_sq < max_dist_sq)) {
+    /* Only possible with precision issues in the bound, search again without it. */
+    nearest->dist_sq = max_dist_sq;
+    BLI_bvhtree_find_nearest(treedata->tree, co, nearest, treedata->nearest_callback, treedata);
+  }
 
   if ((nearest->index != -1) && (nearest->dist_sq <= max_dist_sq)) {
     *r_hit_dist = sqrtf(nearest->dist_sq);
@@ -369,24 +380,35 @@ void BKE_mesh_remap_free(MeshPairRemap *map)
   map->mem = NULL;
 }
 
-static void mesh_remap_item_define(MeshPairRemap *map,
-                                   const int index,
-                                   const float UNUSED(hit_dist),
-                                   const int island,
-                                   const int sources_num,
-                                   const int *indices_src,
-                                   const float *weights_src)
+/**
+ * \param mem_lock: Protects the memory arena of \a map, when items are defined from several threads
+ * (each item is only ever written by one thread).
+ */
+static void mesh_remap_item_define_ex(MeshPairRemap *map,
+                                      SpinLock *mem_lock,
+                                      const int index,
+                                      const float UNUSED(hit_dist),
+                                      const int island,
+                                      const int sources_num,
+                                      const int *indices_src,
+                                      const float *weights_src)
 {
   MeshPairRemapItem *mapit = &map->items[index];
   MemArena *mem = map->mem;
 
   if (sources_num) {
     mapit->sources_num = sources_num;
+    if (mem_lock) {
+      BLI_spin_lock(mem_lock);
+    }
     mapit->indices_src = BLI_memarena_alloc(mem,
                                             sizeof(*mapit->indices_src) * (size_t)sources_num);
-    memcpy(mapit->indices_src, indices_src, sizeof(*mapit->indices_src) * (size_t)sources_num);
     mapit->weights_src = BLI_memarena_alloc(mem,
                                             sizeof(*mapit->weights_src) * (size_t)sources_num);
+    if (mem_lock) {
+      BLI_spin_unlock(mem_lock);
+    }
+    memcpy(mapit->indices_src, indices_src, sizeof(*mapit->indices_src) * (size_t)sources_num);
     memcpy(mapit->weights_src, weights_src, sizeof(*mapit->weights_src) * (size_t)sources_num);
   }
   else {
@@ -399,13 +421,25 @@ static void mesh_remap_item_define(MeshPairRemap *map,
   mapit->island = island;
 }
 
+static void mesh_remap_item_define(MeshPairRemap *map,
+                                   const int index,
+                                   const float hit_dist,
+                                   const int island,
+                                   const int sources_num,
+                                   const int *indices_src,
+                                   const float *weights_src)
+{
+  mesh_remap_item_define_ex(
+      map, NULL, index, hit_dist, island, sources_num, indices_src, weights_src);
+}
+
 void BKE_mesh_remap_item_define_invalid(MeshPairRemap *map, const int index)
 {
   mesh_remap_item_define(map, index, FLT_MAX, 0, 0, NULL, NULL);
 }
 
 static int mesh_remap_interp_poly_data_get(const MPoly *mp,
-                                           MLoop *mloops,
+                                           const MLoop *mloops,
                                            const float (*vcos_src)[3],
                                            const float point[3],
                                            size_t *buff_size,
@@ -416,7 +450,7 @@ static int mesh_remap_interp_poly_data_get(const MPoly *mp,
                                            const bool do_weights,
                                            int *r_closest_index)
 {
-  MLoop *ml;
+  const MLoop *ml;
   float(*vco)[3];
   float ref_dist_sq = FLT_MAX;
   int *index;
@@ -493,6 +527,283 @@ typedef struct IslandResult {
 /* Will be enough in 99% of cases. */
 #define MREMAP_DEFAULT_BUFSIZE 32
 
+/* Map elements in parallel when there are more than this. */
+#define MREMAP_THREAD_ITEMS_THRESHOLD 1000
+
+/**
+ * Thread local data of the parallel mapping loops, buffers are allocated on first use.
+ *
+ * The result of each element only depends on the element itself, never on the ones processed
+ * before it by the same thread, so the map is the same whatever the amount of threads.
+ */
+typedef struct MeshRemapTLS {
+  /** Last nearest hit, only used as a hint for the next nearest query. */
+  BVHTreeNearest nearest;
+  BVHTreeRayHit rayhit;
+
+  /** Buffers for #mesh_remap_interp_poly_data_get and the sources of sampled elements. */
+  size_t buff_size;
+  float (*vcos)[3];
+  int *indices;
+  float *weights;
+
+  /** Weights of all source elements when sampling, reset to zero after each element. */
+  float *weights_src;
+
+  /** Per source island results of the loops of a dest poly. */
+  IslandResult **islands_res;
+  size_t islands_res_buff_size;
+  int islands_num;
+  BLI_AStarSolution as_solution;
+
+  /** Projected dest poly when sampling polys. */
+  size_t poly_size;
+  float (*poly_vcos_2d)[2];
+  int (*tri_vidx_2d)[3];
+  RNG *rng;
+} MeshRemapTLS;
+
+static void mesh_remap_tls_buffers_ensure(MeshRemapTLS *tls, const size_t size)
+{
+  if (tls->vcos == NULL) {
+    tls->buff_size = max_zz(size, MREMAP_DEFAULT_BUFSIZE);
+    tls->vcos = MEM_mallocN(sizeof(*tls->vcos) * tls->buff_size, __func__);
+    tls->indices = MEM_mallocN(sizeof(*tls->indices) * tls->buff_size, __func__);
+    tls->weights = MEM_mallocN(sizeof(*tls->weights) * tls->buff_size, __func__);
+  }
+  else if (size > tls->buff_size) {
+    tls->buff_size = size;
+    tls->vcos = MEM_reallocN(tls->vcos, sizeof(*tls->vcos) * tls->buff_size);
+    tls->indices = MEM_reallocN(tls->indices, sizeof(*tls->indices) * tls->buff_size);
+    tls->weights = MEM_reallocN(tls->weights, sizeof(*tls->weights) * tls->buff_size);
+  }
+}
+
+static void mesh_remap_tls_finalize(void *__restrict UNUSED(userdata),
+                                    void *__restrict userdata_chunk)
+{
+  MeshRemapTLS *tls = userdata_chunk;
+
+  MEM_SAFE_FREE(tls->vcos);
+  MEM_SAFE_FREE(tls->indices);
+  MEM_SAFE_FREE(tls->weights);
+  MEM_SAFE_FREE(tls->weights_src);
+  if (tls->islands_res) {
+    for (int i = 0; i < tls->islands_num; i++) {
+      MEM_freeN(tls->islands_res[i]);
+    }
+    MEM_freeN(tls->islands_res);
+  }
+  BLI_astar_solution_free(&tls->as_solution);
+  MEM_SAFE_FREE(tls->poly_vcos_2d);
+  MEM_SAFE_FREE(tls->tri_vidx_2d);
+  if (tls->rng) {
+    BLI_rng_free(tls->rng);
+  }
+}
+
+/**
+ * Normalize the weights of the sources hit while sampling an element.
+ *
+ * \param indices: The source elements with a non-zero weight in \a weights_src,
+ * sorted in place, their weights are reset to zero for the next element.
+ */
+static void mesh_remap_sampled_sources_get(float *weights_src,
+                                           int *indices,
+                                           const int sources_num,
+                                           const float totweights,
+                                           float *r_weights)
+{
+  qsort(indices, (size_t)sources_num, sizeof(*indices), BLI_sortutil_cmp_int);
+  for (int j = 0; j < sources_num; j++) {
+    r_weights[j] = weights_src[indices[j]] / totweights;
+    weights_src[indices[j]] = 0.0f;
+  }
+}
+
+static void mesh_remap_parallel_range(const int items_num,
+                                      void *userdata,
+                                      TaskParallelRangeFunc func)
+{
+  MeshRemapTLS tls = {{0}};
+  tls.nearest.index = -1;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (items_num > MREMAP_THREAD_ITEMS_THRESHOLD);
+  settings.userdata_chunk = &tls;
+  settings.userdata_chunk_size = sizeof(tls);
+  settings.func_finalize = mesh_remap_tls_finalize;
+  BLI_task_parallel_range(0, items_num, userdata, func, &settings);
+}
+
+typedef struct MeshRemapVertsData {
+  int mode;
+  const SpaceTransform *space_transform;
+  float max_dist;
+  float max_dist_sq;
+  float ray_radius;
+  const MVert *verts_dst;
+  BVHTreeFromMesh *treedata;
+  const MEdge *edges_src;
+  const MPoly *polys_src;
+  const MLoop *loops_src;
+  const float (*vcos_src)[3];
+  MeshPairRemap *r_map;
+  SpinLock *mem_lock;
+} MeshRemapVertsData;
+
+static void mesh_remap_verts_task_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict tls)
+{
+  const MeshRemapVertsData *data = userdata;
+  MeshRemapTLS *data_tls = tls->userdata_chunk;
+  const int mode = data->mode;
+  const SpaceTransform *space_transform = data->space_transform;
+  BVHTreeFromMesh *treedata = data->treedata;
+  BVHTreeNearest *nearest = &data_tls->nearest;
+  const float full_weight = 1.0f;
+  float hit_dist;
+  float tmp_co[3], tmp_no[3];
+
+  copy_v3_v3(tmp_co, data->verts_dst[i].co);
+
+  if (mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
+    BVHTreeRayHit *rayhit = &data_tls->rayhit;
+
+    normal_short_to_float_v3(tmp_no, data->verts_dst[i].no);
+
+    /* Convert the vertex to tree coordinates, if needed. */
+    if (space_transform) {
+      BLI_space_transform_apply(space_transform, tmp_co);
+      BLI_space_transform_apply_normal(space_transform, tmp_no);
+    }
+
+    if (mesh_remap_bvhtree_query_raycast(
+            treedata, rayhit, tmp_co, tmp_no, data->ray_radius, data->max_dist, &hit_dist)) {
+      const MLoopTri *lt = &treedata->looptri[rayhit->index];
+      const MPoly *mp_src = &data->polys_src[lt->poly];
+      int sources_num;
+
+      mesh_remap_tls_buffers_ensure(data_tls, 0);
+      sources_num = mesh_remap_interp_poly_data_get(mp_src,
+                                                    data->loops_src,
+                                                    data->vcos_src,
+                                                    rayhit->co,
+                                                    &data_tls->buff_size,
+                                                    &data_tls->vcos,
+                                                    false,
+                                                    &data_tls->indices,
+                                                    &data_tls->weights,
+                                                    true,
+                                                    NULL);
+
+      mesh_remap_item_define_ex(data->r_map,
+                                data->mem_lock,
+                                i,
+                                hit_dist,
+                                0,
+                                sources_num,
+                                data_tls->indices,
+                                data_tls->weights);
+    }
+    else {
+      /* No source for this dest vertex! */
+      BKE_mesh_remap_item_define_invalid(data->r_map, i);
+    }
+    return;
+  }
+
+  /* Convert the vertex to tree coordinates, if needed. */
+  if (space_transform) {
+    BLI_space_transform_apply(space_transform, tmp_co);
+  }
+
+  if (!mesh_remap_bvhtree_query_nearest(
+          treedata, nearest, tmp_co, data->max_dist_sq, &hit_dist)) {
+    /* No source for this dest vertex! */
+    BKE_mesh_remap_item_define_invalid(data->r_map, i);
+  }
+  else if (mode == MREMAP_MODE_VERT_NEAREST) {
+    mesh_remap_item_define_ex(
+        data->r_map, data->mem_lock, i, hit_dist, 0, 1, &nearest->index, &full_weight);
+  }
+  else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
+    const MEdge *me = &data->edges_src[nearest->index];
+    const float *v1cos = data->vcos_src[me->v1];
+    const float *v2cos = data->vcos_src[me->v2];
+
+    if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
+      const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
+      const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
+      const int index = (int)((dist_v1 > dist_v2) ? me->v2 : me->v1);
+      mesh_remap_item_define_ex(
+          data->r_map, data->mem_lock, i, hit_dist, 0, 1, &index, &full_weight);
+    }
+    else if (mode == MREMAP_MODE_VERT_EDGEINTERP_NEAREST) {
+      int indices[2];
+      float weights[2];
+
+      indices[0] = (int)me->v1;
+      indices[1] = (int)me->v2;
+
+      /* Weight is inverse of point factor here... */
+      weights[0] = line_point_factor_v3(tmp_co, v2cos, v1cos);
+      CLAMP(weights[0], 0.0f, 1.0f);
+      weights[1] = 1.0f - weights[0];
+
+      mesh_remap_item_define_ex(data->r_map, data->mem_lock, i, hit_dist, 0, 2, indices, weights);
+    }
+  }
+  else {
+    const MLoopTri *lt = &treedata->looptri[nearest->index];
+    const MPoly *mp = &data->polys_src[lt->poly];
+
+    mesh_remap_tls_buffers_ensure(data_tls, 0);
+
+    if (mode == MREMAP_MODE_VERT_POLY_NEAREST) {
+      int index;
+      mesh_remap_interp_poly_data_get(mp,
+                                      data->loops_src,
+                                      data->vcos_src,
+                                      nearest->co,
+                                      &data_tls->buff_size,
+                                      &data_tls->vcos,
+                                      false,
+                                      &data_tls->indices,
+                                      &data_tls->weights,
+                                      false,
+                                      &index);
+
+      mesh_remap_item_define_ex(
+          data->r_map, data->mem_lock, i, hit_dist, 0, 1, &index, &full_weight);
+    }
+    else if (mode == MREMAP_MODE_VERT_POLYINTERP_NEAREST) {
+      const int sources_num = mesh_remap_interp_poly_data_get(mp,
+                                                              data->loops_src,
+                                                              data->vcos_src,
+                                                              nearest->co,
+                                                              &data_tls->buff_size,
+                                                              &data_tls->vcos,
+                                                              false,
+                                                              &data_tls->indices,
+                                                              &data_tls->weights,
+                                                              true,
+                                                              NULL);
+
+      mesh_remap_item_define_ex(data->r_map,
+                                data->mem_lock,
+                                i,
+                                hit_dist,
+                                0,
+                                sources_num,
+                                data_tls->indices,
+                                data_tls->weights);
+    }
+  }
+}
+
 void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
                                          const SpaceTransform *space_transform,
                                          const float max_dist,
@@ -519,202 +830,371 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
   }
   else {
     BVHTreeFromMesh treedata = {NULL};
-    BVHTreeNearest nearest = {0};
-    BVHTreeRayHit rayhit = {0};
-    float hit_dist;
-    float tmp_co[3], tmp_no[3];
+    float(*vcos_src)[3] = NULL;
+    SpinLock mem_lock;
+
+    MeshRemapVertsData data = {
+        .mode = mode,
+        .space_transform = space_transform,
+        .max_dist = max_dist,
+        .max_dist_sq = max_dist_sq,
+        .ray_radius = ray_radius,
+        .verts_dst = verts_dst,
+        .treedata = &treedata,
+        .edges_src = me_src->medge,
+        .polys_src = me_src->mpoly,
+        .loops_src = me_src->mloop,
+        .r_map = r_map,
+        .mem_lock = &mem_lock,
+    };
 
     if (mode == MREMAP_MODE_VERT_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
-      nearest.index = -1;
-
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
+    }
+    else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
+      vcos_src = BKE_mesh_vert_coords_alloc(me_src, NULL);
+      BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
+    }
+    else if (ELEM(mode,
+                  MREMAP_MODE_VERT_POLY_NEAREST,
+                  MREMAP_MODE_VERT_POLYINTERP_NEAREST,
+                  MREMAP_MODE_VERT_POLYINTERP_VNORPROJ)) {
+      vcos_src = BKE_mesh_vert_coords_alloc(me_src, NULL);
+      BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
+    }
+    else {
+      CLOG_WARN(&LOG, "Unsupported mesh-to-mesh vertex mapping mode (%d)!", mode);
+      memset(r_map->items, 0, sizeof(*r_map->items) * (size_t)numverts_dst);
+      return;
+    }
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+    data.vcos_src = (const float(*)[3])vcos_src;
+    BLI_spin_init(&mem_lock);
+    mesh_remap_parallel_range(numverts_dst, &data, mesh_remap_verts_task_cb);
+    BLI_spin_end(&mem_lock);
 
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
-        }
-        else {
-          /* No source for this dest vertex! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
+    if (vcos_src) {
+      MEM_freeN(vcos_src);
     }
-    else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
-      MEdge *edges_src = me_src->medge;
-      float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
+    free_bvhtree_from_mesh(&treedata);
+  }
+}
 
-      BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
+/** Nearest source vertex of a dest vertex. */
+typedef struct MeshRemapVertHit {
+  float hit_dist;
+  int index;
+} MeshRemapVertHit;
+
+typedef struct MeshRemapEdgesData {
+  int mode;
+  const SpaceTransform *space_transform;
+  float max_dist;
+  float max_dist_sq;
+  float ray_radius;
+  const MVert *verts_dst;
+  const MEdge *edges_dst;
+  BVHTreeFromMesh *treedata;
+  const MEdge *edges_src;
+  int numedges_src;
+  const MPoly *polys_src;
+  const MLoop *loops_src;
+  const float (*vcos_src)[3];
+
+  /* #MREMAP_MODE_EDGE_VERT_NEAREST only. */
+  const MeshElemMap *vert_to_edge_src_map;
+  const BLI_bitmap *verts_used_dst;
+  MeshRemapVertHit *v_dst_to_src_map;
+
+  MeshPairRemap *r_map;
+  SpinLock *mem_lock;
+} MeshRemapEdgesData;
+
+/** Compute closest verts only once, for all dest verts used by edges. */
+static void mesh_remap_edges_vert_nearest_task_cb(void *__restrict userdata,
+                                                  const int vidx_dst,
+                                                  const TaskParallelTLS *__restrict tls)
+{
+  const MeshRemapEdgesData *data = userdata;
+  MeshRemapTLS *data_tls = tls->userdata_chunk;
+  MeshRemapVertHit *v_hit = &data->v_dst_to_src_map[vidx_dst];
+  float hit_dist;
+  float tmp_co[3];
 
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
+  if (!BLI_BITMAP_TEST(data->verts_used_dst, vidx_dst)) {
+    return;
+  }
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+  copy_v3_v3(tmp_co, data->verts_dst[vidx_dst].co);
 
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          MEdge *me = &edges_src[nearest.index];
-          const float *v1cos = vcos_src[me->v1];
-          const float *v2cos = vcos_src[me->v2];
-
-          if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
-            const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
-            const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
-            const int index = (int)((dist_v1 > dist_v2) ? me->v2 : me->v1);
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
-          }
-          else if (mode == MREMAP_MODE_VERT_EDGEINTERP_NEAREST) {
-            int indices[2];
-            float weights[2];
+  /* Convert the vertex to tree coordinates, if needed. */
+  if (data->space_transform) {
+    BLI_space_transform_apply(data->space_transform, tmp_co);
+  }
 
-            indices[0] = (int)me->v1;
-            indices[1] = (int)me->v2;
+  if (mesh_remap_bvhtree_query_nearest(
+          data->treedata, &data_tls->nearest, tmp_co, data->max_dist_sq, &hit_dist)) {
+    v_hit->hit_dist = hit_dist;
+    v_hit->index = data_tls->nearest.index;
+  }
+  else {
+    /* No source for this dest vert! */
+    v_hit->hit_dist = FLT_MAX;
+    v_hit->index = -1;
+  }
+}
 
-            /* Weight is inverse of point factor here... */
-            weights[0] = line_point_factor_v3(tmp_co, v2cos, v1cos);
-            CLAMP(weights[0], 0.0f, 1.0f);
-            weights[1] = 1.0f - weights[0];
+static void mesh_remap_edges_vert_task_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MeshRemapEdgesData *data = userdata;
+  const MVert *verts_dst = data->verts_dst;
+  const MEdge *edges_src = data->edges_src;
+  const float(*vcos_src)[3] = data->vcos_src;
+  const MEdge *e_dst = &data->edges_dst[i];
+  const float full_weight = 1.0f;
+  float best_totdist = FLT_MAX;
+  int best_eidx_src = -1;
+  int j;
+
+  /* Now, check all source edges of closest sources vertices,
+   * and select the one giving the smallest total verts-to-verts distance. */
+  for (j = 2; j--;) {
+    const unsigned int vidx_dst = j ? e_dst->v1 : e_dst->v2;
+    const float first_dist = data->v_dst_to_src_map[vidx_dst].hit_dist;
+    const int vidx_src = data->v_dst_to_src_map[vidx_dst].index;
+    int *eidx_src, k;
+
+    if (vidx_src < 0) {
+      continue;
+    }
 
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 2, indices, weights);
-          }
-        }
-        else {
-          /* No source for this dest vertex! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
+    eidx_src = data->vert_to_edge_src_map[vidx_src].indices;
+    k = data->vert_to_edge_src_map[vidx_src].count;
 
-      MEM_freeN(vcos_src);
+    for (; k--; eidx_src++) {
+      const MEdge *e_src = &edges_src[*eidx_src];
+      const float *other_co_src = vcos_src[BKE_mesh_edge_other_vert(e_src, vidx_src)];
+      const float *other_co_dst = verts_dst[BKE_mesh_edge_other_vert(e_dst, (int)vidx_dst)].co;
+      const float totdist = first_dist + len_v3v3(other_co_src, other_co_dst);
+
+      if (totdist < best_totdist) {
+        best_totdist = totdist;
+        best_eidx_src = *eidx_src;
+      }
     }
-    else if (ELEM(mode,
-                  MREMAP_MODE_VERT_POLY_NEAREST,
-                  MREMAP_MODE_VERT_POLYINTERP_NEAREST,
-                  MREMAP_MODE_VERT_POLYINTERP_VNORPROJ)) {
-      MPoly *polys_src = me_src->mpoly;
-      MLoop *loops_src = me_src->mloop;
-      float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
+  }
 
-      size_t tmp_buff_size = MREMAP_DEFAULT_BUFSIZE;
-      float(*vcos)[3] = MEM_mallocN(sizeof(*vcos) * tmp_buff_size, __func__);
-      int *indices = MEM_mallocN(sizeof(*indices) * tmp_buff_size, __func__);
-      float *weights = MEM_mallocN(sizeof(*weights) * tmp_buff_size, __func__);
+  if (best_eidx_src >= 0) {
+    const float *co1_src = vcos_src[edges_src[best_eidx_src].v1];
+    const float *co2_src = vcos_src[edges_src[best_eidx_src].v2];
+    const float *co1_dst = verts_dst[e_dst->v1].co;
+    const float *co2_dst = verts_dst[e_dst->v2].co;
+    float co_src[3], co_dst[3];
+    float hit_dist;
 
-      BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
+    /* TODO: would need an isect_seg_seg_v3(), actually! */
+    const int isect_type = isect_line_line_v3(co1_src, co2_src, co1_dst, co2_dst, co_src, co_dst);
+    if (isect_type != 0) {
+      const float fac_src = line_point_factor_v3(co_src, co1_src, co2_src);
+      const float fac_dst = line_point_factor_v3(co_dst, co1_dst, co2_dst);
+      if (fac_src < 0.0f) {
+        copy_v3_v3(co_src, co1_src);
+      }
+      else if (fac_src > 1.0f) {
+        copy_v3_v3(co_src, co2_src);
+      }
+      if (fac_dst < 0.0f) {
+        copy_v3_v3(co_dst, co1_dst);
+      }
+      else if (fac_dst > 1.0f) {
+        copy_v3_v3(co_dst, co2_dst);
+      }
+    }
+    hit_dist = len_v3v3(co_dst, co_src);
+    mesh_remap_item_define_ex(
+        data->r_map, data->mem_lock, i, hit_dist, 0, 1, &best_eidx_src, &full_weight);
+  }
+  else {
+    /* No source for this dest edge! */
+    BKE_mesh_remap_item_define_invalid(data->r_map, i);
+  }
+}
 
-      if (mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
-        for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, verts_dst[i].co);
-          normal_short_to_float_v3(tmp_no, verts_dst[i].no);
+static void mesh_remap_edges_nearest_task_cb(void *__restrict userdata,
+                                             const int i,
+                                             const TaskParallelTLS *__restrict tls)
+{
+  const MeshRemapEdgesData *data = userdata;
+  MeshRemapTLS *data_tls = tls->userdata_chunk;
+  BVHTreeNearest *nearest = &data_tls->nearest;
+  const MVert *verts_dst = data->verts_dst;
+  const MEdge *edges_dst = data->edges_dst;
+  const float full_weight = 1.0f;
+  float hit_dist;
+  float tmp_co[3];
 
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-            BLI_space_transform_apply_normal(space_transform, tmp_no);
-          }
+  interp_v3_v3v3(tmp_co, verts_dst[edges_dst[i].v1].co, verts_dst[edges_dst[i].v2].co, 0.5f);
 
-          if (mesh_remap_bvhtree_query_raycast(
-                  &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist)) {
-            const MLoopTri *lt = &treedata.looptri[rayhit.index];
-            MPoly *mp_src = &polys_src[lt->poly];
-            const int sources_num = mesh_remap_interp_poly_data_get(mp_src,
-                                                                    loops_src,
-                                                                    (const float(*)[3])vcos_src,
-                                                                    rayhit.co,
-                                                                    &tmp_buff_size,
-                                                                    &vcos,
-                                                                    false,
-                                                                    &indices,
-                                                                    &weights,
-                                                                    true,
-                                                                    NULL);
+  /* Convert the vertex to tree coordinates, if needed. */
+  if (data->space_transform) {
+    BLI_space_transform_apply(data->space_transform, tmp_co);
+  }
 
-            mesh_remap_item_define(r_map, i, hit_dist, 0, sources_num, indices, weights);
-          }
-          else {
-            /* No source for this dest vertex! */
-            BKE_mesh_remap_item_define_invalid(r_map, i);
-          }
-        }
+  if (!mesh_remap_bvhtree_query_nearest(
+          data->treedata, nearest, tmp_co, data->max_dist_sq, &hit_dist)) {
+    /* No source for this dest edge! */
+    BKE_mesh_remap_item_define_invalid(data->r_map, i);
+  }
+  else if (data->mode == MREMAP_MODE_EDGE_NEAREST) {
+    mesh_remap_item_define_ex(
+        data->r_map, data->mem_lock, i, hit_dist, 0, 1, &nearest->index, &full_weight);
+  }
+  else if (data->mode == MREMAP_MODE_EDGE_POLY_NEAREST) {
+    const MLoopTri *lt = &data->treedata->looptri[nearest->index];
+    const MPoly *mp_src = &data->polys_src[lt->poly];
+    const MLoop *ml_src = &data->loops_src[mp_src->loopstart];
+    int nloops = mp_src->totloop;
+    float best_dist_sq = FLT_MAX;
+    int best_eidx_src = -1;
+
+    for (; nloops--; ml_src++) {
+      const MEdge *med_src = &data->edges_src[ml_src->e];
+      const float *co1_src = data->vcos_src[med_src->v1];
+      const float *co2_src = data->vcos_src[med_src->v2];
+      float co_src[3];
+      float dist_sq;
+
+      interp_v3_v3v3(co_src, co1_src, co2_src, 0.5f);
+      dist_sq = len_squared_v3v3(tmp_co, co_src);
+      if (dist_sq < best_dist_sq) {
+        best_dist_sq = dist_sq;
+        best_eidx_src = (int)ml_src->e;
       }
-      else {
-        nearest.index = -1;
+    }
+    if (best_eidx_src >= 0) {
+      mesh_remap_item_define_ex(
+          data->r_map, data->mem_lock, i, hit_dist, 0, 1, &best_eidx_src, &full_weight);
+    }
+  }
+}
 
-        for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, verts_dst[i].co);
+#define MREMAP_EDGE_RAYS_MIN 5
+#define MREMAP_EDGE_RAYS_MAX 100
 
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-          }
+static void mesh_remap_edges_vnorproj_task_cb(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict tls)
+{
+  /* For each dst edge, we sample some rays from it (interpolated from its vertices)
+   * and use their hits to interpolate from source edges. */
+  const MeshRemapEdgesData *data = userdata;
+  MeshRemapTLS *data_tls = tls->userdata_chunk;
+  const SpaceTransform *space_transform = data->space_transform;
+  const float ray_radius = data->ray_radius;
+  const MEdge *me = &data->edges_dst[i];
+  float v1_co[3], v2_co[3];
+  float v1_no[3], v2_no[3];
+  float tmp_co[3], tmp_no[3];
+  float hit_dist;
 
-          if (mesh_remap_bvhtree_query_nearest(
-                  &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-            const MLoopTri *lt = &treedata.looptri[nearest.index];
-            MPoly *mp = &polys_src[lt->poly];
-
-            if (mode == MREMAP_MODE_VERT_POLY_NEAREST) {
-              int index;
-              mesh_remap_interp_poly_data_get(mp,
-                                              loops_src,
-                                              (const float(*)[3])vcos_src,
-                                              nearest.co,
-                                              &tmp_buff_size,
-                                              &vcos,
-                                              false,
-                                              &indices,
-                                              &weights,
-                                              false,
-                                              &index);
+  int grid_size;
+  float edge_dst_len;
+  float grid_step;
 
-              mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
-            }
-            else if (mode == MREMAP_MODE_VERT_POLYINTERP_NEAREST) {
-              const int sources_num = mesh_remap_interp_poly_data_get(mp,
-                                                                      loops_src,
-                                                                      (const float(*)[3])vcos_src,
-                                                                      nearest.co,
-                                                                      &tmp_buff_size,
-                                                                      &vcos,
-                                                                      false,
-                                                                      &indices,
-                                                                      &weights,
-                                                                      true,
-                                                                      NULL);
-
-              mesh_remap_item_define(r_map, i, hit_dist, 0, sources_num, indices, weights);
-            }
-          }
-          else {
-            /* No source for this dest vertex! */
-            BKE_mesh_remap_item_define_invalid(r_map, i);
-          }
+  float totweights = 0.0f;
+  float hit_dist_accum = 0.0f;
+  int sources_num = 0;
+  int j;
+
+  if (data_tls->weights_src == NULL) {
+    data_tls->weights_src = MEM_calloc_arrayN(
+        (size_t)data->numedges_src, sizeof(*data_tls->weights_src), __func__);
+  }
+  /* Each ray hits at most one source edge. */
+  mesh_remap_tls_buffers_ensure(data_tls, MREMAP_EDGE_RAYS_MAX);
+
+  copy_v3_v3(v1_co, data->verts_dst[me->v1].co);
+  copy_v3_v3(v2_co, data->verts_dst[me->v2].co);
+
+  normal_short_to_float_v3(v1_no, data->verts_dst[me->v1].no);
+  normal_short_to_float_v3(v2_no, data->verts_dst[me->v2].no);
+
+  /* We do our transform here, allows to interpolate from normals already in src space. */
+  if (space_transform) {
+    BLI_space_transform_apply(space_transform, v1_co);
+    BLI_space_transform_apply(space_transform, v2_co);
+    BLI_space_transform_apply_normal(space_transform, v1_no);
+    BLI_space_transform_apply_normal(space_transform, v2_no);
+  }
+
+  /* We adjust our ray-casting grid to ray_radius (the smaller, the more rays are cast),
+   * with lower/upper bounds. */
+  edge_dst_len = len_v3v3(v1_co, v2_co);
+
+  grid_size = (int)((edge_dst_len / ray_radius) + 0.5f);
+  CLAMP(grid_size, MREMAP_EDGE_RAYS_MIN, MREMAP_EDGE_RAYS_MAX); /* min 5 rays/edge, max 100. */
+
+  grid_step = 1.0f / (float)grid_size; /* Not actual distance here, rather an interp fac... */
+
+  /* And now we can cast all our rays, and see what we get! */
+  for (j = 0; j < grid_size; j++) {
+    const float fac = grid_step * (float)j;
+
+    int n = (ray_radius > 0.0f) ? MREMAP_RAYCAST_APPROXIMATE_NR : 1;
+    float w = 1.0f;
+
+    interp_v3_v3v3(tmp_co, v1_co, v2_co, fac);
+    interp_v3_v3v3_slerp_safe(tmp_no, v1_no, v2_no, fac);
+
+    while (n--) {
+      if (mesh_remap_bvhtree_query_raycast(data->treedata,
+                                           &data_tls->rayhit,
+                                           tmp_co,
+                                           tmp_no,
+                                           ray_radius / w,
+                                           data->max_dist,
+                                           &hit_dist)) {
+        const int index = data_tls->rayhit.index;
+        if (data_tls->weights_src[index] == 0.0f) {
+          data_tls->indices[sources_num++] = index;
         }
+        data_tls->weights_src[index] += w;
+        totweights += w;
+        hit_dist_accum += hit_dist;
+        break;
       }
-
-      MEM_freeN(vcos_src);
-      MEM_freeN(vcos);
-      MEM_freeN(indices);
-      MEM_freeN(weights);
+      /* Next iteration will get bigger radius but smaller weight! */
+      w /= MREMAP_RAYCAST_APPROXIMATE_FAC;
     }
-    else {
-      CLOG_WARN(&LOG, "Unsupported mesh-to-mesh vertex mapping mode (%d)!", mode);
-      memset(r_map->items, 0, sizeof(*r_map->items) * (size_t)numverts_dst);
+  }
+  /* A sampling is valid (as in, its result can be considered as valid sources)
+   * only if at least half of the rays found a source! */
+  if (totweights > ((float)grid_size / 2.0f)) {
+    mesh_remap_sampled_sources_get(
+        data_tls->weights_src, data_tls->indices, sources_num, totweights, data_tls->weights);
+    mesh_remap_item_define_ex(data->r_map,
+                              data->mem_lock,
+                              i,
+                              hit_dist_accum / totweights,
+                              0,
+                              sources_num,
+                              data_tls->indices,
+                              data_tls->weights);
+  }
+  else {
+    /* No source for this dest edge! */
+    for (j = 0; j < sources_num; j++) {
+      data_tls->weights_src[data_tls->indices[j]] = 0.0f;
     }
-
-    free_bvhtree_from_mesh(&treedata);
+    BKE_mesh_remap_item_define_invalid(data->r_map, i);
   }
 }
 
+#undef MREMAP_EDGE_RAYS_MIN
+#undef MREMAP_EDGE_RAYS_MAX
+
 void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
                                          const SpaceTransform *space_transform,
                                          const float max_dist,
@@ -743,316 +1223,93 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
   }
   else {
     BVHTreeFromMesh treedata = {NULL};
-    BVHTreeNearest nearest = {0};
-    BVHTreeRayHit rayhit = {0};
-    float hit_dist;
-    float tmp_co[3], tmp_no[3];
+    SpinLock mem_lock;
+
+    MeshRemapEdgesData data = {
+        .mode = mode,
+        .space_transform = space_transform,
+        .max_dist = max_dist,
+        .max_dist_sq = max_dist_sq,
+        .ray_radius = ray_radius,
+        .verts_dst = verts_dst,
+        .edges_dst = edges_dst,
+        .treedata = &treedata,
+        .edges_src = me_src->medge,
+        .numedges_src = me_src->totedge,
+        .polys_src = me_src->mpoly,
+        .loops_src = me_src->mloop,
+        .r_map = r_map,
+        .mem_lock = &mem_lock,
+    };
+
+    BLI_spin_init(&mem_lock);
 
     if (mode == MREMAP_MODE_EDGE_VERT_NEAREST) {
       const int num_verts_src = me_src->totvert;
       const int num_edges_src = me_src->totedge;
-      MEdge *edges_src = me_src->medge;
       float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
 
       MeshElemMap *vert_to_edge_src_map;
       int *vert_to_edge_src_map_mem;
 
-      struct {
-        float hit_dist;
-        int index;
-      } *v_dst_to_src_map = MEM_mallocN(sizeof(*v_dst_to_src_map) * (size_t)numverts_dst,
-                                        __func__);
+      MeshRemapVertHit *v_dst_to_src_map = MEM_mallocN(
+          sizeof(*v_dst_to_src_map) * (size_t)numverts_dst, __func__);
+      BLI_bitmap *verts_used_dst = BLI_BITMAP_NEW((size_t)numverts_dst, __func__);
 
-      for (i = 0; i < numverts_dst; i++) {
-        v_dst_to_src_map[i].hit_dist = -1.0f;
+      for (i = 0; i < numedges_dst; i++) {
+        BLI_BITMAP_ENABLE(verts_used_dst, edges_dst[i].v1);
+        BLI_BITMAP_ENABLE(verts_used_dst, edges_dst[i].v2);
       }
 
       BKE_mesh_vert_edge_map_create(&vert_to_edge_src_map,
                                     &vert_to_edge_src_map_mem,
-                                    edges_src,
+                                    me_src->medge,
                                     num_verts_src,
                                     num_edges_src);
 
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
-      nearest.index = -1;
-
-      for (i = 0; i < numedges_dst; i++) {
-        const MEdge *e_dst = &edges_dst[i];
-        float best_totdist = FLT_MAX;
-        int best_eidx_src = -1;
-        int j = 2;
 
-        while (j--) {
-          const unsigned int vidx_dst = j ? e_dst->v1 : e_dst->v2;
+      data.vcos_src = (const float(*)[3])vcos_src;
+      data.vert_to_edge_src_map = vert_to_edge_src_map;
+      data.verts_used_dst = verts_used_dst;
+      data.v_dst_to_src_map = v_dst_to_src_map;
 
-          /* Compute closest verts only once! */
-          if (v_dst_to_src_map[vidx_dst].hit_dist == -1.0f) {
-            copy_v3_v3(tmp_co, verts_dst[vidx_dst].co);
+      mesh_remap_parallel_range(numverts_dst, &data, mesh_remap_edges_vert_nearest_task_cb);
+      mesh_remap_parallel_range(numedges_dst, &data, mesh_remap_edges_vert_task_cb);
 
-            /* Convert the vertex to tree coordinates, if needed. */
-            if (space_transform) {
-              BLI_space_transform_apply(space_transform, tmp_co);
-            }
-
-            if (mesh_remap_bvhtree_query_nearest(
-                    &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-              v_dst_to_src_map[vidx_dst].hit_dist = hit_dist;
-              v_dst_to_src_map[vidx_dst].index = nearest.index;
-            }
-            else {
-              /* No source for this dest vert! */
-              v_dst_to_src_map[vidx_dst].hit_dist = FLT_MAX;
-            }
-          }
-        }
+      MEM_freeN(vcos_src);
+      MEM_freeN(v_dst_to_src_map);
+      MEM_freeN(verts_used_dst);
+      MEM_freeN(vert_to_edge_src_map);
+      MEM_freeN(vert_to_edge_src_map_mem);
+    }
+    else if (mode == MREMAP_MODE_EDGE_NEAREST) {
+      BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
 
-        /* Now, check all source edges of closest sources vertices,
-         * and select the one giving the smallest total verts-to-verts distance. */
-        for (j = 2; j--;) {
-          const unsigned int vidx_dst = j ? e_dst->v1 : e_dst->v2;
-          const float first_dist = v_dst_to_src_map[vidx_dst].hit_dist;
-          const int vidx_src = v_dst_to_src_map[vidx_dst].index;
-          int *eidx_src, k;
+      mesh_remap_parallel_range(numedges_dst, &data, mesh_remap_edges_nearest_task_cb);
+    }
+    else if (mode == MREMAP_MODE_EDGE_POLY_NEAREST) {
+      float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
 
-          if (vidx_src < 0) {
-            continue;
-          }
+      BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
 
-          eidx_src = vert_to_edge_src_map[vidx_src].indices;
-          k = vert_to_edge_src_map[vidx_src].count;
+      data.vcos_src = (const float(*)[3])vcos_src;
+      mesh_remap_parallel_range(numedges_dst, &data, mesh_remap_edges_nearest_task_cb);
 
-          for (; k--; eidx_src++) {
-            MEdge *e_src = &edges_src[*eidx_src];
-            const float *other_co_src = vcos_src[BKE_mesh_edge_other_vert(e_src, vidx_src)];
-            const float *other_co_dst =
-                verts_dst[BKE_mesh_edge_other_vert(e_dst, (int)vidx_dst)].co;
-            const float totdist = first_dist + len_v3v3(other_co_src, other_co_dst);
+      MEM_freeN(vcos_src);
+    }
+    else if (mode == MREMAP_MODE_EDGE_EDGEINTERP_VNORPROJ) {
+      BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
 
-            if (totdist < best_totdist) {
-              best_totdist = totdist;
-              best_eidx_src = *eidx_src;
-            }
-          }
-        }
-
-        if (best_eidx_src >= 0) {
-          const float *co1_src = vcos_src[edges_src[best_eidx_src].v1];
-          const float *co2_src = vcos_src[edges_src[best_eidx_src].v2];
-          const float *co1_dst = verts_dst[e_dst->v1].co;
-          const float *co2_dst = verts_dst[e_dst->v2].co;
-          float co_src[3], co_dst[3];
-
-          /* TODO: would need an isect_seg_seg_v3(), actually! */
-          const int isect_type = isect_line_line_v3(
-              co1_src, co2_src, co1_dst, co2_dst, co_src, co_dst);
-          if (isect_type != 0) {
-            const float fac_src = line_point_factor_v3(co_src, co1_src, co2_src);
-            const float fac_dst = line_point_factor_v3(co_dst, co1_dst, co2_dst);
-            if (fac_src < 0.0f) {
-              copy_v3_v3(co_src, co1_src);
-            }
-            else if (fac_src > 1.0f) {
-              copy_v3_v3(co_src, co2_src);
-            }
-            if (fac_dst < 0.0f) {
-              copy_v3_v3(co_dst, co1_dst);
-            }
-            else if (fac_dst > 1.0f) {
-              copy_v3_v3(co_dst, co2_dst);
-            }
-          }
-          hit_dist = len_v3v3(co_dst, co_src);
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &best_eidx_src, &full_weight);
-        }
-        else {
-          /* No source for this dest edge! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
-
-      MEM_freeN(vcos_src);
-      MEM_freeN(v_dst_to_src_map);
-      MEM_freeN(vert_to_edge_src_map);
-      MEM_freeN(vert_to_edge_src_map_mem);
-    }
-    else if (mode == MREMAP_MODE_EDGE_NEAREST) {
-      BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
-
-      for (i = 0; i < numedges_dst; i++) {
-        interp_v3_v3v3(tmp_co, verts_dst[edges_dst[i].v1].co, verts_dst[edges_dst[i].v2].co, 0.5f);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
-        }
-        else {
-          /* No source for this dest edge! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
-    }
-    else if (mode == MREMAP_MODE_EDGE_POLY_NEAREST) {
-      MEdge *edges_src = me_src->medge;
-      MPoly *polys_src = me_src->mpoly;
-      MLoop *loops_src = me_src->mloop;
-      float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
-
-      BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
-
-      for (i = 0; i < numedges_dst; i++) {
-        interp_v3_v3v3(tmp_co, verts_dst[edges_dst[i].v1].co, verts_dst[edges_dst[i].v2].co, 0.5f);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          const MLoopTri *lt = &treedata.looptri[nearest.index];
-          MPoly *mp_src = &polys_src[lt->poly];
-          MLoop *ml_src = &loops_src[mp_src->loopstart];
-          int nloops = mp_src->totloop;
-          float best_dist_sq = FLT_MAX;
-          int best_eidx_src = -1;
-
-          for (; nloops--; ml_src++) {
-            MEdge *med_src = &edges_src[ml_src->e];
-            float *co1_src = vcos_src[med_src->v1];
-            float *co2_src = vcos_src[med_src->v2];
-            float co_src[3];
-            float dist_sq;
-
-            interp_v3_v3v3(co_src, co1_src, co2_src, 0.5f);
-            dist_sq = len_squared_v3v3(tmp_co, co_src);
-            if (dist_sq < best_dist_sq) {
-              best_dist_sq = dist_sq;
-              best_eidx_src = (int)ml_src->e;
-            }
-          }
-          if (best_eidx_src >= 0) {
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &best_eidx_src, &full_weight);
-          }
-        }
-        else {
-          /* No source for this dest edge! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
-
-      MEM_freeN(vcos_src);
-    }
-    else if (mode == MREMAP_MODE_EDGE_EDGEINTERP_VNORPROJ) {
-      const int num_rays_min = 5, num_rays_max = 100;
-      const int numedges_src = me_src->totedge;
-
-      /* Subtleness - this one we can allocate only max number of cast rays per edges! */
-      int *indices = MEM_mallocN(sizeof(*indices) * (size_t)min_ii(numedges_src, num_rays_max),
-                                 __func__);
-      /* Here it's simpler to just allocate for all edges :/ */
-      float *weights = MEM_mallocN(sizeof(*weights) * (size_t)numedges_src, __func__);
-
-      BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-
-      for (i = 0; i < numedges_dst; i++) {
-        /* For each dst edge, we sample some rays from it (interpolated from its vertices)
-         * and use their hits to interpolate from source edges. */
-        const MEdge *me = &edges_dst[i];
-        float v1_co[3], v2_co[3];
-        float v1_no[3], v2_no[3];
-
-        int grid_size;
-        float edge_dst_len;
-        float grid_step;
-
-        float totweights = 0.0f;
-        float hit_dist_accum = 0.0f;
-        int sources_num = 0;
-        int j;
-
-        copy_v3_v3(v1_co, verts_dst[me->v1].co);
-        copy_v3_v3(v2_co, verts_dst[me->v2].co);
-
-        normal_short_to_float_v3(v1_no, verts_dst[me->v1].no);
-        normal_short_to_float_v3(v2_no, verts_dst[me->v2].no);
-
-        /* We do our transform here, allows to interpolate from normals already in src space. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, v1_co);
-          BLI_space_transform_apply(space_transform, v2_co);
-          BLI_space_transform_apply_normal(space_transform, v1_no);
-          BLI_space_transform_apply_normal(space_transform, v2_no);
-        }
-
-        copy_vn_fl(weights, (int)numedges_src, 0.0f);
-
-        /* We adjust our ray-casting grid to ray_radius (the smaller, the more rays are cast),
-         * with lower/upper bounds. */
-        edge_dst_len = len_v3v3(v1_co, v2_co);
-
-        grid_size = (int)((edge_dst_len / ray_radius) + 0.5f);
-        CLAMP(grid_size, num_rays_min, num_rays_max); /* min 5 rays/edge, max 100. */
-
-        grid_step = 1.0f /
-                    (float)grid_size; /* Not actual distance here, rather an interp fac... */
-
-        /* And now we can cast all our rays, and see what we get! */
-        for (j = 0; j < grid_size; j++) {
-          const float fac = grid_step * (float)j;
-
-          int n = (ray_radius > 0.0f) ? MREMAP_RAYCAST_APPROXIMATE_NR : 1;
-          float w = 1.0f;
-
-          interp_v3_v3v3(tmp_co, v1_co, v2_co, fac);
-          interp_v3_v3v3_slerp_safe(tmp_no, v1_no, v2_no, fac);
-
-          while (n--) {
-            if (mesh_remap_bvhtree_query_raycast(
-                    &treedata, &rayhit, tmp_co, tmp_no, ray_radius / w, max_dist, &hit_dist)) {
-              weights[rayhit.index] += w;
-              totweights += w;
-              hit_dist_accum += hit_dist;
-              break;
-            }
-            /* Next iteration will get bigger radius but smaller weight! */
-            w /= MREMAP_RAYCAST_APPROXIMATE_FAC;
-          }
-        }
-        /* A sampling is valid (as in, its result can be considered as valid sources)
-         * only if at least half of the rays found a source! */
-        if (totweights > ((float)grid_size / 2.0f)) {
-          for (j = 0; j < (int)numedges_src; j++) {
-            if (!weights[j]) {
-              continue;
-            }
-            /* Note: sources_num is always <= j! */
-            weights[sources_num] = weights[j] / totweights;
-            indices[sources_num] = j;
-            sources_num++;
-          }
-          mesh_remap_item_define(
-              r_map, i, hit_dist_accum / totweights, 0, sources_num, indices, weights);
-        }
-        else {
-          /* No source for this dest edge! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
-
-      MEM_freeN(indices);
-      MEM_freeN(weights);
+      mesh_remap_parallel_range(numedges_dst, &data, mesh_remap_edges_vnorproj_task_cb);
     }
     else {
       CLOG_WARN(&LOG, "Unsupported mesh-to-mesh edge mapping mode (%d)!", mode);
       memset(r_map->items, 0, sizeof(*r_map->items) * (size_t)numedges_dst);
     }
 
+    BLI_spin_end(&mem_lock);
+
     free_bvhtree_from_mesh(&treedata);
   }
 }
@@ -1247,6 +1504,604 @@ static float mesh_remap_calc_loops_astar_f_cost(BLI_AStarGraph *as_graph,
 
 #define ASTAR_STEPS_MAX 64
 
+typedef struct MeshRemapLoopsData {
+  int mode;
+  const SpaceTransform *space_transform;
+  float max_dist;
+  float max_dist_sq;
+  float ray_radius;
+
+  bool use_from_vert;
+  bool use_islands;
+  int isld_steps_src;
+
+  const MVert *verts_dst;
+  const MLoop *loops_dst;
+  const MPoly *polys_dst;
+  const float (*poly_nors_dst)[3];
+  const float (*loop_nors_dst)[3];
+
+  const MVert *verts_src;
+  const float (*vcos_src)[3];
+  const MLoop *loops_src;
+  const MPoly *polys_src;
+  const MLoopTri *looptri_src;
+  const float (*poly_nors_src)[3];
+  const float (*loop_nors_src)[3];
+  const float (*poly_cents_src)[3];
+
+  const MeshElemMap *vert_to_loop_map_src;
+  const MeshElemMap *vert_to_poly_map_src;
+  const MeshElemMap *poly_to_looptri_map_src;
+  const int *loop_to_poly_map_src;
+
+  const MeshIslandStore *island_store;
+  BVHTreeFromMesh *treedata;
+  int num_trees;
+  BLI_AStarGraph *as_graphdata;
+
+  MeshPairRemap *r_map;
+  SpinLock *mem_lock;
+} MeshRemapLoopsData;
+
+static void mesh_remap_loops_task_cb(void *__restrict userdata,
+                                     const int pidx_dst,
+                                     const TaskParallelTLS *__restrict tls)
+{
+  const MeshRemapLoopsData *data = userdata;
+  MeshRemapTLS *data_tls = tls->userdata_chunk;
+
+  const int mode = data->mode;
+  const SpaceTransform *space_transform = data->space_transform;
+  const float max_dist_sq = data->max_dist_sq;
+  const float ray_radius = data->ray_radius;
+  const bool use_from_vert = data->use_from_vert;
+  const bool use_islands = data->use_islands;
+  const int isld_steps_src = data->isld_steps_src;
+  const int num_trees = data->num_trees;
+
+  const MVert *verts_dst = data->verts_dst;
+  const MLoop *loops_dst = data->loops_dst;
+  const MVert *verts_src = data->verts_src;
+  const float(*vcos_src)[3] = data->vcos_src;
+  const MLoop *loops_src = data->loops_src;
+  const MPoly *polys_src = data->polys_src;
+  const MLoopTri *looptri_src = data->looptri_src;
+  const MeshElemMap *poly_to_looptri_map_src = data->poly_to_looptri_map_src;
+  const MeshIslandStore *island_store = data->island_store;
+  MeshPairRemap *r_map = data->r_map;
+
+  BVHTreeNearest *nearest = &data_tls->nearest;
+  BVHTreeRayHit *rayhit = &data_tls->rayhit;
+  BLI_AStarSolution *as_solution = &data_tls->as_solution;
+  IslandResult **islands_res;
+  float hit_dist;
+  float tmp_co[3], tmp_no[3];
+
+  const float full_weight = 1.0f;
+  const MPoly *mp_dst = &data->polys_dst[pidx_dst];
+  const MLoop *ml_src, *ml_dst;
+  const MPoly *mp_src;
+  int tindex, lidx_dst, plidx_dst, pidx_src, lidx_src, plidx_src;
+  int i;
+
+  float pnor_dst[3];
+
+  /* Only in use_from_vert case, we may need polys' centers as fallback
+   * in case we cannot decide which corner to use from normals only. */
+  float pcent_dst[3];
+  bool pcent_dst_valid = false;
+
+  if (!use_from_vert) {
+    mesh_remap_tls_buffers_ensure(data_tls, MREMAP_DEFAULT_BUFSIZE);
+  }
+
+  if (data_tls->islands_res == NULL) {
+    data_tls->islands_num = num_trees;
+    data_tls->islands_res_buff_size = max_zz((size_t)mp_dst->totloop, MREMAP_DEFAULT_BUFSIZE);
+    data_tls->islands_res = MEM_mallocN(sizeof(*data_tls->islands_res) * (size_t)num_trees,
+                                        __func__);
+    for (tindex = 0; tindex < num_trees; tindex++) {
+      data_tls->islands_res[tindex] = MEM_mallocN(
+          sizeof(**data_tls->islands_res) * data_tls->islands_res_buff_size, __func__);
+    }
+  }
+  else if ((size_t)mp_dst->totloop > data_tls->islands_res_buff_size) {
+    data_tls->islands_res_buff_size = (size_t)mp_dst->totloop + MREMAP_DEFAULT_BUFSIZE;
+    for (tindex = 0; tindex < num_trees; tindex++) {
+      data_tls->islands_res[tindex] = MEM_reallocN(
+          data_tls->islands_res[tindex],
+          sizeof(**data_tls->islands_res) * data_tls->islands_res_buff_size);
+    }
+  }
+  islands_res = data_tls->islands_res;
+
+  if (mode == MREMAP_MODE_LOOP_NEAREST_POLYNOR) {
+    copy_v3_v3(pnor_dst, data->poly_nors_dst[pidx_dst]);
+    if (space_transform) {
+      BLI_space_transform_apply_normal(space_transform, pnor_dst);
+    }
+  }
+
+  for (tindex = 0; tindex < num_trees; tindex++) {
+    BVHTreeFromMesh *tdata = &data->treedata[tindex];
+
+    ml_dst = &loops_dst[mp_dst->loopstart];
+    for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++, ml_dst++) {
+      if (use_from_vert) {
+        const MeshElemMap *vert_to_refelem_map_src = NULL;
+
+        copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
+        nearest->index = -1;
+
+        /* Convert the vertex to tree coordinates, if needed. */
+        if (space_transform) {
+          BLI_space_transform_apply(space_transform, tmp_co);
+        }
+
+        if (mesh_remap_bvhtree_query_nearest(tdata, nearest, tmp_co, max_dist_sq, &hit_dist)) {
+          const float(*nor_dst)[3];
+          const float(*nors_src)[3];
+          float best_nor_dot = -2.0f;
+          float best_sqdist_fallback = FLT_MAX;
+          int best_index_src = -1;
+
+          if (mode == MREMAP_MODE_LOOP_NEAREST_LOOPNOR) {
+            copy_v3_v3(tmp_no, data->loop_nors_dst[plidx_dst + mp_dst->loopstart]);
+            if (space_transform) {
+              BLI_space_transform_apply_normal(space_transform, tmp_no);
+            }
+            nor_dst = (const float(*)[3])&tmp_no;
+            nors_src = data->loop_nors_src;
+            vert_to_refelem_map_src = data->vert_to_loop_map_src;
+          }
+          else { /* if (mode == MREMAP_MODE_LOOP_NEAREST_POLYNOR) { */
+            nor_dst = (const float(*)[3])&pnor_dst;
+            nors_src = data->poly_nors_src;
+            vert_to_refelem_map_src = data->vert_to_poly_map_src;
+          }
+
+          for (i = vert_to_refelem_map_src[nearest->index].count; i--;) {
+            const int index_src = vert_to_refelem_map_src[nearest->index].indices[i];
+            BLI_assert(index_src != -1);
+            const float dot = dot_v3v3(nors_src[index_src], *nor_dst);
+
+            pidx_src = ((mode == MREMAP_MODE_LOOP_NEAREST_LOOPNOR) ?
+                            data->loop_to_poly_map_src[index_src] :
+                            index_src);
+            /* WARNING! This is not the *real* lidx_src in case of POLYNOR, we only use it
+             *          to check we stay on current island (all loops from a given poly are
+             *          on same island!). */
+            lidx_src = ((mode == MREMAP_MODE_LOOP_NEAREST_LOOPNOR) ?
+                            index_src :
+                            polys_src[pidx_src].loopstart);
+
+            /* A same vert may be at the boundary of several islands! Hence, we have to ensure
+             * poly/loop we are currently considering *belongs* to current island! */
+            if (use_islands && island_store->items_to_islands[lidx_src] != tindex) {
+              continue;
+            }
+
+            if (dot > best_nor_dot - 1e-6f) {
+              /* We need something as fallback decision in case dest normal matches several
+               * source normals (see T44522), using distance between polys' centers here. */
+              const float *pcent_src;
+              float sqdist;
+
+              if (!pcent_dst_valid) {
+                BKE_mesh_calc_poly_center(
+                    mp_dst, &loops_dst[mp_dst->loopstart], verts_dst, pcent_dst);
+                pcent_dst_valid = true;
+              }
+              pcent_src = data->poly_cents_src[pidx_src];
+              sqdist = len_squared_v3v3(pcent_dst, pcent_src);
+
+              if ((dot > best_nor_dot + 1e-6f) || (sqdist < best_sqdist_fallback)) {
+                best_nor_dot = dot;
+                best_sqdist_fallback = sqdist;
+                best_index_src = index_src;
+              }
+            }
+          }
+          if (best_index_src == -1) {
+            /* We found no item to map back from closest vertex... */
+            best_nor_dot = -1.0f;
+            hit_dist = FLT_MAX;
+          }
+          else if (mode == MREMAP_MODE_LOOP_NEAREST_POLYNOR) {
+            /* Our best_index_src is a poly one for now!
+             * Have to find its loop matching our closest vertex. */
+            mp_src = &polys_src[best_index_src];
+            ml_src = &loops_src[mp_src->loopstart];
+            for (plidx_src = 0; plidx_src < mp_src->totloop; plidx_src++, ml_src++) {
+              if ((int)ml_src->v == nearest->index) {
+                best_index_src = plidx_src + mp_src->loopstart;
+                break;
+              }
+            }
+          }
+          best_nor_dot = (best_nor_dot + 1.0f) * 0.5f;
+          islands_res[tindex][plidx_dst].factor = hit_dist ? (best_nor_dot / hit_dist) : 1e18f;
+          islands_res[tindex][plidx_dst].hit_dist = hit_dist;
+          islands_res[tindex][plidx_dst].index_src = best_index_src;
+        }
+        else {
+          /* No source for this dest loop! */
+          islands_res[tindex][plidx_dst].factor = 0.0f;
+          islands_res[tindex][plidx_dst].hit_dist = FLT_MAX;
+          islands_res[tindex][plidx_dst].index_src = -1;
+        }
+      }
+      else if (mode & MREMAP_USE_NORPROJ) {
+        int n = (ray_radius > 0.0f) ? MREMAP_RAYCAST_APPROXIMATE_NR : 1;
+        float w = 1.0f;
+
+        copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
+        copy_v3_v3(tmp_no, data->loop_nors_dst[plidx_dst + mp_dst->loopstart]);
+
+        /* We do our transform here, since we may do several raycast/nearest queries. */
+        if (space_transform) {
+          BLI_space_transform_apply(space_transform, tmp_co);
+          BLI_space_transform_apply_normal(space_transform, tmp_no);
+        }
+
+        while (n--) {
+          if (mesh_remap_bvhtree_query_raycast(
+                  tdata, rayhit, tmp_co, tmp_no, ray_radius / w, data->max_dist, &hit_dist)) {
+            islands_res[tindex][plidx_dst].factor = (hit_dist ? (1.0f / hit_dist) : 1e18f) * w;
+            islands_res[tindex][plidx_dst].hit_dist = hit_dist;
+            islands_res[tindex][plidx_dst].index_src = (int)tdata->looptri[rayhit->index].poly;
+            copy_v3_v3(islands_res[tindex][plidx_dst].hit_point, rayhit->co);
+            break;
+          }
+          /* Next iteration will get bigger radius but smaller weight! */
+          w /= MREMAP_RAYCAST_APPROXIMATE_FAC;
+        }
+        if (n == -1) {
+          /* Fallback to 'nearest' hit here, loops usually comes in 'face group', not good to
+           * have only part of one dest face's loops to map to source.
+           * Note that since we give this a null weight, if whole weight for a given face
+           * is null, it means none of its loop mapped to this source island,
+           * hence we can skip it later.
+           */
+          copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
+          nearest->index = -1;
+
+          /* Convert the vertex to tree coordinates, if needed. */
+          if (space_transform) {
+            BLI_space_transform_apply(space_transform, tmp_co);
+          }
+
+          /* In any case, this fallback nearest hit should have no weight at all
+           * in 'best island' decision! */
+          islands_res[tindex][plidx_dst].factor = 0.0f;
+
+          if (mesh_remap_bvhtree_query_nearest(tdata, nearest, tmp_co, max_dist_sq, &hit_dist)) {
+            islands_res[tindex][plidx_dst].hit_dist = hit_dist;
+            islands_res[tindex][plidx_dst].index_src = (int)tdata->looptri[nearest->index].poly;
+            copy_v3_v3(islands_res[tindex][plidx_dst].hit_point, nearest->co);
+          }
+          else {
+            /* No source for this dest loop! */
+            islands_res[tindex][plidx_dst].hit_dist = FLT_MAX;
+            islands_res[tindex][plidx_dst].index_src = -1;
+          }
+        }
+      }
+      else { /* Nearest poly either to use all its loops/verts or just closest one. */
+        copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
+        nearest->index = -1;
+
+        /* Convert the vertex to tree coordinates, if needed. */
+        if (space_transform) {
+          BLI_space_transform_apply(space_transform, tmp_co);
+        }
+
+        if (mesh_remap_bvhtree_query_nearest(tdata, nearest, tmp_co, max_dist_sq, &hit_dist)) {
+          islands_res[tindex][plidx_dst].factor = hit_dist ? (1.0f / hit_dist) : 1e18f;
+          islands_res[tindex][plidx_dst].hit_dist = hit_dist;
+          islands_res[tindex][plidx_dst].index_src = (int)tdata->looptri[nearest->index].poly;
+          copy_v3_v3(islands_res[tindex][plidx_dst].hit_point, nearest->co);
+        }
+        else {
+          /* No source for this dest loop! */
+          islands_res[tindex][plidx_dst].factor = 0.0f;
+          islands_res[tindex][plidx_dst].hit_dist = FLT_MAX;
+          islands_res[tindex][plidx_dst].index_src = -1;
+        }
+      }
+    }
+  }
+
+  /* And now, find best island to use! */
+  /* We have to first select the 'best source island' for given dst poly and its loops.
+   * Then, we have to check that poly does not 'spread' across some island's limits
+   * (like inner seams for UVs, etc.).
+   * Note we only still partially support that kind of situation here, i.e.
+   * Polys spreading over actual cracks
+   * (like a narrow space without faces on src, splitting a 'tube-like' geometry).
+   * That kind of situation should be relatively rare, though.
+   */
+  {
+    BLI_AStarGraph *as_graph = NULL;
+    int *poly_island_index_map = NULL;
+    int pidx_src_prev = -1;
+
+    MeshElemMap *best_island = NULL;
+    float best_island_fac = 0.0f;
+    int best_island_index = -1;
+
+    for (tindex = 0; tindex < num_trees; tindex++) {
+      float island_fac = 0.0f;
+
+      for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++) {
+        island_fac += islands_res[tindex][plidx_dst].factor;
+      }
+      island_fac /= (float)mp_dst->totloop;
+
+      if (island_fac > best_island_fac) {
+        best_island_fac = island_fac;
+        best_island_index = tindex;
+      }
+    }
+
+    if (best_island_index != -1 && isld_steps_src) {
+      best_island = use_islands ? island_store->islands[best_island_index] : NULL;
+      as_graph = &data->as_graphdata[best_island_index];
+      poly_island_index_map = (int *)as_graph->custom_data;
+      BLI_astar_solution_init(as_graph, as_solution, NULL);
+    }
+
+    for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++) {
+      IslandResult *isld_res;
+      lidx_dst = plidx_dst + mp_dst->loopstart;
+
+      if (best_island_index == -1) {
+        /* No source for any loops of our dest poly in any source islands. */
+        BKE_mesh_remap_item_define_invalid(r_map, lidx_dst);
+        continue;
+      }
+
+      as_solution->custom_data = POINTER_FROM_INT(false);
+
+      isld_res = &islands_res[best_island_index][plidx_dst];
+      if (use_from_vert) {
+        /* Indices stored in islands_res are those of loops, one per dest loop. */
+        lidx_src = isld_res->index_src;
+        if (lidx_src >= 0) {
+          pidx_src = data->loop_to_poly_map_src[lidx_src];
+          /* If prev and curr poly are the same, no need to do anything more!!! */
+          if (!ELEM(pidx_src_prev, -1, pidx_src) && isld_steps_src) {
+            int pidx_isld_src, pidx_isld_src_prev;
+            if (poly_island_index_map) {
+              pidx_isld_src = poly_island_index_map[pidx_src];
+              pidx_isld_src_prev = poly_island_index_map[pidx_src_prev];
+            }
+            else {
+              pidx_isld_src = pidx_src;
+              pidx_isld_src_prev = pidx_src_prev;
+            }
+
+            BLI_astar_graph_solve(as_graph,
+                                  pidx_isld_src_prev,
+                                  pidx_isld_src,
+                                  mesh_remap_calc_loops_astar_f_cost,
+                                  as_solution,
+                                  isld_steps_src);
+            if (POINTER_AS_INT(as_solution->custom_data) && (as_solution->steps > 0)) {
+              /* Find first 'cutting edge' on path, and bring back lidx_src on poly just
+               * before that edge.
+               * Note we could try to be much smarter, g.g. Storing a whole poly's indices,
+               * and making decision (on which side of cutting edge(s!) to be) on the end,
+               * but this is one more level of complexity, better to first see if
+               * simple solution works!
+               */
+              int last_valid_pidx_isld_src = -1;
+              /* Note we go backward here, from dest to src poly. */
+              for (i = as_solution->steps - 1; i--;) {
+                BLI_AStarGNLink *as_link = as_solution->prev_links[pidx_isld_src];
+                const int eidx = POINTER_AS_INT(as_link->custom_data);
+                pidx_isld_src = as_solution->prev_nodes[pidx_isld_src];
+                BLI_assert(pidx_isld_src != -1);
+                if (eidx != -1) {
+                  /* we are 'crossing' a cutting edge. */
+                  last_valid_pidx_isld_src = pidx_isld_src;
+                }
+              }
+              if (last_valid_pidx_isld_src != -1) {
+                /* Find a new valid loop in that new poly (nearest one for now).
+                 * Note we could be much more subtle here, again that's for later... */
+                int j;
+                float best_dist_sq = FLT_MAX;
+
+                ml_dst = &loops_dst[lidx_dst];
+                copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
+
+                /* We do our transform here,
+                 * since we may do several raycast/nearest queries. */
+                if (space_transform) {
+                  BLI_space_transform_apply(space_transform, tmp_co);
+                }
+
+                pidx_src = (use_islands ? best_island->indices[last_valid_pidx_isld_src] :
+                                          last_valid_pidx_isld_src);
+                mp_src = &polys_src[pidx_src];
+                ml_src = &loops_src[mp_src->loopstart];
+                for (j = 0; j < mp_src->totloop; j++, ml_src++) {
+                  const float dist_sq = len_squared_v3v3(verts_src[ml_src->v].co, tmp_co);
+                  if (dist_sq < best_dist_sq) {
+                    best_dist_sq = dist_sq;
+                    lidx_src = mp_src->loopstart + j;
+                  }
+                }
+              }
+            }
+          }
+          mesh_remap_item_define_ex(r_map,
+                                    data->mem_lock,
+                                    lidx_dst,
+                                    isld_res->hit_dist,
+                                    best_island_index,
+                                    1,
+                                    &lidx_src,
+                                    &full_weight);
+          pidx_src_prev = pidx_src;
+        }
+        else {
+          /* No source for this loop in this island. */
+          /* TODO: would probably be better to get a source
+           * at all cost in best island anyway? */
+          mesh_remap_item_define_ex(
+              r_map, data->mem_lock, lidx_dst, FLT_MAX, best_island_index, 0, NULL, NULL);
+        }
+      }
+      else {
+        /* Else, we use source poly, indices stored in islands_res are those of polygons. */
+        pidx_src = isld_res->index_src;
+        if (pidx_src >= 0) {
+          float *hit_co = isld_res->hit_point;
+          int best_loop_index_src;
+
+          mp_src = &polys_src[pidx_src];
+          /* If prev and curr poly are the same, no need to do anything more!!! */
+          if (!ELEM(pidx_src_prev, -1, pidx_src) && isld_steps_src) {
+            int pidx_isld_src, pidx_isld_src_prev;
+            if (poly_island_index_map) {
+              pidx_isld_src = poly_island_index_map[pidx_src];
+              pidx_isld_src_prev = poly_island_index_map[pidx_src_prev];
+            }
+            else {
+              pidx_isld_src = pidx_src;
+              pidx_isld_src_prev = pidx_src_prev;
+            }
+
+            BLI_astar_graph_solve(as_graph,
+                                  pidx_isld_src_prev,
+                                  pidx_isld_src,
+                                  mesh_remap_calc_loops_astar_f_cost,
+                                  as_solution,
+                                  isld_steps_src);
+            if (POINTER_AS_INT(as_solution->custom_data) && (as_solution->steps > 0)) {
+              /* Find first 'cutting edge' on path, and bring back lidx_src on poly just
+               * before that edge.
+               * Note we could try to be much smarter: e.g. Storing a whole poly's indices,
+               * and making decision (one which side of cutting edge(s)!) to be on the end,
+               * but this is one more level of complexity, better to first see if
+               * simple solution works!
+               */
+              int last_valid_pidx_isld_src = -1;
+              /* Note we go backward here, from dest to src poly. */
+              for (i = as_solution->steps - 1; i--;) {
+                BLI_AStarGNLink *as_link = as_solution->prev_links[pidx_isld_src];
+                int eidx = POINTER_AS_INT(as_link->custom_data);
+
+                pidx_isld_src = as_solution->prev_nodes[pidx_isld_src];
+                BLI_assert(pidx_isld_src != -1);
+                if (eidx != -1) {
+                  /* we are 'crossing' a cutting edge. */
+                  last_valid_pidx_isld_src = pidx_isld_src;
+                }
+              }
+              if (last_valid_pidx_isld_src != -1) {
+                /* Find a new valid loop in that new poly (nearest point on poly for now).
+                 * Note we could be much more subtle here, again that's for later... */
+                float best_dist_sq = FLT_MAX;
+                int j;
+
+                ml_dst = &loops_dst[lidx_dst];
+                copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
+
+                /* We do our transform here,
+                 * since we may do several raycast/nearest queries. */
+                if (space_transform) {
+                  BLI_space_transform_apply(space_transform, tmp_co);
+                }
+
+                pidx_src = (use_islands ? best_island->indices[last_valid_pidx_isld_src] :
+                                          last_valid_pidx_isld_src);
+                mp_src = &polys_src[pidx_src];
+
+                for (j = poly_to_looptri_map_src[pidx_src].count; j--;) {
+                  float h[3];
+                  const MLoopTri *lt = &looptri_src[poly_to_looptri_map_src[pidx_src].indices[j]];
+                  float dist_sq;
+
+                  closest_on_tri_to_point_v3(h,
+                                             tmp_co,
+                                             vcos_src[loops_src[lt->tri[0]].v],
+                                             vcos_src[loops_src[lt->tri[1]].v],
+                                             vcos_src[loops_src[lt->tri[2]].v]);
+                  dist_sq = len_squared_v3v3(tmp_co, h);
+                  if (dist_sq < best_dist_sq) {
+                    copy_v3_v3(hit_co, h);
+                    best_dist_sq = dist_sq;
+                  }
+                }
+              }
+            }
+          }
+
+          if (mode == MREMAP_MODE_LOOP_POLY_NEAREST) {
+            mesh_remap_interp_poly_data_get(mp_src,
+                                            loops_src,
+                                            vcos_src,
+                                            hit_co,
+                                            &data_tls->buff_size,
+                                            &data_tls->vcos,
+                                            true,
+                                            &data_tls->indices,
+                                            &data_tls->weights,
+                                            false,
+                                            &best_loop_index_src);
+
+            mesh_remap_item_define_ex(r_map,
+                                      data->mem_lock,
+                                      lidx_dst,
+                                      isld_res->hit_dist,
+                                      best_island_index,
+                                      1,
+                                      &best_loop_index_src,
+                                      &full_weight);
+          }
+          else {
+            const int sources_num = mesh_remap_interp_poly_data_get(mp_src,
+                                                                    loops_src,
+                                                                    vcos_src,
+                                                                    hit_co,
+                                                                    &data_tls->buff_size,
+                                                                    &data_tls->vcos,
+                                                                    true,
+                                                                    &data_tls->indices,
+                                                                    &data_tls->weights,
+                                                                    true,
+                                                                    NULL);
+
+            mesh_remap_item_define_ex(r_map,
+                                      data->mem_lock,
+                                      lidx_dst,
+                                      isld_res->hit_dist,
+                                      best_island_index,
+                                      sources_num,
+                                      data_tls->indices,
+                                      data_tls->weights);
+          }
+
+          pidx_src_prev = pidx_src;
+        }
+        else {
+          /* No source for this loop in this island. */
+          /* TODO: would probably be better to get a source
+           * at all cost in best island anyway? */
+          mesh_remap_item_define_ex(
+              r_map, data->mem_lock, lidx_dst, FLT_MAX, best_island_index, 0, NULL, NULL);
+        }
+      }
+    }
+
+    BLI_astar_solution_clear(as_solution);
+  }
+}
+
 void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
                                          const SpaceTransform *space_transform,
                                          const float max_dist,
@@ -1288,11 +2143,7 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
   }
   else {
     BVHTreeFromMesh *treedata = NULL;
-    BVHTreeNearest nearest = {0};
-    BVHTreeRayHit rayhit = {0};
     int num_trees = 0;
-    float hit_dist;
-    float tmp_co[3], tmp_no[3];
 
     const bool use_from_vert = (mode & MREMAP_USE_VERT);
 
@@ -1300,7 +2151,6 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
     bool use_islands = false;
 
     BLI_AStarGraph *as_graphdata = NULL;
-    BLI_AStarSolution as_solution = {0};
     const int isld_steps_src = (islands_precision_src ?
                                     max_ii((int)(ASTAR_STEPS_MAX * islands_precision_src + 0.499f),
                                            1) :
@@ -1337,24 +2187,14 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
     const MLoopTri *looptri_src = NULL;
     int num_looptri_src = 0;
 
-    size_t buff_size_interp = MREMAP_DEFAULT_BUFSIZE;
-    float(*vcos_interp)[3] = NULL;
-    int *indices_interp = NULL;
-    float *weights_interp = NULL;
-
-    MLoop *ml_src, *ml_dst;
-    MPoly *mp_src, *mp_dst;
-    int tindex, pidx_dst, lidx_dst, plidx_dst, pidx_src, lidx_src, plidx_src;
+    MLoop *ml_src;
+    MPoly *mp_src;
+    int tindex, pidx_src, lidx_src, plidx_src;
 
-    IslandResult **islands_res;
-    size_t islands_res_buff_size = MREMAP_DEFAULT_BUFSIZE;
+    SpinLock mem_lock;
 
     if (!use_from_vert) {
       vcos_src = BKE_mesh_vert_coords_alloc(me_src, NULL);
-
-      vcos_interp = MEM_mallocN(sizeof(*vcos_interp) * buff_size_interp, __func__);
-      indices_interp = MEM_mallocN(sizeof(*indices_interp) * buff_size_interp, __func__);
-      weights_interp = MEM_mallocN(sizeof(*weights_interp) * buff_size_interp, __func__);
     }
 
     {
@@ -1609,543 +2449,69 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
       }
     }
 
-    /* And check each dest poly! */
-    islands_res = MEM_mallocN(sizeof(*islands_res) * (size_t)num_trees, __func__);
-    for (tindex = 0; tindex < num_trees; tindex++) {
-      islands_res[tindex] = MEM_mallocN(sizeof(**islands_res) * islands_res_buff_size, __func__);
+    /* Searching for the closest source element of a loop that may cross an inner cut
+     * needs the looptris of each source poly, create them here rather than on demand,
+     * since polys are mapped in parallel. */
+    if (isld_steps_src && !use_from_vert) {
+      BKE_mesh_origindex_map_create_looptri(&poly_to_looptri_map_src,
+                                            &poly_to_looptri_map_src_buff,
+                                            polys_src,
+                                            num_polys_src,
+                                            looptri_src,
+                                            num_looptri_src);
     }
 
-    for (pidx_dst = 0, mp_dst = polys_dst; pidx_dst < numpolys_dst; pidx_dst++, mp_dst++) {
-      float pnor_dst[3];
-
-      /* Only in use_from_vert case, we may need polys' centers as fallback
-       * in case we cannot decide which corner to use from normals only. */
-      float pcent_dst[3];
-      bool pcent_dst_valid = false;
-
-      if (mode == MREMAP_MODE_LOOP_NEAREST_POLYNOR) {
-        copy_v3_v3(pnor_dst, poly_nors_dst[pidx_dst]);
-        if (space_transform) {
-          BLI_space_transform_apply_normal(space_transform, pnor_dst);
-        }
-      }
-
-      if ((size_t)mp_dst->totloop > islands_res_buff_size) {
-        islands_res_buff_size = (size_t)mp_dst->totloop + MREMAP_DEFAULT_BUFSIZE;
-        for (tindex = 0; tindex < num_trees; tindex++) {
-          islands_res[tindex] = MEM_reallocN(islands_res[tindex],
-                                             sizeof(**islands_res) * islands_res_buff_size);
-        }
-      }
-
-      for (tindex = 0; tindex < num_trees; tindex++) {
-        BVHTreeFromMesh *tdata = &treedata[tindex];
-
-        ml_dst = &loops_dst[mp_dst->loopstart];
-        for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++, ml_dst++) {
-          if (use_from_vert) {
-            MeshElemMap *vert_to_refelem_map_src = NULL;
-
-            copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
-            nearest.index = -1;
-
-            /* Convert the vertex to tree coordinates, if needed. */
-            if (space_transform) {
-              BLI_space_transform_apply(space_transform, tmp_co);
-            }
-
-            if (mesh_remap_bvhtree_query_nearest(
-                    tdata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-              float(*nor_dst)[3];
-              float(*nors_src)[3];
-              float best_nor_dot = -2.0f;
-              float best_sqdist_fallback = FLT_MAX;
-              int best_index_src = -1;
-
-              if (mode == MREMAP_MODE_LOOP_NEAREST_LOOPNOR) {
-                copy_v3_v3(tmp_no, loop_nors_dst[plidx_dst + mp_dst->loopstart]);
-                if (space_transform) {
-                  BLI_space_transform_apply_normal(space_transform, tmp_no);
-                }
-                nor_dst = &tmp_no;
-                nors_src = loop_nors_src;
-                vert_to_refelem_map_src = vert_to_loop_map_src;
-              }
-              else { /* if (mode == MREMAP_MODE_LOOP_NEAREST_POLYNOR) { */
-                nor_dst = &pnor_dst;
-                nors_src = poly_nors_src;
-                vert_to_refelem_map_src = vert_to_poly_map_src;
-              }
-
-              for (i = vert_to_refelem_map_src[nearest.index].count; i--;) {
-                const int index_src = vert_to_refelem_map_src[nearest.index].indices[i];
-                BLI_assert(index_src != -1);
-                const float dot = dot_v3v3(nors_src[index_src], *nor_dst);
-
-                pidx_src = ((mode == MREMAP_MODE_LOOP_NEAREST_LOOPNOR) ?
-                                loop_to_poly_map_src[index_src] :
-                                index_src);
-                /* WARNING! This is not the *real* lidx_src in case of POLYNOR, we only use it
-                 *          to check we stay on current island (all loops from a given poly are
-                 *          on same island!). */
-                lidx_src = ((mode == MREMAP_MODE_LOOP_NEAREST_LOOPNOR) ?
-                                index_src :
-                                polys_src[pidx_src].loopstart);
-
-                /* A same vert may be at the boundary of several islands! Hence, we have to ensure
-                 * poly/loop we are currently considering *belongs* to current island! */
-                if (use_islands && island_store.items_to_islands[lidx_src] != tindex) {
-                  continue;
-                }
-
-                if (dot > best_nor_dot - 1e-6f) {
-                  /* We need something as fallback decision in case dest normal matches several
-                   * source normals (see T44522), using distance between polys' centers here. */
-                  float *pcent_src;
-                  float sqdist;
-
-                  mp_src = &polys_src[pidx_src];
-                  ml_src = &loops_src[mp_src->loopstart];
-
-                  if (!pcent_dst_valid) {
-                    BKE_mesh_calc_poly_center(
-                        mp_dst, &loops_dst[mp_dst->loopstart], verts_dst, pcent_dst);
-                    pcent_dst_valid = true;
-                  }
-                  pcent_src = poly_cents_src[pidx_src];
-                  sqdist = len_squared_v3v3(pcent_dst, pcent_src);
-
-                  if ((dot > best_nor_dot + 1e-6f) || (sqdist < best_sqdist_fallback)) {
-                    best_nor_dot = dot;
-                    best_sqdist_fallback = sqdist;
-                    best_index_src = index_src;
-                  }
-                }
-              }
-              if (best_index_src == -1) {
-                /* We found no item to map back from closest vertex... */
-                best_nor_dot = -1.0f;
-                hit_dist = FLT_MAX;
-              }
-              else if (mode == MREMAP_MODE_LOOP_NEAREST_POLYNOR) {
-                /* Our best_index_src is a poly one for now!
-                 * Have to find its loop matching our closest vertex. */
-                mp_src = &polys_src[best_index_src];
-                ml_src = &loops_src[mp_src->loopstart];
-                for (plidx_src = 0; plidx_src < mp_src->totloop; plidx_src++, ml_src++) {
-                  if ((int)ml_src->v == nearest.index) {
-                    best_index_src = plidx_src + mp_src->loopstart;
-                    break;
-                  }
-                }
-              }
-              best_nor_dot = (best_nor_dot + 1.0f) * 0.5f;
-              islands_res[tindex][plidx_dst].factor = hit_dist ? (best_nor_dot / hit_dist) : 1e18f;
-              islands_res[tindex][plidx_dst].hit_dist = hit_dist;
-              islands_res[tindex][plidx_dst].index_src = best_index_src;
-            }
-            else {
-              /* No source for this dest loop! */
-              islands_res[tindex][plidx_dst].factor = 0.0f;
-              islands_res[tindex][plidx_dst].hit_dist = FLT_MAX;
-              islands_res[tindex][plidx_dst].index_src = -1;
-            }
-          }
-          else if (mode & MREMAP_USE_NORPROJ) {
-            int n = (ray_radius > 0.0f) ? MREMAP_RAYCAST_APPROXIMATE_NR : 1;
-            float w = 1.0f;
-
-            copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
-            copy_v3_v3(tmp_no, loop_nors_dst[plidx_dst + mp_dst->loopstart]);
-
-            /* We do our transform here, since we may do several raycast/nearest queries. */
-            if (space_transform) {
-              BLI_space_transform_apply(space_transform, tmp_co);
-              BLI_space_transform_apply_normal(space_transform, tmp_no);
-            }
-
-            while (n--) {
-              if (mesh_remap_bvhtree_query_raycast(
-                      tdata, &rayhit, tmp_co, tmp_no, ray_radius / w, max_dist, &hit_dist)) {
-                islands_res[tindex][plidx_dst].factor = (hit_dist ? (1.0f / hit_dist) : 1e18f) * w;
-                islands_res[tindex][plidx_dst].hit_dist = hit_dist;
-                islands_res[tindex][plidx_dst].index_src = (int)tdata->looptri[rayhit.index].poly;
-                copy_v3_v3(islands_res[tindex][plidx_dst].hit_point, rayhit.co);
-                break;
-              }
-              /* Next iteration will get bigger radius but smaller weight! */
-              w /= MREMAP_RAYCAST_APPROXIMATE_FAC;
-            }
-            if (n == -1) {
-              /* Fallback to 'nearest' hit here, loops usually comes in 'face group', not good to
-               * have only part of one dest face's loops to map to source.
-               * Note that since we give this a null weight, if whole weight for a given face
-               * is null, it means none of its loop mapped to this source island,
-               * hence we can skip it later.
-               */
-              copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
-              nearest.index = -1;
-
-              /* Convert the vertex to tree coordinates, if needed. */
-              if (space_transform) {
-                BLI_space_transform_apply(space_transform, tmp_co);
-              }
-
-              /* In any case, this fallback nearest hit should have no weight at all
-               * in 'best island' decision! */
-              islands_res[tindex][plidx_dst].factor = 0.0f;
-
-              if (mesh_remap_bvhtree_query_nearest(
-                      tdata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-                islands_res[tindex][plidx_dst].hit_dist = hit_dist;
-                islands_res[tindex][plidx_dst].index_src = (int)tdata->looptri[nearest.index].poly;
-                copy_v3_v3(islands_res[tindex][plidx_dst].hit_point, nearest.co);
-              }
-              else {
-                /* No source for this dest loop! */
-                islands_res[tindex][plidx_dst].hit_dist = FLT_MAX;
-                islands_res[tindex][plidx_dst].index_src = -1;
-              }
-            }
-          }
-          else { /* Nearest poly either to use all its loops/verts or just closest one. */
-            copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
-            nearest.index = -1;
-
-            /* Convert the vertex to tree coordinates, if needed. */
-            if (space_transform) {
-              BLI_space_transform_apply(space_transform, tmp_co);
-            }
-
-            if (mesh_remap_bvhtree_query_nearest(
-                    tdata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-              islands_res[tindex][plidx_dst].factor = hit_dist ? (1.0f / hit_dist) : 1e18f;
-              islands_res[tindex][plidx_dst].hit_dist = hit_dist;
-              islands_res[tindex][plidx_dst].index_src = (int)tdata->looptri[nearest.index].poly;
-              copy_v3_v3(islands_res[tindex][plidx_dst].hit_point, nearest.co);
-            }
-            else {
-              /* No source for this dest loop! */
-              islands_res[tindex][plidx_dst].factor = 0.0f;
-              islands_res[tindex][plidx_dst].hit_dist = FLT_MAX;
-              islands_res[tindex][plidx_dst].index_src = -1;
-            }
-          }
-        }
-      }
-
-      /* And now, find best island to use! */
-      /* We have to first select the 'best source island' for given dst poly and its loops.
-       * Then, we have to check that poly does not 'spread' across some island's limits
-       * (like inner seams for UVs, etc.).
-       * Note we only still partially support that kind of situation here, i.e.
-       * Polys spreading over actual cracks
-       * (like a narrow space without faces on src, splitting a 'tube-like' geometry).
-       * That kind of situation should be relatively rare, though.
-       */
-      /* XXX This block in itself is big and complex enough to be a separate function but...
-       *     it uses a bunch of locale vars.
-       *     Not worth sending all that through parameters (for now at least). */
-      {
-        BLI_AStarGraph *as_graph = NULL;
-        int *poly_island_index_map = NULL;
-        int pidx_src_prev = -1;
-
-        MeshElemMap *best_island = NULL;
-        float best_island_fac = 0.0f;
-        int best_island_index = -1;
-
-        for (tindex = 0; tindex < num_trees; tindex++) {
-          float island_fac = 0.0f;
-
-          for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++) {
-            island_fac += islands_res[tindex][plidx_dst].factor;
-          }
-          island_fac /= (float)mp_dst->totloop;
-
-          if (island_fac > best_island_fac) {
-            best_island_fac = island_fac;
-            best_island_index = tindex;
-          }
-        }
-
-        if (best_island_index != -1 && isld_steps_src) {
-          best_island = use_islands ? island_store.islands[best_island_index] : NULL;
-          as_graph = &as_graphdata[best_island_index];
-          poly_island_index_map = (int *)as_graph->custom_data;
-          BLI_astar_solution_init(as_graph, &as_solution, NULL);
-        }
-
-        for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++) {
-          IslandResult *isld_res;
-          lidx_dst = plidx_dst + mp_dst->loopstart;
-
-          if (best_island_index == -1) {
-            /* No source for any loops of our dest poly in any source islands. */
-            BKE_mesh_remap_item_define_invalid(r_map, lidx_dst);
-            continue;
-          }
-
-          as_solution.custom_data = POINTER_FROM_INT(false);
-
-          isld_res = &islands_res[best_island_index][plidx_dst];
-          if (use_from_vert) {
-            /* Indices stored in islands_res are those of loops, one per dest loop. */
-            lidx_src = isld_res->index_src;
-            if (lidx_src >= 0) {
-              pidx_src = loop_to_poly_map_src[lidx_src];
-              /* If prev and curr poly are the same, no need to do anything more!!! */
-              if (!ELEM(pidx_src_prev, -1, pidx_src) && isld_steps_src) {
-                int pidx_isld_src, pidx_isld_src_prev;
-                if (poly_island_index_map) {
-                  pidx_isld_src = poly_island_index_map[pidx_src];
-                  pidx_isld_src_prev = poly_island_index_map[pidx_src_prev];
-                }
-                else {
-                  pidx_isld_src = pidx_src;
-                  pidx_isld_src_prev = pidx_src_prev;
-                }
-
-                BLI_astar_graph_solve(as_graph,
-                                      pidx_isld_src_prev,
-                                      pidx_isld_src,
-                                      mesh_remap_calc_loops_astar_f_cost,
-                                      &as_solution,
-                                      isld_steps_src);
-                if (POINTER_AS_INT(as_solution.custom_data) && (as_solution.steps > 0)) {
-                  /* Find first 'cutting edge' on path, and bring back lidx_src on poly just
-                   * before that edge.
-                   * Note we could try to be much smarter, g.g. Storing a whole poly's indices,
-                   * and making decision (on which side of cutting edge(s!) to be) on the end,
-                   * but this is one more level of complexity, better to first see if
-                   * simple solution works!
-                   */
-                  int last_valid_pidx_isld_src = -1;
-                  /* Note we go backward here, from dest to src poly. */
-                  for (i = as_solution.steps - 1; i--;) {
-                    BLI_AStarGNLink *as_link = as_solution.prev_links[pidx_isld_src];
-                    const int eidx = POINTER_AS_INT(as_link->custom_data);
-                    pidx_isld_src = as_solution.prev_nodes[pidx_isld_src];
-                    BLI_assert(pidx_isld_src != -1);
-                    if (eidx != -1) {
-                      /* we are 'crossing' a cutting edge. */
-                      last_valid_pidx_isld_src = pidx_isld_src;
-                    }
-                  }
-                  if (last_valid_pidx_isld_src != -1) {
-                    /* Find a new valid loop in that new poly (nearest one for now).
-                     * Note we could be much more subtle here, again that's for later... */
-                    int j;
-                    float best_dist_sq = FLT_MAX;
-
-                    ml_dst = &loops_dst[lidx_dst];
-                    copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
-
-                    /* We do our transform here,
-                     * since we may do several raycast/nearest queries. */
-                    if (space_transform) {
-                      BLI_space_transform_apply(space_transform, tmp_co);
-                    }
-
-                    pidx_src = (use_islands ? best_island->indices[last_valid_pidx_isld_src] :
-                                              last_valid_pidx_isld_src);
-                    mp_src = &polys_src[pidx_src];
-                    ml_src = &loops_src[mp_src->loopstart];
-                    for (j = 0; j < mp_src->totloop; j++, ml_src++) {
-                      const float dist_sq = len_squared_v3v3(verts_src[ml_src->v].co, tmp_co);
-                      if (dist_sq < best_dist_sq) {
-                        best_dist_sq = dist_sq;
-                        lidx_src = mp_src->loopstart + j;
-                      }
-                    }
-                  }
-                }
-              }
-              mesh_remap_item_define(r_map,
-                                     lidx_dst,
-                                     isld_res->hit_dist,
-                                     best_island_index,
-                                     1,
-                                     &lidx_src,
-                                     &full_weight);
-              pidx_src_prev = pidx_src;
-            }
-            else {
-              /* No source for this loop in this island. */
-              /* TODO: would probably be better to get a source
-               * at all cost in best island anyway? */
-              mesh_remap_item_define(r_map, lidx_dst, FLT_MAX, best_island_index, 0, NULL, NULL);
-            }
-          }
-          else {
-            /* Else, we use source poly, indices stored in islands_res are those of polygons. */
-            pidx_src = isld_res->index_src;
-            if (pidx_src >= 0) {
-              float *hit_co = isld_res->hit_point;
-              int best_loop_index_src;
-
-              mp_src = &polys_src[pidx_src];
-              /* If prev and curr poly are the same, no need to do anything more!!! */
-              if (!ELEM(pidx_src_prev, -1, pidx_src) && isld_steps_src) {
-                int pidx_isld_src, pidx_isld_src_prev;
-                if (poly_island_index_map) {
-                  pidx_isld_src = poly_island_index_map[pidx_src];
-                  pidx_isld_src_prev = poly_island_index_map[pidx_src_prev];
-                }
-                else {
-                  pidx_isld_src = pidx_src;
-                  pidx_isld_src_prev = pidx_src_prev;
-                }
-
-                BLI_astar_graph_solve(as_graph,
-                                      pidx_isld_src_prev,
-                                      pidx_isld_src,
-                                      mesh_remap_calc_loops_astar_f_cost,
-                                      &as_solution,
-                                      isld_steps_src);
-                if (POINTER_AS_INT(as_solution.custom_data) && (as_solution.steps > 0)) {
-                  /* Find first 'cutting edge' on path, and bring back lidx_src on poly just
-                   * before that edge.
-                   * Note we could try to be much smarter: e.g. Storing a whole poly's indices,
-                   * and making decision (one which side of cutting edge(s)!) to be on the end,
-                   * but this is one more level of complexity, better to first see if
-                   * simple solution works!
-                   */
-                  int last_valid_pidx_isld_src = -1;
-                  /* Note we go backward here, from dest to src poly. */
-                  for (i = as_solution.steps - 1; i--;) {
-                    BLI_AStarGNLink *as_link = as_solution.prev_links[pidx_isld_src];
-                    int eidx = POINTER_AS_INT(as_link->custom_data);
-
-                    pidx_isld_src = as_solution.prev_nodes[pidx_isld_src];
-                    BLI_assert(pidx_isld_src != -1);
-                    if (eidx != -1) {
-                      /* we are 'crossing' a cutting edge. */
-                      last_valid_pidx_isld_src = pidx_isld_src;
-                    }
-                  }
-                  if (last_valid_pidx_isld_src != -1) {
-                    /* Find a new valid loop in that new poly (nearest point on poly for now).
-                     * Note we could be much more subtle here, again that's for later... */
-                    float best_dist_sq = FLT_MAX;
-                    int j;
-
-                    ml_dst = &loops_dst[lidx_dst];
-                    copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
-
-                    /* We do our transform here,
-                     * since we may do several raycast/nearest queries. */
-                    if (space_transform) {
-                      BLI_space_transform_apply(space_transform, tmp_co);
-                    }
-
-                    pidx_src = (use_islands ? best_island->indices[last_valid_pidx_isld_src] :
-                                              last_valid_pidx_isld_src);
-                    mp_src = &polys_src[pidx_src];
-
-                    /* Create that one on demand. */
-                    if (poly_to_looptri_map_src == NULL) {
-                      BKE_mesh_origindex_map_create_looptri(&poly_to_looptri_map_src,
-                                                            &poly_to_looptri_map_src_buff,
-                                                            polys_src,
-                                                            num_polys_src,
-                                                            looptri_src,
-                                                            num_looptri_src);
-                    }
-
-                    for (j = poly_to_looptri_map_src[pidx_src].count; j--;) {
-                      float h[3];
-                      const MLoopTri *lt =
-                          &looptri_src[poly_to_looptri_map_src[pidx_src].indices[j]];
-                      float dist_sq;
-
-                      closest_on_tri_to_point_v3(h,
-                                                 tmp_co,
-                                                 vcos_src[loops_src[lt->tri[0]].v],
-                                                 vcos_src[loops_src[lt->tri[1]].v],
-                                                 vcos_src[loops_src[lt->tri[2]].v]);
-                      dist_sq = len_squared_v3v3(tmp_co, h);
-                      if (dist_sq < best_dist_sq) {
-                        copy_v3_v3(hit_co, h);
-                        best_dist_sq = dist_sq;
-                      }
-                    }
-                  }
-                }
-              }
-
-              if (mode == MREMAP_MODE_LOOP_POLY_NEAREST) {
-                mesh_remap_interp_poly_data_get(mp_src,
-                                                loops_src,
-                                                (const float(*)[3])vcos_src,
-                                                hit_co,
-                                                &buff_size_interp,
-                                                &vcos_interp,
-                                                true,
-                                                &indices_interp,
-                                                &weights_interp,
-                                                false,
-                                                &best_loop_index_src);
-
-                mesh_remap_item_define(r_map,
-                                       lidx_dst,
-                                       isld_res->hit_dist,
-                                       best_island_index,
-                                       1,
-                                       &best_loop_index_src,
-                                       &full_weight);
-              }
-              else {
-                const int sources_num = mesh_remap_interp_poly_data_get(
-                    mp_src,
-                    loops_src,
-                    (const float(*)[3])vcos_src,
-                    hit_co,
-                    &buff_size_interp,
-                    &vcos_interp,
-                    true,
-                    &indices_interp,
-                    &weights_interp,
-                    true,
-                    NULL);
-
-                mesh_remap_item_define(r_map,
-                                       lidx_dst,
-                                       isld_res->hit_dist,
-                                       best_island_index,
-                                       sources_num,
-                                       indices_interp,
-                                       weights_interp);
-              }
-
-              pidx_src_prev = pidx_src;
-            }
-            else {
-              /* No source for this loop in this island. */
-              /* TODO: would probably be better to get a source
-               * at all cost in best island anyway? */
-              mesh_remap_item_define(r_map, lidx_dst, FLT_MAX, best_island_index, 0, NULL, NULL);
-            }
-          }
-        }
-
-        BLI_astar_solution_clear(&as_solution);
-      }
+    /* And check each dest poly! */
+    {
+      MeshRemapLoopsData data = {
+          .mode = mode,
+          .space_transform = space_transform,
+          .max_dist = max_dist,
+          .max_dist_sq = max_dist_sq,
+          .ray_radius = ray_radius,
+          .use_from_vert = use_from_vert,
+          .use_islands = use_islands,
+          .isld_steps_src = isld_steps_src,
+          .verts_dst = verts_dst,
+          .loops_dst = loops_dst,
+          .polys_dst = polys_dst,
+          .poly_nors_dst = (const float(*)[3])poly_nors_dst,
+          .loop_nors_dst = (const float(*)[3])loop_nors_dst,
+          .verts_src = verts_src,
+          .vcos_src = (const float(*)[3])vcos_src,
+          .loops_src = loops_src,
+          .polys_src = polys_src,
+          .looptri_src = looptri_src,
+          .poly_nors_src = (const float(*)[3])poly_nors_src,
+          .loop_nors_src = (const float(*)[3])loop_nors_src,
+          .poly_cents_src = (const float(*)[3])poly_cents_src,
+          .vert_to_loop_map_src = vert_to_loop_map_src,
+          .vert_to_poly_map_src = vert_to_poly_map_src,
+          .poly_to_looptri_map_src = poly_to_looptri_map_src,
+          .loop_to_poly_map_src = loop_to_poly_map_src,
+          .island_store = &island_store,
+          .treedata = treedata,
+          .num_trees = num_trees,
+          .as_graphdata = as_graphdata,
+          .r_map = r_map,
+          .mem_lock = &mem_lock,
+      };
+
+      BLI_spin_init(&mem_lock);
+      mesh_remap_parallel_range(numpolys_dst, &data, mesh_remap_loops_task_cb);
+      BLI_spin_end(&mem_lock);
     }
 
     for (tindex = 0; tindex < num_trees; tindex++) {
-      MEM_freeN(islands_res[tindex]);
       free_bvhtree_from_mesh(&treedata[tindex]);
       if (isld_steps_src) {
         BLI_astar_graph_free(&as_graphdata[tindex]);
       }
     }
-    MEM_freeN(islands_res);
     BKE_mesh_loop_islands_free(&island_store);
     MEM_freeN(treedata);
     if (isld_steps_src) {
       MEM_freeN(as_graphdata);
-      BLI_astar_solution_free(&as_solution);
     }
 
     if (vcos_src) {
@@ -2181,16 +2547,363 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
     if (poly_cents_src) {
       MEM_freeN(poly_cents_src);
     }
-    if (vcos_interp) {
-      MEM_freeN(vcos_interp);
+  }
+}
+
+typedef struct MeshRemapPolysData {
+  int mode;
+  const SpaceTransform *space_transform;
+  float max_dist;
+  float max_dist_sq;
+  float ray_radius;
+  const MVert *verts_dst;
+  const MLoop *loops_dst;
+  const MPoly *polys_dst;
+  const float (*poly_nors_dst)[3];
+  BVHTreeFromMesh *treedata;
+  int numpolys_src;
+  /** Random values used by all dest polys before each one, when sampling polys. */
+  uint64_t *rng_offsets;
+  MeshPairRemap *r_map;
+  SpinLock *mem_lock;
+} MeshRemapPolysData;
+
+static void mesh_remap_polys_task_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict tls)
+{
+  const MeshRemapPolysData *data = userdata;
+  MeshRemapTLS *data_tls = tls->userdata_chunk;
+  const MPoly *mp = &data->polys_dst[i];
+  const float full_weight = 1.0f;
+  float tmp_co[3], tmp_no[3];
+  float hit_dist;
+  int index_src;
+
+  BKE_mesh_calc_poly_center(mp, &data->loops_dst[mp->loopstart], data->verts_dst, tmp_co);
+
+  if (data->mode == MREMAP_MODE_POLY_NEAREST) {
+    /* Convert the vertex to tree coordinates, if needed. */
+    if (data->space_transform) {
+      BLI_space_transform_apply(data->space_transform, tmp_co);
+    }
+
+    if (!mesh_remap_bvhtree_query_nearest(
+            data->treedata, &data_tls->nearest, tmp_co, data->max_dist_sq, &hit_dist)) {
+      /* No source for this dest poly! */
+      BKE_mesh_remap_item_define_invalid(data->r_map, i);
+      return;
     }
-    if (indices_interp) {
-      MEM_freeN(indices_interp);
+    index_src = data_tls->nearest.index;
+  }
+  else { /* if (data->mode == MREMAP_MODE_POLY_NOR) { */
+    copy_v3_v3(tmp_no, data->poly_nors_dst[i]);
+
+    /* Convert the vertex to tree coordinates, if needed. */
+    if (data->space_transform) {
+      BLI_space_transform_apply(data->space_transform, tmp_co);
+      BLI_space_transform_apply_normal(data->space_transform, tmp_no);
+    }
+
+    if (!mesh_remap_bvhtree_query_raycast(data->treedata,
+                                          &data_tls->rayhit,
+                                          tmp_co,
+                                          tmp_no,
+                                          data->ray_radius,
+                                          data->max_dist,
+                                          &hit_dist)) {
+      /* No source for this dest poly! */
+      BKE_mesh_remap_item_define_invalid(data->r_map, i);
+      return;
+    }
+    index_src = data_tls->rayhit.index;
+  }
+
+  {
+    const MLoopTri *lt = &data->treedata->looptri[index_src];
+    const int poly_index = (int)lt->poly;
+    mesh_remap_item_define_ex(
+        data->r_map, data->mem_lock, i, hit_dist, 0, 1, &poly_index, &full_weight);
+  }
+}
+
+/**
+ * Project dest poly \a i along its normal into the 2D buffers of \a data_tls, and tessellate it.
+ * Note: dst poly is early-converted into src space!
+ *
+ * \return The number of rays cast from the poly, before they are spread across its triangles.
+ */
+static int mesh_remap_poly_pnorproj_calc(const MeshRemapPolysData *data,
+                                         MeshRemapTLS *data_tls,
+                                         const int i,
+                                         float r_from_pnor_2d_mat[3][3],
+                                         float r_no[3],
+                                         float *r_poly_dst_2d_z,
+                                         float *r_poly_area_2d_inv)
+{
+  const SpaceTransform *space_transform = data->space_transform;
+  const float ray_radius = data->ray_radius;
+  const MPoly *mp = &data->polys_dst[i];
+  float(*poly_vcos_2d)[2];
+  int(*tri_vidx_2d)[3];
+  float tmp_co[3];
+
+  int tot_rays;
+  float poly_area_2d;
+
+  float pcent_dst[3];
+  float to_pnor_2d_mat[3][3];
+  float poly_dst_2d_min[2], poly_dst_2d_max[2];
+  float poly_dst_2d_size[2];
+  int j;
+
+  if (data_tls->poly_vcos_2d == NULL) {
+    data_tls->poly_size = max_zz((size_t)mp->totloop, MREMAP_DEFAULT_BUFSIZE);
+    data_tls->poly_vcos_2d = MEM_mallocN(sizeof(*data_tls->poly_vcos_2d) * data_tls->poly_size,
+                                         __func__);
+    /* Tessellated 2D poly, always (num_loops - 2) triangles. */
+    data_tls->tri_vidx_2d = MEM_mallocN(
+        sizeof(*data_tls->tri_vidx_2d) * (data_tls->poly_size - 2), __func__);
+  }
+  else if (UNLIKELY((size_t)mp->totloop > data_tls->poly_size)) {
+    data_tls->poly_size = (size_t)mp->totloop;
+    data_tls->poly_vcos_2d = MEM_reallocN(data_tls->poly_vcos_2d,
+                                          sizeof(*data_tls->poly_vcos_2d) * data_tls->poly_size);
+    data_tls->tri_vidx_2d = MEM_reallocN(
+        data_tls->tri_vidx_2d, sizeof(*data_tls->tri_vidx_2d) * (data_tls->poly_size - 2));
+  }
+  poly_vcos_2d = data_tls->poly_vcos_2d;
+  tri_vidx_2d = data_tls->tri_vidx_2d;
+
+  BKE_mesh_calc_poly_center(mp, &data->loops_dst[mp->loopstart], data->verts_dst, pcent_dst);
+  copy_v3_v3(r_no, data->poly_nors_dst[i]);
+
+  /* We do our transform here, else it'd be redone by raycast helper for each ray, ugh! */
+  if (space_transform) {
+    BLI_space_transform_apply(space_transform, pcent_dst);
+    BLI_space_transform_apply_normal(space_transform, r_no);
+  }
+
+  axis_dominant_v3_to_m3(to_pnor_2d_mat, r_no);
+  invert_m3_m3(r_from_pnor_2d_mat, to_pnor_2d_mat);
+
+  mul_m3_v3(to_pnor_2d_mat, pcent_dst);
+  *r_poly_dst_2d_z = pcent_dst[2];
+
+  /* Get (2D) bounding square of our poly. */
+  INIT_MINMAX2(poly_dst_2d_min, poly_dst_2d_max);
+
+  for (j = 0; j < mp->totloop; j++) {
+    const MLoop *ml = &data->loops_dst[j + mp->loopstart];
+    copy_v3_v3(tmp_co, data->verts_dst[ml->v].co);
+    if (space_transform) {
+      BLI_space_transform_apply(space_transform, tmp_co);
     }
-    if (weights_interp) {
-      MEM_freeN(weights_interp);
+    mul_v2_m3v3(poly_vcos_2d[j], to_pnor_2d_mat, tmp_co);
+    minmax_v2v2_v2(poly_dst_2d_min, poly_dst_2d_max, poly_vcos_2d[j]);
+  }
+
+  /* We adjust our ray-casting grid to ray_radius (the smaller, the more rays are cast),
+   * with lower/upper bounds. */
+  sub_v2_v2v2(poly_dst_2d_size, poly_dst_2d_max, poly_dst_2d_min);
+
+  if (ray_radius) {
+    tot_rays = (int)((max_ff(poly_dst_2d_size[0], poly_dst_2d_size[1]) / ray_radius) + 0.5f);
+    CLAMP(tot_rays, MREMAP_RAYCAST_TRI_SAMPLES_MIN, MREMAP_RAYCAST_TRI_SAMPLES_MAX);
+  }
+  else {
+    /* If no radius (pure rays), give max number of rays! */
+    tot_rays = MREMAP_RAYCAST_TRI_SAMPLES_MIN;
+  }
+  tot_rays *= tot_rays;
+
+  poly_area_2d = area_poly_v2((const float(*)[2])poly_vcos_2d, (unsigned int)mp->totloop);
+  /* In case we have a null-area degenerated poly... */
+  *r_poly_area_2d_inv = 1.0f / max_ff(poly_area_2d, 1e-9f);
+
+  /* Tessellate our poly. */
+  if (mp->totloop == 3) {
+    tri_vidx_2d[0][0] = 0;
+    tri_vidx_2d[0][1] = 1;
+    tri_vidx_2d[0][2] = 2;
+  }
+  if (mp->totloop == 4) {
+    tri_vidx_2d[0][0] = 0;
+    tri_vidx_2d[0][1] = 1;
+    tri_vidx_2d[0][2] = 2;
+    tri_vidx_2d[1][0] = 0;
+    tri_vidx_2d[1][1] = 2;
+    tri_vidx_2d[1][2] = 3;
+  }
+  else {
+    BLI_polyfill_calc(
+        poly_vcos_2d, (unsigned int)mp->totloop, -1, (unsigned int(*)[3])tri_vidx_2d);
+  }
+
+  return tot_rays;
+}
+
+/**
+ * The number of rays cast from the next triangle of a projected poly.
+ *
+ * All this allows us to get 'absolute' number of rays for each tri,
+ * avoiding accumulating errors over iterations, and helping better even distribution.
+ */
+static int mesh_remap_poly_pnorproj_tri_rays_num(const float tri_area,
+                                                 const int tot_rays,
+                                                 const float poly_area_2d_inv,
+                                                 float *r_done_area,
+                                                 int *r_done_rays)
+{
+  int rays_num;
+
+  *r_done_area += tri_area;
+  rays_num = max_ii((int)((float)tot_rays * *r_done_area * poly_area_2d_inv + 0.5f) - *r_done_rays,
+                    0);
+  *r_done_rays += rays_num;
+  return rays_num;
+}
+
+static void mesh_remap_polys_pnorproj_rays_task_cb(void *__restrict userdata,
+                                                   const int i,
+                                                   const TaskParallelTLS *__restrict tls)
+{
+  /* Count the random values used by each dst poly, so the sampling can start each poly where
+   * the previous one ended, see #mesh_remap_polys_pnorproj_task_cb. */
+  const MeshRemapPolysData *data = userdata;
+  MeshRemapTLS *data_tls = tls->userdata_chunk;
+  const int tris_num = data->polys_dst[i].totloop - 2;
+  float from_pnor_2d_mat[3][3], tmp_no[3];
+  float poly_dst_2d_z, poly_area_2d_inv, done_area = 0.0f;
+  int tot_rays, done_rays = 0;
+
+  tot_rays = mesh_remap_poly_pnorproj_calc(
+      data, data_tls, i, from_pnor_2d_mat, tmp_no, &poly_dst_2d_z, &poly_area_2d_inv);
+
+  for (int j = 0; j < tris_num; j++) {
+    const float(*poly_vcos_2d)[2] = (const float(*)[2])data_tls->poly_vcos_2d;
+    const int *tri = data_tls->tri_vidx_2d[j];
+
+    mesh_remap_poly_pnorproj_tri_rays_num(
+        area_tri_v2(poly_vcos_2d[tri[0]], poly_vcos_2d[tri[1]], poly_vcos_2d[tri[2]]),
+        tot_rays,
+        poly_area_2d_inv,
+        &done_area,
+        &done_rays);
+  }
+
+  /* Each ray samples its triangle with two random values. */
+  data->rng_offsets[i] = (uint64_t)done_rays * 2;
+}
+
+static void mesh_remap_polys_pnorproj_task_cb(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict tls)
+{
+  /* For each dst poly, we sample some rays from it (2D grid in pnor space)
+   * and use their hits to interpolate from source polys. */
+  const MeshRemapPolysData *data = userdata;
+  MeshRemapTLS *data_tls = tls->userdata_chunk;
+  const float ray_radius = data->ray_radius;
+  const MPoly *mp = &data->polys_dst[i];
+  float(*poly_vcos_2d)[2];
+  int(*tri_vidx_2d)[3];
+  float tmp_co[3], tmp_no[3];
+  float hit_dist;
+
+  int tot_rays, done_rays = 0;
+  float poly_area_2d_inv, done_area = 0.0f;
+
+  float from_pnor_2d_mat[3][3], poly_dst_2d_z;
+
+  float totweights = 0.0f;
+  float hit_dist_accum = 0.0f;
+  int sources_num = 0;
+  const int tris_num = mp->totloop - 2;
+  uint64_t rng_skip = data->rng_offsets[i];
+  int j;
+
+  if (data_tls->rng == NULL) {
+    data_tls->rng = BLI_rng_new(0);
+    data_tls->weights_src = MEM_calloc_arrayN(
+        (size_t)data->numpolys_src, sizeof(*data_tls->weights_src), __func__);
+  }
+  mesh_remap_tls_buffers_ensure(data_tls, MREMAP_DEFAULT_BUFSIZE);
+
+  /* Continue the sequence of a single generator used for all polys in order, so the result
+   * neither depends on the polys mapped before by this thread, nor on the amount of threads. */
+  BLI_rng_seed(data_tls->rng, 0);
+  while (rng_skip > (uint64_t)INT_MAX) {
+    BLI_rng_skip(data_tls->rng, INT_MAX);
+    rng_skip -= (uint64_t)INT_MAX;
+  }
+  BLI_rng_skip(data_tls->rng, (int)rng_skip);
+
+  tot_rays = mesh_remap_poly_pnorproj_calc(
+      data, data_tls, i, from_pnor_2d_mat, tmp_no, &poly_dst_2d_z, &poly_area_2d_inv);
+  poly_vcos_2d = data_tls->poly_vcos_2d;
+  tri_vidx_2d = data_tls->tri_vidx_2d;
+
+  for (j = 0; j < tris_num; j++) {
+    float *v1 = poly_vcos_2d[tri_vidx_2d[j][0]];
+    float *v2 = poly_vcos_2d[tri_vidx_2d[j][1]];
+    float *v3 = poly_vcos_2d[tri_vidx_2d[j][2]];
+    int rays_num = mesh_remap_poly_pnorproj_tri_rays_num(
+        area_tri_v2(v1, v2, v3), tot_rays, poly_area_2d_inv, &done_area, &done_rays);
+
+    while (rays_num--) {
+      int n = (ray_radius > 0.0f) ? MREMAP_RAYCAST_APPROXIMATE_NR : 1;
+      float w = 1.0f;
+
+      BLI_rng_get_tri_sample_float_v2(data_tls->rng, v1, v2, v3, tmp_co);
+
+      tmp_co[2] = poly_dst_2d_z;
+      mul_m3_v3(from_pnor_2d_mat, tmp_co);
+
+      /* At this point, tmp_co is a point on our poly surface, in mesh_src space! */
+      while (n--) {
+        if (mesh_remap_bvhtree_query_raycast(data->treedata,
+                                             &data_tls->rayhit,
+                                             tmp_co,
+                                             tmp_no,
+                                             ray_radius / w,
+                                             data->max_dist,
+                                             &hit_dist)) {
+          const MLoopTri *lt = &data->treedata->looptri[data_tls->rayhit.index];
+
+          if (data_tls->weights_src[lt->poly] == 0.0f) {
+            if ((size_t)sources_num == data_tls->buff_size) {
+              mesh_remap_tls_buffers_ensure(data_tls, data_tls->buff_size * 2);
+            }
+            data_tls->indices[sources_num++] = (int)lt->poly;
+          }
+          data_tls->weights_src[lt->poly] += w;
+          totweights += w;
+          hit_dist_accum += hit_dist;
+          break;
+        }
+        /* Next iteration will get bigger radius but smaller weight! */
+        w /= MREMAP_RAYCAST_APPROXIMATE_FAC;
+      }
     }
   }
+
+  if (totweights > 0.0f) {
+    mesh_remap_sampled_sources_get(
+        data_tls->weights_src, data_tls->indices, sources_num, totweights, data_tls->weights);
+    mesh_remap_item_define_ex(data->r_map,
+                              data->mem_lock,
+                              i,
+                              hit_dist_accum / totweights,
+                              0,
+                              sources_num,
+                              data_tls->indices,
+                              data_tls->weights);
+  }
+  else {
+    /* No source for this dest poly! */
+    BKE_mesh_remap_item_define_invalid(data->r_map, i);
+  }
 }
 
 void BKE_mesh_remap_calc_polys_from_mesh(const int mode,
@@ -2211,7 +2924,6 @@ void BKE_mesh_remap_calc_polys_from_mesh(const int mode,
   const float full_weight = 1.0f;
   const float max_dist_sq = max_dist * max_dist;
   float(*poly_nors_dst)[3] = NULL;
-  float tmp_co[3], tmp_no[3];
   int i;
 
   BLI_assert(mode & MREMAP_MODE_POLY);
@@ -2246,246 +2958,60 @@ void BKE_mesh_remap_calc_polys_from_mesh(const int mode,
   }
   else {
     BVHTreeFromMesh treedata = {NULL};
-    BVHTreeNearest nearest = {0};
-    BVHTreeRayHit rayhit = {0};
-    float hit_dist;
+    SpinLock mem_lock;
+
+    MeshRemapPolysData data = {
+        .mode = mode,
+        .space_transform = space_transform,
+        .max_dist = max_dist,
+        .max_dist_sq = max_dist_sq,
+        .ray_radius = ray_radius,
+        .verts_dst = verts_dst,
+        .loops_dst = loops_dst,
+        .polys_dst = polys_dst,
+        .poly_nors_dst = (const float(*)[3])poly_nors_dst,
+        .treedata = &treedata,
+        .numpolys_src = me_src->totpoly,
+        .r_map = r_map,
+        .mem_lock = &mem_lock,
+    };
 
     BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
+    BLI_spin_init(&mem_lock);
 
-    if (mode == MREMAP_MODE_POLY_NEAREST) {
-      nearest.index = -1;
-
-      for (i = 0; i < numpolys_dst; i++) {
-        MPoly *mp = &polys_dst[i];
-
-        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, tmp_co);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          const MLoopTri *lt = &treedata.looptri[nearest.index];
-          const int poly_index = (int)lt->poly;
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &poly_index, &full_weight);
-        }
-        else {
-          /* No source for this dest poly! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
-    }
-    else if (mode == MREMAP_MODE_POLY_NOR) {
-      BLI_assert(poly_nors_dst);
-
-      for (i = 0; i < numpolys_dst; i++) {
-        MPoly *mp = &polys_dst[i];
-
-        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, tmp_co);
-        copy_v3_v3(tmp_no, poly_nors_dst[i]);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-          BLI_space_transform_apply_normal(space_transform, tmp_no);
-        }
+    if (ELEM(mode, MREMAP_MODE_POLY_NEAREST, MREMAP_MODE_POLY_NOR)) {
+      BLI_assert(mode != MREMAP_MODE_POLY_NOR || poly_nors_dst);
 
-        if (mesh_remap_bvhtree_query_raycast(
-                &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist)) {
-          const MLoopTri *lt = &treedata.looptri[rayhit.index];
-          const int poly_index = (int)lt->poly;
-
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &poly_index, &full_weight);
-        }
-        else {
-          /* No source for this dest poly! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
+      mesh_remap_parallel_range(numpolys_dst, &data, mesh_remap_polys_task_cb);
     }
     else if (mode == MREMAP_MODE_POLY_POLYINTERP_PNORPROJ) {
       /* We cast our rays randomly, with a pseudo-even distribution
        * (since we spread across tessellated tris,
        * with additional weighting based on each tri's relative area).
        */
-      RNG *rng = BLI_rng_new(0);
-
-      const size_t numpolys_src = (size_t)me_src->totpoly;
-
-      /* Here it's simpler to just allocate for all polys :/ */
-      int *indices = MEM_mallocN(sizeof(*indices) * numpolys_src, __func__);
-      float *weights = MEM_mallocN(sizeof(*weights) * numpolys_src, __func__);
-
-      size_t tmp_poly_size = MREMAP_DEFAULT_BUFSIZE;
-      float(*poly_vcos_2d)[2] = MEM_mallocN(sizeof(*poly_vcos_2d) * tmp_poly_size, __func__);
-      /* Tessellated 2D poly, always (num_loops - 2) triangles. */
-      int(*tri_vidx_2d)[3] = MEM_mallocN(sizeof(*tri_vidx_2d) * (tmp_poly_size - 2), __func__);
+      uint64_t *rng_offsets = MEM_malloc_arrayN(
+          (size_t)numpolys_dst, sizeof(*rng_offsets), __func__);
+      uint64_t rng_offset = 0;
 
+      data.rng_offsets = rng_offsets;
+      mesh_remap_parallel_range(numpolys_dst, &data, mesh_remap_polys_pnorproj_rays_task_cb);
       for (i = 0; i < numpolys_dst; i++) {
-        /* For each dst poly, we sample some rays from it (2D grid in pnor space)
-         * and use their hits to interpolate from source polys. */
-        /* Note: dst poly is early-converted into src space! */
-        MPoly *mp = &polys_dst[i];
-
-        int tot_rays, done_rays = 0;
-        float poly_area_2d_inv, done_area = 0.0f;
-
-        float pcent_dst[3];
-        float to_pnor_2d_mat[3][3], from_pnor_2d_mat[3][3];
-        float poly_dst_2d_min[2], poly_dst_2d_max[2], poly_dst_2d_z;
-        float poly_dst_2d_size[2];
-
-        float totweights = 0.0f;
-        float hit_dist_accum = 0.0f;
-        int sources_num = 0;
-        const int tris_num = mp->totloop - 2;
-        int j;
-
-        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, pcent_dst);
-        copy_v3_v3(tmp_no, poly_nors_dst[i]);
-
-        /* We do our transform here, else it'd be redone by raycast helper for each ray, ugh! */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, pcent_dst);
-          BLI_space_transform_apply_normal(space_transform, tmp_no);
-        }
-
-        copy_vn_fl(weights, (int)numpolys_src, 0.0f);
-
-        if (UNLIKELY((size_t)mp->totloop > tmp_poly_size)) {
-          tmp_poly_size = (size_t)mp->totloop;
-          poly_vcos_2d = MEM_reallocN(poly_vcos_2d, sizeof(*poly_vcos_2d) * tmp_poly_size);
-          tri_vidx_2d = MEM_reallocN(tri_vidx_2d, sizeof(*tri_vidx_2d) * (tmp_poly_size - 2));
-        }
-
-        axis_dominant_v3_to_m3(to_pnor_2d_mat, tmp_no);
-        invert_m3_m3(from_pnor_2d_mat, to_pnor_2d_mat);
-
-        mul_m3_v3(to_pnor_2d_mat, pcent_dst);
-        poly_dst_2d_z = pcent_dst[2];
-
-        /* Get (2D) bounding square of our poly. */
-        INIT_MINMAX2(poly_dst_2d_min, poly_dst_2d_max);
-
-        for (j = 0; j < mp->totloop; j++) {
-          MLoop *ml = &loops_dst[j + mp->loopstart];
-          copy_v3_v3(tmp_co, verts_dst[ml->v].co);
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-          }
-          mul_v2_m3v3(poly_vcos_2d[j], to_pnor_2d_mat, tmp_co);
-          minmax_v2v2_v2(poly_dst_2d_min, poly_dst_2d_max, poly_vcos_2d[j]);
-        }
-
-        /* We adjust our ray-casting grid to ray_radius (the smaller, the more rays are cast),
-         * with lower/upper bounds. */
-        sub_v2_v2v2(poly_dst_2d_size, poly_dst_2d_max, poly_dst_2d_min);
-
-        if (ray_radius) {
-          tot_rays = (int)((max_ff(poly_dst_2d_size[0], poly_dst_2d_size[1]) / ray_radius) + 0.5f);
-          CLAMP(tot_rays, MREMAP_RAYCAST_TRI_SAMPLES_MIN, MREMAP_RAYCAST_TRI_SAMPLES_MAX);
-        }
-        else {
-          /* If no radius (pure rays), give max number of rays! */
-          tot_rays = MREMAP_RAYCAST_TRI_SAMPLES_MIN;
-        }
-        tot_rays *= tot_rays;
-
-        poly_area_2d_inv = area_poly_v2((const float(*)[2])poly_vcos_2d,
-                                        (unsigned int)mp->totloop);
-        /* In case we have a null-area degenerated poly... */
-        poly_area_2d_inv = 1.0f / max_ff(poly_area_2d_inv, 1e-9f);
-
-        /* Tessellate our poly. */
-        if (mp->totloop == 3) {
-          tri_vidx_2d[0][0] = 0;
-          tri_vidx_2d[0][1] = 1;
-          tri_vidx_2d[0][2] = 2;
-        }
-        if (mp->totloop == 4) {
-          tri_vidx_2d[0][0] = 0;
-          tri_vidx_2d[0][1] = 1;
-          tri_vidx_2d[0][2] = 2;
-          tri_vidx_2d[1][0] = 0;
-          tri_vidx_2d[1][1] = 2;
-          tri_vidx_2d[1][2] = 3;
-        }
-        else {
-          BLI_polyfill_calc(
-              poly_vcos_2d, (unsigned int)mp->totloop, -1, (unsigned int(*)[3])tri_vidx_2d);
-        }
-
-        for (j = 0; j < tris_num; j++) {
-          float *v1 = poly_vcos_2d[tri_vidx_2d[j][0]];
-          float *v2 = poly_vcos_2d[tri_vidx_2d[j][1]];
-          float *v3 = poly_vcos_2d[tri_vidx_2d[j][2]];
-          int rays_num;
-
-          /* All this allows us to get 'absolute' number of rays for each tri,
-           * avoiding accumulating errors over iterations, and helping better even distribution. */
-          done_area += area_tri_v2(v1, v2, v3);
-          rays_num = max_ii(
-              (int)((float)tot_rays * done_area * poly_area_2d_inv + 0.5f) - done_rays, 0);
-          done_rays += rays_num;
-
-          while (rays_num--) {
-            int n = (ray_radius > 0.0f) ? MREMAP_RAYCAST_APPROXIMATE_NR : 1;
-            float w = 1.0f;
-
-            BLI_rng_get_tri_sample_float_v2(rng, v1, v2, v3, tmp_co);
-
-            tmp_co[2] = poly_dst_2d_z;
-            mul_m3_v3(from_pnor_2d_mat, tmp_co);
-
-            /* At this point, tmp_co is a point on our poly surface, in mesh_src space! */
-            while (n--) {
-              if (mesh_remap_bvhtree_query_raycast(
-                      &treedata, &rayhit, tmp_co, tmp_no, ray_radius / w, max_dist, &hit_dist)) {
-                const MLoopTri *lt = &treedata.looptri[rayhit.index];
-
-                weights[lt->poly] += w;
-                totweights += w;
-                hit_dist_accum += hit_dist;
-                break;
-              }
-              /* Next iteration will get bigger radius but smaller weight! */
-              w /= MREMAP_RAYCAST_APPROXIMATE_FAC;
-            }
-          }
-        }
-
-        if (totweights > 0.0f) {
-          for (j = 0; j < (int)numpolys_src; j++) {
-            if (!weights[j]) {
-              continue;
-            }
-            /* Note: sources_num is always <= j! */
-            weights[sources_num] = weights[j] / totweights;
-            indices[sources_num] = j;
-            sources_num++;
-          }
-          mesh_remap_item_define(
-              r_map, i, hit_dist_accum / totweights, 0, sources_num, indices, weights);
-        }
-        else {
-          /* No source for this dest poly! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
+        const uint64_t rng_num = rng_offsets[i];
+        rng_offsets[i] = rng_offset;
+        rng_offset += rng_num;
       }
 
-      MEM_freeN(tri_vidx_2d);
-      MEM_freeN(poly_vcos_2d);
-      MEM_freeN(indices);
-      MEM_freeN(weights);
-      BLI_rng_free(rng);
+      mesh_remap_parallel_range(numpolys_dst, &data, mesh_remap_polys_pnorproj_task_cb);
+
+      MEM_freeN(rng_offsets);
     }
     else {
       CLOG_WARN(&LOG, "Unsupported mesh-to-mesh poly mapping mode (%d)!", mode);
       memset(r_map->items, 0, sizeof(*r_map->items) * (size_t)numpolys_dst);
     }
 
+    BLI_spin_end(&mem_lock);
+
     free_bvhtree_from_mesh(&treedata);
   }
 }
@@ -68,6 +68,7 @@ void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int UNUSED(flag))
   runtime->subdiv_ccg = NULL;
   memset(&runtime->looptris, 0, sizeof(runtime->looptris));
   runtime->bvh_cache = NULL;
+  runtime->bvh_cache_refit = NULL;
   runtime->shrinkwrap_data = NULL;
 
   mesh->runtime.eval_mutex = MEM_mallocN(sizeof(ThreadMutex), "mesh runtime eval_mutex");
@@ -228,6 +229,7 @@ bool BKE_mesh_runtime_clear_edit_data(Mesh *mesh)
 void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
 {
   bvhcache_free(&mesh->runtime.bvh_cache);
+  bvhcache_free(&mesh->runtime.bvh_cache_refit);
   MEM_SAFE_FREE(mesh->runtime.looptris.array);
   /* TODO(sergey): Does this really belong here? */
   if (mesh->runtime.subdiv_ccg != NULL) {
@@ -99,6 +99,11 @@ typedef struct ShrinkwrapCalcCBData {
 
   float *proj_axis;
   SpaceTransform *local2aux;
+
+  /* Batched nearest queries, see #shrinkwrap_calc_nearest_batch. */
+  float (*tree_co)[3];
+  float *weights;
+  BVHTreeNearest *nearest;
 } ShrinkwrapCalcCBData;
 
 /* Checks if the modifier needs target normals with these settings. */
@@ -338,55 +343,91 @@ void BKE_shrinkwrap_compute_boundary_data(struct Mesh *mesh)
 }
 
 /*
- * Shrinkwrap to the nearest vertex
- *
- * it builds a kdtree of vertexs we can attach to and then
- * for each vertex performs a nearest vertex search on the tree
+ * Nearest point of the target for all vertices at once
  */
-static void shrinkwrap_calc_nearest_vertex_cb_ex(void *__restrict userdata,
-                                                 const int i,
-                                                 const TaskParallelTLS *__restrict tls)
+static void shrinkwrap_calc_nearest_batch_init_cb_ex(void *__restrict userdata,
+                                                     const int i,
+                                                     const TaskParallelTLS *__restrict UNUSED(tls))
 {
   ShrinkwrapCalcCBData *data = userdata;
-
   ShrinkwrapCalcData *calc = data->calc;
-  BVHTreeFromMesh *treeData = &data->tree->treeData;
-  BVHTreeNearest *nearest = tls->userdata_chunk;
-
-  float *co = calc->vertexCos[i];
-  float tmp_co[3];
   float weight = defvert_array_find_weight_safe(calc->dvert, i, calc->vgroup);
 
   if (calc->invert_vgroup) {
     weight = 1.0f - weight;
   }
-
-  if (weight == 0.0f) {
-    return;
-  }
+  data->weights[i] = weight;
 
   /* Convert the vertex to tree coordinates */
   if (calc->vert) {
-    copy_v3_v3(tmp_co, calc->vert[i].co);
+    copy_v3_v3(data->tree_co[i], calc->vert[i].co);
   }
   else {
-    copy_v3_v3(tmp_co, co);
+    copy_v3_v3(data->tree_co[i], calc->vertexCos[i]);
   }
-  BLI_space_transform_apply(&calc->local2target, tmp_co);
+  BLI_space_transform_apply(&calc->local2target, data->tree_co[i]);
 
-  /* Use local proximity heuristics (to reduce the nearest search)
-   *
-   * If we already had an hit before.. we assume this vertex is going to have a close hit to that
-   * other vertex so we can initiate the "nearest.dist" with the expected value to that last hit.
-   * This will lead in pruning of the search tree. */
-  if (nearest->index != -1) {
-    nearest->dist_sq = len_squared_v3v3(tmp_co, nearest->co);
-  }
-  else {
-    nearest->dist_sq = FLT_MAX;
-  }
+  /* Vertices which aren't affected don't search at all. */
+  data->nearest[i].index = -1;
+  data->nearest[i].dist_sq = (weight == 0.0f) ? 0.0f : FLT_MAX;
+}
+
+/**
+ * Fill in the tree coordinates, weights and nearest points of all vertices,
+ * free them with #shrinkwrap_calc_nearest_batch_free.
+ */
+static void shrinkwrap_calc_nearest_batch(ShrinkwrapCalcCBData *data)
+{
+  ShrinkwrapCalcData *calc = data->calc;
+  BVHTreeFromMesh *treeData = &data->tree->treeData;
+
+  data->tree_co = MEM_malloc_arrayN((size_t)calc->numVerts, sizeof(*data->tree_co), __func__);
+  data->weights = MEM_malloc_arrayN((size_t)calc->numVerts, sizeof(*data->weights), __func__);
+  data->nearest = MEM_malloc_arrayN((size_t)calc->numVerts, sizeof(*data->nearest), __func__);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (calc->numVerts > BKE_MESH_OMP_LIMIT);
+  BLI_task_parallel_range(
+      0, calc->numVerts, data, shrinkwrap_calc_nearest_batch_init_cb_ex, &settings);
+
+  /* Use local proximity heuristics (to reduce the nearest search).
+   * The queries are sorted spatially, so the nearest point of the previous vertex gives a close
+   * upper bound to the distance, which prunes most of the search tree. */
+  BLI_bvhtree_find_nearest_batch(data->tree->bvh,
+                                 (const float(*)[3])data->tree_co,
+                                 data->nearest,
+                                 calc->numVerts,
+                                 treeData->nearest_callback,
+                                 treeData,
+                                 BVH_NEAREST_REUSE_PREVIOUS);
+}
+
+static void shrinkwrap_calc_nearest_batch_free(ShrinkwrapCalcCBData *data)
+{
+  MEM_freeN(data->tree_co);
+  MEM_freeN(data->weights);
+  MEM_freeN(data->nearest);
+}
 
-  BLI_bvhtree_find_nearest(treeData->tree, tmp_co, nearest, treeData->nearest_callback, treeData);
+/*
+ * Shrinkwrap to the nearest vertex
+ *
+ * it builds a kdtree of vertexs we can attach to and then
+ * for each vertex performs a nearest vertex search on the tree
+ */
+static void shrinkwrap_calc_nearest_vertex_cb_ex(void *__restrict userdata,
+                                                 const int i,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ShrinkwrapCalcCBData *data = userdata;
+
+  ShrinkwrapCalcData *calc = data->calc;
+  const BVHTreeNearest *nearest = &data->nearest[i];
+
+  float *co = calc->vertexCos[i];
+  float tmp_co[3];
+  float weight = data->weights[i];
 
   /* Found the nearest vertex */
   if (nearest->index != -1) {
@@ -407,23 +448,19 @@ static void shrinkwrap_calc_nearest_vertex_cb_ex(void *__restrict userdata,
 
 static void shrinkwrap_calc_nearest_vertex(ShrinkwrapCalcData *calc)
 {
-  BVHTreeNearest nearest = NULL_BVHTreeNearest;
-
-  /* Setup nearest */
-  nearest.index = -1;
-  nearest.dist_sq = FLT_MAX;
-
   ShrinkwrapCalcCBData data = {
       .calc = calc,
       .tree = calc->tree,
   };
+  shrinkwrap_calc_nearest_batch(&data);
+
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
   settings.use_threading = (calc->numVerts > BKE_MESH_OMP_LIMIT);
-  settings.userdata_chunk = &nearest;
-  settings.userdata_chunk_size = sizeof(nearest);
   BLI_task_parallel_range(
       0, calc->numVerts, &data, shrinkwrap_calc_nearest_vertex_cb_ex, &settings);
+
+  shrinkwrap_calc_nearest_batch_free(&data);
 }
 
 /*
@@ -1144,24 +1181,10 @@ static void shrinkwrap_calc_nearest_surface_point_cb_ex(void *__restrict userdat
   }
   BLI_space_transform_apply(&calc->local2target, tmp_co);
 
-  /* Use local proximity heuristics (to reduce the nearest search)
-   *
-   * If we already had an hit before.. we assume this vertex is going to have a close hit to that
-   * other vertex so we can initiate the "nearest.dist" with the expected value to that last hit.
-   * This will lead in pruning of the search tree. */
-  if (nearest->index != -1) {
-    if (calc->smd->shrinkType == MOD_SHRINKWRAP_TARGET_PROJECT) {
-      /* Heuristic doesn't work because of additional restrictions. */
-      nearest->index = -1;
-      nearest->dist_sq = FLT_MAX;
-    }
-    else {
-      nearest->dist_sq = len_squared_v3v3(tmp_co, nearest->co);
-    }
-  }
-  else {
-    nearest->dist_sq = FLT_MAX;
-  }
+  /* Local proximity heuristics don't work because of additional restrictions,
+   * the nearest surface mode uses #shrinkwrap_calc_nearest_surface_point_batch_cb_ex. */
+  nearest->index = -1;
+  nearest->dist_sq = FLT_MAX;
 
   BKE_shrinkwrap_find_nearest_surface(data->tree, nearest, tmp_co, calc->smd->shrinkType);
 
@@ -1183,6 +1206,35 @@ static void shrinkwrap_calc_nearest_surface_point_cb_ex(void *__restrict userdat
   }
 }
 
+static void shrinkwrap_calc_nearest_surface_point_batch_cb_ex(
+    void *__restrict userdata, const int i, const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ShrinkwrapCalcCBData *data = userdata;
+
+  ShrinkwrapCalcData *calc = data->calc;
+  const BVHTreeNearest *nearest = &data->nearest[i];
+
+  float *co = calc->vertexCos[i];
+  float tmp_co[3];
+
+  /* Found the nearest vertex */
+  if (nearest->index != -1) {
+    BKE_shrinkwrap_snap_point_to_surface(data->tree,
+                                         NULL,
+                                         calc->smd->shrinkMode,
+                                         nearest->index,
+                                         nearest->co,
+                                         nearest->no,
+                                         calc->keepDist,
+                                         data->tree_co[i],
+                                         tmp_co);
+
+    /* Convert the coordinates back to mesh coordinates */
+    BLI_space_transform_invert(&calc->local2target, tmp_co);
+    interp_v3_v3v3(co, co, tmp_co, data->weights[i]); /* linear interpolation */
+  }
+}
+
 /**
  * Compute a smooth normal of the target (if applicable) at the hit location.
  *
@@ -1371,6 +1423,23 @@ void BKE_shrinkwrap_snap_point_to_surface(const struct ShrinkwrapTreeData *tree,
 
 static void shrinkwrap_calc_nearest_surface_point(ShrinkwrapCalcData *calc)
 {
+  if (calc->smd->shrinkType == MOD_SHRINKWRAP_NEAREST_SURFACE) {
+    ShrinkwrapCalcCBData data = {
+        .calc = calc,
+        .tree = calc->tree,
+    };
+    shrinkwrap_calc_nearest_batch(&data);
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (calc->numVerts > BKE_MESH_OMP_LIMIT);
+    BLI_task_parallel_range(
+        0, calc->numVerts, &data, shrinkwrap_calc_nearest_surface_point_batch_cb_ex, &settings);
+
+    shrinkwrap_calc_nearest_batch_free(&data);
+    return;
+  }
+
   BVHTreeNearest nearest = NULL_BVHTreeNearest;
 
   /* Setup nearest */
@@ -89,6 +89,11 @@ typedef struct BVHTreeRayHit {
   float dist;
 } BVHTreeRayHit;
 
+enum {
+  /* Split nodes using a binned surface area heuristic instead of the median of the largest axis,
+   * the tree takes longer to build but is faster to query. */
+  BVH_BUILD_SAH = (1 << 0),
+};
 enum {
   /* Use a priority queue to process nodes in the optimal order (for slow callbacks) */
   BVH_OVERLAP_USE_THREADING = (1 << 0),
@@ -98,6 +103,9 @@ enum {
 enum {
   /* Use a priority queue to process nodes in the optimal order (for slow callbacks) */
   BVH_NEAREST_OPTIMAL_ORDER = (1 << 0),
+  /* Batch queries only: limit the search to the distance to the result of the previous query,
+   * only valid when the callback finds the nearest point of each element, without other tests. */
+  BVH_NEAREST_REUSE_PREVIOUS = (1 << 1),
 };
 enum {
   /* calculate IsectRayPrecalc data */
@@ -144,7 +152,12 @@ typedef bool (*BVHTree_WalkOrderCallback)(const BVHTreeAxisRange *bounds,
                                           char axis,
                                           void *userdata);
 
+/* callback to BLI_bvhtree_update_leafs, write the points of the element
+ * inserted with this index to r_co and return their number. */
+typedef int (*BVHTree_UpdateLeafCallback)(void *userdata, int index, float r_co[4][3]);
+
 BVHTree *BLI_bvhtree_new(int maxsize, float epsilon, char tree_type, char axis);
+BVHTree *BLI_bvhtree_new_ex(int maxsize, float epsilon, char tree_type, char axis, int flag);
 void BLI_bvhtree_free(BVHTree *tree);
 
 /* construct: first insert points, then call balance */
@@ -155,6 +168,8 @@ void BLI_bvhtree_balance(BVHTree *tree);
 bool BLI_bvhtree_update_node(
     BVHTree *tree, int index, const float co[3], const float co_moving[3], int numpoints);
 void BLI_bvhtree_update_tree(BVHTree *tree);
+void BLI_bvhtree_update_leafs(BVHTree *tree, BVHTree_UpdateLeafCallback callback, void *userdata);
+float BLI_bvhtree_get_area_ratio(const BVHTree *tree);
 
 int BLI_bvhtree_overlap_thread_num(const BVHTree *tree);
 
@@ -199,6 +214,24 @@ int BLI_bvhtree_find_nearest_first(BVHTree *tree,
                                    BVHTree_NearestPointCallback callback,
                                    void *userdata);
 
+/* batches of queries, processed in parallel (callbacks must be thread-safe) */
+void BLI_bvhtree_find_nearest_batch(BVHTree *tree,
+                                    const float (*co)[3],
+                                    BVHTreeNearest *nearest,
+                                    int co_len,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata,
+                                    int flag);
+void BLI_bvhtree_ray_cast_batch(BVHTree *tree,
+                                const float (*co)[3],
+                                const float (*dir)[3],
+                                float radius,
+                                BVHTreeRayHit *hit,
+                                int ray_len,
+                                BVHTree_RayCastCallback callback,
+                                void *userdata,
+                                int flag);
+
 int BLI_bvhtree_ray_cast_ex(BVHTree *tree,
                             const float co[3],
                             const float dir[3],
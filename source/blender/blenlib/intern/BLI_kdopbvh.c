@@ -36,9 +36,12 @@
  *   #BLI_bvhtree_overlap, #BVHOverlapData_Shared, #BVHOverlapData_Thread
  * - Range Query:
  *   #BLI_bvhtree_range_query
+ * - Batches of nearest point and ray-cast queries:
+ *   #BLI_bvhtree_find_nearest_batch, #BLI_bvhtree_ray_cast_batch
  */
 
 #include <assert.h>
+#include <stdlib.h> /* for qsort */
 
 #include "MEM_guardedalloc.h"
 
@@ -102,11 +105,12 @@ struct BVHTree {
   axis_t start_axis, stop_axis; /* bvhtree_kdop_axes array indices according to axis */
   axis_t axis;                  /* kdop type (6 => OBB, 7 => AABB, ...) */
   char tree_type;               /* type of tree (4 => quadtree) */
+  char build_flag;              /* BVH_BUILD_* flags */
 };
 
 /* optimization, ensure we stay small */
-BLI_STATIC_ASSERT((sizeof(void *) == 8 && sizeof(BVHTree) <= 48) ||
-                      (sizeof(void *) == 4 && sizeof(BVHTree) <= 32),
+BLI_STATIC_ASSERT((sizeof(void *) == 8 && sizeof(BVHTree) <= 56) ||
+                      (sizeof(void *) == 4 && sizeof(BVHTree) <= 36),
                   "over sized")
 
 /* avoid duplicating vars in BVHOverlapData_Thread */
@@ -858,14 +862,390 @@ static void non_recursive_bvh_div_nodes(const BVHTree *tree,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Binned SAH Build
+ *
+ * Optional top-down build (#BVH_BUILD_SAH), nodes are split where the surface area heuristic
+ * estimates the cheapest queries instead of at the median of the largest axis.
+ *
+ * A branch with N leafs reserves N - 1 consecutive branch slots for its subtree,
+ * which is enough for any tree where branches have at least two children.
+ * This way subtrees can be built by independent tasks, the branches are linked
+ * into #BVHTree.nodes in depth first order afterwards, so children still come after parents.
+ * \{ */
+
+/* Number of bins per axis the split candidates are evaluated at. */
+#define BVH_SAH_BINS 16
+/* Split at the median below this depth, so unbalanced splits can't make the tree too deep. */
+#define BVH_SAH_MAX_DEPTH 48
+
+/* Bounds on the x, y and z axis, with the same layout as the start of #BVHNode.bv. */
+typedef float BVHSahBounds[3][2];
+
+typedef struct BVHSahBin {
+  BVHSahBounds bounds;
+  int count;
+} BVHSahBin;
+
+BLI_INLINE void sah_bounds_init(BVHSahBounds bounds)
+{
+  for (int axis = 0; axis < 3; axis++) {
+    bounds[axis][0] = FLT_MAX;
+    bounds[axis][1] = -FLT_MAX;
+  }
+}
+
+BLI_INLINE void sah_bounds_expand(BVHSahBounds bounds, const float *bv)
+{
+  for (int axis = 0; axis < 3; axis++) {
+    bounds[axis][0] = min_ff(bounds[axis][0], bv[2 * axis]);
+    bounds[axis][1] = max_ff(bounds[axis][1], bv[(2 * axis) + 1]);
+  }
+}
+
+/* Half the surface area, the constant factor doesn't change the split. */
+BLI_INLINE float sah_bounds_area(const BVHSahBounds bounds)
+{
+  const float dx = bounds[0][1] - bounds[0][0];
+  const float dy = bounds[1][1] - bounds[1][0];
+  const float dz = bounds[2][1] - bounds[2][0];
+  return dx * dy + dy * dz + dz * dx;
+}
+
+/* Twice the centroid, the scale doesn't matter for binning. */
+BLI_INLINE float sah_centroid(const float *bv, const int axis)
+{
+  return bv[2 * axis] + bv[(2 * axis) + 1];
+}
+
+BLI_INLINE int sah_bin_index(const BVHNode *node,
+                             const int axis,
+                             const float centroid_min[3],
+                             const float bin_scale[3])
+{
+  const int bin = (int)((sah_centroid(node->bv, axis) - centroid_min[axis]) * bin_scale[axis]);
+  return CLAMPIS(bin, 0, BVH_SAH_BINS - 1);
+}
+
+/**
+ * Partition the leafs in the range [begin, end) in two.
+ *
+ * \param r_bounds: The bounds of both partitions.
+ * \return the index of the first leaf of the second partition, always in ]begin, end[.
+ */
+static int sah_split_leafs(BVHNode **leafs_array,
+                           const int begin,
+                           const int end,
+                           const bool use_median,
+                           char *r_axis,
+                           BVHSahBounds r_bounds[2])
+{
+  float centroid_min[3], centroid_max[3];
+  INIT_MINMAX(centroid_min, centroid_max);
+  for (int i = begin; i < end; i++) {
+    for (int axis = 0; axis < 3; axis++) {
+      const float centroid = sah_centroid(leafs_array[i]->bv, axis);
+      centroid_min[axis] = min_ff(centroid_min[axis], centroid);
+      centroid_max[axis] = max_ff(centroid_max[axis], centroid);
+    }
+  }
+  float extent[3];
+  sub_v3_v3v3(extent, centroid_max, centroid_min);
+  const int largest_axis = axis_dominant_v3_single(extent);
+
+  if (!use_median && extent[largest_axis] > 0.0f) {
+    BVHSahBin bins[3][BVH_SAH_BINS];
+    float bin_scale[3];
+    for (int axis = 0; axis < 3; axis++) {
+      /* Keep the largest centroid in the last bin. */
+      bin_scale[axis] = (extent[axis] > 0.0f) ? (BVH_SAH_BINS * 0.9999f) / extent[axis] : 0.0f;
+      for (int b = 0; b < BVH_SAH_BINS; b++) {
+        sah_bounds_init(bins[axis][b].bounds);
+        bins[axis][b].count = 0;
+      }
+    }
+    for (int i = begin; i < end; i++) {
+      const BVHNode *node = leafs_array[i];
+      for (int axis = 0; axis < 3; axis++) {
+        BVHSahBin *bin = &bins[axis][sah_bin_index(node, axis, centroid_min, bin_scale)];
+        sah_bounds_expand(bin->bounds, node->bv);
+        bin->count++;
+      }
+    }
+
+    /* Find the cheapest split between two bins. */
+    float best_cost = FLT_MAX;
+    int best_axis = -1;
+    int best_bin = 0;
+    for (int axis = 0; axis < 3; axis++) {
+      if (extent[axis] == 0.0f) {
+        continue;
+      }
+      BVHSahBounds right_bounds[BVH_SAH_BINS];
+      int right_count[BVH_SAH_BINS];
+      BVHSahBounds bounds;
+      int count = 0;
+      sah_bounds_init(bounds);
+      for (int b = BVH_SAH_BINS - 1; b > 0; b--) {
+        sah_bounds_expand(bounds, &bins[axis][b].bounds[0][0]);
+        count += bins[axis][b].count;
+        memcpy(right_bounds[b], bounds, sizeof(bounds));
+        right_count[b] = count;
+      }
+      count = 0;
+      sah_bounds_init(bounds);
+      for (int b = 0; b < BVH_SAH_BINS - 1; b++) {
+        sah_bounds_expand(bounds, &bins[axis][b].bounds[0][0]);
+        count += bins[axis][b].count;
+        if (count == 0 || right_count[b + 1] == 0) {
+          continue;
+        }
+        const float cost = sah_bounds_area(bounds) * (float)count +
+                           sah_bounds_area(right_bounds[b + 1]) * (float)right_count[b + 1];
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_axis = axis;
+          best_bin = b;
+          memcpy(r_bounds[0], bounds, sizeof(bounds));
+          memcpy(r_bounds[1], right_bounds[b + 1], sizeof(bounds));
+        }
+      }
+    }
+
+    if (best_axis != -1) {
+      int i = begin, j = end - 1;
+      while (i <= j) {
+        if (sah_bin_index(leafs_array[i], best_axis, centroid_min, bin_scale) <= best_bin) {
+          i++;
+        }
+        else {
+          SWAP(BVHNode *, leafs_array[i], leafs_array[j]);
+          j--;
+        }
+      }
+      BLI_assert(i > begin && i < end);
+      *r_axis = (char)best_axis;
+      return i;
+    }
+  }
+
+  /* All centroids are in the same place (or the tree is too deep already), split in the middle.
+   * Like #split_leafs, only partitioning around the middle leaf is needed. */
+  const int mid = (begin + end) / 2;
+  partition_nth_element(leafs_array, begin, end, mid, (largest_axis * 2) + 1);
+  sah_bounds_init(r_bounds[0]);
+  sah_bounds_init(r_bounds[1]);
+  for (int i = begin; i < end; i++) {
+    sah_bounds_expand(r_bounds[i < mid ? 0 : 1], leafs_array[i]->bv);
+  }
+  *r_axis = (char)largest_axis;
+  return mid;
+}
+
+typedef struct BVHSahBuildData {
+  const BVHTree *tree;
+  BVHNode *branches_array;
+  BVHNode **leafs_array;
+  /** Only set when building subtrees in parallel. */
+  TaskPool *task_pool;
+} BVHSahBuildData;
+
+typedef struct BVHSahBuildTask {
+  int branch_index;
+  int leafs_begin;
+  int leafs_end;
+  int depth;
+} BVHSahBuildTask;
+
+typedef struct BVHSahChild {
+  int leafs_begin;
+  int leafs_end;
+  BVHSahBounds bounds;
+} BVHSahChild;
+
+static void sah_bvh_build_task_cb(TaskPool *__restrict pool, void *taskdata, int thread_id);
+
+static void sah_bvh_build_recursive(const BVHSahBuildData *data,
+                                    const int branch_index,
+                                    const int leafs_begin,
+                                    const int leafs_end,
+                                    const int depth,
+                                    const int thread_id)
+{
+  const int tree_type = data->tree->tree_type;
+  BVHNode **leafs_array = data->leafs_array;
+  BVHNode *node = &data->branches_array[branch_index];
+  BVHSahChild children[MAX_TREETYPE];
+  int totnode = 1;
+
+  refit_kdop_hull(data->tree, node, leafs_begin, leafs_end);
+
+  /* Keep splitting the child with the largest surface area in two, until the node is full. */
+  children[0].leafs_begin = leafs_begin;
+  children[0].leafs_end = leafs_end;
+  sah_bounds_init(children[0].bounds);
+  sah_bounds_expand(children[0].bounds, node->bv);
+  while (totnode < tree_type) {
+    int k = -1;
+    for (int i = 0; i < totnode; i++) {
+      if ((children[i].leafs_end - children[i].leafs_begin > 1) &&
+          (k == -1 || sah_bounds_area(children[i].bounds) > sah_bounds_area(children[k].bounds))) {
+        k = i;
+      }
+    }
+    if (k == -1) {
+      break;
+    }
+    BVHSahChild *child = &children[k];
+    BVHSahChild *child_next = &children[totnode];
+    BVHSahBounds bounds[2];
+    char split_axis;
+    const int mid = sah_split_leafs(leafs_array,
+                                    child->leafs_begin,
+                                    child->leafs_end,
+                                    depth >= BVH_SAH_MAX_DEPTH,
+                                    &split_axis,
+                                    bounds);
+    if (totnode == 1) {
+      /* Save split axis (this can be used on raytracing to speedup the query time) */
+      node->main_axis = split_axis;
+    }
+    child_next->leafs_begin = mid;
+    child_next->leafs_end = child->leafs_end;
+    memcpy(child_next->bounds, bounds[1], sizeof(bounds[1]));
+    child->leafs_end = mid;
+    memcpy(child->bounds, bounds[0], sizeof(bounds[0]));
+    totnode++;
+  }
+
+  /* Queries visit children in order along the main axis, sort them accordingly. */
+  const int main_axis = node->main_axis;
+  for (int i = 1; i < totnode; i++) {
+    const BVHSahChild child = children[i];
+    const float centroid = sah_centroid(&child.bounds[0][0], main_axis);
+    int j = i;
+    while (j > 0 && centroid < sah_centroid(&children[j - 1].bounds[0][0], main_axis)) {
+      children[j] = children[j - 1];
+      j--;
+    }
+    children[j] = child;
+  }
+
+  int branch_next = branch_index + 1;
+  for (int k = 0; k < totnode; k++) {
+    const int child_leafs_begin = children[k].leafs_begin;
+    const int child_leafs_end = children[k].leafs_end;
+    const int child_leafs_len = child_leafs_end - child_leafs_begin;
+
+    if (child_leafs_len > 1) {
+      node->children[k] = &data->branches_array[branch_next];
+
+      if (data->task_pool && (child_leafs_len > KDOPBVH_THREAD_LEAF_THRESHOLD)) {
+        BVHSahBuildTask *task = MEM_mallocN(sizeof(*task), __func__);
+        *task = (BVHSahBuildTask){
+            .branch_index = branch_next,
+            .leafs_begin = child_leafs_begin,
+            .leafs_end = child_leafs_end,
+            .depth = depth + 1,
+        };
+        BLI_task_pool_push_from_thread(
+            data->task_pool, sah_bvh_build_task_cb, task, true, TASK_PRIORITY_HIGH, thread_id);
+      }
+      else {
+        sah_bvh_build_recursive(
+            data, branch_next, child_leafs_begin, child_leafs_end, depth + 1, thread_id);
+      }
+      branch_next += child_leafs_len - 1;
+    }
+    else {
+      node->children[k] = leafs_array[child_leafs_begin];
+    }
+    node->children[k]->parent = node;
+  }
+  node->totnode = (char)totnode;
+}
+
+static void sah_bvh_build_task_cb(TaskPool *__restrict pool, void *taskdata, int thread_id)
+{
+  const BVHSahBuildData *data = BLI_task_pool_userdata(pool);
+  const BVHSahBuildTask *task = taskdata;
+  sah_bvh_build_recursive(
+      data, task->branch_index, task->leafs_begin, task->leafs_end, task->depth, thread_id);
+}
+
+static void sah_bvh_link_branches(BVHTree *tree, BVHNode *node)
+{
+  tree->nodes[tree->totleaf + tree->totbranch] = node;
+  tree->totbranch++;
+  for (int k = 0; k < node->totnode; k++) {
+    if (node->children[k]->totnode) {
+      sah_bvh_link_branches(tree, node->children[k]);
+    }
+  }
+}
+
+/**
+ * Builds the tree top-down from the given leafs, with the root at the start of branches_array.
+ * Unlike #non_recursive_bvh_div_nodes this also links the branches to #BVHTree.nodes.
+ */
+static void sah_bvh_div_nodes(BVHTree *tree,
+                              BVHNode *branches_array,
+                              BVHNode **leafs_array,
+                              int num_leafs)
+{
+  BVHNode *root = &branches_array[0];
+  root->parent = NULL;
+
+  if (num_leafs < 2) {
+    refit_kdop_hull(tree, root, 0, num_leafs);
+    root->main_axis = get_largest_axis(root->bv) / 2;
+    root->totnode = (char)num_leafs;
+    if (num_leafs == 1) {
+      root->children[0] = leafs_array[0];
+      root->children[0]->parent = root;
+    }
+  }
+  else {
+    BVHSahBuildData data = {
+        .tree = tree,
+        .branches_array = branches_array,
+        .leafs_array = leafs_array,
+        .task_pool = NULL,
+    };
+
+    if (num_leafs > KDOPBVH_THREAD_LEAF_THRESHOLD) {
+      BVHSahBuildTask *task = MEM_mallocN(sizeof(*task), __func__);
+      *task = (BVHSahBuildTask){
+          .branch_index = 0,
+          .leafs_begin = 0,
+          .leafs_end = num_leafs,
+          .depth = 0,
+      };
+      data.task_pool = BLI_task_pool_create(BLI_task_scheduler_get(), &data);
+      BLI_task_pool_push(data.task_pool, sah_bvh_build_task_cb, task, true, TASK_PRIORITY_HIGH);
+      BLI_task_pool_work_and_wait(data.task_pool);
+      BLI_task_pool_free(data.task_pool);
+    }
+    else {
+      sah_bvh_build_recursive(&data, 0, 0, num_leafs, 0, 0);
+    }
+  }
+
+  tree->totbranch = 0;
+  sah_bvh_link_branches(tree, root);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name BLI_bvhtree API
  * \{ */
 
 /**
+ * \param flag: #BVH_BUILD_SAH to use the binned SAH build on #BLI_bvhtree_balance.
  * \note many callers don't check for ``NULL`` return.
  */
-BVHTree *BLI_bvhtree_new(int maxsize, float epsilon, char tree_type, char axis)
+BVHTree *BLI_bvhtree_new_ex(int maxsize, float epsilon, char tree_type, char axis, int flag)
 {
   BVHTree *tree;
   int numnodes, i;
@@ -884,6 +1264,7 @@ BVHTree *BLI_bvhtree_new(int maxsize, float epsilon, char tree_type, char axis)
     tree->epsilon = epsilon;
     tree->tree_type = tree_type;
     tree->axis = axis;
+    tree->build_flag = (char)flag;
 
     if (axis == 26) {
       tree->start_axis = 0;
@@ -912,8 +1293,14 @@ BVHTree *BLI_bvhtree_new(int maxsize, float epsilon, char tree_type, char axis)
       goto fail;
     }
 
-    /* Allocate arrays */
-    numnodes = maxsize + implicit_needed_branches(tree_type, maxsize) + tree_type;
+    /* Allocate arrays, top-down builds may use one branch less than the number of leafs. */
+    numnodes = maxsize + tree_type;
+    if (flag & BVH_BUILD_SAH) {
+      numnodes += max_ii(1, maxsize - 1);
+    }
+    else {
+      numnodes += implicit_needed_branches(tree_type, maxsize);
+    }
 
     tree->nodes = MEM_callocN(sizeof(BVHNode *) * (size_t)numnodes, "BVHNodes");
     tree->nodebv = MEM_callocN(sizeof(float) * (size_t)(axis * numnodes), "BVHNodeBV");
@@ -937,6 +1324,14 @@ fail:
   return NULL;
 }
 
+/**
+ * \note many callers don't check for ``NULL`` return.
+ */
+BVHTree *BLI_bvhtree_new(int maxsize, float epsilon, char tree_type, char axis)
+{
+  return BLI_bvhtree_new_ex(maxsize, epsilon, tree_type, axis, 0);
+}
+
 void BLI_bvhtree_free(BVHTree *tree)
 {
   if (tree) {
@@ -956,15 +1351,21 @@ void BLI_bvhtree_balance(BVHTree *tree)
    * (some big bug goes here if its being called more than once per tree) */
   BLI_assert(tree->totbranch == 0);
 
-  /* Build the implicit tree */
-  non_recursive_bvh_div_nodes(
-      tree, tree->nodearray + (tree->totleaf - 1), leafs_array, tree->totleaf);
+  if (tree->build_flag & BVH_BUILD_SAH) {
+    /* Build the tree top-down, this links the branches to the nodes array too. */
+    sah_bvh_div_nodes(tree, tree->nodearray + tree->totleaf, leafs_array, tree->totleaf);
+  }
+  else {
+    /* Build the implicit tree */
+    non_recursive_bvh_div_nodes(
+        tree, tree->nodearray + (tree->totleaf - 1), leafs_array, tree->totleaf);
 
-  /* current code expects the branches to be linked to the nodes array
-   * we perform that linkage here */
-  tree->totbranch = implicit_needed_branches(tree->tree_type, tree->totleaf);
-  for (int i = 0; i < tree->totbranch; i++) {
-    tree->nodes[tree->totleaf + i] = &tree->nodearray[tree->totleaf + i];
+    /* current code expects the branches to be linked to the nodes array
+     * we perform that linkage here */
+    tree->totbranch = implicit_needed_branches(tree->tree_type, tree->totleaf);
+    for (int i = 0; i < tree->totbranch; i++) {
+      tree->nodes[tree->totleaf + i] = &tree->nodearray[tree->totleaf + i];
+    }
   }
 
 #ifdef USE_SKIP_LINKS
@@ -1045,6 +1446,83 @@ void BLI_bvhtree_update_tree(BVHTree *tree)
     node_join(tree, *index);
   }
 }
+
+typedef struct BVHUpdateLeafsData {
+  BVHTree *tree;
+  BVHTree_UpdateLeafCallback callback;
+  void *userdata;
+} BVHUpdateLeafsData;
+
+static void bvhtree_update_leafs_task_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHUpdateLeafsData *data = userdata;
+  BVHTree *tree = data->tree;
+  BVHNode *node = &tree->nodearray[i];
+  float co[4][3];
+
+  const int numpoints = data->callback(data->userdata, node->index, co);
+  BLI_assert(numpoints > 0 && numpoints <= 4);
+
+  create_kdop_hull(tree, node, co[0], numpoints, 0);
+
+  /* inflate the bv with some epsilon */
+  for (axis_t axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    node->bv[(2 * axis_iter)] -= tree->epsilon;     /* minimum */
+    node->bv[(2 * axis_iter) + 1] += tree->epsilon; /* maximum */
+  }
+}
+
+/**
+ * Refit the whole tree to new positions of its elements, the leafs are updated in parallel
+ * with points from \a callback, which must be thread-safe.
+ * Replaces calling #BLI_bvhtree_update_node for every leaf and #BLI_bvhtree_update_tree.
+ */
+void BLI_bvhtree_update_leafs(BVHTree *tree, BVHTree_UpdateLeafCallback callback, void *userdata)
+{
+  BVHUpdateLeafsData data = {
+      .tree = tree,
+      .callback = callback,
+      .userdata = userdata,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (tree->totleaf > KDOPBVH_THREAD_LEAF_THRESHOLD);
+  BLI_task_parallel_range(0, tree->totleaf, &data, bvhtree_update_leafs_task_cb, &settings);
+
+  BLI_bvhtree_update_tree(tree);
+}
+
+/**
+ * Sum of the surface area of all branches, relative to the area of the root.
+ * This estimates the cost of queries: refitting a tree to deformed positions makes it grow,
+ * when the tree gets too slow to query it's better to build it again.
+ *
+ * \note Only the first three axes of the tree are used,
+ * these are the x, y and z axes for trees with 6, 14 and 26 axes.
+ */
+float BLI_bvhtree_get_area_ratio(const BVHTree *tree)
+{
+  if (tree->totbranch == 0) {
+    return 1.0f;
+  }
+
+  float area_sum = 0.0f;
+  float area_root = 0.0f;
+  for (int i = 0; i < tree->totbranch; i++) {
+    const float *bv = &tree->nodes[tree->totleaf + i]->bv[2 * tree->start_axis];
+    const float size[3] = {bv[1] - bv[0], bv[3] - bv[2], bv[5] - bv[4]};
+    const float area = size[0] * size[1] + size[1] * size[2] + size[2] * size[0];
+    if (i == 0) {
+      area_root = area;
+    }
+    area_sum += area;
+  }
+
+  return (area_root > 0.0f) ? area_sum / area_root : 1.0f;
+}
 /**
  * Number of times #BLI_bvhtree_insert has been called.
  * mainly useful for asserts functions to check we added the correct number.
@@ -1973,6 +2451,235 @@ void BLI_bvhtree_ray_cast_all(BVHTree *tree,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name BLI_bvhtree_find_nearest_batch / BLI_bvhtree_ray_cast_batch
+ *
+ * Queries are processed in the Morton order of their coordinates, so consecutive queries
+ * traverse mostly the same nodes, which are then still in the cache.
+ * Contiguous ranges of the sorted queries are processed in parallel.
+ *
+ * \{ */
+
+typedef struct BVHBatchKey {
+  uint code;
+  int index;
+} BVHBatchKey;
+
+/* Spread the lower 10 bits of x, leaving two zero bits between each of them. */
+static uint morton_spread_bits(uint x)
+{
+  x &= 0x3ff;
+  x = (x | (x << 16)) & 0x030000ff;
+  x = (x | (x << 8)) & 0x0300f00f;
+  x = (x | (x << 4)) & 0x030c30c3;
+  x = (x | (x << 2)) & 0x09249249;
+  return x;
+}
+
+static int bvh_batch_key_cmp(const void *a_v, const void *b_v)
+{
+  const BVHBatchKey *a = a_v;
+  const BVHBatchKey *b = b_v;
+  if (a->code != b->code) {
+    return (a->code < b->code) ? -1 : 1;
+  }
+  return (a->index < b->index) ? -1 : (a->index > b->index);
+}
+
+/**
+ * \return the order to process the queries in, or NULL when they aren't worth sorting.
+ */
+static int *bvh_batch_order(const float (*co)[3], int co_len)
+{
+  if (co_len <= KDOPBVH_THREAD_LEAF_THRESHOLD) {
+    return NULL;
+  }
+
+  float min[3], max[3], scale[3];
+  INIT_MINMAX(min, max);
+  for (int i = 0; i < co_len; i++) {
+    minmax_v3v3_v3(min, max, co[i]);
+  }
+  for (int axis = 0; axis < 3; axis++) {
+    const float size = max[axis] - min[axis];
+    scale[axis] = (size > FLT_EPSILON) ? 1023.0f / size : 0.0f;
+  }
+
+  BVHBatchKey *keys = MEM_mallocN(sizeof(*keys) * (size_t)co_len, __func__);
+  for (int i = 0; i < co_len; i++) {
+    uint code = 0;
+    for (int axis = 0; axis < 3; axis++) {
+      const uint cell = (uint)((co[i][axis] - min[axis]) * scale[axis]);
+      code |= morton_spread_bits(cell) << axis;
+    }
+    keys[i].code = code;
+    keys[i].index = i;
+  }
+  qsort(keys, (size_t)co_len, sizeof(*keys), bvh_batch_key_cmp);
+
+  int *order = MEM_mallocN(sizeof(*order) * (size_t)co_len, __func__);
+  for (int i = 0; i < co_len; i++) {
+    order[i] = keys[i].index;
+  }
+  MEM_freeN(keys);
+
+  return order;
+}
+
+typedef struct BVHNearestBatchData {
+  BVHTree *tree;
+  const float (*co)[3];
+  BVHTreeNearest *nearest;
+  const int *order;
+  BVHTree_NearestPointCallback callback;
+  void *userdata;
+  int flag;
+} BVHNearestBatchData;
+
+static void bvhtree_find_nearest_batch_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict tls)
+{
+  const BVHNearestBatchData *data = userdata;
+  BVHTreeNearest *nearest_prev = tls->userdata_chunk;
+  const int index = data->order ? data->order[i] : i;
+  const float *co = data->co[index];
+  BVHTreeNearest *nearest = &data->nearest[index];
+
+  /* The nearest point of the previous query is usually close, and gives an upper bound to the
+   * distance which prunes most of the tree. */
+  if ((data->flag & BVH_NEAREST_REUSE_PREVIOUS) && (nearest_prev->index != -1)) {
+    const float dist_sq = len_squared_v3v3(co, nearest_prev->co);
+    if (dist_sq < nearest->dist_sq) {
+      *nearest = *nearest_prev;
+      nearest->dist_sq = dist_sq;
+    }
+  }
+
+  BLI_bvhtree_find_nearest_ex(data->tree,
+                              co,
+                              nearest,
+                              data->callback,
+                              data->userdata,
+                              data->flag & BVH_NEAREST_OPTIMAL_ORDER);
+
+  if (nearest->index != -1) {
+    *nearest_prev = *nearest;
+  }
+}
+
+/**
+ * Find the nearest node for each of the coordinates, like #BLI_bvhtree_find_nearest_ex.
+ *
+ * \param nearest: Array of \a co_len results, these must be initialized like for a single query,
+ * the index to -1 and the distance to the maximum distance to search.
+ * \param callback: Called from multiple threads, it must be thread-safe.
+ */
+void BLI_bvhtree_find_nearest_batch(BVHTree *tree,
+                                    const float (*co)[3],
+                                    BVHTreeNearest *nearest,
+                                    int co_len,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata,
+                                    int flag)
+{
+  int *order = bvh_batch_order(co, co_len);
+
+  BVHNearestBatchData data = {
+      .tree = tree,
+      .co = co,
+      .nearest = nearest,
+      .order = order,
+      .callback = callback,
+      .userdata = userdata,
+      .flag = flag,
+  };
+  BVHTreeNearest nearest_prev = {.index = -1};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (co_len > KDOPBVH_THREAD_LEAF_THRESHOLD);
+  settings.userdata_chunk = &nearest_prev;
+  settings.userdata_chunk_size = sizeof(nearest_prev);
+  BLI_task_parallel_range(0, co_len, &data, bvhtree_find_nearest_batch_cb, &settings);
+
+  if (order) {
+    MEM_freeN(order);
+  }
+}
+
+typedef struct BVHRayCastBatchData {
+  BVHTree *tree;
+  const float (*co)[3];
+  const float (*dir)[3];
+  float radius;
+  BVHTreeRayHit *hit;
+  const int *order;
+  BVHTree_RayCastCallback callback;
+  void *userdata;
+  int flag;
+} BVHRayCastBatchData;
+
+static void bvhtree_ray_cast_batch_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHRayCastBatchData *data = userdata;
+  const int index = data->order ? data->order[i] : i;
+
+  BLI_bvhtree_ray_cast_ex(data->tree,
+                          data->co[index],
+                          data->dir[index],
+                          data->radius,
+                          &data->hit[index],
+                          data->callback,
+                          data->userdata,
+                          data->flag);
+}
+
+/**
+ * Cast a ray from each of the coordinates, like #BLI_bvhtree_ray_cast_ex.
+ *
+ * \param hit: Array of \a ray_len results, these must be initialized like for a single query,
+ * the index to -1 and the distance to the maximum distance to search.
+ * \param callback: Called from multiple threads, it must be thread-safe.
+ */
+void BLI_bvhtree_ray_cast_batch(BVHTree *tree,
+                                const float (*co)[3],
+                                const float (*dir)[3],
+                                float radius,
+                                BVHTreeRayHit *hit,
+                                int ray_len,
+                                BVHTree_RayCastCallback callback,
+                                void *userdata,
+                                int flag)
+{
+  int *order = bvh_batch_order(co, ray_len);
+
+  BVHRayCastBatchData data = {
+      .tree = tree,
+      .co = co,
+      .dir = dir,
+      .radius = radius,
+      .hit = hit,
+      .order = order,
+      .callback = callback,
+      .userdata = userdata,
+      .flag = flag,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (ray_len > KDOPBVH_THREAD_LEAF_THRESHOLD);
+  BLI_task_parallel_range(0, ray_len, &data, bvhtree_ray_cast_batch_cb, &settings);
+
+  if (order) {
+    MEM_freeN(order);
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name BLI_bvhtree_range_query
  *
@@ -22,6 +22,7 @@
 
 #include "BLI_math.h"
 #include "BLI_kdtree_impl.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "BLI_strict_flags.h"
 
@@ -56,6 +57,11 @@ struct KDTree {
 #define KD_NEAR_ALLOC_INC 100 /* alloc increment for collecting nearest */
 #define KD_FOUND_ALLOC_INC 50 /* alloc increment for collecting nearest */
 
+/* Balance ranges with more nodes than this in a separate task. */
+#define KD_THREAD_NODES_THRESHOLD 10000
+/* Run batch queries in parallel when there are more points than this. */
+#define KD_THREAD_QUERIES_THRESHOLD 1000
+
 #define KD_NODE_UNSET ((uint)-1)
 
 /** When set we know all values are unbalanced,
@@ -143,7 +149,59 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+typedef struct KDTreeBalanceTask {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+} KDTreeBalanceTask;
+
+static uint kdtree_balance(KDTreeNode *nodes,
+                           uint nodes_len,
+                           uint axis,
+                           const uint ofs,
+                           TaskPool *task_pool,
+                           const int thread_id);
+
+static void kdtree_balance_task_cb(TaskPool *__restrict pool, void *taskdata, int thread_id)
+{
+  const KDTreeBalanceTask *task = taskdata;
+  kdtree_balance(task->nodes, task->nodes_len, task->axis, task->ofs, pool, thread_id);
+}
+
+/**
+ * Balance a sub-range of the nodes, in a new task when \a task_pool is set and the range is large.
+ * Ranges never overlap, so tasks don't need any locking.
+ */
+static uint kdtree_balance_subtree(KDTreeNode *nodes,
+                                   uint nodes_len,
+                                   uint axis,
+                                   const uint ofs,
+                                   TaskPool *task_pool,
+                                   const int thread_id)
+{
+  if (task_pool && (nodes_len > KD_THREAD_NODES_THRESHOLD)) {
+    KDTreeBalanceTask *task = MEM_mallocN(sizeof(*task), __func__);
+    *task = (KDTreeBalanceTask){
+        .nodes = nodes,
+        .nodes_len = nodes_len,
+        .axis = axis,
+        .ofs = ofs,
+    };
+    BLI_task_pool_push_from_thread(
+        task_pool, kdtree_balance_task_cb, task, true, TASK_PRIORITY_HIGH, thread_id);
+    /* The root of a balanced range is always its median, no need to wait for the task. */
+    return (nodes_len / 2) + ofs;
+  }
+  return kdtree_balance(nodes, nodes_len, axis, ofs, task_pool, thread_id);
+}
+
+static uint kdtree_balance(KDTreeNode *nodes,
+                           uint nodes_len,
+                           uint axis,
+                           const uint ofs,
+                           TaskPool *task_pool,
+                           const int thread_id)
 {
   KDTreeNode *node;
   float co;
@@ -192,9 +250,13 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   node = &nodes[median];
   node->d = axis;
   axis = (axis + 1) % KD_DIMS;
-  node->left = kdtree_balance(nodes, median, axis, ofs);
-  node->right = kdtree_balance(
-      nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
+  node->left = kdtree_balance_subtree(nodes, median, axis, ofs, task_pool, thread_id);
+  node->right = kdtree_balance_subtree(nodes + median + 1,
+                                       (nodes_len - (median + 1)),
+                                       axis,
+                                       (median + 1) + ofs,
+                                       task_pool,
+                                       thread_id);
 
   return median + ofs;
 }
@@ -208,7 +270,16 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len > KD_THREAD_NODES_THRESHOLD) {
+    /* Both halves of every split are independent, balance large ones in parallel. */
+    TaskPool *task_pool = BLI_task_pool_create(BLI_task_scheduler_get(), NULL);
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0, task_pool, 0);
+    BLI_task_pool_work_and_wait(task_pool);
+    BLI_task_pool_free(task_pool);
+  }
+  else {
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0, NULL, 0);
+  }
 
 #ifdef DEBUG
   tree->is_balanced = true;
@@ -804,6 +875,99 @@ finally:
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name BLI_kdtree_3d_find_nearest_n_batch / BLI_kdtree_3d_range_search_batch
+ * \{ */
+
+typedef struct KDTreeBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  KDTreeNearest *nearest;
+  KDTreeNearest **nearest_range;
+  uint nearest_len_capacity;
+  float range;
+  int *nearest_len;
+} KDTreeBatchData;
+
+static void kdtree_find_nearest_n_batch_cb(void *__restrict userdata,
+                                           const int i,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeBatchData *data = userdata;
+  data->nearest_len[i] = BLI_kdtree_nd_(find_nearest_n)(
+      data->tree,
+      data->co[i],
+      &data->nearest[(size_t)i * data->nearest_len_capacity],
+      data->nearest_len_capacity);
+}
+
+static void kdtree_range_search_batch_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeBatchData *data = userdata;
+  data->nearest_len[i] = BLI_kdtree_nd_(range_search)(
+      data->tree, data->co[i], &data->nearest_range[i], data->range);
+}
+
+/**
+ * Run #BLI_kdtree_3d_find_nearest_n for every point in \a co, in parallel for large arrays.
+ *
+ * \param r_nearest: An array sized at least `co_len * nearest_len_capacity`,
+ * the results of point `i` start at `i * nearest_len_capacity`.
+ * \param r_nearest_len: The number of points found for each point in \a co.
+ */
+void BLI_kdtree_nd_(find_nearest_n_batch)(const KDTree *tree,
+                                          const float (*co)[KD_DIMS],
+                                          const uint co_len,
+                                          KDTreeNearest *r_nearest,
+                                          const uint nearest_len_capacity,
+                                          int *r_nearest_len)
+{
+  KDTreeBatchData data = {
+      .tree = tree,
+      .co = co,
+      .nearest = r_nearest,
+      .nearest_len_capacity = nearest_len_capacity,
+      .nearest_len = r_nearest_len,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (co_len > KD_THREAD_QUERIES_THRESHOLD);
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_find_nearest_n_batch_cb, &settings);
+}
+
+/**
+ * Run #BLI_kdtree_3d_range_search for every point in \a co, in parallel for large arrays.
+ *
+ * \param r_nearest: An array of \a co_len pointers, set to the results of each point
+ * (caller is responsible for freeing every non NULL item).
+ * \param r_nearest_len: The number of points found for each point in \a co.
+ */
+void BLI_kdtree_nd_(range_search_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const uint co_len,
+                                        const float range,
+                                        KDTreeNearest **r_nearest,
+                                        int *r_nearest_len)
+{
+  KDTreeBatchData data = {
+      .tree = tree,
+      .co = co,
+      .nearest_range = r_nearest,
+      .range = range,
+      .nearest_len = r_nearest_len,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (co_len > KD_THREAD_QUERIES_THRESHOLD);
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_range_search_batch_cb, &settings);
+}
+
+/** \} */
+
 /**
  * Use when we want to loop over nodes ordered by index.
  * Requires indices to be aligned with nodes.
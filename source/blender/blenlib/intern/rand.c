@@ -254,9 +254,23 @@ void BLI_rng_shuffle_array(RNG *rng, void *data, unsigned int elem_size_i, unsig
  */
 void BLI_rng_skip(RNG *rng, int n)
 {
-  while (n--) {
-    rng_step(rng);
+  /* Compose the linear congruential step with itself by squaring, so skipping takes log(n)
+   * steps instead of n. All arithmetic wraps modulo 2^64, which the mask reduces to 2^48. */
+  uint64_t mul = MULTIPLIER, add = ADDEND;
+  uint64_t mul_acc = 1, add_acc = 0;
+  unsigned int steps = (n > 0) ? (unsigned int)n : 0;
+
+  while (steps) {
+    if (steps & 1) {
+      mul_acc *= mul;
+      add_acc = add_acc * mul + add;
+    }
+    add *= mul + 1;
+    mul *= mul;
+    steps >>= 1;
   }
+
+  rng->X = (mul_acc * rng->X + add_acc) & MASK;
 }
 
 /***/
@@ -3270,6 +3270,7 @@ static void direct_link_animdata(FileData *fd, AnimData *adt)
   link_list(fd, &adt->drivers);
   direct_link_fcurves(fd, &adt->drivers);
   adt->driver_array = NULL;
+  adt->path_cache = NULL;
 
   /* link overrides */
   // TODO...
@@ -4041,6 +4042,7 @@ static void direct_link_key(FileData *fd, Key *key)
 
   for (kb = key->block.first; kb; kb = kb->next) {
     kb->data = newdataadr(fd, kb->data);
+    kb->sparse = NULL;
 
     if (fd->flags & FD_FLAGS_SWITCH_ENDIAN) {
       switch_endian_keyblock(key, kb);
@@ -5759,6 +5761,7 @@ static void direct_link_modifiers(FileData *fd, ListBase *lb)
       /* runtime only */
       csmd->delta_cache.deltas = NULL;
       csmd->delta_cache.totverts = 0;
+      csmd->delta_cache.adjacency = NULL;
     }
     else if (md->type == eModifierType_MeshSequenceCache) {
       MeshSeqCacheModifierData *msmcd = (MeshSeqCacheModifierData *)md;
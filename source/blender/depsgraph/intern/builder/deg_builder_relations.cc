@@ -176,7 +176,14 @@ bool driver_variables_depends_on_time(const ListBase *variables)
 bool driver_depends_on_time(ChannelDriver *driver)
 {
   if (driver->type == DRIVER_TYPE_PYTHON) {
-    if (python_driver_exression_depends_on_time(driver->expression)) {
+    /* Expressions handled without Python know exactly which variables they use,
+     * so function calls do not need to be treated as time dependent. */
+    if (BKE_driver_has_simple_expression(driver)) {
+      if (BKE_driver_simple_expression_uses_frame(driver)) {
+        return true;
+      }
+    }
+    else if (python_driver_exression_depends_on_time(driver->expression)) {
       return true;
     }
   }
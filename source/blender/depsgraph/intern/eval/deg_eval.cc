@@ -32,6 +32,7 @@
 #include "BLI_task.h"
 #include "BLI_ghash.h"
 
+#include "BKE_fcurve.h"
 #include "BKE_global.h"
 
 #include "DNA_object_types.h"
@@ -257,6 +258,9 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   }
   const bool do_time_debug = ((G.debug & G_DEBUG_DEPSGRAPH_TIME) != 0);
   const double start_time = do_time_debug ? PIL_check_seconds_timer() : 0;
+  if (do_time_debug) {
+    BKE_driver_stats_reset();
+  }
   graph->is_evaluating = true;
   depsgraph_ensure_view_layer(graph);
   /* Set up evaluation state. */
@@ -301,6 +305,13 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   graph->is_evaluating = false;
   if (do_time_debug) {
     printf("Depsgraph updated in %f seconds.\n", PIL_check_seconds_timer() - start_time);
+    unsigned int num_drivers, num_python_drivers;
+    BKE_driver_stats_get(&num_drivers, &num_python_drivers);
+    if (num_drivers != 0) {
+      printf("Expression drivers evaluated: %u, using Python: %u.\n",
+             num_drivers,
+             num_python_drivers);
+    }
   }
 }
 
@@ -824,6 +824,7 @@ void update_id_after_copy(const Depsgraph *depsgraph,
   }
   update_edit_mode_pointers(depsgraph, id_orig, id_cow);
   BKE_animsys_update_driver_array(id_cow);
+  BKE_animsys_update_path_cache(id_cow);
 }
 
 /* This callback is used to validate that all nested ID data-blocks are
@@ -486,11 +486,11 @@ static void prepare(Render *re, ViewLayer *view_layer, Depsgraph *depsgraph)
   bool diffuse = false, z = false;
   for (RenderPass *rpass = (RenderPass *)rl->passes.first; rpass; rpass = rpass->next) {
     if (STREQ(rpass->name, RE_PASSNAME_DIFFUSE_COLOR)) {
-      controller->setPassDiffuse(rpass->rect, rpass->rectx, rpass->recty);
+      controller->setPassDiffuse(RE_pass_rect_ensure(rl, rpass), rpass->rectx, rpass->recty);
       diffuse = true;
     }
     if (STREQ(rpass->name, RE_PASSNAME_Z)) {
-      controller->setPassZ(rpass->rect, rpass->rectx, rpass->recty);
+      controller->setPassZ(RE_pass_rect_ensure(rl, rpass), rpass->rectx, rpass->recty);
       z = true;
     }
   }
@@ -1269,7 +1269,8 @@ void IMB_exr_read_channels(void *handle)
                            Slice(Imf::FLOAT, (char *)rect, xstride, ystride));
       }
       else {
-        printf("warning, channel with no rect set %s\n", echan->m->internal_name.c_str());
+        /* Not an error, render results only read back the passes they need. */
+        exr_printf("skipping channel with no rect set %s\n", echan->m->internal_name.c_str());
       }
     }
 
@@ -33,6 +33,8 @@ extern "C" {
 #include "DNA_action_types.h"
 #include "DNA_curve_types.h"
 
+struct AnimPathCache;
+
 /* ************************************************ */
 /* F-Curve DataTypes */
 
@@ -1079,6 +1081,8 @@ typedef struct AnimData {
 
   /** Runtime data, for depsgraph evaluation. */
   FCurve **driver_array;
+  /** Runtime data, resolved F-Curve paths of evaluated data, see anim_sys.c. */
+  struct AnimPathCache *path_cache;
 
   /* settings for animation evaluation */
   /** User-defined settings. */
@@ -79,6 +79,9 @@ typedef struct BevList {
   int nr, dupe_nr;
   int poly, hole;
   int charidx;
+  /** Copy of the spline this list was made from, to reuse it in the next evaluation. */
+  void *source;
+  size_t source_len;
   int *segbevcount;
   float *seglen;
   BevPoint *bevpoints;
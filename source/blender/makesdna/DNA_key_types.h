@@ -33,6 +33,7 @@
 
 struct AnimData;
 struct Ipo;
+struct KeyBlockSparse;
 
 typedef struct KeyBlock {
   struct KeyBlock *next, *prev;
@@ -61,6 +62,8 @@ typedef struct KeyBlock {
 
   /** array of shape key values, size is (Key->elemsize * KeyBlock->totelem) */
   void *data;
+  /** Runtime: elements offset from the relative key, only cached on evaluated copies. */
+  struct KeyBlockSparse *sparse;
   /** MAX_NAME (unique name, user assigned) */
   char name[64];
   /** MAX_VGROUP_NAME (optional vertex group), array gets allocated into 'weights' when set */
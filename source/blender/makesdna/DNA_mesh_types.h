@@ -97,6 +97,8 @@ typedef struct Mesh_Runtime {
 
   /** 'BVHCache', for 'BKE_bvhutil.c' */
   struct LinkNode *bvh_cache;
+  /** 'BVHCache' of the previous evaluated mesh, refit on request (see 'BKE_bvhutil.c'). */
+  struct LinkNode *bvh_cache_refit;
 
   /** Non-manifold boundary data for Shrinkwrap Target Project. */
   struct ShrinkwrapBoundaryData *shrinkwrap_data;
@@ -1633,6 +1633,9 @@ typedef struct CorrectiveSmoothDeltaCache {
   short repeat, flag;
   char smooth_type, rest_source;
   char _pad[2];
+
+  /* Vertex adjacency of the mesh, only depends on its topology. */
+  void *adjacency;
 } CorrectiveSmoothDeltaCache;
 
 typedef struct CorrectiveSmoothModifierData {
@@ -493,6 +493,10 @@ void RNA_def_property_duplicate_pointers(StructOrFunctionRNA *cont_, PropertyRNA
 void RNA_def_property_free_pointers(PropertyRNA *prop);
 int RNA_def_property_free_identifier(StructOrFunctionRNA *cont_, const char *identifier);
 
+/* Incremented whenever runtime defined structs or properties are freed, so
+ * cached StructRNA and PropertyRNA pointers can be checked for validity. */
+unsigned int RNA_def_free_generation(void);
+
 /* utilities */
 const char *RNA_property_typename(PropertyType type);
 #define IS_DNATYPE_FLOAT_COMPAT(_str) (strcmp(_str, "float") == 0 || strcmp(_str, "double") == 0)
@@ -189,6 +189,14 @@ static void rna_brna_structs_add(BlenderRNA *brna, StructRNA *srna)
 }
 
 #ifdef RNA_RUNTIME
+/* Incremented when runtime defined structs or properties are freed. */
+static unsigned int rna_def_free_generation = 0;
+
+unsigned int RNA_def_free_generation(void)
+{
+  return rna_def_free_generation;
+}
+
 static void rna_brna_structs_remove_and_free(BlenderRNA *brna, StructRNA *srna)
 {
   if ((srna->flag & STRUCT_PUBLIC_NAMESPACE) && brna->structs_map) {
@@ -782,6 +790,8 @@ void RNA_struct_free(BlenderRNA *brna, StructRNA *srna)
   PropertyRNA *prop, *nextprop;
   PropertyRNA *parm, *nextparm;
 
+  rna_def_free_generation++;
+
 #  if 0
   if (srna->flag & STRUCT_RUNTIME) {
     if (RNA_struct_py_type_get(srna)) {
@@ -4580,6 +4590,8 @@ static void rna_def_property_free(StructOrFunctionRNA *cont_, PropertyRNA *prop)
 {
   ContainerRNA *cont = cont_;
 
+  rna_def_free_generation++;
+
   if (prop->flag_internal & PROP_INTERN_RUNTIME) {
     if (cont->prophash) {
       BLI_ghash_remove(cont->prophash, prop->identifier, NULL, NULL);
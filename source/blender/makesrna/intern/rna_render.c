@@ -444,16 +444,34 @@ static int rna_RenderPass_rect_get_length(PointerRNA *ptr, int length[RNA_MAX_AR
   return length[0] * length[1];
 }
 
+/* Streamed passes are read back from disk the first time they are accessed. */
+static float *rna_RenderPass_rect_ensure(RenderPass *rpass)
+{
+  return (rpass->stream_layer) ? RE_pass_rect_ensure(rpass->stream_layer, rpass) : rpass->rect;
+}
+
 static void rna_RenderPass_rect_get(PointerRNA *ptr, float *values)
 {
   RenderPass *rpass = (RenderPass *)ptr->data;
-  memcpy(values, rpass->rect, sizeof(float) * rpass->rectx * rpass->recty * rpass->channels);
+  const size_t size = sizeof(float) * rpass->rectx * rpass->recty * rpass->channels;
+  const float *rect = rna_RenderPass_rect_ensure(rpass);
+
+  if (rect) {
+    memcpy(values, rect, size);
+  }
+  else {
+    memset(values, 0, size);
+  }
 }
 
 void rna_RenderPass_rect_set(PointerRNA *ptr, const float *values)
 {
   RenderPass *rpass = (RenderPass *)ptr->data;
-  memcpy(rpass->rect, values, sizeof(float) * rpass->rectx * rpass->recty * rpass->channels);
+  float *rect = rna_RenderPass_rect_ensure(rpass);
+
+  if (rect) {
+    memcpy(rect, values, sizeof(float) * rpass->rectx * rpass->recty * rpass->channels);
+  }
 }
 
 static PointerRNA rna_BakePixel_next_get(PointerRNA *ptr)
@@ -5843,6 +5843,16 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
       "(saves memory, required for Full Sample)");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
 
+  prop = RNA_def_property(srna, "use_save_buffers_stream", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "scemode", R_EXR_TILE_STREAM);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Stream Buffers",
+                           "Keep saved buffers on disk after rendering, only the Combined pass "
+                           "stays in memory and other passes are read back when they are used "
+                           "(saves memory for large images with many passes)");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
+
   prop = RNA_def_property(srna, "use_full_sample", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "scemode", R_FULL_SAMPLE);
   RNA_def_property_ui_text(prop,
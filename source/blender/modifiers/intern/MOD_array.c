@@ -27,7 +27,9 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_hash.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_curve_types.h"
 #include "DNA_mesh_types.h"
@@ -113,7 +115,6 @@ BLI_INLINE float sum_v3(const float v[3])
 /* Structure used for sorting vertices, when processing doubles */
 typedef struct SortVertsElem {
   int vertex_num; /* The original index of the vertex, prior to sorting */
-  float co[3];    /* Its coordinates */
   float sum_co;   /* sum_v3(co), just so we don't do the sum many times.  */
 } SortVertsElem;
 
@@ -129,21 +130,231 @@ static int svert_sum_cmp(const void *e1, const void *e2)
     return -1;
   }
   else {
-    return 0;
+    return (sv1->vertex_num > sv2->vertex_num) - (sv1->vertex_num < sv2->vertex_num);
   }
 }
 
-static void svert_from_mvert(SortVertsElem *sv,
-                             const MVert *mv,
-                             const int i_begin,
-                             const int i_end)
+/* Merge candidates are looked up in a grid of cells slightly larger than the merge distance,
+ * so that all doubles of a vertex are found within its own and the 26 neighboring cells. */
+#define MERGE_CELL_SIZE_MIN 1e-5f
+#define MERGE_CELL_MAX (1 << 29)
+
+typedef struct MergeVertsHash {
+  double cell_scale;
+  uint bucket_mask;
+  /* Vertices of each bucket, bucket_verts[bucket_offsets[b]] to
+   * bucket_verts[bucket_offsets[b + 1]]. */
+  int *bucket_offsets;
+  int *bucket_verts;
+} MergeVertsHash;
+
+static void merge_hash_cell(const MergeVertsHash *hash, const float co[3], int r_cell[3])
 {
-  int i;
-  for (i = i_begin; i < i_end; i++, sv++, mv++) {
-    sv->vertex_num = i;
-    copy_v3_v3(sv->co, mv->co);
-    sv->sum_co = sum_v3(mv->co);
+  for (int i = 0; i < 3; i++) {
+    const double f = floor((double)co[i] * hash->cell_scale);
+    /* Clamping keeps neighboring cells neighbors, and also handles NaN coordinates. */
+    r_cell[i] = (f > MERGE_CELL_MAX) ? MERGE_CELL_MAX :
+                                       ((f >= -MERGE_CELL_MAX) ? (int)f : -MERGE_CELL_MAX);
+  }
+}
+
+BLI_INLINE uint merge_hash_bucket(const MergeVertsHash *hash,
+                                  const int x,
+                                  const int y,
+                                  const int z)
+{
+  return BLI_hash_int_2d(BLI_hash_int_2d((uint)x, (uint)y), (uint)z) & hash->bucket_mask;
+}
+
+typedef struct MergeVertsHashBuildData {
+  const MergeVertsHash *hash;
+  const MVert *mverts;
+  uint *vert_buckets;
+} MergeVertsHashBuildData;
+
+static void merge_hash_bucket_task(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MergeVertsHashBuildData *data = userdata;
+  int cell[3];
+
+  merge_hash_cell(data->hash, data->mverts[i].co, cell);
+  data->vert_buckets[i] = merge_hash_bucket(data->hash, cell[0], cell[1], cell[2]);
+}
+
+static void merge_hash_build(MergeVertsHash *hash,
+                             const MVert *mverts,
+                             const int verts_start,
+                             const int verts_num,
+                             const float dist)
+{
+  const uint buckets_num = power_of_2_max_u((uint)max_ii(verts_num, 1)) * 2;
+  uint *vert_buckets = MEM_malloc_arrayN(verts_num, sizeof(*vert_buckets), __func__);
+  int *bucket_fill;
+
+  hash->cell_scale = 1.0 / ((double)max_ff(dist, MERGE_CELL_SIZE_MIN) * 1.001);
+  hash->bucket_mask = buckets_num - 1;
+  hash->bucket_offsets = MEM_calloc_arrayN(buckets_num + 1, sizeof(int), __func__);
+  hash->bucket_verts = MEM_malloc_arrayN(verts_num, sizeof(int), __func__);
+
+  MergeVertsHashBuildData data = {
+      .hash = hash,
+      .mverts = mverts + verts_start,
+      .vert_buckets = vert_buckets,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (verts_num > 1024);
+  BLI_task_parallel_range(0, verts_num, &data, merge_hash_bucket_task, &settings);
+
+  /* Counting sort of the vertices by bucket. */
+  for (int i = 0; i < verts_num; i++) {
+    hash->bucket_offsets[vert_buckets[i] + 1]++;
+  }
+  for (uint b = 0; b < buckets_num; b++) {
+    hash->bucket_offsets[b + 1] += hash->bucket_offsets[b];
+  }
+  bucket_fill = MEM_dupallocN(hash->bucket_offsets);
+  for (int i = 0; i < verts_num; i++) {
+    hash->bucket_verts[bucket_fill[vert_buckets[i]]++] = verts_start + i;
+  }
+
+  MEM_freeN(bucket_fill);
+  MEM_freeN(vert_buckets);
+}
+
+static void merge_hash_free(MergeVertsHash *hash)
+{
+  MEM_freeN(hash->bucket_offsets);
+  MEM_freeN(hash->bucket_verts);
+}
+
+typedef struct MapDoublesData {
+  const int *doubles_map;
+  const MVert *mverts;
+  const MergeVertsHash *hash;
+  int source_start;
+  int source_end;
+  float dist;
+  float dist3;
+
+  /* Mapping of each source vertex, written to doubles_map once all are known. */
+  int *source_map;
+  /* Source vertices whose mapping depends on the mapping of other source vertices,
+   * their source_map entry holds the merge candidate until they are resolved in order. */
+  bool *source_deferred;
+} MapDoublesData;
+
+/**
+ * Mapping of vertex \a v, as seen by \a v_source while scanning sources in order of
+ * ascending #sum_v3 of their coordinates: sources scanned earlier are already mapped.
+ */
+static int map_doubles_lookup(const MapDoublesData *data, const int v, const int v_source)
+{
+  if (v >= data->source_start && v < data->source_end && v != v_source) {
+    const float sum_co = sum_v3(data->mverts[v].co);
+    const float sum_co_source = sum_v3(data->mverts[v_source].co);
+    if (sum_co < sum_co_source || (sum_co == sum_co_source && v < v_source)) {
+      return data->source_map[v - data->source_start];
+    }
   }
+  return data->doubles_map[v];
+}
+
+/**
+ * If target is already mapped, we only follow that mapping if final target remains
+ * close enough from current vert (otherwise no mapping at all).
+ * Returns false if that requires the mapping of another source vertex.
+ */
+static bool map_doubles_follow(const MapDoublesData *data,
+                               const int v_source,
+                               const bool use_source_map,
+                               int *r_target)
+{
+  int target = *r_target;
+  while (target != -1) {
+    int target_next;
+    if (target >= data->source_start && target < data->source_end) {
+      if (!use_source_map) {
+        return false;
+      }
+      target_next = map_doubles_lookup(data, target, v_source);
+    }
+    else {
+      target_next = data->doubles_map[target];
+    }
+    if (ELEM(target_next, -1, target)) {
+      break;
+    }
+    if (compare_len_v3v3(data->mverts[v_source].co, data->mverts[target_next].co, data->dist)) {
+      target = target_next;
+    }
+    else {
+      target = -1;
+    }
+  }
+  *r_target = target;
+  return true;
+}
+
+static void map_doubles_task(void *__restrict userdata,
+                             const int i_source,
+                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MapDoublesData *data = userdata;
+  const MergeVertsHash *hash = data->hash;
+  const int v_source = data->source_start + i_source;
+  const float *co = data->mverts[v_source].co;
+  const float sum_co = sum_v3(co);
+  int best_target_vertex = -1;
+  float best_dist_sq = data->dist * data->dist;
+  float best_sum_co = 0.0f;
+  int cell[3];
+
+  /* If source has already been assigned to a target (in an earlier call, with other chunks) */
+  if (data->doubles_map[v_source] != -1) {
+    data->source_map[i_source] = data->doubles_map[v_source];
+    return;
+  }
+
+  merge_hash_cell(hash, co, cell);
+
+  for (int z = cell[2] - 1; z <= cell[2] + 1; z++) {
+    for (int y = cell[1] - 1; y <= cell[1] + 1; y++) {
+      for (int x = cell[0] - 1; x <= cell[0] + 1; x++) {
+        const uint bucket = merge_hash_bucket(hash, x, y, z);
+        for (int j = hash->bucket_offsets[bucket]; j < hash->bucket_offsets[bucket + 1]; j++) {
+          const int v_target = hash->bucket_verts[j];
+          const float *co_target = data->mverts[v_target].co;
+          const float sum_co_target = sum_v3(co_target);
+          float dist_sq;
+
+          /* Same candidates as scanning targets sorted by sum_v3(co) within dist3. */
+          if (sum_co_target < sum_co - data->dist3 || sum_co_target > sum_co + data->dist3) {
+            continue;
+          }
+          if ((dist_sq = len_squared_v3v3(co, co_target)) > best_dist_sq) {
+            continue;
+          }
+          /* Of equally distant targets, the last one in that scan order wins. */
+          if (dist_sq == best_dist_sq && best_target_vertex != -1 &&
+              (sum_co_target < best_sum_co ||
+               (sum_co_target == best_sum_co && v_target < best_target_vertex))) {
+            continue;
+          }
+          best_dist_sq = dist_sq;
+          best_sum_co = sum_co_target;
+          best_target_vertex = v_target;
+        }
+      }
+    }
+  }
+
+  if (!map_doubles_follow(data, v_source, false, &best_target_vertex)) {
+    data->source_deferred[i_source] = true;
+  }
+  data->source_map[i_source] = best_target_vertex;
 }
 
 /**
@@ -152,6 +363,9 @@ static void svert_from_mvert(SortVertsElem *sv,
  * It builds a mapping for all vertices within source,
  * to vertices within target, or -1 if no double found.
  * The int doubles_map[num_verts_source] array must have been allocated by caller.
+ *
+ * Target vertices are looked up in a spatial hash, the mapping is the same as scanning both
+ * sets sorted by the sum of their coordinates.
  */
 static void dm_mvert_map_doubles(int *doubles_map,
                                  const MVert *mverts,
@@ -162,109 +376,61 @@ static void dm_mvert_map_doubles(int *doubles_map,
                                  const float dist)
 {
   const float dist3 = ((float)M_SQRT3 + 0.00005f) * dist; /* Just above sqrt(3) */
-  int i_source, i_target, i_target_low_bound, target_end, source_end;
-  SortVertsElem *sorted_verts_target, *sorted_verts_source;
-  SortVertsElem *sve_source, *sve_target, *sve_target_low_bound;
-  bool target_scan_completed;
-
-  target_end = target_start + target_num_verts;
-  source_end = source_start + source_num_verts;
-
-  /* build array of MVerts to be tested for merging */
-  sorted_verts_target = MEM_malloc_arrayN(target_num_verts, sizeof(SortVertsElem), __func__);
-  sorted_verts_source = MEM_malloc_arrayN(source_num_verts, sizeof(SortVertsElem), __func__);
-
-  /* Copy target vertices index and cos into SortVertsElem array */
-  svert_from_mvert(sorted_verts_target, mverts + target_start, target_start, target_end);
-
-  /* Copy source vertices index and cos into SortVertsElem array */
-  svert_from_mvert(sorted_verts_source, mverts + source_start, source_start, source_end);
-
-  /* sort arrays according to sum of vertex coordinates (sumco) */
-  qsort(sorted_verts_target, target_num_verts, sizeof(SortVertsElem), svert_sum_cmp);
-  qsort(sorted_verts_source, source_num_verts, sizeof(SortVertsElem), svert_sum_cmp);
-
-  sve_target_low_bound = sorted_verts_target;
-  i_target_low_bound = 0;
-  target_scan_completed = false;
-
-  /* Scan source vertices, in SortVertsElem sorted array, */
-  /* all the while maintaining the lower bound of possible doubles in target vertices */
-  for (i_source = 0, sve_source = sorted_verts_source; i_source < source_num_verts;
-       i_source++, sve_source++) {
-    int best_target_vertex = -1;
-    float best_dist_sq = dist * dist;
-    float sve_source_sumco;
-
-    /* If source has already been assigned to a target (in an earlier call, with other chunks) */
-    if (doubles_map[sve_source->vertex_num] != -1) {
-      continue;
-    }
+  MergeVertsHash hash;
+  int deferred_num = 0;
 
-    /* If target fully scanned already, then all remaining source vertices cannot have a double */
-    if (target_scan_completed) {
-      doubles_map[sve_source->vertex_num] = -1;
-      continue;
-    }
+  if (source_num_verts == 0 || target_num_verts == 0) {
+    return;
+  }
 
-    sve_source_sumco = sum_v3(sve_source->co);
+  merge_hash_build(&hash, mverts, target_start, target_num_verts, dist);
+
+  MapDoublesData data = {
+      .doubles_map = doubles_map,
+      .mverts = mverts,
+      .hash = &hash,
+      .source_start = source_start,
+      .source_end = source_start + source_num_verts,
+      .dist = dist,
+      .dist3 = dist3,
+      .source_map = MEM_malloc_arrayN(source_num_verts, sizeof(int), __func__),
+      .source_deferred = MEM_calloc_arrayN(source_num_verts, sizeof(bool), __func__),
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (source_num_verts > 1024);
+  BLI_task_parallel_range(0, source_num_verts, &data, map_doubles_task, &settings);
+
+  for (int i = 0; i < source_num_verts; i++) {
+    deferred_num += data.source_deferred[i];
+  }
 
-    /* Skip all target vertices that are more than dist3 lower in terms of sumco */
-    /* and advance the overall lower bound, applicable to all remaining vertices as well. */
-    while ((i_target_low_bound < target_num_verts) &&
-           (sve_target_low_bound->sum_co < sve_source_sumco - dist3)) {
-      i_target_low_bound++;
-      sve_target_low_bound++;
-    }
-    /* If end of target list reached, then no more possible doubles */
-    if (i_target_low_bound >= target_num_verts) {
-      doubles_map[sve_source->vertex_num] = -1;
-      target_scan_completed = true;
-      continue;
-    }
-    /* Test target candidates starting at the low bound of possible doubles,
-     * ordered in terms of sumco. */
-    i_target = i_target_low_bound;
-    sve_target = sve_target_low_bound;
-
-    /* i_target will scan vertices in the
-     * [v_source_sumco - dist3;  v_source_sumco + dist3] range */
-
-    while ((i_target < target_num_verts) && (sve_target->sum_co <= sve_source_sumco + dist3)) {
-      /* Testing distance for candidate double in target */
-      /* v_target is within dist3 of v_source in terms of sumco;  check real distance */
-      float dist_sq;
-      if ((dist_sq = len_squared_v3v3(sve_source->co, sve_target->co)) <= best_dist_sq) {
-        /* Potential double found */
-        best_dist_sq = dist_sq;
-        best_target_vertex = sve_target->vertex_num;
-
-        /* If target is already mapped, we only follow that mapping if final target remains
-         * close enough from current vert (otherwise no mapping at all).
-         * Note that if we later find another target closer than this one, then we check it.
-         * But if other potential targets are farther,
-         * then there will be no mapping at all for this source. */
-        while (best_target_vertex != -1 &&
-               !ELEM(doubles_map[best_target_vertex], -1, best_target_vertex)) {
-          if (compare_len_v3v3(mverts[sve_source->vertex_num].co,
-                               mverts[doubles_map[best_target_vertex]].co,
-                               dist)) {
-            best_target_vertex = doubles_map[best_target_vertex];
-          }
-          else {
-            best_target_vertex = -1;
-          }
-        }
+  /* Targets that are mapped back to source vertices (merging the first and last copies)
+   * depend on the order in which sources are mapped, resolve those in scan order. */
+  if (deferred_num != 0) {
+    SortVertsElem *sorted_verts = MEM_malloc_arrayN(deferred_num, sizeof(*sorted_verts), __func__);
+    SortVertsElem *sv = sorted_verts;
+    for (int i = 0; i < source_num_verts; i++) {
+      if (data.source_deferred[i]) {
+        sv->vertex_num = source_start + i;
+        sv->sum_co = sum_v3(mverts[source_start + i].co);
+        sv++;
       }
-      i_target++;
-      sve_target++;
     }
-    /* End of candidate scan: if none found then no doubles */
-    doubles_map[sve_source->vertex_num] = best_target_vertex;
+    qsort(sorted_verts, deferred_num, sizeof(SortVertsElem), svert_sum_cmp);
+
+    for (int i = 0; i < deferred_num; i++) {
+      const int v_source = sorted_verts[i].vertex_num;
+      map_doubles_follow(&data, v_source, true, &data.source_map[v_source - source_start]);
+    }
+    MEM_freeN(sorted_verts);
   }
 
-  MEM_freeN(sorted_verts_source);
-  MEM_freeN(sorted_verts_target);
+  memcpy(doubles_map + source_start, data.source_map, sizeof(int) * (size_t)source_num_verts);
+
+  MEM_freeN(data.source_map);
+  MEM_freeN(data.source_deferred);
+  merge_hash_free(&hash);
 }
 
 static void mesh_merge_transform(Mesh *result,
@@ -349,17 +515,138 @@ static void mesh_merge_transform(Mesh *result,
   }
 }
 
+typedef struct ArrayChunkData {
+  const Mesh *mesh;
+  Mesh *result;
+  /* Cumulative offset of each copy. */
+  float (*chunk_offsets)[4][4];
+  const float *uv_offset;
+  int chunk_nverts, chunk_nedges, chunk_nloops, chunk_npolys;
+  bool use_recalc_normals;
+  bool use_uv_offset;
+} ArrayChunkData;
+
+static void array_chunk_copy_task(void *__restrict userdata,
+                                  const int c,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ArrayChunkData *data = userdata;
+  const Mesh *mesh = data->mesh;
+  Mesh *result = data->result;
+  const int chunk_nverts = data->chunk_nverts;
+  const int chunk_nedges = data->chunk_nedges;
+  const int chunk_nloops = data->chunk_nloops;
+  const int chunk_npolys = data->chunk_npolys;
+  float(*current_offset)[4] = data->chunk_offsets[c];
+  MVert *mv;
+  MEdge *me;
+  MLoop *ml;
+  MPoly *mp;
+  int i;
+
+  /* copy customdata to new geometry */
+  CustomData_copy_data(&mesh->vdata, &result->vdata, 0, c * chunk_nverts, chunk_nverts);
+  CustomData_copy_data(&mesh->edata, &result->edata, 0, c * chunk_nedges, chunk_nedges);
+  CustomData_copy_data(&mesh->ldata, &result->ldata, 0, c * chunk_nloops, chunk_nloops);
+  CustomData_copy_data(&mesh->pdata, &result->pdata, 0, c * chunk_npolys, chunk_npolys);
+
+  /* apply offset to all new verts */
+  mv = result->mvert + c * chunk_nverts;
+  for (i = 0; i < chunk_nverts; i++, mv++) {
+    mul_m4_v3(current_offset, mv->co);
+
+    /* We have to correct normals too, if we do not tag them as dirty! */
+    if (!data->use_recalc_normals) {
+      float no[3];
+      normal_short_to_float_v3(no, mv->no);
+      mul_mat3_m4_v3(current_offset, no);
+      normalize_v3(no);
+      normal_float_to_short_v3(mv->no, no);
+    }
+  }
+
+  /* adjust edge vertex indices */
+  me = result->medge + c * chunk_nedges;
+  for (i = 0; i < chunk_nedges; i++, me++) {
+    me->v1 += c * chunk_nverts;
+    me->v2 += c * chunk_nverts;
+  }
+
+  mp = result->mpoly + c * chunk_npolys;
+  for (i = 0; i < chunk_npolys; i++, mp++) {
+    mp->loopstart += c * chunk_nloops;
+  }
+
+  /* adjust loop vertex and edge indices */
+  ml = result->mloop + c * chunk_nloops;
+  for (i = 0; i < chunk_nloops; i++, ml++) {
+    ml->v += c * chunk_nverts;
+    ml->e += c * chunk_nedges;
+  }
+
+  /* handle UVs */
+  if (data->use_uv_offset) {
+    const int totuv = CustomData_number_of_layers(&result->ldata, CD_MLOOPUV);
+    const float uv_offset[2] = {
+        data->uv_offset[0] * (float)c,
+        data->uv_offset[1] * (float)c,
+    };
+    for (i = 0; i < totuv; i++) {
+      MLoopUV *dmloopuv = CustomData_get_layer_n(&result->ldata, CD_MLOOPUV, i);
+      dmloopuv += c * chunk_nloops;
+      for (int l_index = chunk_nloops; l_index-- != 0; dmloopuv++) {
+        dmloopuv->uv[0] += uv_offset[0];
+        dmloopuv->uv[1] += uv_offset[1];
+      }
+    }
+  }
+}
+
+typedef struct ArrayMapDoublesData {
+  int *full_doubles_map;
+  const MVert *mverts;
+  int chunk_start;
+  int chunk_nverts;
+  float merge_dist;
+} ArrayMapDoublesData;
+
+/* Mapping chunk 3 to chunk 2 is a translation of mapping 2 to 1. */
+static void array_map_doubles_translated_task(void *__restrict userdata,
+                                              const int k,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ArrayMapDoublesData *data = userdata;
+  int *full_doubles_map = data->full_doubles_map;
+  const int this_chunk_index = data->chunk_start + k;
+  const int prev_chunk_index = this_chunk_index - data->chunk_nverts;
+  int target = full_doubles_map[prev_chunk_index];
+
+  if (target != -1) {
+    target += data->chunk_nverts; /* translate mapping */
+    while (target != -1 && !ELEM(full_doubles_map[target], -1, target)) {
+      /* If target is already mapped, we only follow that mapping if final target remains
+       * close enough from current vert (otherwise no mapping at all). */
+      if (compare_len_v3v3(data->mverts[this_chunk_index].co,
+                           data->mverts[full_doubles_map[target]].co,
+                           data->merge_dist)) {
+        target = full_doubles_map[target];
+      }
+      else {
+        target = -1;
+      }
+    }
+  }
+  full_doubles_map[this_chunk_index] = target;
+}
+
 static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
                                    const ModifierEvalContext *ctx,
                                    Mesh *mesh)
 {
   const float eps = 1e-6f;
   const MVert *src_mvert;
-  MVert *mv, *mv_prev, *result_dm_verts;
+  MVert *result_dm_verts;
 
-  MEdge *me;
-  MLoop *ml;
-  MPoly *mp;
   int i, j, c, count;
   float length = amd->length;
   /* offset matrix */
@@ -368,6 +655,7 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
   bool offset_has_scale;
   float current_offset[4][4];
   float final_offset[4][4];
+  float(*chunk_offsets)[4][4];
   int *full_doubles_map = NULL;
   int tot_doubles;
 
@@ -533,110 +821,57 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
   first_chunk_start = 0;
   first_chunk_nverts = chunk_nverts;
 
-  unit_m4(current_offset);
+  /* The cumulative offset of each copy, so the copies can be made in parallel. */
+  chunk_offsets = MEM_malloc_arrayN(count, sizeof(*chunk_offsets), __func__);
+  unit_m4(chunk_offsets[0]);
   for (c = 1; c < count; c++) {
-    /* copy customdata to new geometry */
-    CustomData_copy_data(&mesh->vdata, &result->vdata, 0, c * chunk_nverts, chunk_nverts);
-    CustomData_copy_data(&mesh->edata, &result->edata, 0, c * chunk_nedges, chunk_nedges);
-    CustomData_copy_data(&mesh->ldata, &result->ldata, 0, c * chunk_nloops, chunk_nloops);
-    CustomData_copy_data(&mesh->pdata, &result->pdata, 0, c * chunk_npolys, chunk_npolys);
-
-    mv_prev = result_dm_verts;
-    mv = mv_prev + c * chunk_nverts;
-
-    /* recalculate cumulative offset here */
-    mul_m4_m4m4(current_offset, current_offset, offset);
-
-    /* apply offset to all new verts */
-    for (i = 0; i < chunk_nverts; i++, mv++, mv_prev++) {
-      mul_m4_v3(current_offset, mv->co);
-
-      /* We have to correct normals too, if we do not tag them as dirty! */
-      if (!use_recalc_normals) {
-        float no[3];
-        normal_short_to_float_v3(no, mv->no);
-        mul_mat3_m4_v3(current_offset, no);
-        normalize_v3(no);
-        normal_float_to_short_v3(mv->no, no);
-      }
-    }
-
-    /* adjust edge vertex indices */
-    me = result->medge + c * chunk_nedges;
-    for (i = 0; i < chunk_nedges; i++, me++) {
-      me->v1 += c * chunk_nverts;
-      me->v2 += c * chunk_nverts;
-    }
-
-    mp = result->mpoly + c * chunk_npolys;
-    for (i = 0; i < chunk_npolys; i++, mp++) {
-      mp->loopstart += c * chunk_nloops;
-    }
-
-    /* adjust loop vertex and edge indices */
-    ml = result->mloop + c * chunk_nloops;
-    for (i = 0; i < chunk_nloops; i++, ml++) {
-      ml->v += c * chunk_nverts;
-      ml->e += c * chunk_nedges;
-    }
-
-    /* Handle merge between chunk n and n-1 */
-    if (use_merge && (c >= 1)) {
-      if (!offset_has_scale && (c >= 2)) {
-        /* Mapping chunk 3 to chunk 2 is a translation of mapping 2 to 1
-         * ... that is except if scaling makes the distance grow */
-        int k;
-        int this_chunk_index = c * chunk_nverts;
-        int prev_chunk_index = (c - 1) * chunk_nverts;
-        for (k = 0; k < chunk_nverts; k++, this_chunk_index++, prev_chunk_index++) {
-          int target = full_doubles_map[prev_chunk_index];
-          if (target != -1) {
-            target += chunk_nverts; /* translate mapping */
-            while (target != -1 && !ELEM(full_doubles_map[target], -1, target)) {
-              /* If target is already mapped, we only follow that mapping if final target remains
-               * close enough from current vert (otherwise no mapping at all). */
-              if (compare_len_v3v3(result_dm_verts[this_chunk_index].co,
-                                   result_dm_verts[full_doubles_map[target]].co,
-                                   amd->merge_dist)) {
-                target = full_doubles_map[target];
-              }
-              else {
-                target = -1;
-              }
-            }
-          }
-          full_doubles_map[this_chunk_index] = target;
-        }
-      }
-      else {
-        dm_mvert_map_doubles(full_doubles_map,
-                             result_dm_verts,
-                             (c - 1) * chunk_nverts,
-                             chunk_nverts,
-                             c * chunk_nverts,
-                             chunk_nverts,
-                             amd->merge_dist);
-      }
-    }
+    mul_m4_m4m4(chunk_offsets[c], chunk_offsets[c - 1], offset);
   }
-
-  /* handle UVs */
-  if (chunk_nloops > 0 && is_zero_v2(amd->uv_offset) == false) {
-    const int totuv = CustomData_number_of_layers(&result->ldata, CD_MLOOPUV);
-    for (i = 0; i < totuv; i++) {
-      MLoopUV *dmloopuv = CustomData_get_layer_n(&result->ldata, CD_MLOOPUV, i);
-      dmloopuv += chunk_nloops;
-      for (c = 1; c < count; c++) {
-        const float uv_offset[2] = {
-            amd->uv_offset[0] * (float)c,
-            amd->uv_offset[1] * (float)c,
-        };
-        int l_index = chunk_nloops;
-        for (; l_index-- != 0; dmloopuv++) {
-          dmloopuv->uv[0] += uv_offset[0];
-          dmloopuv->uv[1] += uv_offset[1];
-        }
-      }
+  copy_m4_m4(current_offset, chunk_offsets[count - 1]);
+
+  ArrayChunkData chunk_data = {
+      .mesh = mesh,
+      .result = result,
+      .chunk_offsets = chunk_offsets,
+      .uv_offset = amd->uv_offset,
+      .chunk_nverts = chunk_nverts,
+      .chunk_nedges = chunk_nedges,
+      .chunk_nloops = chunk_nloops,
+      .chunk_npolys = chunk_npolys,
+      .use_recalc_normals = use_recalc_normals,
+      .use_uv_offset = (chunk_nloops > 0 && is_zero_v2(amd->uv_offset) == false),
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((count - 1) * (chunk_nverts + chunk_nloops) > 1024);
+  BLI_task_parallel_range(1, count, &chunk_data, array_chunk_copy_task, &settings);
+
+  MEM_freeN(chunk_offsets);
+
+  /* Handle merge between chunk n and n-1 */
+  for (c = 1; use_merge && c < count; c++) {
+    if (!offset_has_scale && (c >= 2)) {
+      /* Mapping chunk 3 to chunk 2 is a translation of mapping 2 to 1
+       * ... that is except if scaling makes the distance grow */
+      ArrayMapDoublesData map_data = {
+          .full_doubles_map = full_doubles_map,
+          .mverts = result_dm_verts,
+          .chunk_start = c * chunk_nverts,
+          .chunk_nverts = chunk_nverts,
+          .merge_dist = amd->merge_dist,
+      };
+      settings.use_threading = (chunk_nverts > 1024);
+      BLI_task_parallel_range(
+          0, chunk_nverts, &map_data, array_map_doubles_translated_task, &settings);
+    }
+    else {
+      dm_mvert_map_doubles(full_doubles_map,
+                           result_dm_verts,
+                           (c - 1) * chunk_nverts,
+                           chunk_nverts,
+                           c * chunk_nverts,
+                           chunk_nverts,
+                           amd->merge_dist);
     }
   }
 
@@ -97,6 +97,78 @@ static void updateDepsgraph(ModifierData *md, const ModifierUpdateDepsgraphConte
   }
 }
 
+typedef struct CastUserdata {
+  short flag;
+  bool use_ctrl_ob;
+  bool has_radius;
+  bool is_cylinder;
+  float radius;
+  float fac;
+  float len;
+  float center[3];
+  float mat[4][4], imat[4][4];
+  /* Bound box corners, for cuboid casting. */
+  float bb[8][3];
+} CastUserdata;
+
+static void sphere_do_vert(void *__restrict userdata,
+                           const int UNUSED(index),
+                           float co[3],
+                           const float weight)
+{
+  const CastUserdata *data = userdata;
+  const short flag = data->flag;
+  const float fac = data->fac * weight;
+  const float facm = 1.0f - fac;
+  const float len = data->len;
+  float vec[3], tmp_co[3];
+
+  copy_v3_v3(tmp_co, co);
+  if (data->use_ctrl_ob) {
+    if (flag & MOD_CAST_USE_OB_TRANSFORM) {
+      mul_m4_v3(data->mat, tmp_co);
+    }
+    else {
+      sub_v3_v3(tmp_co, data->center);
+    }
+  }
+
+  copy_v3_v3(vec, tmp_co);
+
+  if (data->is_cylinder) {
+    vec[2] = 0.0f;
+  }
+
+  if (data->has_radius) {
+    if (len_v3(vec) > data->radius) {
+      return;
+    }
+  }
+
+  normalize_v3(vec);
+
+  if (flag & MOD_CAST_X) {
+    tmp_co[0] = fac * vec[0] * len + facm * tmp_co[0];
+  }
+  if (flag & MOD_CAST_Y) {
+    tmp_co[1] = fac * vec[1] * len + facm * tmp_co[1];
+  }
+  if (flag & MOD_CAST_Z) {
+    tmp_co[2] = fac * vec[2] * len + facm * tmp_co[2];
+  }
+
+  if (data->use_ctrl_ob) {
+    if (flag & MOD_CAST_USE_OB_TRANSFORM) {
+      mul_m4_v3(data->imat, tmp_co);
+    }
+    else {
+      add_v3_v3(tmp_co, data->center);
+    }
+  }
+
+  copy_v3_v3(co, tmp_co);
+}
+
 static void sphere_do(CastModifierData *cmd,
                       const ModifierEvalContext *UNUSED(ctx),
                       Object *ob,
@@ -109,14 +181,9 @@ static void sphere_do(CastModifierData *cmd,
   Object *ctrl_ob = NULL;
 
   int i, defgrp_index;
-  bool has_radius = false;
   short flag, type;
   float len = 0.0f;
-  float fac = cmd->fac;
-  float facm = 1.0f - fac;
-  const float fac_orig = fac;
-  float vec[3], center[3] = {0.0f, 0.0f, 0.0f};
-  float mat[4][4], imat[4][4];
+  CastUserdata data = {0};
 
   flag = cmd->flag;
   type = cmd->type; /* projection type: sphere or cylinder */
@@ -132,13 +199,13 @@ static void sphere_do(CastModifierData *cmd,
    * we use its location, transformed to ob's local space */
   if (ctrl_ob) {
     if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-      invert_m4_m4(imat, ctrl_ob->obmat);
-      mul_m4_m4m4(mat, imat, ob->obmat);
-      invert_m4_m4(imat, mat);
+      invert_m4_m4(data.imat, ctrl_ob->obmat);
+      mul_m4_m4m4(data.mat, data.imat, ob->obmat);
+      invert_m4_m4(data.imat, data.mat);
     }
 
     invert_m4_m4(ob->imat, ob->obmat);
-    mul_v3_m4v3(center, ob->imat, ctrl_ob->obmat[3]);
+    mul_v3_m4v3(data.center, ob->imat, ctrl_ob->obmat[3]);
   }
 
   /* now we check which options the user wants */
@@ -147,7 +214,7 @@ static void sphere_do(CastModifierData *cmd,
   /* 2) cmd->radius > 0.0f: only the vertices within this radius from
    * the center of the effect should be deformed */
   if (cmd->radius > FLT_EPSILON) {
-    has_radius = 1;
+    data.has_radius = true;
   }
 
   /* 3) if we were given a vertex group name,
@@ -163,7 +230,7 @@ static void sphere_do(CastModifierData *cmd,
 
   if (len <= 0) {
     for (i = 0; i < numVerts; i++) {
-      len += len_v3v3(center, vertexCos[i]);
+      len += len_v3v3(data.center, vertexCos[i]);
     }
     len /= numVerts;
 
@@ -172,64 +239,118 @@ static void sphere_do(CastModifierData *cmd,
     }
   }
 
-  for (i = 0; i < numVerts; i++) {
-    float tmp_co[3];
-
-    copy_v3_v3(tmp_co, vertexCos[i]);
-    if (ctrl_ob) {
-      if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-        mul_m4_v3(mat, tmp_co);
-      }
-      else {
-        sub_v3_v3(tmp_co, center);
-      }
-    }
+  data.flag = flag;
+  data.use_ctrl_ob = (ctrl_ob != NULL);
+  data.is_cylinder = (type == MOD_CAST_TYPE_CYLINDER);
+  data.radius = cmd->radius;
+  data.fac = cmd->fac;
+  data.len = len;
 
-    copy_v3_v3(vec, tmp_co);
+  MOD_deform_verts_parallel(
+      vertexCos, numVerts, dvert, defgrp_index, false, &data, sphere_do_vert);
+}
 
-    if (type == MOD_CAST_TYPE_CYLINDER) {
-      vec[2] = 0.0f;
+static void cuboid_do_vert(void *__restrict userdata,
+                           const int UNUSED(index),
+                           float co[3],
+                           const float weight)
+{
+  const CastUserdata *data = userdata;
+  const short flag = data->flag;
+  const float fac = data->fac * weight;
+  const float facm = 1.0f - fac;
+  int octant, coord;
+  float d[3], dmax, apex[3], fbb;
+  float tmp_co[3];
+
+  copy_v3_v3(tmp_co, co);
+  if (data->use_ctrl_ob) {
+    if (flag & MOD_CAST_USE_OB_TRANSFORM) {
+      mul_m4_v3(data->mat, tmp_co);
+    }
+    else {
+      sub_v3_v3(tmp_co, data->center);
     }
+  }
 
-    if (has_radius) {
-      if (len_v3(vec) > cmd->radius) {
-        continue;
-      }
+  if (data->has_radius) {
+    if (fabsf(tmp_co[0]) > data->radius || fabsf(tmp_co[1]) > data->radius ||
+        fabsf(tmp_co[2]) > data->radius) {
+      return;
     }
+  }
 
-    if (dvert) {
-      const float weight = defvert_find_weight(&dvert[i], defgrp_index);
-      if (weight == 0.0f) {
-        continue;
-      }
+  /* The algo used to project the vertices to their
+   * bounding box (bb) is pretty simple:
+   * for each vertex v:
+   * 1) find in which octant v is in;
+   * 2) find which outer "wall" of that octant is closer to v;
+   * 3) calculate factor (var fbb) to project v to that wall;
+   * 4) project. */
+
+  /* find in which octant this vertex is in */
+  octant = 0;
+  if (tmp_co[0] > 0.0f) {
+    octant += 1;
+  }
+  if (tmp_co[1] > 0.0f) {
+    octant += 2;
+  }
+  if (tmp_co[2] > 0.0f) {
+    octant += 4;
+  }
 
-      fac = fac_orig * weight;
-      facm = 1.0f - fac;
-    }
+  /* apex is the bb's vertex at the chosen octant */
+  copy_v3_v3(apex, data->bb[octant]);
 
-    normalize_v3(vec);
+  /* find which bb plane is closest to this vertex ... */
+  d[0] = tmp_co[0] / apex[0];
+  d[1] = tmp_co[1] / apex[1];
+  d[2] = tmp_co[2] / apex[2];
 
-    if (flag & MOD_CAST_X) {
-      tmp_co[0] = fac * vec[0] * len + facm * tmp_co[0];
-    }
-    if (flag & MOD_CAST_Y) {
-      tmp_co[1] = fac * vec[1] * len + facm * tmp_co[1];
-    }
-    if (flag & MOD_CAST_Z) {
-      tmp_co[2] = fac * vec[2] * len + facm * tmp_co[2];
-    }
+  /* ... (the closest has the higher (closer to 1) d value) */
+  dmax = d[0];
+  coord = 0;
+  if (d[1] > dmax) {
+    dmax = d[1];
+    coord = 1;
+  }
+  if (d[2] > dmax) {
+    /* dmax = d[2]; */ /* commented, we don't need it */
+    coord = 2;
+  }
 
-    if (ctrl_ob) {
-      if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-        mul_m4_v3(imat, tmp_co);
-      }
-      else {
-        add_v3_v3(tmp_co, center);
-      }
-    }
+  /* ok, now we know which coordinate of the vertex to use */
+
+  if (fabsf(tmp_co[coord]) < FLT_EPSILON) { /* avoid division by zero */
+    return;
+  }
+
+  /* finally, this is the factor we wanted, to project the vertex
+   * to its bounding box (bb) */
+  fbb = apex[coord] / tmp_co[coord];
 
-    copy_v3_v3(vertexCos[i], tmp_co);
+  /* calculate the new vertex position */
+  if (flag & MOD_CAST_X) {
+    tmp_co[0] = facm * tmp_co[0] + fac * tmp_co[0] * fbb;
   }
+  if (flag & MOD_CAST_Y) {
+    tmp_co[1] = facm * tmp_co[1] + fac * tmp_co[1] * fbb;
+  }
+  if (flag & MOD_CAST_Z) {
+    tmp_co[2] = facm * tmp_co[2] + fac * tmp_co[2] * fbb;
+  }
+
+  if (data->use_ctrl_ob) {
+    if (flag & MOD_CAST_USE_OB_TRANSFORM) {
+      mul_m4_v3(data->imat, tmp_co);
+    }
+    else {
+      add_v3_v3(tmp_co, data->center);
+    }
+  }
+
+  copy_v3_v3(co, tmp_co);
 }
 
 static void cuboid_do(CastModifierData *cmd,
@@ -245,17 +366,18 @@ static void cuboid_do(CastModifierData *cmd,
   int i, defgrp_index;
   bool has_radius = false;
   short flag;
-  float fac = cmd->fac;
-  float facm = 1.0f - fac;
-  const float fac_orig = fac;
-  float min[3], max[3], bb[8][3];
-  float center[3] = {0.0f, 0.0f, 0.0f};
-  float mat[4][4], imat[4][4];
+  float min[3], max[3];
+  float(*bb)[3];
+  float *center;
+  CastUserdata data = {0};
 
   flag = cmd->flag;
 
   ctrl_ob = cmd->object;
 
+  bb = data.bb;
+  center = data.center;
+
   /* now we check which options the user wants */
 
   /* 1) (flag was checked in the "if (ctrl_ob)" block above) */
@@ -271,9 +393,9 @@ static void cuboid_do(CastModifierData *cmd,
 
   if (ctrl_ob) {
     if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-      invert_m4_m4(imat, ctrl_ob->obmat);
-      mul_m4_m4m4(mat, imat, ob->obmat);
-      invert_m4_m4(imat, mat);
+      invert_m4_m4(data.imat, ctrl_ob->obmat);
+      mul_m4_m4m4(data.mat, data.imat, ob->obmat);
+      invert_m4_m4(data.imat, data.mat);
     }
 
     invert_m4_m4(ob->imat, ob->obmat);
@@ -342,110 +464,14 @@ static void cuboid_do(CastModifierData *cmd,
   bb[4][2] = bb[5][2] = bb[6][2] = bb[7][2] = max[2];
 
   /* ready to apply the effect, one vertex at a time */
-  for (i = 0; i < numVerts; i++) {
-    int octant, coord;
-    float d[3], dmax, apex[3], fbb;
-    float tmp_co[3];
-
-    copy_v3_v3(tmp_co, vertexCos[i]);
-    if (ctrl_ob) {
-      if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-        mul_m4_v3(mat, tmp_co);
-      }
-      else {
-        sub_v3_v3(tmp_co, center);
-      }
-    }
-
-    if (has_radius) {
-      if (fabsf(tmp_co[0]) > cmd->radius || fabsf(tmp_co[1]) > cmd->radius ||
-          fabsf(tmp_co[2]) > cmd->radius) {
-        continue;
-      }
-    }
-
-    if (dvert) {
-      const float weight = defvert_find_weight(&dvert[i], defgrp_index);
-      if (weight == 0.0f) {
-        continue;
-      }
-
-      fac = fac_orig * weight;
-      facm = 1.0f - fac;
-    }
-
-    /* The algo used to project the vertices to their
-     * bounding box (bb) is pretty simple:
-     * for each vertex v:
-     * 1) find in which octant v is in;
-     * 2) find which outer "wall" of that octant is closer to v;
-     * 3) calculate factor (var fbb) to project v to that wall;
-     * 4) project. */
-
-    /* find in which octant this vertex is in */
-    octant = 0;
-    if (tmp_co[0] > 0.0f) {
-      octant += 1;
-    }
-    if (tmp_co[1] > 0.0f) {
-      octant += 2;
-    }
-    if (tmp_co[2] > 0.0f) {
-      octant += 4;
-    }
-
-    /* apex is the bb's vertex at the chosen octant */
-    copy_v3_v3(apex, bb[octant]);
-
-    /* find which bb plane is closest to this vertex ... */
-    d[0] = tmp_co[0] / apex[0];
-    d[1] = tmp_co[1] / apex[1];
-    d[2] = tmp_co[2] / apex[2];
-
-    /* ... (the closest has the higher (closer to 1) d value) */
-    dmax = d[0];
-    coord = 0;
-    if (d[1] > dmax) {
-      dmax = d[1];
-      coord = 1;
-    }
-    if (d[2] > dmax) {
-      /* dmax = d[2]; */ /* commented, we don't need it */
-      coord = 2;
-    }
-
-    /* ok, now we know which coordinate of the vertex to use */
-
-    if (fabsf(tmp_co[coord]) < FLT_EPSILON) { /* avoid division by zero */
-      continue;
-    }
-
-    /* finally, this is the factor we wanted, to project the vertex
-     * to its bounding box (bb) */
-    fbb = apex[coord] / tmp_co[coord];
-
-    /* calculate the new vertex position */
-    if (flag & MOD_CAST_X) {
-      tmp_co[0] = facm * tmp_co[0] + fac * tmp_co[0] * fbb;
-    }
-    if (flag & MOD_CAST_Y) {
-      tmp_co[1] = facm * tmp_co[1] + fac * tmp_co[1] * fbb;
-    }
-    if (flag & MOD_CAST_Z) {
-      tmp_co[2] = facm * tmp_co[2] + fac * tmp_co[2] * fbb;
-    }
-
-    if (ctrl_ob) {
-      if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-        mul_m4_v3(imat, tmp_co);
-      }
-      else {
-        add_v3_v3(tmp_co, center);
-      }
-    }
-
-    copy_v3_v3(vertexCos[i], tmp_co);
-  }
+  data.flag = flag;
+  data.use_ctrl_ob = (ctrl_ob != NULL);
+  data.has_radius = has_radius;
+  data.radius = cmd->radius;
+  data.fac = cmd->fac;
+
+  MOD_deform_verts_parallel(
+      vertexCos, numVerts, dvert, defgrp_index, false, &data, cuboid_do_vert);
 }
 
 static void deformVerts(ModifierData *md,
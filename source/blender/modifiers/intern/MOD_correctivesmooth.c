@@ -25,7 +25,9 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_hash_mm2a.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_scene_types.h"
 #include "DNA_meshdata_types.h"
@@ -53,9 +55,6 @@
 #  include "PIL_time_utildefines.h"
 #endif
 
-/* minor optimization, calculate this inline */
-#define USE_TANGENT_CALC_INLINE
-
 static void initData(ModifierData *md)
 {
   CorrectiveSmoothModifierData *csmd = (CorrectiveSmoothModifierData *)md;
@@ -86,8 +85,11 @@ static void copyData(const ModifierData *md, ModifierData *target, const int fla
 
   tcsmd->delta_cache.deltas = NULL;
   tcsmd->delta_cache.totverts = 0;
+  tcsmd->delta_cache.adjacency = NULL;
 }
 
+static void adjacency_free(CorrectiveSmoothModifierData *csmd);
+
 static void freeBind(CorrectiveSmoothModifierData *csmd)
 {
   MEM_SAFE_FREE(csmd->bind_coords);
@@ -100,6 +102,7 @@ static void freeData(ModifierData *md)
 {
   CorrectiveSmoothModifierData *csmd = (CorrectiveSmoothModifierData *)md;
   freeBind(csmd);
+  adjacency_free(csmd);
 }
 
 static void requiredDataMask(Object *UNUSED(ob),
@@ -168,13 +171,195 @@ static void mesh_get_boundaries(Mesh *mesh, float *smooth_weights)
   MEM_freeN(boundaries);
 }
 
+/* -------------------------------------------------------------------- */
+/* Vertex Adjacency
+ *
+ * Smoothing and tangent spaces gather from the neighbors of each vertex,
+ * so all vertices can be computed in parallel.
+ * Neighbors are stored in the order the edges and polys used to be iterated,
+ * which keeps the result the same as accumulating over edges and polys.
+ *
+ * This only depends on the topology, it's kept in the delta cache while that doesn't change.
+ */
+
+typedef struct CorrectiveSmoothAdjacency {
+  uint verts_num, edges_num, loops_num, polys_num;
+  /* Detect topology changes which keep the same number of elements. */
+  uint topology_hash;
+
+  /* Other vertex of each edge using a vertex,
+   * from `vert_edges_offset[i]` to `vert_edges_offset[i + 1]`. */
+  uint *vert_edges_offset;
+  uint *vert_edges_other;
+
+  /* Previous and next vertex of each corner using a vertex,
+   * from `vert_loops_offset[i]` to `vert_loops_offset[i + 1]`. */
+  uint *vert_loops_offset;
+  uint (*vert_loops_prev_next)[2];
+} CorrectiveSmoothAdjacency;
+
+static void adjacency_free(CorrectiveSmoothModifierData *csmd)
+{
+  CorrectiveSmoothAdjacency *adj = csmd->delta_cache.adjacency;
+
+  if (adj) {
+    MEM_freeN(adj->vert_edges_offset);
+    MEM_freeN(adj->vert_edges_other);
+    MEM_freeN(adj->vert_loops_offset);
+    MEM_freeN(adj->vert_loops_prev_next);
+    MEM_freeN(adj);
+    csmd->delta_cache.adjacency = NULL;
+  }
+}
+
+static uint mesh_topology_hash(const Mesh *mesh)
+{
+  BLI_HashMurmur2A mm2;
+
+  BLI_hash_mm2a_init(&mm2, 0);
+  BLI_hash_mm2a_add(&mm2, (const uchar *)mesh->medge, sizeof(*mesh->medge) * (size_t)mesh->totedge);
+  BLI_hash_mm2a_add(&mm2, (const uchar *)mesh->mloop, sizeof(*mesh->mloop) * (size_t)mesh->totloop);
+  BLI_hash_mm2a_add(&mm2, (const uchar *)mesh->mpoly, sizeof(*mesh->mpoly) * (size_t)mesh->totpoly);
+  return BLI_hash_mm2a_end(&mm2);
+}
+
+/**
+ * Turn per vertex counts into offsets, returns the total.
+ */
+static uint adjacency_offsets_accumulate(uint *offsets, const uint verts_num)
+{
+  uint offset = 0;
+  uint i;
+
+  for (i = 0; i < verts_num; i++) {
+    const uint count = offsets[i];
+    offsets[i] = offset;
+    offset += count;
+  }
+  offsets[verts_num] = offset;
+  return offset;
+}
+
+static CorrectiveSmoothAdjacency *adjacency_create(Mesh *mesh, const uint verts_num)
+{
+  CorrectiveSmoothAdjacency *adj = MEM_callocN(sizeof(*adj), __func__);
+  const MEdge *medge = mesh->medge;
+  const MPoly *mpoly = mesh->mpoly;
+  const MLoop *mloop = mesh->mloop;
+  uint *fill;
+  uint i;
+
+  adj->verts_num = verts_num;
+  adj->edges_num = (uint)mesh->totedge;
+  adj->loops_num = (uint)mesh->totloop;
+  adj->polys_num = (uint)mesh->totpoly;
+  adj->topology_hash = mesh_topology_hash(mesh);
+
+  adj->vert_edges_offset = MEM_calloc_arrayN(verts_num + 1, sizeof(uint), __func__);
+  adj->vert_edges_other = MEM_malloc_arrayN(adj->edges_num * 2, sizeof(uint), __func__);
+  adj->vert_loops_offset = MEM_calloc_arrayN(verts_num + 1, sizeof(uint), __func__);
+  adj->vert_loops_prev_next = MEM_malloc_arrayN(adj->loops_num, sizeof(uint[2]), __func__);
+  fill = MEM_malloc_arrayN(verts_num, sizeof(uint), __func__);
+
+  for (i = 0; i < adj->edges_num; i++) {
+    adj->vert_edges_offset[medge[i].v1]++;
+    adj->vert_edges_offset[medge[i].v2]++;
+  }
+  adjacency_offsets_accumulate(adj->vert_edges_offset, verts_num);
+
+  memcpy(fill, adj->vert_edges_offset, sizeof(uint) * verts_num);
+  for (i = 0; i < adj->edges_num; i++) {
+    adj->vert_edges_other[fill[medge[i].v1]++] = medge[i].v2;
+    adj->vert_edges_other[fill[medge[i].v2]++] = medge[i].v1;
+  }
+
+  for (i = 0; i < adj->loops_num; i++) {
+    adj->vert_loops_offset[mloop[i].v]++;
+  }
+  adjacency_offsets_accumulate(adj->vert_loops_offset, verts_num);
+
+  /* Same order as the polys used to be iterated,
+   * starting with the last corner of each poly. */
+  memcpy(fill, adj->vert_loops_offset, sizeof(uint) * verts_num);
+  for (i = 0; i < adj->polys_num; i++) {
+    const MPoly *mp = &mpoly[i];
+    const MLoop *l_next = &mloop[mp->loopstart];
+    const MLoop *l_term = l_next + mp->totloop;
+    const MLoop *l_prev = l_term - 2;
+    const MLoop *l_curr = l_term - 1;
+
+    for (; l_next != l_term; l_prev = l_curr, l_curr = l_next, l_next++) {
+      uint *prev_next = adj->vert_loops_prev_next[fill[l_curr->v]++];
+      prev_next[0] = l_prev->v;
+      prev_next[1] = l_next->v;
+    }
+  }
+
+  MEM_freeN(fill);
+
+  return adj;
+}
+
+static const CorrectiveSmoothAdjacency *adjacency_ensure(CorrectiveSmoothModifierData *csmd,
+                                                         Mesh *mesh,
+                                                         const uint verts_num)
+{
+  const CorrectiveSmoothAdjacency *adj = csmd->delta_cache.adjacency;
+
+  if (adj && !((adj->verts_num == verts_num) && (adj->edges_num == (uint)mesh->totedge) &&
+               (adj->loops_num == (uint)mesh->totloop) &&
+               (adj->polys_num == (uint)mesh->totpoly) &&
+               (adj->topology_hash == mesh_topology_hash(mesh)))) {
+    adjacency_free(csmd);
+    adj = NULL;
+  }
+
+  if (adj == NULL) {
+    csmd->delta_cache.adjacency = adjacency_create(mesh, verts_num);
+    adj = csmd->delta_cache.adjacency;
+  }
+
+  return adj;
+}
+
+typedef struct SmoothIterData {
+  const CorrectiveSmoothAdjacency *adj;
+  const float (*vertexCos_src)[3];
+  float (*vertexCos_dst)[3];
+  const float *smooth_weights;
+  /* Simple: weight of the average of each vertex, including lambda.
+   * Length weight: number of neighbors of each vertex. */
+  const float *vertex_edge_count;
+  float lambda;
+} SmoothIterData;
+
 /* -------------------------------------------------------------------- */
 /* Simple Weighted Smoothing
  *
  * (average of surrounding verts)
  */
+static void smooth_iter__simple_cb(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SmoothIterData *data = userdata;
+  const CorrectiveSmoothAdjacency *adj = data->adj;
+  const float *co = data->vertexCos_src[i];
+  float delta[3] = {0.0f, 0.0f, 0.0f};
+  uint j;
+
+  for (j = adj->vert_edges_offset[i]; j < adj->vert_edges_offset[i + 1]; j++) {
+    float edge_dir[3];
+
+    sub_v3_v3v3(edge_dir, data->vertexCos_src[adj->vert_edges_other[j]], co);
+    add_v3_v3(delta, edge_dir);
+  }
+
+  madd_v3_v3v3fl(data->vertexCos_dst[i], co, delta, data->vertex_edge_count[i]);
+}
+
 static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
-                                Mesh *mesh,
+                                const CorrectiveSmoothAdjacency *adj,
                                 float (*vertexCos)[3],
                                 uint numVerts,
                                 const float *smooth_weights,
@@ -183,20 +368,16 @@ static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
   const float lambda = csmd->lambda;
   uint i;
 
-  const uint numEdges = (uint)mesh->totedge;
-  const MEdge *edges = mesh->medge;
   float *vertex_edge_count_div;
+  float(*vertexCos_tmp)[3] = MEM_malloc_arrayN(numVerts, sizeof(*vertexCos_tmp), __func__);
+  float(*vertexCos_src)[3] = vertexCos;
+  float(*vertexCos_dst)[3] = vertexCos_tmp;
 
-  struct SmoothingData_Simple {
-    float delta[3];
-  } *smooth_data = MEM_calloc_arrayN(numVerts, sizeof(*smooth_data), __func__);
-
-  vertex_edge_count_div = MEM_calloc_arrayN(numVerts, sizeof(float), __func__);
+  vertex_edge_count_div = MEM_malloc_arrayN(numVerts, sizeof(float), __func__);
 
   /* calculate as floats to avoid int->float conversion in #smooth_iter */
-  for (i = 0; i < numEdges; i++) {
-    vertex_edge_count_div[edges[i].v1] += 1.0f;
-    vertex_edge_count_div[edges[i].v2] += 1.0f;
+  for (i = 0; i < numVerts; i++) {
+    vertex_edge_count_div[i] = (float)(adj->vert_edges_offset[i + 1] - adj->vert_edges_offset[i]);
   }
 
   /* a little confusing, but we can include 'lambda' and smoothing weight
@@ -220,131 +401,135 @@ static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
   /* Main Smoothing Loop */
 
   while (iterations--) {
-    for (i = 0; i < numEdges; i++) {
-      struct SmoothingData_Simple *sd_v1;
-      struct SmoothingData_Simple *sd_v2;
-      float edge_dir[3];
-
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i].v2], vertexCos[edges[i].v1]);
-
-      sd_v1 = &smooth_data[edges[i].v1];
-      sd_v2 = &smooth_data[edges[i].v2];
-
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
+    SmoothIterData data = {
+        .adj = adj,
+        .vertexCos_src = (const float(*)[3])vertexCos_src,
+        .vertexCos_dst = vertexCos_dst,
+        .vertex_edge_count = vertex_edge_count_div,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (numVerts > 1024);
+    BLI_task_parallel_range(0, (int)numVerts, &data, smooth_iter__simple_cb, &settings);
+
+    /* Result of this iteration is the input of the next one. */
+    {
+      float(*vertexCos_swap)[3] = vertexCos_src;
+      vertexCos_src = vertexCos_dst;
+      vertexCos_dst = vertexCos_swap;
     }
+  }
 
-    for (i = 0; i < numVerts; i++) {
-      struct SmoothingData_Simple *sd = &smooth_data[i];
-      madd_v3_v3fl(vertexCos[i], sd->delta, vertex_edge_count_div[i]);
-      /* zero for the next iteration (saves memset on entire array) */
-      memset(sd, 0, sizeof(*sd));
-    }
+  if (vertexCos_src != vertexCos) {
+    memcpy(vertexCos, vertexCos_src, sizeof(*vertexCos) * numVerts);
   }
 
   MEM_freeN(vertex_edge_count_div);
-  MEM_freeN(smooth_data);
+  MEM_freeN(vertexCos_tmp);
 }
 
 /* -------------------------------------------------------------------- */
 /* Edge-Length Weighted Smoothing
  */
+static void smooth_iter__length_weight_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const float eps = FLT_EPSILON * 10.0f;
+  const SmoothIterData *data = userdata;
+  const CorrectiveSmoothAdjacency *adj = data->adj;
+  const float *co = data->vertexCos_src[i];
+  float delta[3] = {0.0f, 0.0f, 0.0f};
+  float edge_length_sum = 0.0f;
+  float div;
+  uint j;
+
+  for (j = adj->vert_edges_offset[i]; j < adj->vert_edges_offset[i + 1]; j++) {
+    float edge_dir[3];
+    float edge_dist;
+
+    sub_v3_v3v3(edge_dir, data->vertexCos_src[adj->vert_edges_other[j]], co);
+    edge_dist = len_v3(edge_dir);
+
+    /* weight by distance */
+    mul_v3_fl(edge_dir, edge_dist);
+
+    add_v3_v3(delta, edge_dir);
+    edge_length_sum += edge_dist;
+  }
+
+  /* Divide by sum of all neighbor distances (weighted) and amount of neighbors,
+   * (mean average). */
+  div = edge_length_sum * data->vertex_edge_count[i];
+  if (div > eps) {
+    const float lambda_w = data->smooth_weights ? data->lambda * data->smooth_weights[i] :
+                                                  data->lambda;
+    /* first calculate the new location, then interpolate, in one step */
+    madd_v3_v3v3fl(data->vertexCos_dst[i], co, delta, lambda_w / div);
+  }
+  else {
+    copy_v3_v3(data->vertexCos_dst[i], co);
+  }
+}
+
 static void smooth_iter__length_weight(CorrectiveSmoothModifierData *csmd,
-                                       Mesh *mesh,
+                                       const CorrectiveSmoothAdjacency *adj,
                                        float (*vertexCos)[3],
                                        uint numVerts,
                                        const float *smooth_weights,
                                        uint iterations)
 {
-  const float eps = FLT_EPSILON * 10.0f;
-  const uint numEdges = (uint)mesh->totedge;
   /* note: the way this smoothing method works, its approx half as strong as the simple-smooth,
    * and 2.0 rarely spikes, double the value for consistent behavior. */
   const float lambda = csmd->lambda * 2.0f;
-  const MEdge *edges = mesh->medge;
   float *vertex_edge_count;
   uint i;
 
-  struct SmoothingData_Weighted {
-    float delta[3];
-    float edge_length_sum;
-  } *smooth_data = MEM_calloc_arrayN(numVerts, sizeof(*smooth_data), __func__);
+  float(*vertexCos_tmp)[3] = MEM_malloc_arrayN(numVerts, sizeof(*vertexCos_tmp), __func__);
+  float(*vertexCos_src)[3] = vertexCos;
+  float(*vertexCos_dst)[3] = vertexCos_tmp;
 
   /* calculate as floats to avoid int->float conversion in #smooth_iter */
-  vertex_edge_count = MEM_calloc_arrayN(numVerts, sizeof(float), __func__);
-  for (i = 0; i < numEdges; i++) {
-    vertex_edge_count[edges[i].v1] += 1.0f;
-    vertex_edge_count[edges[i].v2] += 1.0f;
+  vertex_edge_count = MEM_malloc_arrayN(numVerts, sizeof(float), __func__);
+  for (i = 0; i < numVerts; i++) {
+    vertex_edge_count[i] = (float)(adj->vert_edges_offset[i + 1] - adj->vert_edges_offset[i]);
   }
 
   /* -------------------------------------------------------------------- */
   /* Main Smoothing Loop */
 
   while (iterations--) {
-    for (i = 0; i < numEdges; i++) {
-      struct SmoothingData_Weighted *sd_v1;
-      struct SmoothingData_Weighted *sd_v2;
-      float edge_dir[3];
-      float edge_dist;
-
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i].v2], vertexCos[edges[i].v1]);
-      edge_dist = len_v3(edge_dir);
-
-      /* weight by distance */
-      mul_v3_fl(edge_dir, edge_dist);
-
-      sd_v1 = &smooth_data[edges[i].v1];
-      sd_v2 = &smooth_data[edges[i].v2];
-
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
-
-      sd_v1->edge_length_sum += edge_dist;
-      sd_v2->edge_length_sum += edge_dist;
+    SmoothIterData data = {
+        .adj = adj,
+        .vertexCos_src = (const float(*)[3])vertexCos_src,
+        .vertexCos_dst = vertexCos_dst,
+        .smooth_weights = smooth_weights,
+        .vertex_edge_count = vertex_edge_count,
+        .lambda = lambda,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (numVerts > 1024);
+    BLI_task_parallel_range(0, (int)numVerts, &data, smooth_iter__length_weight_cb, &settings);
+
+    /* Result of this iteration is the input of the next one. */
+    {
+      float(*vertexCos_swap)[3] = vertexCos_src;
+      vertexCos_src = vertexCos_dst;
+      vertexCos_dst = vertexCos_swap;
     }
+  }
 
-    if (smooth_weights == NULL) {
-      /* fast-path */
-      for (i = 0; i < numVerts; i++) {
-        struct SmoothingData_Weighted *sd = &smooth_data[i];
-        /* Divide by sum of all neighbor distances (weighted) and amount of neighbors,
-         * (mean average). */
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
-        if (div > eps) {
-#if 0
-          /* first calculate the new location */
-          mul_v3_fl(sd->delta, 1.0f / div);
-          /* then interpolate */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda);
-#else
-          /* do this in one step */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda / div);
-#endif
-        }
-        /* zero for the next iteration (saves memset on entire array) */
-        memset(sd, 0, sizeof(*sd));
-      }
-    }
-    else {
-      for (i = 0; i < numVerts; i++) {
-        struct SmoothingData_Weighted *sd = &smooth_data[i];
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
-        if (div > eps) {
-          const float lambda_w = lambda * smooth_weights[i];
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda_w / div);
-        }
-
-        memset(sd, 0, sizeof(*sd));
-      }
-    }
+  if (vertexCos_src != vertexCos) {
+    memcpy(vertexCos, vertexCos_src, sizeof(*vertexCos) * numVerts);
   }
 
   MEM_freeN(vertex_edge_count);
-  MEM_freeN(smooth_data);
+  MEM_freeN(vertexCos_tmp);
 }
 
 static void smooth_iter(CorrectiveSmoothModifierData *csmd,
-                        Mesh *mesh,
+                        const CorrectiveSmoothAdjacency *adj,
                         float (*vertexCos)[3],
                         uint numVerts,
                         const float *smooth_weights,
@@ -352,17 +537,18 @@ static void smooth_iter(CorrectiveSmoothModifierData *csmd,
 {
   switch (csmd->smooth_type) {
     case MOD_CORRECTIVESMOOTH_SMOOTH_LENGTH_WEIGHT:
-      smooth_iter__length_weight(csmd, mesh, vertexCos, numVerts, smooth_weights, iterations);
+      smooth_iter__length_weight(csmd, adj, vertexCos, numVerts, smooth_weights, iterations);
       break;
 
     /* case MOD_CORRECTIVESMOOTH_SMOOTH_SIMPLE: */
     default:
-      smooth_iter__simple(csmd, mesh, vertexCos, numVerts, smooth_weights, iterations);
+      smooth_iter__simple(csmd, adj, vertexCos, numVerts, smooth_weights, iterations);
       break;
   }
 }
 
 static void smooth_verts(CorrectiveSmoothModifierData *csmd,
+                         const CorrectiveSmoothAdjacency *adj,
                          Mesh *mesh,
                          MDeformVert *dvert,
                          const int defgrp_index,
@@ -391,7 +577,7 @@ static void smooth_verts(CorrectiveSmoothModifierData *csmd,
     }
   }
 
-  smooth_iter(csmd, mesh, vertexCos, numVerts, smooth_weights, (uint)csmd->repeat);
+  smooth_iter(csmd, adj, vertexCos, numVerts, smooth_weights, (uint)csmd->repeat);
 
   if (smooth_weights) {
     MEM_freeN(smooth_weights);
@@ -452,54 +638,74 @@ static void calc_tangent_loop_accum(const float v_dir_prev[3],
   }
 }
 
-static void calc_tangent_spaces(Mesh *mesh, float (*vertexCos)[3], float (*r_tangent_spaces)[3][3])
+/**
+ * Orthogonal tangent space of a vertex, from the corners of the polys using it.
+ */
+static void calc_tangent_space(const CorrectiveSmoothAdjacency *adj,
+                               const float (*vertexCos)[3],
+                               const uint v,
+                               float r_tangent_space[3][3])
 {
-  const uint mpoly_num = (uint)mesh->totpoly;
-#ifndef USE_TANGENT_CALC_INLINE
-  const uint mvert_num = (uint)dm->getNumVerts(dm);
-#endif
-  const MPoly *mpoly = mesh->mpoly;
-  const MLoop *mloop = mesh->mloop;
-  uint i;
+  uint j;
 
-  for (i = 0; i < mpoly_num; i++) {
-    const MPoly *mp = &mpoly[i];
-    const MLoop *l_next = &mloop[mp->loopstart];
-    const MLoop *l_term = l_next + mp->totloop;
-    const MLoop *l_prev = l_term - 2;
-    const MLoop *l_curr = l_term - 1;
+  zero_m3(r_tangent_space);
+
+  for (j = adj->vert_loops_offset[v]; j < adj->vert_loops_offset[v + 1]; j++) {
+    const uint *prev_next = adj->vert_loops_prev_next[j];
 
     /* loop directions */
     float v_dir_prev[3], v_dir_next[3];
 
-    /* needed entering the loop */
-    sub_v3_v3v3(v_dir_prev, vertexCos[l_prev->v], vertexCos[l_curr->v]);
+    sub_v3_v3v3(v_dir_prev, vertexCos[prev_next[0]], vertexCos[v]);
     normalize_v3(v_dir_prev);
 
-    for (; l_next != l_term; l_prev = l_curr, l_curr = l_next, l_next++) {
-      float(*ts)[3] = r_tangent_spaces[l_curr->v];
+    sub_v3_v3v3(v_dir_next, vertexCos[v], vertexCos[prev_next[1]]);
+    normalize_v3(v_dir_next);
 
-      /* re-use the previous value */
-#if 0
-      sub_v3_v3v3(v_dir_prev, vertexCos[l_prev->v], vertexCos[l_curr->v]);
-      normalize_v3(v_dir_prev);
-#endif
-      sub_v3_v3v3(v_dir_next, vertexCos[l_curr->v], vertexCos[l_next->v]);
-      normalize_v3(v_dir_next);
+    calc_tangent_loop_accum(v_dir_prev, v_dir_next, r_tangent_space);
+  }
 
-      calc_tangent_loop_accum(v_dir_prev, v_dir_next, ts);
+  calc_tangent_ortho(r_tangent_space);
+}
 
-      copy_v3_v3(v_dir_prev, v_dir_next);
-    }
-  }
+typedef struct CalcDeltasData {
+  const CorrectiveSmoothAdjacency *adj;
+  /* Smoothed positions. */
+  const float (*vertexCos)[3];
+  /* #calc_deltas_cb only. */
+  const float (*rest_coords)[3];
+  float (*deltas)[3];
+  /* #apply_deltas_cb only. */
+  float (*vertexCos_dst)[3];
+} CalcDeltasData;
+
+static void calc_deltas_cb(void *__restrict userdata,
+                           const int i,
+                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CalcDeltasData *data = userdata;
+  float tangent_space[3][3], imat[3][3], delta[3];
+
+  calc_tangent_space(data->adj, data->vertexCos, (uint)i, tangent_space);
 
-  /* do inline */
-#ifndef USE_TANGENT_CALC_INLINE
-  for (i = 0; i < mvert_num; i++) {
-    float(*ts)[3] = r_tangent_spaces[i];
-    calc_tangent_ortho(ts);
+  sub_v3_v3v3(delta, data->rest_coords[i], data->vertexCos[i]);
+  if (UNLIKELY(!invert_m3_m3(imat, tangent_space))) {
+    transpose_m3_m3(imat, tangent_space);
   }
-#endif
+  mul_v3_m3v3(data->deltas[i], imat, delta);
+}
+
+static void apply_deltas_cb(void *__restrict userdata,
+                            const int i,
+                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CalcDeltasData *data = userdata;
+  float tangent_space[3][3], delta[3];
+
+  calc_tangent_space(data->adj, data->vertexCos, (uint)i, tangent_space);
+
+  mul_v3_m3v3(delta, tangent_space, data->deltas[i]);
+  add_v3_v3v3(data->vertexCos_dst[i], data->vertexCos[i], delta);
 }
 
 static void store_cache_settings(CorrectiveSmoothModifierData *csmd)
@@ -524,6 +730,7 @@ static bool cache_settings_equal(CorrectiveSmoothModifierData *csmd)
  * It's not run on every update (during animation for example).
  */
 static void calc_deltas(CorrectiveSmoothModifierData *csmd,
+                        const CorrectiveSmoothAdjacency *adj,
                         Mesh *mesh,
                         MDeformVert *dvert,
                         const int defgrp_index,
@@ -531,10 +738,6 @@ static void calc_deltas(CorrectiveSmoothModifierData *csmd,
                         uint numVerts)
 {
   float(*smooth_vertex_coords)[3] = MEM_dupallocN(rest_coords);
-  float(*tangent_spaces)[3][3];
-  uint i;
-
-  tangent_spaces = MEM_calloc_arrayN(numVerts, sizeof(float[3][3]), __func__);
 
   if (csmd->delta_cache.totverts != numVerts) {
     MEM_SAFE_FREE(csmd->delta_cache.deltas);
@@ -546,25 +749,21 @@ static void calc_deltas(CorrectiveSmoothModifierData *csmd,
     csmd->delta_cache.deltas = MEM_malloc_arrayN(numVerts, sizeof(float[3]), __func__);
   }
 
-  smooth_verts(csmd, mesh, dvert, defgrp_index, smooth_vertex_coords, numVerts);
-
-  calc_tangent_spaces(mesh, smooth_vertex_coords, tangent_spaces);
+  smooth_verts(csmd, adj, mesh, dvert, defgrp_index, smooth_vertex_coords, numVerts);
 
-  for (i = 0; i < numVerts; i++) {
-    float imat[3][3], delta[3];
-
-#ifdef USE_TANGENT_CALC_INLINE
-    calc_tangent_ortho(tangent_spaces[i]);
-#endif
-
-    sub_v3_v3v3(delta, rest_coords[i], smooth_vertex_coords[i]);
-    if (UNLIKELY(!invert_m3_m3(imat, tangent_spaces[i]))) {
-      transpose_m3_m3(imat, tangent_spaces[i]);
-    }
-    mul_v3_m3v3(csmd->delta_cache.deltas[i], imat, delta);
+  {
+    CalcDeltasData data = {
+        .adj = adj,
+        .vertexCos = (const float(*)[3])smooth_vertex_coords,
+        .rest_coords = rest_coords,
+        .deltas = csmd->delta_cache.deltas,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (numVerts > 1024);
+    BLI_task_parallel_range(0, (int)numVerts, &data, calc_deltas_cb, &settings);
   }
 
-  MEM_freeN(tangent_spaces);
   MEM_freeN(smooth_vertex_coords);
 }
 
@@ -585,11 +784,14 @@ static void correctivesmooth_modifier_do(ModifierData *md,
        (((ID *)ob->data)->recalc & ID_RECALC_ALL));
 
   bool use_only_smooth = (csmd->flag & MOD_CORRECTIVESMOOTH_ONLY_SMOOTH) != 0;
+  const CorrectiveSmoothAdjacency *adj;
   MDeformVert *dvert = NULL;
   int defgrp_index;
 
   MOD_get_vgroup(ob, mesh, csmd->defgrp_name, &dvert, &defgrp_index);
 
+  adj = adjacency_ensure(csmd, mesh, numVerts);
+
   /* if rest bind_coords not are defined, set them (only run during bind) */
   if ((csmd->rest_source == MOD_CORRECTIVESMOOTH_RESTSOURCE_BIND) &&
       /* signal to recalculate, whoever sets MUST also free bind coords */
@@ -611,7 +813,7 @@ static void correctivesmooth_modifier_do(ModifierData *md,
   }
 
   if (UNLIKELY(use_only_smooth)) {
-    smooth_verts(csmd, mesh, dvert, defgrp_index, vertexCos, numVerts);
+    smooth_verts(csmd, adj, mesh, dvert, defgrp_index, vertexCos, numVerts);
     return;
   }
 
@@ -670,7 +872,7 @@ static void correctivesmooth_modifier_do(ModifierData *md,
     TIMEIT_START(corrective_smooth_deltas);
 #endif
 
-    calc_deltas(csmd, mesh, dvert, defgrp_index, rest_coords, numVerts);
+    calc_deltas(csmd, adj, mesh, dvert, defgrp_index, rest_coords, numVerts);
 
 #ifdef DEBUG_TIME
     TIMEIT_END(corrective_smooth_deltas);
@@ -690,30 +892,25 @@ static void correctivesmooth_modifier_do(ModifierData *md,
 #endif
 
   /* do the actual delta mush */
-  smooth_verts(csmd, mesh, dvert, defgrp_index, vertexCos, numVerts);
-
   {
-    uint i;
-
-    float(*tangent_spaces)[3][3];
-
-    /* calloc, since values are accumulated */
-    tangent_spaces = MEM_calloc_arrayN(numVerts, sizeof(float[3][3]), __func__);
-
-    calc_tangent_spaces(mesh, vertexCos, tangent_spaces);
-
-    for (i = 0; i < numVerts; i++) {
-      float delta[3];
-
-#ifdef USE_TANGENT_CALC_INLINE
-      calc_tangent_ortho(tangent_spaces[i]);
-#endif
-
-      mul_v3_m3v3(delta, tangent_spaces[i], csmd->delta_cache.deltas[i]);
-      add_v3_v3(vertexCos[i], delta);
-    }
-
-    MEM_freeN(tangent_spaces);
+    /* Tangent spaces are computed from the smoothed positions of the neighbors,
+     * so the result can't be written in place. */
+    float(*smooth_vertex_coords)[3] = MEM_dupallocN(vertexCos);
+
+    smooth_verts(csmd, adj, mesh, dvert, defgrp_index, smooth_vertex_coords, numVerts);
+
+    CalcDeltasData data = {
+        .adj = adj,
+        .vertexCos = (const float(*)[3])smooth_vertex_coords,
+        .deltas = csmd->delta_cache.deltas,
+        .vertexCos_dst = vertexCos,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (numVerts > 1024);
+    BLI_task_parallel_range(0, (int)numVerts, &data, apply_deltas_cb, &settings);
+
+    MEM_freeN(smooth_vertex_coords);
   }
 
 #ifdef DEBUG_TIME
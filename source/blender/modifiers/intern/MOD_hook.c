@@ -24,6 +24,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -211,7 +212,10 @@ static float hook_falloff(const struct HookData_cb *hd, const float len_sq)
   }
 }
 
-static void hook_co_apply(struct HookData_cb *hd, const int j)
+/**
+ * \param weight: Vertex group weight of the vertex, already looked up by the caller.
+ */
+static void hook_co_apply_weight(const struct HookData_cb *hd, const int j, const float weight)
 {
   float *co = hd->vertexCos[j];
   float fac;
@@ -234,15 +238,51 @@ static void hook_co_apply(struct HookData_cb *hd, const int j)
     fac = hd->fac_orig;
   }
 
+  fac *= weight;
+
   if (fac) {
-    if (hd->dvert) {
-      fac *= defvert_find_weight(&hd->dvert[j], hd->defgrp_index);
-    }
+    float co_tmp[3];
+    mul_v3_m4v3(co_tmp, hd->mat, co);
+    interp_v3_v3v3(co, co, co_tmp, fac);
+  }
+}
+
+static void hook_co_apply(const struct HookData_cb *hd, const int j)
+{
+  const float weight = hd->dvert ? defvert_find_weight(&hd->dvert[j], hd->defgrp_index) : 1.0f;
+
+  if (weight != 0.0f) {
+    hook_co_apply_weight(hd, j, weight);
+  }
+}
+
+static void hook_co_apply_vgroup(void *__restrict userdata,
+                                 const int j,
+                                 float UNUSED(co[3]),
+                                 const float weight)
+{
+  hook_co_apply_weight(userdata, j, weight);
+}
+
+typedef struct HookOrigIndexUserdata {
+  const struct HookData_cb *hd;
+  const int *origindex_ar;
+  /* Number of times each original index is in the hook indices. */
+  const int *index_counts;
+  int numVerts;
+} HookOrigIndexUserdata;
+
+static void hook_co_apply_origindex_task(void *__restrict userdata,
+                                         const int j,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const HookOrigIndexUserdata *data = userdata;
+  const int index = data->origindex_ar[j];
 
-    if (fac) {
-      float co_tmp[3];
-      mul_v3_m4v3(co_tmp, hd->mat, co);
-      interp_v3_v3v3(co, co, co_tmp, fac);
+  if (index >= 0 && index < data->numVerts) {
+    /* Duplicate indices apply the hook again, like looping over the indices does. */
+    for (int count = data->index_counts[index]; count > 0; count--) {
+      hook_co_apply(data->hd, j);
     }
   }
 }
@@ -321,17 +361,28 @@ static void deformVerts_do(HookModifierData *hmd,
 
     /* if mesh is present and has original index data, use it */
     if (mesh && (origindex_ar = CustomData_get_layer(&mesh->vdata, CD_ORIGINDEX))) {
-      for (i = 0, index_pt = hmd->indexar; i < hmd->totindex; i++, index_pt++) {
-        if (*index_pt < numVerts) {
-          int j;
+      /* Count hooked indices per vertex, instead of searching all vertices for each. */
+      int *index_counts = MEM_calloc_arrayN((size_t)numVerts, sizeof(int), __func__);
 
-          for (j = 0; j < numVerts; j++) {
-            if (origindex_ar[j] == *index_pt) {
-              hook_co_apply(&hd, j);
-            }
-          }
+      for (i = 0, index_pt = hmd->indexar; i < hmd->totindex; i++, index_pt++) {
+        if (*index_pt >= 0 && *index_pt < numVerts) {
+          index_counts[*index_pt]++;
         }
       }
+
+      HookOrigIndexUserdata data = {
+          .hd = &hd,
+          .origindex_ar = origindex_ar,
+          .index_counts = index_counts,
+          .numVerts = numVerts,
+      };
+
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = (numVerts > 512);
+      BLI_task_parallel_range(0, numVerts, &data, hook_co_apply_origindex_task, &settings);
+
+      MEM_freeN(index_counts);
     }
     else { /* missing mesh or ORIGINDEX */
       for (i = 0, index_pt = hmd->indexar; i < hmd->totindex; i++, index_pt++) {
@@ -342,9 +393,8 @@ static void deformVerts_do(HookModifierData *hmd,
     }
   }
   else if (hd.dvert) { /* vertex group hook */
-    for (i = 0; i < numVerts; i++) {
-      hook_co_apply(&hd, i);
-    }
+    MOD_deform_verts_parallel(
+        vertexCos, numVerts, hd.dvert, hd.defgrp_index, false, &hd, hook_co_apply_vgroup);
   }
 }
 
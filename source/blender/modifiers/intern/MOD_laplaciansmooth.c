@@ -24,6 +24,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -169,27 +170,49 @@ static float compute_volume(const float center[3],
   return fabsf(vol);
 }
 
-static void volume_preservation(LaplacianSystem *sys, float vini, float vend, short flag)
-{
+typedef struct LaplacianSolutionData {
+  LaplacianSystem *sys;
+  short flag;
+  float lambda;
+  float lambda_border;
   float beta;
-  int i;
+} LaplacianSolutionData;
 
+static void volume_preservation_cb(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const LaplacianSolutionData *data = userdata;
+  LaplacianSystem *sys = data->sys;
+  const float beta = data->beta;
+
+  if (data->flag & MOD_LAPLACIANSMOOTH_X) {
+    sys->vertexCos[i][0] = (sys->vertexCos[i][0] - sys->vert_centroid[0]) * beta +
+                           sys->vert_centroid[0];
+  }
+  if (data->flag & MOD_LAPLACIANSMOOTH_Y) {
+    sys->vertexCos[i][1] = (sys->vertexCos[i][1] - sys->vert_centroid[1]) * beta +
+                           sys->vert_centroid[1];
+  }
+  if (data->flag & MOD_LAPLACIANSMOOTH_Z) {
+    sys->vertexCos[i][2] = (sys->vertexCos[i][2] - sys->vert_centroid[2]) * beta +
+                           sys->vert_centroid[2];
+  }
+}
+
+static void volume_preservation(LaplacianSystem *sys, float vini, float vend, short flag)
+{
   if (vend != 0.0f) {
-    beta = pow(vini / vend, 1.0f / 3.0f);
-    for (i = 0; i < sys->numVerts; i++) {
-      if (flag & MOD_LAPLACIANSMOOTH_X) {
-        sys->vertexCos[i][0] = (sys->vertexCos[i][0] - sys->vert_centroid[0]) * beta +
-                               sys->vert_centroid[0];
-      }
-      if (flag & MOD_LAPLACIANSMOOTH_Y) {
-        sys->vertexCos[i][1] = (sys->vertexCos[i][1] - sys->vert_centroid[1]) * beta +
-                               sys->vert_centroid[1];
-      }
-      if (flag & MOD_LAPLACIANSMOOTH_Z) {
-        sys->vertexCos[i][2] = (sys->vertexCos[i][2] - sys->vert_centroid[2]) * beta +
-                               sys->vert_centroid[2];
-      }
-    }
+    LaplacianSolutionData data = {
+        .sys = sys,
+        .flag = flag,
+        .beta = pow(vini / vend, 1.0f / 3.0f),
+    };
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (sys->numVerts > 1024);
+    BLI_task_parallel_range(0, sys->numVerts, &data, volume_preservation_cb, &settings);
   }
 }
 
@@ -334,34 +357,55 @@ static void fill_laplacian_matrix(LaplacianSystem *sys)
   }
 }
 
-static void validate_solution(LaplacianSystem *sys, short flag, float lambda, float lambda_border)
+static void validate_solution_cb(void *__restrict userdata,
+                                 const int i,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  int i;
+  const LaplacianSolutionData *data = userdata;
+  LaplacianSystem *sys = data->sys;
+  const short flag = data->flag;
   float lam;
+
+  if (sys->zerola[i] == 0) {
+    lam = sys->numNeEd[i] == sys->numNeFa[i] ? (data->lambda >= 0.0f ? 1.0f : -1.0f) :
+                                               (data->lambda_border >= 0.0f ? 1.0f : -1.0f);
+    if (flag & MOD_LAPLACIANSMOOTH_X) {
+      sys->vertexCos[i][0] += lam * ((float)EIG_linear_solver_variable_get(sys->context, 0, i) -
+                                     sys->vertexCos[i][0]);
+    }
+    if (flag & MOD_LAPLACIANSMOOTH_Y) {
+      sys->vertexCos[i][1] += lam * ((float)EIG_linear_solver_variable_get(sys->context, 1, i) -
+                                     sys->vertexCos[i][1]);
+    }
+    if (flag & MOD_LAPLACIANSMOOTH_Z) {
+      sys->vertexCos[i][2] += lam * ((float)EIG_linear_solver_variable_get(sys->context, 2, i) -
+                                     sys->vertexCos[i][2]);
+    }
+  }
+}
+
+static void validate_solution(LaplacianSystem *sys, short flag, float lambda, float lambda_border)
+{
   float vini = 0.0f, vend = 0.0f;
 
   if (flag & MOD_LAPLACIANSMOOTH_PRESERVE_VOLUME) {
     vini = compute_volume(
         sys->vert_centroid, sys->vertexCos, sys->mpoly, sys->numPolys, sys->mloop);
   }
-  for (i = 0; i < sys->numVerts; i++) {
-    if (sys->zerola[i] == 0) {
-      lam = sys->numNeEd[i] == sys->numNeFa[i] ? (lambda >= 0.0f ? 1.0f : -1.0f) :
-                                                 (lambda_border >= 0.0f ? 1.0f : -1.0f);
-      if (flag & MOD_LAPLACIANSMOOTH_X) {
-        sys->vertexCos[i][0] += lam * ((float)EIG_linear_solver_variable_get(sys->context, 0, i) -
-                                       sys->vertexCos[i][0]);
-      }
-      if (flag & MOD_LAPLACIANSMOOTH_Y) {
-        sys->vertexCos[i][1] += lam * ((float)EIG_linear_solver_variable_get(sys->context, 1, i) -
-                                       sys->vertexCos[i][1]);
-      }
-      if (flag & MOD_LAPLACIANSMOOTH_Z) {
-        sys->vertexCos[i][2] += lam * ((float)EIG_linear_solver_variable_get(sys->context, 2, i) -
-                                       sys->vertexCos[i][2]);
-      }
-    }
-  }
+
+  /* Reading the solution back is independent per vertex. */
+  LaplacianSolutionData data = {
+      .sys = sys,
+      .flag = flag,
+      .lambda = lambda,
+      .lambda_border = lambda_border,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (sys->numVerts > 1024);
+  BLI_task_parallel_range(0, sys->numVerts, &data, validate_solution_cb, &settings);
+
   if (flag & MOD_LAPLACIANSMOOTH_PRESERVE_VOLUME) {
     vend = compute_volume(
         sys->vert_centroid, sys->vertexCos, sys->mpoly, sys->numPolys, sys->mloop);
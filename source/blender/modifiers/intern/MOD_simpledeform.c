@@ -190,6 +190,61 @@ static void simpleDeform_bend(const float factor,
   }
 }
 
+typedef struct SimpleDeformUserdata {
+  void (*deform_callback)(const float factor, const int axis, const float dcut[3], float co[3]);
+  const SpaceTransform *transf;
+  const uint *axis_map;
+  int lock_axis;
+  int limit_axis;
+  int deform_axis;
+  float smd_limit[2];
+  float smd_factor;
+} SimpleDeformUserdata;
+
+static void simple_deform_vert(void *__restrict userdata,
+                               const int UNUSED(index),
+                               float vco[3],
+                               const float weight)
+{
+  const SimpleDeformUserdata *data = userdata;
+  const float base_limit[2] = {0.0f, 0.0f};
+  const int lock_axis = data->lock_axis;
+  float co[3], dcut[3] = {0.0f, 0.0f, 0.0f};
+
+  if (data->transf) {
+    BLI_space_transform_apply(data->transf, vco);
+  }
+
+  copy_v3_v3(co, vco);
+
+  /* Apply axis limits, and axis mappings */
+  if (lock_axis & MOD_SIMPLEDEFORM_LOCK_AXIS_X) {
+    axis_limit(0, base_limit, co, dcut);
+  }
+  if (lock_axis & MOD_SIMPLEDEFORM_LOCK_AXIS_Y) {
+    axis_limit(1, base_limit, co, dcut);
+  }
+  if (lock_axis & MOD_SIMPLEDEFORM_LOCK_AXIS_Z) {
+    axis_limit(2, base_limit, co, dcut);
+  }
+  axis_limit(data->limit_axis, data->smd_limit, co, dcut);
+
+  /* apply the deform to a mapped copy of the vertex, and then re-map it back. */
+  float co_remap[3];
+  float dcut_remap[3];
+  copy_v3_v3_map(co_remap, co, data->axis_map);
+  copy_v3_v3_map(dcut_remap, dcut, data->axis_map);
+  data->deform_callback(data->smd_factor, data->deform_axis, dcut_remap, co_remap);
+  copy_v3_v3_unmap(co, co_remap, data->axis_map);
+
+  /* Use vertex weight has coef of linear interpolation */
+  interp_v3_v3v3(vco, vco, co, weight);
+
+  if (data->transf) {
+    BLI_space_transform_invert(data->transf, vco);
+  }
+}
+
 /* simple deform modifier */
 static void SimpleDeformModifier_do(SimpleDeformModifierData *smd,
                                     const ModifierEvalContext *UNUSED(ctx),
@@ -198,7 +253,6 @@ static void SimpleDeformModifier_do(SimpleDeformModifierData *smd,
                                     float (*vertexCos)[3],
                                     int numVerts)
 {
-  const float base_limit[2] = {0.0f, 0.0f};
   int i;
   float smd_limit[2], smd_factor;
   SpaceTransform *transf = NULL, tmp_transf;
@@ -312,53 +366,29 @@ static void SimpleDeformModifier_do(SimpleDeformModifierData *smd,
 
   MOD_get_vgroup(ob, mesh, smd->vgroup_name, &dvert, &vgroup);
   const bool invert_vgroup = (smd->flag & MOD_SIMPLEDEFORM_FLAG_INVERT_VGROUP) != 0;
-  const uint *axis_map =
-      axis_map_table[(smd->mode != MOD_SIMPLEDEFORM_MODE_BEND) ? deform_axis : 2];
-
-  for (i = 0; i < numVerts; i++) {
-    float weight = defvert_array_find_weight_safe(dvert, i, vgroup);
 
-    if (invert_vgroup) {
-      weight = 1.0f - weight;
-    }
-
-    if (weight != 0.0f) {
-      float co[3], dcut[3] = {0.0f, 0.0f, 0.0f};
-
-      if (transf) {
-        BLI_space_transform_apply(transf, vertexCos[i]);
-      }
-
-      copy_v3_v3(co, vertexCos[i]);
-
-      /* Apply axis limits, and axis mappings */
-      if (lock_axis & MOD_SIMPLEDEFORM_LOCK_AXIS_X) {
-        axis_limit(0, base_limit, co, dcut);
-      }
-      if (lock_axis & MOD_SIMPLEDEFORM_LOCK_AXIS_Y) {
-        axis_limit(1, base_limit, co, dcut);
-      }
-      if (lock_axis & MOD_SIMPLEDEFORM_LOCK_AXIS_Z) {
-        axis_limit(2, base_limit, co, dcut);
-      }
-      axis_limit(limit_axis, smd_limit, co, dcut);
-
-      /* apply the deform to a mapped copy of the vertex, and then re-map it back. */
-      float co_remap[3];
-      float dcut_remap[3];
-      copy_v3_v3_map(co_remap, co, axis_map);
-      copy_v3_v3_map(dcut_remap, dcut, axis_map);
-      simpleDeform_callback(smd_factor, deform_axis, dcut_remap, co_remap); /* apply deform */
-      copy_v3_v3_unmap(co, co_remap, axis_map);
-
-      /* Use vertex weight has coef of linear interpolation */
-      interp_v3_v3v3(vertexCos[i], vertexCos[i], co, weight);
-
-      if (transf) {
-        BLI_space_transform_invert(transf, vertexCos[i]);
-      }
+  if (dvert == NULL) {
+    /* All vertices have the same weight: one without a vertex group,
+     * zero when the vertex group is valid but empty. */
+    const float weight = (vgroup == -1) ? 1.0f : 0.0f;
+    if ((invert_vgroup ? 1.0f - weight : weight) == 0.0f) {
+      return;
     }
   }
+
+  SimpleDeformUserdata data = {
+      .deform_callback = simpleDeform_callback,
+      .transf = transf,
+      .axis_map = axis_map_table[(smd->mode != MOD_SIMPLEDEFORM_MODE_BEND) ? deform_axis : 2],
+      .lock_axis = lock_axis,
+      .limit_axis = limit_axis,
+      .deform_axis = deform_axis,
+      .smd_limit = {smd_limit[0], smd_limit[1]},
+      .smd_factor = smd_factor,
+  };
+
+  MOD_deform_verts_parallel(
+      vertexCos, numVerts, dvert, vgroup, invert_vgroup, &data, simple_deform_vert);
 }
 
 /* SimpleDeform */
@@ -26,6 +26,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -33,6 +34,7 @@
 #include "BKE_editmesh.h"
 #include "BKE_library.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 #include "BKE_particle.h"
 #include "BKE_deform.h"
 
@@ -77,6 +79,71 @@ static void requiredDataMask(Object *UNUSED(ob),
   }
 }
 
+typedef struct SmoothUserdata {
+  float (*vertexCos)[3];
+  float (*accumulated_vecs)[3];
+  uint *num_accumulated_vecs;
+  const MEdge *medges;
+  const MeshElemMap *vert_edges;
+  float fac_new;
+  short flag;
+  bool use_dvert;
+} SmoothUserdata;
+
+/* Gather the edge midpoints around each vertex. Edges are visited in index order,
+ * so the sums are the same as when scattering over all edges. */
+static void smooth_accumulate_task(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SmoothUserdata *data = userdata;
+  const MeshElemMap *map = &data->vert_edges[i];
+  float(*vertexCos)[3] = data->vertexCos;
+  float *accum = data->accumulated_vecs[i];
+
+  zero_v3(accum);
+
+  for (int j = 0; j < map->count; j++) {
+    const MEdge *medge = &data->medges[map->indices[j]];
+    float fvec[3];
+
+    mid_v3_v3v3(fvec, vertexCos[medge->v1], vertexCos[medge->v2]);
+    add_v3_v3(accum, fvec);
+  }
+
+  data->num_accumulated_vecs[i] = (uint)map->count;
+}
+
+static void smooth_vert(void *__restrict userdata,
+                        const int i,
+                        float vco_orig[3],
+                        const float weight)
+{
+  const SmoothUserdata *data = userdata;
+  const short flag = data->flag;
+
+  if (data->num_accumulated_vecs[0] > 0) {
+    mul_v3_fl(data->accumulated_vecs[i], 1.0f / (float)data->num_accumulated_vecs[i]);
+  }
+  const float *vco_new = data->accumulated_vecs[i];
+
+  const float f_new = weight * data->fac_new;
+  if (data->use_dvert && f_new <= 0.0f) {
+    return;
+  }
+  const float f_orig = 1.0f - f_new;
+
+  if (flag & MOD_SMOOTH_X) {
+    vco_orig[0] = f_orig * vco_orig[0] + f_new * vco_new[0];
+  }
+  if (flag & MOD_SMOOTH_Y) {
+    vco_orig[1] = f_orig * vco_orig[1] + f_new * vco_new[1];
+  }
+  if (flag & MOD_SMOOTH_Z) {
+    vco_orig[2] = f_orig * vco_orig[2] + f_new * vco_new[2];
+  }
+}
+
 static void smoothModifier_do(
     SmoothModifierData *smd, Object *ob, Mesh *mesh, float (*vertexCos)[3], int numVerts)
 {
@@ -84,13 +151,13 @@ static void smoothModifier_do(
     return;
   }
 
-  float(*accumulated_vecs)[3] = MEM_calloc_arrayN(
+  float(*accumulated_vecs)[3] = MEM_malloc_arrayN(
       (size_t)numVerts, sizeof(*accumulated_vecs), __func__);
   if (!accumulated_vecs) {
     return;
   }
 
-  uint *num_accumulated_vecs = MEM_calloc_arrayN(
+  uint *num_accumulated_vecs = MEM_malloc_arrayN(
       (size_t)numVerts, sizeof(*num_accumulated_vecs), __func__);
   if (!num_accumulated_vecs) {
     if (accumulated_vecs) {
@@ -99,84 +166,37 @@ static void smoothModifier_do(
     return;
   }
 
-  const float fac_new = smd->fac;
-  const float fac_orig = 1.0f - fac_new;
-
-  MEdge *medges = mesh->medge;
-  const int num_edges = mesh->totedge;
-
   MDeformVert *dvert;
   int defgrp_index;
   MOD_get_vgroup(ob, mesh, smd->defgrp_name, &dvert, &defgrp_index);
 
-  for (int j = 0; j < smd->repeat; j++) {
-    if (j != 0) {
-      memset(accumulated_vecs, 0, sizeof(*accumulated_vecs) * (size_t)numVerts);
-      memset(num_accumulated_vecs, 0, sizeof(*num_accumulated_vecs) * (size_t)numVerts);
-    }
-
-    for (int i = 0; i < num_edges; i++) {
-      float fvec[3];
-      const uint idx1 = medges[i].v1;
-      const uint idx2 = medges[i].v2;
-
-      mid_v3_v3v3(fvec, vertexCos[idx1], vertexCos[idx2]);
-
-      num_accumulated_vecs[idx1]++;
-      add_v3_v3(accumulated_vecs[idx1], fvec);
-
-      num_accumulated_vecs[idx2]++;
-      add_v3_v3(accumulated_vecs[idx2], fvec);
-    }
+  MeshElemMap *vert_edges;
+  int *vert_edges_mem;
+  BKE_mesh_vert_edge_map_create(
+      &vert_edges, &vert_edges_mem, mesh->medge, numVerts, mesh->totedge);
+
+  SmoothUserdata data = {
+      .vertexCos = vertexCos,
+      .accumulated_vecs = accumulated_vecs,
+      .num_accumulated_vecs = num_accumulated_vecs,
+      .medges = mesh->medge,
+      .vert_edges = vert_edges,
+      .fac_new = smd->fac,
+      .flag = smd->flag,
+      .use_dvert = (dvert != NULL),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (numVerts > 512);
 
-    const short flag = smd->flag;
-    if (dvert) {
-      MDeformVert *dv = dvert;
-      for (int i = 0; i < numVerts; i++, dv++) {
-        float *vco_orig = vertexCos[i];
-        if (num_accumulated_vecs[0] > 0) {
-          mul_v3_fl(accumulated_vecs[i], 1.0f / (float)num_accumulated_vecs[i]);
-        }
-        float *vco_new = accumulated_vecs[i];
-
-        const float f_new = defvert_find_weight(dv, defgrp_index) * fac_new;
-        if (f_new <= 0.0f) {
-          continue;
-        }
-        const float f_orig = 1.0f - f_new;
-
-        if (flag & MOD_SMOOTH_X) {
-          vco_orig[0] = f_orig * vco_orig[0] + f_new * vco_new[0];
-        }
-        if (flag & MOD_SMOOTH_Y) {
-          vco_orig[1] = f_orig * vco_orig[1] + f_new * vco_new[1];
-        }
-        if (flag & MOD_SMOOTH_Z) {
-          vco_orig[2] = f_orig * vco_orig[2] + f_new * vco_new[2];
-        }
-      }
-    }
-    else { /* no vertex group */
-      for (int i = 0; i < numVerts; i++) {
-        float *vco_orig = vertexCos[i];
-        if (num_accumulated_vecs[0] > 0) {
-          mul_v3_fl(accumulated_vecs[i], 1.0f / (float)num_accumulated_vecs[i]);
-        }
-        float *vco_new = accumulated_vecs[i];
-
-        if (flag & MOD_SMOOTH_X) {
-          vco_orig[0] = fac_orig * vco_orig[0] + fac_new * vco_new[0];
-        }
-        if (flag & MOD_SMOOTH_Y) {
-          vco_orig[1] = fac_orig * vco_orig[1] + fac_new * vco_new[1];
-        }
-        if (flag & MOD_SMOOTH_Z) {
-          vco_orig[2] = fac_orig * vco_orig[2] + fac_new * vco_new[2];
-        }
-      }
-    }
+  for (int j = 0; j < smd->repeat; j++) {
+    BLI_task_parallel_range(0, numVerts, &data, smooth_accumulate_task, &settings);
+    MOD_deform_verts_parallel(vertexCos, numVerts, dvert, defgrp_index, false, &data, smooth_vert);
   }
 
+  MEM_freeN(vert_edges);
+  MEM_freeN(vert_edges_mem);
   MEM_freeN(accumulated_vecs);
   MEM_freeN(num_accumulated_vecs);
 }
@@ -22,6 +22,7 @@
 
 #include "BLI_bitmap.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines_stack.h"
 
 #include "DNA_mesh_types.h"
@@ -75,6 +76,59 @@ BLI_INLINE bool edgeref_is_init(const EdgeFaceRef *edge_ref)
   return !((edge_ref->p1 == 0) && (edge_ref->p2 == 0));
 }
 
+typedef struct HQNormalEdgeData {
+  const EdgeFaceRef *edge_ref_array;
+  const float (*poly_nors)[3];
+  float (*edge_nors)[3];
+} HQNormalEdgeData;
+
+static void mesh_calc_hq_normal_edge_task(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const HQNormalEdgeData *data = userdata;
+  const EdgeFaceRef *edge_ref = &data->edge_ref_array[i];
+  const float(*poly_nors)[3] = data->poly_nors;
+  float *edge_normal = data->edge_nors[i];
+
+  /* Get the edge vert indices, and edge value (the face indices that use it) */
+
+  if (edgeref_is_init(edge_ref) && (edge_ref->p1 != -1)) {
+    if (edge_ref->p2 != -1) {
+      /* We have 2 faces using this edge, calculate the edges normal
+       * using the angle between the 2 faces as a weighting */
+#if 0
+      add_v3_v3v3(edge_normal, face_nors[edge_ref->f1], face_nors[edge_ref->f2]);
+      normalize_v3_length(
+          edge_normal,
+          angle_normalized_v3v3(face_nors[edge_ref->f1], face_nors[edge_ref->f2]));
+#else
+      mid_v3_v3v3_angle_weighted(edge_normal, poly_nors[edge_ref->p1], poly_nors[edge_ref->p2]);
+#endif
+    }
+    else {
+      /* only one face attached to that edge */
+      /* an edge without another attached- the weight on this is undefined */
+      copy_v3_v3(edge_normal, poly_nors[edge_ref->p1]);
+    }
+  }
+}
+
+typedef struct HQNormalVertData {
+  const MVert *mvert;
+  float (*vert_nors)[3];
+} HQNormalVertData;
+
+static void mesh_calc_hq_normal_vert_task(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const HQNormalVertData *data = userdata;
+  if (normalize_v3(data->vert_nors[i]) == 0.0f) {
+    normal_short_to_float_v3(data->vert_nors[i], data->mvert[i].no);
+  }
+}
+
 /**
  * \param dm: Mesh to calculate normals for.
  * \param poly_nors: Precalculated face normals.
@@ -86,7 +140,7 @@ static void mesh_calc_hq_normal(Mesh *mesh, float (*poly_nors)[3], float (*r_ver
   MPoly *mpoly, *mp;
   MLoop *mloop, *ml;
   MEdge *medge, *ed;
-  MVert *mvert, *mv;
+  MVert *mvert;
 
   numVerts = mesh->totvert;
   numEdges = mesh->totedge;
@@ -104,14 +158,12 @@ static void mesh_calc_hq_normal(Mesh *mesh, float (*poly_nors)[3], float (*r_ver
   cddm->mvert = mv;
 #endif
 
-  mv = mvert;
   mp = mpoly;
 
   {
     EdgeFaceRef *edge_ref_array = MEM_calloc_arrayN(
         (size_t)numEdges, sizeof(EdgeFaceRef), "Edge Connectivity");
     EdgeFaceRef *edge_ref;
-    float edge_normal[3];
 
     /* Add an edge reference if it's not there, pointing back to the face index. */
     for (i = 0; i < numPolys; i++, mp++) {
@@ -140,41 +192,36 @@ static void mesh_calc_hq_normal(Mesh *mesh, float (*poly_nors)[3], float (*r_ver
       }
     }
 
+    HQNormalEdgeData edge_data = {
+        .edge_ref_array = edge_ref_array,
+        .poly_nors = poly_nors,
+        .edge_nors = MEM_malloc_arrayN((size_t)numEdges, sizeof(float[3]), __func__),
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (numEdges > 1024);
+    BLI_task_parallel_range(0, numEdges, &edge_data, mesh_calc_hq_normal_edge_task, &settings);
+
+    /* Accumulate in edge order, the result doesn't depend on threading. */
     for (i = 0, ed = medge, edge_ref = edge_ref_array; i < numEdges; i++, ed++, edge_ref++) {
-      /* Get the edge vert indices, and edge value (the face indices that use it) */
-
       if (edgeref_is_init(edge_ref) && (edge_ref->p1 != -1)) {
-        if (edge_ref->p2 != -1) {
-          /* We have 2 faces using this edge, calculate the edges normal
-           * using the angle between the 2 faces as a weighting */
-#if 0
-          add_v3_v3v3(edge_normal, face_nors[edge_ref->f1], face_nors[edge_ref->f2]);
-          normalize_v3_length(
-              edge_normal,
-              angle_normalized_v3v3(face_nors[edge_ref->f1], face_nors[edge_ref->f2]));
-#else
-          mid_v3_v3v3_angle_weighted(
-              edge_normal, poly_nors[edge_ref->p1], poly_nors[edge_ref->p2]);
-#endif
-        }
-        else {
-          /* only one face attached to that edge */
-          /* an edge without another attached- the weight on this is undefined */
-          copy_v3_v3(edge_normal, poly_nors[edge_ref->p1]);
-        }
-        add_v3_v3(r_vert_nors[ed->v1], edge_normal);
-        add_v3_v3(r_vert_nors[ed->v2], edge_normal);
+        add_v3_v3(r_vert_nors[ed->v1], edge_data.edge_nors[i]);
+        add_v3_v3(r_vert_nors[ed->v2], edge_data.edge_nors[i]);
       }
     }
+    MEM_freeN(edge_data.edge_nors);
     MEM_freeN(edge_ref_array);
   }
 
   /* normalize vertex normals and assign */
-  for (i = 0; i < numVerts; i++, mv++) {
-    if (normalize_v3(r_vert_nors[i]) == 0.0f) {
-      normal_short_to_float_v3(r_vert_nors[i], mv->no);
-    }
-  }
+  HQNormalVertData vert_data = {
+      .mvert = mvert,
+      .vert_nors = r_vert_nors,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (numVerts > 1024);
+  BLI_task_parallel_range(0, numVerts, &vert_data, mesh_calc_hq_normal_vert_task, &settings);
 }
 
 /** \} */
@@ -183,6 +230,367 @@ static void mesh_calc_hq_normal(Mesh *mesh, float (*poly_nors)[3], float (*r_ver
 /** \name Main Solidify Function
  * \{ */
 
+typedef struct SolidifyShellPolyData {
+  const Mesh *mesh;
+  Mesh *result;
+  uint numVerts;
+  uint numEdges;
+  short mat_ofs;
+  short mat_nr_max;
+} SolidifyShellPolyData;
+
+/* Flip the copied faces, each face writes its own loops only. */
+static void solidify_shell_poly_task(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SolidifyShellPolyData *data = userdata;
+  const Mesh *mesh = data->mesh;
+  Mesh *result = data->result;
+  MPoly *mp = result->mpoly + mesh->totpoly + i;
+  const int loop_end = mp->totloop - 1;
+  MLoop *ml2;
+  uint e;
+  int j;
+
+  /* reverses the loop direction (MLoop.v as well as custom-data)
+   * MLoop.e also needs to be corrected too, done in a separate loop below. */
+  ml2 = result->mloop + mp->loopstart + mesh->totloop;
+#if 0
+  for (j = 0; j < mp->totloop; j++) {
+    CustomData_copy_data(&mesh->ldata,
+                         &result->ldata,
+                         mp->loopstart + j,
+                         mp->loopstart + (loop_end - j) + mesh->totloop,
+                         1);
+  }
+#else
+  /* slightly more involved, keep the first vertex the same for the copy,
+   * ensures the diagonals in the new face match the original. */
+  j = 0;
+  for (int j_prev = loop_end; j < mp->totloop; j_prev = j++) {
+    CustomData_copy_data(&mesh->ldata,
+                         &result->ldata,
+                         mp->loopstart + j,
+                         mp->loopstart + (loop_end - j_prev) + mesh->totloop,
+                         1);
+  }
+#endif
+
+  if (data->mat_ofs) {
+    mp->mat_nr += data->mat_ofs;
+    CLAMP(mp->mat_nr, 0, data->mat_nr_max);
+  }
+
+  e = ml2[0].e;
+  for (j = 0; j < loop_end; j++) {
+    ml2[j].e = ml2[j + 1].e;
+  }
+  ml2[loop_end].e = e;
+
+  mp->loopstart += mesh->totloop;
+
+  for (j = 0; j < mp->totloop; j++) {
+    ml2[j].e += data->numEdges;
+    ml2[j].v += data->numVerts;
+  }
+}
+
+typedef struct SolidifyEvenAngleData {
+  const MVert *mvert;
+  const MLoop *mloop;
+  const MPoly *mpoly;
+  const MEdge *orig_medge;
+  const float (*poly_nors)[3];
+  const float (*vert_nors)[3];
+#ifdef USE_NONMANIFOLD_WORKAROUND
+  bool check_non_manifold;
+#endif
+  /* Per loop corner angle and its shell distance weighted angle. */
+  float *loop_angles;
+  float *loop_shell_angles;
+} SolidifyEvenAngleData;
+
+static void solidify_even_angle_poly_task(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SolidifyEvenAngleData *data = userdata;
+  const MVert *mvert = data->mvert;
+  const MPoly *mp = &data->mpoly[i];
+  const MLoop *ml = &data->mloop[mp->loopstart];
+  float *loop_angles = &data->loop_angles[mp->loopstart];
+  float *loop_shell_angles = &data->loop_shell_angles[mp->loopstart];
+
+  /* #BKE_mesh_calc_poly_angles logic is inlined here */
+  float nor_prev[3];
+  float nor_next[3];
+
+  int i_curr = mp->totloop - 1;
+  int i_next = 0;
+
+  sub_v3_v3v3(nor_prev, mvert[ml[i_curr - 1].v].co, mvert[ml[i_curr].v].co);
+  normalize_v3(nor_prev);
+
+  while (i_next < mp->totloop) {
+    float angle;
+    sub_v3_v3v3(nor_next, mvert[ml[i_curr].v].co, mvert[ml[i_next].v].co);
+    normalize_v3(nor_next);
+    angle = angle_normalized_v3v3(nor_prev, nor_next);
+
+    /* --- not related to angle calc --- */
+    if (angle < FLT_EPSILON) {
+      angle = FLT_EPSILON;
+    }
+
+    const uint vidx = ml[i_curr].v;
+    loop_angles[i_curr] = angle;
+
+#ifdef USE_NONMANIFOLD_WORKAROUND
+    /* skip 3+ face user edges */
+    if ((data->check_non_manifold == false) ||
+        LIKELY(((data->orig_medge[ml[i_curr].e].flag & ME_EDGE_TMP_TAG) == 0) &&
+               ((data->orig_medge[ml[i_next].e].flag & ME_EDGE_TMP_TAG) == 0))) {
+      loop_shell_angles[i_curr] = shell_v3v3_normalized_to_dist(data->vert_nors[vidx],
+                                                                data->poly_nors[i]) *
+                                  angle;
+    }
+    else {
+      loop_shell_angles[i_curr] = angle;
+    }
+#else
+    loop_shell_angles[i_curr] = shell_v3v3_normalized_to_dist(data->vert_nors[vidx],
+                                                              data->poly_nors[i]) *
+                                angle;
+#endif
+    /* --- end non-angle-calc section --- */
+
+    /* step */
+    copy_v3_v3(nor_prev, nor_next);
+    i_curr = i_next;
+    i_next++;
+  }
+}
+
+typedef struct SolidifyOffsetData {
+  /* First vertex to offset, see #INIT_VERT_ARRAY_OFFSETS. */
+  MVert *mvert;
+  const uint *new_vert_arr;
+  bool do_shell_align;
+
+  /* No even thickness. */
+  const MDeformVert *dvert;
+  int defgrp_index;
+  bool defgrp_invert;
+  float offset_fac_vg;
+  float offset_fac_vg_inv;
+  float scalar_short;
+  bool do_clamp;
+  bool do_angle_clamp;
+  /* Offsetting the original vertices rather than the new ones. */
+  bool is_orig;
+  float offset;
+  float offset_sq;
+  const float *vert_lens;
+  const float *vert_angs;
+
+  /* Even thickness. */
+  const float (*vert_nors)[3];
+  const float *vert_angles;
+  const float *vert_accum;
+  float ofs;
+} SolidifyOffsetData;
+
+static void solidify_offset_vert_task(void *__restrict userdata,
+                                      const int index,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SolidifyOffsetData *data = userdata;
+  const uint i_orig = (uint)index;
+  const uint i = data->do_shell_align ? i_orig : data->new_vert_arr[i_orig];
+  MVert *mv = &data->mvert[i_orig];
+  const float offset = data->offset;
+  float scalar_short_vgroup = data->scalar_short;
+
+  if (data->dvert) {
+    const MDeformVert *dv = &data->dvert[i];
+    if (data->defgrp_invert) {
+      scalar_short_vgroup = 1.0f - defvert_find_weight(dv, data->defgrp_index);
+    }
+    else {
+      scalar_short_vgroup = defvert_find_weight(dv, data->defgrp_index);
+    }
+    scalar_short_vgroup = (data->offset_fac_vg +
+                           (scalar_short_vgroup * data->offset_fac_vg_inv)) *
+                          data->scalar_short;
+  }
+  if (data->do_clamp && offset > FLT_EPSILON) {
+    if (data->do_angle_clamp) {
+      float cos_ang = data->is_orig ? cosf(data->vert_angs[i_orig] * 0.5f) :
+                                      cosf(((2 * M_PI) - data->vert_angs[i]) * 0.5f);
+      if (cos_ang > 0) {
+        float max_off = sqrtf(data->vert_lens[i]) * 0.5f / cos_ang;
+        if (max_off < offset * 0.5f) {
+          scalar_short_vgroup *= max_off / offset * 2;
+        }
+      }
+    }
+    else {
+      if (data->vert_lens[i] < data->offset_sq) {
+        float scalar = sqrtf(data->vert_lens[i]) / offset;
+        scalar_short_vgroup *= scalar;
+      }
+    }
+  }
+  madd_v3v3short_fl(mv->co, mv->no, scalar_short_vgroup);
+}
+
+static void solidify_even_offset_vert_task(void *__restrict userdata,
+                                           const int index,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SolidifyOffsetData *data = userdata;
+  const uint i_orig = (uint)index;
+  const uint i_other = data->do_shell_align ? i_orig : data->new_vert_arr[i_orig];
+  MVert *mv = &data->mvert[i_orig];
+
+  if (data->vert_accum[i_other]) { /* zero if unselected */
+    madd_v3_v3fl(mv->co,
+                 data->vert_nors[i_other],
+                 data->ofs * (data->vert_angles[i_other] / data->vert_accum[i_other]));
+  }
+}
+
+typedef struct SolidifyRimPolyData {
+  const Mesh *mesh;
+  Mesh *result;
+  const uint *new_edge_arr;
+  const uint *edge_users;
+  const char *edge_order;
+  const uint *old_vert_arr;
+  uint numVerts;
+  uint numEdges;
+  uint numPolys;
+  uint numLoops;
+  uint newEdges;
+  uint stride;
+  bool do_shell;
+  short mat_ofs_rim;
+  short mat_nr_max;
+  uchar crease_outer;
+  uchar crease_inner;
+} SolidifyRimPolyData;
+
+/* Create the rim face of a boundary edge, each face writes its own loops and edges only. */
+static void solidify_rim_poly_task(void *__restrict userdata,
+                                   const int index,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SolidifyRimPolyData *data = userdata;
+  const Mesh *mesh = data->mesh;
+  Mesh *result = data->result;
+  MEdge *medge = result->medge;
+  MPoly *mpoly = result->mpoly;
+  const uint *old_vert_arr = data->old_vert_arr;
+  const uint numVerts = data->numVerts;
+  const uint numEdges = data->numEdges;
+  const uint numPolys = data->numPolys;
+  const uint numLoops = data->numLoops;
+  const uint newEdges = data->newEdges;
+  const uint stride = data->stride;
+  const bool do_shell = data->do_shell;
+  const uint i = (uint)index;
+  MPoly *mp = mpoly + (numPolys * stride) + i;
+  MLoop *ml = result->mloop + (numLoops * stride);
+  uint j = i * 4;
+  uint eidx = data->new_edge_arr[i];
+  uint pidx = data->edge_users[eidx];
+  MEdge *ed;
+  int k1, k2;
+  bool flip;
+
+  if (pidx >= numPolys) {
+    pidx -= numPolys;
+    flip = true;
+  }
+  else {
+    flip = false;
+  }
+
+  ed = medge + eidx;
+
+  /* copy most of the face settings */
+  CustomData_copy_data(
+      &mesh->pdata, &result->pdata, (int)pidx, (int)((numPolys * stride) + i), 1);
+  mp->loopstart = (int)(j + (numLoops * stride));
+  mp->flag = mpoly[pidx].flag;
+
+  /* notice we use 'mp->totloop' which is later overwritten,
+   * we could lookup the original face but there's no point since this is a copy
+   * and will have the same value, just take care when changing order of assignment */
+
+  /* prev loop */
+  k1 = mpoly[pidx].loopstart + (((data->edge_order[eidx] - 1) + mp->totloop) % mp->totloop);
+
+  k2 = mpoly[pidx].loopstart + (data->edge_order[eidx]);
+
+  mp->totloop = 4;
+
+  CustomData_copy_data(&mesh->ldata, &result->ldata, k2, (int)((numLoops * stride) + j + 0), 1);
+  CustomData_copy_data(&mesh->ldata, &result->ldata, k1, (int)((numLoops * stride) + j + 1), 1);
+  CustomData_copy_data(&mesh->ldata, &result->ldata, k1, (int)((numLoops * stride) + j + 2), 1);
+  CustomData_copy_data(&mesh->ldata, &result->ldata, k2, (int)((numLoops * stride) + j + 3), 1);
+
+  if (flip == false) {
+    ml[j].v = ed->v1;
+    ml[j++].e = eidx;
+
+    ml[j].v = ed->v2;
+    ml[j++].e = (numEdges * stride) + old_vert_arr[ed->v2] + newEdges;
+
+    ml[j].v = (do_shell ? ed->v2 : old_vert_arr[ed->v2]) + numVerts;
+    ml[j++].e = (do_shell ? eidx : i) + numEdges;
+
+    ml[j].v = (do_shell ? ed->v1 : old_vert_arr[ed->v1]) + numVerts;
+    ml[j++].e = (numEdges * stride) + old_vert_arr[ed->v1] + newEdges;
+  }
+  else {
+    ml[j].v = ed->v2;
+    ml[j++].e = eidx;
+
+    ml[j].v = ed->v1;
+    ml[j++].e = (numEdges * stride) + old_vert_arr[ed->v1] + newEdges;
+
+    ml[j].v = (do_shell ? ed->v1 : old_vert_arr[ed->v1]) + numVerts;
+    ml[j++].e = (do_shell ? eidx : i) + numEdges;
+
+    ml[j].v = (do_shell ? ed->v2 : old_vert_arr[ed->v2]) + numVerts;
+    ml[j++].e = (numEdges * stride) + old_vert_arr[ed->v2] + newEdges;
+  }
+
+  /* The original index of the rim edges used by the loops above is cleared already,
+   * rim edges are shared between rim faces. */
+
+  /* use the next material index if option enabled */
+  if (data->mat_ofs_rim) {
+    mp->mat_nr += data->mat_ofs_rim;
+    CLAMP(mp->mat_nr, 0, data->mat_nr_max);
+  }
+  if (data->crease_outer) {
+    /* crease += crease_outer; without wrapping */
+    char *cr = &(ed->crease);
+    int tcr = *cr + data->crease_outer;
+    *cr = tcr > 255 ? 255 : tcr;
+  }
+
+  if (data->crease_inner) {
+    /* crease += crease_inner; without wrapping */
+    char *cr = &(medge[numEdges + (do_shell ? eidx : i)].crease);
+    int tcr = *cr + data->crease_inner;
+    *cr = tcr > 255 ? 255 : tcr;
+  }
+}
+
 Mesh *MOD_solidify_extrude_applyModifier(ModifierData *md,
                                          const ModifierEvalContext *ctx,
                                          Mesh *mesh)
@@ -439,55 +847,19 @@ Mesh *MOD_solidify_extrude_applyModifier(ModifierData *md,
   if (do_shell) {
     uint i;
 
-    mp = mpoly + numPolys;
-    for (i = 0; i < mesh->totpoly; i++, mp++) {
-      const int loop_end = mp->totloop - 1;
-      MLoop *ml2;
-      uint e;
-      int j;
-
-      /* reverses the loop direction (MLoop.v as well as custom-data)
-       * MLoop.e also needs to be corrected too, done in a separate loop below. */
-      ml2 = mloop + mp->loopstart + mesh->totloop;
-#if 0
-      for (j = 0; j < mp->totloop; j++) {
-        CustomData_copy_data(&mesh->ldata,
-                             &result->ldata,
-                             mp->loopstart + j,
-                             mp->loopstart + (loop_end - j) + mesh->totloop,
-                             1);
-      }
-#else
-      /* slightly more involved, keep the first vertex the same for the copy,
-       * ensures the diagonals in the new face match the original. */
-      j = 0;
-      for (int j_prev = loop_end; j < mp->totloop; j_prev = j++) {
-        CustomData_copy_data(&mesh->ldata,
-                             &result->ldata,
-                             mp->loopstart + j,
-                             mp->loopstart + (loop_end - j_prev) + mesh->totloop,
-                             1);
-      }
-#endif
-
-      if (mat_ofs) {
-        mp->mat_nr += mat_ofs;
-        CLAMP(mp->mat_nr, 0, mat_nr_max);
-      }
-
-      e = ml2[0].e;
-      for (j = 0; j < loop_end; j++) {
-        ml2[j].e = ml2[j + 1].e;
-      }
-      ml2[loop_end].e = e;
-
-      mp->loopstart += mesh->totloop;
-
-      for (j = 0; j < mp->totloop; j++) {
-        ml2[j].e += numEdges;
-        ml2[j].v += numVerts;
-      }
-    }
+    SolidifyShellPolyData shell_data = {
+        .mesh = mesh,
+        .result = result,
+        .numVerts = numVerts,
+        .numEdges = numEdges,
+        .mat_ofs = mat_ofs,
+        .mat_nr_max = mat_nr_max,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (numPolys > 1024);
+    BLI_task_parallel_range(
+        0, (int)numPolys, &shell_data, solidify_shell_poly_task, &settings);
 
     for (i = 0, ed = medge + numEdges; i < numEdges; i++, ed++) {
       ed->v1 += numVerts;
@@ -498,8 +870,6 @@ Mesh *MOD_solidify_extrude_applyModifier(ModifierData *md,
   /* note, copied vertex layers don't have flipped normals yet. do this after applying offset */
   if ((smd->flag & MOD_SOLIDIFY_EVEN) == 0) {
     /* no even thickness, very simple */
-    float scalar_short;
-    float scalar_short_vgroup;
 
     /* for clamping */
     float *vert_lens = NULL;
@@ -565,97 +935,50 @@ Mesh *MOD_solidify_extrude_applyModifier(ModifierData *md,
       }
     }
 
+    SolidifyOffsetData offset_data = {
+        .new_vert_arr = new_vert_arr,
+        .dvert = dvert,
+        .defgrp_index = defgrp_index,
+        .defgrp_invert = defgrp_invert,
+        .offset_fac_vg = offset_fac_vg,
+        .offset_fac_vg_inv = offset_fac_vg_inv,
+        .do_clamp = do_clamp,
+        .do_angle_clamp = do_angle_clamp,
+        .offset = offset,
+        .offset_sq = offset_sq,
+        .vert_lens = vert_lens,
+        .vert_angs = vert_angs,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+
     if (ofs_new != 0.0f) {
-      uint i_orig, i_end;
+      uint i_end;
       bool do_shell_align;
 
-      scalar_short = scalar_short_vgroup = ofs_new / 32767.0f;
-
       INIT_VERT_ARRAY_OFFSETS(false);
 
-      for (i_orig = 0; i_orig < i_end; i_orig++, mv++) {
-        const uint i = do_shell_align ? i_orig : new_vert_arr[i_orig];
-        if (dvert) {
-          MDeformVert *dv = &dvert[i];
-          if (defgrp_invert) {
-            scalar_short_vgroup = 1.0f - defvert_find_weight(dv, defgrp_index);
-          }
-          else {
-            scalar_short_vgroup = defvert_find_weight(dv, defgrp_index);
-          }
-          scalar_short_vgroup = (offset_fac_vg + (scalar_short_vgroup * offset_fac_vg_inv)) *
-                                scalar_short;
-        }
-        if (do_clamp && offset > FLT_EPSILON) {
-          /* always reset because we may have set before */
-          if (dvert == NULL) {
-            scalar_short_vgroup = scalar_short;
-          }
-          if (do_angle_clamp) {
-            float cos_ang = cosf(((2 * M_PI) - vert_angs[i]) * 0.5f);
-            if (cos_ang > 0) {
-              float max_off = sqrtf(vert_lens[i]) * 0.5f / cos_ang;
-              if (max_off < offset * 0.5f) {
-                scalar_short_vgroup *= max_off / offset * 2;
-              }
-            }
-          }
-          else {
-            if (vert_lens[i] < offset_sq) {
-              float scalar = sqrtf(vert_lens[i]) / offset;
-              scalar_short_vgroup *= scalar;
-            }
-          }
-        }
-        madd_v3v3short_fl(mv->co, mv->no, scalar_short_vgroup);
-      }
+      offset_data.mvert = mv;
+      offset_data.do_shell_align = do_shell_align;
+      offset_data.is_orig = false;
+      offset_data.scalar_short = ofs_new / 32767.0f;
+      settings.use_threading = (i_end > 1024);
+      BLI_task_parallel_range(0, (int)i_end, &offset_data, solidify_offset_vert_task, &settings);
     }
 
     if (ofs_orig != 0.0f) {
-      uint i_orig, i_end;
+      uint i_end;
       bool do_shell_align;
 
-      scalar_short = scalar_short_vgroup = ofs_orig / 32767.0f;
-
       /* as above but swapped */
       INIT_VERT_ARRAY_OFFSETS(true);
 
-      for (i_orig = 0; i_orig < i_end; i_orig++, mv++) {
-        const uint i = do_shell_align ? i_orig : new_vert_arr[i_orig];
-        if (dvert) {
-          MDeformVert *dv = &dvert[i];
-          if (defgrp_invert) {
-            scalar_short_vgroup = 1.0f - defvert_find_weight(dv, defgrp_index);
-          }
-          else {
-            scalar_short_vgroup = defvert_find_weight(dv, defgrp_index);
-          }
-          scalar_short_vgroup = (offset_fac_vg + (scalar_short_vgroup * offset_fac_vg_inv)) *
-                                scalar_short;
-        }
-        if (do_clamp && offset > FLT_EPSILON) {
-          /* always reset because we may have set before */
-          if (dvert == NULL) {
-            scalar_short_vgroup = scalar_short;
-          }
-          if (do_angle_clamp) {
-            float cos_ang = cosf(vert_angs[i_orig] * 0.5f);
-            if (cos_ang > 0) {
-              float max_off = sqrtf(vert_lens[i]) * 0.5f / cos_ang;
-              if (max_off < offset * 0.5f) {
-                scalar_short_vgroup *= max_off / offset * 2;
-              }
-            }
-          }
-          else {
-            if (vert_lens[i] < offset_sq) {
-              float scalar = sqrtf(vert_lens[i]) / offset;
-              scalar_short_vgroup *= scalar;
-            }
-          }
-        }
-        madd_v3v3short_fl(mv->co, mv->no, scalar_short_vgroup);
-      }
+      offset_data.mvert = mv;
+      offset_data.do_shell_align = do_shell_align;
+      offset_data.is_orig = true;
+      offset_data.scalar_short = ofs_orig / 32767.0f;
+      settings.use_threading = (i_end > 1024);
+      BLI_task_parallel_range(0, (int)i_end, &offset_data, solidify_offset_vert_task, &settings);
     }
 
     if (do_clamp) {
@@ -683,55 +1006,47 @@ Mesh *MOD_solidify_extrude_applyModifier(ModifierData *md,
       }
     }
 
-    for (i = 0, mp = mpoly; i < numPolys; i++, mp++) {
-      /* #BKE_mesh_calc_poly_angles logic is inlined here */
-      float nor_prev[3];
-      float nor_next[3];
+    /* Angles are calculated per loop in parallel,
+     * then accumulated in the same order as before so the result doesn't depend on threading. */
+    SolidifyEvenAngleData angle_data = {
+        .mvert = mvert,
+        .mloop = mloop,
+        .mpoly = mpoly,
+        .orig_medge = orig_medge,
+        .poly_nors = poly_nors,
+        .vert_nors = vert_nors,
+#ifdef USE_NONMANIFOLD_WORKAROUND
+        .check_non_manifold = check_non_manifold,
+#endif
+        .loop_angles = MEM_malloc_arrayN(numLoops, 2 * sizeof(float), __func__), /* 2 in 1 */
+    };
+    angle_data.loop_shell_angles = angle_data.loop_angles + numLoops;
+    {
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = (numPolys > 1024);
+      BLI_task_parallel_range(
+          0, (int)numPolys, &angle_data, solidify_even_angle_poly_task, &settings);
+    }
 
+    for (i = 0, mp = mpoly; i < numPolys; i++, mp++) {
       int i_curr = mp->totloop - 1;
       int i_next = 0;
 
       ml = &mloop[mp->loopstart];
 
-      sub_v3_v3v3(nor_prev, mvert[ml[i_curr - 1].v].co, mvert[ml[i_curr].v].co);
-      normalize_v3(nor_prev);
-
       while (i_next < mp->totloop) {
-        float angle;
-        sub_v3_v3v3(nor_next, mvert[ml[i_curr].v].co, mvert[ml[i_next].v].co);
-        normalize_v3(nor_next);
-        angle = angle_normalized_v3v3(nor_prev, nor_next);
-
-        /* --- not related to angle calc --- */
-        if (angle < FLT_EPSILON) {
-          angle = FLT_EPSILON;
-        }
-
+        const uint l_curr = (uint)mp->loopstart + (uint)i_curr;
         vidx = ml[i_curr].v;
-        vert_accum[vidx] += angle;
-
-#ifdef USE_NONMANIFOLD_WORKAROUND
-        /* skip 3+ face user edges */
-        if ((check_non_manifold == false) ||
-            LIKELY(((orig_medge[ml[i_curr].e].flag & ME_EDGE_TMP_TAG) == 0) &&
-                   ((orig_medge[ml[i_next].e].flag & ME_EDGE_TMP_TAG) == 0))) {
-          vert_angles[vidx] += shell_v3v3_normalized_to_dist(vert_nors[vidx], poly_nors[i]) *
-                               angle;
-        }
-        else {
-          vert_angles[vidx] += angle;
-        }
-#else
-        vert_angles[vidx] += shell_v3v3_normalized_to_dist(vert_nors[vidx], poly_nors[i]) * angle;
-#endif
-        /* --- end non-angle-calc section --- */
+        vert_accum[vidx] += angle_data.loop_angles[l_curr];
+        vert_angles[vidx] += angle_data.loop_shell_angles[l_curr];
 
         /* step */
-        copy_v3_v3(nor_prev, nor_next);
         i_curr = i_next;
         i_next++;
       }
     }
+    MEM_freeN(angle_data.loop_angles);
 
     /* vertex group support */
     if (dvert) {
@@ -835,35 +1150,42 @@ Mesh *MOD_solidify_extrude_applyModifier(ModifierData *md,
 #undef INVALID_UNUSED
 #undef INVALID_PAIR
 
+    SolidifyOffsetData offset_data = {
+        .new_vert_arr = new_vert_arr,
+        .vert_nors = vert_nors,
+        .vert_angles = vert_angles,
+        .vert_accum = vert_accum,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+
     if (ofs_new != 0.0f) {
-      uint i_orig, i_end;
+      uint i_end;
       bool do_shell_align;
 
       INIT_VERT_ARRAY_OFFSETS(false);
 
-      for (i_orig = 0; i_orig < i_end; i_orig++, mv++) {
-        const uint i_other = do_shell_align ? i_orig : new_vert_arr[i_orig];
-        if (vert_accum[i_other]) { /* zero if unselected */
-          madd_v3_v3fl(
-              mv->co, vert_nors[i_other], ofs_new * (vert_angles[i_other] / vert_accum[i_other]));
-        }
-      }
+      offset_data.mvert = mv;
+      offset_data.do_shell_align = do_shell_align;
+      offset_data.ofs = ofs_new;
+      settings.use_threading = (i_end > 1024);
+      BLI_task_parallel_range(
+          0, (int)i_end, &offset_data, solidify_even_offset_vert_task, &settings);
     }
 
     if (ofs_orig != 0.0f) {
-      uint i_orig, i_end;
+      uint i_end;
       bool do_shell_align;
 
       /* same as above but swapped, intentional use of 'ofs_new' */
       INIT_VERT_ARRAY_OFFSETS(true);
 
-      for (i_orig = 0; i_orig < i_end; i_orig++, mv++) {
-        const uint i_other = do_shell_align ? i_orig : new_vert_arr[i_orig];
-        if (vert_accum[i_other]) { /* zero if unselected */
-          madd_v3_v3fl(
-              mv->co, vert_nors[i_other], ofs_orig * (vert_angles[i_other] / vert_accum[i_other]));
-        }
-      }
+      offset_data.mvert = mv;
+      offset_data.do_shell_align = do_shell_align;
+      offset_data.ofs = ofs_orig;
+      settings.use_threading = (i_end > 1024);
+      BLI_task_parallel_range(
+          0, (int)i_end, &offset_data, solidify_even_offset_vert_task, &settings);
     }
 
     MEM_freeN(vert_angles);
@@ -916,7 +1238,6 @@ Mesh *MOD_solidify_extrude_applyModifier(ModifierData *md,
 
     int *origindex_edge;
     int *orig_ed;
-    uint j;
 
     if (crease_rim || crease_outer || crease_inner) {
       result->cd_flag |= ME_CDFLAG_EDGE_CREASE;
@@ -942,118 +1263,43 @@ Mesh *MOD_solidify_extrude_applyModifier(ModifierData *md,
     }
 
     /* faces */
-    mp = mpoly + (numPolys * stride);
-    ml = mloop + (numLoops * stride);
-    j = 0;
-    for (i = 0; i < newPolys; i++, mp++) {
-      uint eidx = new_edge_arr[i];
-      uint pidx = edge_users[eidx];
-      int k1, k2;
-      bool flip;
-
-      if (pidx >= numPolys) {
-        pidx -= numPolys;
-        flip = true;
-      }
-      else {
-        flip = false;
-      }
-
-      ed = medge + eidx;
-
-      /* copy most of the face settings */
-      CustomData_copy_data(
-          &mesh->pdata, &result->pdata, (int)pidx, (int)((numPolys * stride) + i), 1);
-      mp->loopstart = (int)(j + (numLoops * stride));
-      mp->flag = mpoly[pidx].flag;
-
-      /* notice we use 'mp->totloop' which is later overwritten,
-       * we could lookup the original face but there's no point since this is a copy
-       * and will have the same value, just take care when changing order of assignment */
-
-      /* prev loop */
-      k1 = mpoly[pidx].loopstart + (((edge_order[eidx] - 1) + mp->totloop) % mp->totloop);
-
-      k2 = mpoly[pidx].loopstart + (edge_order[eidx]);
-
-      mp->totloop = 4;
-
-      CustomData_copy_data(
-          &mesh->ldata, &result->ldata, k2, (int)((numLoops * stride) + j + 0), 1);
-      CustomData_copy_data(
-          &mesh->ldata, &result->ldata, k1, (int)((numLoops * stride) + j + 1), 1);
-      CustomData_copy_data(
-          &mesh->ldata, &result->ldata, k1, (int)((numLoops * stride) + j + 2), 1);
-      CustomData_copy_data(
-          &mesh->ldata, &result->ldata, k2, (int)((numLoops * stride) + j + 3), 1);
-
-      if (flip == false) {
-        ml[j].v = ed->v1;
-        ml[j++].e = eidx;
-
-        ml[j].v = ed->v2;
-        ml[j++].e = (numEdges * stride) + old_vert_arr[ed->v2] + newEdges;
-
-        ml[j].v = (do_shell ? ed->v2 : old_vert_arr[ed->v2]) + numVerts;
-        ml[j++].e = (do_shell ? eidx : i) + numEdges;
-
-        ml[j].v = (do_shell ? ed->v1 : old_vert_arr[ed->v1]) + numVerts;
-        ml[j++].e = (numEdges * stride) + old_vert_arr[ed->v1] + newEdges;
-      }
-      else {
-        ml[j].v = ed->v2;
-        ml[j++].e = eidx;
-
-        ml[j].v = ed->v1;
-        ml[j++].e = (numEdges * stride) + old_vert_arr[ed->v1] + newEdges;
-
-        ml[j].v = (do_shell ? ed->v1 : old_vert_arr[ed->v1]) + numVerts;
-        ml[j++].e = (do_shell ? eidx : i) + numEdges;
-
-        ml[j].v = (do_shell ? ed->v2 : old_vert_arr[ed->v2]) + numVerts;
-        ml[j++].e = (numEdges * stride) + old_vert_arr[ed->v2] + newEdges;
-      }
-
-      if (origindex_edge) {
-        origindex_edge[ml[j - 3].e] = ORIGINDEX_NONE;
-        origindex_edge[ml[j - 1].e] = ORIGINDEX_NONE;
-      }
-
-      /* use the next material index if option enabled */
-      if (mat_ofs_rim) {
-        mp->mat_nr += mat_ofs_rim;
-        CLAMP(mp->mat_nr, 0, mat_nr_max);
-      }
-      if (crease_outer) {
-        /* crease += crease_outer; without wrapping */
-        char *cr = &(ed->crease);
-        int tcr = *cr + crease_outer;
-        *cr = tcr > 255 ? 255 : tcr;
-      }
-
-      if (crease_inner) {
-        /* crease += crease_inner; without wrapping */
-        char *cr = &(medge[numEdges + (do_shell ? eidx : i)].crease);
-        int tcr = *cr + crease_inner;
-        *cr = tcr > 255 ? 255 : tcr;
-      }
+    SolidifyRimPolyData rim_data = {
+        .mesh = mesh,
+        .result = result,
+        .new_edge_arr = new_edge_arr,
+        .edge_users = edge_users,
+        .edge_order = edge_order,
+        .old_vert_arr = old_vert_arr,
+        .numVerts = numVerts,
+        .numEdges = numEdges,
+        .numPolys = numPolys,
+        .numLoops = numLoops,
+        .newEdges = newEdges,
+        .stride = stride,
+        .do_shell = do_shell,
+        .mat_ofs_rim = mat_ofs_rim,
+        .mat_nr_max = mat_nr_max,
+        .crease_outer = crease_outer,
+        .crease_inner = crease_inner,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (newPolys > 1024);
+    BLI_task_parallel_range(0, (int)newPolys, &rim_data, solidify_rim_poly_task, &settings);
 
 #ifdef SOLIDIFY_SIDE_NORMALS
-      if (do_side_normals) {
-        normal_quad_v3(nor,
-                       mvert[ml[j - 4].v].co,
-                       mvert[ml[j - 3].v].co,
-                       mvert[ml[j - 2].v].co,
-                       mvert[ml[j - 1].v].co);
+    if (do_side_normals) {
+      mp = mpoly + (numPolys * stride);
+      for (i = 0; i < newPolys; i++, mp++) {
+        ed = medge + new_edge_arr[i];
+        ml = mloop + mp->loopstart;
+        normal_quad_v3(
+            nor, mvert[ml[0].v].co, mvert[ml[1].v].co, mvert[ml[2].v].co, mvert[ml[3].v].co);
 
         add_v3_v3(edge_vert_nos[ed->v1], nor);
         add_v3_v3(edge_vert_nos[ed->v2], nor);
       }
-#endif
-    }
 
-#ifdef SOLIDIFY_SIDE_NORMALS
-    if (do_side_normals) {
       const MEdge *ed_orig = medge;
       ed = medge + (numEdges * stride);
       for (i = 0; i < rimVerts; i++, ed++, ed_orig++) {
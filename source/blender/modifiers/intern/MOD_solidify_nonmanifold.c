@@ -21,6 +21,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -78,6 +79,8 @@ static float angle_signed_on_axis_normalized_v3v3_v3(const float n[3],
 
 /* Data structures for manifold solidify. */
 
+#define MOD_SOLIDIFY_EMPTY_TAG ((uint)-1)
+
 typedef struct NewFaceRef {
   MPoly *face;
   uint index;
@@ -132,6 +135,982 @@ static int comp_float_int_pair(const void *a, const void *b)
   return (int)(x->angle > y->angle) - (int)(x->angle < y->angle);
 }
 
+typedef struct EdgeGroupCoordsData {
+  const SolidifyModifierData *smd;
+  MVert *orig_mvert;
+  MEdge *orig_medge;
+  MLoop *orig_mloop;
+  const uint *vm;
+  EdgeGroup **orig_vert_groups_arr;
+  const float *orig_edge_lengths;
+  float (*poly_nors)[3];
+  const bool *null_faces;
+  MDeformVert *dvert;
+  int defgrp_index;
+  bool defgrp_invert;
+  float offset_fac_vg;
+  float offset_fac_vg_inv;
+  float ofs_front;
+  float ofs_back;
+  float offset;
+  bool do_clamp;
+  bool do_angle_clamp;
+} EdgeGroupCoordsData;
+
+/* Calculate the vertex coordinates of the edge groups of a vert,
+ * which only depend on the vert and its own edge groups. */
+static void solidify_edge_group_coords_task(void *__restrict userdata,
+                                            const int index,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const EdgeGroupCoordsData *data = userdata;
+  const uint i = (uint)index;
+  EdgeGroup *g = data->orig_vert_groups_arr[i];
+  if (g == NULL) {
+    return;
+  }
+
+  const SolidifyModifierData *smd = data->smd;
+  MVert *orig_mvert = data->orig_mvert;
+  MEdge *orig_medge = data->orig_medge;
+  MLoop *orig_mloop = data->orig_mloop;
+  const uint *vm = data->vm;
+  const float *orig_edge_lengths = data->orig_edge_lengths;
+  float(*poly_nors)[3] = data->poly_nors;
+  const bool *null_faces = data->null_faces;
+  MDeformVert *dvert = data->dvert;
+  const int defgrp_index = data->defgrp_index;
+  const bool defgrp_invert = data->defgrp_invert;
+  const float offset_fac_vg = data->offset_fac_vg;
+  const float offset_fac_vg_inv = data->offset_fac_vg_inv;
+  const float ofs_front = data->ofs_front;
+  const float ofs_back = data->ofs_back;
+  const float offset = data->offset;
+  const bool do_clamp = data->do_clamp;
+  const bool do_angle_clamp = data->do_angle_clamp;
+  const MVert *mv = &orig_mvert[i];
+  MLoop *ml;
+
+  for (uint j = 0; g->valid; j++, g++) {
+    if (!g->is_singularity) {
+      float *nor = g->no;
+      float move_nor[3] = {0, 0, 0};
+      bool disable_boundary_fix = (smd->nonmanifold_boundary_mode ==
+                                       MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_NONE ||
+                                   (g->is_orig_closed || g->split));
+      /* Constraints Method. */
+      if (smd->nonmanifold_offset_mode == MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_CONSTRAINTS) {
+        NewEdgeRef *first_edge = NULL;
+        NewEdgeRef **edge_ptr = g->edges;
+        /* Contains normal and offset [nx, ny, nz, ofs]. */
+        float(*normals_queue)[4] = MEM_malloc_arrayN(
+            g->edges_len + 1, sizeof(*normals_queue), "normals_queue in solidify");
+        uint queue_index = 0;
+
+        float face_nors[3][3];
+        float nor_ofs[3];
+
+        const bool cycle = (g->is_orig_closed && !g->split) || g->is_even_split;
+        for (uint k = 0; k < g->edges_len; k++, edge_ptr++) {
+          if (!(k & 1) || (!cycle && k == g->edges_len - 1)) {
+            NewEdgeRef *edge = *edge_ptr;
+            for (uint l = 0; l < 2; l++) {
+              NewFaceRef *face = edge->faces[l];
+              if (face && (first_edge == NULL ||
+                           (first_edge->faces[0] != face && first_edge->faces[1] != face))) {
+                if (!null_faces[face->index]) {
+                  mul_v3_v3fl(normals_queue[queue_index],
+                              poly_nors[face->index],
+                              face->reversed ? -1 : 1);
+                  normals_queue[queue_index++][3] = face->reversed ? ofs_back : ofs_front;
+                }
+                else {
+                  mul_v3_v3fl(face_nors[0], poly_nors[face->index], face->reversed ? -1 : 1);
+                  nor_ofs[0] = face->reversed ? ofs_back : ofs_front;
+                }
+              }
+            }
+            if ((cycle && k == 0) || (!cycle && k + 3 >= g->edges_len)) {
+              first_edge = edge;
+            }
+          }
+        }
+        uint face_nors_len = 0;
+        const float stop_explosion = 1 - fabsf(smd->offset_fac) * 0.05f;
+        while (queue_index > 0) {
+          if (face_nors_len == 0) {
+            if (queue_index <= 2) {
+              for (uint k = 0; k < queue_index; k++) {
+                copy_v3_v3(face_nors[k], normals_queue[k]);
+                nor_ofs[k] = normals_queue[k][3];
+              }
+              face_nors_len = queue_index;
+              queue_index = 0;
+            }
+            else {
+              /* Find most different two normals. */
+              float min_p = 2;
+              uint min_n0 = 0;
+              uint min_n1 = 0;
+              for (uint k = 0; k < queue_index; k++) {
+                for (uint m = k + 1; m < queue_index; m++) {
+                  float p = dot_v3v3(normals_queue[k], normals_queue[m]);
+                  if (p <= min_p + FLT_EPSILON) {
+                    min_p = p;
+                    min_n0 = m;
+                    min_n1 = k;
+                  }
+                }
+              }
+              copy_v3_v3(face_nors[0], normals_queue[min_n0]);
+              copy_v3_v3(face_nors[1], normals_queue[min_n1]);
+              nor_ofs[0] = normals_queue[min_n0][3];
+              nor_ofs[1] = normals_queue[min_n1][3];
+              face_nors_len = 2;
+              queue_index--;
+              memmove(normals_queue + min_n0,
+                      normals_queue + min_n0 + 1,
+                      (queue_index - min_n0) * sizeof(*normals_queue));
+              queue_index--;
+              memmove(normals_queue + min_n1,
+                      normals_queue + min_n1 + 1,
+                      (queue_index - min_n1) * sizeof(*normals_queue));
+              min_p = 1;
+              min_n1 = 0;
+              float max_p = -1;
+              for (uint k = 0; k < queue_index; k++) {
+                max_p = -1;
+                for (uint m = 0; m < face_nors_len; m++) {
+                  float p = dot_v3v3(face_nors[m], normals_queue[k]);
+                  if (p > max_p + FLT_EPSILON) {
+                    max_p = p;
+                  }
+                }
+                if (max_p <= min_p + FLT_EPSILON) {
+                  min_p = max_p;
+                  min_n1 = k;
+                }
+              }
+              if (min_p < 0.8) {
+                copy_v3_v3(face_nors[2], normals_queue[min_n1]);
+                nor_ofs[2] = normals_queue[min_n1][3];
+                face_nors_len++;
+                queue_index--;
+                memmove(normals_queue + min_n1,
+                        normals_queue + min_n1 + 1,
+                        (queue_index - min_n1) * sizeof(*normals_queue));
+              }
+            }
+          }
+          else {
+            uint best = 0;
+            uint best_group = 0;
+            float best_p = -1.0f;
+            for (uint k = 0; k < queue_index; k++) {
+              for (uint m = 0; m < face_nors_len; m++) {
+                float p = dot_v3v3(face_nors[m], normals_queue[k]);
+                if (p > best_p + FLT_EPSILON) {
+                  best_p = p;
+                  best = m;
+                  best_group = k;
+                }
+              }
+            }
+            add_v3_v3(face_nors[best], normals_queue[best_group]);
+            normalize_v3(face_nors[best]);
+            nor_ofs[best] = (nor_ofs[best] + normals_queue[best_group][3]) * 0.5f;
+            queue_index--;
+            memmove(normals_queue + best_group,
+                    normals_queue + best_group + 1,
+                    (queue_index - best_group) * sizeof(*normals_queue));
+          }
+        }
+        MEM_freeN(normals_queue);
+        /* When up to 3 constraint normals are found. */
+        float d, q;
+        switch (face_nors_len) {
+          case 0:
+            mul_v3_v3fl(nor, face_nors[0], nor_ofs[0]);
+            disable_boundary_fix = true;
+            break;
+          case 1:
+            mul_v3_v3fl(nor, face_nors[0], nor_ofs[0]);
+            disable_boundary_fix = true;
+            break;
+          case 2:
+            q = dot_v3v3(face_nors[0], face_nors[1]);
+            d = 1.0f - q * q;
+            if (LIKELY(d > FLT_EPSILON) && q < stop_explosion) {
+              d = 1.0f / d;
+              mul_v3_fl(face_nors[0], (nor_ofs[0] - nor_ofs[1] * q) * d);
+              mul_v3_fl(face_nors[1], (nor_ofs[1] - nor_ofs[0] * q) * d);
+              add_v3_v3v3(nor, face_nors[0], face_nors[1]);
+            }
+            else {
+              mul_v3_fl(face_nors[0], nor_ofs[0] * 0.5f);
+              mul_v3_fl(face_nors[1], nor_ofs[1] * 0.5f);
+              add_v3_v3v3(nor, face_nors[0], face_nors[1]);
+            }
+            if (!disable_boundary_fix) {
+              cross_v3_v3v3(move_nor, face_nors[0], face_nors[1]);
+            }
+            break;
+          case 3:
+            q = dot_v3v3(face_nors[0], face_nors[1]);
+            d = 1.0f - q * q;
+            float *free_nor = move_nor; /* No need to allocate a new array. */
+            cross_v3_v3v3(free_nor, face_nors[0], face_nors[1]);
+            if (LIKELY(d > FLT_EPSILON) && q < stop_explosion) {
+              d = 1.0f / d;
+              mul_v3_fl(face_nors[0], (nor_ofs[0] - nor_ofs[1] * q) * d);
+              mul_v3_fl(face_nors[1], (nor_ofs[1] - nor_ofs[0] * q) * d);
+              add_v3_v3v3(nor, face_nors[0], face_nors[1]);
+            }
+            else {
+              mul_v3_fl(face_nors[0], nor_ofs[0] * 0.5f);
+              mul_v3_fl(face_nors[1], nor_ofs[1] * 0.5f);
+              add_v3_v3v3(nor, face_nors[0], face_nors[1]);
+            }
+            mul_v3_fl(face_nors[2], nor_ofs[2]);
+            d = dot_v3v3(face_nors[2], free_nor);
+            if (LIKELY(fabsf(d) > FLT_EPSILON)) {
+              sub_v3_v3v3(face_nors[0], nor, face_nors[2]); /* Override face_nor[0]. */
+              mul_v3_fl(free_nor, dot_v3v3(face_nors[2], face_nors[0]) / d);
+              sub_v3_v3(nor, free_nor);
+            }
+            disable_boundary_fix = true;
+            break;
+          default:
+            BLI_assert(0);
+        }
+      }
+      /* Simple/Even Method. */
+      else {
+        float total_angle = 0;
+        float total_angle_back = 0;
+        NewEdgeRef *first_edge = NULL;
+        NewEdgeRef **edge_ptr = g->edges;
+        float face_nor[3];
+        float nor_back[3] = {0, 0, 0};
+        bool has_back = false;
+        bool has_front = false;
+        bool cycle = (g->is_orig_closed && !g->split) || g->is_even_split;
+        for (uint k = 0; k < g->edges_len; k++, edge_ptr++) {
+          if (!(k & 1) || (!cycle && k == g->edges_len - 1)) {
+            NewEdgeRef *edge = *edge_ptr;
+            for (uint l = 0; l < 2; l++) {
+              NewFaceRef *face = edge->faces[l];
+              if (face && (first_edge == NULL ||
+                           (first_edge->faces[0] != face && first_edge->faces[1] != face))) {
+                float angle = 1.0f;
+                float ofs = face->reversed ? -max_ff(1.0e-5f, ofs_back) :
+                                             max_ff(1.0e-5f, ofs_front);
+                if (smd->nonmanifold_offset_mode == MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_EVEN) {
+                  MLoop *ml_next = orig_mloop + face->face->loopstart;
+                  ml = ml_next + (face->face->totloop - 1);
+                  MLoop *ml_prev = ml - 1;
+                  for (int m = 0; m < face->face->totloop && vm[ml->v] != i;
+                       m++, ml_next++) {
+                    ml_prev = ml;
+                    ml = ml_next;
+                  }
+                  angle = angle_v3v3v3(
+                      orig_mvert[vm[ml_prev->v]].co, mv->co, orig_mvert[vm[ml_next->v]].co);
+                  if (face->reversed) {
+                    total_angle_back += angle * ofs * ofs;
+                  }
+                  else {
+                    total_angle += angle * ofs * ofs;
+                  }
+                }
+                else {
+                  if (face->reversed) {
+                    total_angle_back++;
+                  }
+                  else {
+                    total_angle++;
+                  }
+                }
+                mul_v3_v3fl(face_nor, poly_nors[face->index], angle * ofs);
+                if (face->reversed) {
+                  add_v3_v3(nor_back, face_nor);
+                  has_back = true;
+                }
+                else {
+                  add_v3_v3(nor, face_nor);
+                  has_front = true;
+                }
+              }
+            }
+            if ((cycle && k == 0) || (!cycle && k + 3 >= g->edges_len)) {
+              first_edge = edge;
+            }
+          }
+        }
+
+        /* Set normal length with selected method. */
+        if (smd->nonmanifold_offset_mode == MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_EVEN) {
+          float d = dot_v3v3(nor, nor_back);
+          if (has_front) {
+            float length = len_squared_v3(nor);
+            if (LIKELY(length > FLT_EPSILON)) {
+              mul_v3_fl(nor, total_angle / length);
+            }
+          }
+          if (has_back) {
+            float length = len_squared_v3(nor_back);
+            if (LIKELY(length > FLT_EPSILON)) {
+              mul_v3_fl(nor_back, total_angle_back / length);
+            }
+            if (!has_front) {
+              copy_v3_v3(nor, nor_back);
+            }
+          }
+          if (has_front && has_back) {
+            float nor_length = len_v3(nor);
+            float nor_back_length = len_v3(nor_back);
+            float q = dot_v3v3(nor, nor_back);
+            if (LIKELY(fabsf(q) > FLT_EPSILON)) {
+              q /= nor_length * nor_back_length;
+            }
+            d = 1.0f - q * q;
+            if (LIKELY(d > FLT_EPSILON)) {
+              d = 1.0f / d;
+              if (LIKELY(nor_length > FLT_EPSILON)) {
+                mul_v3_fl(nor, (1 - nor_back_length * q / nor_length) * d);
+              }
+              if (LIKELY(nor_back_length > FLT_EPSILON)) {
+                mul_v3_fl(nor_back, (1 - nor_length * q / nor_back_length) * d);
+              }
+              add_v3_v3(nor, nor_back);
+            }
+            else {
+              mul_v3_fl(nor, 0.5f);
+              mul_v3_fl(nor_back, 0.5f);
+              add_v3_v3(nor, nor_back);
+            }
+          }
+        }
+        else {
+          if (has_front && total_angle > FLT_EPSILON) {
+            mul_v3_fl(nor, 1.0f / total_angle);
+          }
+          if (has_back && total_angle_back > FLT_EPSILON) {
+            mul_v3_fl(nor_back, 1.0f / total_angle_back);
+            add_v3_v3(nor, nor_back);
+          }
+        }
+        /* Set move_nor for boundary fix. */
+        if (!disable_boundary_fix && g->edges_len > 2) {
+          edge_ptr = g->edges + 1;
+          float tmp[3];
+          uint k;
+          for (k = 1; k + 1 < g->edges_len; k++, edge_ptr++) {
+            MEdge *e = orig_medge + (*edge_ptr)->old_edge;
+            sub_v3_v3v3(tmp, orig_mvert[vm[e->v1] == i ? e->v2 : e->v1].co, mv->co);
+            add_v3_v3(move_nor, tmp);
+          }
+          if (k == 1) {
+            disable_boundary_fix = true;
+          }
+          else {
+            disable_boundary_fix = normalize_v3(move_nor) == 0.0f;
+          }
+        }
+        else {
+          disable_boundary_fix = true;
+        }
+      }
+      /* Fix boundary verts. */
+      if (!disable_boundary_fix) {
+        /* Constraint normal, nor * constr_nor == 0 after this fix. */
+        float constr_nor[3];
+        MEdge *e0_edge = orig_medge + g->edges[0]->old_edge;
+        MEdge *e1_edge = orig_medge + g->edges[g->edges_len - 1]->old_edge;
+        float e0[3];
+        float e1[3];
+        sub_v3_v3v3(e0, orig_mvert[vm[e0_edge->v1] == i ? e0_edge->v2 : e0_edge->v1].co, mv->co);
+        sub_v3_v3v3(e1, orig_mvert[vm[e1_edge->v1] == i ? e1_edge->v2 : e1_edge->v1].co, mv->co);
+        if (smd->nonmanifold_boundary_mode == MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_FLAT) {
+          cross_v3_v3v3(constr_nor, e0, e1);
+        }
+        else {
+          float f0[3];
+          float f1[3];
+          if (g->edges[0]->faces[0]->reversed) {
+            negate_v3_v3(f0, poly_nors[g->edges[0]->faces[0]->index]);
+          }
+          else {
+            copy_v3_v3(f0, poly_nors[g->edges[0]->faces[0]->index]);
+          }
+          if (g->edges[g->edges_len - 1]->faces[0]->reversed) {
+            negate_v3_v3(f1, poly_nors[g->edges[g->edges_len - 1]->faces[0]->index]);
+          }
+          else {
+            copy_v3_v3(f1, poly_nors[g->edges[g->edges_len - 1]->faces[0]->index]);
+          }
+          float n0[3];
+          float n1[3];
+          cross_v3_v3v3(n0, e0, f0);
+          cross_v3_v3v3(n1, f1, e1);
+          normalize_v3(n0);
+          normalize_v3(n1);
+          add_v3_v3v3(constr_nor, n0, n1);
+        }
+        float d = dot_v3v3(constr_nor, move_nor);
+        if (LIKELY(fabsf(d) > FLT_EPSILON)) {
+          mul_v3_fl(move_nor, dot_v3v3(constr_nor, nor) / d);
+          sub_v3_v3(nor, move_nor);
+        }
+      }
+      float scalar_vgroup = 1;
+      /* Use vertex group. */
+      if (dvert) {
+        MDeformVert *dv = &dvert[i];
+        if (defgrp_invert) {
+          scalar_vgroup = 1.0f - defvert_find_weight(dv, defgrp_index);
+        }
+        else {
+          scalar_vgroup = defvert_find_weight(dv, defgrp_index);
+        }
+        scalar_vgroup = offset_fac_vg + (scalar_vgroup * offset_fac_vg_inv);
+      }
+      /* Do clamping. */
+      if (do_clamp) {
+        if (do_angle_clamp) {
+          float min_length = 0;
+          float angle = 0.5f * M_PI;
+          uint k = 0;
+          for (NewEdgeRef **p = g->edges; k < g->edges_len; k++, p++) {
+            float length = orig_edge_lengths[(*p)->old_edge];
+            float e_ang = (*p)->angle;
+            if (e_ang > angle) {
+              angle = e_ang;
+            }
+            if (length < min_length || k == 0) {
+              min_length = length;
+            }
+          }
+          float cos_ang = cosf(angle * 0.5f);
+          if (cos_ang > 0) {
+            float max_off = min_length * 0.5f / cos_ang;
+            if (max_off < offset * 0.5f) {
+              scalar_vgroup *= max_off / offset * 2;
+            }
+          }
+        }
+        else {
+          float min_length = 0;
+          uint k = 0;
+          for (NewEdgeRef **p = g->edges; k < g->edges_len; k++, p++) {
+            float length = orig_edge_lengths[(*p)->old_edge];
+            if (length < min_length || k == 0) {
+              min_length = length;
+            }
+          }
+          if (min_length < offset) {
+            scalar_vgroup *= min_length / offset;
+          }
+        }
+      }
+      mul_v3_fl(nor, scalar_vgroup);
+      add_v3_v3v3(g->co, nor, mv->co);
+    }
+    else {
+      copy_v3_v3(g->co, mv->co);
+    }
+  }
+}
+
+typedef struct EdgeFacesSortData {
+  MVert *orig_mvert;
+  MEdge *orig_medge;
+  MPoly *orig_mpoly;
+  const uint *vm;
+  const float *orig_edge_lengths;
+  float (*poly_nors)[3];
+  OldEdgeFaceRef **edge_adj_faces;
+  const uint *edge_adj_faces_len;
+  NewFaceRef *face_sides_arr;
+  const uint *sorted_faces_offsets;
+  FaceKeyPair *sorted_faces_arr;
+} EdgeFacesSortData;
+
+/* Sort the faces of an edge with more than one adjacent face by their angle around it. */
+static void solidify_edge_faces_sort_task(void *__restrict userdata,
+                                          const int index,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const EdgeFacesSortData *data = userdata;
+  const uint i = (uint)index;
+  if (data->edge_adj_faces_len[i] == 0 || data->edge_adj_faces[i]->faces_len < 2) {
+    return;
+  }
+  const MVert *orig_mvert = data->orig_mvert;
+  const MEdge *ed = &data->orig_medge[i];
+  const MPoly *orig_mpoly = data->orig_mpoly;
+  float(*poly_nors)[3] = data->poly_nors;
+  NewFaceRef *face_sides_arr = data->face_sides_arr;
+
+  float edgedir[3];
+  sub_v3_v3v3(edgedir, orig_mvert[data->vm[ed->v2]].co, orig_mvert[data->vm[ed->v1]].co);
+  mul_v3_fl(edgedir, 1.0f / data->orig_edge_lengths[i]);
+
+  const OldEdgeFaceRef *adj_faces = data->edge_adj_faces[i];
+  const uint adj_len = adj_faces->faces_len;
+  const uint *adj_faces_faces = adj_faces->faces;
+  const bool *adj_faces_reversed = adj_faces->faces_reversed;
+  FaceKeyPair *sorted_faces = data->sorted_faces_arr + data->sorted_faces_offsets[i];
+
+  /* Get keys for sorting. */
+  float ref_nor[3] = {0, 0, 0};
+  float nor[3];
+  for (uint j = 0; j < adj_len; j++) {
+    const bool reverse = adj_faces_reversed[j];
+    const uint face_i = adj_faces_faces[j];
+    if (reverse) {
+      negate_v3_v3(nor, poly_nors[face_i]);
+    }
+    else {
+      copy_v3_v3(nor, poly_nors[face_i]);
+    }
+    float d = 1;
+    if (orig_mpoly[face_i].totloop > 3) {
+      d = project_v3_v3(nor, edgedir);
+      if (LIKELY(d != 0)) {
+        d = normalize_v3(nor);
+      }
+      else {
+        d = 1;
+      }
+    }
+    if (UNLIKELY(d == 0.0f)) {
+      sorted_faces[j].angle = 0.0f;
+    }
+    else if (j == 0) {
+      copy_v3_v3(ref_nor, nor);
+      sorted_faces[j].angle = 0.0f;
+    }
+    else {
+      float angle = angle_signed_on_axis_normalized_v3v3_v3(nor, ref_nor, edgedir);
+      sorted_faces[j].angle = -angle;
+    }
+    sorted_faces[j].face = face_sides_arr + adj_faces_faces[j] * 2 +
+                           (adj_faces_reversed[j] ? 1 : 0);
+  }
+  /* Sort faces by order around the edge (keep order in faces,
+   * reversed and face_angles the same). */
+  qsort(sorted_faces, adj_len, sizeof(*sorted_faces), comp_float_int_pair);
+}
+
+typedef struct EdgeGroupsCreateData {
+  OldVertEdgeRef **vert_adj_edges;
+  NewEdgeRef ***orig_edge_data_arr;
+  EdgeGroup **orig_vert_groups_arr;
+  MEdge *orig_medge;
+  const uint *vm;
+} EdgeGroupsCreateData;
+
+/* Create the sorted edge groups of a vert, this only reads the shared #NewEdgeRef data
+ * and writes the groups of the vert itself. */
+static void solidify_edge_groups_create_task(void *__restrict userdata,
+                                             const int index,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const EdgeGroupsCreateData *data = userdata;
+  const uint i = (uint)index;
+  const OldVertEdgeRef *adj_edges_ref = data->vert_adj_edges[i];
+  if (adj_edges_ref == NULL || adj_edges_ref->edges_len < 2) {
+    return;
+  }
+  NewEdgeRef ***orig_edge_data_arr = data->orig_edge_data_arr;
+  const MEdge *orig_medge = data->orig_medge;
+  const uint *vm = data->vm;
+
+  EdgeGroup *edge_groups;
+
+  int eg_index = -1;
+  bool contains_long_groups = false;
+  uint topo_groups = 0;
+
+  /* Initial sorted creation. */
+  {
+    const uint *adj_edges = adj_edges_ref->edges;
+    const uint tot_adj_edges = adj_edges_ref->edges_len;
+
+    uint unassigned_edges_len = 0;
+    for (uint j = 0; j < tot_adj_edges; j++) {
+      NewEdgeRef **new_edges = orig_edge_data_arr[adj_edges[j]];
+      /* TODO check where the null pointer come from,
+       * because there should not be any... */
+      if (new_edges) {
+        while (*new_edges) {
+          unassigned_edges_len++;
+          new_edges++;
+        }
+      }
+    }
+    NewEdgeRef **unassigned_edges = MEM_malloc_arrayN(
+        unassigned_edges_len, sizeof(*unassigned_edges), "unassigned_edges in solidify");
+    for (uint j = 0, k = 0; j < tot_adj_edges; j++) {
+      NewEdgeRef **new_edges = orig_edge_data_arr[adj_edges[j]];
+      if (new_edges) {
+        while (*new_edges) {
+          unassigned_edges[k++] = *new_edges;
+          new_edges++;
+        }
+      }
+    }
+
+    edge_groups = MEM_calloc_arrayN(
+        (unassigned_edges_len / 2) + 1, sizeof(*edge_groups), "edge_groups in solidify");
+
+    uint assigned_edges_len = 0;
+    NewEdgeRef *found_edge = NULL;
+    uint found_edge_index = 0;
+    bool insert_at_start = false;
+    uint eg_capacity = 5;
+    NewFaceRef *eg_track_faces[2] = {NULL, NULL};
+    NewFaceRef *last_open_edge_track = NULL;
+    NewEdgeRef *edge = NULL;
+
+    while (assigned_edges_len < unassigned_edges_len) {
+      found_edge = NULL;
+      insert_at_start = false;
+      if (eg_index >= 0 && edge_groups[eg_index].edges_len == 0) {
+        uint j = 0;
+        edge = NULL;
+        while (!edge && j < unassigned_edges_len) {
+          edge = unassigned_edges[j++];
+          if (edge && last_open_edge_track &&
+              (edge->faces[0] != last_open_edge_track || edge->faces[1] != NULL)) {
+            edge = NULL;
+          }
+        }
+        if (!edge && last_open_edge_track) {
+          topo_groups++;
+          last_open_edge_track = NULL;
+          edge_groups[eg_index].topo_group++;
+          j = 0;
+          while (!edge && j < unassigned_edges_len) {
+            edge = unassigned_edges[j++];
+          }
+        }
+        else if (!last_open_edge_track && eg_index > 0) {
+          topo_groups++;
+          edge_groups[eg_index].topo_group++;
+        }
+        BLI_assert(edge != NULL);
+        found_edge_index = j - 1;
+        found_edge = edge;
+        if (!last_open_edge_track && vm[orig_medge[edge->old_edge].v1] == i) {
+          eg_track_faces[0] = edge->faces[0];
+          eg_track_faces[1] = edge->faces[1];
+          if (edge->faces[1] == NULL) {
+            last_open_edge_track = edge->faces[0]->reversed ? edge->faces[0] - 1 :
+                                                              edge->faces[0] + 1;
+          }
+        }
+        else {
+          eg_track_faces[0] = edge->faces[1];
+          eg_track_faces[1] = edge->faces[0];
+        }
+      }
+      else if (eg_index >= 0) {
+        NewEdgeRef **edge_ptr = unassigned_edges;
+        for (found_edge_index = 0; found_edge_index < unassigned_edges_len;
+             found_edge_index++, edge_ptr++) {
+          if (*edge_ptr) {
+            edge = *edge_ptr;
+            if (edge->faces[0] == eg_track_faces[1]) {
+              insert_at_start = false;
+              eg_track_faces[1] = edge->faces[1];
+              found_edge = edge;
+              if (edge->faces[1] == NULL) {
+                edge_groups[eg_index].is_orig_closed = false;
+                last_open_edge_track = edge->faces[0]->reversed ? edge->faces[0] - 1 :
+                                                                  edge->faces[0] + 1;
+              }
+              break;
+            }
+            else if (edge->faces[0] == eg_track_faces[0]) {
+              insert_at_start = true;
+              eg_track_faces[0] = edge->faces[1];
+              found_edge = edge;
+              if (edge->faces[1] == NULL) {
+                edge_groups[eg_index].is_orig_closed = false;
+              }
+              break;
+            }
+            else if (edge->faces[1] != NULL) {
+              if (edge->faces[1] == eg_track_faces[1]) {
+                insert_at_start = false;
+                eg_track_faces[1] = edge->faces[0];
+                found_edge = edge;
+                break;
+              }
+              else if (edge->faces[1] == eg_track_faces[0]) {
+                insert_at_start = true;
+                eg_track_faces[0] = edge->faces[0];
+                found_edge = edge;
+                break;
+              }
+            }
+          }
+        }
+      }
+      if (found_edge) {
+        unassigned_edges[found_edge_index] = NULL;
+        assigned_edges_len++;
+        const uint needed_capacity = edge_groups[eg_index].edges_len + 1;
+        if (needed_capacity > eg_capacity) {
+          eg_capacity = needed_capacity + 1;
+          NewEdgeRef **new_eg = MEM_calloc_arrayN(
+              eg_capacity, sizeof(*new_eg), "edge_group realloc in solidify");
+          if (insert_at_start) {
+            memcpy(new_eg + 1,
+                   edge_groups[eg_index].edges,
+                   edge_groups[eg_index].edges_len * sizeof(*new_eg));
+          }
+          else {
+            memcpy(new_eg,
+                   edge_groups[eg_index].edges,
+                   edge_groups[eg_index].edges_len * sizeof(*new_eg));
+          }
+          MEM_freeN(edge_groups[eg_index].edges);
+          edge_groups[eg_index].edges = new_eg;
+        }
+        else if (insert_at_start) {
+          memmove(edge_groups[eg_index].edges + 1,
+                  edge_groups[eg_index].edges,
+                  edge_groups[eg_index].edges_len * sizeof(*edge_groups[eg_index].edges));
+        }
+        edge_groups[eg_index].edges[insert_at_start ? 0 : edge_groups[eg_index].edges_len] =
+            found_edge;
+        edge_groups[eg_index].edges_len++;
+        if (edge_groups[eg_index].edges[edge_groups[eg_index].edges_len - 1]->faces[1] != NULL) {
+          last_open_edge_track = NULL;
+        }
+        if (edge_groups[eg_index].edges_len > 3) {
+          contains_long_groups = true;
+        }
+      }
+      else {
+        eg_index++;
+        BLI_assert(eg_index < (unassigned_edges_len / 2));
+        eg_capacity = 5;
+        NewEdgeRef **edges = MEM_calloc_arrayN(
+            eg_capacity, sizeof(*edges), "edge_group in solidify");
+        edge_groups[eg_index] = (EdgeGroup){
+            .valid = true,
+            .edges = edges,
+            .edges_len = 0,
+            .open_face_edge = MOD_SOLIDIFY_EMPTY_TAG,
+            .is_orig_closed = true,
+            .is_even_split = false,
+            .split = 0,
+            .is_singularity = false,
+            .topo_group = topo_groups,
+            .co = {0.0f, 0.0f, 0.0f},
+            .no = {0.0f, 0.0f, 0.0f},
+            .new_vert = MOD_SOLIDIFY_EMPTY_TAG,
+        };
+        eg_track_faces[0] = NULL;
+        eg_track_faces[1] = NULL;
+      }
+    }
+    /* #eg_index is the number of groups from here on. */
+    eg_index++;
+    /* #topo_groups is the number of topo groups from here on. */
+    topo_groups++;
+    MEM_freeN(unassigned_edges);
+  }
+
+  /* Split of long self intersection groups */
+  {
+    uint splits = 0;
+    if (contains_long_groups) {
+      uint add_index = 0;
+      for (uint j = 0; j < eg_index; j++) {
+        const uint edges_len = edge_groups[j + add_index].edges_len;
+        if (edges_len > 3) {
+          bool has_doubles = false;
+          bool *doubles = MEM_calloc_arrayN(edges_len, sizeof(*doubles), "doubles in solidify");
+          EdgeGroup g = edge_groups[j + add_index];
+          for (uint k = 0; k < edges_len; k++) {
+            for (uint l = k + 1; l < edges_len; l++) {
+              if (g.edges[k]->old_edge == g.edges[l]->old_edge) {
+                doubles[k] = true;
+                doubles[l] = true;
+                has_doubles = true;
+              }
+            }
+          }
+          if (has_doubles) {
+            const uint prior_splits = splits;
+            const uint prior_index = add_index;
+            int unique_start = -1;
+            int first_unique_end = -1;
+            int last_split = -1;
+            int first_split = -1;
+            bool first_even_split = false;
+            uint real_k = 0;
+            while (real_k < edges_len ||
+                   (g.is_orig_closed &&
+                    (real_k <=
+                         (first_unique_end == -1 ? 0 : first_unique_end) + (int)edges_len ||
+                     first_split != last_split))) {
+              const uint k = real_k % edges_len;
+              if (!doubles[k]) {
+                if (first_unique_end != -1 && unique_start == -1) {
+                  unique_start = (int)real_k;
+                }
+              }
+              else if (first_unique_end == -1) {
+                first_unique_end = (int)k;
+              }
+              else if (unique_start != -1) {
+                const uint split = (((uint)unique_start + real_k + 1) / 2) % edges_len;
+                const bool is_even_split = (((uint)unique_start + real_k) & 1);
+                if (last_split != -1) {
+                  /* Override g on first split (no insert). */
+                  if (prior_splits != splits) {
+                    memmove(edge_groups + j + add_index + 1,
+                            edge_groups + j + add_index,
+                            ((uint)eg_index - j) * sizeof(*edge_groups));
+                    add_index++;
+                  }
+                  if (last_split > split) {
+                    const uint size = (split + edges_len) - (uint)last_split;
+                    NewEdgeRef **edges = MEM_malloc_arrayN(
+                        size, sizeof(*edges), "edge_group split in solidify");
+                    memcpy(edges,
+                           g.edges + last_split,
+                           (edges_len - (uint)last_split) * sizeof(*edges));
+                    memcpy(edges + (edges_len - (uint)last_split),
+                           g.edges,
+                           split * sizeof(*edges));
+                    edge_groups[j + add_index] = (EdgeGroup){
+                        .valid = true,
+                        .edges = edges,
+                        .edges_len = size,
+                        .open_face_edge = MOD_SOLIDIFY_EMPTY_TAG,
+                        .is_orig_closed = g.is_orig_closed,
+                        .is_even_split = is_even_split,
+                        .split = add_index - prior_index + 1 + (uint)!g.is_orig_closed,
+                        .is_singularity = false,
+                        .topo_group = g.topo_group,
+                        .co = {0.0f, 0.0f, 0.0f},
+                        .no = {0.0f, 0.0f, 0.0f},
+                        .new_vert = MOD_SOLIDIFY_EMPTY_TAG,
+                    };
+                  }
+                  else {
+                    const uint size = split - (uint)last_split;
+                    NewEdgeRef **edges = MEM_malloc_arrayN(
+                        size, sizeof(*edges), "edge_group split in solidify");
+                    memcpy(edges, g.edges + last_split, size * sizeof(*edges));
+                    edge_groups[j + add_index] = (EdgeGroup){
+                        .valid = true,
+                        .edges = edges,
+                        .edges_len = size,
+                        .open_face_edge = MOD_SOLIDIFY_EMPTY_TAG,
+                        .is_orig_closed = g.is_orig_closed,
+                        .is_even_split = is_even_split,
+                        .split = add_index - prior_index + 1 + (uint)!g.is_orig_closed,
+                        .is_singularity = false,
+                        .topo_group = g.topo_group,
+                        .co = {0.0f, 0.0f, 0.0f},
+                        .no = {0.0f, 0.0f, 0.0f},
+                        .new_vert = MOD_SOLIDIFY_EMPTY_TAG,
+                    };
+                  }
+                  splits++;
+                }
+                last_split = (int)split;
+                if (first_split == -1) {
+                  first_split = (int)split;
+                  first_even_split = is_even_split;
+                }
+                unique_start = -1;
+              }
+              real_k++;
+            }
+            if (first_split != -1) {
+              if (!g.is_orig_closed) {
+                if (prior_splits != splits) {
+                  memmove(edge_groups + (j + prior_index + 1),
+                          edge_groups + (j + prior_index),
+                          ((uint)eg_index + add_index - (j + prior_index)) *
+                              sizeof(*edge_groups));
+                  memmove(edge_groups + (j + add_index + 2),
+                          edge_groups + (j + add_index + 1),
+                          ((uint)eg_index - j) * sizeof(*edge_groups));
+                  add_index++;
+                }
+                else {
+                  memmove(edge_groups + (j + add_index + 2),
+                          edge_groups + (j + add_index + 1),
+                          ((uint)eg_index - j - 1) * sizeof(*edge_groups));
+                }
+                NewEdgeRef **edges = MEM_malloc_arrayN(
+                    (uint)first_split, sizeof(*edges), "edge_group split in solidify");
+                memcpy(edges, g.edges, (uint)first_split * sizeof(*edges));
+                edge_groups[j + prior_index] = (EdgeGroup){
+                    .valid = true,
+                    .edges = edges,
+                    .edges_len = (uint)first_split,
+                    .open_face_edge = MOD_SOLIDIFY_EMPTY_TAG,
+                    .is_orig_closed = g.is_orig_closed,
+                    .is_even_split = first_even_split,
+                    .split = 1,
+                    .is_singularity = false,
+                    .topo_group = g.topo_group,
+                    .co = {0.0f, 0.0f, 0.0f},
+                    .no = {0.0f, 0.0f, 0.0f},
+                    .new_vert = MOD_SOLIDIFY_EMPTY_TAG,
+                };
+                add_index++;
+                splits++;
+                edges = MEM_malloc_arrayN(edges_len - (uint)last_split,
+                                          sizeof(*edges),
+                                          "edge_group split in solidify");
+                memcpy(edges,
+                       g.edges + last_split,
+                       (edges_len - (uint)last_split) * sizeof(*edges));
+                edge_groups[j + add_index] = (EdgeGroup){
+                    .valid = true,
+                    .edges = edges,
+                    .edges_len = (edges_len - (uint)last_split),
+                    .open_face_edge = MOD_SOLIDIFY_EMPTY_TAG,
+                    .is_orig_closed = g.is_orig_closed,
+                    .is_even_split = false,
+                    .split = add_index - prior_index + 1,
+                    .is_singularity = false,
+                    .topo_group = g.topo_group,
+                    .co = {0.0f, 0.0f, 0.0f},
+                    .no = {0.0f, 0.0f, 0.0f},
+                    .new_vert = MOD_SOLIDIFY_EMPTY_TAG,
+                };
+              }
+              if (prior_splits != splits) {
+                MEM_freeN(g.edges);
+              }
+            }
+            if (first_unique_end != -1 && prior_splits == splits) {
+              edge_groups[j + add_index].is_singularity = true;
+            }
+          }
+          MEM_freeN(doubles);
+        }
+      }
+    }
+  }
+
+
+  data->orig_vert_groups_arr[i] = edge_groups;
+}
+
 Mesh *MOD_solidify_nonmanifold_applyModifier(ModifierData *md,
                                              const ModifierEvalContext *ctx,
                                              Mesh *mesh)
@@ -139,7 +1118,7 @@ Mesh *MOD_solidify_nonmanifold_applyModifier(ModifierData *md,
   Mesh *result;
   const SolidifyModifierData *smd = (SolidifyModifierData *)md;
 
-  MVert *mv, *mvert, *orig_mvert;
+  MVert *mvert, *orig_mvert;
   MEdge *ed, *medge, *orig_medge;
   MLoop *ml, *mloop, *orig_mloop;
   MPoly *mp, *mpoly, *orig_mpoly;
@@ -189,8 +1168,6 @@ Mesh *MOD_solidify_nonmanifold_applyModifier(ModifierData *md,
   uint numNewLoops = 0;
   uint numNewPolys = 0;
 
-#define MOD_SOLIDIFY_EMPTY_TAG ((uint)-1)
-
   /* Calculate only face normals. */
   poly_nors = MEM_malloc_arrayN(numPolys, sizeof(*poly_nors), __func__);
   BKE_mesh_calc_normals_poly(orig_mvert,
@@ -612,62 +1589,50 @@ Mesh *MOD_solidify_nonmanifold_applyModifier(ModifierData *md,
 
     /* Create #NewEdgeRef array. */
     {
-      ed = orig_medge;
-      for (uint i = 0; i < numEdges; i++, ed++) {
-        const uint v1 = vm[ed->v1];
-        const uint v2 = vm[ed->v2];
+      /* Sort the faces around every edge in parallel, every edge uses its own slice of
+       * #sorted_faces_arr at the prefix sum of the adjacent face counts. */
+      uint *sorted_faces_offsets = MEM_malloc_arrayN(
+          numEdges, sizeof(*sorted_faces_offsets), "sorted_faces_offsets in solidify");
+      uint sorted_faces_len = 0;
+      for (uint i = 0; i < numEdges; i++) {
+        sorted_faces_offsets[i] = sorted_faces_len;
         if (edge_adj_faces_len[i] > 0) {
-          sub_v3_v3v3(edgedir, orig_mvert[v2].co, orig_mvert[v1].co);
-          mul_v3_fl(edgedir, 1.0f / orig_edge_lengths[i]);
+          sorted_faces_len += edge_adj_faces[i]->faces_len;
+        }
+      }
+      FaceKeyPair *sorted_faces_arr = MEM_malloc_arrayN(
+          sorted_faces_len, sizeof(*sorted_faces_arr), "sorted_faces in solidify");
+      {
+        EdgeFacesSortData sort_data = {
+            .orig_mvert = orig_mvert,
+            .orig_medge = orig_medge,
+            .orig_mpoly = orig_mpoly,
+            .vm = vm,
+            .orig_edge_lengths = orig_edge_lengths,
+            .poly_nors = poly_nors,
+            .edge_adj_faces = edge_adj_faces,
+            .edge_adj_faces_len = edge_adj_faces_len,
+            .face_sides_arr = face_sides_arr,
+            .sorted_faces_offsets = sorted_faces_offsets,
+            .sorted_faces_arr = sorted_faces_arr,
+        };
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.use_threading = (numEdges > 1024);
+        BLI_task_parallel_range(
+            0, (int)numEdges, &sort_data, solidify_edge_faces_sort_task, &settings);
+      }
 
+      for (uint i = 0; i < numEdges; i++) {
+        if (edge_adj_faces_len[i] > 0) {
           OldEdgeFaceRef *adj_faces = edge_adj_faces[i];
           const uint adj_len = adj_faces->faces_len;
           const uint *adj_faces_faces = adj_faces->faces;
           const bool *adj_faces_reversed = adj_faces->faces_reversed;
           uint new_edges_len = 0;
-          FaceKeyPair *sorted_faces = MEM_malloc_arrayN(
-              adj_len, sizeof(*sorted_faces), "sorted_faces in solidify");
+          FaceKeyPair *sorted_faces = sorted_faces_arr + sorted_faces_offsets[i];
           if (adj_len > 1) {
             new_edges_len = adj_len;
-            /* Get keys for sorting. */
-            float ref_nor[3] = {0, 0, 0};
-            float nor[3];
-            for (uint j = 0; j < adj_len; j++) {
-              const bool reverse = adj_faces_reversed[j];
-              const uint face_i = adj_faces_faces[j];
-              if (reverse) {
-                negate_v3_v3(nor, poly_nors[face_i]);
-              }
-              else {
-                copy_v3_v3(nor, poly_nors[face_i]);
-              }
-              float d = 1;
-              if (orig_mpoly[face_i].totloop > 3) {
-                d = project_v3_v3(nor, edgedir);
-                if (LIKELY(d != 0)) {
-                  d = normalize_v3(nor);
-                }
-                else {
-                  d = 1;
-                }
-              }
-              if (UNLIKELY(d == 0.0f)) {
-                sorted_faces[j].angle = 0.0f;
-              }
-              else if (j == 0) {
-                copy_v3_v3(ref_nor, nor);
-                sorted_faces[j].angle = 0.0f;
-              }
-              else {
-                float angle = angle_signed_on_axis_normalized_v3v3_v3(nor, ref_nor, edgedir);
-                sorted_faces[j].angle = -angle;
-              }
-              sorted_faces[j].face = face_sides_arr + adj_faces_faces[j] * 2 +
-                                     (adj_faces_reversed[j] ? 1 : 0);
-            }
-            /* Sort faces by order around the edge (keep order in faces,
-             * reversed and face_angles the same). */
-            qsort(sorted_faces, adj_len, sizeof(*sorted_faces), comp_float_int_pair);
           }
           else {
             new_edges_len = 2;
@@ -729,13 +1694,14 @@ Mesh *MOD_solidify_nonmanifold_applyModifier(ModifierData *md,
               }
             }
           }
-          MEM_freeN(sorted_faces);
           orig_edge_data_arr[i] = new_edges;
           if (do_shell || (adj_len == 1 && do_rim)) {
             numNewEdges += new_edges_len;
           }
         }
       }
+      MEM_freeN(sorted_faces_offsets);
+      MEM_freeN(sorted_faces_arr);
     }
 
     for (uint i = 0; i < numEdges; i++) {
@@ -757,456 +1723,85 @@ Mesh *MOD_solidify_nonmanifold_applyModifier(ModifierData *md,
 
   /* Create sorted edge groups for every vert. */
   {
-    OldVertEdgeRef **adj_edges_ptr = vert_adj_edges;
-    for (uint i = 0; i < numVerts; i++, adj_edges_ptr++) {
-      if (*adj_edges_ptr != NULL && (*adj_edges_ptr)->edges_len >= 2) {
-        EdgeGroup *edge_groups;
-
-        int eg_index = -1;
-        bool contains_long_groups = false;
-        uint topo_groups = 0;
-
-        /* Initial sorted creation. */
-        {
-          const uint *adj_edges = (*adj_edges_ptr)->edges;
-          const uint tot_adj_edges = (*adj_edges_ptr)->edges_len;
-
-          uint unassigned_edges_len = 0;
-          for (uint j = 0; j < tot_adj_edges; j++) {
-            NewEdgeRef **new_edges = orig_edge_data_arr[adj_edges[j]];
-            /* TODO check where the null pointer come from,
-             * because there should not be any... */
-            if (new_edges) {
-              while (*new_edges) {
-                unassigned_edges_len++;
-                new_edges++;
-              }
-            }
-          }
-          NewEdgeRef **unassigned_edges = MEM_malloc_arrayN(
-              unassigned_edges_len, sizeof(*unassigned_edges), "unassigned_edges in solidify");
-          for (uint j = 0, k = 0; j < tot_adj_edges; j++) {
-            NewEdgeRef **new_edges = orig_edge_data_arr[adj_edges[j]];
-            if (new_edges) {
-              while (*new_edges) {
-                unassigned_edges[k++] = *new_edges;
-                new_edges++;
-              }
-            }
-          }
+    EdgeGroupsCreateData create_data = {
+        .vert_adj_edges = vert_adj_edges,
+        .orig_edge_data_arr = orig_edge_data_arr,
+        .orig_vert_groups_arr = orig_vert_groups_arr,
+        .orig_medge = orig_medge,
+        .vm = vm,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (numVerts > 1024);
+    BLI_task_parallel_range(
+        0, (int)numVerts, &create_data, solidify_edge_groups_create_task, &settings);
+  }
 
-          edge_groups = MEM_calloc_arrayN(
-              (unassigned_edges_len / 2) + 1, sizeof(*edge_groups), "edge_groups in solidify");
-
-          uint assigned_edges_len = 0;
-          NewEdgeRef *found_edge = NULL;
-          uint found_edge_index = 0;
-          bool insert_at_start = false;
-          uint eg_capacity = 5;
-          NewFaceRef *eg_track_faces[2] = {NULL, NULL};
-          NewFaceRef *last_open_edge_track = NULL;
-          NewEdgeRef *edge = NULL;
-
-          while (assigned_edges_len < unassigned_edges_len) {
-            found_edge = NULL;
-            insert_at_start = false;
-            if (eg_index >= 0 && edge_groups[eg_index].edges_len == 0) {
-              uint j = 0;
-              edge = NULL;
-              while (!edge && j < unassigned_edges_len) {
-                edge = unassigned_edges[j++];
-                if (edge && last_open_edge_track &&
-                    (edge->faces[0] != last_open_edge_track || edge->faces[1] != NULL)) {
-                  edge = NULL;
-                }
-              }
-              if (!edge && last_open_edge_track) {
-                topo_groups++;
-                last_open_edge_track = NULL;
-                edge_groups[eg_index].topo_group++;
-                j = 0;
-                while (!edge && j < unassigned_edges_len) {
-                  edge = unassigned_edges[j++];
-                }
-              }
-              else if (!last_open_edge_track && eg_index > 0) {
-                topo_groups++;
-                edge_groups[eg_index].topo_group++;
-              }
-              BLI_assert(edge != NULL);
-              found_edge_index = j - 1;
-              found_edge = edge;
-              if (!last_open_edge_track && vm[orig_medge[edge->old_edge].v1] == i) {
-                eg_track_faces[0] = edge->faces[0];
-                eg_track_faces[1] = edge->faces[1];
-                if (edge->faces[1] == NULL) {
-                  last_open_edge_track = edge->faces[0]->reversed ? edge->faces[0] - 1 :
-                                                                    edge->faces[0] + 1;
-                }
-              }
-              else {
-                eg_track_faces[0] = edge->faces[1];
-                eg_track_faces[1] = edge->faces[0];
-              }
-            }
-            else if (eg_index >= 0) {
-              NewEdgeRef **edge_ptr = unassigned_edges;
-              for (found_edge_index = 0; found_edge_index < unassigned_edges_len;
-                   found_edge_index++, edge_ptr++) {
-                if (*edge_ptr) {
-                  edge = *edge_ptr;
-                  if (edge->faces[0] == eg_track_faces[1]) {
-                    insert_at_start = false;
-                    eg_track_faces[1] = edge->faces[1];
-                    found_edge = edge;
-                    if (edge->faces[1] == NULL) {
-                      edge_groups[eg_index].is_orig_closed = false;
-                      last_open_edge_track = edge->faces[0]->reversed ? edge->faces[0] - 1 :
-                                                                        edge->faces[0] + 1;
-                    }
-                    break;
-                  }
-                  else if (edge->faces[0] == eg_track_faces[0]) {
-                    insert_at_start = true;
-                    eg_track_faces[0] = edge->faces[1];
-                    found_edge = edge;
-                    if (edge->faces[1] == NULL) {
-                      edge_groups[eg_index].is_orig_closed = false;
-                    }
-                    break;
-                  }
-                  else if (edge->faces[1] != NULL) {
-                    if (edge->faces[1] == eg_track_faces[1]) {
-                      insert_at_start = false;
-                      eg_track_faces[1] = edge->faces[0];
-                      found_edge = edge;
-                      break;
-                    }
-                    else if (edge->faces[1] == eg_track_faces[0]) {
-                      insert_at_start = true;
-                      eg_track_faces[0] = edge->faces[0];
-                      found_edge = edge;
-                      break;
-                    }
-                  }
-                }
-              }
-            }
-            if (found_edge) {
-              unassigned_edges[found_edge_index] = NULL;
-              assigned_edges_len++;
-              const uint needed_capacity = edge_groups[eg_index].edges_len + 1;
-              if (needed_capacity > eg_capacity) {
-                eg_capacity = needed_capacity + 1;
-                NewEdgeRef **new_eg = MEM_calloc_arrayN(
-                    eg_capacity, sizeof(*new_eg), "edge_group realloc in solidify");
-                if (insert_at_start) {
-                  memcpy(new_eg + 1,
-                         edge_groups[eg_index].edges,
-                         edge_groups[eg_index].edges_len * sizeof(*new_eg));
-                }
-                else {
-                  memcpy(new_eg,
-                         edge_groups[eg_index].edges,
-                         edge_groups[eg_index].edges_len * sizeof(*new_eg));
-                }
-                MEM_freeN(edge_groups[eg_index].edges);
-                edge_groups[eg_index].edges = new_eg;
-              }
-              else if (insert_at_start) {
-                memmove(edge_groups[eg_index].edges + 1,
-                        edge_groups[eg_index].edges,
-                        edge_groups[eg_index].edges_len * sizeof(*edge_groups[eg_index].edges));
-              }
-              edge_groups[eg_index].edges[insert_at_start ? 0 : edge_groups[eg_index].edges_len] =
-                  found_edge;
-              edge_groups[eg_index].edges_len++;
-              if (edge_groups[eg_index].edges[edge_groups[eg_index].edges_len - 1]->faces[1] !=
-                  NULL) {
-                last_open_edge_track = NULL;
-              }
-              if (edge_groups[eg_index].edges_len > 3) {
-                contains_long_groups = true;
-              }
-            }
-            else {
-              eg_index++;
-              BLI_assert(eg_index < (unassigned_edges_len / 2));
-              eg_capacity = 5;
-              NewEdgeRef **edges = MEM_calloc_arrayN(
-                  eg_capacity, sizeof(*edges), "edge_group in solidify");
-              edge_groups[eg_index] = (EdgeGroup){
-                  .valid = true,
-                  .edges = edges,
-                  .edges_len = 0,
-                  .open_face_edge = MOD_SOLIDIFY_EMPTY_TAG,
-                  .is_orig_closed = true,
-                  .is_even_split = false,
-                  .split = 0,
-                  .is_singularity = false,
-                  .topo_group = topo_groups,
-                  .co = {0.0f, 0.0f, 0.0f},
-                  .no = {0.0f, 0.0f, 0.0f},
-                  .new_vert = MOD_SOLIDIFY_EMPTY_TAG,
-              };
-              eg_track_faces[0] = NULL;
-              eg_track_faces[1] = NULL;
-            }
-          }
-          /* #eg_index is the number of groups from here on. */
-          eg_index++;
-          /* #topo_groups is the number of topo groups from here on. */
-          topo_groups++;
-          MEM_freeN(unassigned_edges);
+  /* Count new edges, loops, polys and add to link_edge_groups. */
+  for (uint i = 0; i < numVerts; i++) {
+    EdgeGroup *edge_groups = orig_vert_groups_arr[i];
+    if (edge_groups == NULL) {
+      continue;
+    }
+    uint new_verts = 0;
+    bool contains_open_splits = false;
+    uint open_edges = 0;
+    uint contains_splits = 0;
+    uint last_added = 0;
+    uint first_added = 0;
+    bool first_set = false;
+    for (EdgeGroup *g = edge_groups; g->valid; g++) {
+      NewEdgeRef **e = g->edges;
+      for (uint j = 0; j < g->edges_len; j++, e++) {
+        const uint flip = (uint)(vm[orig_medge[(*e)->old_edge].v2] == i);
+        BLI_assert(flip || vm[orig_medge[(*e)->old_edge].v1] == i);
+        (*e)->link_edge_groups[flip] = g;
+      }
+      has_singularities |= g->is_singularity;
+      uint added = 0;
+      if (do_shell || (do_rim && !g->is_orig_closed)) {
+        BLI_assert(g->new_vert == MOD_SOLIDIFY_EMPTY_TAG);
+        g->new_vert = numNewVerts++;
+        if (do_rim || (do_shell && g->split)) {
+          new_verts++;
+          contains_splits += (g->split != 0);
+          contains_open_splits |= g->split && !g->is_orig_closed;
+          added = g->split;
         }
-
-        /* Split of long self intersection groups */
-        {
-          uint splits = 0;
-          if (contains_long_groups) {
-            uint add_index = 0;
-            for (uint j = 0; j < eg_index; j++) {
-              const uint edges_len = edge_groups[j + add_index].edges_len;
-              if (edges_len > 3) {
-                bool has_doubles = false;
-                bool *doubles = MEM_calloc_arrayN(
-                    edges_len, sizeof(*doubles), "doubles in solidify");
-                EdgeGroup g = edge_groups[j + add_index];
-                for (uint k = 0; k < edges_len; k++) {
-                  for (uint l = k + 1; l < edges_len; l++) {
-                    if (g.edges[k]->old_edge == g.edges[l]->old_edge) {
-                      doubles[k] = true;
-                      doubles[l] = true;
-                      has_doubles = true;
-                    }
-                  }
-                }
-                if (has_doubles) {
-                  const uint prior_splits = splits;
-                  const uint prior_index = add_index;
-                  int unique_start = -1;
-                  int first_unique_end = -1;
-                  int last_split = -1;
-                  int first_split = -1;
-                  bool first_even_split = false;
-                  uint real_k = 0;
-                  while (real_k < edges_len ||
-                         (g.is_orig_closed &&
-                          (real_k <=
-                               (first_unique_end == -1 ? 0 : first_unique_end) + (int)edges_len ||
-                           first_split != last_split))) {
-                    const uint k = real_k % edges_len;
-                    if (!doubles[k]) {
-                      if (first_unique_end != -1 && unique_start == -1) {
-                        unique_start = (int)real_k;
-                      }
-                    }
-                    else if (first_unique_end == -1) {
-                      first_unique_end = (int)k;
-                    }
-                    else if (unique_start != -1) {
-                      const uint split = (((uint)unique_start + real_k + 1) / 2) % edges_len;
-                      const bool is_even_split = (((uint)unique_start + real_k) & 1);
-                      if (last_split != -1) {
-                        /* Override g on first split (no insert). */
-                        if (prior_splits != splits) {
-                          memmove(edge_groups + j + add_index + 1,
-                                  edge_groups + j + add_index,
-                                  ((uint)eg_index - j) * sizeof(*edge_groups));
-                          add_index++;
-                        }
-                        if (last_split > split) {
-                          const uint size = (split + edges_len) - (uint)last_split;
-                          NewEdgeRef **edges = MEM_malloc_arrayN(
-                              size, sizeof(*edges), "edge_group split in solidify");
-                          memcpy(edges,
-                                 g.edges + last_split,
-                                 (edges_len - (uint)last_split) * sizeof(*edges));
-                          memcpy(edges + (edges_len - (uint)last_split),
-                                 g.edges,
-                                 split * sizeof(*edges));
-                          edge_groups[j + add_index] = (EdgeGroup){
-                              .valid = true,
-                              .edges = edges,
-                              .edges_len = size,
-                              .open_face_edge = MOD_SOLIDIFY_EMPTY_TAG,
-                              .is_orig_closed = g.is_orig_closed,
-                              .is_even_split = is_even_split,
-                              .split = add_index - prior_index + 1 + (uint)!g.is_orig_closed,
-                              .is_singularity = false,
-                              .topo_group = g.topo_group,
-                              .co = {0.0f, 0.0f, 0.0f},
-                              .no = {0.0f, 0.0f, 0.0f},
-                              .new_vert = MOD_SOLIDIFY_EMPTY_TAG,
-                          };
-                        }
-                        else {
-                          const uint size = split - (uint)last_split;
-                          NewEdgeRef **edges = MEM_malloc_arrayN(
-                              size, sizeof(*edges), "edge_group split in solidify");
-                          memcpy(edges, g.edges + last_split, size * sizeof(*edges));
-                          edge_groups[j + add_index] = (EdgeGroup){
-                              .valid = true,
-                              .edges = edges,
-                              .edges_len = size,
-                              .open_face_edge = MOD_SOLIDIFY_EMPTY_TAG,
-                              .is_orig_closed = g.is_orig_closed,
-                              .is_even_split = is_even_split,
-                              .split = add_index - prior_index + 1 + (uint)!g.is_orig_closed,
-                              .is_singularity = false,
-                              .topo_group = g.topo_group,
-                              .co = {0.0f, 0.0f, 0.0f},
-                              .no = {0.0f, 0.0f, 0.0f},
-                              .new_vert = MOD_SOLIDIFY_EMPTY_TAG,
-                          };
-                        }
-                        splits++;
-                      }
-                      last_split = (int)split;
-                      if (first_split == -1) {
-                        first_split = (int)split;
-                        first_even_split = is_even_split;
-                      }
-                      unique_start = -1;
-                    }
-                    real_k++;
-                  }
-                  if (first_split != -1) {
-                    if (!g.is_orig_closed) {
-                      if (prior_splits != splits) {
-                        memmove(edge_groups + (j + prior_index + 1),
-                                edge_groups + (j + prior_index),
-                                ((uint)eg_index + add_index - (j + prior_index)) *
-                                    sizeof(*edge_groups));
-                        memmove(edge_groups + (j + add_index + 2),
-                                edge_groups + (j + add_index + 1),
-                                ((uint)eg_index - j) * sizeof(*edge_groups));
-                        add_index++;
-                      }
-                      else {
-                        memmove(edge_groups + (j + add_index + 2),
-                                edge_groups + (j + add_index + 1),
-                                ((uint)eg_index - j - 1) * sizeof(*edge_groups));
-                      }
-                      NewEdgeRef **edges = MEM_malloc_arrayN(
-                          (uint)first_split, sizeof(*edges), "edge_group split in solidify");
-                      memcpy(edges, g.edges, (uint)first_split * sizeof(*edges));
-                      edge_groups[j + prior_index] = (EdgeGroup){
-                          .valid = true,
-                          .edges = edges,
-                          .edges_len = (uint)first_split,
-                          .open_face_edge = MOD_SOLIDIFY_EMPTY_TAG,
-                          .is_orig_closed = g.is_orig_closed,
-                          .is_even_split = first_even_split,
-                          .split = 1,
-                          .is_singularity = false,
-                          .topo_group = g.topo_group,
-                          .co = {0.0f, 0.0f, 0.0f},
-                          .no = {0.0f, 0.0f, 0.0f},
-                          .new_vert = MOD_SOLIDIFY_EMPTY_TAG,
-                      };
-                      add_index++;
-                      splits++;
-                      edges = MEM_malloc_arrayN(edges_len - (uint)last_split,
-                                                sizeof(*edges),
-                                                "edge_group split in solidify");
-                      memcpy(edges,
-                             g.edges + last_split,
-                             (edges_len - (uint)last_split) * sizeof(*edges));
-                      edge_groups[j + add_index] = (EdgeGroup){
-                          .valid = true,
-                          .edges = edges,
-                          .edges_len = (edges_len - (uint)last_split),
-                          .open_face_edge = MOD_SOLIDIFY_EMPTY_TAG,
-                          .is_orig_closed = g.is_orig_closed,
-                          .is_even_split = false,
-                          .split = add_index - prior_index + 1,
-                          .is_singularity = false,
-                          .topo_group = g.topo_group,
-                          .co = {0.0f, 0.0f, 0.0f},
-                          .no = {0.0f, 0.0f, 0.0f},
-                          .new_vert = MOD_SOLIDIFY_EMPTY_TAG,
-                      };
-                    }
-                    if (prior_splits != splits) {
-                      MEM_freeN(g.edges);
-                    }
-                  }
-                  if (first_unique_end != -1 && prior_splits == splits) {
-                    has_singularities = true;
-                    edge_groups[j + add_index].is_singularity = true;
-                  }
-                }
-                MEM_freeN(doubles);
-              }
-            }
+      }
+      open_edges += (uint)(added < last_added);
+      if (!first_set) {
+        first_set = true;
+        first_added = added;
+      }
+      last_added = added;
+      if (!(g + 1)->valid || g->topo_group != (g + 1)->topo_group) {
+        if (new_verts > 2) {
+          numNewPolys++;
+          numNewEdges += new_verts;
+          open_edges += (uint)(first_added < last_added);
+          open_edges -= (uint)(open_edges && !contains_open_splits);
+          if (do_shell && do_rim) {
+            numNewLoops += new_verts * 2;
           }
-        }
-
-        orig_vert_groups_arr[i] = edge_groups;
-        /* Count new edges, loops, polys and add to link_edge_groups. */
-        {
-          uint new_verts = 0;
-          bool contains_open_splits = false;
-          uint open_edges = 0;
-          uint contains_splits = 0;
-          uint last_added = 0;
-          uint first_added = 0;
-          bool first_set = false;
-          for (EdgeGroup *g = edge_groups; g->valid; g++) {
-            NewEdgeRef **e = g->edges;
-            for (uint j = 0; j < g->edges_len; j++, e++) {
-              const uint flip = (uint)(vm[orig_medge[(*e)->old_edge].v2] == i);
-              BLI_assert(flip || vm[orig_medge[(*e)->old_edge].v1] == i);
-              (*e)->link_edge_groups[flip] = g;
-            }
-            uint added = 0;
-            if (do_shell || (do_rim && !g->is_orig_closed)) {
-              BLI_assert(g->new_vert == MOD_SOLIDIFY_EMPTY_TAG);
-              g->new_vert = numNewVerts++;
-              if (do_rim || (do_shell && g->split)) {
-                new_verts++;
-                contains_splits += (g->split != 0);
-                contains_open_splits |= g->split && !g->is_orig_closed;
-                added = g->split;
-              }
-            }
-            open_edges += (uint)(added < last_added);
-            if (!first_set) {
-              first_set = true;
-              first_added = added;
-            }
-            last_added = added;
-            if (!(g + 1)->valid || g->topo_group != (g + 1)->topo_group) {
-              if (new_verts > 2) {
-                numNewPolys++;
-                numNewEdges += new_verts;
-                open_edges += (uint)(first_added < last_added);
-                open_edges -= (uint)(open_edges && !contains_open_splits);
-                if (do_shell && do_rim) {
-                  numNewLoops += new_verts * 2;
-                }
-                else if (do_shell) {
-                  numNewLoops += new_verts * 2 - open_edges;
-                }
-                else {  // do_rim
-                  numNewLoops += new_verts * 2 + open_edges - contains_splits;
-                }
-              }
-              else if (new_verts == 2) {
-                numNewEdges++;
-                numNewLoops += 2u - (uint)(!(do_rim && do_shell) && contains_open_splits);
-              }
-              new_verts = 0;
-              contains_open_splits = false;
-              contains_splits = 0;
-              open_edges = 0;
-              last_added = 0;
-              first_added = 0;
-              first_set = false;
-            }
+          else if (do_shell) {
+            numNewLoops += new_verts * 2 - open_edges;
           }
+          else {  // do_rim
+            numNewLoops += new_verts * 2 + open_edges - contains_splits;
+          }
+        }
+        else if (new_verts == 2) {
+          numNewEdges++;
+          numNewLoops += 2u - (uint)(!(do_rim && do_shell) && contains_open_splits);
         }
+        new_verts = 0;
+        contains_open_splits = false;
+        contains_splits = 0;
+        open_edges = 0;
+        last_added = 0;
+        first_added = 0;
+        first_set = false;
       }
     }
   }
@@ -1230,445 +1825,32 @@ Mesh *MOD_solidify_nonmanifold_applyModifier(ModifierData *md,
 
   /* Calculate EdgeGroup vertex coordinates. */
   {
-    mv = orig_mvert;
-    gs_ptr = orig_vert_groups_arr;
-    for (uint i = 0; i < numVerts; i++, mv++, gs_ptr++) {
-      if (*gs_ptr) {
-        EdgeGroup *g = *gs_ptr;
-        for (uint j = 0; g->valid; j++, g++) {
-          if (!g->is_singularity) {
-            float *nor = g->no;
-            float move_nor[3] = {0, 0, 0};
-            bool disable_boundary_fix = (smd->nonmanifold_boundary_mode ==
-                                             MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_NONE ||
-                                         (g->is_orig_closed || g->split));
-            /* Constraints Method. */
-            if (smd->nonmanifold_offset_mode == MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_CONSTRAINTS) {
-              NewEdgeRef *first_edge = NULL;
-              NewEdgeRef **edge_ptr = g->edges;
-              /* Contains normal and offset [nx, ny, nz, ofs]. */
-              float(*normals_queue)[4] = MEM_malloc_arrayN(
-                  g->edges_len + 1, sizeof(*normals_queue), "normals_queue in solidify");
-              uint queue_index = 0;
-
-              float face_nors[3][3];
-              float nor_ofs[3];
-
-              const bool cycle = (g->is_orig_closed && !g->split) || g->is_even_split;
-              for (uint k = 0; k < g->edges_len; k++, edge_ptr++) {
-                if (!(k & 1) || (!cycle && k == g->edges_len - 1)) {
-                  NewEdgeRef *edge = *edge_ptr;
-                  for (uint l = 0; l < 2; l++) {
-                    NewFaceRef *face = edge->faces[l];
-                    if (face && (first_edge == NULL ||
-                                 (first_edge->faces[0] != face && first_edge->faces[1] != face))) {
-                      if (!null_faces[face->index]) {
-                        mul_v3_v3fl(normals_queue[queue_index],
-                                    poly_nors[face->index],
-                                    face->reversed ? -1 : 1);
-                        normals_queue[queue_index++][3] = face->reversed ? ofs_back : ofs_front;
-                      }
-                      else {
-                        mul_v3_v3fl(face_nors[0], poly_nors[face->index], face->reversed ? -1 : 1);
-                        nor_ofs[0] = face->reversed ? ofs_back : ofs_front;
-                      }
-                    }
-                  }
-                  if ((cycle && k == 0) || (!cycle && k + 3 >= g->edges_len)) {
-                    first_edge = edge;
-                  }
-                }
-              }
-              uint face_nors_len = 0;
-              const float stop_explosion = 1 - fabsf(smd->offset_fac) * 0.05f;
-              while (queue_index > 0) {
-                if (face_nors_len == 0) {
-                  if (queue_index <= 2) {
-                    for (uint k = 0; k < queue_index; k++) {
-                      copy_v3_v3(face_nors[k], normals_queue[k]);
-                      nor_ofs[k] = normals_queue[k][3];
-                    }
-                    face_nors_len = queue_index;
-                    queue_index = 0;
-                  }
-                  else {
-                    /* Find most different two normals. */
-                    float min_p = 2;
-                    uint min_n0 = 0;
-                    uint min_n1 = 0;
-                    for (uint k = 0; k < queue_index; k++) {
-                      for (uint m = k + 1; m < queue_index; m++) {
-                        float p = dot_v3v3(normals_queue[k], normals_queue[m]);
-                        if (p <= min_p + FLT_EPSILON) {
-                          min_p = p;
-                          min_n0 = m;
-                          min_n1 = k;
-                        }
-                      }
-                    }
-                    copy_v3_v3(face_nors[0], normals_queue[min_n0]);
-                    copy_v3_v3(face_nors[1], normals_queue[min_n1]);
-                    nor_ofs[0] = normals_queue[min_n0][3];
-                    nor_ofs[1] = normals_queue[min_n1][3];
-                    face_nors_len = 2;
-                    queue_index--;
-                    memmove(normals_queue + min_n0,
-                            normals_queue + min_n0 + 1,
-                            (queue_index - min_n0) * sizeof(*normals_queue));
-                    queue_index--;
-                    memmove(normals_queue + min_n1,
-                            normals_queue + min_n1 + 1,
-                            (queue_index - min_n1) * sizeof(*normals_queue));
-                    min_p = 1;
-                    min_n1 = 0;
-                    float max_p = -1;
-                    for (uint k = 0; k < queue_index; k++) {
-                      max_p = -1;
-                      for (uint m = 0; m < face_nors_len; m++) {
-                        float p = dot_v3v3(face_nors[m], normals_queue[k]);
-                        if (p > max_p + FLT_EPSILON) {
-                          max_p = p;
-                        }
-                      }
-                      if (max_p <= min_p + FLT_EPSILON) {
-                        min_p = max_p;
-                        min_n1 = k;
-                      }
-                    }
-                    if (min_p < 0.8) {
-                      copy_v3_v3(face_nors[2], normals_queue[min_n1]);
-                      nor_ofs[2] = normals_queue[min_n1][3];
-                      face_nors_len++;
-                      queue_index--;
-                      memmove(normals_queue + min_n1,
-                              normals_queue + min_n1 + 1,
-                              (queue_index - min_n1) * sizeof(*normals_queue));
-                    }
-                  }
-                }
-                else {
-                  uint best = 0;
-                  uint best_group = 0;
-                  float best_p = -1.0f;
-                  for (uint k = 0; k < queue_index; k++) {
-                    for (uint m = 0; m < face_nors_len; m++) {
-                      float p = dot_v3v3(face_nors[m], normals_queue[k]);
-                      if (p > best_p + FLT_EPSILON) {
-                        best_p = p;
-                        best = m;
-                        best_group = k;
-                      }
-                    }
-                  }
-                  add_v3_v3(face_nors[best], normals_queue[best_group]);
-                  normalize_v3(face_nors[best]);
-                  nor_ofs[best] = (nor_ofs[best] + normals_queue[best_group][3]) * 0.5f;
-                  queue_index--;
-                  memmove(normals_queue + best_group,
-                          normals_queue + best_group + 1,
-                          (queue_index - best_group) * sizeof(*normals_queue));
-                }
-              }
-              MEM_freeN(normals_queue);
-              /* When up to 3 constraint normals are found. */
-              float d, q;
-              switch (face_nors_len) {
-                case 0:
-                  mul_v3_v3fl(nor, face_nors[0], nor_ofs[0]);
-                  disable_boundary_fix = true;
-                  break;
-                case 1:
-                  mul_v3_v3fl(nor, face_nors[0], nor_ofs[0]);
-                  disable_boundary_fix = true;
-                  break;
-                case 2:
-                  q = dot_v3v3(face_nors[0], face_nors[1]);
-                  d = 1.0f - q * q;
-                  if (LIKELY(d > FLT_EPSILON) && q < stop_explosion) {
-                    d = 1.0f / d;
-                    mul_v3_fl(face_nors[0], (nor_ofs[0] - nor_ofs[1] * q) * d);
-                    mul_v3_fl(face_nors[1], (nor_ofs[1] - nor_ofs[0] * q) * d);
-                    add_v3_v3v3(nor, face_nors[0], face_nors[1]);
-                  }
-                  else {
-                    mul_v3_fl(face_nors[0], nor_ofs[0] * 0.5f);
-                    mul_v3_fl(face_nors[1], nor_ofs[1] * 0.5f);
-                    add_v3_v3v3(nor, face_nors[0], face_nors[1]);
-                  }
-                  if (!disable_boundary_fix) {
-                    cross_v3_v3v3(move_nor, face_nors[0], face_nors[1]);
-                  }
-                  break;
-                case 3:
-                  q = dot_v3v3(face_nors[0], face_nors[1]);
-                  d = 1.0f - q * q;
-                  float *free_nor = move_nor; /* No need to allocate a new array. */
-                  cross_v3_v3v3(free_nor, face_nors[0], face_nors[1]);
-                  if (LIKELY(d > FLT_EPSILON) && q < stop_explosion) {
-                    d = 1.0f / d;
-                    mul_v3_fl(face_nors[0], (nor_ofs[0] - nor_ofs[1] * q) * d);
-                    mul_v3_fl(face_nors[1], (nor_ofs[1] - nor_ofs[0] * q) * d);
-                    add_v3_v3v3(nor, face_nors[0], face_nors[1]);
-                  }
-                  else {
-                    mul_v3_fl(face_nors[0], nor_ofs[0] * 0.5f);
-                    mul_v3_fl(face_nors[1], nor_ofs[1] * 0.5f);
-                    add_v3_v3v3(nor, face_nors[0], face_nors[1]);
-                  }
-                  mul_v3_fl(face_nors[2], nor_ofs[2]);
-                  d = dot_v3v3(face_nors[2], free_nor);
-                  if (LIKELY(fabsf(d) > FLT_EPSILON)) {
-                    sub_v3_v3v3(face_nors[0], nor, face_nors[2]); /* Override face_nor[0]. */
-                    mul_v3_fl(free_nor, dot_v3v3(face_nors[2], face_nors[0]) / d);
-                    sub_v3_v3(nor, free_nor);
-                  }
-                  disable_boundary_fix = true;
-                  break;
-                default:
-                  BLI_assert(0);
-              }
-            }
-            /* Simple/Even Method. */
-            else {
-              float total_angle = 0;
-              float total_angle_back = 0;
-              NewEdgeRef *first_edge = NULL;
-              NewEdgeRef **edge_ptr = g->edges;
-              float face_nor[3];
-              float nor_back[3] = {0, 0, 0};
-              bool has_back = false;
-              bool has_front = false;
-              bool cycle = (g->is_orig_closed && !g->split) || g->is_even_split;
-              for (uint k = 0; k < g->edges_len; k++, edge_ptr++) {
-                if (!(k & 1) || (!cycle && k == g->edges_len - 1)) {
-                  NewEdgeRef *edge = *edge_ptr;
-                  for (uint l = 0; l < 2; l++) {
-                    NewFaceRef *face = edge->faces[l];
-                    if (face && (first_edge == NULL ||
-                                 (first_edge->faces[0] != face && first_edge->faces[1] != face))) {
-                      float angle = 1.0f;
-                      float ofs = face->reversed ? -max_ff(1.0e-5f, ofs_back) :
-                                                   max_ff(1.0e-5f, ofs_front);
-                      if (smd->nonmanifold_offset_mode ==
-                          MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_EVEN) {
-                        MLoop *ml_next = orig_mloop + face->face->loopstart;
-                        ml = ml_next + (face->face->totloop - 1);
-                        MLoop *ml_prev = ml - 1;
-                        for (int m = 0; m < face->face->totloop && vm[ml->v] != i;
-                             m++, ml_next++) {
-                          ml_prev = ml;
-                          ml = ml_next;
-                        }
-                        angle = angle_v3v3v3(
-                            orig_mvert[vm[ml_prev->v]].co, mv->co, orig_mvert[vm[ml_next->v]].co);
-                        if (face->reversed) {
-                          total_angle_back += angle * ofs * ofs;
-                        }
-                        else {
-                          total_angle += angle * ofs * ofs;
-                        }
-                      }
-                      else {
-                        if (face->reversed) {
-                          total_angle_back++;
-                        }
-                        else {
-                          total_angle++;
-                        }
-                      }
-                      mul_v3_v3fl(face_nor, poly_nors[face->index], angle * ofs);
-                      if (face->reversed) {
-                        add_v3_v3(nor_back, face_nor);
-                        has_back = true;
-                      }
-                      else {
-                        add_v3_v3(nor, face_nor);
-                        has_front = true;
-                      }
-                    }
-                  }
-                  if ((cycle && k == 0) || (!cycle && k + 3 >= g->edges_len)) {
-                    first_edge = edge;
-                  }
-                }
-              }
-
-              /* Set normal length with selected method. */
-              if (smd->nonmanifold_offset_mode == MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_EVEN) {
-                float d = dot_v3v3(nor, nor_back);
-                if (has_front) {
-                  float length = len_squared_v3(nor);
-                  if (LIKELY(length > FLT_EPSILON)) {
-                    mul_v3_fl(nor, total_angle / length);
-                  }
-                }
-                if (has_back) {
-                  float length = len_squared_v3(nor_back);
-                  if (LIKELY(length > FLT_EPSILON)) {
-                    mul_v3_fl(nor_back, total_angle_back / length);
-                  }
-                  if (!has_front) {
-                    copy_v3_v3(nor, nor_back);
-                  }
-                }
-                if (has_front && has_back) {
-                  float nor_length = len_v3(nor);
-                  float nor_back_length = len_v3(nor_back);
-                  float q = dot_v3v3(nor, nor_back);
-                  if (LIKELY(fabsf(q) > FLT_EPSILON)) {
-                    q /= nor_length * nor_back_length;
-                  }
-                  d = 1.0f - q * q;
-                  if (LIKELY(d > FLT_EPSILON)) {
-                    d = 1.0f / d;
-                    if (LIKELY(nor_length > FLT_EPSILON)) {
-                      mul_v3_fl(nor, (1 - nor_back_length * q / nor_length) * d);
-                    }
-                    if (LIKELY(nor_back_length > FLT_EPSILON)) {
-                      mul_v3_fl(nor_back, (1 - nor_length * q / nor_back_length) * d);
-                    }
-                    add_v3_v3(nor, nor_back);
-                  }
-                  else {
-                    mul_v3_fl(nor, 0.5f);
-                    mul_v3_fl(nor_back, 0.5f);
-                    add_v3_v3(nor, nor_back);
-                  }
-                }
-              }
-              else {
-                if (has_front && total_angle > FLT_EPSILON) {
-                  mul_v3_fl(nor, 1.0f / total_angle);
-                }
-                if (has_back && total_angle_back > FLT_EPSILON) {
-                  mul_v3_fl(nor_back, 1.0f / total_angle_back);
-                  add_v3_v3(nor, nor_back);
-                }
-              }
-              /* Set move_nor for boundary fix. */
-              if (!disable_boundary_fix && g->edges_len > 2) {
-                edge_ptr = g->edges + 1;
-                float tmp[3];
-                uint k;
-                for (k = 1; k + 1 < g->edges_len; k++, edge_ptr++) {
-                  MEdge *e = orig_medge + (*edge_ptr)->old_edge;
-                  sub_v3_v3v3(tmp, orig_mvert[vm[e->v1] == i ? e->v2 : e->v1].co, mv->co);
-                  add_v3_v3(move_nor, tmp);
-                }
-                if (k == 1) {
-                  disable_boundary_fix = true;
-                }
-                else {
-                  disable_boundary_fix = normalize_v3(move_nor) == 0.0f;
-                }
-              }
-              else {
-                disable_boundary_fix = true;
-              }
-            }
-            /* Fix boundary verts. */
-            if (!disable_boundary_fix) {
-              /* Constraint normal, nor * constr_nor == 0 after this fix. */
-              float constr_nor[3];
-              MEdge *e0_edge = orig_medge + g->edges[0]->old_edge;
-              MEdge *e1_edge = orig_medge + g->edges[g->edges_len - 1]->old_edge;
-              float e0[3];
-              float e1[3];
-              sub_v3_v3v3(
-                  e0, orig_mvert[vm[e0_edge->v1] == i ? e0_edge->v2 : e0_edge->v1].co, mv->co);
-              sub_v3_v3v3(
-                  e1, orig_mvert[vm[e1_edge->v1] == i ? e1_edge->v2 : e1_edge->v1].co, mv->co);
-              if (smd->nonmanifold_boundary_mode == MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_FLAT) {
-                cross_v3_v3v3(constr_nor, e0, e1);
-              }
-              else {
-                float f0[3];
-                float f1[3];
-                if (g->edges[0]->faces[0]->reversed) {
-                  negate_v3_v3(f0, poly_nors[g->edges[0]->faces[0]->index]);
-                }
-                else {
-                  copy_v3_v3(f0, poly_nors[g->edges[0]->faces[0]->index]);
-                }
-                if (g->edges[g->edges_len - 1]->faces[0]->reversed) {
-                  negate_v3_v3(f1, poly_nors[g->edges[g->edges_len - 1]->faces[0]->index]);
-                }
-                else {
-                  copy_v3_v3(f1, poly_nors[g->edges[g->edges_len - 1]->faces[0]->index]);
-                }
-                float n0[3];
-                float n1[3];
-                cross_v3_v3v3(n0, e0, f0);
-                cross_v3_v3v3(n1, f1, e1);
-                normalize_v3(n0);
-                normalize_v3(n1);
-                add_v3_v3v3(constr_nor, n0, n1);
-              }
-              float d = dot_v3v3(constr_nor, move_nor);
-              if (LIKELY(fabsf(d) > FLT_EPSILON)) {
-                mul_v3_fl(move_nor, dot_v3v3(constr_nor, nor) / d);
-                sub_v3_v3(nor, move_nor);
-              }
-            }
-            float scalar_vgroup = 1;
-            /* Use vertex group. */
-            if (dvert) {
-              MDeformVert *dv = &dvert[i];
-              if (defgrp_invert) {
-                scalar_vgroup = 1.0f - defvert_find_weight(dv, defgrp_index);
-              }
-              else {
-                scalar_vgroup = defvert_find_weight(dv, defgrp_index);
-              }
-              scalar_vgroup = offset_fac_vg + (scalar_vgroup * offset_fac_vg_inv);
-            }
-            /* Do clamping. */
-            if (do_clamp) {
-              if (do_angle_clamp) {
-                float min_length = 0;
-                float angle = 0.5f * M_PI;
-                uint k = 0;
-                for (NewEdgeRef **p = g->edges; k < g->edges_len; k++, p++) {
-                  float length = orig_edge_lengths[(*p)->old_edge];
-                  float e_ang = (*p)->angle;
-                  if (e_ang > angle) {
-                    angle = e_ang;
-                  }
-                  if (length < min_length || k == 0) {
-                    min_length = length;
-                  }
-                }
-                float cos_ang = cosf(angle * 0.5f);
-                if (cos_ang > 0) {
-                  float max_off = min_length * 0.5f / cos_ang;
-                  if (max_off < offset * 0.5f) {
-                    scalar_vgroup *= max_off / offset * 2;
-                  }
-                }
-              }
-              else {
-                float min_length = 0;
-                uint k = 0;
-                for (NewEdgeRef **p = g->edges; k < g->edges_len; k++, p++) {
-                  float length = orig_edge_lengths[(*p)->old_edge];
-                  if (length < min_length || k == 0) {
-                    min_length = length;
-                  }
-                }
-                if (min_length < offset) {
-                  scalar_vgroup *= min_length / offset;
-                }
-              }
-            }
-            mul_v3_fl(nor, scalar_vgroup);
-            add_v3_v3v3(g->co, nor, mv->co);
-          }
-          else {
-            copy_v3_v3(g->co, mv->co);
-          }
-        }
-      }
-    }
+    EdgeGroupCoordsData coords_data = {
+        .smd = smd,
+        .orig_mvert = orig_mvert,
+        .orig_medge = orig_medge,
+        .orig_mloop = orig_mloop,
+        .vm = vm,
+        .orig_vert_groups_arr = orig_vert_groups_arr,
+        .orig_edge_lengths = orig_edge_lengths,
+        .poly_nors = poly_nors,
+        .null_faces = null_faces,
+        .dvert = dvert,
+        .defgrp_index = defgrp_index,
+        .defgrp_invert = defgrp_invert,
+        .offset_fac_vg = offset_fac_vg,
+        .offset_fac_vg_inv = offset_fac_vg_inv,
+        .ofs_front = ofs_front,
+        .ofs_back = ofs_back,
+        .offset = offset,
+        .do_clamp = do_clamp,
+        .do_angle_clamp = do_angle_clamp,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (numVerts > 1024);
+    BLI_task_parallel_range(
+        0, (int)numVerts, &coords_data, solidify_edge_group_coords_task, &settings);
   }
 
   if (null_faces) {
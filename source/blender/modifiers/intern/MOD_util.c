@@ -28,6 +28,7 @@
 #include "BLI_bitmap.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_matrix.h"
+#include "BLI_task.h"
 
 #include "DNA_image_types.h"
 #include "DNA_meshdata_types.h"
@@ -248,6 +249,63 @@ void MOD_get_vgroup(
   }
 }
 
+typedef struct DeformVertsUserdata {
+  float (*vertexCos)[3];
+  const MDeformVert *dvert;
+  int defgrp_index;
+  bool invert_vgroup;
+  void *userdata;
+  ModDeformVertFunc deform_func;
+} DeformVertsUserdata;
+
+static void deform_verts_task(void *__restrict userdata,
+                              const int index,
+                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DeformVertsUserdata *data = userdata;
+  float weight = 1.0f;
+
+  if (data->dvert) {
+    weight = defvert_find_weight(&data->dvert[index], data->defgrp_index);
+    if (data->invert_vgroup) {
+      weight = 1.0f - weight;
+    }
+    if (weight == 0.0f) {
+      return;
+    }
+  }
+
+  data->deform_func(data->userdata, index, data->vertexCos[index], weight);
+}
+
+/**
+ * Run \a deform_func over all vertices in parallel, skipping the ones with zero weight
+ * when a vertex group is given (\a dvert may be NULL).
+ */
+void MOD_deform_verts_parallel(float (*vertexCos)[3],
+                               const int numVerts,
+                               const MDeformVert *dvert,
+                               const int defgrp_index,
+                               const bool invert_vgroup,
+                               void *userdata,
+                               ModDeformVertFunc deform_func)
+{
+  DeformVertsUserdata data = {
+      .vertexCos = vertexCos,
+      .dvert = dvert,
+      .defgrp_index = defgrp_index,
+      .invert_vgroup = invert_vgroup,
+      .userdata = userdata,
+      .deform_func = deform_func,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (numVerts > 512);
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(0, numVerts, &data, deform_verts_task, &settings);
+}
+
 /* only called by BKE_modifier.h/modifier.c */
 void modifier_type_init(ModifierTypeInfo *types[])
 {
@@ -56,4 +56,21 @@ void MOD_get_vgroup(struct Object *ob,
                     struct MDeformVert **dvert,
                     int *defgrp_index);
 
+/**
+ * Deform a single vertex coordinate in place, called from multiple threads.
+ * \param weight: Vertex group weight, 1.0 when no vertex group is used. Never zero.
+ */
+typedef void (*ModDeformVertFunc)(void *__restrict userdata,
+                                  const int index,
+                                  float co[3],
+                                  const float weight);
+
+void MOD_deform_verts_parallel(float (*vertexCos)[3],
+                               const int numVerts,
+                               const struct MDeformVert *dvert,
+                               const int defgrp_index,
+                               const bool invert_vgroup,
+                               void *userdata,
+                               ModDeformVertFunc deform_func);
+
 #endif /* __MOD_UTIL_H__ */
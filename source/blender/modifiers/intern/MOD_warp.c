@@ -31,6 +31,7 @@
 #include "DNA_object_types.h"
 
 #include "BKE_editmesh.h"
+#include "BKE_image.h"
 #include "BKE_library.h"
 #include "BKE_library_query.h"
 #include "BKE_mesh.h"
@@ -153,6 +154,105 @@ static void updateDepsgraph(ModifierData *md, const ModifierUpdateDepsgraphConte
   }
 }
 
+typedef struct WarpUserdata {
+  const WarpModifierData *wmd;
+  const struct Scene *scene;
+  struct ImagePool *pool;
+  Tex *tex_target;
+  float (*tex_co)[3];
+  float strength;
+  float falloff_radius_sq;
+  float mat_from[4][4];
+  float mat_from_inv[4][4];
+  float mat_unit[4][4];
+  float mat_final[4][4];
+} WarpUserdata;
+
+static void warp_do_vert(void *__restrict userdata,
+                         const int i,
+                         float co[3],
+                         const float vgroup_weight)
+{
+  const WarpUserdata *data = userdata;
+  const WarpModifierData *wmd = data->wmd;
+  float fac = 1.0f;
+
+  if (wmd->falloff_type == eWarp_Falloff_None ||
+      ((fac = len_squared_v3v3(co, data->mat_from[3])) < data->falloff_radius_sq &&
+       (fac = (wmd->falloff_radius - sqrtf(fac)) / wmd->falloff_radius))) {
+    const float weight = vgroup_weight * data->strength;
+    if (weight <= 0.0f) {
+      return;
+    }
+
+    /* closely match PROP_SMOOTH and similar */
+    switch (wmd->falloff_type) {
+      case eWarp_Falloff_None:
+        fac = 1.0f;
+        break;
+      case eWarp_Falloff_Curve:
+        fac = BKE_curvemapping_evaluateF(wmd->curfalloff, 0, fac);
+        break;
+      case eWarp_Falloff_Sharp:
+        fac = fac * fac;
+        break;
+      case eWarp_Falloff_Smooth:
+        fac = 3.0f * fac * fac - 2.0f * fac * fac * fac;
+        break;
+      case eWarp_Falloff_Root:
+        fac = sqrtf(fac);
+        break;
+      case eWarp_Falloff_Linear:
+        /* pass */
+        break;
+      case eWarp_Falloff_Const:
+        fac = 1.0f;
+        break;
+      case eWarp_Falloff_Sphere:
+        fac = sqrtf(2 * fac - fac * fac);
+        break;
+      case eWarp_Falloff_InvSquare:
+        fac = fac * (2.0f - fac);
+        break;
+    }
+
+    fac *= weight;
+
+    if (data->tex_co) {
+      TexResult texres;
+      texres.nor = NULL;
+      BKE_texture_get_value_ex(
+          data->scene, data->tex_target, data->tex_co[i], &texres, data->pool, false);
+      fac *= texres.tin;
+    }
+
+    if (fac != 0.0f) {
+      /* into the 'from' objects space */
+      mul_m4_v3(data->mat_from_inv, co);
+
+      if (fac == 1.0f) {
+        mul_m4_v3(data->mat_final, co);
+      }
+      else {
+        if (wmd->flag & MOD_WARP_VOLUME_PRESERVE) {
+          /* interpolate the matrix for nicer locations */
+          float tmat[4][4];
+          blend_m4_m4m4(tmat, data->mat_unit, data->mat_final, fac);
+          mul_m4_v3(tmat, co);
+        }
+        else {
+          float tvec[3];
+          mul_v3_m4v3(tvec, data->mat_final, co);
+          interp_v3_v3v3(co, co, tvec, fac);
+        }
+      }
+
+      /* out of the 'from' objects space */
+      mul_m4_v3(data->mat_from, co);
+    }
+  }
+}
+
 static void warpModifier_do(WarpModifierData *wmd,
                             const ModifierEvalContext *ctx,
                             Mesh *mesh,
@@ -161,20 +261,13 @@ static void warpModifier_do(WarpModifierData *wmd,
 {
   Object *ob = ctx->object;
   float obinv[4][4];
-  float mat_from[4][4];
-  float mat_from_inv[4][4];
   float mat_to[4][4];
-  float mat_unit[4][4];
-  float mat_final[4][4];
 
   float tmat[4][4];
 
-  const float falloff_radius_sq = SQUARE(wmd->falloff_radius);
   float strength = wmd->strength;
-  float fac = 1.0f, weight;
-  int i;
   int defgrp_index;
-  MDeformVert *dvert, *dv = NULL;
+  MDeformVert *dvert;
 
   float(*tex_co)[3] = NULL;
 
@@ -182,10 +275,13 @@ static void warpModifier_do(WarpModifierData *wmd,
     return;
   }
 
+  WarpUserdata data = {
+      .wmd = wmd,
+      .scene = DEG_get_evaluated_scene(ctx->depsgraph),
+      .falloff_radius_sq = SQUARE(wmd->falloff_radius),
+  };
+
   MOD_get_vgroup(ob, mesh, wmd->defgrp_name, &dvert, &defgrp_index);
-  if (dvert == NULL) {
-    defgrp_index = -1;
-  }
 
   if (wmd->curfalloff == NULL) { /* should never happen, but bad lib linking could cause it */
     wmd->curfalloff = BKE_curvemapping_add(1, 0.0f, 0.0f, 1.0f, 1.0f);
@@ -197,26 +293,26 @@ static void warpModifier_do(WarpModifierData *wmd,
 
   invert_m4_m4(obinv, ob->obmat);
 
-  mul_m4_m4m4(mat_from, obinv, wmd->object_from->obmat);
+  mul_m4_m4m4(data.mat_from, obinv, wmd->object_from->obmat);
   mul_m4_m4m4(mat_to, obinv, wmd->object_to->obmat);
 
-  invert_m4_m4(tmat, mat_from);  // swap?
-  mul_m4_m4m4(mat_final, tmat, mat_to);
+  invert_m4_m4(tmat, data.mat_from);  // swap?
+  mul_m4_m4m4(data.mat_final, tmat, mat_to);
 
-  invert_m4_m4(mat_from_inv, mat_from);
+  invert_m4_m4(data.mat_from_inv, data.mat_from);
 
-  unit_m4(mat_unit);
+  unit_m4(data.mat_unit);
 
   if (strength < 0.0f) {
     float loc[3];
     strength = -strength;
 
     /* inverted location is not useful, just use the negative */
-    copy_v3_v3(loc, mat_final[3]);
-    invert_m4(mat_final);
-    negate_v3_v3(mat_final[3], loc);
+    copy_v3_v3(loc, data.mat_final[3]);
+    invert_m4(data.mat_final);
+    negate_v3_v3(data.mat_final[3], loc);
   }
-  weight = strength;
+  data.strength = strength;
 
   Tex *tex_target = wmd->texture;
   if (mesh != NULL && tex_target != NULL) {
@@ -224,88 +320,17 @@ static void warpModifier_do(WarpModifierData *wmd,
     MOD_get_texture_coords((MappingInfoModifierData *)wmd, ctx, ob, mesh, vertexCos, tex_co);
 
     MOD_init_texture((MappingInfoModifierData *)wmd, ctx);
-  }
-
-  for (i = 0; i < numVerts; i++) {
-    float *co = vertexCos[i];
-
-    if (wmd->falloff_type == eWarp_Falloff_None ||
-        ((fac = len_squared_v3v3(co, mat_from[3])) < falloff_radius_sq &&
-         (fac = (wmd->falloff_radius - sqrtf(fac)) / wmd->falloff_radius))) {
-      /* skip if no vert group found */
-      if (defgrp_index != -1) {
-        dv = &dvert[i];
-        weight = defvert_find_weight(dv, defgrp_index) * strength;
-        if (weight <= 0.0f) {
-          continue;
-        }
-      }
 
-      /* closely match PROP_SMOOTH and similar */
-      switch (wmd->falloff_type) {
-        case eWarp_Falloff_None:
-          fac = 1.0f;
-          break;
-        case eWarp_Falloff_Curve:
-          fac = BKE_curvemapping_evaluateF(wmd->curfalloff, 0, fac);
-          break;
-        case eWarp_Falloff_Sharp:
-          fac = fac * fac;
-          break;
-        case eWarp_Falloff_Smooth:
-          fac = 3.0f * fac * fac - 2.0f * fac * fac * fac;
-          break;
-        case eWarp_Falloff_Root:
-          fac = sqrtf(fac);
-          break;
-        case eWarp_Falloff_Linear:
-          /* pass */
-          break;
-        case eWarp_Falloff_Const:
-          fac = 1.0f;
-          break;
-        case eWarp_Falloff_Sphere:
-          fac = sqrtf(2 * fac - fac * fac);
-          break;
-        case eWarp_Falloff_InvSquare:
-          fac = fac * (2.0f - fac);
-          break;
-      }
-
-      fac *= weight;
-
-      if (tex_co) {
-        struct Scene *scene = DEG_get_evaluated_scene(ctx->depsgraph);
-        TexResult texres;
-        texres.nor = NULL;
-        BKE_texture_get_value(scene, tex_target, tex_co[i], &texres, false);
-        fac *= texres.tin;
-      }
+    data.tex_target = tex_target;
+    data.tex_co = tex_co;
+    data.pool = BKE_image_pool_new();
+    BKE_texture_fetch_images_for_pool(tex_target, data.pool);
+  }
 
-      if (fac != 0.0f) {
-        /* into the 'from' objects space */
-        mul_m4_v3(mat_from_inv, co);
+  MOD_deform_verts_parallel(vertexCos, numVerts, dvert, defgrp_index, false, &data, warp_do_vert);
 
-        if (fac == 1.0f) {
-          mul_m4_v3(mat_final, co);
-        }
-        else {
-          if (wmd->flag & MOD_WARP_VOLUME_PRESERVE) {
-            /* interpolate the matrix for nicer locations */
-            blend_m4_m4m4(tmat, mat_unit, mat_final, fac);
-            mul_m4_v3(tmat, co);
-          }
-          else {
-            float tvec[3];
-            mul_v3_m4v3(tvec, mat_final, co);
-            interp_v3_v3v3(co, co, tvec, fac);
-          }
-        }
-
-        /* out of the 'from' objects space */
-        mul_m4_v3(mat_from, co);
-      }
-    }
+  if (data.pool != NULL) {
+    BKE_image_pool_free(data.pool);
   }
 
   if (tex_co) {
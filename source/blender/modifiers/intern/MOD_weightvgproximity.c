@@ -73,67 +73,22 @@ typedef struct Vert2GeomData {
 
   const SpaceTransform *loc2trgt;
 
-  BVHTreeFromMesh *treeData[3];
-
   /* Write data, but not needing locking (two different threads will never write same index). */
-  float *dist[3];
+  float (*tree_cos)[3];
 } Vert2GeomData;
 
-/** Data which is localized to each computed chunk
- * (i.e. thread-safe, and with continuous subset of index range). */
-typedef struct Vert2GeomDataChunk {
-  /* Read-only data */
-  float last_hit_co[3][3];
-  bool is_init[3];
-} Vert2GeomDataChunk;
-
 /**
  * Callback used by BLI_task 'for loop' helper.
  */
 static void vert2geom_task_cb_ex(void *__restrict userdata,
                                  const int iter,
-                                 const TaskParallelTLS *__restrict tls)
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
 {
   Vert2GeomData *data = userdata;
-  Vert2GeomDataChunk *data_chunk = tls->userdata_chunk;
-
-  float tmp_co[3];
-  int i;
 
   /* Convert the vertex to tree coordinates. */
-  copy_v3_v3(tmp_co, data->v_cos[iter]);
-  BLI_space_transform_apply(data->loc2trgt, tmp_co);
-
-  for (i = 0; i < ARRAY_SIZE(data->dist); i++) {
-    if (data->dist[i]) {
-      BVHTreeNearest nearest = {0};
-
-      /* Note that we use local proximity heuristics (to reduce the nearest search).
-       *
-       * If we already had an hit before in same chunk of tasks (i.e. previous vertex by index),
-       * we assume this vertex is going to have a close hit to that other vertex,
-       * so we can initiate the "nearest.dist" with the expected value to that last hit.
-       * This will lead in pruning of the search tree.
-       */
-      nearest.dist_sq = data_chunk->is_init[i] ?
-                            len_squared_v3v3(tmp_co, data_chunk->last_hit_co[i]) :
-                            FLT_MAX;
-      nearest.index = -1;
-
-      /* Compute and store result. If invalid (-1 idx), keep FLT_MAX dist. */
-      BLI_bvhtree_find_nearest(data->treeData[i]->tree,
-                               tmp_co,
-                               &nearest,
-                               data->treeData[i]->nearest_callback,
-                               data->treeData[i]);
-      data->dist[i][iter] = sqrtf(nearest.dist_sq);
-
-      if (nearest.index != -1) {
-        copy_v3_v3(data_chunk->last_hit_co[i], nearest.co);
-        data_chunk->is_init[i] = true;
-      }
-    }
-  }
+  copy_v3_v3(data->tree_cos[iter], data->v_cos[iter]);
+  BLI_space_transform_apply(data->loc2trgt, data->tree_cos[iter]);
 }
 
 /**
@@ -148,7 +103,6 @@ static void get_vert2geom_distance(int numVerts,
                                    const SpaceTransform *loc2trgt)
 {
   Vert2GeomData data = {0};
-  Vert2GeomDataChunk data_chunk = {{{0}}};
 
   BVHTreeFromMesh treeData_v = {NULL};
   BVHTreeFromMesh treeData_e = {NULL};
@@ -179,22 +133,50 @@ static void get_vert2geom_distance(int numVerts,
     }
   }
 
+  BVHTreeFromMesh *treeData[3] = {&treeData_v, &treeData_e, &treeData_f};
+  float *dist[3] = {dist_v, dist_e, dist_f};
+
   data.v_cos = v_cos;
   data.loc2trgt = loc2trgt;
-  data.treeData[0] = &treeData_v;
-  data.treeData[1] = &treeData_e;
-  data.treeData[2] = &treeData_f;
-  data.dist[0] = dist_v;
-  data.dist[1] = dist_e;
-  data.dist[2] = dist_f;
+  data.tree_cos = MEM_malloc_arrayN(numVerts, sizeof(*data.tree_cos), __func__);
+  BVHTreeNearest *nearest = MEM_malloc_arrayN(numVerts, sizeof(*nearest), __func__);
 
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
   settings.use_threading = (numVerts > 10000);
-  settings.userdata_chunk = &data_chunk;
-  settings.userdata_chunk_size = sizeof(data_chunk);
   BLI_task_parallel_range(0, numVerts, &data, vert2geom_task_cb_ex, &settings);
 
+  for (int i = 0; i < ARRAY_SIZE(dist); i++) {
+    if (dist[i]) {
+      for (int v = 0; v < numVerts; v++) {
+        nearest[v].index = -1;
+        nearest[v].dist_sq = FLT_MAX;
+      }
+
+      /* Note that we use local proximity heuristics (to reduce the nearest search).
+       *
+       * The queries are sorted spatially, we assume each vertex is going to have a close hit to
+       * the previous one, so the search starts with the distance to that last hit.
+       * This will lead in pruning of the search tree.
+       */
+      BLI_bvhtree_find_nearest_batch(treeData[i]->tree,
+                                     (const float(*)[3])data.tree_cos,
+                                     nearest,
+                                     numVerts,
+                                     treeData[i]->nearest_callback,
+                                     treeData[i],
+                                     BVH_NEAREST_REUSE_PREVIOUS);
+
+      /* Store result. If invalid (-1 idx), keep FLT_MAX dist. */
+      for (int v = 0; v < numVerts; v++) {
+        dist[i][v] = sqrtf(nearest[v].dist_sq);
+      }
+    }
+  }
+
+  MEM_freeN(data.tree_cos);
+  MEM_freeN(nearest);
+
   if (dist_v) {
     free_bvhtree_from_mesh(&treeData_v);
   }
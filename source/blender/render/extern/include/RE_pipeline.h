@@ -84,6 +84,9 @@ typedef struct RenderPass {
   int view_id;       /* quick lookup */
 
   int pad;
+
+  /** Layer a streamed pass is read back from while it has no rect, see #RE_pass_rect_ensure. */
+  struct RenderLayer *stream_layer;
 } RenderPass;
 
 /* a renderlayer is a full image, but with all passes and samples */
@@ -101,6 +104,9 @@ typedef struct RenderLayer {
 
   /** Optional saved endresult on disk. */
   void *exrhandle;
+  /** Tiled EXR file that passes without rect are read back from on demand,
+   * owned by the layer and removed when it is freed, see #RE_pass_rect_ensure. */
+  char *stream_filepath;
 
   ListBase passes;
 
@@ -353,6 +359,7 @@ struct RenderPass *RE_pass_find_by_name(volatile struct RenderLayer *rl,
 struct RenderPass *RE_pass_find_by_type(volatile struct RenderLayer *rl,
                                         int passtype,
                                         const char *viewname);
+float *RE_pass_rect_ensure(struct RenderLayer *rl, struct RenderPass *rpass);
 
 /* shaded view or baking options */
 #define RE_BAKE_NORMALS 0
@@ -28,6 +28,7 @@
 
 #define RR_USE_MEM 0
 #define RR_USE_EXR 1
+#define RR_USE_STREAM 2
 
 #define RR_ALL_LAYERS NULL
 #define RR_ALL_VIEWS NULL
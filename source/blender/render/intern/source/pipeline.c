@@ -293,7 +293,7 @@ void RE_FreeRenderResult(RenderResult *res)
 float *RE_RenderLayerGetPass(volatile RenderLayer *rl, const char *name, const char *viewname)
 {
   RenderPass *rpass = RE_pass_find_by_name(rl, name, viewname);
-  return rpass ? rpass->rect : NULL;
+  return rpass ? RE_pass_rect_ensure((RenderLayer *)rl, rpass) : NULL;
 }
 
 RenderLayer *RE_GetRenderLayer(RenderResult *rr, const char *name)
@@ -744,7 +744,7 @@ static int check_mode_full_sample(RenderData *rd)
   }
 #else
   /* can't do this without openexr support */
-  scemode &= ~(R_EXR_TILE_FILE | R_FULL_SAMPLE);
+  scemode &= ~(R_EXR_TILE_FILE | R_EXR_TILE_STREAM | R_FULL_SAMPLE);
 #endif
 
   return scemode;
@@ -2871,6 +2871,24 @@ void RE_layer_load_from_file(
                 "%s: no Combined pass found in the render layer '%s'",
                 __func__,
                 filename);
+    if (ibuf) {
+      IMB_freeImBuf(ibuf);
+    }
+    return;
+  }
+
+  /* Streamed passes are read back from disk before they are overwritten. */
+  float *rect = RE_pass_rect_ensure(layer, rpass);
+  if (rect == NULL) {
+    BKE_reportf(reports,
+                RPT_ERROR,
+                "%s: cannot read the Combined pass of the render layer '%s'",
+                __func__,
+                filename);
+    if (ibuf) {
+      IMB_freeImBuf(ibuf);
+    }
+    return;
   }
 
   if (ibuf && (ibuf->rect || ibuf->rect_float)) {
@@ -2879,7 +2897,7 @@ void RE_layer_load_from_file(
         IMB_float_from_rect(ibuf);
       }
 
-      memcpy(rpass->rect, ibuf->rect_float, sizeof(float) * 4 * layer->rectx * layer->recty);
+      memcpy(rect, ibuf->rect_float, sizeof(float) * 4 * layer->rectx * layer->recty);
     }
     else {
       if ((ibuf->x - x >= layer->rectx) && (ibuf->y - y >= layer->recty)) {
@@ -2893,8 +2911,7 @@ void RE_layer_load_from_file(
         if (ibuf_clip) {
           IMB_rectcpy(ibuf_clip, ibuf, 0, 0, x, y, layer->rectx, layer->recty);
 
-          memcpy(
-              rpass->rect, ibuf_clip->rect_float, sizeof(float) * 4 * layer->rectx * layer->recty);
+          memcpy(rect, ibuf_clip->rect_float, sizeof(float) * 4 * layer->rectx * layer->recty);
           IMB_freeImBuf(ibuf_clip);
         }
         else {
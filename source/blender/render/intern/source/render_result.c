@@ -28,7 +28,10 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "BLI_utildefines.h"
+#include "BLI_fileops.h"
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_hash_md5.h"
@@ -98,6 +101,10 @@ void render_result_free(RenderResult *res)
       BLI_remlink(&rl->passes, rpass);
       MEM_freeN(rpass);
     }
+    if (rl->stream_filepath) {
+      BLI_delete(rl->stream_filepath, false, false);
+      MEM_freeN(rl->stream_filepath);
+    }
     BLI_remlink(&res->layers, rl);
     MEM_freeN(rl);
   }
@@ -242,8 +249,10 @@ static RenderPass *render_layer_add_pass(RenderResult *rr,
   }
 
   /* Always allocate combined for display, in case of save buffers
-   * other passes are not allocated and only saved to the EXR file. */
-  if (rl->exrhandle == NULL || STREQ(rpass->name, RE_PASSNAME_COMBINED)) {
+   * other passes are not allocated and only saved to the EXR file.
+   * Streamed passes are read back from that file on demand. */
+  if ((rl->exrhandle == NULL && rl->stream_filepath == NULL) ||
+      STREQ(rpass->name, RE_PASSNAME_COMBINED)) {
     float *rect;
     int x;
 
@@ -267,6 +276,9 @@ static RenderPass *render_layer_add_pass(RenderResult *rr,
       }
     }
   }
+  else if (rl->stream_filepath) {
+    rpass->stream_layer = rl;
+  }
 
   BLI_addtail(&rl->passes, rpass);
 
@@ -283,6 +295,24 @@ RenderPass *gp_add_pass(
 /* will read info from Render *re to define layers */
 /* called in threads */
 /* re->winx,winy is coordinate space of entire image, partrct the part within */
+/* Path of the tiled EXR file a streamed render layer reads its passes from. Every layer gets a
+ * unique file, so results kept in render slots are not overwritten by the next render. */
+static char *render_result_exr_stream_path(Scene *scene, const char *layname)
+{
+  static unsigned int stream_counter = 0;
+  char name[FILE_MAXFILE + MAX_ID_NAME + MAX_ID_NAME + 100];
+  char filepath[FILE_MAX];
+
+  BLI_snprintf(name,
+               sizeof(name),
+               "%s_stream%u",
+               layname,
+               atomic_add_and_fetch_u(&stream_counter, 1));
+  render_result_exr_file_path(scene, name, 0, filepath);
+
+  return BLI_strdup(filepath);
+}
+
 RenderResult *render_result_new(Render *re,
                                 rcti *partrct,
                                 int crop,
@@ -316,7 +346,7 @@ RenderResult *render_result_new(Render *re,
   rr->tilerect.ymin = partrct->ymin - re->disprect.ymin;
   rr->tilerect.ymax = partrct->ymax - re->disprect.ymin;
 
-  if (savebuffers) {
+  if (savebuffers == RR_USE_EXR) {
     rr->do_exr_tile = true;
   }
 
@@ -345,6 +375,9 @@ RenderResult *render_result_new(Render *re,
     if (rr->do_exr_tile) {
       rl->exrhandle = IMB_exr_get_handle();
     }
+    else if (savebuffers == RR_USE_STREAM) {
+      rl->stream_filepath = render_result_exr_stream_path(re->scene, rl->name);
+    }
 
     for (rv = rr->views.first; rv; rv = rv->next) {
       const char *view = rv->name;
@@ -759,8 +792,9 @@ RenderResult *render_result_new_from_exr(
       rpass->rectx = rectx;
       rpass->recty = recty;
 
-      if (rpass->channels >= 3) {
-        IMB_colormanagement_transform(rpass->rect,
+      float *rect = RE_pass_rect_ensure(rl, rpass);
+      if (rect && rpass->channels >= 3) {
+        IMB_colormanagement_transform(rect,
                                       rpass->rectx,
                                       rpass->recty,
                                       rpass->channels,
@@ -987,6 +1021,11 @@ bool RE_WriteRenderResult(ReportList *reports,
         }
       }
 
+      /* Streamed passes are read back from disk to be written. */
+      if (RE_pass_rect_ensure(rl, rp) == NULL) {
+        continue;
+      }
+
       /* We only store RGBA passes as half float, for
        * others precision loss can be problematic. */
       bool pass_half_float = half_float &&
@@ -1252,6 +1291,8 @@ void render_result_exr_file_begin(Render *re, RenderEngine *engine)
 /* end write of exr tile file, read back first sample */
 void render_result_exr_file_end(Render *re, RenderEngine *engine)
 {
+  const bool use_stream = (re->r.scemode & R_EXR_TILE_STREAM) != 0;
+
   /* Close EXR files. */
   for (RenderResult *rr = re->result; rr; rr = rr->next) {
     for (RenderLayer *rl = rr->layers.first; rl; rl = rl->next) {
@@ -1262,13 +1303,43 @@ void render_result_exr_file_end(Render *re, RenderEngine *engine)
     rr->do_exr_tile = false;
   }
 
-  /* Create new render result in memory instead of on disk. */
+  /* Create new render result in memory instead of on disk. When streaming, only
+   * combined is allocated and other passes stay in the EXR files. */
   BLI_rw_mutex_lock(&re->resultmutex, THREAD_LOCK_WRITE);
   render_result_free_list(&re->fullresult, re->result);
-  re->result = render_result_new(re, &re->disprect, 0, RR_USE_MEM, RR_ALL_LAYERS, RR_ALL_VIEWS);
+  re->result = render_result_new(re,
+                                 &re->disprect,
+                                 0,
+                                 use_stream ? RR_USE_STREAM : RR_USE_MEM,
+                                 RR_ALL_LAYERS,
+                                 RR_ALL_VIEWS);
   BLI_rw_mutex_unlock(&re->resultmutex);
 
   for (RenderLayer *rl = re->result->layers.first; rl; rl = rl->next) {
+    char str[FILE_MAXFILE + MAX_ID_NAME + MAX_ID_NAME + 100] = "";
+    render_result_exr_file_path(re->scene, rl->name, 0, str);
+
+    /* Move the tile file out of the way of the next render, or read it
+     * back entirely if that fails. */
+    if (rl->stream_filepath) {
+      if (BLI_rename(str, rl->stream_filepath) == 0 && BLI_exists(rl->stream_filepath)) {
+        BLI_strncpy(str, rl->stream_filepath, sizeof(str));
+      }
+      else {
+        printf("cannot stream exr tmp file: %s\n", str);
+        MEM_freeN(rl->stream_filepath);
+        rl->stream_filepath = NULL;
+
+        for (RenderPass *rpass = rl->passes.first; rpass; rpass = rpass->next) {
+          if (rpass->rect == NULL) {
+            rpass->rect = MEM_mapallocN(
+                sizeof(float) * rpass->rectx * rpass->recty * rpass->channels, rpass->name);
+          }
+          rpass->stream_layer = NULL;
+        }
+      }
+    }
+
     /* Get passes needed by engine. */
     ListBase templates;
     render_result_get_pass_templates(engine, re, rl, &templates);
@@ -1284,8 +1355,6 @@ void render_result_exr_file_end(Render *re, RenderEngine *engine)
     BLI_freelistN(&templates);
 
     /* Render passes contents from file. */
-    char str[FILE_MAXFILE + MAX_ID_NAME + MAX_ID_NAME + 100] = "";
-    render_result_exr_file_path(re->scene, rl->name, 0, str);
     printf("read exr tmp file: %s\n", str);
 
     if (!render_result_exr_file_read_path(re->result, rl, str)) {
@@ -1360,13 +1429,18 @@ int render_result_exr_file_read_path(RenderResult *rr,
       int a;
       char fullname[EXR_PASS_MAXNAME];
 
+      set_pass_full_name(rpass->fullname, rpass->name, -1, rpass->view, rpass->chan_id);
+
+      /* Streamed passes are read on demand. */
+      if (rpass->rect == NULL) {
+        continue;
+      }
+
       for (a = 0; a < xstride; a++) {
         set_pass_full_name(fullname, rpass->name, a, rpass->view, rpass->chan_id);
         IMB_exr_set_channel(
             exrhandle, rl->name, fullname, xstride, xstride * rectx, rpass->rect + a);
       }
-
-      set_pass_full_name(rpass->fullname, rpass->name, -1, rpass->view, rpass->chan_id);
     }
   }
 
@@ -1376,6 +1450,48 @@ int render_result_exr_file_read_path(RenderResult *rr,
   return 1;
 }
 
+/* Read a pass of a streamed render layer back from its EXR file, the first time it is used.
+ * Returns NULL if the pass could not be read. */
+float *RE_pass_rect_ensure(RenderLayer *rl, RenderPass *rpass)
+{
+  static ThreadMutex stream_lock = BLI_MUTEX_INITIALIZER;
+
+  if (rl->stream_filepath == NULL) {
+    return rpass->rect;
+  }
+
+  BLI_mutex_lock(&stream_lock);
+
+  if (rpass->rect == NULL) {
+    void *exrhandle = IMB_exr_get_handle();
+    int rectx, recty;
+
+    if (IMB_exr_begin_read(exrhandle, rl->stream_filepath, &rectx, &recty) &&
+        rectx == rpass->rectx && recty == rpass->recty) {
+      const int xstride = rpass->channels;
+      float *rect = MEM_mapallocN(sizeof(float) * rectx * recty * xstride, rpass->name);
+
+      for (int a = 0; a < xstride; a++) {
+        char fullname[EXR_PASS_MAXNAME];
+        set_pass_full_name(fullname, rpass->name, a, rpass->view, rpass->chan_id);
+        IMB_exr_set_channel(exrhandle, rl->name, fullname, xstride, xstride * rectx, rect + a);
+      }
+
+      IMB_exr_read_channels(exrhandle);
+      rpass->rect = rect;
+    }
+    else {
+      printf("cannot read streamed pass %s from: %s\n", rpass->fullname, rl->stream_filepath);
+    }
+
+    IMB_exr_close(exrhandle);
+  }
+
+  BLI_mutex_unlock(&stream_lock);
+
+  return rpass->rect;
+}
+
 static void render_result_exr_file_cache_path(Scene *sce, const char *root, char *r_path)
 {
   char filename_full[FILE_MAX + MAX_ID_NAME + 100], filename[FILE_MAXFILE], dirname[FILE_MAXDIR];
@@ -1629,6 +1745,7 @@ static RenderPass *duplicate_render_pass(RenderPass *rpass)
   RenderPass *new_rpass = MEM_mallocN(sizeof(RenderPass), "new render pass");
   *new_rpass = *rpass;
   new_rpass->next = new_rpass->prev = NULL;
+  new_rpass->stream_layer = NULL;
   if (new_rpass->rect != NULL) {
     new_rpass->rect = MEM_dupallocN(new_rpass->rect);
   }
@@ -1642,7 +1759,10 @@ static RenderLayer *duplicate_render_layer(RenderLayer *rl)
   new_rl->next = new_rl->prev = NULL;
   new_rl->passes.first = new_rl->passes.last = NULL;
   new_rl->exrhandle = NULL;
+  new_rl->stream_filepath = NULL;
   for (RenderPass *rpass = rl->passes.first; rpass != NULL; rpass = rpass->next) {
+    /* The copy doesn't own the EXR file, so it gets all passes in memory. */
+    RE_pass_rect_ensure(rl, rpass);
     RenderPass *new_rpass = duplicate_render_pass(rpass);
     BLI_addtail(&new_rl->passes, new_rpass);
   }
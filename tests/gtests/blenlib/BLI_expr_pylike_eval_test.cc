@@ -102,6 +102,8 @@ TEST_PARSE_FAIL(BadArgCount2, "sqrt(1,2)")
 TEST_PARSE_FAIL(BadArgCount3, "pi()")
 TEST_PARSE_FAIL(BadArgCount4, "max()")
 TEST_PARSE_FAIL(BadArgCount5, "min()")
+TEST_PARSE_FAIL(BadArgCount6, "log()")
+TEST_PARSE_FAIL(BadArgCount7, "log(1,2,3)")
 
 TEST_PARSE_FAIL(Truncated1, "(1+2")
 TEST_PARSE_FAIL(Truncated2, "1 if 2")
@@ -113,6 +115,11 @@ TEST_PARSE_FAIL(Truncated7, "1 and")
 TEST_PARSE_FAIL(Truncated8, "1 or")
 TEST_PARSE_FAIL(Truncated9, "sqrt(1")
 TEST_PARSE_FAIL(Truncated10, "fmod(1,")
+TEST_PARSE_FAIL(Truncated11, "2 **")
+TEST_PARSE_FAIL(Truncated12, "2 //")
+TEST_PARSE_FAIL(Truncated13, "2 %")
+TEST_PARSE_FAIL(BadOp1, "2 ***3")
+TEST_PARSE_FAIL(BadOp2, "2 ///3")
 
 /* Constant expression with working constant folding */
 #define TEST_CONST(name, str, value) \
@@ -147,6 +154,9 @@ TEST_CONST(Half, ".5", 0.5)
 TEST_CONST(Pi, "pi", M_PI)
 TEST_CONST(True, "True", TRUE_VAL)
 TEST_CONST(False, "False", FALSE_VAL)
+TEST_CONST(E, "e", M_E)
+TEST_CONST(Tau, "tau", M_PI * 2)
+TEST_CONST(Inf, "inf", INFINITY)
 
 TEST_CONST(Sqrt, "sqrt(4)", 2.0)
 TEST_EVAL(Sqrt, "sqrt(x)", 4.0, 2.0)
@@ -157,6 +167,27 @@ TEST_EVAL(FMod, "fmod(x, 2)", 3.5, 1.5)
 TEST_CONST(Pow, "pow(4, 0.5)", 2.0)
 TEST_EVAL(Pow, "pow(4, x)", 0.5, 2.0)
 
+TEST_CONST(Log1, "log(e)", 1.0)
+TEST_CONST(Log2, "log(8, 2)", 3.0)
+TEST_EVAL(Log2, "log(x, 10)", 100.0, 2.0)
+TEST_CONST(Log10, "log10(1000)", 3.0)
+TEST_CONST(Log2f, "log2(8)", 3.0)
+
+TEST_CONST(Hypot, "hypot(3, 4)", 5.0)
+TEST_CONST(CopySign, "copysign(2, -0.5)", -2.0)
+TEST_CONST(LdExp, "ldexp(0.75, 3)", 6.0)
+TEST_EVAL(LdExp, "ldexp(x, -2)", 3.0, 0.75)
+TEST_CONST(Tanh, "tanh(0)", 0.0)
+
+TEST_CONST(Float, "float(2)", 2.0)
+TEST_CONST(Bool1, "bool(2)", TRUE_VAL)
+TEST_CONST(Bool2, "bool(0)", FALSE_VAL)
+
+TEST_CONST(Round1, "round(1.4)", 1.0)
+TEST_CONST(Round2, "round(-1.6)", -2.0)
+TEST_CONST(Round3, "round(2.5)", 2.0)
+TEST_EVAL(Round, "round(x)", 3.5, 4.0)
+
 TEST_RESULT(Min1, "min(3,1,2)", 1.0)
 TEST_RESULT(Max1, "max(3,1,2)", 3.0)
 TEST_RESULT(Min2, "min(1,2,3)", 1.0)
@@ -181,6 +212,30 @@ TEST_EVAL(BinaryMul, "x*3", 2, 6.0)
 TEST_CONST(BinaryDiv, "3/2", 1.5)
 TEST_EVAL(BinaryDiv, "3/x", 2, 1.5)
 
+TEST_CONST(BinaryPow, "2**3", 8.0)
+TEST_EVAL(BinaryPow, "x**3", 2, 8.0)
+
+TEST_CONST(BinaryFloorDiv1, "7//2", 3.0)
+TEST_CONST(BinaryFloorDiv2, "-7//2", -4.0)
+TEST_CONST(BinaryFloorDiv3, "7//0.1", 69.0)
+TEST_CONST(BinaryFloorDiv4, "-7//0.1", -70.0)
+TEST_CONST(BinaryFloorDiv5, "7//-0.1", -70.0)
+TEST_CONST(BinaryFloorDiv6, "5.5//2", 2.0)
+TEST_EVAL(BinaryFloorDiv, "x//2", 7, 3.0)
+TEST_EVAL(BinaryFloorDivFrac, "x//0.1", 7, 69.0)
+
+TEST_CONST(BinaryMod1, "7%3", 1.0)
+TEST_CONST(BinaryMod2, "-7%3", 2.0)
+TEST_CONST(BinaryMod3, "7%-3", -2.0)
+TEST_CONST(BinaryMod4, "5.5%2", 1.5)
+TEST_EVAL(BinaryMod, "x%3", -1, 2.0)
+
+TEST_CONST(Power1, "-2**2", -4.0)
+TEST_CONST(Power2, "2**-1", 0.5)
+TEST_CONST(Power3, "2**3**2", 512.0)
+TEST_CONST(Power4, "2*3**2", 18.0)
+TEST_CONST(Power5, "(-2)**2", 4.0)
+
 TEST_CONST(Arith1, "1 + -2 * 3", -5.0)
 TEST_CONST(Arith2, "(1 + -2) * 3", -3.0)
 TEST_CONST(Arith3, "-1 + 2 * 3", 5.0)
@@ -301,10 +356,34 @@ TEST_ERROR(PowDomain1, "pow(-1, 0.5)", 0.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain2, "pow(-1, x)", 0.5, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain3, "pow(-1, x)", 2.0, EXPR_PYLIKE_SUCCESS)
 
+TEST_ERROR(LdExpDomain1, "ldexp(1, 0.5)", 0.0, EXPR_PYLIKE_MATH_ERROR)
+TEST_ERROR(LdExpDomain2, "ldexp(1, x)", 0.5, EXPR_PYLIKE_MATH_ERROR)
+TEST_ERROR(LdExpDomain3, "ldexp(1, x)", 2.0, EXPR_PYLIKE_SUCCESS)
+
+TEST_ERROR(ModZero1, "1 % 0", 0.0, EXPR_PYLIKE_MATH_ERROR)
+TEST_ERROR(ModZero2, "1 % x", 0.0, EXPR_PYLIKE_MATH_ERROR)
+TEST_ERROR(FloorDivZero, "1 // x", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
+
+TEST_ERROR(LogDomain, "log(x)", -1.0, EXPR_PYLIKE_MATH_ERROR)
+TEST_ERROR(LogBaseOne, "log(x, 1)", 2.0, EXPR_PYLIKE_DIV_BY_ZERO)
+
 TEST_ERROR(Mixed1, "sqrt(x) + 1 / max(0, x)", -1.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(Mixed2, "sqrt(x) + 1 / max(0, x)", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 TEST_ERROR(Mixed3, "sqrt(x) + 1 / max(0, x)", 1.0, EXPR_PYLIKE_SUCCESS)
 
+TEST(expr_pylike, UsingParam)
+{
+  const char *names[2] = {"x", "y"};
+
+  ExprPyLike_Parsed *expr = BLI_expr_pylike_parse("y * 2 + sin(pi)", names, ARRAY_SIZE(names));
+
+  EXPECT_TRUE(BLI_expr_pylike_is_valid(expr));
+  EXPECT_FALSE(BLI_expr_pylike_is_using_param(expr, 0));
+  EXPECT_TRUE(BLI_expr_pylike_is_using_param(expr, 1));
+
+  BLI_expr_pylike_free(expr);
+}
+
 TEST(expr_pylike, Error_Invalid)
 {
   ExprPyLike_Parsed *expr = BLI_expr_pylike_parse("", NULL, 0);
@@ -0,0 +1,228 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+extern "C" {
+#include "BLI_compiler_attrs.h"
+#include "BLI_kdopbvh.h"
+#include "BLI_math.h"
+#include "BLI_rand.h"
+#include "MEM_guardedalloc.h"
+#include "PIL_time_utildefines.h"
+}
+
+#include "stubs/bf_intern_eigen_stubs.h"
+
+/* Compare build and query time of the median split and the SAH build, for all tree types.
+ * The triangles are spread over a wavy surface, with some dense clusters,
+ * which is where the trees built by both methods differ the most. */
+
+#define TRIS_LEN 1000000
+#define QUERIES_LEN 200000
+
+/* Run the longest tests! */
+//#define KDOPBVH_RUN_BIG
+
+typedef struct BVHTestData {
+  float (*tris)[3][3];
+  int tris_len;
+  /* Ray origins and directions, also used as points for nearest queries. */
+  float (*ray_origins)[3];
+  float (*ray_directions)[3];
+  int queries_len;
+} BVHTestData;
+
+static float surface_height(const float x, const float y)
+{
+  return sinf(x) * cosf(y);
+}
+
+static void test_data_create(BVHTestData *data, int tris_len, int queries_len)
+{
+  struct RNG *rng = BLI_rng_new(1234);
+
+  data->tris_len = tris_len;
+  data->tris = (float(*)[3][3])MEM_mallocN(sizeof(*data->tris) * tris_len, __func__);
+  for (int i = 0; i < tris_len; i++) {
+    float center[3];
+    float size;
+    if (i % 4 == 0) {
+      /* Dense cluster. */
+      center[0] = 3.0f + BLI_rng_get_float(rng) * 0.1f;
+      center[1] = BLI_rng_get_float(rng) * 0.1f;
+      center[2] = BLI_rng_get_float(rng) * 0.1f;
+      size = 0.002f;
+    }
+    else {
+      center[0] = BLI_rng_get_float(rng) * 10.0f;
+      center[1] = BLI_rng_get_float(rng) * 10.0f;
+      center[2] = surface_height(center[0], center[1]);
+      size = 0.03f;
+    }
+    for (int j = 0; j < 3; j++) {
+      for (int k = 0; k < 3; k++) {
+        data->tris[i][j][k] = center[k] + (BLI_rng_get_float(rng) - 0.5f) * size;
+      }
+    }
+  }
+
+  data->queries_len = queries_len;
+  data->ray_origins = (float(*)[3])MEM_mallocN(sizeof(*data->ray_origins) * queries_len,
+                                               __func__);
+  data->ray_directions = (float(*)[3])MEM_mallocN(sizeof(*data->ray_directions) * queries_len,
+                                                  __func__);
+  for (int i = 0; i < queries_len; i++) {
+    float *origin = data->ray_origins[i];
+    float target[3];
+    origin[0] = BLI_rng_get_float(rng) * 10.0f;
+    origin[1] = BLI_rng_get_float(rng) * 10.0f;
+    origin[2] = surface_height(origin[0], origin[1]) + BLI_rng_get_float(rng) * 0.4f - 0.2f;
+    target[0] = BLI_rng_get_float(rng) * 10.0f;
+    target[1] = BLI_rng_get_float(rng) * 10.0f;
+    target[2] = surface_height(target[0], target[1]);
+    sub_v3_v3v3(data->ray_directions[i], target, origin);
+    normalize_v3(data->ray_directions[i]);
+  }
+
+  BLI_rng_free(rng);
+}
+
+static void test_data_free(BVHTestData *data)
+{
+  MEM_freeN(data->tris);
+  MEM_freeN(data->ray_origins);
+  MEM_freeN(data->ray_directions);
+}
+
+static void raycast_callback(void *userdata, int index, const BVHTreeRay *ray, BVHTreeRayHit *hit)
+{
+  const BVHTestData *data = (const BVHTestData *)userdata;
+  const float(*tri)[3] = data->tris[index];
+  float dist;
+  if (isect_ray_tri_v3(ray->origin, ray->direction, tri[0], tri[1], tri[2], &dist, NULL) &&
+      dist < hit->dist) {
+    hit->index = index;
+    hit->dist = dist;
+  }
+}
+
+static void nearest_callback(void *userdata, int index, const float co[3], BVHTreeNearest *nearest)
+{
+  const BVHTestData *data = (const BVHTestData *)userdata;
+  const float(*tri)[3] = data->tris[index];
+  float co_tri[3];
+  closest_on_tri_to_point_v3(co_tri, co, tri[0], tri[1], tri[2]);
+  const float dist_sq = len_squared_v3v3(co, co_tri);
+  if (dist_sq < nearest->dist_sq) {
+    nearest->index = index;
+    nearest->dist_sq = dist_sq;
+    copy_v3_v3(nearest->co, co_tri);
+  }
+}
+
+static void kdopbvh_performance_test(BVHTestData *data, char tree_type, int build_flag)
+{
+  printf("\n========== STARTING tree type %d, %s build ==========\n",
+         tree_type,
+         (build_flag & BVH_BUILD_SAH) ? "SAH" : "median");
+
+  BVHTree *tree = BLI_bvhtree_new_ex(data->tris_len, 0.0f, tree_type, 6, build_flag);
+  for (int i = 0; i < data->tris_len; i++) {
+    BLI_bvhtree_insert(tree, i, &data->tris[i][0][0], 3);
+  }
+
+  TIMEIT_START(balance);
+  BLI_bvhtree_balance(tree);
+  TIMEIT_END(balance);
+
+  int hits = 0;
+  TIMEIT_START(ray_cast);
+  for (int i = 0; i < data->queries_len; i++) {
+    BVHTreeRayHit hit = {-1};
+    hit.dist = BVH_RAYCAST_DIST_MAX;
+    BLI_bvhtree_ray_cast(
+        tree, data->ray_origins[i], data->ray_directions[i], 0.0f, &hit, raycast_callback, data);
+    hits += (hit.index != -1);
+  }
+  TIMEIT_END(ray_cast);
+  printf("%d hits\n", hits);
+
+  TIMEIT_START(find_nearest);
+  for (int i = 0; i < data->queries_len; i++) {
+    BVHTreeNearest nearest = {-1};
+    nearest.dist_sq = FLT_MAX;
+    BLI_bvhtree_find_nearest(tree, data->ray_origins[i], &nearest, nearest_callback, data);
+    EXPECT_NE(nearest.index, -1);
+  }
+  TIMEIT_END(find_nearest);
+
+  /* The same queries as a batch. */
+  BVHTreeRayHit *hits_batch = (BVHTreeRayHit *)MEM_mallocN(
+      sizeof(*hits_batch) * data->queries_len, __func__);
+  for (int i = 0; i < data->queries_len; i++) {
+    hits_batch[i].index = -1;
+    hits_batch[i].dist = BVH_RAYCAST_DIST_MAX;
+  }
+  TIMEIT_START(ray_cast_batch);
+  BLI_bvhtree_ray_cast_batch(tree,
+                             data->ray_origins,
+                             data->ray_directions,
+                             0.0f,
+                             hits_batch,
+                             data->queries_len,
+                             raycast_callback,
+                             data,
+                             BVH_RAYCAST_DEFAULT);
+  TIMEIT_END(ray_cast_batch);
+  int hits_batch_len = 0;
+  for (int i = 0; i < data->queries_len; i++) {
+    hits_batch_len += (hits_batch[i].index != -1);
+  }
+  EXPECT_EQ(hits, hits_batch_len);
+  MEM_freeN(hits_batch);
+
+  BVHTreeNearest *nearest_batch = (BVHTreeNearest *)MEM_mallocN(
+      sizeof(*nearest_batch) * data->queries_len, __func__);
+  for (int i = 0; i < data->queries_len; i++) {
+    nearest_batch[i].index = -1;
+    nearest_batch[i].dist_sq = FLT_MAX;
+  }
+  TIMEIT_START(find_nearest_batch);
+  BLI_bvhtree_find_nearest_batch(tree,
+                                 data->ray_origins,
+                                 nearest_batch,
+                                 data->queries_len,
+                                 nearest_callback,
+                                 data,
+                                 BVH_NEAREST_REUSE_PREVIOUS);
+  TIMEIT_END(find_nearest_batch);
+  MEM_freeN(nearest_batch);
+
+  BLI_bvhtree_free(tree);
+
+  printf("========== ENDED tree type %d ==========\n\n", tree_type);
+}
+
+static void kdopbvh_performance_test_all(int tris_len, int queries_len)
+{
+  BVHTestData data;
+  test_data_create(&data, tris_len, queries_len);
+  for (int build_flag = 0; build_flag <= BVH_BUILD_SAH; build_flag += BVH_BUILD_SAH) {
+    for (char tree_type = 2; tree_type <= 8; tree_type *= 2) {
+      kdopbvh_performance_test(&data, tree_type, build_flag);
+    }
+  }
+  test_data_free(&data);
+}
+
+TEST(kdopbvh, Performance)
+{
+  kdopbvh_performance_test_all(TRIS_LEN, QUERIES_LEN);
+}
+
+#ifdef KDOPBVH_RUN_BIG
+TEST(kdopbvh, PerformanceBig)
+{
+  kdopbvh_performance_test_all(TRIS_LEN * 10, QUERIES_LEN * 5);
+}
+#endif
@@ -65,15 +65,28 @@ static void optimal_check_callback(void *userdata,
   nearest->dist_sq = len_squared_v3v3(co, points[index]);
 }
 
+static int refit_callback(void *userdata, int index, float r_co[4][3])
+{
+  float(*points)[3] = (float(*)[3])userdata;
+  copy_v3_v3(r_co[0], points[index]);
+  return 1;
+}
+
 /**
  * Note that a small epsilon is added to the BVH nodes bounds, even if we pass in zero.
  * Use rounding to ensure very close nodes don't cause the wrong node to be found as nearest.
  */
-static void find_nearest_points_test(
-    int points_len, float scale, int round, int random_seed, bool optimal = false)
+static void find_nearest_points_test(int points_len,
+                                     float scale,
+                                     int round,
+                                     int random_seed,
+                                     bool optimal = false,
+                                     char tree_type = 8,
+                                     int build_flag = 0,
+                                     bool refit = false)
 {
   struct RNG *rng = BLI_rng_new(random_seed);
-  BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 8, 8);
+  BVHTree *tree = BLI_bvhtree_new_ex(points_len, 0.0, tree_type, 8, build_flag);
 
   void *mem = MEM_mallocN(sizeof(float[3]) * points_len, __func__);
   float(*points)[3] = (float(*)[3])mem;
@@ -84,6 +97,25 @@ static void find_nearest_points_test(
   }
   BLI_bvhtree_balance(tree);
 
+  if (refit) {
+    /* The area ratio doesn't depend on the scale, only allow for rounding errors in the sum. */
+    const float area_ratio = BLI_bvhtree_get_area_ratio(tree);
+    for (int i = 0; i < points_len; i++) {
+      mul_v3_fl(points[i], 2.0f);
+    }
+    BLI_bvhtree_update_leafs(tree, refit_callback, points);
+    EXPECT_NEAR(BLI_bvhtree_get_area_ratio(tree), area_ratio, area_ratio * 1e-5f);
+
+    /* Move all points, refitting the tree must still give exact results.
+     * Every branch lies within the root and there are fewer branches than points. */
+    for (int i = 0; i < points_len; i++) {
+      rng_v3_round(points[i], 3, rng, round, scale);
+    }
+    BLI_bvhtree_update_leafs(tree, refit_callback, points);
+    EXPECT_GE(BLI_bvhtree_get_area_ratio(tree), 1.0f);
+    EXPECT_LE(BLI_bvhtree_get_area_ratio(tree), (float)points_len);
+  }
+
   /* first find each point */
   BVHTree_NearestPointCallback callback = optimal ? optimal_check_callback : NULL;
   int flags = optimal ? BVH_NEAREST_OPTIMAL_ORDER : 0;
@@ -135,3 +167,156 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+TEST(kdopbvh, SAHFindNearest_1)
+{
+  find_nearest_points_test(1, 1.0, 1000, 1234, false, 8, BVH_BUILD_SAH);
+}
+TEST(kdopbvh, SAHFindNearest_2)
+{
+  find_nearest_points_test(2, 1.0, 1000, 123, false, 8, BVH_BUILD_SAH);
+}
+TEST(kdopbvh, SAHFindNearest_500)
+{
+  find_nearest_points_test(500, 1.0, 1000, 12, false, 2, BVH_BUILD_SAH);
+  find_nearest_points_test(500, 1.0, 1000, 12, false, 4, BVH_BUILD_SAH);
+  find_nearest_points_test(500, 1.0, 1000, 12, false, 8, BVH_BUILD_SAH);
+}
+/* Enough points to build subtrees in parallel. */
+TEST(kdopbvh, SAHFindNearest_20000)
+{
+  find_nearest_points_test(20000, 1.0, 100000, 12, false, 4, BVH_BUILD_SAH);
+}
+/* Many equal points make the splits fall back to the median. */
+TEST(kdopbvh, SAHFindNearest_Duplicates)
+{
+  find_nearest_points_test(5000, 1.0, 4, 12, false, 2, BVH_BUILD_SAH);
+}
+
+TEST(kdopbvh, RefitFindNearest_2)
+{
+  find_nearest_points_test(2, 1.0, 1000, 123, false, 8, 0, true);
+}
+TEST(kdopbvh, RefitFindNearest_500)
+{
+  find_nearest_points_test(500, 1.0, 1000, 12, false, 2, 0, true);
+  find_nearest_points_test(500, 1.0, 1000, 12, false, 8, BVH_BUILD_SAH, true);
+}
+/* Enough points to refit the leafs in parallel. */
+TEST(kdopbvh, RefitFindNearest_5000)
+{
+  find_nearest_points_test(5000, 1.0, 100000, 12, false, 4, 0, true);
+}
+
+TEST(kdopbvh, SAHOptimalFindNearest_500)
+{
+  find_nearest_points_test(500, 1.0, 1000, 12, true, 2, BVH_BUILD_SAH);
+  find_nearest_points_test(500, 1.0, 1000, 12, true, 8, BVH_BUILD_SAH);
+}
+
+/* -------------------------------------------------------------------- */
+/* Batch Queries */
+
+static BVHTree *batch_test_tree_new(struct RNG *rng, int boxes_len, float box_size)
+{
+  BVHTree *tree = BLI_bvhtree_new(boxes_len, 0.0, 4, 6);
+  for (int i = 0; i < boxes_len; i++) {
+    float co[2][3];
+    rng_v3_round(co[0], 3, rng, 1000, 1.0f);
+    copy_v3_v3(co[1], co[0]);
+    add_v3_fl(co[1], box_size);
+    BLI_bvhtree_insert(tree, i, co[0], 2);
+  }
+  BLI_bvhtree_balance(tree);
+  return tree;
+}
+
+static void find_nearest_batch_test(int boxes_len, int queries_len, int random_seed, int flag)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = batch_test_tree_new(rng, boxes_len, 0.01f);
+
+  float(*co)[3] = (float(*)[3])MEM_mallocN(sizeof(*co) * queries_len, __func__);
+  BVHTreeNearest *nearest = (BVHTreeNearest *)MEM_mallocN(sizeof(*nearest) * queries_len,
+                                                          __func__);
+  for (int i = 0; i < queries_len; i++) {
+    rng_v3_round(co[i], 3, rng, 1000, 1.5f);
+    nearest[i].index = -1;
+    nearest[i].dist_sq = FLT_MAX;
+  }
+
+  BLI_bvhtree_find_nearest_batch(tree, co, nearest, queries_len, NULL, NULL, flag);
+
+  for (int i = 0; i < queries_len; i++) {
+    BVHTreeNearest single;
+    single.index = -1;
+    single.dist_sq = FLT_MAX;
+    BLI_bvhtree_find_nearest(tree, co[i], &single, NULL, NULL);
+    EXPECT_NE(nearest[i].index, -1);
+    EXPECT_FLOAT_EQ(nearest[i].dist_sq, single.dist_sq);
+  }
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(co);
+  MEM_freeN(nearest);
+}
+
+static void ray_cast_batch_test(int boxes_len, int rays_len, int random_seed)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = batch_test_tree_new(rng, boxes_len, 0.05f);
+
+  float(*co)[3] = (float(*)[3])MEM_mallocN(sizeof(*co) * rays_len, __func__);
+  float(*dir)[3] = (float(*)[3])MEM_mallocN(sizeof(*dir) * rays_len, __func__);
+  BVHTreeRayHit *hit = (BVHTreeRayHit *)MEM_mallocN(sizeof(*hit) * rays_len, __func__);
+  for (int i = 0; i < rays_len; i++) {
+    rng_v3_round(co[i], 3, rng, 1000, 1.5f);
+    BLI_rng_get_float_unit_v3(rng, dir[i]);
+    hit[i].index = -1;
+    hit[i].dist = BVH_RAYCAST_DIST_MAX;
+  }
+
+  BLI_bvhtree_ray_cast_batch(tree, co, dir, 0.0f, hit, rays_len, NULL, NULL, 0);
+
+  int hits_len = 0;
+  for (int i = 0; i < rays_len; i++) {
+    BVHTreeRayHit single;
+    single.index = -1;
+    single.dist = BVH_RAYCAST_DIST_MAX;
+    BLI_bvhtree_ray_cast_ex(tree, co[i], dir[i], 0.0f, &single, NULL, NULL, 0);
+    EXPECT_EQ(hit[i].index, single.index);
+    EXPECT_EQ(hit[i].dist, single.dist);
+    hits_len += (hit[i].index != -1);
+  }
+  EXPECT_GT(hits_len, 0);
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(co);
+  MEM_freeN(dir);
+  MEM_freeN(hit);
+}
+
+TEST(kdopbvh, FindNearestBatch_10)
+{
+  find_nearest_batch_test(100, 10, 12, 0);
+}
+TEST(kdopbvh, FindNearestBatch_5000)
+{
+  find_nearest_batch_test(1000, 5000, 12, 0);
+  find_nearest_batch_test(1000, 5000, 12, BVH_NEAREST_OPTIMAL_ORDER);
+}
+TEST(kdopbvh, FindNearestBatchReuse_5000)
+{
+  find_nearest_batch_test(1000, 5000, 12, BVH_NEAREST_REUSE_PREVIOUS);
+}
+
+TEST(kdopbvh, RayCastBatch_10)
+{
+  ray_cast_batch_test(100, 10, 12);
+}
+TEST(kdopbvh, RayCastBatch_5000)
+{
+  ray_cast_batch_test(1000, 5000, 12);
+}
@@ -0,0 +1,110 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+extern "C" {
+#include "BLI_kdtree.h"
+#include "BLI_rand.h"
+#include "MEM_guardedalloc.h"
+#include "PIL_time_utildefines.h"
+}
+
+/* Time balancing, batched queries and duplicate detection.
+ * A quarter of the points are duplicated with a small offset, so there are doubles to find. */
+
+#define POINTS_LEN 1000000
+#define QUERIES_LEN 200000
+
+/* Run the longest tests! */
+//#define KDTREE_RUN_BIG
+
+static void kdtree_performance_test(int points_len, int queries_len)
+{
+  printf("\n========== STARTING %d points ==========\n", points_len);
+
+  float(*co)[3] = (float(*)[3])MEM_malloc_arrayN(points_len, sizeof(*co), __func__);
+  RNG *rng = BLI_rng_new(1234);
+  for (int i = 0; i < points_len; i++) {
+    if (i % 4 == 3) {
+      for (int j = 0; j < 3; j++) {
+        co[i][j] = co[i - 1][j] + (BLI_rng_get_float(rng) - 0.5f) * 1e-6f;
+      }
+    }
+    else {
+      for (int j = 0; j < 3; j++) {
+        co[i][j] = BLI_rng_get_float(rng) * 10.0f;
+      }
+    }
+  }
+  BLI_rng_free(rng);
+
+  KDTree_3d *tree = BLI_kdtree_3d_new(points_len);
+  for (int i = 0; i < points_len; i++) {
+    BLI_kdtree_3d_insert(tree, i, co[i]);
+  }
+
+  TIMEIT_START(balance);
+  BLI_kdtree_3d_balance(tree);
+  TIMEIT_END(balance);
+
+  const unsigned int nearest_len = 8;
+  KDTreeNearest_3d *nearest = (KDTreeNearest_3d *)MEM_malloc_arrayN(
+      (size_t)queries_len * nearest_len, sizeof(*nearest), __func__);
+  int *nearest_found = (int *)MEM_malloc_arrayN(queries_len, sizeof(*nearest_found), __func__);
+
+  TIMEIT_START(find_nearest_n);
+  for (int i = 0; i < queries_len; i++) {
+    nearest_found[i] = BLI_kdtree_3d_find_nearest_n(
+        tree, co[i], &nearest[(size_t)i * nearest_len], nearest_len);
+  }
+  TIMEIT_END(find_nearest_n);
+
+  TIMEIT_START(find_nearest_n_batch);
+  BLI_kdtree_3d_find_nearest_n_batch(
+      tree, co, queries_len, nearest, nearest_len, nearest_found);
+  TIMEIT_END(find_nearest_n_batch);
+  MEM_freeN(nearest);
+
+  KDTreeNearest_3d **nearest_range = (KDTreeNearest_3d **)MEM_malloc_arrayN(
+      queries_len, sizeof(*nearest_range), __func__);
+  TIMEIT_START(range_search_batch);
+  BLI_kdtree_3d_range_search_batch(tree, co, queries_len, 0.05f, nearest_range, nearest_found);
+  TIMEIT_END(range_search_batch);
+  for (int i = 0; i < queries_len; i++) {
+    EXPECT_LE(1, nearest_found[i]);
+    if (nearest_range[i]) {
+      MEM_freeN(nearest_range[i]);
+    }
+  }
+  MEM_freeN(nearest_range);
+  MEM_freeN(nearest_found);
+
+  int *duplicates = (int *)MEM_malloc_arrayN(points_len, sizeof(*duplicates), __func__);
+  for (int i = 0; i < points_len; i++) {
+    duplicates[i] = -1;
+  }
+  int found;
+  TIMEIT_START(calc_duplicates_fast);
+  found = BLI_kdtree_3d_calc_duplicates_fast(tree, 1e-5f, false, duplicates);
+  TIMEIT_END(calc_duplicates_fast);
+  printf("%d duplicates\n", found);
+  EXPECT_LE(points_len / 4, found);
+  MEM_freeN(duplicates);
+
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(co);
+
+  printf("========== ENDED %d points ==========\n\n", points_len);
+}
+
+TEST(kdtree, Performance)
+{
+  kdtree_performance_test(POINTS_LEN, QUERIES_LEN);
+}
+
+#ifdef KDTREE_RUN_BIG
+TEST(kdtree, PerformanceBig)
+{
+  kdtree_performance_test(POINTS_LEN * 10, QUERIES_LEN * 5);
+}
+#endif
@@ -0,0 +1,165 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+extern "C" {
+#include "BLI_kdtree.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.h"
+#include "BLI_utildefines.h"
+#include "MEM_guardedalloc.h"
+}
+
+/* -------------------------------------------------------------------- */
+/* Helper Functions */
+
+static KDTree_3d *kdtree_random_new(float (*co)[3], int points_len, unsigned int seed)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(points_len);
+  RNG *rng = BLI_rng_new(seed);
+  for (int i = 0; i < points_len; i++) {
+    BLI_rng_get_float_unit_v3(rng, co[i]);
+    mul_v3_fl(co[i], BLI_rng_get_float(rng));
+    BLI_kdtree_3d_insert(tree, i, co[i]);
+  }
+  BLI_rng_free(rng);
+  BLI_kdtree_3d_balance(tree);
+  return tree;
+}
+
+static void find_nearest_test(int points_len, unsigned int seed)
+{
+  float(*co)[3] = (float(*)[3])MEM_malloc_arrayN(points_len, sizeof(*co), __func__);
+  KDTree_3d *tree = kdtree_random_new(co, points_len, seed);
+
+  for (int i = 0; i < points_len; i++) {
+    KDTreeNearest_3d nearest;
+    EXPECT_EQ(i, BLI_kdtree_3d_find_nearest(tree, co[i], &nearest));
+    EXPECT_EQ(0.0f, nearest.dist);
+  }
+
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(co);
+}
+
+static void find_nearest_n_batch_test(int points_len, unsigned int nearest_len, unsigned int seed)
+{
+  float(*co)[3] = (float(*)[3])MEM_malloc_arrayN(points_len, sizeof(*co), __func__);
+  KDTree_3d *tree = kdtree_random_new(co, points_len, seed);
+
+  /* Query points between the points of the tree. */
+  float(*co_query)[3] = (float(*)[3])MEM_malloc_arrayN(points_len, sizeof(*co_query), __func__);
+  for (int i = 0; i < points_len; i++) {
+    interp_v3_v3v3(co_query[i], co[i], co[(i + 1) % points_len], 0.25f);
+  }
+
+  KDTreeNearest_3d *nearest_batch = (KDTreeNearest_3d *)MEM_malloc_arrayN(
+      (size_t)points_len * nearest_len, sizeof(*nearest_batch), __func__);
+  int *nearest_batch_len = (int *)MEM_malloc_arrayN(
+      points_len, sizeof(*nearest_batch_len), __func__);
+  BLI_kdtree_3d_find_nearest_n_batch(
+      tree, co_query, points_len, nearest_batch, nearest_len, nearest_batch_len);
+
+  KDTreeNearest_3d *nearest = (KDTreeNearest_3d *)MEM_malloc_arrayN(
+      nearest_len, sizeof(*nearest), __func__);
+  for (int i = 0; i < points_len; i++) {
+    const int found = BLI_kdtree_3d_find_nearest_n(tree, co_query[i], nearest, nearest_len);
+    EXPECT_EQ(MIN2(points_len, (int)nearest_len), found);
+    EXPECT_EQ(found, nearest_batch_len[i]);
+    for (int j = 0; j < found; j++) {
+      EXPECT_EQ(nearest[j].index, nearest_batch[i * nearest_len + j].index);
+      EXPECT_EQ(nearest[j].dist, nearest_batch[i * nearest_len + j].dist);
+    }
+  }
+
+  MEM_freeN(nearest);
+  MEM_freeN(nearest_batch);
+  MEM_freeN(nearest_batch_len);
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(co_query);
+  MEM_freeN(co);
+}
+
+static void range_search_batch_test(int points_len, float range, unsigned int seed)
+{
+  float(*co)[3] = (float(*)[3])MEM_malloc_arrayN(points_len, sizeof(*co), __func__);
+  KDTree_3d *tree = kdtree_random_new(co, points_len, seed);
+
+  KDTreeNearest_3d **nearest_batch = (KDTreeNearest_3d **)MEM_malloc_arrayN(
+      points_len, sizeof(*nearest_batch), __func__);
+  int *nearest_batch_len = (int *)MEM_malloc_arrayN(
+      points_len, sizeof(*nearest_batch_len), __func__);
+  BLI_kdtree_3d_range_search_batch(tree, co, points_len, range, nearest_batch, nearest_batch_len);
+
+  for (int i = 0; i < points_len; i++) {
+    KDTreeNearest_3d *nearest = NULL;
+    const int found = BLI_kdtree_3d_range_search(tree, co[i], &nearest, range);
+    /* Every point finds itself. */
+    EXPECT_LE(1, found);
+    EXPECT_EQ(found, nearest_batch_len[i]);
+    for (int j = 0; j < found; j++) {
+      EXPECT_EQ(nearest[j].dist, nearest_batch[i][j].dist);
+      EXPECT_LE(nearest[j].dist, range);
+    }
+    if (nearest) {
+      MEM_freeN(nearest);
+    }
+    if (nearest_batch[i]) {
+      MEM_freeN(nearest_batch[i]);
+    }
+  }
+
+  MEM_freeN(nearest_batch);
+  MEM_freeN(nearest_batch_len);
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(co);
+}
+
+/* -------------------------------------------------------------------- */
+/* Tests */
+
+TEST(kdtree, Empty)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(0);
+  BLI_kdtree_3d_balance(tree);
+  const float co[3] = {0.0f, 0.0f, 0.0f};
+  EXPECT_EQ(-1, BLI_kdtree_3d_find_nearest(tree, co, NULL));
+  BLI_kdtree_3d_free(tree);
+}
+
+TEST(kdtree, FindNearest_100)
+{
+  find_nearest_test(100, 1);
+}
+
+/* Large enough to balance in parallel. */
+TEST(kdtree, FindNearest_100000)
+{
+  find_nearest_test(100000, 2);
+}
+
+TEST(kdtree, FindNearestNBatch_100)
+{
+  find_nearest_n_batch_test(100, 4, 3);
+}
+
+TEST(kdtree, FindNearestNBatch_Capacity)
+{
+  /* More nearest requested than there are points. */
+  find_nearest_n_batch_test(10, 16, 4);
+}
+
+TEST(kdtree, FindNearestNBatch_20000)
+{
+  find_nearest_n_batch_test(20000, 8, 5);
+}
+
+TEST(kdtree, RangeSearchBatch_100)
+{
+  range_search_batch_test(100, 0.2f, 6);
+}
+
+TEST(kdtree, RangeSearchBatch_20000)
+{
+  range_search_batch_test(20000, 0.05f, 7);
+}
@@ -0,0 +1,30 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+extern "C" {
+#include "BLI_compiler_attrs.h"
+#include "BLI_utildefines.h"
+#include "BLI_rand.h"
+}
+
+/* Skipping must end up at the same value as drawing the values one by one. */
+TEST(rand, RNGSkip)
+{
+  const int skips[] = {0, 1, 2, 3, 7, 64, 1000, 123457};
+
+  for (const int skip : skips) {
+    RNG *rng_step = BLI_rng_new(42);
+    RNG *rng_skip = BLI_rng_new(42);
+
+    for (int i = 0; i < skip; i++) {
+      BLI_rng_get_int(rng_step);
+    }
+    BLI_rng_skip(rng_skip, skip);
+
+    EXPECT_EQ(BLI_rng_get_uint(rng_step), BLI_rng_get_uint(rng_skip));
+
+    BLI_rng_free(rng_step);
+    BLI_rng_free(rng_skip);
+  }
+}
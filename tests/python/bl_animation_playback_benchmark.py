@@ -0,0 +1,129 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+"""
+Measure animation playback time per frame, on an armature with many animated channels.
+
+Example Usage:
+
+./blender.bin --background --factory-startup \
+    --python tests/python/bl_animation_playback_benchmark.py -- \
+    --bones=5000 --frames=100
+
+Every bone animates location, rotation and scale (10 channels), optionally
+a number of bones are driven as well.
+"""
+
+import sys
+import time
+
+import bpy
+
+
+CHANNELS = (
+    ("location", 3),
+    ("rotation_quaternion", 4),
+    ("scale", 3),
+)
+
+
+def create_rig(num_bones, num_drivers, num_keys):
+    arm = bpy.data.armatures.new("BenchmarkRig")
+    ob = bpy.data.objects.new("BenchmarkRig", arm)
+    bpy.context.scene.collection.objects.link(ob)
+    bpy.context.view_layer.objects.active = ob
+
+    bpy.ops.object.mode_set(mode='EDIT')
+    for i in range(num_bones):
+        bone = arm.edit_bones.new("Bone.%05d" % i)
+        bone.head = (i * 0.1, 0.0, 0.0)
+        bone.tail = (i * 0.1, 0.0, 1.0)
+    bpy.ops.object.mode_set(mode='OBJECT')
+
+    action = bpy.data.actions.new("BenchmarkAction")
+    ob.animation_data_create().action = action
+
+    for i in range(num_bones):
+        bone_path = 'pose.bones["Bone.%05d"]' % i
+        for prop, size in CHANNELS:
+            for index in range(size):
+                fcu = action.fcurves.new(bone_path + "." + prop, index=index)
+                fcu.keyframe_points.add(num_keys)
+                co = []
+                for k in range(num_keys):
+                    co += [k * 10.0, ((i + index + k) % 7) * 0.1]
+                fcu.keyframe_points.foreach_set("co", co)
+                fcu.update()
+
+    for i in range(min(num_drivers, num_bones)):
+        fcu = ob.driver_add('pose.bones["Bone.%05d"].custom_shape_scale' % i)
+        driver = fcu.driver
+        driver.type = 'AVERAGE'
+        var = driver.variables.new()
+        var.type = 'SINGLE_PROP'
+        var.targets[0].id = ob
+        var.targets[0].data_path = 'pose.bones["Bone.%05d"].location[0]' % i
+
+    return ob
+
+
+def benchmark(num_frames):
+    scene = bpy.context.scene
+    times = []
+    for frame in range(num_frames):
+        start = time.perf_counter()
+        scene.frame_set(frame + 1)
+        times.append(time.perf_counter() - start)
+    return times
+
+
+def main():
+    import argparse
+
+    argv = sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else []
+
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--bones", type=int, default=5000, help="Number of animated bones")
+    parser.add_argument("--drivers", type=int, default=0, help="Number of driven bones")
+    parser.add_argument("--keys", type=int, default=10, help="Keyframes per channel")
+    parser.add_argument("--frames", type=int, default=100, help="Number of frames to play")
+    args = parser.parse_args(argv)
+
+    create_rig(args.bones, args.drivers, args.keys)
+    num_channels = args.bones * sum(size for _, size in CHANNELS)
+
+    # First evaluation builds the dependency graph and resolves all paths.
+    start = time.perf_counter()
+    bpy.context.view_layer.update()
+    print("Initial evaluation: %.2f ms" % ((time.perf_counter() - start) * 1000.0))
+
+    times = benchmark(args.frames)
+    times.sort()
+    print("Animated channels: %d, drivers: %d" % (num_channels, args.drivers))
+    print("Time per frame: average %.2f ms, median %.2f ms, min %.2f ms, max %.2f ms" % (
+        sum(times) / len(times) * 1000.0,
+        times[len(times) // 2] * 1000.0,
+        times[0] * 1000.0,
+        times[-1] * 1000.0,
+    ))
+
+
+if __name__ == "__main__":
+    main()
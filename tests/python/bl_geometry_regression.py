@@ -0,0 +1,772 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+"""
+Check evaluated geometry against reference results, and against a single
+threaded run of the same case. Every case builds its objects in an empty
+scene, large enough to be evaluated in parallel, and returns a dictionary of
+results, see modules/mesh_reference.py.
+
+Example Usage:
+
+./blender.bin --background --factory-startup \
+    --python tests/python/bl_geometry_regression.py -- \
+    --case=array --reference=../lib/tests/geometry_regression/array.txt
+
+Arguments after '--':
+
+--case=NAME
+    The case to evaluate, see CASES.
+--reference=FILE
+    Compare against this file, allowing for a small tolerance on floats.
+    With BLENDER_TEST_UPDATE set the file is written instead. References are
+    written by a build from before the change a case guards, the comparison
+    is skipped while the file doesn't exist.
+--dump=FILE
+    Write the results to this file and exit, used for the single threaded run.
+"""
+
+import argparse
+import math
+import os
+import sys
+
+import bpy
+
+sys.path.append(os.path.dirname(__file__))
+from modules import mesh_reference
+
+
+def link(ob):
+    bpy.context.scene.collection.objects.link(ob)
+    return ob
+
+
+def create_grid(subdivisions=48):
+    bpy.ops.mesh.primitive_grid_add(
+        x_subdivisions=subdivisions, y_subdivisions=subdivisions, size=2.0)
+    return bpy.context.view_layer.objects.active
+
+
+# -----------------------------------------------------------------------------
+# array modifier
+#
+# Merging, merging the first and last copies, caps, fit to curve and UV offsets.
+
+def array_create_grid():
+    # 2304 vertices, the edges at x = -1 and x = 1 coincide between copies with a relative offset.
+    ob = create_grid()
+    for v in ob.data.vertices:
+        v.co.z = 0.05 * math.sin(v.co.y * 5.0)
+    return ob
+
+
+def array_create_sector():
+    # A grid bent into a 45 degree sector, so eight copies rotated around Z close a ring.
+    ob = array_create_grid()
+    for v in ob.data.vertices:
+        x, y, z = v.co
+        angle = (x + 1.0) / 2.0 * math.radians(45.0)
+        radius = 3.0 + y
+        v.co = (radius * math.cos(angle), radius * math.sin(angle), z)
+    return ob
+
+
+def array_create_cap(name, x):
+    ob = create_grid(8)
+    ob.name = name
+    # An upright grid across the open end of the array.
+    for v in ob.data.vertices:
+        v.co = (x, v.co.x, v.co.y)
+    return ob
+
+
+def array_create_curve():
+    curve = bpy.data.curves.new("Curve", 'CURVE')
+    spline = curve.splines.new('BEZIER')
+    spline.bezier_points.add(2)
+    coords = ((0.0, 0.0, 0.0), (6.0, 4.0, 0.0), (12.0, 0.0, 1.0))
+    for point, co in zip(spline.bezier_points, coords):
+        point.co = co
+        point.handle_left_type = point.handle_right_type = 'AUTO'
+    return link(bpy.data.objects.new("Curve", curve))
+
+
+def evaluate_array():
+    grid = array_create_grid()
+    sector = array_create_sector()
+    offset = link(bpy.data.objects.new("Offset", None))
+    offset.rotation_euler.z = math.radians(45.0)
+    start_cap = array_create_cap("StartCap", -1.0)
+    end_cap = array_create_cap("EndCap", 1.0)
+    curve = array_create_curve()
+
+    cases = (
+        ("merge", grid, {"count": 6, "use_merge_vertices": True}),
+        ("merge_threshold", grid, {"count": 5, "use_merge_vertices": True, "merge_threshold": 0.05,
+                                   "relative_offset_displace": (0.99, 0.0, 0.0)}),
+        ("merge_first_last", sector, {"count": 8, "use_relative_offset": False,
+                                      "use_object_offset": True, "offset_object": offset,
+                                      "use_merge_vertices": True, "use_merge_vertices_cap": True}),
+        ("caps", grid, {"count": 4, "use_merge_vertices": True, "start_cap": start_cap,
+                        "end_cap": end_cap}),
+        ("caps_first_last", sector, {"count": 8, "use_relative_offset": False,
+                                     "use_object_offset": True, "offset_object": offset,
+                                     "use_merge_vertices": True, "use_merge_vertices_cap": True,
+                                     "start_cap": start_cap, "end_cap": end_cap}),
+        ("fit_length", grid, {"fit_type": 'FIT_LENGTH', "fit_length": 9.5,
+                              "use_constant_offset": True,
+                              "constant_offset_displace": (0.25, 0.0, 0.0)}),
+        ("fit_curve", grid, {"fit_type": 'FIT_CURVE', "curve": curve, "use_merge_vertices": True}),
+        ("uv_offset", grid, {"count": 3, "offset_u": 0.5, "offset_v": 0.25,
+                             "relative_offset_displace": (1.0, 0.5, 0.0)}),
+    )
+
+    result = {}
+    for name, ob, settings in cases:
+        md = ob.modifiers.new("Array", 'ARRAY')
+        for key, value in settings.items():
+            setattr(md, key, value)
+
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        ob_eval = ob.evaluated_get(depsgraph)
+        mesh = ob_eval.to_mesh()
+        result[name] = mesh_reference.mesh_data(mesh) + (
+            [tuple(l.uv) for l in mesh.uv_layers.active.data],
+        )
+        ob_eval.to_mesh_clear()
+        ob.modifiers.remove(md)
+    return result
+
+
+# -----------------------------------------------------------------------------
+# solidify modifier
+#
+# Simple and complex modes, on an open grid, a grid with non-manifold fins and a torus.
+
+SOLIDIFY_SETTINGS = (
+    ("simple", {"solidify_mode": 'EXTRUDE'}),
+    ("simple_even", {"solidify_mode": 'EXTRUDE', "use_even_offset": True}),
+    ("simple_hq", {"solidify_mode": 'EXTRUDE', "use_quality_normals": True}),
+    ("simple_rim_only", {"solidify_mode": 'EXTRUDE', "use_rim_only": True, "offset": 0.0}),
+    ("simple_clamp", {"solidify_mode": 'EXTRUDE', "use_even_offset": True,
+                      "thickness_clamp": 0.5, "use_thickness_angle_clamp": True}),
+    ("simple_vgroup", {"solidify_mode": 'EXTRUDE', "use_flip_normals": True,
+                       "vertex_group": "Group", "thickness_vertex_group": 0.25}),
+    ("complex", {"solidify_mode": 'NON_MANIFOLD'}),
+    ("complex_even", {"solidify_mode": 'NON_MANIFOLD', "nonmanifold_thickness_mode": 'EVEN'}),
+    ("complex_constraints", {"solidify_mode": 'NON_MANIFOLD',
+                             "nonmanifold_thickness_mode": 'CONSTRAINTS',
+                             "nonmanifold_boundary_mode": 'FLAT'}),
+    ("complex_fixed", {"solidify_mode": 'NON_MANIFOLD', "nonmanifold_thickness_mode": 'FIXED',
+                       "thickness_clamp": 0.5, "vertex_group": "Group"}),
+)
+
+
+def solidify_create_grid():
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=150, y_subdivisions=150)
+    ob = bpy.context.view_layer.objects.active
+    for v in ob.data.vertices:
+        x, y, _ = v.co
+        v.co.z = 0.1 * math.sin(x * 13.0) * math.cos(y * 7.0)
+    return ob
+
+
+def solidify_create_non_manifold():
+    # Grid with fins, so edges with more than two faces are solidified.
+    ob = solidify_create_grid()
+    bpy.ops.object.mode_set(mode='EDIT')
+    bpy.ops.mesh.select_all(action='DESELECT')
+    bpy.ops.object.mode_set(mode='OBJECT')
+    for e in ob.data.edges:
+        e.select = (e.index % 7 == 0)
+    bpy.ops.object.mode_set(mode='EDIT')
+    bpy.ops.mesh.extrude_edges_move(TRANSFORM_OT_translate={"value": (0.0, 0.0, 0.05)})
+    bpy.ops.object.mode_set(mode='OBJECT')
+    return ob
+
+
+def solidify_create_torus():
+    bpy.ops.mesh.primitive_torus_add(major_segments=96, minor_segments=48)
+    return bpy.context.view_layer.objects.active
+
+
+def evaluate_solidify():
+    result = {}
+    for mesh_name, create in (
+            ("grid", solidify_create_grid),
+            ("non_manifold", solidify_create_non_manifold),
+            ("torus", solidify_create_torus),
+    ):
+        ob = create()
+        vgroup = ob.vertex_groups.new(name="Group")
+        for i in range(len(ob.data.vertices)):
+            vgroup.add([i], (i % 11) / 10.0, 'REPLACE')
+
+        for name, settings in SOLIDIFY_SETTINGS:
+            md = ob.modifiers.new("Solidify", 'SOLIDIFY')
+            md.thickness = 0.02
+            for key, value in settings.items():
+                setattr(md, key, value)
+
+            depsgraph = bpy.context.evaluated_depsgraph_get()
+            ob_eval = ob.evaluated_get(depsgraph)
+            result[mesh_name + "." + name] = mesh_reference.mesh_data(ob_eval.to_mesh())
+            ob_eval.to_mesh_clear()
+            ob.modifiers.remove(md)
+        bpy.data.objects.remove(ob)
+    return result
+
+
+# -----------------------------------------------------------------------------
+# data transfer modifier
+#
+# Vertex, edge, face corner and face data, with every mapping mode that doesn't need
+# matching topology, including UV islands.
+
+def data_transfer_displace(ob, amount):
+    # Irregular positions, so nearest elements are rarely at exactly the same distance.
+    for v in ob.data.vertices:
+        x, y, z = v.co
+        v.co *= 1.0 + amount * math.sin(x * 7.1 + y * 3.3) * math.cos(z * 5.7)
+
+
+def data_transfer_create_source():
+    bpy.ops.mesh.primitive_uv_sphere_add(segments=48, ring_count=24, radius=1.0)
+    ob = bpy.context.view_layer.objects.active
+    ob.name = "Source"
+    me = ob.data
+    data_transfer_displace(ob, 0.05)
+
+    vgroup = ob.vertex_groups.new(name="Group")
+    for v in me.vertices:
+        vgroup.add([v.index], 0.5 + 0.5 * math.sin(v.co.x * 4.0 + v.co.z * 2.0), 'REPLACE')
+
+    me.use_customdata_edge_bevel = True
+    me.use_customdata_edge_crease = True
+    for e in me.edges:
+        e.use_seam = (e.index % 5 == 0)
+        e.use_edge_sharp = (e.index % 7 == 0)
+        e.use_freestyle_mark = (e.index % 3 == 0)
+        e.crease = (e.index % 11) / 10.0
+        e.bevel_weight = (e.index % 13) / 12.0
+
+    for p in me.polygons:
+        p.use_smooth = (p.index % 2 == 0)
+        p.use_freestyle_mark = (p.index % 9 == 0)
+
+    vcol = me.vertex_colors.new(name="Col")
+    for l, col in zip(me.loops, vcol.data):
+        x, y, z = me.vertices[l.vertex_index].co
+        col.color = (x * 0.5 + 0.5, y * 0.5 + 0.5, z * 0.5 + 0.5, 1.0)
+
+    # Custom normals tilted towards the face normal, so they differ from the vertex normals.
+    loop_poly = [0] * len(me.loops)
+    for p in me.polygons:
+        for i in p.loop_indices:
+            loop_poly[i] = p.index
+    me.use_auto_smooth = True
+    me.normals_split_custom_set([
+        (me.polygons[loop_poly[l.index]].normal * 0.5 + me.vertices[l.vertex_index].normal)
+        .normalized() for l in me.loops
+    ])
+    return ob
+
+
+def data_transfer_create_dest():
+    # 2562 vertices, 7680 edges, 5120 faces and 15360 face corners.
+    bpy.ops.mesh.primitive_ico_sphere_add(subdivisions=4, radius=1.05)
+    ob = bpy.context.view_layer.objects.active
+    ob.name = "Dest"
+    me = ob.data
+    data_transfer_displace(ob, 0.03)
+
+    # The modifier only writes to layers that exist.
+    vgroup = ob.vertex_groups.new(name="Group")
+    vgroup.add(list(range(len(me.vertices))), 0.0, 'REPLACE')
+    me.use_customdata_edge_bevel = True
+    me.use_customdata_edge_crease = True
+    me.uv_layers.new(name="UVMap")
+    me.vertex_colors.new(name="Col")
+    me.use_auto_smooth = True
+    return ob
+
+
+def data_transfer_vert_data(me):
+    return [tuple(g.weight for g in v.groups) for v in me.vertices]
+
+
+def data_transfer_edge_data(me):
+    return [
+        (e.use_seam, e.use_edge_sharp, e.use_freestyle_mark, e.crease, e.bevel_weight)
+        for e in me.edges
+    ]
+
+
+def data_transfer_loop_uv_data(me):
+    return [tuple(l.uv) for l in me.uv_layers["UVMap"].data]
+
+
+def data_transfer_loop_data(me):
+    me.calc_normals_split()
+    return (
+        data_transfer_loop_uv_data(me),
+        [tuple(l.color) for l in me.vertex_colors["Col"].data],
+        [tuple(l.normal) for l in me.loops],
+    )
+
+
+def data_transfer_poly_data(me):
+    return [(p.use_smooth, p.use_freestyle_mark) for p in me.polygons]
+
+
+DATA_TRANSFER_EDGE_TYPES = {'SHARP_EDGE', 'SEAM', 'CREASE', 'BEVEL_WEIGHT_EDGE', 'FREESTYLE_EDGE'}
+
+DATA_TRANSFER_SETTINGS = (
+    # Vertex data.
+    *((("verts", mode), data_transfer_vert_data, {
+        "use_vert_data": True, "data_types_verts": {'VGROUP_WEIGHTS'}, "vert_mapping": mode,
+    }) for mode in (
+        'NEAREST', 'EDGE_NEAREST', 'EDGEINTERP_NEAREST', 'POLY_NEAREST', 'POLYINTERP_NEAREST',
+        'POLYINTERP_VNORPROJ',
+    )),
+    (("verts", "max_distance"), data_transfer_vert_data, {
+        "use_vert_data": True, "data_types_verts": {'VGROUP_WEIGHTS'},
+        "vert_mapping": 'POLYINTERP_NEAREST', "use_max_distance": True, "max_distance": 0.06,
+    }),
+    # Edge data.
+    *((("edges", mode), data_transfer_edge_data, {
+        "use_edge_data": True, "data_types_edges": DATA_TRANSFER_EDGE_TYPES, "edge_mapping": mode,
+    }) for mode in ('VERT_NEAREST', 'NEAREST', 'POLY_NEAREST', 'EDGEINTERP_VNORPROJ')),
+    (("edges", "ray_radius"), data_transfer_edge_data, {
+        "use_edge_data": True, "data_types_edges": {'CREASE', 'BEVEL_WEIGHT_EDGE'},
+        "edge_mapping": 'EDGEINTERP_VNORPROJ', "ray_radius": 0.05,
+    }),
+    # Face corner data, all layers for one mode, UVs for the others.
+    (("loops", 'POLYINTERP_NEAREST'), data_transfer_loop_data, {
+        "use_loop_data": True, "data_types_loops": {'CUSTOM_NORMAL', 'VCOL', 'UV'},
+        "loop_mapping": 'POLYINTERP_NEAREST',
+    }),
+    *((("loops", mode), data_transfer_loop_uv_data, {
+        "use_loop_data": True, "data_types_loops": {'UV'}, "loop_mapping": mode,
+    }) for mode in ('NEAREST_NORMAL', 'NEAREST_POLYNOR', 'NEAREST_POLY', 'POLYINTERP_LNORPROJ')),
+    # UV islands.
+    *((("loops_islands", mode), data_transfer_loop_uv_data, {
+        "use_loop_data": True, "data_types_loops": {'UV'}, "loop_mapping": mode,
+        "islands_precision": 0.5,
+    }) for mode in ('NEAREST_POLYNOR', 'POLYINTERP_NEAREST', 'POLYINTERP_LNORPROJ')),
+    # Face data.
+    *((("polys", mode), data_transfer_poly_data, {
+        "use_poly_data": True, "data_types_polys": {'SMOOTH', 'FREESTYLE_FACE'},
+        "poly_mapping": mode,
+    }) for mode in ('NEAREST', 'NORMAL', 'POLYINTERP_PNORPROJ')),
+)
+
+
+def evaluate_data_transfer():
+    source = data_transfer_create_source()
+    dest = data_transfer_create_dest()
+
+    result = {}
+    for (data, mode), get_data, settings in DATA_TRANSFER_SETTINGS:
+        md = dest.modifiers.new("DataTransfer", 'DATA_TRANSFER')
+        md.object = source
+        for key, value in settings.items():
+            setattr(md, key, value)
+
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        dest_eval = dest.evaluated_get(depsgraph)
+        result[data + "." + mode] = get_data(dest_eval.to_mesh())
+        dest_eval.to_mesh_clear()
+        dest.modifiers.remove(md)
+    return result
+
+
+# -----------------------------------------------------------------------------
+# smooth modifiers
+#
+# Corrective smooth and laplacian smooth of meshes deformed by an animated wave, evaluated on
+# several frames, so the cached adjacency of corrective smooth is reused.
+
+SMOOTH_FRAMES = (1, 5, 9)
+
+SMOOTH_CORRECTIVE_SETTINGS = (
+    ("simple", {"smooth_type": 'SIMPLE'}),
+    ("length_weighted", {"smooth_type": 'LENGTH_WEIGHTED'}),
+    ("simple_vgroup", {"smooth_type": 'SIMPLE', "vertex_group": "Group"}),
+    ("length_weighted_vgroup", {"smooth_type": 'LENGTH_WEIGHTED', "vertex_group": "Group",
+                                "invert_vertex_group": True}),
+    ("only_smooth", {"smooth_type": 'LENGTH_WEIGHTED', "use_only_smooth": True,
+                     "vertex_group": "Group"}),
+    ("pin_boundary", {"smooth_type": 'SIMPLE', "use_pin_boundary": True, "factor": 0.8,
+                      "iterations": 10}),
+    ("bind", {"smooth_type": 'LENGTH_WEIGHTED', "rest_source": 'BIND',
+              "vertex_group": "Group"}),
+)
+
+SMOOTH_LAPLACIAN_SETTINGS = (
+    ("laplacian", {}),
+    ("laplacian_volume", {"use_volume_preserve": True, "use_normalized": True,
+                          "vertex_group": "Group"}),
+)
+
+
+def smooth_create_torus():
+    bpy.ops.mesh.primitive_torus_add(major_segments=72, minor_segments=32)
+    return bpy.context.view_layer.objects.active
+
+
+def smooth_prepare(ob):
+    vgroup = ob.vertex_groups.new(name="Group")
+    for v in ob.data.vertices:
+        vgroup.add([v.index], 0.5 + 0.5 * math.sin(v.co.x * 3.0 + v.co.y * 2.0), 'REPLACE')
+
+    md = ob.modifiers.new("Wave", 'WAVE')
+    md.height = 0.1
+    md.width = 0.4
+    md.speed = 0.1
+
+
+def smooth_evaluate_frames(ob, key, result):
+    for frame in SMOOTH_FRAMES:
+        bpy.context.scene.frame_set(frame)
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        ob_eval = ob.evaluated_get(depsgraph)
+        result[key + ".%d" % frame] = [tuple(v.co) for v in ob_eval.to_mesh().vertices]
+        ob_eval.to_mesh_clear()
+
+
+def evaluate_smooth():
+    result = {}
+    for mesh_name, create in (("grid", create_grid), ("torus", smooth_create_torus)):
+        ob = create()
+        smooth_prepare(ob)
+
+        for name, settings in SMOOTH_CORRECTIVE_SETTINGS:
+            md = ob.modifiers.new("CorrectiveSmooth", 'CORRECTIVE_SMOOTH')
+            md.iterations = 20
+            for key, value in settings.items():
+                setattr(md, key, value)
+            if md.rest_source == 'BIND':
+                bpy.context.view_layer.objects.active = ob
+                bpy.context.scene.frame_set(SMOOTH_FRAMES[0])
+                bpy.ops.object.correctivesmooth_bind(modifier=md.name)
+            smooth_evaluate_frames(ob, mesh_name + "." + name, result)
+            ob.modifiers.remove(md)
+
+        for name, settings in SMOOTH_LAPLACIAN_SETTINGS:
+            md = ob.modifiers.new("LaplacianSmooth", 'LAPLACIANSMOOTH')
+            md.iterations = 5
+            for key, value in settings.items():
+                setattr(md, key, value)
+            smooth_evaluate_frames(ob, mesh_name + "." + name, result)
+            ob.modifiers.remove(md)
+
+        bpy.data.objects.remove(ob)
+    return result
+
+
+# -----------------------------------------------------------------------------
+# metaballs
+#
+# Metaballs large compared to the resolution, so the surface crosses many blocks of the
+# lattice which are polygonized in parallel and merged. The order of the vertices, edges
+# and faces is not compared, see mesh_reference.mesh_data_unordered().
+
+def metaball_create(name, resolution, threshold, elements):
+    mball = bpy.data.metaballs.new(name)
+    mball.resolution = resolution
+    mball.threshold = threshold
+    for elem_type, co, radius, settings in elements:
+        elem = mball.elements.new(type=elem_type)
+        elem.co = co
+        elem.radius = radius
+        for key, value in settings.items():
+            setattr(elem, key, value)
+    return link(bpy.data.objects.new(name, mball))
+
+
+def metaball_ring_elements(count):
+    # Balls on a wavy ring, irregularly sized so the surface is not symmetric.
+    elements = []
+    for i in range(count):
+        angle = 2.0 * math.pi * i / count
+        co = (2.0 * math.cos(angle), 2.0 * math.sin(angle), 0.3 * math.sin(angle * 3.0))
+        elements.append(('BALL', co, 0.6 + 0.2 * math.sin(i * 1.7), {}))
+    return elements
+
+
+METABALL_SETTINGS = (
+    # Many elements, the first points are found in parallel and the ring spans several blocks.
+    ("ring", 0.04, 0.6, metaball_ring_elements(16)),
+    # A single element much larger than a block.
+    ("large_ball", 0.02, 0.6, (('BALL', (0.0, 0.0, 0.0), 2.0, {}),)),
+    # Separate surfaces, and every element type, a negative element carves a hole.
+    ("types", 0.05, 0.6, (
+        ('BALL', (-3.0, 0.0, 0.0), 1.2, {}),
+        ('CAPSULE', (0.0, 0.0, 0.0), 1.0, {"size_x": 1.5}),
+        ('PLANE', (3.0, 0.0, 0.0), 1.0, {"size_x": 0.8, "size_y": 0.6}),
+        ('ELLIPSOID', (0.0, 3.0, 0.0), 1.0, {"size_x": 1.5, "size_y": 0.8, "size_z": 0.5}),
+        ('CUBE', (0.0, -3.0, 0.0), 1.0, {"size_x": 0.6, "size_y": 0.6, "size_z": 0.6}),
+        ('BALL', (0.0, 0.0, 0.6), 0.8, {"use_negative": True}),
+        ('BALL', (0.0, -3.0, 1.0), 1.0, {"stiffness": 4.0}),
+    )),
+)
+
+
+def evaluate_metaball():
+    result = {}
+    for name, resolution, threshold, elements in METABALL_SETTINGS:
+        ob = metaball_create(name, resolution, threshold, elements)
+
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        ob_eval = ob.evaluated_get(depsgraph)
+        # Blocks of the lattice are merged in a different order than the serial code visited
+        # cubes in, only the surface itself is compared.
+        result[name] = mesh_reference.mesh_data_unordered(ob_eval.to_mesh())
+        ob_eval.to_mesh_clear()
+
+        bpy.data.objects.remove(ob)
+    return result
+
+
+# -----------------------------------------------------------------------------
+# curves, text and surfaces
+#
+# 2D curves and text with holes, a 3D curve with a bevel and taper object and a NURBS surface
+# have many splines, evaluated in parallel. Moving a hook re-evaluates a curve reusing its
+# unchanged bevel lists, the result is compared with a fresh evaluation of a copy.
+
+def curve_add_circle(curve, center, radius, count):
+    spline = curve.splines.new('BEZIER')
+    spline.bezier_points.add(count - 1)
+    for i, point in enumerate(spline.bezier_points):
+        angle = 2.0 * math.pi * i / count
+        # Slightly irregular, so the circles are not symmetric.
+        r = radius * (1.0 + 0.1 * math.sin(angle * 3.0))
+        point.co = (center[0] + r * math.cos(angle), center[1] + r * math.sin(angle), 0.0)
+        point.handle_left_type = point.handle_right_type = 'AUTO'
+    spline.use_cyclic_u = True
+    return spline
+
+
+def curve_add_poly(curve, coords, cyclic):
+    spline = curve.splines.new('POLY')
+    spline.points.add(len(coords) - 1)
+    for point, co in zip(spline.points, coords):
+        point.co = (*co, 1.0)
+    spline.use_cyclic_u = cyclic
+    return spline
+
+
+def curve_create_2d():
+    curve = bpy.data.curves.new("Curve2D", 'CURVE')
+    curve.dimensions = '2D'
+    curve.fill_mode = 'BOTH'
+    curve.extrude = 0.2
+    curve.bevel_depth = 0.05
+    curve.resolution_u = 16
+    # Islands with holes, and islands inside holes.
+    for x in range(4):
+        for y in range(4):
+            center = (x * 5.0, y * 5.0)
+            curve_add_circle(curve, center, 2.0, 6)
+            curve_add_circle(curve, (center[0] - 0.8, center[1]), 0.6, 4)
+            curve_add_circle(curve, (center[0] + 0.8, center[1]), 0.6, 4)
+            curve_add_circle(curve, (center[0] + 0.8, center[1]), 0.3, 4)
+            x0, y0 = center
+            curve_add_poly(curve, ((x0 - 0.3, y0 + 1.0), (x0 + 0.3, y0 + 1.0),
+                             (x0 + 0.3, y0 + 1.4), (x0 - 0.3, y0 + 1.4)), True)
+    return link(bpy.data.objects.new("Curve2D", curve))
+
+
+def curve_create_text():
+    text = bpy.data.curves.new("Text", 'FONT')
+    # Letters with holes, over several lines.
+    text.body = "ABBA boa 8086\nQuod PDQ 90\nbeep & 0 @"
+    text.extrude = 0.05
+    text.bevel_depth = 0.01
+    text.offset = 0.01
+    text.resolution_u = 8
+    return link(bpy.data.objects.new("Text", text))
+
+
+def curve_create_bevel():
+    curve = bpy.data.curves.new("Bevel", 'CURVE')
+    curve_add_circle(curve, (0.0, 0.0), 0.2, 5)
+    return link(bpy.data.objects.new("Bevel", curve))
+
+
+def curve_create_taper():
+    curve = bpy.data.curves.new("Taper", 'CURVE')
+    spline = curve.splines.new('BEZIER')
+    spline.bezier_points.add(2)
+    coords = ((0.0, 0.2, 0.0), (1.0, 1.0, 0.0), (2.0, 0.5, 0.0))
+    for point, co in zip(spline.bezier_points, coords):
+        point.co = co
+        point.handle_left_type = point.handle_right_type = 'AUTO'
+    return link(bpy.data.objects.new("Taper", curve))
+
+
+def curve_create_3d(bevel, taper):
+    curve = bpy.data.curves.new("Curve3D", 'CURVE')
+    curve.dimensions = '3D'
+    curve.bevel_object = bevel
+    curve.taper_object = taper
+    curve.use_fill_caps = True
+    curve.resolution_u = 12
+    curve.twist_mode = 'MINIMUM'
+    # Open and cyclic bezier and NURBS helices.
+    for i in range(24):
+        if i % 3 == 0:
+            spline = curve.splines.new('BEZIER')
+            spline.bezier_points.add(7)
+            points = spline.bezier_points
+        else:
+            spline = curve.splines.new('NURBS')
+            spline.points.add(7)
+            spline.order_u = 3 + (i % 2)
+            spline.use_endpoint_u = (i % 2 == 0)
+            points = spline.points
+        for j, point in enumerate(points):
+            angle = j * 0.9 + i * 0.3
+            co = (math.cos(angle) * (1.0 + i * 0.2), math.sin(angle) * (1.0 + i * 0.2), j * 0.4)
+            if spline.type == 'BEZIER':
+                point.co = co
+                point.handle_left_type = point.handle_right_type = 'AUTO'
+            else:
+                point.co = (*co, 1.0)
+            point.tilt = j * 0.2
+            point.radius = 1.0 + 0.1 * j
+        spline.use_cyclic_u = (i % 4 == 1)
+    return link(bpy.data.objects.new("Curve3D", curve))
+
+
+def curve_create_surface():
+    bpy.ops.surface.primitive_nurbs_surface_torus_add()
+    ob = bpy.context.view_layer.objects.active
+    surf = ob.data
+    surf.resolution_u = 8
+    surf.resolution_v = 8
+    # Several patches, each tessellated by its own task.
+    bpy.ops.surface.primitive_nurbs_surface_sphere_add(location=(3.0, 0.0, 0.0))
+    bpy.ops.surface.primitive_nurbs_surface_cylinder_add(location=(-3.0, 0.0, 0.0))
+    bpy.ops.object.select_all(action='DESELECT')
+    for ob_iter in bpy.context.view_layer.objects:
+        ob_iter.select_set(ob_iter.type == 'SURFACE')
+    bpy.context.view_layer.objects.active = ob
+    bpy.ops.object.join()
+    return ob
+
+
+def curve_evaluated_data(ob):
+    depsgraph = bpy.context.evaluated_depsgraph_get()
+    ob_eval = ob.evaluated_get(depsgraph)
+    data = mesh_reference.mesh_data(ob_eval.to_mesh())
+    ob_eval.to_mesh_clear()
+    return data
+
+
+def curve_evaluate_hook(ob):
+    """Move a hook after a first evaluation, and compare with a copy evaluated once."""
+    hook = link(bpy.data.objects.new("Hook", None))
+    md = ob.modifiers.new("Hook", 'HOOK')
+    md.object = hook
+    # Bezier points have three coordinates, this hooks every other handle or point.
+    md.vertex_indices_set(range(0, 8 * 3, 2))
+    curve_evaluated_data(ob)
+
+    hook.location = (0.5, -0.25, 1.0)
+    moved = curve_evaluated_data(ob)
+
+    ob_fresh = link(ob.copy())
+    fresh = curve_evaluated_data(ob_fresh)
+    if not mesh_reference.values_equal(moved, fresh, 0.0):
+        print("FAILED: re-evaluating %s after moving a hook differs from a fresh evaluation" %
+              ob.name)
+        sys.exit(1)
+    return moved
+
+
+def evaluate_curve():
+    bevel = curve_create_bevel()
+    taper = curve_create_taper()
+
+    result = {}
+    for name, create in (
+            ("curve_2d", curve_create_2d),
+            ("text", curve_create_text),
+            ("curve_3d", lambda: curve_create_3d(bevel, taper)),
+            ("surface", curve_create_surface),
+    ):
+        result[name] = curve_evaluated_data(create())
+
+    result["curve_3d_hook"] = curve_evaluate_hook(bpy.data.objects["Curve3D"])
+    return result
+
+
+# -----------------------------------------------------------------------------
+# main
+
+CASES = {
+    "array": evaluate_array,
+    "solidify": evaluate_solidify,
+    "data_transfer": evaluate_data_transfer,
+    "smooth": evaluate_smooth,
+    "metaball": evaluate_metaball,
+    "curve": evaluate_curve,
+}
+
+
+def main():
+    argv = sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else []
+
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--case", required=True, choices=sorted(CASES.keys()),
+                        help="The case to evaluate")
+    parser.add_argument("--reference", default="", help="Compare against the results in this file")
+    parser.add_argument("--dump", default="", help="Write the results to this file and exit")
+    args = parser.parse_args(argv)
+
+    # Start from an empty scene.
+    for ob in bpy.data.objects:
+        bpy.data.objects.remove(ob)
+
+    result = CASES[args.case]()
+
+    if args.dump:
+        mesh_reference.write(args.dump, result)
+        return
+
+    # The number of threads must not change the result at all.
+    failed = mesh_reference.compare(
+        result, mesh_reference.evaluate_single_threaded(__file__, "--case=" + args.case), 0.0,
+        "the single threaded result")
+
+    if args.reference:
+        failed += mesh_reference.compare_reference(result, args.reference, 1e-5)
+
+    if failed:
+        sys.exit(1)
+    print("All %d results of %s match" % (len(result), args.case))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,153 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+"""
+Measure evaluation time of deform modifiers on a dense grid mesh.
+
+Example Usage:
+
+./blender.bin --background --factory-startup \
+    --python tests/python/bl_modifier_deform_benchmark.py -- \
+    --subdivisions=1000 --iterations=10
+
+Every modifier is evaluated on its own, the time of evaluating the mesh
+without modifiers is subtracted. Use --vgroup to deform through a vertex group.
+"""
+
+import sys
+import time
+
+import bpy
+
+
+MODIFIERS = (
+    ('CAST', {}),
+    ('SIMPLE_DEFORM', {"deform_method": 'TWIST'}),
+    ('WAVE', {}),
+    ('WARP', {}),
+    ('HOOK', {}),
+    ('SMOOTH', {"iterations": 4}),
+    ('CORRECTIVE_SMOOTH', {"iterations": 10}),
+    ('LAPLACIANSMOOTH', {}),
+    ('LATTICE', {}),
+    ('CURVE', {}),
+)
+
+
+def create_grid(subdivisions, use_vgroup):
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=subdivisions, y_subdivisions=subdivisions)
+    ob = bpy.context.view_layer.objects.active
+    ob.name = "BenchmarkGrid"
+
+    if use_vgroup:
+        vgroup = ob.vertex_groups.new(name="Group")
+        num_verts = len(ob.data.vertices)
+        vgroup.add(range(0, num_verts, 2), 1.0, 'REPLACE')
+
+    return ob
+
+
+def create_helpers():
+    empty_from = bpy.data.objects.new("From", None)
+    empty_to = bpy.data.objects.new("To", None)
+    empty_to.location = (0.5, 0.0, 0.5)
+
+    bpy.ops.object.add(type='LATTICE')
+    lattice = bpy.context.view_layer.objects.active
+    lattice.scale = (2.5, 2.5, 2.5)
+    lattice.data.points[0].co_deform.z += 0.5
+
+    bpy.ops.curve.primitive_bezier_curve_add()
+    curve = bpy.context.view_layer.objects.active
+
+    for ob in (empty_from, empty_to):
+        bpy.context.scene.collection.objects.link(ob)
+
+    return {
+        "object_from": empty_from,
+        "object_to": empty_to,
+        "lattice": lattice,
+        "curve": curve,
+    }
+
+
+def add_modifier(ob, mod_type, settings, helpers, use_vgroup):
+    md = ob.modifiers.new(mod_type.title(), mod_type)
+    for key, value in settings.items():
+        setattr(md, key, value)
+
+    if mod_type == 'WARP':
+        md.object_from = helpers["object_from"]
+        md.object_to = helpers["object_to"]
+    elif mod_type == 'HOOK':
+        md.object = helpers["object_to"]
+    elif mod_type == 'LATTICE':
+        md.object = helpers["lattice"]
+    elif mod_type == 'CURVE':
+        md.object = helpers["curve"]
+
+    if use_vgroup and hasattr(md, "vertex_group"):
+        md.vertex_group = "Group"
+    elif mod_type == 'HOOK':
+        # Hooks without vertex group or indices don't deform anything.
+        md.vertex_indices_set(range(0, len(ob.data.vertices), 2))
+
+    return md
+
+
+def evaluate(ob, iterations):
+    view_layer = bpy.context.view_layer
+    times = []
+    for _ in range(iterations):
+        ob.update_tag(refresh={'DATA'})
+        start = time.perf_counter()
+        view_layer.update()
+        times.append(time.perf_counter() - start)
+    times.sort()
+    return times[len(times) // 2]
+
+
+def main():
+    import argparse
+
+    argv = sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else []
+
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--subdivisions", type=int, default=1000, help="Grid subdivisions")
+    parser.add_argument("--iterations", type=int, default=10, help="Evaluations per modifier")
+    parser.add_argument("--vgroup", action="store_true", help="Deform through a vertex group")
+    args = parser.parse_args(argv)
+
+    helpers = create_helpers()
+    ob = create_grid(args.subdivisions, args.vgroup)
+    print("Vertices: %d" % len(ob.data.vertices))
+
+    baseline = evaluate(ob, args.iterations)
+    print("%-16s %8.2f ms" % ("No modifiers", baseline * 1000.0))
+
+    for mod_type, settings in MODIFIERS:
+        md = add_modifier(ob, mod_type, settings, helpers, args.vgroup)
+        median = evaluate(ob, args.iterations)
+        print("%-16s %8.2f ms" % (md.name, (median - baseline) * 1000.0))
+        ob.modifiers.remove(md)
+
+
+if __name__ == "__main__":
+    main()
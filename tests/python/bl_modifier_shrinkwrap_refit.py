@@ -0,0 +1,120 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+"""
+Check shrinkwrap onto an animated target gives the same result on every frame,
+when the BVH trees of the target are refit instead of being built again.
+
+Example Usage:
+
+./blender.bin --background --factory-startup \
+    --python tests/python/bl_modifier_shrinkwrap_refit.py
+
+The expected result is computed with trees built from scratch by mathutils.
+"""
+
+import sys
+
+import bpy
+from mathutils.bvhtree import BVHTree
+from mathutils.kdtree import KDTree
+
+
+FRAMES = 12
+EPSILON = 1e-5
+
+
+def create_target(use_subsurf):
+    bpy.ops.mesh.primitive_uv_sphere_add(segments=64, ring_count=32, radius=1.0)
+    target = bpy.context.view_layer.objects.active
+    # Wave is animated over time, the topology of the target stays the same.
+    md = target.modifiers.new("Wave", 'WAVE')
+    md.height = 0.2
+    md.width = 0.5
+    md.speed = 0.1
+    if use_subsurf:
+        target.modifiers.new("Subsurf", 'SUBSURF')
+    return target
+
+
+def create_source(target, wrap_method):
+    bpy.ops.mesh.primitive_ico_sphere_add(subdivisions=4, radius=0.5)
+    source = bpy.context.view_layer.objects.active
+    md = source.modifiers.new("Shrinkwrap", 'SHRINKWRAP')
+    md.target = target
+    md.wrap_method = wrap_method
+    return source
+
+
+def expected_coords(source, target, depsgraph, wrap_method):
+    target_eval = target.evaluated_get(depsgraph)
+    coords = [v.co for v in source.data.vertices]
+
+    if wrap_method == 'NEAREST_VERTEX':
+        mesh = target_eval.data
+        kd = KDTree(len(mesh.vertices))
+        for v in mesh.vertices:
+            kd.insert(v.co, v.index)
+        kd.balance()
+        return [kd.find(co)[0] for co in coords]
+
+    bvh = BVHTree.FromObject(target_eval, depsgraph)
+    return [bvh.find_nearest(co)[0] for co in coords]
+
+
+def check(use_subsurf, wrap_method):
+    scene = bpy.context.scene
+    target = create_target(use_subsurf)
+    source = create_source(target, wrap_method)
+
+    failed = 0
+    for frame in range(1, FRAMES + 1):
+        scene.frame_set(frame)
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        result = [v.co.copy() for v in source.evaluated_get(depsgraph).data.vertices]
+        expected = expected_coords(source, target, depsgraph, wrap_method)
+        errors = sum((a - b).length > EPSILON for a, b in zip(result, expected))
+        if errors:
+            print("FAILED: %s (subsurf: %r), frame %d: %d vertices differ" %
+                  (wrap_method, use_subsurf, frame, errors))
+            failed += 1
+
+    bpy.data.objects.remove(source)
+    bpy.data.objects.remove(target)
+    return failed
+
+
+def main():
+    # Start from an empty scene.
+    for ob in bpy.data.objects:
+        bpy.data.objects.remove(ob)
+
+    failed = 0
+    for use_subsurf in (False, True):
+        for wrap_method in ('NEAREST_SURFACEPOINT', 'NEAREST_VERTEX'):
+            failed += check(use_subsurf, wrap_method)
+
+    if failed:
+        sys.exit(1)
+    print("All shrinkwrap results match")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,150 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+"""
+Compare evaluated geometry against a reference file, and against a single
+threaded run of the same test script, see bl_geometry_regression.py.
+
+Results are dictionaries of names to nested lists, tuples and dictionaries of
+numbers and strings. They are written with repr, so floats round-trip exactly.
+References are meant to be written by a build from before the change they
+guard, the comparison is skipped while the file doesn't exist.
+"""
+
+import os
+import subprocess
+import tempfile
+
+import bpy
+
+
+def mesh_data(mesh):
+    """Vertex coordinates, edges and faces of a mesh, in order."""
+    return (
+        [tuple(v.co) for v in mesh.vertices],
+        [tuple(e.vertices) for e in mesh.edges],
+        [tuple(p.vertices) for p in mesh.polygons],
+    )
+
+
+def mesh_data_unordered(mesh, precision=4):
+    """
+    Like mesh_data, but independent of the order of vertices, edges and faces,
+    and of the first vertex of each face. Vertices are sorted by their coordinates
+    rounded to precision decimals first, so vertices which differ by less than the
+    tolerance of a comparison are sorted the same way on both sides.
+    """
+    def key(i):
+        co = tuple(mesh.vertices[i].co)
+        return tuple(round(c, precision) for c in co), co
+
+    order = sorted(range(len(mesh.vertices)), key=key)
+    remap = [0] * len(order)
+    for index_new, index in enumerate(order):
+        remap[index] = index_new
+
+    edges = sorted(tuple(sorted(remap[v] for v in e.vertices)) for e in mesh.edges)
+    polys = []
+    for p in mesh.polygons:
+        verts = [remap[v] for v in p.vertices]
+        start = verts.index(min(verts))
+        polys.append(tuple(verts[start:] + verts[:start]))
+    polys.sort()
+
+    return (
+        [tuple(mesh.vertices[i].co) for i in order],
+        edges,
+        polys,
+    )
+
+
+def values_equal(a, b, tolerance):
+    """Compare nested results, floats may differ by tolerance."""
+    if isinstance(a, float) or isinstance(b, float):
+        return (
+            isinstance(a, (int, float)) and isinstance(b, (int, float)) and
+            abs(a - b) <= tolerance
+        )
+    if isinstance(a, (list, tuple)):
+        return (
+            isinstance(b, (list, tuple)) and len(a) == len(b) and
+            all(values_equal(x, y, tolerance) for x, y in zip(a, b))
+        )
+    if isinstance(a, dict):
+        return (
+            isinstance(b, dict) and a.keys() == b.keys() and
+            all(values_equal(a[key], b[key], tolerance) for key in a)
+        )
+    return a == b
+
+
+def compare(result, expected, tolerance, expected_name):
+    """Print and return the names of results which differ from the expected results."""
+    failed = []
+    for key in sorted(result.keys() | expected.keys()):
+        if key not in expected:
+            print("FAILED: %s is missing from %s" % (key, expected_name))
+        elif key not in result:
+            print("FAILED: %s of %s is missing" % (key, expected_name))
+        elif not values_equal(result[key], expected[key], tolerance):
+            print("FAILED: %s differs from %s" % (key, expected_name))
+        else:
+            continue
+        failed.append(key)
+    return failed
+
+
+def write(filepath, result):
+    with open(filepath, "w") as fh:
+        fh.write(repr(result))
+
+
+def read(filepath):
+    with open(filepath) as fh:
+        return eval(fh.read())
+
+
+def evaluate_single_threaded(script, *args):
+    """Run the test script again with a single thread and extra arguments, return its results."""
+    with tempfile.TemporaryDirectory() as tmpdir:
+        filepath = os.path.join(tmpdir, "single_thread.txt")
+        subprocess.run((
+            bpy.app.binary_path, "--background", "--factory-startup", "--threads", "1",
+            "--python", script, "--", *args, "--dump=" + filepath,
+        ), check=True)
+        return read(filepath)
+
+
+def compare_reference(result, filepath, tolerance):
+    """
+    Compare against a reference file, or write it when BLENDER_TEST_UPDATE is set.
+    A missing reference is skipped, it can only be written by a build from before the change
+    the test guards. Return the names of results which differ.
+    """
+    if os.getenv("BLENDER_TEST_UPDATE") is not None:
+        write(filepath, result)
+        print("Updated reference %s" % filepath)
+        return []
+    if not os.path.exists(filepath):
+        print("SKIPPED: reference %s not found, only compared with a single thread. "
+              "Write it with BLENDER_TEST_UPDATE=1 from a build without the change under test." %
+              filepath)
+        return []
+    return compare(result, read(filepath), tolerance, "the reference")